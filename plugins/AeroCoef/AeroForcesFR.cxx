@@ -1,11 +1,13 @@
 #include "Common/BadValueException.hh"
 #include "Common/ParserException.hh"
+#include "Common/StringOps.hh"
 #include "Framework/MethodCommandProvider.hh"
 #include "Framework/SubSystemStatus.hh"
 #include "Framework/PathAppender.hh"
 #include "Environment/FileHandlerOutput.hh"
 #include "Environment/FileHandlerInput.hh"
 #include "Environment/DirPaths.hh"
+#include "Common/MPI/MPIIOFunctions.hh"
 
 #include "AeroCoef/AeroCoef.hh"
 #include "AeroCoef/AeroForcesFR.hh"
@@ -48,6 +50,7 @@ void AeroForcesFR::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< bool >("AppendTime","Append time to file name.");
   options.addConfigOption< bool >("AppendIter","Append Iteration# to file name."); 
   options.addConfigOption< bool >("ReorderWallData","Reorder the wall data to make the file structured.");
+  options.addConfigOption< bool >("BinaryWallData","Write the wall data as native doubles (one record per wall point) after the text header, whose last line gives the total number of records and the number of values in each record.");
   options.addConfigOption< CFuint >("TID","Position of T in the state vector");
   options.addConfigOption< CFuint >("UID","Position of u in the state vector");
   options.addConfigOption< CFuint >("VID","Position of v in the state vector");
@@ -168,6 +171,9 @@ AeroForcesFR::AeroForcesFR(const std::string& name) :
   m_reorderWallData = true;
   setParameter("ReorderWallData",&m_reorderWallData);
   
+  m_binaryWallData = false;
+  setParameter("BinaryWallData",&m_binaryWallData);
+  
   m_TID = 0;
   setParameter("TID",&m_TID);
 
@@ -1127,7 +1133,9 @@ void AeroForcesFR::initSurfaceResiduals()
 
 void AeroForcesFR::reorderOutputFileWall()
 {      
-  if (m_reorderWallData && PhysicalModelStack::getActive()->getDim() == DIM_2D) {
+  // binary wall data are not reordered
+  if (m_reorderWallData && !m_binaryWallData && 
+      PhysicalModelStack::getActive()->getDim() == DIM_2D) {
     SafePtr<TopologicalRegionSet> currTrs = this->getCurrentTRS();
     
     boost::filesystem::path file = Environment::DirPaths::getInstance().getResultsDir() /
@@ -1206,6 +1214,38 @@ void AeroForcesFR::reorderOutputFileWall()
   }
 }
   
+//////////////////////////////////////////////////////////////////////////////
+
+void AeroForcesFR::appendWallData(const boost::filesystem::path& file,
+			const std::string& text,
+			const std::vector<CFreal>& values,
+			const CFuint stride)
+{
+  const std::string nsp = this->getMethodData().getNamespace();
+  MPI_Comm comm = PE::GetPE().GetCommunicator(nsp);
+  
+  if (m_binaryWallData) {
+    cf_assert(values.size()%stride == 0);
+    CFuint nbRecords = values.size()/stride;
+    CFuint totNbRecords = 0;
+    MPI_Allreduce(&nbRecords, &totNbRecords, 1, MPI_UNSIGNED, MPI_SUM, comm);
+    
+    // the first processor tells how to read the records after the text header
+    string buf;
+    if (PE::GetPE().GetRank(nsp) == 0) {
+      buf = "BINARY RECORDS = " + StringOps::to_str(totNbRecords) +
+	" STRIDE = " + StringOps::to_str(stride) +
+	" BYTES = " + StringOps::to_str(sizeof(CFreal)) + "\n";
+    }
+    const char* data = (!values.empty()) ? reinterpret_cast<const char*>(&values[0]) : CFNULL;
+    buf.append(data, values.size()*sizeof(CFreal));
+    MPIIOFunctions::appendOrdered(file.string(), buf.data(), buf.size(), comm);
+  }
+  else {
+    MPIIOFunctions::appendOrdered(file.string(), text.data(), text.size(), comm);
+  }
+}
+  
 //////////////////////////////////////////////////////////////////////////////
      
     } // namespace AeroCoeff
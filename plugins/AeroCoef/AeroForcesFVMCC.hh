@@ -111,6 +111,16 @@ protected:
   /// Reorder the file with the wall data
   virtual void reorderOutputFileWall();
   
+  /// Append the wall data of all the processors to the given file at once,
+  /// in rank order, with collective MPI-IO
+  /// @param text    ASCII lines of this processor
+  /// @param values  records of this processor, written if BinaryWallData
+  /// @param stride  number of values in each record
+  void appendWallData(const boost::filesystem::path& file,
+		      const std::string& text,
+		      const std::vector<CFreal>& values,
+		      const CFuint stride);
+  
   /**
    * Execute on a set of dofs
    */
@@ -352,6 +362,9 @@ protected:
   ///flag for reordering the wall data to produce a structured file
   bool m_reorderWallData;
   
+  ///flag for writing the wall data in binary format
+  bool m_binaryWallData;
+  
   /// ID of temperature in gradient vars
   CFuint m_TID;
 
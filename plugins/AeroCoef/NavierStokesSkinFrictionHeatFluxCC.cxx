@@ -320,71 +320,74 @@ void NavierStokesSkinFrictionHeatFluxCC::prepareOutputFileWall()
 
 void NavierStokesSkinFrictionHeatFluxCC::updateOutputFileWall()
 {  
-  const std::string nsp = getMethodData().getNamespace();
-  PE::GetPE().setBarrier(nsp);
-  
-  // all processors will write their own data one after the other 
-  for (CFuint i = 0; i < PE::GetPE().GetProcessorCount(nsp); ++i) {
-    if (i == PE::GetPE().GetRank (nsp)) {
-      if (getCurrentTRS()->getLocalNbGeoEnts() > 0) {
-	SafePtr<TopologicalRegionSet> currTrs = getCurrentTRS();
-	boost::filesystem::path file = Environment::DirPaths::getInstance().getResultsDir() /
-	  boost::filesystem::path(m_nameOutputFileWall + currTrs->getName());
-	file = Framework::PathAppender::getInstance().appendAllInfo  
-	  (file,this->m_appendIter,this->m_appendTime,false);   
-     
-	SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
-	  Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
-	ofstream& fout = fhandle->open(file, ios::app);
-	
-	Common::SafePtr<GeometricEntityPool<FaceTrsGeoBuilder> >
-	  geoBuilder = m_fvmccData->getFaceTrsGeoBuilder();
-	
-	SafePtr<FaceTrsGeoBuilder> geoBuilderPtr = geoBuilder->getGeoBuilder();
-	geoBuilderPtr->setDataSockets(socket_states, socket_gstates, socket_nodes);
+  SafePtr<TopologicalRegionSet> currTrs = getCurrentTRS();
+  boost::filesystem::path file = Environment::DirPaths::getInstance().getResultsDir() /
+    boost::filesystem::path(m_nameOutputFileWall + currTrs->getName());
+  file = Framework::PathAppender::getInstance().appendAllInfo  
+    (file,this->m_appendIter,this->m_appendTime,false);   
+  
+  // each processor collects its own data, then all of them are written at once
+  ostringstream fout;
+  vector<CFreal> values;
+  
+  const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
+  if (nbTrsFaces > 0) {
+    Common::SafePtr<GeometricEntityPool<FaceTrsGeoBuilder> >
+      geoBuilder = m_fvmccData->getFaceTrsGeoBuilder();
+    
+    SafePtr<FaceTrsGeoBuilder> geoBuilderPtr = geoBuilder->getGeoBuilder();
+    geoBuilderPtr->setDataSockets(socket_states, socket_gstates, socket_nodes);
+    
+    FaceTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+    geoData.trs = currTrs;
+    geoData.isBFace = true;
+    
+    const CFuint nbVars = m_valuesMat.nbRows(); 
+    if (m_binaryWallData) {
+      values.reserve(nbTrsFaces*(m_coord.size() + nbVars));
+    }
+    
+    for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+      // build the GeometricEntity
+      geoData.idx = iFace;
+      m_currFace = geoBuilder->buildGE();
+      m_fvmccData->getCurrentFace() = m_currFace;
+      
+      // only faces whose internal State is parallel updatable will write
+      // their data to avoid redudance due to overlap 
+      if (m_currFace->getState(0)->isParUpdatable()) {
+	// compute the face normal
+	const vector<Node*>& faceNodes = *m_currFace->getNodes();
+	const CFuint nbFaceNodes = faceNodes.size();
 	
-	FaceTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
-	geoData.trs = currTrs;
-	geoData.isBFace = true;
+	// compute the face mid point
+	m_coord = 0.0;
+	for (CFuint iNode = 0; iNode < nbFaceNodes; ++iNode) {
+	  m_coord += *faceNodes[iNode];
+	}
+	m_coord /= nbFaceNodes;
 	
-	const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
-	for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
-	  // build the GeometricEntity
-	  geoData.idx = iFace;
-	  m_currFace = geoBuilder->buildGE();
-	  m_fvmccData->getCurrentFace() = m_currFace;
-	  
-	  // only faces whose internal State is parallel updatable will write
-	  // their data to avoid redudance due to overlap 
-	  if (m_currFace->getState(0)->isParUpdatable()) {
-	    // compute the face normal
-	    const vector<Node*>& faceNodes = *m_currFace->getNodes();
-	    const CFuint nbFaceNodes = faceNodes.size();
-	    
-	    // compute the face mid point
-	    m_coord = 0.0;
-	    for (CFuint iNode = 0; iNode < nbFaceNodes; ++iNode) {
-	      m_coord += *faceNodes[iNode];
-	    }
-	    m_coord /= nbFaceNodes;
-	    
-	    fout << m_coord << " ";
-	   
-	    const CFuint index = m_mapTrsFaceToID.find(m_currFace->getID());
-	    const CFuint nbVars = m_valuesMat.nbRows(); 
-	    for (CFuint iVar = 0; iVar < nbVars; ++iVar) {
-	      fout << m_valuesMat(iVar, index) << " ";
-	    }
-	   fout << "\n";
+	const CFuint index = m_mapTrsFaceToID.find(m_currFace->getID());
+	if (m_binaryWallData) {
+	  values.insert(values.end(), &m_coord[0], &m_coord[0] + m_coord.size());
+	  for (CFuint iVar = 0; iVar < nbVars; ++iVar) {
+	    values.push_back(m_valuesMat(iVar, index));
+	  }
+	}
+	else {
+	  fout << m_coord << " ";
+	  for (CFuint iVar = 0; iVar < nbVars; ++iVar) {
+	    fout << m_valuesMat(iVar, index) << " ";
 	  }
-	  
-	  geoBuilder->releaseGE();
+	  fout << "\n";
 	}
       }
+      
+      geoBuilder->releaseGE();
     }
-    
-    PE::GetPE().setBarrier(nsp);
   }
+  
+  appendWallData(file, fout.str(), values, m_coord.size() + m_valuesMat.nbRows());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -435,95 +435,78 @@ void NavierStokesSkinFrictionHeatFluxFR::prepareOutputFileWall()
 
 void NavierStokesSkinFrictionHeatFluxFR::updateOutputFileWall()
 {  
-  const std::string nsp = getMethodData().getNamespace();
-  PE::GetPE().setBarrier(nsp);
-  
-  // all processors will write their own data one after the other 
-  for (CFuint i = 0; i < PE::GetPE().GetProcessorCount(nsp); ++i) 
+  SafePtr<TopologicalRegionSet> currTrs = getCurrentTRS();
+  boost::filesystem::path file = Environment::DirPaths::getInstance().getResultsDir() /
+    boost::filesystem::path(m_nameOutputFileWall + currTrs->getName());
+  file = Framework::PathAppender::getInstance().appendAllInfo  
+    (file,this->m_appendIter,this->m_appendTime,false);   
+  
+  // each processor collects its own data, then all of them are written at once
+  ostringstream fout;
+  vector<CFreal> values;
+  
+  const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
+  if (nbTrsFaces > 0) 
   {
-    if (i == PE::GetPE().GetRank (nsp)) 
+    Common::SafePtr<GeometricEntityPool<FaceToCellGEBuilder> >
+      geoBuilder = m_faceBuilder;
+    
+    // get InnerCells TopologicalRegionSet
+    SafePtr<TopologicalRegionSet> cellTrs = MeshDataStack::getActive()->getTrs("InnerCells");
+    
+    FaceToCellGEBuilder::GeoData& geoData = geoBuilder->getDataGE();
+    geoData.cellsTRS = cellTrs;
+    geoData.facesTRS = currTrs;
+    geoData.isBoundary = true;
+    
+    const CFuint nbVars = m_valuesMat.nbRows(); 
+    for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) 
     {
-      if (getCurrentTRS()->getLocalNbGeoEnts() > 0) 
+      // build the GeometricEntity
+      geoData.idx = iFace;
+      m_currFace = geoBuilder->buildGE();
+      
+      // GET THE NEIGHBOURING CELL
+      m_intCell = m_currFace->getNeighborGeo(0);
+      
+      // GET THE STATES IN THE NEIGHBOURING CELL
+      m_cellStates = m_intCell->getStates();
+      
+      // only faces whose internal State is parallel updatable will write
+      // their data to avoid redudance due to overlap 
+      if ((*m_cellStates)[0]->isParUpdatable()) 
       {
-	SafePtr<TopologicalRegionSet> currTrs = getCurrentTRS();
-	boost::filesystem::path file = Environment::DirPaths::getInstance().getResultsDir() /
-	  boost::filesystem::path(m_nameOutputFileWall + currTrs->getName());
-	file = Framework::PathAppender::getInstance().appendAllInfo  
-	  (file,this->m_appendIter,this->m_appendTime,false);   
-     
-	SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
-	  Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
-	ofstream& fout = fhandle->open(file, ios::app);
-	
-	Common::SafePtr<GeometricEntityPool<FaceToCellGEBuilder> >
-	  geoBuilder = m_faceBuilder;
-	
-	SafePtr<FaceToCellGEBuilder> geoBuilderPtr = geoBuilder->getGeoBuilder();
-	//geoBuilderPtr->setDataSockets(socket_states, socket_gstates, socket_nodes);
-	
-	// get InnerCells TopologicalRegionSet
-        SafePtr<TopologicalRegionSet> cellTrs = MeshDataStack::getActive()->getTrs("InnerCells");
-	
-	FaceToCellGEBuilder::GeoData& geoData = geoBuilder->getDataGE();
-	geoData.cellsTRS = cellTrs;
-        geoData.facesTRS = currTrs;
-        geoData.isBoundary = true;
-	
-	const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
-	for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) 
+	// loop over flx pnts
+	for (CFuint iFlx = 0; iFlx < m_nbrFaceFlxPnts; ++iFlx)
 	{
-	  // build the GeometricEntity
-	  geoData.idx = iFace;
-	  m_currFace = geoBuilder->buildGE();
-	  //m_fvmccData->getCurrentFace() = m_currFace;
-	  
-	  // GET THE NEIGHBOURING CELL
-          m_intCell = m_currFace->getNeighborGeo(0);
-
-          // GET THE STATES IN THE NEIGHBOURING CELL
-          m_cellStates = m_intCell->getStates();
+	  // compute coordinates of output point
+	  m_coord = m_currFace->computeCoordFromMappedCoord((*m_flxLocalCoords)[iFlx]);
 	  
-	  // only faces whose internal State is parallel updatable will write
-	  // their data to avoid redudance due to overlap 
-	  if ((*m_cellStates)[0]->isParUpdatable()) 
+	  const CFuint index = m_mapTrsFaceToID.find(m_currFace->getID()*m_nbrFaceFlxPnts+iFlx);
+	  if (m_binaryWallData) 
 	  {
-	    // loop over flx pnts
-            for (CFuint iFlx = 0; iFlx < m_nbrFaceFlxPnts; ++iFlx)
-            {
-              // compute coordinates of output point
-              m_coord = m_currFace->computeCoordFromMappedCoord((*m_flxLocalCoords)[iFlx]);
-	      
-	      fout << m_coord << " ";
-	      
-	      const CFuint index = m_mapTrsFaceToID.find(m_currFace->getID()*m_nbrFaceFlxPnts+iFlx);
-	      const CFuint nbVars = m_valuesMat.nbRows(); 
-	      for (CFuint iVar = 0; iVar < nbVars; ++iVar) 
-	      {
-	        fout << m_valuesMat(iVar, index) << " ";
-	      }
-	      fout << "\n";
-            }
-            
-// 	    // compute the face normal
-// 	    const vector<Node*>& faceNodes = *m_currFace->getNodes();
-// 	    const CFuint nbFaceNodes = faceNodes.size();
-// 	    
-// 	    // compute the face mid point
-// 	    m_coord = 0.0;
-// 	    for (CFuint iNode = 0; iNode < nbFaceNodes; ++iNode) 
-// 	    {
-// 	      m_coord += *faceNodes[iNode];
-// 	    }
-// 	    m_coord /= nbFaceNodes;
-// 	    
-	  }  
-	  geoBuilder->releaseGE();
+	    values.insert(values.end(), &m_coord[0], &m_coord[0] + m_coord.size());
+	    for (CFuint iVar = 0; iVar < nbVars; ++iVar) 
+	    {
+	      values.push_back(m_valuesMat(iVar, index));
+	    }
+	  }
+	  else 
+	  {
+	    fout << m_coord << " ";
+	    for (CFuint iVar = 0; iVar < nbVars; ++iVar) 
+	    {
+	      fout << m_valuesMat(iVar, index) << " ";
+	    }
+	    fout << "\n";
+	  }
 	}
-      }
+      }  
+      geoBuilder->releaseGE();
     }
-    
-    PE::GetPE().setBarrier(nsp);
   }
+  
+  appendWallData(file, fout.str(), values, m_coord.size() + m_valuesMat.nbRows());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,187 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <boost/filesystem/fstream.hpp>
+
+#include "Common/StringOps.hh"
+#include "Framework/BadFormatException.hh"
+
+#include "CFmeshFileReader/CFmeshTextScanner.hh"
+
+#if defined(CF_HAVE_ALLOC_MMAP) && defined(CF_HAVE_UNISTD_H)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#define CF_TEXT_SCANNER_MMAP
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace CFmeshFileReader {
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFmeshTextScanner::CFmeshTextScanner() :
+  m_fileName(),
+  m_begin(CFNULL),
+  m_end(CFNULL),
+  m_pos(CFNULL),
+  m_content(),
+  m_isMapped(false)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFmeshTextScanner::~CFmeshTextScanner()
+{
+  close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool CFmeshTextScanner::open(const boost::filesystem::path& file)
+{
+  close();
+  m_fileName = file.string();
+
+#ifdef CF_TEXT_SCANNER_MMAP
+  const int fd = ::open(m_fileName.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void* start = mmap(CFNULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (start == MAP_FAILED) return false;
+
+  // the lists are scanned from the beginning to the end
+  madvise(start, st.st_size, MADV_SEQUENTIAL);
+
+  m_isMapped = true;
+  m_begin = static_cast<const char*>(start);
+  m_end = m_begin + st.st_size;
+#else
+  boost::filesystem::ifstream fin(file, std::ios::in | std::ios::binary);
+  if (!fin) return false;
+  m_content.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+  if (m_content.empty()) return false;
+  m_begin = &m_content[0];
+  m_end = m_begin + m_content.size();
+#endif
+
+  m_pos = m_begin;
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshTextScanner::close()
+{
+#ifdef CF_TEXT_SCANNER_MMAP
+  if (m_isMapped) {
+    munmap(const_cast<char*>(m_begin), m_end - m_begin);
+  }
+#endif
+  m_isMapped = false;
+  m_begin = CFNULL;
+  m_end = CFNULL;
+  m_pos = CFNULL;
+  std::vector<char>().swap(m_content);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+size_t CFmeshTextScanner::copyToken()
+{
+  nextToken();
+
+  // the file is not null terminated: the token is copied before
+  // being given to the conversion functions
+  size_t length = 0;
+  const size_t maxLength = sizeof(m_token) - 1;
+  while (m_pos + length < m_end && !isSpace(m_pos[length])) {
+    if (length == maxLength) {
+      const size_t offset = m_pos - m_begin;
+      throw Framework::BadFormatException
+	(FromHere(), "Token longer than " + Common::StringOps::to_str(maxLength) +
+	 " characters at offset " + Common::StringOps::to_str(offset) + " while reading " + m_fileName);
+    }
+    m_token[length] = m_pos[length];
+    ++length;
+  }
+  m_token[length] = '\0';
+  return length;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal CFmeshTextScanner::readReal()
+{
+  copyToken();
+
+  char* last = CFNULL;
+  const CFreal value = static_cast<CFreal>(std::strtod(m_token, &last));
+  if (last == m_token) badNumber();
+
+  m_pos += last - m_token;
+  return value;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+unsigned long CFmeshTextScanner::readULong()
+{
+  copyToken();
+
+  char* last = CFNULL;
+  const unsigned long value = std::strtoul(m_token, &last, 10);
+  if (last == m_token) badNumber();
+
+  m_pos += last - m_token;
+  return value;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshTextScanner::endOfFileReached() const
+{
+  throw Framework::BadFormatException
+    (FromHere(), "Unexpected end of file while reading " + m_fileName);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CFmeshTextScanner::badNumber() const
+{
+  const size_t offset = m_pos - m_begin;
+  throw Framework::BadFormatException
+    (FromHere(), "Expected a number at offset " + Common::StringOps::to_str(offset) +
+     " while reading " + m_fileName + ", found \"" + std::string(m_token) + "\"");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace CFmeshFileReader
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,172 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_CFmeshFileReader_CFmeshTextScanner_hh
+#define COOLFluiD_CFmeshFileReader_CFmeshTextScanner_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/NonCopyable.hh"
+
+#include "CFmeshFileReader/CFmeshFileReaderAPI.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace CFmeshFileReader {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class scans the whitespace separated tokens of a text file,
+/// which is mapped in memory (read-only) or, if mapping is not available,
+/// loaded at once.
+/// It is meant to replace the formatted extraction from std::ifstream in
+/// the large lists of a CFmesh file: the tokens that are not needed are
+/// skipped without being converted and the numbers are converted with the
+/// C library functions, giving the same values as std::ifstream.
+class CFmeshFileReader_API CFmeshTextScanner :
+    public Common::NonCopyable<CFmeshTextScanner> {
+public:
+
+  /// Constructor
+  CFmeshTextScanner();
+
+  /// Destructor
+  ~CFmeshTextScanner();
+
+  /// Open the file
+  /// @return false if the file could not be opened
+  bool open(const boost::filesystem::path& file);
+
+  /// Release the mapped or loaded file
+  void close();
+
+  /// @return true if a file is open
+  bool isOpen() const {return m_begin != CFNULL;}
+
+  /// Move to the given offset from the beginning of the file
+  void seek(size_t offset)
+  {
+    cf_assert(offset <= size_t(m_end - m_begin));
+    m_pos = m_begin + offset;
+  }
+
+  /// @return the current offset from the beginning of the file
+  size_t tell() const {return m_pos - m_begin;}
+
+  /// Skip the given number of tokens
+  void skip(CFuint nbTokens)
+  {
+    for (CFuint i = 0; i < nbTokens; ++i) {
+      nextToken();
+      while (m_pos < m_end && !isSpace(*m_pos)) ++m_pos;
+    }
+  }
+
+  /// Read the given number of real values
+  void read(CFreal* values, CFuint nbValues)
+  {
+    for (CFuint i = 0; i < nbValues; ++i) {
+      values[i] = readReal();
+    }
+  }
+
+  /// Read the next token as a real value
+  CFreal readReal();
+
+  /// Read the next token as an unsigned integer
+  template <typename T>
+  void readUInt(T& value)
+  {
+    nextToken();
+
+    // plain sequences of digits are converted directly
+    const char* p = m_pos;
+    T result = 0;
+    while (p < m_end && *p >= '0' && *p <= '9') {
+      result = 10*result + static_cast<T>(*p - '0');
+      ++p;
+    }
+    if (p > m_pos && (p == m_end || isSpace(*p))) {
+      m_pos = p;
+      value = result;
+      return;
+    }
+
+    value = static_cast<T>(readULong());
+  }
+
+private:
+
+  /// @return true if c is a whitespace character, as for std::isspace()
+  /// in the "C" locale
+  static bool isSpace(char c)
+  {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  }
+
+  /// Move to the beginning of the next token
+  /// @throw Framework::BadFormatException if the end of the file is reached
+  void nextToken()
+  {
+    while (m_pos < m_end && isSpace(*m_pos)) ++m_pos;
+    if (m_pos == m_end) endOfFileReached();
+  }
+
+  /// Copy the current token in a null terminated buffer
+  /// @return the length of the token
+  /// @throw Framework::BadFormatException if the token does not fit in the buffer
+  size_t copyToken();
+
+  /// Read the next token as an unsigned long with std::strtoul
+  unsigned long readULong();
+
+  /// Throw the exception for an unexpected end of file
+  void endOfFileReached() const;
+
+  /// Throw the exception for a token that is not a number
+  void badNumber() const;
+
+private:
+
+  /// name of the file, for the error messages
+  std::string m_fileName;
+
+  /// beginning of the content of the file
+  const char* m_begin;
+
+  /// end of the content of the file
+  const char* m_end;
+
+  /// current position
+  const char* m_pos;
+
+  /// content of the file, if not mapped
+  std::vector<char> m_content;
+
+  /// flag telling if the file is mapped
+  bool m_isMapped;
+
+  /// buffer where a token is copied to be converted
+  char m_token[128];
+
+}; // end of class CFmeshTextScanner
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace CFmeshFileReader
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_CFmeshFileReader_CFmeshTextScanner_hh
@@ -17,6 +17,7 @@
 #include "Common/BadValueException.hh"
 #include "Common/MPI/MPIIOFunctions.hh"
 
+#include "Environment/DirPaths.hh"
 #include "Environment/FileHandlerInput.hh"
 #include "Environment/SingleBehaviorFactory.hh"
 
@@ -24,6 +25,7 @@
 #include "Framework/MeshData.hh"
 #include "Framework/VarSetTransformer.hh"
 #include "Framework/MeshPartitioner.hh"
+#include "Framework/MeshSignature.hh"
 #include "Framework/SubSystemStatus.hh"
 
 #include "CFmeshFileReader/ParCFmeshBinaryFileReader.hh"
@@ -53,6 +55,9 @@ ParCFmeshBinaryFileReader::ParCFmeshBinaryFileReader() :
   
   m_maxBuffSize = 2147479200; // (CFuint) std::numeric_limits<int>::max();
   setParameter("MaxBuffSize",&m_maxBuffSize);
+  
+  m_solutionFile = "";
+  setParameter("SolutionFile",&m_solutionFile);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -66,6 +71,8 @@ ParCFmeshBinaryFileReader::~ParCFmeshBinaryFileReader()
 void ParCFmeshBinaryFileReader::defineConfigOptions(Config::OptionList& options)
 {
    options.addConfigOption< int >("MaxBuffSize", "Maximum buffer size for MPI I/O");
+   options.addConfigOption< std::string >
+     ("SolutionFile", "Solution-only file (.CFsol) from which the states are read instead of the mesh file");
 }
  
 /////////////////////////////////////////////////////////////////////////////
@@ -669,25 +676,7 @@ void ParCFmeshBinaryFileReader::readElementList(MPI_File* fh)
   CFLog(DEBUG_MAX, CFPrintContainer<vector<PartitionerData::IndexT> >("pdata.elemNode = ", &pdata.elemNode));
   CFLog(DEBUG_MAX, CFPrintContainer<vector<PartitionerData::IndexT> >("pdata.elmdist  = ", &pdata.elmdist));
   
-  // avoid mesh partitioning if you have just one processor
-  if (m_nbProc > 1)
-  {
-    if (PhysicalModelStack::getActive()->getDim() > DIM_1D) {
-      m_partitioner->SetCommunicator(m_comm);
-      CFLog(NOTICE, "Calling mesh partitioner\n");
-      CFLog(NOTICE, "+++\n");
-      m_partitioner->doPartition(pdata);
-      CFLog(NOTICE, "+++\n");
-    }
-    else {
-      pdata.part->resize(m_nbElemPerProc[m_myRank], m_myRank);
-    }
-  }
-  else
-  {
-    cf_assert(m_myRank == 0);
-    pdata.part->resize(m_nbElemPerProc[m_myRank], 0);
-  }
+  partitionElements(pdata);
   
   // move the elements data to the right processor
   // and build info about the overlap region
@@ -697,10 +686,13 @@ void ParCFmeshBinaryFileReader::readElementList(MPI_File* fh)
   cf_assert(m_localNodeIDs.size() > 0);
   cf_assert(m_localStateIDs.size() > 0);
 
+  // renumber the local nodes/states to improve the memory locality
+  computeLocalOrdering(*m_local_elem);
+  
   // set mapping between global and local node/state IDs
-  setMapGlobalToLocalID(m_localNodeIDs, m_ghostNodeIDs, m_mapGlobToLocNodeID);
+  setMapGlobalToLocalID(m_localNodeIDs, m_ghostNodeIDs, m_orderedNodeIDs, m_mapGlobToLocNodeID);
 
-  setMapGlobalToLocalID(m_localStateIDs, m_ghostStateIDs, m_mapGlobToLocStateID);
+  setMapGlobalToLocalID(m_localStateIDs, m_ghostStateIDs, m_orderedStateIDs, m_mapGlobToLocStateID);
 
   // set the elements in the readData
   setElements(*m_local_elem);
@@ -1156,6 +1148,10 @@ void ParCFmeshBinaryFileReader::readGeomEntList(MPI_File* fh)
     (*nbGeomEntsPerTR)[iTRS][iTR] = countGeos;
     
     cf_assert((*trsGlobalIDs)[iTRS][iTR].size() == countGeos);
+    
+    if (!m_orderedStateIDs.empty()) {
+      sortGeoConnByState(iTRS, iTR);
+    }
 
     CFLogDebugMin("Rank " << m_myRank << ", iTR = " << iTR
 		  << ", countGeos = " << countGeos << "\n");
@@ -1182,21 +1178,7 @@ bool ParCFmeshBinaryFileReader::readString(MPI_File* fh)
   
   // check end of file
   if (key != getReaderTerminator()) {
-    CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readString() => key " << key << " before\n");
-    MapString2ReaderP::iterator key_pair = m_mapString2ReaderFun.find(key);
-    CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readString() => key " << key << " after\n");
-    
-    // check if key exists else ignore it
-    if (key_pair != m_mapString2ReaderFun.end()) {
-      CFLogDebugMin( "Read CFmesh Key: " << key << "\n");
-      ReaderFun function = key_pair->second;
-      cf_assert(function != CFNULL);
-      (this->*function)(fh);
-    }
-    else {
-      std::string msg = "Key in CFmesh is not valid:" + key;
-      throw Common::NoSuchValueException (FromHere(),msg);
-    }
+    readKey(fh, key);
     
     // keep reading
     return true;
@@ -1206,6 +1188,27 @@ bool ParCFmeshBinaryFileReader::readString(MPI_File* fh)
   return false;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshBinaryFileReader::readKey(MPI_File* fh, const std::string& key)
+{
+  CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readKey() => key " << key << " before\n");
+  MapString2ReaderP::iterator key_pair = m_mapString2ReaderFun.find(key);
+  CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readKey() => key " << key << " after\n");
+  
+  // check if key exists else ignore it
+  if (key_pair != m_mapString2ReaderFun.end()) {
+    CFLogDebugMin( "Read CFmesh Key: " << key << "\n");
+    ReaderFun function = key_pair->second;
+    cf_assert(function != CFNULL);
+    (this->*function)(fh);
+  }
+  else {
+    std::string msg = "Key in CFmesh is not valid:" + key;
+    throw Common::NoSuchValueException (FromHere(),msg);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
     
 void ParCFmeshBinaryFileReader::finish()
@@ -1657,6 +1660,12 @@ void ParCFmeshBinaryFileReader::createNodesAll(const vector<CFreal>& localNodesD
   }
   sort(globalIDs.begin(), globalIDs.end());
   
+  // renumbered nodes are registered beforehand in the local order
+  const bool isRenumbered = !m_orderedNodeIDs.empty();
+  if (isRenumbered) {
+    addPointsInLocalOrder(nodes, m_orderedNodeIDs, m_localNodeIDs);
+  }
+  
   typedef CFMultiMap<CFuint,CFuint>::MapIterator MapIt;
   
   CFuint countBufLocal = 0;
@@ -1671,7 +1680,7 @@ void ParCFmeshBinaryFileReader::createNodesAll(const vector<CFreal>& localNodesD
     CFuint* countBuf = NULL; 
     if (hasEntry(m_localNodeIDs, globalID)) {
       countLocals++;
-      localID = nodes.addLocalPoint (globalID);
+      localID = isRenumbered ? m_mapGlobToLocNodeID.find(globalID) : nodes.addLocalPoint (globalID);
       cf_assert(localID < nbLocalNodes);
       isFound = true;
       nodesData = &localNodesData;
@@ -1679,7 +1688,7 @@ void ParCFmeshBinaryFileReader::createNodesAll(const vector<CFreal>& localNodesD
     }
     else if (hasEntry(m_ghostNodeIDs, globalID)) {
       countLocals++;
-      localID = nodes.addGhostPoint (globalID);
+      localID = isRenumbered ? m_mapGlobToLocNodeID.find(globalID) : nodes.addGhostPoint (globalID);
       cf_assert(localID < nbLocalNodes);
       isGhost = true;
       isFound = true;
@@ -1764,6 +1773,12 @@ void ParCFmeshBinaryFileReader::createStatesAll(const vector<CFreal>& localState
   }
   sort(globalIDs.begin(), globalIDs.end());
   
+  // renumbered states are registered beforehand in the local order
+  const bool isRenumbered = !m_orderedStateIDs.empty();
+  if (isRenumbered) {
+    addPointsInLocalOrder(states, m_orderedStateIDs, m_localStateIDs);
+  }
+  
   bool hasTransformer = false;
   if (m_inputToUpdateVecStr != "Identity") {
     hasTransformer = true;
@@ -1781,7 +1796,7 @@ void ParCFmeshBinaryFileReader::createStatesAll(const vector<CFreal>& localState
     CFuint* countBuf = NULL; 
     if (hasEntry(m_localStateIDs, globalID)) {
       countLocals++;
-      localID = states.addLocalPoint (globalID);
+      localID = isRenumbered ? m_mapGlobToLocStateID.find(globalID) : states.addLocalPoint (globalID);
       cf_assert(localID < nbLocalStates);
       isFound = true;
       statesData = &localStatesData;
@@ -1789,7 +1804,7 @@ void ParCFmeshBinaryFileReader::createStatesAll(const vector<CFreal>& localState
     }
     else if (hasEntry(m_ghostStateIDs, globalID)) {
       countLocals++;
-      localID = states.addGhostPoint (globalID);
+      localID = isRenumbered ? m_mapGlobToLocStateID.find(globalID) : states.addGhostPoint (globalID);
       cf_assert(localID < nbLocalStates);
       isGhost = true;
       isFound = true;
@@ -2096,6 +2111,131 @@ void ParCFmeshBinaryFileReader::setReadingRanges
 //////////////////////////////////////////////////////////////////////
 
 void ParCFmeshBinaryFileReader::readStateList(MPI_File* fh)
+{
+  if (m_solutionFile == "") {
+    readStateListData(fh);
+    return;
+  }
+  
+  CFLogDebugMin( "ParCFmeshBinaryFileReader::readStateList() start\n");
+  
+  // skip the states stored in the mesh file, if any
+  CFuint flag = 0;
+  MPIIOFunctions::readScalar(fh, flag);
+  char c; MPIIOFunctions::readScalar(fh, c);
+  if (flag) {
+    MPI_Offset startListOffset;
+    MPI_File_get_position(*fh, &startListOffset);
+    MPI_Offset endPos = startListOffset + m_totNbStates*getStateSize()*sizeof(CFreal);
+    MPI_File_seek(*fh, endPos, MPI_SEEK_SET);
+  }
+  
+  readSolutionFile();
+  
+  CFLogDebugMin( "ParCFmeshBinaryFileReader::readStateList() end\n");
+}
+      
+//////////////////////////////////////////////////////////////////////
+
+void ParCFmeshBinaryFileReader::readSolutionFile()
+{
+  CFLogDebugMin( "ParCFmeshBinaryFileReader::readSolutionFile() start\n");
+  
+  boost::filesystem::path filepath = 
+    Environment::DirPaths::getInstance().getWorkingDir() / m_solutionFile;
+  CFLog(INFO, "ParCFmeshBinaryFileReader::readSolutionFile() => reading states from " 
+	<< filepath.string() << "\n");
+  
+  MPI_File fh;
+  char* fileName = const_cast<char*>(filepath.string().c_str());
+  if (MPI_File_open(m_comm, fileName, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+    throw Common::FilesystemException 
+      (FromHere(), "ParCFmeshBinaryFileReader => cannot open solution file " + filepath.string());
+  }
+  
+  // the state data described in the solution file replace those of the mesh
+  m_hasPastStates = false;
+  m_hasInterStates = false;
+  getReadData().setNbExtraStateVars(0);
+  
+  uint64_t signature = 0;
+  bool hasSignature = false;
+  for (;;) {
+    const string key = MPIIOFunctions::readAndTrimString(&fh);
+    if (key == "!LIST_STATE") break;
+    
+    if (key == getReaderTerminator()) {
+      throw BadFormatException 
+	(FromHere(), "ParCFmeshBinaryFileReader => no state list in " + filepath.string());
+    }
+    
+    if (key == "!MESH_SIGNATURE") {
+      MPI_Status status;
+      MPI_File_read_all(fh, &signature, 1, MPI_UINT64_T, &status);
+      hasSignature = true;
+    }
+    else if (key == "!NB_STATES") {
+      CFuint nbStates = 0;
+      CFint nbNonUpdatableStates = 0;
+      MPIIOFunctions::readScalar(&fh, nbStates);
+      MPIIOFunctions::readScalar(&fh, nbNonUpdatableStates);
+      if (nbStates != m_totNbStates) {
+	throw BadFormatException 
+	  (FromHere(), "ParCFmeshBinaryFileReader => number of states in solution file differs from the mesh");
+      }
+    }
+    else {
+      readKey(&fh, key);
+    }
+  }
+  
+  if (!hasSignature) {
+    throw BadFormatException 
+      (FromHere(), "ParCFmeshBinaryFileReader => no mesh signature in " + filepath.string());
+  }
+  
+  readStateListData(&fh);
+  MPI_File_close(&fh);
+  
+  // the states are now created: compare the signature of the mesh read 
+  // so far with the one of the mesh the solution was written from
+  const std::string nsp = MeshDataStack::getActive()->getPrimaryNamespace();
+  DataHandle<Node*,GLOBAL> nodes = MeshDataStack::getActive()->getDataStorage()->
+    getGlobalData<Node*>(nsp + "_nodes");
+  DataHandle<State*,GLOBAL> states = MeshDataStack::getActive()->getDataStorage()->
+    getGlobalData<State*>(nsp + "_states");
+  
+  const uint64_t meshSignature = computeMeshSignature
+    (*getReadData().getElementNodeTable(), *getReadData().getElementStateTable(),
+     nodes, states, m_totNbNodes, m_totNbStates, m_totNbElem, m_comm);
+  if (meshSignature != signature) {
+    throw BadFormatException 
+      (FromHere(), "ParCFmeshBinaryFileReader => solution file " + filepath.string() + 
+       " was not written from the mesh being read");
+  }
+  
+  CFLogDebugMin( "ParCFmeshBinaryFileReader::readSolutionFile() end\n");
+}
+      
+//////////////////////////////////////////////////////////////////////
+
+CFuint ParCFmeshBinaryFileReader::getStateSize()
+{
+  cf_assert(m_originalNbEqs > 0);
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  CFuint stateSize = m_originalNbEqs;
+  if (m_hasPastStates) {stateSize += nbEqs;}
+  if (m_hasInterStates) {stateSize += nbEqs;}
+  if (getReadData().getNbExtraStateVars() > 0) {
+    const vector<CFuint>& strides = *getReadData().getExtraStateVarStrides();
+    stateSize += std::accumulate(strides.begin(), strides.end(), 0);
+  }
+  return stateSize;
+}
+      
+//////////////////////////////////////////////////////////////////////
+
+void ParCFmeshBinaryFileReader::readStateListData(MPI_File* fh)
 {
   CFLogDebugMin( "ParCFmeshBinaryFileReader::readStateList() start\n");
   
@@ -2151,13 +2291,6 @@ void ParCFmeshBinaryFileReader::readStateList(MPI_File* fh)
   }
   
   const CFuint nbExtraVars = getReadData().getNbExtraStateVars();
-  const vector<CFuint>& stateExtraVarsStrides = *getReadData().getExtraStateVarStrides();
-  RealVector extraVars;
-  if (nbExtraVars > 0) {
-    const CFuint sizeExtraVars = std::accumulate(stateExtraVarsStrides.begin(), stateExtraVarsStrides.end(), 0);
-    extraVars.resize(sizeExtraVars, 0.);
-  }
-  
   getReadData().prepareStateExtraVars();
   
   CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readStateList() => nbExtraVars = " << nbExtraVars << "\n");
@@ -2206,11 +2339,7 @@ void ParCFmeshBinaryFileReader::readStateList(MPI_File* fh)
     m_inputToUpdateVecTrans->setup(1);
   }
   
-  CFuint stateSize = m_originalNbEqs;
-  cf_assert(m_originalNbEqs > 0);
-  if (m_hasPastStates) {stateSize += nbEqs;}
-  if (m_hasInterStates) {stateSize += nbEqs;}
-  if (nbExtraVars > 0) {stateSize += extraVars.size();}
+  const CFuint stateSize = getStateSize();
   
   CFLog(VERBOSE, "ParCFmeshBinaryFileReader::readStateList() => stateSize = " << stateSize << "\n");
   
@@ -51,6 +51,9 @@ protected: // functions
   /// Read an entry in the .CFmesh file
   bool readString(MPI_File* fh);
   
+  /// Read the data following the given key in the .CFmesh file
+  void readKey(MPI_File* fh, const std::string& key);
+  
   /// Get the name of the reader
   virtual const std::string getReaderName() const
   {
@@ -171,8 +174,16 @@ private: // member functions
   /// Reads the list of nodes
   void readNodeList(MPI_File* fh);
 
-  /// Reads the list of state tensors and initialize the dofs
+  /// Reads the list of state tensors and initialize the dofs, taking them
+  /// from the solution file if one is given
   void readStateList(MPI_File* fh);
+  /// Reads the list of state tensors from the given file
+  void readStateListData(MPI_File* fh);
+  /// Reads the header and the states of the solution file and checks that
+  /// it was written from the same mesh
+  void readSolutionFile();
+  /// Get the number of values stored for each state in the file
+  CFuint getStateSize();
 
   /// Reads the data concerning the elements
   void readElementList(MPI_File* fh);
@@ -289,6 +300,9 @@ private: // member functions
   /// maximu size of the buffer to write with MPI I/O
   int m_maxBuffSize;
   
+  /// name of the solution-only file (.CFsol) to read the states from
+  std::string m_solutionFile;
+  
 }; // class ParCFmeshBinaryFileReader
 
 //////////////////////////////////////////////////////////////////////////////
@@ -4,7 +4,9 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <algorithm>
 #include <numeric>
+#include <cstring>
 
 #include <boost/progress.hpp>
 
@@ -15,6 +17,7 @@
 #include "Common/StringOps.hh"
 #include "Common/SwapEmpty.hh"
 #include "Common/BadValueException.hh"
+#include "Common/ConnectivityTable.hh"
 
 #include "Environment/FileHandlerInput.hh"
 #include "Environment/SingleBehaviorFactory.hh"
@@ -23,8 +26,11 @@
 #include "Framework/MeshData.hh"
 #include "Framework/VarSetTransformer.hh"
 #include "Framework/MeshPartitioner.hh"
+#include "Framework/PartitionerPeriodicTools.hh"
 #include "Framework/SubSystemStatus.hh"
 
+#include "MathTools/RCM.h"
+
 #include "CFmeshFileReader/ParCFmeshFileReader.hh"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -41,6 +47,32 @@ namespace COOLFluiD {
 
 //////////////////////////////////////////////////////////////////////////////
 
+/// Read an array of values with the text scanner, if given, or from the stream
+template <typename ARRAY>
+static inline void readValues(ifstream& fin, CFmeshTextScanner* scanner, ARRAY& values)
+{
+  if (scanner != CFNULL) {
+    scanner->read(&values[0], values.size());
+  }
+  else {
+    fin >> values;
+  }
+}
+
+/// Read an unsigned integer with the text scanner, if given, or from the stream
+template <typename T>
+static inline void readUIntValue(ifstream& fin, CFmeshTextScanner* scanner, T& value)
+{
+  if (scanner != CFNULL) {
+    scanner->readUInt(value);
+  }
+  else {
+    fin >> value;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 ParCFmeshFileReader::ParCFmeshFileReader() :
   FileReader(),
   ConfigObject("ParCFmeshFileReader"),
@@ -95,6 +127,15 @@ ParCFmeshFileReader::ParCFmeshFileReader() :
   
   m_inputToUpdateVecStr = "Identity";
   setParameter("InputToUpdate",&m_inputToUpdateVecStr);
+  
+  m_partitionCacheFile = "";
+  setParameter("PartitionCacheFile",&m_partitionCacheFile);
+  
+  m_useTextScanner = false;
+  setParameter("UseTextScanner",&m_useTextScanner);
+  
+  m_localRenumbering = "None";
+  setParameter("LocalRenumbering",&m_localRenumbering);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -114,6 +155,15 @@ void ParCFmeshFileReader::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< std::vector<std::string> > ("MergeTRS", "Topological regions sets to be merged");
 
   options.addConfigOption< std::string >("InputToUpdate", "Transformer from input to update variables");
+
+  options.addConfigOption< std::string >
+    ("PartitionCacheFile", "File where the partitioning is saved and reused for the same mesh and number of processors (none if empty)");
+  
+  options.addConfigOption< bool >
+    ("UseTextScanner", "Read the lists of nodes, states and elements from the file mapped in memory, converting only the local entries");
+  
+  options.addConfigOption< std::string >
+    ("LocalRenumbering", "Renumbering of the local states, nodes, elements and boundary faces after the partitioning to improve memory locality (None, RCM)");
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -198,6 +248,31 @@ void ParCFmeshFileReader::setup()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void ParCFmeshFileReader::readFromFile(const boost::filesystem::path& filepath)
+{
+  m_filePath = filepath;
+  FileReader::readFromFile(filepath);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFmeshTextScanner* ParCFmeshFileReader::getTextScanner(ifstream& fin)
+{
+  if (!m_useTextScanner || m_filePath.empty()) return CFNULL;
+  
+  if (!m_textScanner.isOpen() && !m_textScanner.open(m_filePath)) {
+    CFLog(WARN, "ParCFmeshFileReader::getTextScanner() => cannot map "
+	  << m_filePath.string() << ", reading from stream\n");
+    m_useTextScanner = false;
+    return CFNULL;
+  }
+  
+  m_textScanner.seek(fin.tellg());
+  return &m_textScanner;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ParCFmeshFileReader::setMapString2Readers()
 {
   m_mapString2Reader["!COOLFLUID_VERSION"]     = &ParCFmeshFileReader::readCFVersion;
@@ -776,6 +851,12 @@ void ParCFmeshFileReader::readNodeList(ifstream& fin)
   
   nodes.setMapGhost2DonorRanks(m_gNodeID2DonorRank);
   
+  // renumbered nodes are registered beforehand in the local order
+  const bool isRenumbered = !m_orderedNodeIDs.empty();
+  if (isRenumbered) {
+    addPointsInLocalOrder(nodes, m_orderedNodeIDs, m_localNodeIDs);
+  }
+  
   RealVector tmpNode(0.0, dim);
   RealVector tmpPastNode(0.0, dim);
   RealVector tmpInterNode(0.0, dim);
@@ -811,41 +892,51 @@ void ParCFmeshFileReader::readNodeList(ifstream& fin)
 
   getReadData().prepareNodalExtraVars();
 
+  // the nodes which are not local are skipped by the text scanner
+  CFmeshTextScanner* scanner = getTextScanner(fin);
+  const CFuint nodeSize = dim*(1 + (m_hasPastNodes ? 1 : 0) + (m_hasInterNodes ? 1 : 0)) +
+    ((nbExtraVars > 0) ? extraVars.size() : 0);
+  
   CFuint countLocals = 0;
   for (CFuint iNode = 0; iNode < m_totNbNodes; ++iNode) {
 
-    // read the node
-    fin >> tmpNode;
-
-    if (m_hasPastNodes) {
-      fin >> tmpPastNode;
-    }
-
-    if (m_hasInterNodes) {
-      fin >> tmpInterNode;
-    }
-
-    if (nbExtraVars > 0) {
-      fin >> extraVars;
-    }
-
     CFuint localID = 0;
     bool isGhost = false;
     bool isFound = false;
     if (hasEntry(m_localNodeIDs, iNode)) {
       countLocals++;
-      localID = nodes.addLocalPoint (iNode);
+      localID = isRenumbered ? m_mapGlobToLocNodeID.find(iNode) : nodes.addLocalPoint (iNode);
       cf_assert(localID < nbLocalNodes);
       isFound = true;
     }
     else if (hasEntry(m_ghostNodeIDs, iNode)) {
       countLocals++;
-      localID = nodes.addGhostPoint (iNode);
+      localID = isRenumbered ? m_mapGlobToLocNodeID.find(iNode) : nodes.addGhostPoint (iNode);
       cf_assert(localID < nbLocalNodes);
       isGhost = true;
       isFound = true;
     }
     
+    if (scanner != CFNULL && !isFound) {
+      scanner->skip(nodeSize);
+      continue;
+    }
+    
+    // read the node
+    readValues(fin, scanner, tmpNode);
+
+    if (m_hasPastNodes) {
+      readValues(fin, scanner, tmpPastNode);
+    }
+
+    if (m_hasInterNodes) {
+      readValues(fin, scanner, tmpInterNode);
+    }
+
+    if (nbExtraVars > 0) {
+      readValues(fin, scanner, extraVars);
+    }
+    
     if (isFound) {
       Node* newNode = getReadData().createNode
 	(localID, nodes.getGlobalData(localID), tmpNode, !isGhost);
@@ -865,6 +956,8 @@ void ParCFmeshFileReader::readNodeList(ifstream& fin)
     }
   }
 
+  releaseTextScanner(scanner, fin);
+  
   cf_assert(countLocals == nbLocalNodes);
 
   CFLogDebugMin("countLocals  = " << countLocals << "\n");
@@ -972,7 +1065,13 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
   sort(m_ghostStateIDs.begin(), m_ghostStateIDs.end());
   
   states.setMapGhost2DonorRanks(m_gStateID2DonorRank);
-    
+  
+  // renumbered states are registered beforehand in the local order
+  const bool isRenumbered = !m_orderedStateIDs.empty();
+  if (isRenumbered) {
+    addPointsInLocalOrder(states, m_orderedStateIDs, m_localStateIDs);
+  }
+  
   State tmpState;
   State dummyReadState;
   RealVector tmpPastState(0.0, nbEqs);
@@ -1056,28 +1155,58 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
     m_inputToUpdateVecTrans->setup(1);
   }
   
+  // the states which are not local are skipped by the text scanner
+  CFmeshTextScanner* scanner = isWithSolution ? getTextScanner(fin) : CFNULL;
+  CFuint stateSize = m_originalNbEqs + ((m_hasPastStates ? 1 : 0) + (m_hasInterStates ? 1 : 0))*nbEqs +
+    ((nbExtraVars > 0) ? extraVars.size() : 0);
+  if (m_useInitValues.size() > 0 && m_originalNbEqs > nbEqs) {
+    stateSize += m_originalNbEqs - nbEqs;
+  }
+  
   CFuint countLocals = 0;
   for (CFuint iState = 0; iState < m_totNbStates; ++iState)
   {
+    CFuint localID = 0;
+    bool isGhost = false;
+    bool isFound = false;
+    if (hasEntry(m_localStateIDs, iState)) {
+      countLocals++;
+      localID = isRenumbered ? m_mapGlobToLocStateID.find(iState) : states.addLocalPoint (iState);
+      cf_assert(localID < nbLocalStates);
+      isFound = true;
+    }
+    else if (hasEntry(m_ghostStateIDs, iState)) {
+      countLocals++;
+      localID = isRenumbered ? m_mapGlobToLocStateID.find(iState) : states.addGhostPoint (iState);
+      cf_assert(localID < nbLocalStates);
+      isGhost = true;
+      isFound = true;
+    }
+    
+    if (scanner != CFNULL && !isFound) {
+      scanner->skip(stateSize);
+      continue;
+    }
+    
     // read the state
     if (isWithSolution) 
     {      
       // no init values were used
       if (m_useInitValues.size() == 0)
       {
-	fin >> readState;
+	readValues(fin, scanner, readState);
 
         if (m_hasPastStates) 
         {
-          fin >> tmpPastState;
+          readValues(fin, scanner, tmpPastState);
         }
 	
 	if (m_hasInterStates) {
-          fin >> tmpInterState;
+          readValues(fin, scanner, tmpInterState);
         }
 
         if (nbExtraVars > 0) {
-          fin >> extraVars;
+          readValues(fin, scanner, extraVars);
         }
 
         if (!hasTransformer) {
@@ -1097,18 +1226,18 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
       // using init values
       else {
 	cf_assert(m_useInitValues.size() == nbEqs);
-	fin >> readState;
+	readValues(fin, scanner, readState);
 	
 	if (m_hasPastStates) {
-	  fin >> tmpPastState;
+	  readValues(fin, scanner, tmpPastState);
 	}
 	
 	if (m_hasInterStates) {
-	  fin >> tmpInterState;
+	  readValues(fin, scanner, tmpInterState);
 	}
 	
 	if (nbExtraVars > 0) {
-	  fin >> extraVars;
+	  readValues(fin, scanner, extraVars);
 	}
 	
 	for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
@@ -1143,29 +1272,17 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
         {
 	  for (CFuint iEq = nbEqs; iEq < m_originalNbEqs; ++iEq)
 	  {
-            fin >> readState[iEq];
+            if (scanner != CFNULL) {
+              readState[iEq] = scanner->readReal();
+            }
+            else {
+              fin >> readState[iEq];
+            }
           }
         }
       }
     }
 
-    CFuint localID = 0;
-    bool isGhost = false;
-    bool isFound = false;
-    if (hasEntry(m_localStateIDs, iState)) {
-      countLocals++;
-      localID = states.addLocalPoint (iState);
-      cf_assert(localID < nbLocalStates);
-      isFound = true;
-    }
-    else if (hasEntry(m_ghostStateIDs, iState)) {
-      countLocals++;
-      localID = states.addGhostPoint (iState);
-      cf_assert(localID < nbLocalStates);
-      isGhost = true;
-      isFound = true;
-    }
-
     if (isFound) {
       State* newState = getReadData().createState
   (localID, states.getGlobalData(localID), tmpState, !isGhost);
@@ -1188,6 +1305,8 @@ void ParCFmeshFileReader::readStateList(ifstream& fin)
     }
   }
 
+  releaseTextScanner(scanner, fin);
+  
   cf_assert(countLocals == nbLocalStates);
 
   CFLogDebugMin( "ParCFmeshFileReader::readStateList() end\n");
@@ -1323,15 +1442,55 @@ void ParCFmeshFileReader::readElementList(ifstream& fin)
   CFLog(DEBUG_MAX, CFPrintContainer<vector<PartitionerData::IndexT> >("pdata.elemNode = ", &pdata.elemNode));
   CFLog(DEBUG_MAX, CFPrintContainer<vector<PartitionerData::IndexT> >("pdata.elmdist  = ", &pdata.elmdist));
   
+  partitionElements(pdata);
+  
+  // move the elements data to the right processor
+  // and build info about the overlap region
+  m_local_elem = new ElementDataArray<0>;
+  moveElementData(*m_local_elem, pdata);
+
+  cf_assert(m_localNodeIDs.size() > 0);
+  cf_assert(m_localStateIDs.size() > 0);
+
+  // renumber the local nodes/states to improve the memory locality
+  computeLocalOrdering(*m_local_elem);
+  
+  // set mapping between global and local node/state IDs
+  setMapGlobalToLocalID(m_localNodeIDs, m_ghostNodeIDs, m_orderedNodeIDs, m_mapGlobToLocNodeID);
+
+  setMapGlobalToLocalID(m_localStateIDs, m_ghostStateIDs, m_orderedStateIDs, m_mapGlobToLocStateID);
+
+  // set the elements in the readData
+  setElements(*m_local_elem);
+
+  setMapNodeElemID(*m_local_elem);
+
+  CFLogDebugMin( "ParCFmeshFileReader::readElementList() end\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshFileReader::partitionElements(PartitionerData& pdata)
+{
   // avoid mesh partitioning if you have just one processor
   if (m_nbProc > 1)
   {
     if (PhysicalModelStack::getActive()->getDim() > DIM_1D) {
-      m_partitioner->SetCommunicator(m_comm);
-      CFLog(NOTICE, "Calling mesh partitioner\n");
-      CFLog(NOTICE, "+++\n");
-      m_partitioner->doPartition(pdata);
-      CFLog(NOTICE, "+++\n");
+      const uint64_t hash = (m_partitionCacheFile != "") ? computePartitionHash(pdata) : 0;
+      if (m_partitionCacheFile != "" && readPartitionCache(pdata, hash)) {
+	CFLog(NOTICE, "Partitioning read from " << m_partitionCacheFile << "\n");
+      }
+      else {
+	m_partitioner->SetCommunicator(m_comm);
+	CFLog(NOTICE, "Calling mesh partitioner\n");
+	CFLog(NOTICE, "+++\n");
+	m_partitioner->doPartition(pdata);
+	CFLog(NOTICE, "+++\n");
+	
+	if (m_partitionCacheFile != "") {
+	  writePartitionCache(pdata, hash);
+	}
+      }
     }
     else {
       pdata.part->resize(m_nbElemPerProc[m_myRank], m_myRank);
@@ -1342,26 +1501,186 @@ void ParCFmeshFileReader::readElementList(ifstream& fin)
     cf_assert(m_myRank == 0);
     pdata.part->resize(m_nbElemPerProc[m_myRank], 0);
   }
-  
-  // move the elements data to the right processor
-  // and build info about the overlap region
-  m_local_elem = new ElementDataArray<0>;
-  moveElementData(*m_local_elem, pdata);
+}
 
-  cf_assert(m_localNodeIDs.size() > 0);
-  cf_assert(m_localStateIDs.size() > 0);
+//////////////////////////////////////////////////////////////////////////////
 
-  // set mapping between global and local node/state IDs
-  setMapGlobalToLocalID(m_localNodeIDs, m_ghostNodeIDs, m_mapGlobToLocNodeID);
+/// header of the partition cache file, followed by the processor ID
+/// of each element (int) in the global element order
+struct PartitionCacheHeader {
+  char magic[8];
+  uint64_t hash;
+  uint64_t nbProc;
+  uint64_t nbElem;
+};
 
-  setMapGlobalToLocalID(m_localStateIDs, m_ghostStateIDs, m_mapGlobToLocStateID);
+/// identifier and version of the partition cache file
+static const char partitionCacheMagic[8] = {'C','F','P','A','R','T','1','\0'};
 
-  // set the elements in the readData
-  setElements(*m_local_elem);
+/// 64-bit FNV-1a hash of a value, combined with the given hash
+static inline uint64_t hashCombine(uint64_t hash, uint64_t value)
+{
+  for (CFuint i = 0; i < 8; ++i) {
+    hash ^= (value >> (8*i)) & 0xff;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
 
-  setMapNodeElemID(*m_local_elem);
+//////////////////////////////////////////////////////////////////////////////
 
-  CFLogDebugMin( "ParCFmeshFileReader::readElementList() end\n");
+uint64_t ParCFmeshFileReader::computePartitionHash(const PartitionerData& pdata)
+{
+  // connectivity of the elements read by this processor
+  uint64_t localHash = 14695981039346656037ULL;
+  for (CFuint i = 0; i < pdata.eptrn.size(); ++i) {
+    localHash = hashCombine(localHash, pdata.eptrn[i]);
+  }
+  for (CFuint i = 0; i < pdata.elemNode.size(); ++i) {
+    localHash = hashCombine(localHash, pdata.elemNode[i]);
+  }
+  for (CFuint i = 0; i < pdata.eptrs.size(); ++i) {
+    localHash = hashCombine(localHash, pdata.eptrs[i]);
+  }
+  for (CFuint i = 0; i < pdata.elemState.size(); ++i) {
+    localHash = hashCombine(localHash, pdata.elemState[i]);
+  }
+  
+  vector<uint64_t> allHashes(m_nbProc);
+  MPIError::getInstance().check
+    ("MPI_Allgather", "ParCFmeshFileReader::computePartitionHash()",
+     MPI_Allgather(&localHash, 1, MPI_UINT64_T, &allHashes[0], 1, MPI_UINT64_T, m_comm));
+  
+  uint64_t hash = 14695981039346656037ULL;
+  for (CFuint i = 0; i < m_nbProc; ++i) {
+    hash = hashCombine(hash, allHashes[i]);
+  }
+  hash = hashCombine(hash, m_nbProc);
+  hash = hashCombine(hash, m_totNbElem);
+  hash = hashCombine(hash, m_totNbNodes);
+  hash = hashCombine(hash, m_totNbStates);
+  hash = hashCombine(hash, pdata.ndim);
+  for (CFuint i = 0; i < m_partitionerName.size(); ++i) {
+    hash = hashCombine(hash, m_partitionerName[i]);
+  }
+  
+  // options of the partitioner (e.g. ParMetis options and random seed)
+  vector<CFint> settings;
+  m_partitioner->getSettings(settings);
+  hash = hashCombine(hash, settings.size());
+  for (CFuint i = 0; i < settings.size(); ++i) {
+    hash = hashCombine(hash, settings[i]);
+  }
+  
+  // periodic nodes melded by the partitioner, if any
+  string name0, name1;
+  vector<int> idx0, idx1;
+  vector<CFreal> coord0, coord1;
+  PartitionerPeriodicTools::readPeriodicInfo(pdata.ndim, name0, idx0, coord0, name1, idx1, coord1);
+  const string names = name0 + " " + name1;
+  for (CFuint i = 0; i < names.size(); ++i) {
+    hash = hashCombine(hash, names[i]);
+  }
+  hash = hashCombine(hash, idx0.size());
+  for (CFuint i = 0; i < idx0.size(); ++i) {
+    hash = hashCombine(hash, idx0[i]);
+    hash = hashCombine(hash, idx1[i]);
+  }
+  for (CFuint i = 0; i < coord0.size(); ++i) {
+    uint64_t bits0 = 0;
+    uint64_t bits1 = 0;
+    memcpy(&bits0, &coord0[i], sizeof(CFreal));
+    memcpy(&bits1, &coord1[i], sizeof(CFreal));
+    hash = hashCombine(hash, bits0);
+    hash = hashCombine(hash, bits1);
+  }
+  
+  return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool ParCFmeshFileReader::readPartitionCache(PartitionerData& pdata, uint64_t hash)
+{
+  MPI_File fh;
+  char* fileName = const_cast<char*>(m_partitionCacheFile.c_str());
+  if (MPI_File_open(m_comm, fileName, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+    CFLog(INFO, "ParCFmeshFileReader::readPartitionCache() => no file " << m_partitionCacheFile << "\n");
+    return false;
+  }
+  
+  // all the processors read the same header and take the same decision
+  PartitionCacheHeader header;
+  MPI_Status status;
+  MPI_Offset fileSize = 0;
+  MPI_File_get_size(fh, &fileSize);
+  const MPI_Offset expectedSize = sizeof(PartitionCacheHeader) + (MPI_Offset)m_totNbElem*sizeof(int);
+  bool isValid = (fileSize == expectedSize);
+  if (isValid) {
+    MPI_File_read_at(fh, 0, &header, sizeof(PartitionCacheHeader), MPI_BYTE, &status);
+    isValid = std::equal(header.magic, header.magic + 8, partitionCacheMagic) &&
+      header.hash == hash && header.nbProc == m_nbProc && header.nbElem == m_totNbElem;
+  }
+  
+  if (isValid) {
+    const CFuint nbLocalElem = m_nbElemPerProc[m_myRank];
+    vector<int> part(nbLocalElem);
+    const MPI_Offset offset = sizeof(PartitionCacheHeader) + (MPI_Offset)pdata.elmdist[m_myRank]*sizeof(int);
+    MPIError::getInstance().check
+      ("MPI_File_read_at_all", "ParCFmeshFileReader::readPartitionCache()",
+       MPI_File_read_at_all(fh, offset, (nbLocalElem > 0) ? &part[0] : CFNULL, 
+			    nbLocalElem, MPI_INT, &status));
+    
+    pdata.part->resize(nbLocalElem);
+    for (CFuint i = 0; i < nbLocalElem; ++i) {
+      cf_assert(part[i] >= 0 && part[i] < (int)m_nbProc);
+      (*pdata.part)[i] = part[i];
+    }
+  }
+  else {
+    CFLog(INFO, "ParCFmeshFileReader::readPartitionCache() => " << m_partitionCacheFile 
+	  << " does not match the current mesh and settings\n");
+  }
+  
+  MPI_File_close(&fh);
+  return isValid;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshFileReader::writePartitionCache(const PartitionerData& pdata, uint64_t hash)
+{
+  MPI_File fh;
+  char* fileName = const_cast<char*>(m_partitionCacheFile.c_str());
+  if (MPI_File_open(m_comm, fileName, MPI_MODE_WRONLY | MPI_MODE_CREATE, 
+		    MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+    CFLog(WARN, "ParCFmeshFileReader::writePartitionCache() => cannot open " << m_partitionCacheFile << "\n");
+    return;
+  }
+  MPI_File_set_size(fh, 0);
+  
+  MPI_Status status;
+  if (m_myRank == 0) {
+    PartitionCacheHeader header;
+    std::copy(partitionCacheMagic, partitionCacheMagic + 8, header.magic);
+    header.hash = hash;
+    header.nbProc = m_nbProc;
+    header.nbElem = m_totNbElem;
+    MPI_File_write_at(fh, 0, &header, sizeof(PartitionCacheHeader), MPI_BYTE, &status);
+  }
+  
+  // each processor writes the IDs of the elements it has read
+  const CFuint nbLocalElem = pdata.part->size();
+  cf_assert(nbLocalElem == m_nbElemPerProc[m_myRank]);
+  vector<int> part(pdata.part->begin(), pdata.part->end());
+  const MPI_Offset offset = sizeof(PartitionCacheHeader) + (MPI_Offset)pdata.elmdist[m_myRank]*sizeof(int);
+  MPIError::getInstance().check
+    ("MPI_File_write_at_all", "ParCFmeshFileReader::writePartitionCache()",
+     MPI_File_write_at_all(fh, offset, (nbLocalElem > 0) ? &part[0] : CFNULL, 
+			   nbLocalElem, MPI_INT, &status));
+  
+  MPI_File_close(&fh);
+  CFLog(NOTICE, "Partitioning written in " << m_partitionCacheFile << "\n");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -1393,6 +1712,8 @@ void ParCFmeshFileReader::readElemListRank(PartitionerData& pdata,
   CFuint nodeID = 0;
   CFuint stateID = 0;
   
+  CFmeshTextScanner* scanner = getTextScanner(fin);
+  
   for (CFuint iType = 0; iType < m_totNbElemTypes; ++iType) {
     const CFuint nbNodesInElem  = (*elementType)[iType].getNbNodes();
     const CFuint nbStatesInElem = (*elementType)[iType].getNbStates();
@@ -1403,11 +1724,11 @@ void ParCFmeshFileReader::readElemListRank(PartitionerData& pdata,
     for (CFuint iElem = iElemBegin; iElem < iElemEnd; ++iElem) {
       if (iElem < start || iElem >= end) {
 	for (CFuint iNode = 0; iNode < nbNodesInElem; ++iNode) {
-	  fin >> nodeID;
+	  readUIntValue(fin, scanner, nodeID);
 	  checkDofID("node", iElem, iNode, nodeID, m_totNbNodes);
 	}
 	for (CFuint iState = 0; iState < nbStatesInElem; ++iState) {
-	  fin >> stateID;
+	  readUIntValue(fin, scanner, stateID);
 	  checkDofID("state", iElem, iState, stateID, m_totNbStates);
 	}
       }
@@ -1419,11 +1740,11 @@ void ParCFmeshFileReader::readElemListRank(PartitionerData& pdata,
 	eptrs[ipos] = scount;
 	
 	for (CFuint j = 0; j < nbNodesInElem; ++j, ++ncount) {
-	  fin >> eNode[ncount];
+	  readUIntValue(fin, scanner, eNode[ncount]);
 	  checkDofID("node", iElem, j, eNode[ncount], m_totNbNodes);
 	}
 	for (CFuint j = 0; j < nbStatesInElem; ++j, ++scount) {
-	  fin >> eState[scount];
+	  readUIntValue(fin, scanner, eState[scount]);
 	  checkDofID("state", iElem, j, eState[scount], m_totNbStates);
 	}
 	
@@ -1437,6 +1758,8 @@ void ParCFmeshFileReader::readElemListRank(PartitionerData& pdata,
     
     iElemBegin +=  nbElementsPerType;
   }
+  
+  releaseTextScanner(scanner, fin);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -1737,6 +2060,10 @@ void ParCFmeshFileReader::readGeomEntList(ifstream& fin)
     (*nbGeomEntsPerTR)[iTRS][iTR] = countGeos;
 
     cf_assert((*trsGlobalIDs)[iTRS][iTR].size() == countGeos);
+    
+    if (!m_orderedStateIDs.empty()) {
+      sortGeoConnByState(iTRS, iTR);
+    }
 
     CFLogDebugMin("Rank " << m_myRank << ", iTR = " << iTR
       << ", countGeos = " << countGeos << "\n");
@@ -2711,6 +3038,31 @@ void ParCFmeshFileReader::setElements(ElementDataArray<0>& localElem)
     elemIDPerType[etp].push_back(ne);
   }
   cf_assert(ne == nbLocalElems);
+  
+  // with renumbered states, the elements of each type follow their first state
+  if (!m_orderedStateIDs.empty()) {
+    vector<pair<CFuint,CFuint> > firstStateElem(nbLocalElems);
+    ne = 0;
+    for (it = localElem.begin(); it != localElem.end(); ++it, ++ne) {
+      CFuint firstState = m_mapGlobToLocStateID.find(it.getState(0));
+      const CFuint nbStatesInElem = it.get(ElementDataArray<0>::NB_STATES);
+      for (CFuint i = 1; i < nbStatesInElem; ++i) {
+	firstState = std::min(firstState, m_mapGlobToLocStateID.find(it.getState(i)));
+      }
+      firstStateElem[ne] = pair<CFuint,CFuint>(firstState, ne);
+    }
+    
+    for (CFuint iType = 0; iType < m_totNbElemTypes; ++iType) {
+      vector<pair<CFuint,CFuint> > sorted(elemIDPerType[iType].size());
+      for (CFuint i = 0; i < sorted.size(); ++i) {
+	sorted[i] = firstStateElem[elemIDPerType[iType][i]];
+      }
+      std::sort(sorted.begin(), sorted.end());
+      for (CFuint i = 0; i < sorted.size(); ++i) {
+	elemIDPerType[iType][i] = sorted[i].second;
+      }
+    }
+  }
 
   CFuint startIdx = 0;
   for (CFuint i = 0; i < m_totNbElemTypes; ++i) {
@@ -2807,9 +3159,22 @@ void ParCFmeshFileReader::setElements(ElementDataArray<0>& localElem)
 
 void ParCFmeshFileReader::setMapGlobalToLocalID(const vector<CFuint>& localIDs,
 						const vector<CFuint>& ghostIDs,
+						const vector<CFuint>& orderedIDs,
 						CFMap<CFuint,CFuint>& m)
 {
   const CFuint totCount = localIDs.size() + ghostIDs.size();
+  
+  // the local IDs have been renumbered
+  if (!orderedIDs.empty()) {
+    cf_assert(orderedIDs.size() == totCount);
+    m.reserve(totCount);
+    for (CFuint i = 0; i < totCount; ++i) {
+      m.insert(orderedIDs[i], i);
+    }
+    m.sortKeys();
+    return;
+  }
+  
   vector<CFuint> allIDs;
   allIDs.reserve(totCount);
 
@@ -2835,6 +3200,193 @@ void ParCFmeshFileReader::setMapGlobalToLocalID(const vector<CFuint>& localIDs,
 
 //////////////////////////////////////////////////////////////////////////////
 
+void ParCFmeshFileReader::computeLocalOrdering(ElementDataArray<0>& localElem)
+{
+  m_orderedStateIDs.clear();
+  m_orderedNodeIDs.clear();
+  
+  if (m_localRenumbering == "None") return;
+  if (m_localRenumbering != "RCM") {
+    throw BadValueException
+      (FromHere(), "ParCFmeshFileReader::computeLocalOrdering() => unknown LocalRenumbering <"
+       + m_localRenumbering + ">");
+  }
+  
+  // local and ghost IDs in increasing global order, which is
+  // the numbering of the local IDs if no renumbering is applied
+  vector<CFuint> stateIDs(m_localStateIDs);
+  stateIDs.insert(stateIDs.end(), m_ghostStateIDs.begin(), m_ghostStateIDs.end());
+  sort(stateIDs.begin(), stateIDs.end());
+  
+  vector<CFuint> nodeIDs(m_localNodeIDs);
+  nodeIDs.insert(nodeIDs.end(), m_ghostNodeIDs.begin(), m_ghostNodeIDs.end());
+  sort(nodeIDs.begin(), nodeIDs.end());
+  
+  const CFuint nbStates = stateIDs.size();
+  const CFuint nbNodes = nodeIDs.size();
+  const CFuint nbElems = localElem.getNbElements();
+  
+  // in cell centered meshes each cell is stored in the row of its state,
+  // so that the states are connected through the nodes (median dual graph),
+  // otherwise the states are connected through the elements
+  bool isCellCentered = (nbElems == nbStates);
+  ElementDataArray<0>::Itr it;
+  for (it = localElem.begin(); it != localElem.end() && isCellCentered; ++it) {
+    isCellCentered = (it.get(ElementDataArray<0>::NB_STATES) == 1);
+  }
+  
+  vector<CFuint> elemRow(nbElems);
+  valarray<CFuint> nbStatesInRow(nbElems);
+  valarray<CFuint> nbNodesInRow(nbElems);
+  CFuint ne = 0;
+  for (it = localElem.begin(); it != localElem.end(); ++it, ++ne) {
+    elemRow[ne] = (isCellCentered) ? (lower_bound(stateIDs.begin(), stateIDs.end(),
+						  it.getState(0)) - stateIDs.begin()) : ne;
+    nbStatesInRow[elemRow[ne]] = it.get(ElementDataArray<0>::NB_STATES);
+    nbNodesInRow[elemRow[ne]]  = it.get(ElementDataArray<0>::NB_NODES);
+  }
+  
+  ConnectivityTable<CFuint> cellstate(nbStatesInRow);
+  ConnectivityTable<CFuint> cellnode(nbNodesInRow);
+  ne = 0;
+  for (it = localElem.begin(); it != localElem.end(); ++it, ++ne) {
+    const CFuint row = elemRow[ne];
+    for (CFuint i = 0; i < nbStatesInRow[row]; ++i) {
+      cellstate(row,i) = lower_bound(stateIDs.begin(), stateIDs.end(), it.getState(i)) - stateIDs.begin();
+    }
+    for (CFuint i = 0; i < nbNodesInRow[row]; ++i) {
+      cellnode(row,i) = lower_bound(nodeIDs.begin(), nodeIDs.end(), it.getNode(i)) - nodeIDs.begin();
+    }
+  }
+  
+  ConnectivityTable<CFuint> statestate;
+  if (isCellCentered) {
+    RCM::transformCellNode2NodeNodeMedianDual(cellstate, cellnode, statestate);
+  }
+  else {
+    RCM::transformCellNode2NodeNode(cellstate, statestate);
+  }
+  
+  if (statestate.nbRows() != nbStates) {
+    CFLog(WARN, "ParCFmeshFileReader::computeLocalOrdering() => some states are not referenced by the local elements, no renumbering\n");
+    return;
+  }
+  
+  vector<CFuint> newToOld;
+  RCM::computeOrdering(statestate, newToOld);
+  
+  // in cell centered meshes the local element ID must be equal to the
+  // local state ID, with the elements ordered by type
+  if (isCellCentered && m_totNbElemTypes > 1) {
+    SafePtr< vector<ElementTypeData> > elementType = getReadData().getElementTypeData();
+    vector<CFuint> stateType(nbStates);
+    ne = 0;
+    for (it = localElem.begin(); it != localElem.end(); ++it, ++ne) {
+      stateType[elemRow[ne]] = getElementType(*elementType, it.get(ElementDataArray<0>::GLOBAL_ID));
+    }
+    
+    vector<pair<CFuint,CFuint> > typeState(nbStates);
+    for (CFuint i = 0; i < nbStates; ++i) {
+      typeState[i] = pair<CFuint,CFuint>(stateType[newToOld[i]], i);
+    }
+    sort(typeState.begin(), typeState.end());
+    vector<CFuint> newToOldByType(nbStates);
+    for (CFuint i = 0; i < nbStates; ++i) {
+      newToOldByType[i] = newToOld[typeState[i].second];
+    }
+    newToOld.swap(newToOldByType);
+  }
+  
+  vector<CFuint> oldToNew(nbStates);
+  m_orderedStateIDs.resize(nbStates);
+  for (CFuint i = 0; i < nbStates; ++i) {
+    oldToNew[newToOld[i]] = i;
+    m_orderedStateIDs[i] = stateIDs[newToOld[i]];
+  }
+  
+  // bandwidth of the state graph before and after the renumbering
+  CFuint oldBandwidth = 0;
+  CFuint newBandwidth = 0;
+  for (CFuint i = 0; i < nbStates; ++i) {
+    const CFuint nbNeighbors = statestate.nbCols(i);
+    for (CFuint j = 0; j < nbNeighbors; ++j) {
+      const CFuint n = statestate(i,j);
+      oldBandwidth = std::max(oldBandwidth, (i > n) ? i - n : n - i);
+      const CFuint ni = oldToNew[i];
+      const CFuint nn = oldToNew[n];
+      newBandwidth = std::max(newBandwidth, (ni > nn) ? ni - nn : nn - ni);
+    }
+  }
+  
+  // the nodes are numbered as they are first met
+  // while looping over the elements in the order of their states
+  vector<pair<CFuint,CFuint> > firstStateElem(nbElems);
+  for (CFuint iElem = 0; iElem < nbElems; ++iElem) {
+    const CFuint row = elemRow[iElem];
+    CFuint firstState = oldToNew[cellstate(row,0)];
+    for (CFuint i = 1; i < nbStatesInRow[row]; ++i) {
+      firstState = std::min(firstState, oldToNew[cellstate(row,i)]);
+    }
+    firstStateElem[iElem] = pair<CFuint,CFuint>(firstState, row);
+  }
+  sort(firstStateElem.begin(), firstStateElem.end());
+  
+  vector<bool> isNumbered(nbNodes, false);
+  m_orderedNodeIDs.reserve(nbNodes);
+  for (CFuint iElem = 0; iElem < nbElems; ++iElem) {
+    const CFuint row = firstStateElem[iElem].second;
+    for (CFuint i = 0; i < nbNodesInRow[row]; ++i) {
+      const CFuint nodeIdx = cellnode(row,i);
+      if (!isNumbered[nodeIdx]) {
+	isNumbered[nodeIdx] = true;
+	m_orderedNodeIDs.push_back(nodeIDs[nodeIdx]);
+      }
+    }
+  }
+  
+  // nodes not referenced by any element keep their relative order at the end
+  for (CFuint i = 0; i < nbNodes; ++i) {
+    if (!isNumbered[i]) {
+      m_orderedNodeIDs.push_back(nodeIDs[i]);
+    }
+  }
+  cf_assert(m_orderedNodeIDs.size() == nbNodes);
+  
+  CFLog(INFO, "ParCFmeshFileReader::computeLocalOrdering() => RCM renumbering of "
+	<< nbStates << " states and " << nbNodes << " nodes, bandwidth "
+	<< oldBandwidth << " => " << newBandwidth << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshFileReader::sortGeoConnByState(CFuint iTRS, CFuint iTR)
+{
+  GeoConn& geoConn = getReadData().getTRGeoConn(iTRS)[iTR];
+  vector<CFuint>& globalGeoIDs =
+    (*MeshDataStack::getActive()->getGlobalTRSGeoIDs())[iTRS][iTR];
+  
+  const CFuint nbGeos = geoConn.size();
+  cf_assert(globalGeoIDs.size() == nbGeos);
+  
+  vector<pair<CFuint,CFuint> > stateGeo(nbGeos);
+  for (CFuint iGeo = 0; iGeo < nbGeos; ++iGeo) {
+    const CFuint stateID = (geoConn[iGeo].second.size() > 0) ? geoConn[iGeo].second[0] : 0;
+    stateGeo[iGeo] = pair<CFuint,CFuint>(stateID, iGeo);
+  }
+  sort(stateGeo.begin(), stateGeo.end());
+  
+  GeoConn sortedGeoConn(nbGeos);
+  vector<CFuint> sortedGlobalGeoIDs(nbGeos);
+  for (CFuint iGeo = 0; iGeo < nbGeos; ++iGeo) {
+    sortedGeoConn[iGeo] = geoConn[stateGeo[iGeo].second];
+    sortedGlobalGeoIDs[iGeo] = globalGeoIDs[stateGeo[iGeo].second];
+  }
+  geoConn.swap(sortedGeoConn);
+  globalGeoIDs.swap(sortedGlobalGeoIDs);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void ParCFmeshFileReader::setMapNodeElemID(ElementDataArray<0>& localElem)
 {
   // calculate the size of the map to be able to preallocate
@@ -2862,6 +3414,7 @@ void ParCFmeshFileReader::setMapNodeElemID(ElementDataArray<0>& localElem)
 
 void ParCFmeshFileReader::finish()
 {
+  m_textScanner.close();
   SwapEmpty(m_localNodeIDs);
   SwapEmpty(m_localStateIDs);
   SwapEmpty(m_ghostNodeIDs);
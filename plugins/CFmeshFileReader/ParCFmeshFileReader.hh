@@ -9,6 +9,8 @@
 
 //////////////////////////////////////////////////////////////////////////////
 
+#include <stdint.h>
+
 #include "Common/CFMultiMap.hh"
 #include "Common/FilesystemException.hh"
 #include "Common/MPI/MPIError.hh"
@@ -21,6 +23,7 @@
 #include "Framework/ElementDataArray.hh"
 
 #include "CFmeshFileReader/CFmeshFileReaderAPI.hh"
+#include "CFmeshFileReader/CFmeshTextScanner.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -59,6 +62,9 @@ public: // member functions
   
   /// Sets up private data
   virtual void setup();
+  
+  /// Reads the file, remembering its path for the text scanner
+  virtual void readFromFile(const boost::filesystem::path& filepath);
     
   /// Sets the pointer to the stored data
   void setReadData(const Common::SafePtr<Framework::CFmeshReaderSource>& data)
@@ -335,8 +341,33 @@ protected: // member functions
   /// Ineffective reading of the state list
   void emptyStateListRead(std::ifstream& fin);
 
+  /// Get the text scanner positioned where the given stream is
+  /// @return CFNULL if the text scanner is not used
+  CFmeshTextScanner* getTextScanner(std::ifstream& fin);
+  
+  /// Give back to the stream the position reached by the text scanner
+  void releaseTextScanner(CFmeshTextScanner* scanner, std::ifstream& fin)
+  {
+    if (scanner != CFNULL) fin.seekg(scanner->tell());
+  }
+
  protected:
   
+  /// Assign each locally read element to a processor, either by calling the
+  /// mesh partitioner or by reading the partition cache file, if valid
+  void partitionElements(Framework::PartitionerData& pdata);
+  
+  /// Compute a hash of the mesh and of the partitioning settings,
+  /// identical on all the processors
+  uint64_t computePartitionHash(const Framework::PartitionerData& pdata);
+  
+  /// Read the processor IDs of the locally read elements from the partition cache file
+  /// @return false if the file does not exist or does not match the given hash
+  bool readPartitionCache(Framework::PartitionerData& pdata, uint64_t hash);
+  
+  /// Write the processor IDs of the locally read elements in the partition cache file
+  void writePartitionCache(const Framework::PartitionerData& pdata, uint64_t hash);
+  
   /// Set the element distribution array
   void setElmDistArray(std::vector<Framework::PartitionerData::IndexT>& elmdist);
   
@@ -406,10 +437,36 @@ protected: // member functions
 			  std::vector<CFuint>& mlocalDofIDs);
   
   /// Set the mapping between the global and the local node (or state) ID
+  /// @param orderedIDs  global IDs in the order of the local IDs, if empty
+  ///                    the local IDs follow the global ones
   void setMapGlobalToLocalID(const std::vector<CFuint>& localIDs,
 			     const std::vector<CFuint>& ghostIDs,
+			     const std::vector<CFuint>& orderedIDs,
 			     Common::CFMap<CFuint,CFuint>& m);
   
+  /// Compute a locality preserving order of the local and ghost states
+  /// and nodes of the partition, according to the "LocalRenumbering" option
+  void computeLocalOrdering(Framework::ElementDataArray<0>& localElem);
+  
+  /// Sort the geometric entities of the given TR by neighbor state,
+  /// together with their global IDs
+  void sortGeoConnByState(CFuint iTRS, CFuint iTR);
+  
+  /// Register the local and ghost points of the given parallel vector
+  /// in the order computed by computeLocalOrdering()
+  template <typename T>
+  void addPointsInLocalOrder(Framework::DataHandle<T*, Framework::GLOBAL>& dofs,
+			     const std::vector<CFuint>& orderedIDs,
+			     const std::vector<CFuint>& localIDs)
+  {
+    for (CFuint i = 0; i < orderedIDs.size(); ++i) {
+      const CFuint globalID = orderedIDs[i];
+      const CFuint localID = hasEntry(localIDs, globalID) ?
+	dofs.addLocalPoint(globalID) : dofs.addGhostPoint(globalID);
+      cf_always_assert(localID == i);
+    }
+  }
+  
   /// Set the mapping between the global nodeID and the local elementID
   void setMapNodeElemID(Framework::ElementDataArray<0>& localElem);
   
@@ -569,6 +626,28 @@ protected: // member functions
   /// partitioner name
   std::string m_partitionerName;
 
+  /// file storing the partitioning to be reused by later runs
+  std::string m_partitionCacheFile;
+
+  /// flag telling to read the lists of nodes, states and elements
+  /// with the text scanner instead of the std::ifstream
+  bool m_useTextScanner;
+
+  /// algorithm to renumber the local states and nodes after the partitioning
+  std::string m_localRenumbering;
+
+  /// global state IDs in the order of the local state IDs (empty if not renumbered)
+  std::vector<CFuint> m_orderedStateIDs;
+
+  /// global node IDs in the order of the local node IDs (empty if not renumbered)
+  std::vector<CFuint> m_orderedNodeIDs;
+
+  /// path of the file being read
+  boost::filesystem::path m_filePath;
+
+  /// scanner of the file being read
+  CFmeshTextScanner m_textScanner;
+
   /// config option for merging th TRS's
   std::vector<std::string> m_merge_trs;
 
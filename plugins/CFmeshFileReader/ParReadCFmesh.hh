@@ -56,6 +56,9 @@ private: // data
   /// user option to renumber the states
   bool m_renumber;
   
+  /// user option to write the state graphs before and after the renumbering
+  bool m_writeRenumberGraph;
+  
 }; // class ParReadCFmesh
 
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,153 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test CFmesh text scanner"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "Framework/BadFormatException.hh"
+#include "CFmeshFileReader/CFmeshTextScanner.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::CFmeshFileReader;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct CFmeshTextScanner_Fixture
+{
+  /// common setup for each test case: a file with the same layout as
+  /// the lists of a CFmesh file, ending without a newline
+  CFmeshTextScanner_Fixture() : fileName("utest-textScanner.CFmesh")
+  {
+    // the exceptions are expected, no need to dump them
+    Common::ExceptionManager::getInstance().ExceptionOutputs = false;
+    Common::ExceptionManager::getInstance().ExceptionDumps = false;
+    
+    ofstream fout(fileName.c_str());
+    fout << "!LIST_NODE\n";
+    fout << "0.0 -1.5 2.25e-3\n";
+    fout << "  1.000000000000001e+05\t-7.3E-12 3\n";
+    fout << "-0 .5 1.797693134862315e+308\n";
+    fout << "!LIST_ELEM\n";
+    fout << "0 1 2 0\n";
+    fout << "4294967295 12 7 1\n";
+    fout << "123456789 0 5 2";
+  }
+
+  /// common tear-down for each test case
+  ~CFmeshTextScanner_Fixture()
+  {
+    remove(fileName.c_str());
+  }
+
+  /// name of the temporary file
+  std::string fileName;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( CFmeshTextScanner_TestSuite, CFmeshTextScanner_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_sameAsIfstream )
+{
+  ifstream fin(fileName.c_str());
+  CFmeshTextScanner scanner;
+  BOOST_REQUIRE(scanner.open(fileName));
+
+  string key;
+  fin >> key;
+  scanner.seek(fin.tellg());
+
+  // the reals must be bitwise equal to the formatted extraction
+  const CFuint nbReals = 9;
+  CFreal values[nbReals];
+  scanner.read(values, nbReals);
+  for (CFuint i = 0; i < nbReals; ++i) {
+    CFreal expected = 0.;
+    fin >> expected;
+    BOOST_CHECK_EQUAL(values[i], expected);
+  }
+
+  // the stream and the scanner can be synchronized after a list
+  fin >> key;
+  BOOST_CHECK_EQUAL(key, "!LIST_ELEM");
+  scanner.skip(1);
+  BOOST_CHECK_EQUAL(scanner.tell(), size_t(fin.tellg()));
+
+  for (CFuint i = 0; i < 12; ++i) {
+    CFuint value = 0;
+    CFuint expected = 1;
+    scanner.readUInt(value);
+    fin >> expected;
+    BOOST_CHECK_EQUAL(value, expected);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_skip )
+{
+  CFmeshTextScanner scanner;
+  BOOST_REQUIRE(scanner.open(fileName));
+
+  // skipping does not convert the tokens, but must land on the same entry
+  scanner.skip(1 + 3*3 + 1 + 4*2);
+  CFuint value = 0;
+  scanner.readUInt(value);
+  BOOST_CHECK_EQUAL(value, 123456789u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_errors )
+{
+  CFmeshTextScanner scanner;
+  BOOST_CHECK(!scanner.open("utest-textScanner.missing"));
+  BOOST_REQUIRE(scanner.open(fileName));
+
+  // a key is not a number
+  BOOST_CHECK_THROW(scanner.readReal(), Framework::BadFormatException);
+
+  // reading past the last token
+  scanner.seek(0);
+  scanner.skip(1 + 3*3 + 1 + 4*3);
+  BOOST_CHECK_THROW(scanner.skip(1), Framework::BadFormatException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_longToken )
+{
+  // a number is never parsed from a truncated token
+  const string longFile = "utest-textScanner-long.CFmesh";
+  {
+    ofstream fout(longFile.c_str());
+    fout << "1." << string(200, '0') << "1 2.0\n";
+  }
+  
+  CFmeshTextScanner scanner;
+  BOOST_REQUIRE(scanner.open(longFile));
+  BOOST_CHECK_THROW(scanner.readReal(), Framework::BadFormatException);
+  remove(longFile.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
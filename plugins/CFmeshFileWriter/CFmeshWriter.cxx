@@ -139,6 +139,10 @@ void CFmeshWriter::closeImpl()
 
 std::string CFmeshWriter::getFormatExtension() const
 {
+  // solution-only checkpoints are not valid meshes
+  if (_writeSolutionStr == "ParWriteSolutionOnly") {
+    return std::string(".CFsol");
+  }
   return std::string(".CFmesh");
 }
 
@@ -42,18 +42,6 @@ namespace COOLFluiD {
 
 //////////////////////////////////////////////////////////////////////////////
 
-void cmpAndTakeMaxAbs2(CFreal* invec, CFreal* inoutvec, int* len,
-		       MPI_Datatype* datatype)
-{
-  cf_assert(len != CFNULL);
-  int size = *len;
-  for (int i = 0; i < size; ++i) {
-    inoutvec[i] = (fabs(invec[i]) > 0.) ? invec[i] : inoutvec[i];
-  }
-}
-
-//////////////////////////////////////////////////////////////////////////////
-
 ParCFmeshBinaryFileWriter::ParCFmeshBinaryFileWriter() :
   ParFileWriter(), 
   ConfigObject("ParCFmeshBinaryFileWriter"),
@@ -420,8 +408,6 @@ void ParCFmeshBinaryFileWriter::writeElementList(MPI_File* fh)
   MPI_Offset offset;
   MPI_File_get_position(*fh, &offset);
   MPI_Bcast(&offset, 1, MPIStructDef::getMPIOffsetType(), _ioRank, _comm);
-  // wOffset is initialized with current offset
-  vector<MPI_Offset> wOffset(_nbWriters, offset); 
   
   SafePtr< vector<ElementTypeData> > me = getWriteData().getElementTypeData();
   
@@ -469,17 +455,6 @@ void ParCFmeshBinaryFileWriter::writeElementList(MPI_File* fh)
   CFLog(DEBUG_MAX,_myRank << " " << CFPrintContainer<vector<CFuint> >
 		(" globalElementIDs  = ", &(*globalElementIDs)) << "\n");
   
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
-  CFuint elemID = 0;
-  for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
-    const CFuint nbLocalElementsInType = (*me)[iType].getNbElems();
-    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem, ++elemID) {
-      elementList.insertElemLocalID(elemID, (*globalElementIDs)[elemID], iType);
-    }
-  }
-  elementList.endElemInsertion(_myRank);
-  
   CFLog(VERBOSE,_myRank << " maxElemSendSize = " << maxElemSendSize << "\n");
   
   SafePtr<TopologicalRegionSet> elements =
@@ -493,155 +468,114 @@ void ParCFmeshBinaryFileWriter::writeElementList(MPI_File* fh)
     MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
   cf_assert(states.size() > 0);
   
-  // buffer data to send
-  vector<CFuint> sendElements(maxElemSendSize, 0);
-  vector<CFuint> elementToPrint(maxElemSendSize, 0);
-  
-  vector<CFuint> countstates;
-  if(_nbProc == 1 && states.size() == getWriteData().getNbElements()) { 
-    countstates.resize(states.size(), (CFuint)0);
-  }
-  
   const string nsp = MeshDataStack::getActive()->getPrimaryNamespace();
   const string writerName = nsp + "_Writers";
   Group& wg = PE::GetPE().getGroup(writerName);
   
   CFLog(VERBOSE,  "wg.globalRanks.size() = " << wg.globalRanks.size() << "\n");
   
-  CFint wRank = -1; 
-  CFuint rangeID = 0;
+  // ranks of the writers and range of global IDs collected by this process
+  const vector<int> writers(wg.globalRanks.begin(), wg.globalRanks.begin() + nSend);
+  const CFint wRank = getWriterRange(writers);
+  
+  // only the writers hold the buffer of one range of element data
+  vector<CFuint> elementToPrint(_isWriterRank ? maxElemSendSize : 0, 0);
+  
+  const bool checkStates = (_nbProc == 1 && states.size() == getWriteData().getNbElements());
+  vector<CFuint> countstates;
+  if (checkStates) { 
+    countstates.resize(states.size(), (CFuint)0);
+  }
+  
+  CFuint elemID = 0;
   MPI_Offset dataSize = 0;
   for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
     cf_assert(iType < me->size());
     const CFuint nbNodesInType  = (*me)[iType].getNbNodes();
     const CFuint nbStatesInType = (*me)[iType].getNbStates();
     const CFuint nodesPlusStates = nbNodesInType + nbStatesInType;
-    CFuint wSendSize = 0;
-    CFuint countElem = 0;
-    for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-      bool isRangeFound = false;
-      WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
+    
+    // global IDs and connectivity of the local elements of this type: 
+    // each process sends only its own elements to the corresponding writers
+    const CFuint nbLocalElementsInType = (*me)[iType].getNbElems();
+    vector<CFuint> sendIDs(nbLocalElementsInType);
+    vector<CFuint> sendElements(nbLocalElementsInType*nodesPlusStates);
+    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem, ++elemID) {
+      sendIDs[iElem] = (*globalElementIDs)[elemID];
       
-      if (isRangeFound) {
-	CFuint eSize = 0;
-	for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	  const CFuint localElemID = it->second;
-	  const CFuint globalElemID = (*globalElementIDs)[localElemID];
-	  const CFuint sendElemID = globalElemID - countElem;
-	  
-	  CFuint isend = sendElemID*nodesPlusStates;
-	  for (CFuint in = 0; in < nbNodesInType; ++in, ++isend) {
-	    const CFuint localNodeID = elements->getNodeID(localElemID, in);
-	    if (isend >= sendElements.size()) {
-	      CFLogInfo(_myRank << " nbNodesInType = " << nbNodesInType
-			<< " node isend = " << isend << " , size = " << sendElements.size() << "\n");
-	      cf_assert(isend < sendElements.size());
-	    }
-	    
-	    sendElements[isend] = nodes[localNodeID]->getGlobalID();
-	  }
-	  
-	  for (CFuint in = 0; in < nbStatesInType; ++in, ++isend) {
-	    const CFuint localStateID = elements->getStateID(localElemID, in);
-	    if (isend >= sendElements.size()) {
-	      CFLogInfo(_myRank << " state isend = " << isend << " , size = " << sendElements.size() << "\n");
-	      cf_assert(isend < sendElements.size());
-	    }
-	    const CFuint sID = states[localStateID]->getGlobalID();
-	    sendElements[isend] = sID;
-	    // sanity check for cell-centered FV meshes here
-	    if(_nbProc == 1 && states.size() == getWriteData().getNbElements()) {countstates[sID]++;}
-	  }
-	}
-	
-	cf_assert(eSize*nodesPlusStates <= elementList.getSendDataSize(rangeID));
+      CFuint isend = iElem*nodesPlusStates;
+      for (CFuint in = 0; in < nbNodesInType; ++in, ++isend) {
+	const CFuint localNodeID = elements->getNodeID(elemID, in);
+	sendElements[isend] = nodes[localNodeID]->getGlobalID();
       }
       
-      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
-		    (" sendElements  = ", &sendElements, nodesPlusStates) << "\n");
-      
-      // size of the data that, in total, those processes will send to the aggregator (writer) with ID=is
-      const CFuint sendSize = elementList.getSendDataSize(rangeID);
-      cf_assert(sendSize <= sendElements.size());
-      cf_assert(sendSize <= elementToPrint.size());
-      
-      // if the rank corresponds to a writing process, record the size to send for this writer
-      if (_isWriterRank && wg.globalRanks[is] == _myRank) {
-	wSendSize = sendSize; // this should be the total sendsize in the range
-	wRank = is;
+      for (CFuint in = 0; in < nbStatesInType; ++in, ++isend) {
+	const CFuint localStateID = elements->getStateID(elemID, in);
+	const CFuint sID = states[localStateID]->getGlobalID();
+	sendElements[isend] = sID;
+	// sanity check for cell-centered FV meshes here
+	if (checkStates) {countstates[sID]++;}
       }
-      
-      // for each send, accumulate data to the corresponding writing process
-      // this might allocate too much memory on master processes with OPENMPI
-      MPI_Reduce(&sendElements[0], &elementToPrint[0], (int)sendSize,
-		 MPIStructDef::getMPIType(&sendElements[0]), MPI_MAX, wg.globalRanks[is], _comm);
-
-      
-      /// another sanity check
-      if(_nbProc == 1 && states.size() == getWriteData().getNbElements()) {
-	static CFuint count = 0;
-	count = 0;
-	for (CFuint i = 0; i < sendSize; ++i) {
-	  if (sendElements[i] != elementToPrint[i]) {
-	    CFLog(INFO, "#"<< ++count << " => sendElements[" << i << "] = " << sendElements[i] << " != "  
-		  << "elementToPrint[" << i << "] = " << elementToPrint[i] << "\n"); 
+    }
+    
+    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
+		  (" sendElements  = ", &sendElements, nodesPlusStates) << "\n");
+    
+    // start of the range of global IDs collected by each writer
+    vector<CFuint> rangeStart(nSend+1, 0);
+    for (CFuint is = 0; is < nSend; ++is) {
+      rangeStart[is+1] = rangeStart[is] + 
+	elementList.getSendDataSize(iType*nSend + is)/nodesPlusStates;
+    }
+    
+    const CFuint wSendSize = (wRank >= 0) ? 
+      (rangeStart[wRank+1] - rangeStart[wRank])*nodesPlusStates : 0;
+    cf_assert(wSendSize <= elementToPrint.size());
+    
+    // each writer collects the elements of its own range 
+    MPIIOFunctions::sendToWriters(sendIDs, sendElements, nodesPlusStates, rangeStart, 
+				  writers, (_isWriterRank) ? &elementToPrint[0] : CFNULL, _comm);
+    
+    // another sanity check
+    if (checkStates) {
+      for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
+	for (CFuint i = 0; i < nodesPlusStates; ++i) {
+	  const CFuint ie = sendIDs[iElem]*nodesPlusStates + i;
+	  if (sendElements[iElem*nodesPlusStates + i] != elementToPrint[ie]) {
+	    CFLog(INFO, "sendElements[" << iElem*nodesPlusStates + i << "] = " 
+		  << sendElements[iElem*nodesPlusStates + i] << " != "  
+		  << "elementToPrint[" << ie << "] = " << elementToPrint[ie] << "\n"); 
 	    exit(1);
 	  }
 	}
       }
-      ///
-      
-      
-      // the offsets for all writers with send ID > current must be incremented  
-      for (CFuint iw = is+1; iw < wOffset.size(); ++iw) {
-	cf_assert(sendSize > 0);
-	wOffset[iw] += sendSize*sizeof(CFuint);
-	CFLog(DEBUG_MIN, "[" << is << ", " << iw << "] => wOffset = " << wOffset[iw] << ", sendSize = " << sendSize << "\n");
-      }
-      
-      //reset the all sendElement list to 0
-      for (CFuint i = 0; i < maxElemSendSize; ++i) {
-	sendElements[i] = 0;
-      }
-      
-      // update the count element for the current element type
-      countElem += elementList.getSendDataSize(rangeID)/nodesPlusStates;
-      
-      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
-		    (" elementToPrint  = ", &elementToPrint, nodesPlusStates) << "\n");
-      
-    } // end sending loop
+    }
+    
+    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
+		  (" elementToPrint  = ", &elementToPrint, nodesPlusStates) << "\n");
     
     if (_isWriterRank) { 
+      cf_assert(wRank >= 0);
+      const MPI_Offset wOffset = _offset[0].elems.first + 
+	(dataSize + rangeStart[wRank]*nodesPlusStates)*sizeof(CFuint);
+      
       CFLog(DEBUG_MIN, "ParCFmeshBinaryFileWriter::writeElementList() => P[" << _myRank 
-	    << "] => offset = " << wOffset[wRank] << "\n");
+	    << "] => offset = " << wOffset << "\n");
       
       // each writer can now concurrently write all the collected data (related to one element type)
-      cf_assert(wRank >= 0);
-      MPIIOFunctions::writeAll("ParCFmeshBinaryFileWriter::writeElementList()", fh, wOffset[wRank], &elementToPrint[0], 
+      MPIIOFunctions::writeAll("ParCFmeshBinaryFileWriter::writeElementList()", fh, wOffset, &elementToPrint[0], 
 			       wSendSize, _maxBuffSize, _myRank, wg);
       
-      // test  
-      // cf_assert(elementToPrint.size() == wSendSize);
-      // const string nsp = MeshDataStack::getActive()->getPrimaryNamespace();
-      // const string writerName = nsp + "_Writers";
-      // const Group& wgroup = PE::getPE().getGroup(writerName);
-      // MPIIOFunctions::testBuff("ParCFmeshBinaryFileWriter::writeElementList()",
-      //                          wOffset[wRank], &elementToPrint[0], wSendSize, wgroup);
+      // reset all the elements to print to 0
+      elementToPrint.assign(elementToPrint.size(), 0);
     }
     
-    // reset all the elements to print to 0
-    for (CFuint i = 0; i < maxElemSendSize; ++i) {
-      elementToPrint[i] = 0;
-    } 
-    
-    // reset the offset to the end of this type
+    // move to the end of this type
     const CFuint nbElementsInType = (*me)[iType].getNbTotalElems();
     dataSize += nbElementsInType*nodesPlusStates;
-    wOffset.assign(wOffset.size(), _offset[0].elems.first + dataSize*sizeof(CFuint));
   } // end loop on iType
   
-  if (_nbProc == 1 && states.size() == getWriteData().getNbElements()) {
+  if (checkStates) {
     // here we check that, before writing them, state IDs are all pushed into the output buffer 
     for (CFuint i = 0; i < countstates.size(); ++i) {
       if (countstates[i] != 1) {
@@ -728,8 +662,6 @@ void ParCFmeshBinaryFileWriter::writeNodeList(MPI_File* fh)
   MPI_Offset offset;
   MPI_File_get_position(*fh, &offset);
   MPI_Bcast(&offset, 1, MPIStructDef::getMPIOffsetType(), _ioRank, _comm);
-  // wOffset is initialized with current offset
-  vector<MPI_Offset> wOffset(_nbWriters, offset); 
   
   const string nsp = MeshDataStack::getActive()->getPrimaryNamespace();
   const string writerName = nsp + "_Writers";
@@ -770,129 +702,82 @@ void ParCFmeshBinaryFileWriter::writeNodeList(MPI_File* fh)
   CFuint totalToSend = 0;
   elementList.fill(totNbNodes, nodesStride, totalToSend);
   
-  // update the maximum possible element-list size to send
-  const CFuint maxElemSendSize = elementList.getMaxElemSize();
-  
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
-  const CFuint nbLocalElementsInType = nodes.size();
-  for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
-    elementList.insertElemLocalID(iElem, nodes[iElem]->getGlobalID(), 0);
-  }
-  elementList.endElemInsertion(_myRank);
-  
   // start(current position) / end nodes list offset
   _offset[0].nodes.first  = offset;
   _offset[0].nodes.second = _offset[0].nodes.first + sizeof(CFreal)*totalToSend;
   CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeNodeList() => offsets = [" 
 	<<  _offset[0].nodes.first << ", " << _offset[0].nodes.second << "]\n");
   
-  // buffer data to send
-  vector<CFreal> sendElements(maxElemSendSize, 0);
-  vector<CFreal> elementToPrint(maxElemSendSize, 0);
-  
-  CFint wRank = -1; 
-  CFuint wSendSize = 0;
-  CFuint rangeID = 0;
-  CFuint countElem = 0;
-  for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-    bool isRangeFound = false;
-    WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
-    
-    if (isRangeFound) {
-      CFuint eSize = 0;
-      for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	const CFuint localElemID = it->second;
-	const CFuint globalElemID = nodes[localElemID]->getGlobalID();
-	const CFuint sendElemID = globalElemID - countElem;
-
-	if (nodes[localElemID]->isParUpdatable()) {
-	  CFuint isend = sendElemID*nodesStride;
-	  for (CFuint in = 0; in < dim; ++in, ++isend) {
-	    cf_assert(isend < sendElements.size());
-	    sendElements[isend] = (*nodes[localElemID])[in]*refL;
-	  }
-	  
-	  if (storePastNodes) {
-	    const RealVector* pastNodesValues = getWriteData().getPastNode(localElemID);
-	    cf_assert(pastNodesValues->size() == (*nodes[localElemID]).size());
-	    for (CFuint in = 0; in < pastNodesValues->size(); ++in, ++isend) {
-	      cf_assert(isend < sendElements.size());
-	      sendElements[isend] = (*pastNodesValues)[in];
-	    }
-	  }
-	  
-	  if (nbExtraNodalVars > 0) {
-	    const RealVector& extraNodalValues = getWriteData().getExtraNodalValues(localElemID);
-	    cf_assert(extraNodalValues.size() == totalNbExtraNodalVars);
-	    for (CFuint in = 0; in < totalNbExtraNodalVars; ++in, ++isend) {
-	      cf_assert(isend < sendElements.size());
-	      sendElements[isend] = extraNodalValues[in];
-	    }
-	  }
+  // each process sends only the nodes it updates to the corresponding writers
+  CFuint nbSendNodes = 0;
+  for (CFuint iElem = 0; iElem < nbLocalElements; ++iElem) {
+    if (nodes[iElem]->isParUpdatable()) {++nbSendNodes;}
+  }
+  
+  vector<CFuint> sendIDs(nbSendNodes);
+  vector<CFreal> sendElements(nbSendNodes*nodesStride);
+  CFuint isend = 0;
+  for (CFuint iElem = 0, iSendNode = 0; iElem < nbLocalElements; ++iElem) {
+    if (nodes[iElem]->isParUpdatable()) {
+      sendIDs[iSendNode++] = nodes[iElem]->getGlobalID();
+      
+      for (CFuint in = 0; in < dim; ++in, ++isend) {
+	sendElements[isend] = (*nodes[iElem])[in]*refL;
+      }
+      
+      if (storePastNodes) {
+	const RealVector* pastNodesValues = getWriteData().getPastNode(iElem);
+	cf_assert(pastNodesValues->size() == (*nodes[iElem]).size());
+	for (CFuint in = 0; in < pastNodesValues->size(); ++in, ++isend) {
+	  sendElements[isend] = (*pastNodesValues)[in];
 	}
       }
       
-      cf_assert(eSize*nodesStride <= elementList.getSendDataSize(rangeID));
-    }
-
-    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		  (" sendElements  = ", &sendElements, nodesStride) << "\n");
-
-    const CFuint sendSize = elementList.getSendDataSize(rangeID);
-    cf_assert(sendSize <= sendElements.size());
-    cf_assert(sendSize <= elementToPrint.size());
-
-    // if the rank corresponds to a writing process, record the size to send for this writer
-    if (_isWriterRank && wg.globalRanks[is] == _myRank) {
-      wSendSize = sendSize; // this should be the total sendsize in the range
-      wRank = is;
-    }
-    
-    MPI_Op myMpiOp;
-    MPI_Op_create((MPI_User_function *)cmpAndTakeMaxAbs2, 1, &myMpiOp);
-    MPI_Reduce(&sendElements[0], &elementToPrint[0], sendSize,
-	       MPIStructDef::getMPIType(&sendElements[0]), myMpiOp, wg.globalRanks[is], _comm);
-    
-    // MPI_Allreduce(&sendElements[0], &elementToPrint[0], maxElemSendSize, 
-    //               MPIStructDef::getMPIType(&sendElements[0]), myMpiOp, _comm);
-    
-    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		  (" elementToPrint  = ", &elementToPrint, nodesStride) << "\n");
-    
-    // the offsets for all writers with send ID > current must be incremented  
-    for (CFuint iw = is+1; iw < wOffset.size(); ++iw) {
-      cf_assert(sendSize > 0);
-      wOffset[iw] += sendSize*sizeof(CFreal);
-      CFLog(DEBUG_MIN, "[" << is << ", " << iw << "] => wOffset = " << wOffset[iw] << ", sendSize = " << sendSize << "\n");
-    }
-    
-    // reset the all sendElement list to 0
-    for (CFuint i = 0; i < maxElemSendSize; ++i) {
-      sendElements[i] = 0;
+      if (nbExtraNodalVars > 0) {
+	const RealVector& extraNodalValues = getWriteData().getExtraNodalValues(iElem);
+	cf_assert(extraNodalValues.size() == totalNbExtraNodalVars);
+	for (CFuint in = 0; in < totalNbExtraNodalVars; ++in, ++isend) {
+	  sendElements[isend] = extraNodalValues[in];
+	}
+      }
     }
-    
-    // update the count element for the current element type
-    countElem += elementList.getSendDataSize(rangeID)/nodesStride;
   }
+  cf_assert(isend == sendElements.size());
+  
+  CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		(" sendElements  = ", &sendElements, nodesStride) << "\n");
+  
+  // start of the range of global IDs collected by each writer
+  vector<CFuint> rangeStart(nSend+1, 0);
+  for (CFuint is = 0; is < nSend; ++is) {
+    rangeStart[is+1] = rangeStart[is] + elementList.getSendDataSize(is)/nodesStride;
+  }
+  
+  const vector<int> writers(wg.globalRanks.begin(), wg.globalRanks.begin() + nSend);
+  const CFint wRank = getWriterRange(writers);
+  const CFuint wSendSize = (wRank >= 0) ? 
+    (rangeStart[wRank+1] - rangeStart[wRank])*nodesStride : 0;
+  
+  // only the writers hold the buffer of one range of nodal data
+  vector<CFreal> elementToPrint(_isWriterRank ? elementList.getMaxElemSize() : 0, 0.);
+  cf_assert(wSendSize <= elementToPrint.size());
+  
+  MPIIOFunctions::sendToWriters(sendIDs, sendElements, nodesStride, rangeStart, 
+				writers, (_isWriterRank) ? &elementToPrint[0] : CFNULL, _comm);
+  
+  CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		(" elementToPrint  = ", &elementToPrint, nodesStride) << "\n");
   
   if (_isWriterRank) { 
-    CFLog(DEBUG_MIN, "ParCFmeshBinaryFileWriter::writeNodeList() => P[" << _myRank << "] => offset = " << wOffset[wRank] << "\n");
-    // each writer can now concurrently write all the collected data (related to one element type)
     cf_assert(wRank >= 0);
-    // cout << _myRank << " writes " << wSendSize << "\n";
-    // MPI_File_write_at_all(*fh, wOffset[wRank], &elementToPrint[0], (int)wSendSize, 
-    // MPIStructDef::getMPIType(&elementToPrint[0]), &_status); 
+    const MPI_Offset wOffset = offset + rangeStart[wRank]*nodesStride*sizeof(CFreal);
+    CFLog(DEBUG_MIN, "ParCFmeshBinaryFileWriter::writeNodeList() => P[" << _myRank << "] => offset = " << wOffset << "\n");
     
-    MPIIOFunctions::writeAll("ParCFmeshBinaryFileWriter::writeNodeList()", fh, wOffset[wRank], &elementToPrint[0], 
+    // each writer can now concurrently write all the collected data
+    MPIIOFunctions::writeAll("ParCFmeshBinaryFileWriter::writeNodeList()", fh, wOffset, &elementToPrint[0], 
 			     wSendSize, _maxBuffSize, _myRank, wg);
   }
   
-  //reset the all sendElement list to 0
-  for (CFuint i = 0; i < maxElemSendSize; ++i) {
-    elementToPrint[i] = 0;
-  }
-  
   if (_isWriterRank) {
     MPI_Barrier(wg.comm);
     MPI_File_seek(*fh, _offset[0].nodes.second, MPI_SEEK_SET);
@@ -942,9 +827,6 @@ void ParCFmeshBinaryFileWriter::writeStateList(MPI_File* fh)
   MPI_Bcast(&offset, 1, MPIStructDef::getMPIOffsetType(), _ioRank, _comm);
   
   if (getWriteData().isWithSolution()){
-    // wOffset is initialized with current offset
-    vector<MPI_Offset> wOffset(_nbWriters, offset); 
-    
     if (_isWriterRank) {
       MPI_Barrier(wg.comm);
     }
@@ -981,137 +863,89 @@ void ParCFmeshBinaryFileWriter::writeStateList(MPI_File* fh)
     CFuint totalToSend = 0;
     elementList.fill(totNbStates, statesStride, totalToSend);
     
-    // update the maximum possible element-list size to send
-    const CFuint maxElemSendSize = elementList.getMaxElemSize();
-    
-    // insert in the write list the local IDs of the elements
-    // the range ID is automatically determined inside the WriteListMap
-    const CFuint nbLocalElementsInType = states.size();
-    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
-      elementList.insertElemLocalID(iElem, states[iElem]->getGlobalID(), 0);
-    }
-    elementList.endElemInsertion(_myRank);
-  
     // start(current position) / end nodes list offset
     _offset[0].states.first  = offset;
     _offset[0].states.second = _offset[0].states.first + sizeof(CFreal)*totalToSend;
     CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeStateList() => offsets = [" 
 	  <<  _offset[0].states.first << ", " << _offset[0].states.second << "]\n");
     
-    // buffer data to send
-    vector<CFreal> sendElements(maxElemSendSize, 0);
-    vector<CFreal> elementToPrint(maxElemSendSize, 0);
-     
-    CFint wRank = -1; 
-    CFuint wSendSize = 0;
-    CFuint rangeID = 0;
-    CFuint countElem = 0;
-    for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-      bool isRangeFound = false;
-      WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
-      
-      if (isRangeFound) {
-	CFuint eSize = 0;
-	for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	  const CFuint localElemID = it->second;
-	  const CFuint globalElemID = states[localElemID]->getGlobalID();
-	  const CFuint sendElemID = globalElemID - countElem;
-	  
-	  if (states[localElemID]->isParUpdatable()) {
-	    CFuint isend = sendElemID*statesStride;
-	    for (CFuint in = 0; in < dim; ++in, ++isend) {
-	      cf_assert(isend < sendElements.size());
-	      sendElements[isend] = (*states[localElemID])[in];
-	    }
-	    
-	    if(storePastStates){
-	      const RealVector* pastStatesValues = getWriteData().getPastState(localElemID);
-	      cf_assert(pastStatesValues->size() == (*states[localElemID]).size());
-	      for (CFuint in = 0; in < pastStatesValues->size(); ++in, ++isend) {
-		cf_assert(isend < sendElements.size());
-		sendElements[isend] = (*pastStatesValues)[in];
-	      }
-	    }
-	    
-	    if(storeInterStates){
-	      const RealVector* interStatesValues = getWriteData().getInterState(localElemID);
-	      cf_assert(interStatesValues->size() == (*states[localElemID]).size());
-	      for (CFuint in = 0; in < interStatesValues->size(); ++in, ++isend) {
-		cf_assert(isend < sendElements.size());
-		sendElements[isend] = (*interStatesValues)[in];
-	      }
-	    }
-	    
-	    if (nbExtraStateVars > 0) {
-	      const RealVector& extraStateValues = getWriteData().getExtraStateValues(localElemID);
-	      cf_assert(extraStateValues.size() == totalNbExtraStateVars);
-	      for (CFuint in = 0; in < totalNbExtraStateVars; ++in, ++isend) {
-		cf_assert(isend < sendElements.size());
-		sendElements[isend] = extraStateValues[in];
-	      }
-	    }
+    // each process sends only the states it updates to the corresponding writers
+    CFuint nbSendStates = 0;
+    for (CFuint iElem = 0; iElem < nbLocalElements; ++iElem) {
+      if (states[iElem]->isParUpdatable()) {++nbSendStates;}
+    }
+    
+    vector<CFuint> sendIDs(nbSendStates);
+    vector<CFreal> sendElements(nbSendStates*statesStride);
+    CFuint isend = 0;
+    for (CFuint iElem = 0, iSendState = 0; iElem < nbLocalElements; ++iElem) {
+      if (states[iElem]->isParUpdatable()) {
+	sendIDs[iSendState++] = states[iElem]->getGlobalID();
+	
+	for (CFuint in = 0; in < dim; ++in, ++isend) {
+	  sendElements[isend] = (*states[iElem])[in];
+	}
+	
+	if(storePastStates){
+	  const RealVector* pastStatesValues = getWriteData().getPastState(iElem);
+	  cf_assert(pastStatesValues->size() == (*states[iElem]).size());
+	  for (CFuint in = 0; in < pastStatesValues->size(); ++in, ++isend) {
+	    sendElements[isend] = (*pastStatesValues)[in];
 	  }
 	}
 	
-	cf_assert(eSize*statesStride <= elementList.getSendDataSize(rangeID));
-      }
-
-      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		    (" sendElements  = ", &sendElements, statesStride) << "\n");
-
-      const CFuint sendSize = elementList.getSendDataSize(rangeID);
-      cf_assert(sendSize <= sendElements.size());
-      cf_assert(sendSize <= elementToPrint.size());
-      
-      // if the rank corresponds to a writing process, record the size to send for this writer
-      if (_isWriterRank && wg.globalRanks[is] == _myRank) {
-	wSendSize = sendSize; // this should be the total sendsize in the range
-	wRank = is;
-      }
-      
-      MPI_Op myMpiOp;
-      MPI_Op_create((MPI_User_function *)cmpAndTakeMaxAbs2, 1, &myMpiOp);
-      MPI_Reduce(&sendElements[0], &elementToPrint[0], sendSize, 
-		 MPIStructDef::getMPIType(&sendElements[0]), 
-		 myMpiOp, wg.globalRanks[is], _comm);
-      // MPI_Allreduce(&sendElements[0], &elementToPrint[0], maxElemSendSize, 
-      //               MPIStructDef::getMPIType(&sendElements[0]), myMpiOp, _comm);
-      
-      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		    (" elementToPrint  = ", &elementToPrint, statesStride) << "\n");
-      
-      // the offsets for all writers with send ID > current must be incremented  
-      for (CFuint iw = is+1; iw < wOffset.size(); ++iw) {
-	cf_assert(sendSize > 0);
-	wOffset[iw] += sendSize*sizeof(CFreal);
-	CFLog(DEBUG_MIN, "[" << is << ", " << iw << "] => wOffset = " << wOffset[iw] << ", sendSize = " << sendSize << "\n");
-      }
-      
-      // reset the all sendElement list to 0
-      for (CFuint i = 0; i < maxElemSendSize; ++i) {
-	sendElements[i] = 0;
+	if(storeInterStates){
+	  const RealVector* interStatesValues = getWriteData().getInterState(iElem);
+	  cf_assert(interStatesValues->size() == (*states[iElem]).size());
+	  for (CFuint in = 0; in < interStatesValues->size(); ++in, ++isend) {
+	    sendElements[isend] = (*interStatesValues)[in];
+	  }
+	}
+	
+	if (nbExtraStateVars > 0) {
+	  const RealVector& extraStateValues = getWriteData().getExtraStateValues(iElem);
+	  cf_assert(extraStateValues.size() == totalNbExtraStateVars);
+	  for (CFuint in = 0; in < totalNbExtraStateVars; ++in, ++isend) {
+	    sendElements[isend] = extraStateValues[in];
+	  }
+	}
       }
-      
-      // update the count element for the current element type
-      countElem += elementList.getSendDataSize(rangeID)/statesStride;
     }
+    cf_assert(isend == sendElements.size());
+    
+    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		  (" sendElements  = ", &sendElements, statesStride) << "\n");
+    
+    // start of the range of global IDs collected by each writer
+    vector<CFuint> rangeStart(nSend+1, 0);
+    for (CFuint is = 0; is < nSend; ++is) {
+      rangeStart[is+1] = rangeStart[is] + elementList.getSendDataSize(is)/statesStride;
+    }
+    
+    const vector<int> writers(wg.globalRanks.begin(), wg.globalRanks.begin() + nSend);
+    const CFint wRank = getWriterRange(writers);
+    const CFuint wSendSize = (wRank >= 0) ? 
+      (rangeStart[wRank+1] - rangeStart[wRank])*statesStride : 0;
+    
+    // only the writers hold the buffer of one range of state data
+    vector<CFreal> elementToPrint(_isWriterRank ? elementList.getMaxElemSize() : 0, 0.);
+    cf_assert(wSendSize <= elementToPrint.size());
+    
+    MPIIOFunctions::sendToWriters(sendIDs, sendElements, statesStride, rangeStart, 
+				  writers, (_isWriterRank) ? &elementToPrint[0] : CFNULL, _comm);
+    
+    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		  (" elementToPrint  = ", &elementToPrint, statesStride) << "\n");
     
     if (_isWriterRank) { 
-      CFLog(DEBUG_MIN, "ParCFmeshBinaryFileWriter::writeStateList() => P[" << _myRank << "] => offset = " << wOffset[wRank] << "\n");
-      // each writer can now concurrently write all the collected data (related to one element type)
       cf_assert(wRank >= 0);
-     // CFLog(VERBOSE, _myRank << " writes " << wSendSize << " starting at " << wOffset[wRank] << " \n");
-      // MPI_File_write_at_all(*fh, wOffset[wRank], &elementToPrint[0], (int)wSendSize,
-      // MPIStructDef::getMPIType(&elementToPrint[0]), &_status); 
+      const MPI_Offset wOffset = offset + rangeStart[wRank]*statesStride*sizeof(CFreal);
+      CFLog(DEBUG_MIN, "ParCFmeshBinaryFileWriter::writeStateList() => P[" << _myRank << "] => offset = " << wOffset << "\n");
       
-      MPIIOFunctions::writeAll("ParCFmeshBinaryFileWriter::writeStateList()", fh, wOffset[wRank], &elementToPrint[0], 
+      // each writer can now concurrently write all the collected data
+      MPIIOFunctions::writeAll("ParCFmeshBinaryFileWriter::writeStateList()", fh, wOffset, &elementToPrint[0], 
 			       wSendSize, _maxBuffSize, _myRank, wg);
     }
-    
-    //reset the all sendElement list to 0
-    for (CFuint i = 0; i < maxElemSendSize; ++i) {
-      elementToPrint[i] = 0;
-    }
   }
   
   if (_isWriterRank) {
@@ -1200,8 +1034,6 @@ void ParCFmeshBinaryFileWriter::writeGeoList(CFuint iTRS, MPI_File* fh)
   MPI_Offset offset;
   MPI_File_get_position(*fh, &offset);
   MPI_Bcast(&offset, 1, MPIStructDef::getMPIOffsetType(), _ioRank, _comm);
-  // wOffset is initialized with current offset
-  vector<MPI_Offset> wOffset(_nbWriters, offset); 
   
   const string nsp = MeshDataStack::getActive()->getPrimaryNamespace();
   const string writerName = nsp + "_Writers";
@@ -1253,16 +1085,6 @@ void ParCFmeshBinaryFileWriter::writeGeoList(CFuint iTRS, MPI_File* fh)
     MPI_File_seek(*fh, _offset[0].TRS[iTRS].first, MPI_SEEK_SET);
   }
   
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
-  for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
-    const CFuint nbLocalElementsInType = (*trs)[iType]->getLocalNbGeoEnts();
-    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
-      elementList.insertElemLocalID(iElem, (*globalGeoIDS)[iTRS][iType][iElem], iType);
-    }
-  }
-  elementList.endElemInsertion(_myRank);
-  
   DataHandle < Framework::Node*, Framework::GLOBAL > nodes =
     MeshDataStack::getActive()->getNodeDataSocketSink().getDataHandle();
   cf_assert(nodes.size() > 0);
@@ -1271,138 +1093,98 @@ void ParCFmeshBinaryFileWriter::writeGeoList(CFuint iTRS, MPI_File* fh)
     MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
   cf_assert(states.size() > 0);
   
-  // buffer data to send
-  vector<CFint> sendElements(maxElemSendSize, -1);
-  vector<CFint> elementToPrint(maxElemSendSize, -1);
+  // ranks of the writers and range of global IDs collected by this process
+  const vector<int> writers(wg.globalRanks.begin(), wg.globalRanks.begin() + nSend);
+  const CFint wRank = getWriterRange(writers);
+  
+  // only the writers hold the buffer of one range of TR data
+  vector<CFint> elementToPrint(_isWriterRank ? maxElemSendSize : 0, -1);
   
-  CFint wRank = -1; 
-  CFuint rangeID = 0;
   MPI_Offset dataSize = 0;
   for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
     const CFuint maxNbNodesInType  = nbNodesStatesInTRGeo(iType, 0);
     const CFuint maxNbStatesInType = nbNodesStatesInTRGeo(iType, 1);
     const CFuint maxNodesPlusStates = maxNbNodesInType + maxNbStatesInType + 2;
     
-    CFuint wSendSize = 0;
-    CFuint countElem = 0;
-    for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-      bool isRangeFound = false;
-      WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
-      
-      if (isRangeFound) {
-	CFuint eSize = 0;
-	for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	  const CFuint localElemID = it->second;
-	  const CFuint globalElemID = (*globalGeoIDS)[iTRS][iType][localElemID];
-	  const CFuint sendElemID = globalElemID - countElem;
-	  
-	  CFLogDebugMax("localElemID = " << localElemID <<
-			", globalElemID = " << globalElemID <<
-			", sendElemID = " << sendElemID << "\n");
-	  
-	  CFuint isend = sendElemID*maxNodesPlusStates;
-	  // number of nodes in the current TR geo entity
-	  const CFuint nbNodesInTRGeo  = (*trs)[iType]->getNbNodesInGeo(localElemID);
-	  sendElements[isend++] = nbNodesInTRGeo;
-	  
-	  // number of states in the current TR geo entity
-	  const CFuint nbStatesInTRGeo = (isFVMCC) ? 1 : (*trs)[iType]->getNbStatesInGeo(localElemID);
-	  sendElements[isend++] = nbStatesInTRGeo;
-
-	  // TR geo nodes data
-	  for (CFuint in = 0; in < maxNbNodesInType; ++in, ++isend) {
-	    // the local node ID is set to -1 if the maximum number of nodes exceeds the actual value
-	    const CFint localNodeID = (in < nbNodesInTRGeo) ?
-	      static_cast<CFint>((*trs)[iType]->getNodeID(localElemID, in)) : -1;
-	    if (isend >= sendElements.size()) {
-	      CFLog(VERBOSE,_myRank << " maxNbNodesInType = " << maxNbNodesInType
-			    << " node isend = " << isend << " , size = " << sendElements.size() << "\n");
-	      cf_assert(isend < sendElements.size());
-	    }
-	    // set the global ID to -1 if the local ID is -1
-	    sendElements[isend] = (localNodeID != -1) ?
-	      static_cast<CFint>(nodes[localNodeID]->getGlobalID()) : -1;
-	  }
-	  
-	  // TR geo states data
-	  for (CFuint in = 0; in < maxNbStatesInType; ++in, ++isend) {
-	    // the local state ID is set to -1 if the maximum number of states exceeds the actual value
-	    const CFint localStateID = (in < nbStatesInTRGeo) ?
-	      static_cast<CFint>((*trs)[iType]->getStateID(localElemID, in)) : -1;
-	    if (isend >= sendElements.size()) {
-	      CFLog(VERBOSE,_myRank << " state isend = " << isend << " , size = " << sendElements.size() << "\n");
-	      cf_assert(isend < sendElements.size());
-	    }
-	    // set the global ID to -1 if the local ID is -1
-	    sendElements[isend] = (localStateID != -1) ?
-	      static_cast<CFint>(states[localStateID]->getGlobalID()) : -1;
-	  }
-	}
-	
-	cf_assert(eSize*maxNodesPlusStates <= elementList.getSendDataSize(rangeID));
-      }
-      
-      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFint> >
-		    (" sendElements  = ", &sendElements, maxNodesPlusStates) << "\n");
-      
-      const CFuint sendSize = elementList.getSendDataSize(rangeID);
-      cf_assert(sendSize <= sendElements.size());
-      cf_assert(sendSize <= elementToPrint.size());
-      
-      // if the rank corresponds to a writing process, record the size to send for this writer
-      if (_isWriterRank && wg.globalRanks[is] == _myRank) {
-	wSendSize = sendSize; // this should be the total sendsize in the range
-	wRank = is;
-      }
+    // global IDs and connectivity of the local TR geometric entities: 
+    // each process sends only its own entities to the corresponding writers
+    const CFuint nbLocalElementsInType = (*trs)[iType]->getLocalNbGeoEnts();
+    vector<CFuint> sendIDs(nbLocalElementsInType);
+    vector<CFint> sendElements(nbLocalElementsInType*maxNodesPlusStates, -1);
+    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
+      sendIDs[iElem] = (*globalGeoIDS)[iTRS][iType][iElem];
       
-      // for each send, accumulate data to the corresponding writing process
-      MPI_Reduce(&sendElements[0], &elementToPrint[0], (int)sendSize,
-		 MPIStructDef::getMPIType(&sendElements[0]), MPI_MAX, wg.globalRanks[is], _comm);
+      CFuint isend = iElem*maxNodesPlusStates;
+      // number of nodes in the current TR geo entity
+      const CFuint nbNodesInTRGeo  = (*trs)[iType]->getNbNodesInGeo(iElem);
+      sendElements[isend++] = nbNodesInTRGeo;
       
-      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFint> >
-		    (" elementToPrint  = ", &elementToPrint, maxNodesPlusStates) << "\n");
+      // number of states in the current TR geo entity
+      const CFuint nbStatesInTRGeo = (isFVMCC) ? 1 : (*trs)[iType]->getNbStatesInGeo(iElem);
+      sendElements[isend++] = nbStatesInTRGeo;
       
-      // the offsets for all writers with send ID > current must be incremented  
-      for (CFuint iw = is+1; iw < wOffset.size(); ++iw) {
-	cf_assert(sendSize > 0);
-	wOffset[iw] += sendSize*sizeof(CFint);
-	CFLog(DEBUG_MIN, "[" << is << ", " << iw << "] => wOffset = " << wOffset[iw] << ", sendSize = " << sendSize << "\n");
+      // TR geo nodes data
+      for (CFuint in = 0; in < maxNbNodesInType; ++in, ++isend) {
+	// the local node ID is set to -1 if the maximum number of nodes exceeds the actual value
+	const CFint localNodeID = (in < nbNodesInTRGeo) ?
+	  static_cast<CFint>((*trs)[iType]->getNodeID(iElem, in)) : -1;
+	// set the global ID to -1 if the local ID is -1
+	sendElements[isend] = (localNodeID != -1) ?
+	  static_cast<CFint>(nodes[localNodeID]->getGlobalID()) : -1;
       }
       
-      //reset the all sendElement list to -1
-      for (CFuint i = 0; i < maxElemSendSize; ++i) {
-	sendElements[i] = -1;
+      // TR geo states data
+      for (CFuint in = 0; in < maxNbStatesInType; ++in, ++isend) {
+	// the local state ID is set to -1 if the maximum number of states exceeds the actual value
+	const CFint localStateID = (in < nbStatesInTRGeo) ?
+	  static_cast<CFint>((*trs)[iType]->getStateID(iElem, in)) : -1;
+	// set the global ID to -1 if the local ID is -1
+	sendElements[isend] = (localStateID != -1) ?
+	  static_cast<CFint>(states[localStateID]->getGlobalID()) : -1;
       }
-      
-      // update the count element for the current element type
-      countElem += elementList.getSendDataSize(rangeID)/maxNodesPlusStates;
-    } // end sending loop
+    }
+    
+    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFint> >
+		  (" sendElements  = ", &sendElements, maxNodesPlusStates) << "\n");
+    
+    // start of the range of global IDs collected by each writer
+    vector<CFuint> rangeStart(nSend+1, 0);
+    for (CFuint is = 0; is < nSend; ++is) {
+      rangeStart[is+1] = rangeStart[is] + 
+	elementList.getSendDataSize(iType*nSend + is)/maxNodesPlusStates;
+    }
+    
+    const CFuint wSendSize = (wRank >= 0) ? 
+      (rangeStart[wRank+1] - rangeStart[wRank])*maxNodesPlusStates : 0;
+    cf_assert(wSendSize <= elementToPrint.size());
+    
+    // each writer collects the entities of its own range 
+    MPIIOFunctions::sendToWriters(sendIDs, sendElements, maxNodesPlusStates, rangeStart, 
+				  writers, (_isWriterRank) ? &elementToPrint[0] : CFNULL, _comm);
+    
+    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFint> >
+		  (" elementToPrint  = ", &elementToPrint, maxNodesPlusStates) << "\n");
     
     if (_isWriterRank) {
-      CFLog(DEBUG_MIN, "ParCFmeshBinaryFileWriter::writeGeoList() => P[" << _myRank 
-	    << "] => offset = " << wOffset[wRank] << "\n");
       cf_assert(wRank >= 0);
-      // CFLog(VERBOSE, "P[" << _myRank << "] writes " << wSendSize << " starting from " << wOffset[wRank] << "\n");
-      // MPI_File_write_at_all(*fh, wOffset[wRank], &elementToPrint[0], (int)wSendSize, 
-      //MPIStructDef::getMPIType(&elementToPrint[0]), &_status); 
+      const MPI_Offset wOffset = _offset[0].TRS[iTRS].first + 
+	(dataSize + rangeStart[wRank]*maxNodesPlusStates)*sizeof(CFint);
+      CFLog(DEBUG_MIN, "ParCFmeshBinaryFileWriter::writeGeoList() => P[" << _myRank 
+	    << "] => offset = " << wOffset << "\n");
       
-      MPIIOFunctions::writeAll("ParCFmeshBinaryFileWriter::writeGeoList()", fh, wOffset[wRank], &elementToPrint[0], 
+      MPIIOFunctions::writeAll("ParCFmeshBinaryFileWriter::writeGeoList()", fh, wOffset, &elementToPrint[0], 
 			       wSendSize, _maxBuffSize, _myRank, wg);
       
       // note here we are writing some components that could be = -1
       // this will have to be taken into account in the parallel reader 
+      
+      // reset all the elements to print to -1
+      elementToPrint.assign(elementToPrint.size(), -1);
     }
     
-    // reset all the elements to print to -1
-    for (CFuint i = 0; i < maxElemSendSize; ++i) {
-      elementToPrint[i] = -1;
-    }
-    
-    // reset the offset to the end of this type
+    // move to the end of this type
     const CFuint nbElementsInType = trsInfo[iTRS][iType];
     dataSize += nbElementsInType*maxNodesPlusStates;
-    wOffset.assign(wOffset.size(), _offset[0].TRS[iTRS].first + dataSize*sizeof(CFint));
-    CFLog(DEBUG_MIN, CFPrintContainer<vector<MPI_Offset> >(" TR wOffset = ", &wOffset));
   }
   
   if (_isWriterRank) {
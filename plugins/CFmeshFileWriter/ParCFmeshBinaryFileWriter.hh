@@ -77,7 +77,7 @@ protected: // helper functions
   
   /// Writes to the given file.
   /// @throw Common::FilesystemException
-  void writeToFileStream(const boost::filesystem::path& filepath);
+  virtual void writeToFileStream(const boost::filesystem::path& filepath);
   
   /// Get the name of the reader
   const std::string getWriterName() const 
@@ -4,6 +4,7 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <algorithm>
 #include <iomanip>
 #include <numeric>
 
@@ -17,6 +18,7 @@
 #include "Common/CFMultiMap.hh"
 #include "Common/CFPrintContainer.hh"
 #include "Common/MPI/MPIStructDef.hh"
+#include "Common/MPI/MPIIOFunctions.hh"
 
 #include "Environment/SingleBehaviorFactory.hh"
 
@@ -40,14 +42,47 @@ namespace COOLFluiD {
 
 //////////////////////////////////////////////////////////////////////////////
 
-void cmpAndTakeMaxAbs(CFreal* invec, CFreal* inoutvec, int* len,
-		      MPI_Datatype* datatype)
+/// Sort the entries of a list by global ID
+template <typename T>
+static void sortByGlobalID(vector<CFuint>& ids, vector<T>& values, const CFuint stride)
 {
-  cf_assert(len != CFNULL);
-  int size = *len;
-  for (int i = 0; i < size; ++i) {
-    inoutvec[i] = (fabs(invec[i]) > 0.) ? invec[i] : inoutvec[i];
+  vector<pair<CFuint, CFuint> > order(ids.size());
+  for (CFuint i = 0; i < ids.size(); ++i) {
+    order[i] = make_pair(ids[i], i);
   }
+  std::sort(order.begin(), order.end());
+  
+  vector<T> sorted(values.size());
+  for (CFuint i = 0; i < order.size(); ++i) {
+    ids[i] = order[i].first;
+    std::copy(&values[order[i].second*stride], &values[order[i].second*stride] + stride, 
+	      &sorted[i*stride]);
+  }
+  values.swap(sorted);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Collect on the I/O rank the entries with global ID in [rangeStart, rangeEnd)
+/// @param ids    global IDs of the local entries, sorted
+/// @param first  first local entry in the range, set to the first one after it
+template <typename T>
+static void collectRange(const vector<CFuint>& ids, const vector<T>& values, 
+			 const CFuint stride, const CFuint rangeStart, 
+			 const CFuint rangeEnd, CFuint& first, const int ioRank, 
+			 T* buf, MPI_Comm comm)
+{
+  CFuint last = first;
+  while (last < ids.size() && ids[last] < rangeEnd) {++last;}
+  
+  const vector<CFuint> rangeIDs(ids.begin() + first, ids.begin() + last);
+  const vector<T> rangeValues(values.begin() + first*stride, values.begin() + last*stride);
+  vector<CFuint> range(2);
+  range[0] = rangeStart;
+  range[1] = rangeEnd;
+  MPIIOFunctions::sendToWriters(rangeIDs, rangeValues, stride, range, 
+				vector<int>(1, ioRank), buf, comm);
+  first = last;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -443,17 +478,6 @@ void ParCFmeshFileWriter::writeElementList(std::ofstream *const fout)
   CFLogDebugMin(_myRank << " " << CFPrintContainer<vector<CFuint> >
 		(" globalElementIDs  = ", &(*globalElementIDs)) << "\n");
   
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
-  CFuint elemID = 0;
-  for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
-    const CFuint nbLocalElementsInType = (*me)[iType].getNbElems();
-    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem, ++elemID) {
-      elementList.insertElemLocalID(elemID, (*globalElementIDs)[elemID], iType);
-    }
-  }
-  elementList.endElemInsertion(_myRank);
-
   CFLogDebugMin(_myRank << " maxElemSendSize = " << maxElemSendSize << "\n");
 
   SafePtr<TopologicalRegionSet> elements =
@@ -467,65 +491,51 @@ void ParCFmeshFileWriter::writeElementList(std::ofstream *const fout)
     MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
   cf_assert(states.size() > 0);
 
-  // buffer data to send
-  vector<CFuint> sendElements(maxElemSendSize, 0);
-  vector<CFuint> elementToPrint(maxElemSendSize, 0);
-
+  // only the I/O rank holds the buffer of one range of element data
+  vector<CFuint> elementToPrint((_myRank == _ioRank) ? maxElemSendSize : 0, 0);
+  CFuint* const printBuf = (_myRank == _ioRank) ? &elementToPrint[0] : CFNULL;
+  
   CFuint rangeID = 0;
+  CFuint elemID = 0;
   for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
     const CFuint nbNodesInType  = (*me)[iType].getNbNodes();
     const CFuint nbStatesInType = (*me)[iType].getNbStates();
     const CFuint nodesPlusStates = nbNodesInType + nbStatesInType;
     
-    CFuint countElem = 0;
-    for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-
-    bool isRangeFound = false;
-      WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
-
-      if (isRangeFound) {
-	CFuint eSize = 0;
-	for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	  const CFuint localElemID = it->second;
-	  const CFuint globalElemID = (*globalElementIDs)[localElemID];
-	  const CFuint sendElemID = globalElemID - countElem;
-
-	  CFuint isend = sendElemID*nodesPlusStates;
-	  for (CFuint in = 0; in < nbNodesInType; ++in, ++isend) {
-	    const CFuint localNodeID = elements->getNodeID(localElemID, in);
-	    if (isend >= sendElements.size()) {
-	      CFLogInfo(_myRank << " nbNodesInType = " << nbNodesInType
-			<< " node isend = " << isend << " , size = " << sendElements.size() << "\n");
-	      cf_assert(isend < sendElements.size());
-	    }
-
-	    sendElements[isend] = nodes[localNodeID]->getGlobalID();
-	  }
-
-	  for (CFuint in = 0; in < nbStatesInType; ++in, ++isend) {
-	    const CFuint localStateID = elements->getStateID(localElemID, in);
-	     if (isend >= sendElements.size()) {
-	       CFLogInfo(_myRank << " state isend = " << isend << " , size = " << sendElements.size() << "\n");
-	       cf_assert(isend < sendElements.size());
-	     }
-	    sendElements[isend] = states[localStateID]->getGlobalID();
-	  }
-	}
-
-	cf_assert(eSize*nodesPlusStates <= elementList.getSendDataSize(rangeID));
+    // global IDs and connectivity of the local elements of this type, 
+    // sorted by global ID: each process sends only its own elements
+    const CFuint nbLocalElementsInType = (*me)[iType].getNbElems();
+    vector<CFuint> sendIDs(nbLocalElementsInType);
+    vector<CFuint> sendElements(nbLocalElementsInType*nodesPlusStates);
+    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem, ++elemID) {
+      sendIDs[iElem] = (*globalElementIDs)[elemID];
+      
+      CFuint isend = iElem*nodesPlusStates;
+      for (CFuint in = 0; in < nbNodesInType; ++in, ++isend) {
+	const CFuint localNodeID = elements->getNodeID(elemID, in);
+	sendElements[isend] = nodes[localNodeID]->getGlobalID();
       }
-
+      
+      for (CFuint in = 0; in < nbStatesInType; ++in, ++isend) {
+	const CFuint localStateID = elements->getStateID(elemID, in);
+	sendElements[isend] = states[localStateID]->getGlobalID();
+      }
+    }
+    sortByGlobalID(sendIDs, sendElements, nodesPlusStates);
+    
     CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
-	    (" sendElements  = ", &sendElements, nodesPlusStates) << "\n");
-
+		  (" sendElements  = ", &sendElements, nodesPlusStates) << "\n");
+    
+    CFuint first = 0;
+    CFuint countElem = 0;
+    for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
       const CFuint sendSize = elementList.getSendDataSize(rangeID);
-      cf_assert(sendSize <= sendElements.size());
-      cf_assert(sendSize <= elementToPrint.size());
-
-//      MPI_Reduce(&sendElements[0], &elementToPrint[0], sendSize,
-//		 MPIStructDef::getMPIType(&sendElements[0]), MPI_MAX, _ioRank, _comm); // allocates too much memory on master node with OPENMPI
+      cf_assert(sendSize <= maxElemSendSize);
+      const CFuint endElem = countElem + sendSize/nodesPlusStates;
       
-      MPI_Allreduce(&sendElements[0], &elementToPrint[0], maxElemSendSize, MPIStructDef::getMPIType(&sendElements[0]), MPI_MAX, _comm);
+      // the I/O rank collects the elements of the current range
+      collectRange(sendIDs, sendElements, nodesPlusStates, countElem, endElem, 
+		   first, _ioRank, printBuf, _comm);
       
       CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
 		    (" elementToPrint  = ", &elementToPrint, nodesPlusStates) << "\n");
@@ -539,16 +549,13 @@ void ParCFmeshFileWriter::writeElementList(std::ofstream *const fout)
 	    *fout << elementToPrint[i] << endl;
 	  }
 	}
+	
+	//reset the all elementToPrint list to 0
+	elementToPrint.assign(elementToPrint.size(), 0);
       }
-
-      //reset the all sendElement list to 0
-      for (CFuint i = 0; i < maxElemSendSize; ++i) {
-	sendElements[i] = 0;
-	elementToPrint[i] = 0;
-      }
-
+      
       // update the count element for the current element type
-      countElem += elementList.getSendDataSize(rangeID)/nodesPlusStates;
+      countElem = endElem;
     }
   }
   
@@ -675,79 +682,61 @@ void ParCFmeshFileWriter::writeNodeList(std::ofstream *const fout)
     minElemID = maxElemID;
   }
 
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
-  const CFuint nbLocalElementsInType = nodes.size();
-  for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
-    elementList.insertElemLocalID(iElem, nodes[iElem]->getGlobalID(), 0);
+  // values of the nodes updated by this process, sorted by global ID
+  CFuint nbSendNodes = 0;
+  for (CFuint iElem = 0; iElem < nbLocalElements; ++iElem) {
+    if (nodes[iElem]->isParUpdatable()) {++nbSendNodes;}
   }
-  elementList.endElemInsertion(_myRank);
-
-  // buffer data to send
-  vector<CFreal> sendElements(maxElemSendSize, 0);
-  vector<CFreal> elementToPrint(maxElemSendSize, 0);
-
-  CFuint rangeID = 0;
-  CFuint countElem = 0;
-  for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-    bool isRangeFound = false;
-    WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
-
-    if (isRangeFound) {
-
-      CFuint eSize = 0;
-      for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	const CFuint localElemID = it->second;
-	const CFuint globalElemID = nodes[localElemID]->getGlobalID();
-	const CFuint sendElemID = globalElemID - countElem;
-	
-	// only if the node is parallel updatable nmust be written
-	if (nodes[localElemID]->isParUpdatable()) {
-	  CFuint isend = sendElemID*nodesStride;
-	  for (CFuint in = 0; in < dim; ++in, ++isend) {
-	    cf_assert(isend < sendElements.size());
-	    sendElements[isend] = (*nodes[localElemID])[in];
-	  }
-	  
-	  if(storePastNodes){
-	    const RealVector* pastNodesValues = getWriteData().getPastNode(localElemID);
-	    cf_assert(pastNodesValues->size() == (*nodes[localElemID]).size());
-	    for (CFuint in = 0; in < pastNodesValues->size(); ++in, ++isend) {
-	      cf_assert(isend < sendElements.size());
-	      sendElements[isend] = (*pastNodesValues)[in];
-	    }
-	  }
-	  
-	  if (nbExtraNodalVars > 0) {
-	    const RealVector& extraNodalValues = getWriteData().getExtraNodalValues(localElemID);
-	    cf_assert(extraNodalValues.size() == totalNbExtraNodalVars);
-	    for (CFuint in = 0; in < totalNbExtraNodalVars; ++in, ++isend) {
-	      cf_assert(isend < sendElements.size());
-	      sendElements[isend] = extraNodalValues[in];
-	    }
-	  }
+  
+  vector<CFuint> sendIDs(nbSendNodes);
+  vector<CFreal> sendElements(nbSendNodes*nodesStride);
+  CFuint isend = 0;
+  for (CFuint iElem = 0, iSendNode = 0; iElem < nbLocalElements; ++iElem) {
+    // only if the node is parallel updatable must be written
+    if (nodes[iElem]->isParUpdatable()) {
+      sendIDs[iSendNode++] = nodes[iElem]->getGlobalID();
+      
+      for (CFuint in = 0; in < dim; ++in, ++isend) {
+	sendElements[isend] = (*nodes[iElem])[in];
+      }
+      
+      if(storePastNodes){
+	const RealVector* pastNodesValues = getWriteData().getPastNode(iElem);
+	cf_assert(pastNodesValues->size() == (*nodes[iElem]).size());
+	for (CFuint in = 0; in < pastNodesValues->size(); ++in, ++isend) {
+	  sendElements[isend] = (*pastNodesValues)[in];
 	}
       }
       
-      cf_assert(eSize*nodesStride <= elementList.getSendDataSize(rangeID));
+      if (nbExtraNodalVars > 0) {
+	const RealVector& extraNodalValues = getWriteData().getExtraNodalValues(iElem);
+	cf_assert(extraNodalValues.size() == totalNbExtraNodalVars);
+	for (CFuint in = 0; in < totalNbExtraNodalVars; ++in, ++isend) {
+	  sendElements[isend] = extraNodalValues[in];
+	}
+      }
     }
-
-    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		  (" sendElements  = ", &sendElements, nodesStride) << "\n");
-
-    const CFuint sendSize = elementList.getSendDataSize(rangeID);
-    cf_assert(sendSize <= sendElements.size());
-    cf_assert(sendSize <= elementToPrint.size());
-
-    MPI_Op myMpiOp;
-    MPI_Op_create((MPI_User_function *)cmpAndTakeMaxAbs, 1, &myMpiOp);
-    
-    MPI_Datatype MPI_CFREAL = MPIStructDef::getMPIType(&elementToPrint[0]);
-    
-//    MPI_Reduce(&sendElements[0], &elementToPrint[0], sendSize,
-//	       MPI_CFREAL, myMpiOp, _ioRank, _comm);
+  }
+  cf_assert(isend == sendElements.size());
+  sortByGlobalID(sendIDs, sendElements, nodesStride);
+  
+  CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		(" sendElements  = ", &sendElements, nodesStride) << "\n");
+  
+  // only the I/O rank holds the buffer of one range of nodal data
+  vector<CFreal> elementToPrint((_myRank == _ioRank) ? maxElemSendSize : 0, 0.);
+  CFreal* const printBuf = (_myRank == _ioRank) ? &elementToPrint[0] : CFNULL;
+  
+  CFuint first = 0;
+  CFuint countElem = 0;
+  for (CFuint is = 0; is < nSend; ++is) {
+    const CFuint sendSize = elementList.getSendDataSize(is);
+    cf_assert(sendSize <= maxElemSendSize);
+    const CFuint endElem = countElem + sendSize/nodesStride;
     
-    MPI_Allreduce(&sendElements[0], &elementToPrint[0], maxElemSendSize, MPI_CFREAL, myMpiOp, _comm);
+    // the I/O rank collects the nodes of the current range
+    collectRange(sendIDs, sendElements, nodesStride, countElem, endElem, 
+		 first, _ioRank, printBuf, _comm);
     
     CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
 		  (" elementToPrint  = ", &elementToPrint, nodesStride) << "\n");
@@ -769,16 +758,13 @@ void ParCFmeshFileWriter::writeNodeList(std::ofstream *const fout)
 	  countN = 0; // reset countN to 0
 	}
       }
-    }
-
-    //reset the all sendElement list to 0
-    for (CFuint i = 0; i < maxElemSendSize; ++i) {
-      sendElements[i] = 0;
-      elementToPrint[i] = 0;
+      
+      //reset the all elementToPrint list to 0
+      elementToPrint.assign(elementToPrint.size(), 0.);
     }
 
     // update the count element for the current element type
-    countElem += elementList.getSendDataSize(rangeID)/nodesStride;
+    countElem = endElem;
   }
 
   CFLogInfo("Nodes written \n");
@@ -860,88 +846,69 @@ void ParCFmeshFileWriter::writeStateList(std::ofstream *const fout)
       minElemID = maxElemID;
     }
 
-    // insert in the write list the local IDs of the elements
-    // the range ID is automatically determined inside the WriteListMap
-    const CFuint nbLocalElementsInType = states.size();
-    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
-      elementList.insertElemLocalID(iElem, states[iElem]->getGlobalID(), 0);
+    // values of the states updated by this process, sorted by global ID
+    CFuint nbSendStates = 0;
+    for (CFuint iElem = 0; iElem < nbLocalElements; ++iElem) {
+      if (states[iElem]->isParUpdatable()) {++nbSendStates;}
     }
-    elementList.endElemInsertion(_myRank);
-
-    // buffer data to send
-    vector<CFreal> sendElements(maxElemSendSize, 0);
-    vector<CFreal> elementToPrint(maxElemSendSize, 0);
-
-    CFuint rangeID = 0;
-    CFuint countElem = 0;
-    for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-      bool isRangeFound = false;
-      WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
-
-      if (isRangeFound) {
-
-	CFuint eSize = 0;
-	for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	  const CFuint localElemID = it->second;
-	  const CFuint globalElemID = states[localElemID]->getGlobalID();
-	  const CFuint sendElemID = globalElemID - countElem;
-	  
-	  // only if the state is parallel updatable must be written
-	  if (states[localElemID]->isParUpdatable()) {
-	    CFuint isend = sendElemID*statesStride;
-	    for (CFuint in = 0; in < dim; ++in, ++isend) {
-	      cf_assert(isend < sendElements.size());
-	      sendElements[isend] = (*states[localElemID])[in];
-	    }
-	    
-	    if(storePastStates){
-	      const RealVector* pastStatesValues = getWriteData().getPastState(localElemID);
-	      cf_assert(pastStatesValues->size() == (*states[localElemID]).size());
-	      for (CFuint in = 0; in < pastStatesValues->size(); ++in, ++isend) {
-		cf_assert(isend < sendElements.size());
-		sendElements[isend] = (*pastStatesValues)[in];
-	      }
-	    }
-	    
-	    if(storeInterStates){
-	      const RealVector* interStatesValues = getWriteData().getInterState(localElemID);
-	      cf_assert(interStatesValues->size() == (*states[localElemID]).size());
-	      for (CFuint in = 0; in < interStatesValues->size(); ++in, ++isend) {
-		cf_assert(isend < sendElements.size());
-		sendElements[isend] = (*interStatesValues)[in];
-	      }
-	    }
-	    
-	    if (nbExtraStateVars > 0) {
-	      const RealVector& extraStateValues = getWriteData().getExtraStateValues(localElemID);
-	      cf_assert(extraStateValues.size() == totalNbExtraStateVars);
-	      for (CFuint in = 0; in < totalNbExtraStateVars; ++in, ++isend) {
-		cf_assert(isend < sendElements.size());
-		sendElements[isend] = extraStateValues[in];
-	      }
-	    }
+    
+    vector<CFuint> sendIDs(nbSendStates);
+    vector<CFreal> sendElements(nbSendStates*statesStride);
+    CFuint isend = 0;
+    for (CFuint iElem = 0, iSendState = 0; iElem < nbLocalElements; ++iElem) {
+      // only if the state is parallel updatable must be written
+      if (states[iElem]->isParUpdatable()) {
+	sendIDs[iSendState++] = states[iElem]->getGlobalID();
+	
+	for (CFuint in = 0; in < dim; ++in, ++isend) {
+	  sendElements[isend] = (*states[iElem])[in];
+	}
+	
+	if(storePastStates){
+	  const RealVector* pastStatesValues = getWriteData().getPastState(iElem);
+	  cf_assert(pastStatesValues->size() == (*states[iElem]).size());
+	  for (CFuint in = 0; in < pastStatesValues->size(); ++in, ++isend) {
+	    sendElements[isend] = (*pastStatesValues)[in];
 	  }
 	}
 	
-	cf_assert(eSize*statesStride <= elementList.getSendDataSize(rangeID));
+	if(storeInterStates){
+	  const RealVector* interStatesValues = getWriteData().getInterState(iElem);
+	  cf_assert(interStatesValues->size() == (*states[iElem]).size());
+	  for (CFuint in = 0; in < interStatesValues->size(); ++in, ++isend) {
+	    sendElements[isend] = (*interStatesValues)[in];
+	  }
+	}
+	
+	if (nbExtraStateVars > 0) {
+	  const RealVector& extraStateValues = getWriteData().getExtraStateValues(iElem);
+	  cf_assert(extraStateValues.size() == totalNbExtraStateVars);
+	  for (CFuint in = 0; in < totalNbExtraStateVars; ++in, ++isend) {
+	    sendElements[isend] = extraStateValues[in];
+	  }
+	}
       }
-
-      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		    (" sendElements  = ", &sendElements, statesStride) << "\n");
-
-      const CFuint sendSize = elementList.getSendDataSize(rangeID);
-      cf_assert(sendSize <= sendElements.size());
-      cf_assert(sendSize <= elementToPrint.size());
-
-      MPI_Op myMpiOp;
-      MPI_Op_create((MPI_User_function *)cmpAndTakeMaxAbs, 1, &myMpiOp);
-
-      MPI_Datatype MPI_CFREAL = MPIStructDef::getMPIType(&elementToPrint[0]);
-
-      //  MPI_Reduce(&sendElements[0], &elementToPrint[0], sendSize,
-      // 		 MPI_CFREAL, myMpiOp, _ioRank, _comm);
+    }
+    cf_assert(isend == sendElements.size());
+    sortByGlobalID(sendIDs, sendElements, statesStride);
+    
+    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		  (" sendElements  = ", &sendElements, statesStride) << "\n");
+    
+    // only the I/O rank holds the buffer of one range of state data
+    vector<CFreal> elementToPrint((_myRank == _ioRank) ? maxElemSendSize : 0, 0.);
+    CFreal* const printBuf = (_myRank == _ioRank) ? &elementToPrint[0] : CFNULL;
+    
+    CFuint first = 0;
+    CFuint countElem = 0;
+    for (CFuint is = 0; is < nSend; ++is) {
+      const CFuint sendSize = elementList.getSendDataSize(is);
+      cf_assert(sendSize <= maxElemSendSize);
+      const CFuint endElem = countElem + sendSize/statesStride;
       
-      MPI_Allreduce(&sendElements[0], &elementToPrint[0], maxElemSendSize, MPI_CFREAL, myMpiOp, _comm);
+      // the I/O rank collects the states of the current range
+      collectRange(sendIDs, sendElements, statesStride, countElem, endElem, 
+		   first, _ioRank, printBuf, _comm);
       
       CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
 		    (" elementToPrint  = ", &elementToPrint, statesStride) << "\n");
@@ -959,16 +926,13 @@ void ParCFmeshFileWriter::writeStateList(std::ofstream *const fout)
 	    *fout << elementToPrint[i] << endl;
 	  }
 	}
-      }
-
-      //reset the all sendElement list to 0
-      for (CFuint i = 0; i < maxElemSendSize; ++i) {
-	sendElements[i] = 0;
-	elementToPrint[i] = 0;
+	
+	//reset the all elementToPrint list to 0
+	elementToPrint.assign(elementToPrint.size(), 0.);
       }
 
       // update the count element for the current element type
-      countElem += elementList.getSendDataSize(rangeID)/statesStride;
+      countElem = endElem;
     }
   }
 
@@ -1082,16 +1046,6 @@ void ParCFmeshFileWriter::writeGeoList(CFuint iTRS, ofstream *const fout)
     }
   }
 
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
-  for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
-    const CFuint nbLocalElementsInType = (*trs)[iType]->getLocalNbGeoEnts();
-    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
-      elementList.insertElemLocalID(iElem, (*globalGeoIDS)[iTRS][iType][iElem], iType);
-    }
-  }
-  elementList.endElemInsertion(_myRank);
-  
   DataHandle < Framework::Node*, Framework::GLOBAL > nodes =
     MeshDataStack::getActive()->getNodeDataSocketSink().getDataHandle();
   cf_assert(nodes.size() > 0);
@@ -1100,86 +1054,68 @@ void ParCFmeshFileWriter::writeGeoList(CFuint iTRS, ofstream *const fout)
     MeshDataStack::getActive()->getStateDataSocketSink().getDataHandle();
   cf_assert(states.size() > 0);
 
-  // buffer data to send
-  vector<CFint> sendElements(maxElemSendSize, -1);
-  vector<CFint> elementToPrint(maxElemSendSize, -1);
+  // only the I/O rank holds the buffer of one range of TR data
+  vector<CFint> elementToPrint((_myRank == _ioRank) ? maxElemSendSize : 0, -1);
+  CFint* const printBuf = (_myRank == _ioRank) ? &elementToPrint[0] : CFNULL;
   
   CFuint rangeID = 0;
   for (CFuint iType = 0; iType < nbElementTypes; ++iType) {
     const CFuint maxNbNodesInType  = nbNodesStatesInTRGeo(iType, 0);
     const CFuint maxNbStatesInType = nbNodesStatesInTRGeo(iType, 1);
     const CFuint maxNodesPlusStates = maxNbNodesInType + maxNbStatesInType + 2;
-
+    
+    // global IDs and connectivity of the local TR geometric entities, 
+    // sorted by global ID: each process sends only its own entities
+    const CFuint nbLocalElementsInType = (*trs)[iType]->getLocalNbGeoEnts();
+    vector<CFuint> sendIDs(nbLocalElementsInType);
+    vector<CFint> sendElements(nbLocalElementsInType*maxNodesPlusStates, -1);
+    for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem) {
+      sendIDs[iElem] = (*globalGeoIDS)[iTRS][iType][iElem];
+      
+      CFuint isend = iElem*maxNodesPlusStates;
+      // number of nodes in the current TR geo entity
+      const CFuint nbNodesInTRGeo  = (*trs)[iType]->getNbNodesInGeo(iElem);
+      sendElements[isend++] = nbNodesInTRGeo;
+      
+      // number of states in the current TR geo entity
+      const CFuint nbStatesInTRGeo = (isFVMCC) ? 1 : (*trs)[iType]->getNbStatesInGeo(iElem);
+      sendElements[isend++] = nbStatesInTRGeo;
+      
+      // TR geo nodes data
+      for (CFuint in = 0; in < maxNbNodesInType; ++in, ++isend) {
+	// the local node ID is set to -1 if the maximum number of nodes exceeds the actual value
+	const CFint localNodeID = (in < nbNodesInTRGeo) ?
+	  static_cast<CFint>((*trs)[iType]->getNodeID(iElem, in)) : -1;
+	// set the global ID to -1 if the local ID is -1
+	sendElements[isend] = (localNodeID != -1) ?
+	  static_cast<CFint>(nodes[localNodeID]->getGlobalID()) : -1;
+      }
+      
+      // TR geo states data
+      for (CFuint in = 0; in < maxNbStatesInType; ++in, ++isend) {
+	// the local state ID is set to -1 if the maximum number of states exceeds the actual value
+	const CFint localStateID = (in < nbStatesInTRGeo) ?
+	  static_cast<CFint>((*trs)[iType]->getStateID(iElem, in)) : -1;
+	// set the global ID to -1 if the local ID is -1
+	sendElements[isend] = (localStateID != -1) ?
+	  static_cast<CFint>(states[localStateID]->getGlobalID()) : -1;
+      }
+    }
+    sortByGlobalID(sendIDs, sendElements, maxNodesPlusStates);
+    
+    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFint> >
+		  (" sendElements  = ", &sendElements, maxNodesPlusStates) << "\n");
+    
+    CFuint first = 0;
     CFuint countElem = 0;
     for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-      bool isRangeFound = false;
-      WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
-
-      if (isRangeFound) {
-	CFuint eSize = 0;
-	for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	  const CFuint localElemID = it->second;
-	  const CFuint globalElemID = (*globalGeoIDS)[iTRS][iType][localElemID];
-	  const CFuint sendElemID = globalElemID - countElem;
-
-	  CFLogDebugMax("localElemID = " << localElemID <<
-			", globalElemID = " << globalElemID <<
-			", sendElemID = " << sendElemID << "\n");
-
-	  CFuint isend = sendElemID*maxNodesPlusStates;
-	  // number of nodes in the current TR geo entity
-	  const CFuint nbNodesInTRGeo  = (*trs)[iType]->getNbNodesInGeo(localElemID);
-	  sendElements[isend++] = nbNodesInTRGeo;
-
-	  // number of states in the current TR geo entity
-	  const CFuint nbStatesInTRGeo = (isFVMCC) ? 1 : (*trs)[iType]->getNbStatesInGeo(localElemID);
-	  sendElements[isend++] = nbStatesInTRGeo;
-
-	  // TR geo nodes data
-	  for (CFuint in = 0; in < maxNbNodesInType; ++in, ++isend) {
-	    // the local node ID is set to -1 if the maximum number of nodes exceeds the actual value
-	    const CFint localNodeID = (in < nbNodesInTRGeo) ?
-	      static_cast<CFint>((*trs)[iType]->getNodeID(localElemID, in)) : -1;
-	    if (isend >= sendElements.size()) {
-	      CFLogDebugMin(_myRank << " maxNbNodesInType = " << maxNbNodesInType
-			    << " node isend = " << isend << " , size = " << sendElements.size() << "\n");
-	      cf_assert(isend < sendElements.size());
-	    }
-	    // set the global ID to -1 if the local ID is -1
-	    sendElements[isend] = (localNodeID != -1) ?
-	      static_cast<CFint>(nodes[localNodeID]->getGlobalID()) : -1;
-	  }
-
-	  // TR geo states data
-	  for (CFuint in = 0; in < maxNbStatesInType; ++in, ++isend) {
-	    // the local state ID is set to -1 if the maximum number of states exceeds the actual value
-	    const CFint localStateID = (in < nbStatesInTRGeo) ?
-	      static_cast<CFint>((*trs)[iType]->getStateID(localElemID, in)) : -1;
-	    if (isend >= sendElements.size()) {
-	      CFLogDebugMin(_myRank << " state isend = " << isend << " , size = " << sendElements.size() << "\n");
-	      cf_assert(isend < sendElements.size());
-	    }
-	    // set the global ID to -1 if the local ID is -1
-	    sendElements[isend] = (localStateID != -1) ?
-	      static_cast<CFint>(states[localStateID]->getGlobalID()) : -1;
-	  }
-	}
-
-	cf_assert(eSize*maxNodesPlusStates <= elementList.getSendDataSize(rangeID));
-      }
-
-      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFint> >
-		    (" sendElements  = ", &sendElements, maxNodesPlusStates) << "\n");
-
       const CFuint sendSize = elementList.getSendDataSize(rangeID);
-      cf_assert(sendSize <= sendElements.size());
-      cf_assert(sendSize <= elementToPrint.size());
-
-      //   MPI_Reduce(&sendElements[0], &elementToPrint[0], sendSize,
-      // 		 MPIStructDef::getMPIType(&sendElements[0]), MPI_MAX, _ioRank, _comm);
+      cf_assert(sendSize <= maxElemSendSize);
+      const CFuint endElem = countElem + sendSize/maxNodesPlusStates;
       
-      MPI_Allreduce(&sendElements[0], &elementToPrint[0], maxElemSendSize, 
-		    MPIStructDef::getMPIType(&elementToPrint[0]), MPI_MAX, _comm);
+      // the I/O rank collects the entities of the current range
+      collectRange(sendIDs, sendElements, maxNodesPlusStates, countElem, endElem, 
+		   first, _ioRank, printBuf, _comm);
       
       CFLogDebugMax(_myRank << CFPrintContainer<vector<CFint> >
 		    (" elementToPrint  = ", &elementToPrint, maxNodesPlusStates) << "\n");
@@ -1200,16 +1136,13 @@ void ParCFmeshFileWriter::writeGeoList(CFuint iTRS, ofstream *const fout)
 	    }
 	  }
 	}
-      }
-
-      //reset the all sendElement list to 0
-      for (CFuint i = 0; i < maxElemSendSize; ++i) {
-	sendElements[i] = -1;
-	elementToPrint[i] = -1;
+	
+	//reset the all elementToPrint list to -1
+	elementToPrint.assign(elementToPrint.size(), -1);
       }
 
       // update the count element for the current element type
-      countElem += elementList.getSendDataSize(rangeID)/maxNodesPlusStates;
+      countElem = endElem;
     }
   }
 }
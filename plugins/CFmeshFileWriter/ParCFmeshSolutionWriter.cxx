@@ -0,0 +1,175 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <numeric>
+
+#include "CFmeshFileWriter/ParCFmeshSolutionWriter.hh"
+#include "Framework/PhysicalModel.hh"
+#include "Framework/MeshData.hh"
+#include "Framework/MeshSignature.hh"
+#include "Common/MPI/MPIIOFunctions.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace CFmeshFileWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+ParCFmeshSolutionWriter::ParCFmeshSolutionWriter() :
+  ParCFmeshBinaryFileWriter()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+ParCFmeshSolutionWriter::~ParCFmeshSolutionWriter()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshSolutionWriter::writeToFileStream
+(const boost::filesystem::path& filepath)
+{
+  CFLog(VERBOSE, "ParCFmeshSolutionWriter::writeToFileStream() start\n");
+
+  const string nsp = MeshDataStack::getActive()->getPrimaryNamespace();
+  const string writerName = nsp + "_Writers";
+  Group& wg = PE::GetPE().getGroup(writerName);
+
+  char* fileName = const_cast<char*>(filepath.string().c_str());
+  CFLog(VERBOSE, "fileName = " << filepath.string() << "\n");
+
+  // the checkpoint is always rewritten from scratch
+  if (_isWriterRank) {
+    MPI_File_open(wg.comm, fileName, MPI_MODE_RDWR | MPI_MODE_CREATE, MPI_INFO_NULL, &_fh);
+    MPI_File_set_size(_fh, 0);
+  }
+
+  writeVersionStamp(&_fh);
+
+  // global counts and mesh signature
+  writeSolutionCounts(&_fh);
+
+  // info about the data attached to the states
+  writeStateVarsInfo(&_fh);
+
+  // extra vars that are not state or node related
+  writeExtraVars(&_fh);
+
+  // the state list starts right after the header written by the IO rank
+  MPI_Offset position = 0;
+  if (_myRank == _ioRank) {
+    MPI_File_get_position(_fh, &position);
+  }
+  MPI_Bcast(&position, 1, MPIStructDef::getMPIOffsetType(), _ioRank, _comm);
+  _offset[0].nodes.second = position;
+
+  // write the state list
+  writeStateList(&_fh);
+
+  // terminate the file
+  writeEndFile(&_fh);
+
+  if (_isWriterRank) {
+    MPI_File_close(&_fh);
+  }
+
+  CFLog(VERBOSE, "ParCFmeshSolutionWriter::writeToFileStream() end\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshSolutionWriter::writeSolutionCounts(MPI_File* fh)
+{
+  CFLog(VERBOSE, "ParCFmeshSolutionWriter::writeSolutionCounts() start\n");
+
+  SafePtr<MeshData> meshData = MeshDataStack::getActive();
+  const CFuint totNbStates = meshData->getTotalStateCount();
+  const vector<CFuint>& tElem = meshData->getTotalElements();
+
+  // all the processors contribute to the signature of the mesh
+  const uint64_t signature = computeMeshSignature
+    (*meshData->getConnectivity("cellNodes_InnerCells"),
+     *meshData->getConnectivity("cellStates_InnerCells"),
+     meshData->getNodeDataSocketSink().getDataHandle(),
+     meshData->getStateDataSocketSink().getDataHandle(),
+     meshData->getTotalNodeCount(), totNbStates,
+     (CFuint)std::accumulate(tElem.begin(), tElem.end(), 0), _comm);
+
+  if (_myRank == _ioRank) {
+    MPIIOFunctions::writeKeyValue<CFuint>(fh, "\n!NB_DIM ", false, PhysicalModelStack::getActive()->getDim());
+    MPIIOFunctions::writeKeyValue<CFuint>(fh, "\n!NB_EQ ", false, PhysicalModelStack::getActive()->getNbEq());
+
+    MPIIOFunctions::writeKeyValue<CFuint>(fh, "\n!NB_STATES ", false, totNbStates);
+    CFuint nuStates = getWriteData().getNbNonUpdatableStates();
+    MPI_File_write(*fh, &nuStates, 1, MPIStructDef::getMPIType(&nuStates), &_status);
+
+    MPIIOFunctions::writeKeyValue<char>(fh, "\n!MESH_SIGNATURE ");
+    MPI_File_write(*fh, const_cast<uint64_t*>(&signature), 1, MPI_UINT64_T, &_status);
+  }
+
+  CFLog(VERBOSE, "ParCFmeshSolutionWriter::writeSolutionCounts() end\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ParCFmeshSolutionWriter::writeStateVarsInfo(MPI_File* fh)
+{
+  CFLog(VERBOSE, "ParCFmeshSolutionWriter::writeStateVarsInfo() start\n");
+
+  if (_myRank == _ioRank) {
+    // the flags are always written, since they override the ones of the mesh
+    MPIIOFunctions::writeKeyValue<CFuint>(fh, "\n!STORE_PASTSTATES ", false, getWriteData().storePastStates());
+    MPIIOFunctions::writeKeyValue<CFuint>(fh, "\n!STORE_INTERSTATES ", false, getWriteData().storeInterStates());
+
+    const CFuint nbExtraStateVars = getWriteData().getNbExtraStateVars();
+    if (nbExtraStateVars > 0) {
+      MPIIOFunctions::writeKeyValue<CFuint>(fh, "\n!NB_EXTRA_SVARS ", false, nbExtraStateVars);
+
+      MPIIOFunctions::writeKeyValue<char>(fh, "\n!EXTRA_SVARS_NAMES ");
+      for(CFuint iVar = 0; iVar < nbExtraStateVars; iVar++) {
+	MPIIOFunctions::writeKeyValue<char>(fh, (*(getWriteData().getExtraStateVarNames()))[iVar] + " ");
+      }
+      MPIIOFunctions::writeKeyValue<char>(fh, "\n!EXTRA_SVARS_STRIDES ");
+      MPI_File_write(*fh, &(*(getWriteData().getExtraStateVarStrides()))[0],
+		     (int)nbExtraStateVars,
+		     MPIStructDef::getMPIType(&(*(getWriteData().getExtraStateVarStrides()))[0]), &_status);
+    }
+
+    const CFuint nbExtraVars = getWriteData().getNbExtraVars();
+    if (nbExtraVars > 0) {
+      MPIIOFunctions::writeKeyValue<CFuint>(fh, "\n!NB_EXTRA_VARS ", false, nbExtraVars);
+
+      MPIIOFunctions::writeKeyValue<char>(fh, "\n!EXTRA_VARS_NAMES ");
+      for(CFuint iVar = 0; iVar < nbExtraVars; iVar++) {
+	MPIIOFunctions::writeKeyValue<char>(fh, (*(getWriteData().getExtraVarNames()))[iVar] + " ");
+      }
+      MPIIOFunctions::writeKeyValue<char>(fh, "\n!EXTRA_VARS_STRIDES ");
+      MPI_File_write(*fh, &(*(getWriteData().getExtraVarStrides()))[0],
+		     (int)nbExtraVars,
+		     MPIStructDef::getMPIType(&(*(getWriteData().getExtraVarStrides()))[0]), &_status);
+    }
+  }
+
+  CFLog(VERBOSE, "ParCFmeshSolutionWriter::writeStateVarsInfo() end\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace CFmeshFileWriter
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,75 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_CFmeshFileWriter_ParCFmeshSolutionWriter_hh
+#define COOLFluiD_CFmeshFileWriter_ParCFmeshSolutionWriter_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "CFmeshFileWriter/ParCFmeshBinaryFileWriter.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+    namespace CFmeshFileWriter {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class writes binary solution-only checkpoints (.CFsol), holding
+/// the states, the past and intermediate states and the extra state
+/// variables in global ID order, without the topology and the nodes of
+/// the mesh. The file carries the signature of the mesh it belongs to and
+/// is read back together with the original mesh by the parallel binary
+/// CFmesh reader (option SolutionFile).
+/// Nodal data (past and intermediate nodes, extra nodal variables) are
+/// not stored: moving mesh simulations must be restarted from a CFmesh.
+class CFmeshFileWriter_API ParCFmeshSolutionWriter :
+	public ParCFmeshBinaryFileWriter {
+
+ public:
+
+  /// Constructor.
+  ParCFmeshSolutionWriter();
+
+  /// Destructor.
+  virtual ~ParCFmeshSolutionWriter();
+
+  /// Get the file extension
+  const std::string getWriterFileExtension() const
+  {
+    return std::string(".CFsol");
+  }
+
+protected: // helper functions
+
+  /// Writes to the given file.
+  /// @throw Common::FilesystemException
+  virtual void writeToFileStream(const boost::filesystem::path& filepath);
+
+  /// Get the name of the reader
+  const std::string getWriterName() const
+  {
+    return "ParCFmeshSolutionWriter";
+  }
+
+  /// Writes the number of states and the signature of the mesh
+  void writeSolutionCounts(MPI_File* fh);
+
+  /// Writes the info about the data stored with each state
+  void writeStateVarsInfo(MPI_File* fh);
+
+}; // class ParCFmeshSolutionWriter
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace CFmeshFileWriter
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_CFmeshFileWriter_ParCFmeshSolutionWriter_hh
@@ -8,6 +8,7 @@
 #include "CFmeshFileWriter/ParWriteSolution.hh"
 #include "CFmeshFileWriter/ParCFmeshFileWriter.hh"
 #include "CFmeshFileWriter/ParCFmeshBinaryFileWriter.hh"
+#include "CFmeshFileWriter/ParCFmeshSolutionWriter.hh"
 #include "Framework/MethodCommandProvider.hh"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -30,6 +31,10 @@ MethodCommandProvider<ParWriteSolution<ParCFmeshBinaryFileWriter>,
 		      CFmeshWriterData, CFmeshFileWriterModule>
 parWriteBinarySolutionProvider("ParWriteBinarySolution");
 
+MethodCommandProvider<ParWriteSolution<ParCFmeshSolutionWriter>, 
+		      CFmeshWriterData, CFmeshFileWriterModule>
+parWriteSolutionOnlyProvider("ParWriteSolutionOnly");
+
 //////////////////////////////////////////////////////////////////////////////
 
     } // namespace CFmeshFileWriter
@@ -47,7 +47,38 @@ public:
   std::string groupName;     // name of the MPI group in which data transfer is active
   MPI_Op operation;          // MPI operation to apply
 };
- 
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class represents a plan for the direct redistribution of data between
+ * the ranks of the send and recv namespaces: it stores, for each peer rank
+ * in the transfer group, the positions of the local dofs whose data are
+ * exchanged with it, in an order which is agreed upon by both sides
+ */
+class TransferPlan {
+public:
+
+  /// default constructor
+  TransferPlan() {isBuilt = false; nbDofs = 0; dofsHash = 0;}
+
+  // destructor
+  ~TransferPlan() {}
+
+  bool isBuilt;                      // tells if the plan has been built
+  CFuint nbDofs;                     // number of local dofs in the plan (to detect repartitioning)
+  unsigned long long dofsHash;       // hash of the (global ID, position) pairs of those dofs (to detect repartitioning)
+  std::vector<int> sendRanks;        // ranks (in the transfer group) to which data are sent
+  std::vector<CFuint> sendPtr;       // start of the dofs to send to each rank in sendDofs
+  std::vector<CFuint> sendDofs;      // positions of the local dofs to send
+  std::vector<int> recvRanks;        // ranks (in the transfer group) from which data are received
+  std::vector<CFuint> recvPtr;       // start of the dofs to receive from each rank in recvDofs
+  std::vector<CFuint> recvDofs;      // positions of the local dofs to receive
+  std::vector<CFreal> sendBuf;       // buffer for the data to send
+  std::vector<CFreal> recvBuf;       // buffer for the data to receive
+  std::vector<MPI_Request> requests; // requests for the non blocking communication
+};
+
 //////////////////////////////////////////////////////////////////////////////
     
     } // namespace ConcurrentCoupler
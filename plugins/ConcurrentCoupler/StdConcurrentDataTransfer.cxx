@@ -2,6 +2,7 @@
 
 #include "Common/NotImplementedException.hh"
 #include "Common/CFPrintContainer.hh"
+#include "Common/BadValueException.hh"
 
 #include "Framework/DataHandle.hh"
 #include "Framework/MethodCommandProvider.hh"
@@ -47,6 +48,8 @@ void StdConcurrentDataTransfer::defineConfigOptions(Config::OptionList& options)
     ("SocketsConnType","Connectivity type for sockets to transfer (State or Node): this is ne1eded to define global IDs.");
   options.addConfigOption< vector<string> >
     ("SendToRecvVariableTransformer","Variables transformers from send to recv variables.");
+  options.addConfigOption< bool >
+    ("UseTransferPlan","Redistribute data directly between send and recv ranks following a precomputed plan also when only one side has several ranks (always done if both sides have several ranks).");
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -57,6 +60,7 @@ StdConcurrentDataTransfer::StdConcurrentDataTransfer(const std::string& name) :
   _sockets(),
   socket_states("states"),
   _sendToRecvVecTrans(),
+  _plans(),
   _isTransferRank(),
   _global2localIDs(),
   _socketName2data()
@@ -71,6 +75,9 @@ StdConcurrentDataTransfer::StdConcurrentDataTransfer(const std::string& name) :
   
   _sendToRecvVecTransStr = vector<string>();
   setParameter("SendToRecvVariableTransformer", &_sendToRecvVecTransStr);
+  
+  _useTransferPlan = false;
+  setParameter("UseTransferPlan", &_useTransferPlan);
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -150,6 +157,7 @@ void StdConcurrentDataTransfer::setup()
   
   cf_assert(_socketsSendRecv.size() > 0);
   _isTransferRank.resize(_socketsSendRecv.size());
+  _plans.resize(_socketsSendRecv.size());
 }
  
 //////////////////////////////////////////////////////////////////////////////
@@ -180,7 +188,13 @@ void StdConcurrentDataTransfer::execute()
       const CFuint nbRanksSend = dtt->nbRanksSend;
       const CFuint nbRanksRecv = dtt->nbRanksRecv;
       
-      if (nbRanksSend > 1 && nbRanksRecv == 1) {
+      // M x N transfers can only be done following a plan, while 
+      // N x 1 and 1 x N transfers use it only if requested
+      if ((nbRanksSend > 1 && nbRanksRecv > 1) || 
+	  (_useTransferPlan && (nbRanksSend > 1 || nbRanksRecv > 1))) {
+	redistributeData(i);
+      }
+      else if (nbRanksSend > 1 && nbRanksRecv == 1) {
 	gatherData(i);
       }
       else if (nbRanksSend == 1 && nbRanksRecv > 1) {
@@ -188,10 +202,6 @@ void StdConcurrentDataTransfer::execute()
 	scatterData(i);
 	// CFLog(VERBOSE, "StdConcurrentDataTransfer::execute() => after scatterData()\n");
       }
-      else if (nbRanksSend > 1 && nbRanksRecv > 1) {
-	throw NotImplementedException
-	  (FromHere(),"StdConcurrentDataTransfer::execute() => (nbRanksSend > 1 && nbRanksRecv > 1)");
-      }
     }
     
     // every process involved in the enclosing couping method needs to wait and synchronize 
@@ -487,6 +497,309 @@ void StdConcurrentDataTransfer::scatterData(const CFuint idx)
 	<< "] to namespace [" << nspRecv << "] within namespace [" << nspCoupling << "] => end\n");
 }
       
+//////////////////////////////////////////////////////////////////////////////
+      
+void StdConcurrentDataTransfer::redistributeData(const CFuint idx)
+{
+  SafePtr<DataToTrasfer> dtt = _socketName2data.find(_socketsSendRecv[idx]); 
+  cf_assert(dtt.isNotNull());
+  
+  const string nspSend = dtt->nspSend;
+  const string nspRecv = dtt->nspRecv;
+  const string nspCoupling = dtt->groupName;
+  
+  CFLog(INFO, "StdConcurrentDataTransfer::redistributeData() from namespace[" << nspSend 
+	<< "] to namespace [" << nspRecv << "] => start\n");
+  
+  Group& group = PE::GetPE().getGroup(nspCoupling);
+  const int rank = PE::GetPE().GetRank("Default"); // rank in MPI_COMM_WORLD
+  const bool isSendRank = PE::GetPE().isRankInGroup(rank, nspSend);
+  const bool isRecvRank = PE::GetPE().isRankInGroup(rank, nspRecv);
+  cf_assert(!(isSendRank && isRecvRank));
+  
+  // only parallel updatable dofs are sent, while all local dofs 
+  // (including ghosts) are received
+  vector<CFuint> globalIDs;
+  vector<CFuint> dofIDs;
+  if (isSendRank || isRecvRank) {
+    SafePtr<DataStorage> ds = getMethodData().getDataStorage(isSendRank ? nspSend : nspRecv);
+    cf_assert(ds.isNotNull());
+    if (_socketsConnType[idx] == "State") {
+      fillTransferDofs<State*>(dtt, ds, isSendRank, globalIDs, dofIDs);
+    }
+    if (_socketsConnType[idx] == "Node") {
+      fillTransferDofs<Node*>(dtt, ds, isSendRank, globalIDs, dofIDs);
+    }
+  }
+  
+  // the plan is rebuilt only if the dofs of any rank have changed 
+  TransferPlan& plan = _plans[idx];
+  const unsigned long long dofsHash = computeDofsHash(globalIDs, dofIDs);
+  int changed = (!plan.isBuilt || plan.nbDofs != globalIDs.size() || plan.dofsHash != dofsHash) ? 1 : 0;
+  int rebuild = 0;
+  MPIError::getInstance().check
+    ("MPI_Allreduce", "StdConcurrentDataTransfer::redistributeData()", 
+     MPI_Allreduce(&changed, &rebuild, 1, MPIStructDef::getMPIType(&changed), MPI_MAX, group.comm));
+  
+  if (rebuild == 1) {
+    buildTransferPlan(idx, globalIDs, dofIDs);
+    plan.nbDofs  = globalIDs.size();
+    plan.dofsHash = dofsHash;
+    plan.isBuilt = true;
+  }
+  
+  const CFuint sendStride = dtt->sendStride;
+  const CFuint recvStride = dtt->recvStride;
+  plan.sendBuf.resize(plan.sendDofs.size()*recvStride);
+  plan.recvBuf.resize(plan.recvDofs.size()*recvStride);
+  plan.requests.resize(plan.sendRanks.size() + plan.recvRanks.size());
+  
+  // post all the receives first
+  CFuint nbRequests = 0;
+  for (CFuint r = 0; r < plan.recvRanks.size(); ++r) {
+    const CFuint start = plan.recvPtr[r]*recvStride;
+    const int count = (plan.recvPtr[r+1] - plan.recvPtr[r])*recvStride;
+    MPIError::getInstance().check
+      ("MPI_Irecv", "StdConcurrentDataTransfer::redistributeData()", 
+       MPI_Irecv(&plan.recvBuf[start], count, MPIStructDef::getMPIType(&plan.recvBuf[0]), 
+		 plan.recvRanks[r], idx, group.comm, &plan.requests[nbRequests++]));
+  }
+  
+  // data are transformed into recv variables before being sent
+  if (plan.sendDofs.size() > 0) {
+    cf_assert(idx < _sendToRecvVecTrans.size());
+    SafePtr<VarSetTransformer> sendToRecvTrans = _sendToRecvVecTrans[idx].getPtr();
+    cf_assert(sendToRecvTrans.isNotNull());
+    RealVector tState(recvStride, static_cast<CFreal*>(NULL));
+    RealVector state(sendStride, static_cast<CFreal*>(NULL));
+    CFreal *const dataToSend = dtt->array;
+    cf_assert(dataToSend != CFNULL);
+    for (CFuint i = 0; i < plan.sendDofs.size(); ++i) {
+      cf_assert((plan.sendDofs[i]+1)*sendStride <= dtt->arraySize);
+      state.wrap(sendStride, &dataToSend[plan.sendDofs[i]*sendStride]);
+      tState.wrap(recvStride, &plan.sendBuf[i*recvStride]);
+      sendToRecvTrans->transform((const RealVector&)state, (RealVector&)tState);
+    }
+  }
+  
+  for (CFuint r = 0; r < plan.sendRanks.size(); ++r) {
+    const CFuint start = plan.sendPtr[r]*recvStride;
+    const int count = (plan.sendPtr[r+1] - plan.sendPtr[r])*recvStride;
+    MPIError::getInstance().check
+      ("MPI_Isend", "StdConcurrentDataTransfer::redistributeData()", 
+       MPI_Isend(&plan.sendBuf[start], count, MPIStructDef::getMPIType(&plan.sendBuf[0]), 
+		 plan.sendRanks[r], idx, group.comm, &plan.requests[nbRequests++]));
+  }
+  
+  if (nbRequests > 0) {
+    MPIError::getInstance().check
+      ("MPI_Waitall", "StdConcurrentDataTransfer::redistributeData()", 
+       MPI_Waitall(nbRequests, &plan.requests[0], MPI_STATUSES_IGNORE));
+  }
+  
+  // copy the received data into the local array
+  if (plan.recvDofs.size() > 0) {
+    CFreal *const dataToRecv = dtt->array;
+    cf_assert(dataToRecv != CFNULL);
+    for (CFuint i = 0; i < plan.recvDofs.size(); ++i) {
+      const CFuint startR = plan.recvDofs[i]*recvStride;
+      cf_assert(startR + recvStride <= dtt->arraySize);
+      for (CFuint s = 0; s < recvStride; ++s) {
+	dataToRecv[startR + s] = plan.recvBuf[i*recvStride + s];
+      }
+    }
+  }
+  
+  CFLog(INFO, "StdConcurrentDataTransfer::redistributeData() from namespace[" << nspSend 
+	<< "] to namespace [" << nspRecv << "] => end\n");
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+      
+unsigned long long StdConcurrentDataTransfer::computeDofsHash
+(const std::vector<CFuint>& globalIDs, const std::vector<CFuint>& dofIDs)
+{
+  cf_assert(globalIDs.size() == dofIDs.size());
+  
+  // 64-bit FNV-1a mixing of the (global ID, position) pairs, word by word, 
+  // so that renumbered or permuted dofs give a different value
+  const unsigned long long prime = 1099511628211ULL;
+  unsigned long long hash = 14695981039346656037ULL;
+  for (CFuint i = 0; i < globalIDs.size(); ++i) {
+    hash = (hash ^ static_cast<unsigned long long>(globalIDs[i]))*prime;
+    hash = (hash ^ static_cast<unsigned long long>(dofIDs[i]))*prime;
+  }
+  return hash;
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+      
+void StdConcurrentDataTransfer::buildTransferPlan(const CFuint idx, 
+						  const vector<CFuint>& globalIDs,
+						  const vector<CFuint>& dofIDs)
+{
+  CFLog(VERBOSE, "StdConcurrentDataTransfer::buildTransferPlan() => start\n");
+  
+  SafePtr<DataToTrasfer> dtt = _socketName2data.find(_socketsSendRecv[idx]); 
+  Group& group = PE::GetPE().getGroup(dtt->groupName);
+  const int rank = PE::GetPE().GetRank("Default"); // rank in MPI_COMM_WORLD
+  const bool isSendRank = PE::GetPE().isRankInGroup(rank, dtt->nspSend);
+  const CFuint nbRanks = group.globalRanks.size();
+  cf_assert(globalIDs.size() == dofIDs.size());
+  
+  // 1) each rank tells the directory rank of each of its global IDs if
+  // it owns the corresponding data (0) or if it needs them (1)
+  vector<vector<CFuint> > toDirectory(nbRanks);
+  for (CFuint i = 0; i < globalIDs.size(); ++i) {
+    vector<CFuint>& list = toDirectory[globalIDs[i]%nbRanks];
+    list.push_back(globalIDs[i]);
+    list.push_back(isSendRank ? 0 : 1);
+  }
+  
+  vector<CFuint> dirIDs;
+  vector<int> dirCounts;
+  exchangeIDs(group.comm, toDirectory, dirIDs, dirCounts);
+  
+  // 2) the directory matches each needed global ID with its owner and
+  // tells the owner to which rank it has to send the corresponding data 
+  CFMap<CFuint, CFuint> owners;
+  owners.reserve(dirIDs.size()/2);
+  for (CFuint r = 0, i = 0; r < nbRanks; ++r) {
+    for (int c = 0; c < dirCounts[r]; c += 2, i += 2) {
+      if (dirIDs[i+1] == 0) {owners.insert(dirIDs[i], r);}
+    }
+  }
+  owners.sortKeys();
+  
+  vector<vector<CFuint> > toOwner(nbRanks);
+  for (CFuint r = 0, i = 0; r < nbRanks; ++r) {
+    for (int c = 0; c < dirCounts[r]; c += 2, i += 2) {
+      if (dirIDs[i+1] == 1) {
+	bool found = false;
+	const CFuint owner = owners.find(dirIDs[i], found);
+	if (!found) {
+	  throw BadValueException
+	    (FromHere(), "StdConcurrentDataTransfer::buildTransferPlan() => global ID " + 
+	     StringOps::to_str(dirIDs[i]) + " is not owned by any rank in namespace " + dtt->nspSend);
+	}
+	toOwner[owner].push_back(dirIDs[i]);
+	toOwner[owner].push_back(r);
+      }
+    }
+  }
+  
+  vector<CFuint> ownerIDs;
+  vector<int> ownerCounts;
+  exchangeIDs(group.comm, toOwner, ownerIDs, ownerCounts);
+  
+  // 3) each owner lists the dofs to send to each rank and sends
+  // to the latter the corresponding global IDs, in the same order
+  TransferPlan& plan = _plans[idx];
+  plan.sendRanks.clear();
+  plan.sendPtr.assign(1, 0);
+  plan.sendDofs.clear();
+  
+  vector<vector<CFuint> > toRecv(nbRanks);
+  if (ownerIDs.size() > 0) {
+    CFMap<CFuint, CFuint> global2dof(globalIDs.size());
+    for (CFuint i = 0; i < globalIDs.size(); ++i) {
+      global2dof.insert(globalIDs[i], dofIDs[i]);
+    }
+    global2dof.sortKeys();
+    
+    vector<vector<CFuint> > dofsToSend(nbRanks);
+    for (CFuint i = 0; i < ownerIDs.size(); i += 2) {
+      const CFuint recvRank = ownerIDs[i+1];
+      toRecv[recvRank].push_back(ownerIDs[i]);
+      dofsToSend[recvRank].push_back(global2dof.find(ownerIDs[i]));
+    }
+    
+    for (CFuint r = 0; r < nbRanks; ++r) {
+      if (dofsToSend[r].size() > 0) {
+	plan.sendRanks.push_back(r);
+	plan.sendDofs.insert(plan.sendDofs.end(), dofsToSend[r].begin(), dofsToSend[r].end());
+	plan.sendPtr.push_back(plan.sendDofs.size());
+      }
+    }
+  }
+  
+  vector<CFuint> recvIDs;
+  vector<int> recvCounts;
+  exchangeIDs(group.comm, toRecv, recvIDs, recvCounts);
+  
+  // 4) each receiving rank lists the dofs to receive from each owner
+  plan.recvRanks.clear();
+  plan.recvPtr.assign(1, 0);
+  plan.recvDofs.clear();
+  
+  if (recvIDs.size() > 0) {
+    CFMap<CFuint, CFuint> global2dof(globalIDs.size());
+    for (CFuint i = 0; i < globalIDs.size(); ++i) {
+      global2dof.insert(globalIDs[i], dofIDs[i]);
+    }
+    global2dof.sortKeys();
+    
+    for (CFuint r = 0, i = 0; r < nbRanks; ++r) {
+      if (recvCounts[r] > 0) {
+	plan.recvRanks.push_back(r);
+	for (int c = 0; c < recvCounts[r]; ++c, ++i) {
+	  plan.recvDofs.push_back(global2dof.find(recvIDs[i]));
+	}
+	plan.recvPtr.push_back(plan.recvDofs.size());
+      }
+    }
+  }
+  
+  CFLog(VERBOSE, "StdConcurrentDataTransfer::buildTransferPlan() => sending " 
+	<< plan.sendDofs.size() << " dofs to " << plan.sendRanks.size() << " ranks, receiving " 
+	<< plan.recvDofs.size() << " dofs from " << plan.recvRanks.size() << " ranks\n");
+  CFLog(VERBOSE, "StdConcurrentDataTransfer::buildTransferPlan() => end\n");
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+      
+void StdConcurrentDataTransfer::exchangeIDs(MPI_Comm comm, 
+					    const vector<vector<CFuint> >& sendLists,
+					    vector<CFuint>& recvList,
+					    vector<int>& recvCounts)
+{
+  const CFuint nbRanks = sendLists.size();
+  vector<int> sendCounts(nbRanks, 0);
+  vector<int> sendDispls(nbRanks, 0);
+  vector<int> recvDispls(nbRanks, 0);
+  recvCounts.assign(nbRanks, 0);
+  
+  for (CFuint r = 0; r < nbRanks; ++r) {
+    sendCounts[r] = sendLists[r].size();
+  }
+  
+  MPIError::getInstance().check
+    ("MPI_Alltoall", "StdConcurrentDataTransfer::exchangeIDs()", 
+     MPI_Alltoall(&sendCounts[0], 1, MPIStructDef::getMPIType(&sendCounts[0]), 
+		  &recvCounts[0], 1, MPIStructDef::getMPIType(&recvCounts[0]), comm));
+  
+  for (CFuint r = 1; r < nbRanks; ++r) {
+    sendDispls[r] = sendDispls[r-1] + sendCounts[r-1];
+    recvDispls[r] = recvDispls[r-1] + recvCounts[r-1];
+  }
+  
+  vector<CFuint> sendList;
+  sendList.reserve(sendDispls[nbRanks-1] + sendCounts[nbRanks-1]);
+  for (CFuint r = 0; r < nbRanks; ++r) {
+    sendList.insert(sendList.end(), sendLists[r].begin(), sendLists[r].end());
+  }
+  recvList.resize(recvDispls[nbRanks-1] + recvCounts[nbRanks-1]);
+  
+  // dummy entries avoid to pass the address of empty vectors 
+  CFuint dummy = 0;
+  CFuint* sendPtr = (sendList.size() > 0) ? &sendList[0] : &dummy;
+  CFuint* recvPtr = (recvList.size() > 0) ? &recvList[0] : &dummy;
+  MPIError::getInstance().check
+    ("MPI_Alltoallv", "StdConcurrentDataTransfer::exchangeIDs()", 
+     MPI_Alltoallv(sendPtr, &sendCounts[0], &sendDispls[0], MPIStructDef::getMPIType(sendPtr),
+		   recvPtr, &recvCounts[0], &recvDispls[0], MPIStructDef::getMPIType(recvPtr), comm));
+}
+      
 //////////////////////////////////////////////////////////////////////////////
 
 int StdConcurrentDataTransfer::getRootProcess(const std::string& nsp, 
@@ -77,6 +77,51 @@ protected: // functions
   /// @param idx           index of the data transfer
   virtual void scatterData(const CFuint idx);
   
+  /// redistribute data from all processes in namespace nspSend directly to all 
+  /// processes in namespace nspRecv, with point-to-point communication 
+  /// following a plan which is rebuilt only if the partitioning changes
+  /// @param idx           index of the data transfer
+  virtual void redistributeData(const CFuint idx);
+  
+  /// build the plan for redistributing data, using a distributed directory 
+  /// of global IDs (each ID is handled by the rank ID%nbRanks in the group)
+  /// @param idx           index of the data transfer
+  /// @param globalIDs     global IDs of the local dofs involved in the transfer
+  /// @param dofIDs        positions of the local dofs involved in the transfer
+  void buildTransferPlan(const CFuint idx, 
+			 const std::vector<CFuint>& globalIDs,
+			 const std::vector<CFuint>& dofIDs);
+  
+  /// compute a hash of the dofs involved in the transfer, which depends on 
+  /// the order of the dofs, to detect when the plan has to be rebuilt
+  /// @param globalIDs     global IDs of the local dofs involved in the transfer
+  /// @param dofIDs        positions of the local dofs involved in the transfer
+  static unsigned long long computeDofsHash(const std::vector<CFuint>& globalIDs,
+					    const std::vector<CFuint>& dofIDs);
+  
+  /// exchange lists of IDs between all ranks of a group
+  /// @param comm          communicator of the group
+  /// @param sendLists     lists of IDs to send to each rank
+  /// @param recvList      IDs received from all ranks, in rank order
+  /// @param recvCounts    number of IDs received from each rank
+  void exchangeIDs(MPI_Comm comm, 
+		   const std::vector<std::vector<CFuint> >& sendLists,
+		   std::vector<CFuint>& recvList,
+		   std::vector<int>& recvCounts);
+  
+  /// fill the global IDs and positions of the local dofs involved in the transfer
+  /// @param dtt           data to transfer
+  /// @param ds            pointer to DataStorage
+  /// @param onlyUpdatable tells to consider only parallel updatable dofs
+  /// @param globalIDs     global IDs of the dofs
+  /// @param dofIDs        positions of the dofs
+  template <typename T>
+  void fillTransferDofs(Common::SafePtr<DataToTrasfer> dtt,
+			Common::SafePtr<Framework::DataStorage> ds,
+			const bool onlyUpdatable,
+			std::vector<CFuint>& globalIDs,
+			std::vector<CFuint>& dofIDs);
+  
   /// fill a mapping between global and local IDs
   /// @param ds            pointer to DataStorage
   /// @param socketName    name of the socket
@@ -145,6 +190,9 @@ protected: // data
   /// vector transformer from send (source) to recv (target) variables
   std::vector<Common::SelfRegistPtr<Framework::VarSetTransformer> > _sendToRecvVecTrans;
     
+  /// plans for redistributing data between the send and recv ranks
+  std::vector<TransferPlan> _plans;
+  
   /// vector storing flags to identify ranks involved in the data transfer
   std::vector<std::vector<int> > _isTransferRank;
   
@@ -164,6 +212,9 @@ protected: // data
   /// variables transformers from send to recv variables
   std::vector<std::string> _sendToRecvVecTransStr;
   
+  /// flag telling to redistribute data with a plan of point-to-point communication
+  bool _useTransferPlan;
+  
 }; // class StdConcurrentDataTransfer
       
 //////////////////////////////////////////////////////////////////////////////
@@ -17,7 +17,9 @@ namespace COOLFluiD {
 
 FEM_VolumeIntegrator::FEM_VolumeIntegrator() :
   VolumeIntegrator(),
-  _lastPrecomputedCellID(0)
+  _lastPrecomputedCellID(0),
+  _cacheCellGeometry(false),
+  _cellGeoCache()
 {
 }
 
@@ -43,18 +45,25 @@ void FEM_VolumeIntegrator::precomputeCellData(Framework::GeometricEntity* geo)
   std::vector<Node*>& nodes   = *geo->getNodes();
   std::vector<State*>& states = *geo->getStates();
 
-  _intgGeo->computeCoordinatesAtQuadraturePoints(nodes, _coord);
-  const std::vector<RealVector>& mapCoord = _intgSol->getQuadraturePointsCoordinates();
+  _intgSol->computeSolutionAtQuadraturePoints(states, _solValues);
 
-  _intgGeo->computeJacobianAtQuadraturePoints(nodes, mapCoord, _jacob);
+  const std::valarray<CFreal>& coeff  = _intgSol->getCoeff();
+  const CFuint cellID = geo->getID();
 
-  _intgSol->computeSolutionAtQuadraturePoints(states, _solValues);
+  if (!_cacheCellGeometry || !restoreCellGeometry(cellID, coeff.size())) {
+    _intgGeo->computeCoordinatesAtQuadraturePoints(nodes, _coord);
+    const std::vector<RealVector>& mapCoord = _intgSol->getQuadraturePointsCoordinates();
 
-  _intgSol->computeGradSolutionShapeFAtQuadraturePoints(_jacob,mapCoord,_gradValues);
+    _intgGeo->computeJacobianAtQuadraturePoints(nodes, mapCoord, _jacob);
 
-  _intgGeo->computeJacobianDetAtQuadraturePoints(nodes, _detJacobian);
+    _intgSol->computeGradSolutionShapeFAtQuadraturePoints(_jacob,mapCoord,_gradValues);
 
-  const std::valarray<CFreal>& coeff  = _intgSol->getCoeff();
+    _intgGeo->computeJacobianDetAtQuadraturePoints(nodes, _detJacobian);
+
+    if (_cacheCellGeometry) {
+      storeCellGeometry(cellID, coeff.size());
+    }
+  }
 
   cf_assert(_solValues.size() >= coeff.size());
   cf_assert(_gradValues.size() >= coeff.size());
@@ -69,6 +78,59 @@ void FEM_VolumeIntegrator::precomputeCellData(Framework::GeometricEntity* geo)
 
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+void FEM_VolumeIntegrator::storeCellGeometry(CFuint cellID, CFuint nbQPoints)
+{
+  if (cellID >= _cellGeoCache.size()) {
+    _cellGeoCache.resize(cellID + 1);
+  }
+
+  std::vector<CFreal>& cache = _cellGeoCache[cellID];
+  cache.clear();
+  for (CFuint ip = 0; ip < nbQPoints; ++ip) {
+    const Node& coord = *_coord[ip];
+    for (CFuint i = 0; i < coord.size(); ++i) {
+      cache.push_back(coord[i]);
+    }
+
+    const RealMatrix& grad = _gradValues[ip];
+    for (CFuint i = 0; i < grad.size(); ++i) {
+      cache.push_back(grad[i]);
+    }
+
+    cache.push_back(_detJacobian[ip]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool FEM_VolumeIntegrator::restoreCellGeometry(CFuint cellID, CFuint nbQPoints)
+{
+  if (cellID >= _cellGeoCache.size() || _cellGeoCache[cellID].empty()) {
+    return false;
+  }
+
+  const std::vector<CFreal>& cache = _cellGeoCache[cellID];
+  CFuint idx = 0;
+  for (CFuint ip = 0; ip < nbQPoints; ++ip) {
+    Node& coord = *_coord[ip];
+    for (CFuint i = 0; i < coord.size(); ++i) {
+      coord[i] = cache[idx++];
+    }
+
+    RealMatrix& grad = _gradValues[ip];
+    for (CFuint i = 0; i < grad.size(); ++i) {
+      grad[i] = cache[idx++];
+    }
+
+    _detJacobian[ip] = cache[idx++];
+  }
+  cf_assert(idx == cache.size());
+
+  return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
     } // namespace FiniteElement
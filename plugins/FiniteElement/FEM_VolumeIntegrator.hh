@@ -48,6 +48,16 @@ public:
    */
   void precomputeCellData(Framework::GeometricEntity* geo);
 
+  /**
+   * Keep the coordinates, the gradients of the shape functions and the
+   * jacobian determinants at the quadrature points of each cell after
+   * their first computation. Only valid if the mesh does not move.
+   */
+  void setCacheCellGeometry(bool cacheCellGeometry)
+  {
+    _cacheCellGeometry = cacheCellGeometry;
+  }
+
   /**
    * Compute a volume integration for on a GeometricEntity
    * where the functor is a FEMEntity and filling the LocalElementData.
@@ -84,10 +94,28 @@ private:
    */
   FEM_VolumeIntegrator& operator= (const FEM_VolumeIntegrator&);
 
+  /**
+   * Store the geometric data at the quadrature points of the given cell
+   */
+  void storeCellGeometry(CFuint cellID, CFuint nbQPoints);
+
+  /**
+   * Restore the geometric data at the quadrature points of the given cell
+   * @return false if the cell has not been cached yet
+   */
+  bool restoreCellGeometry(CFuint cellID, CFuint nbQPoints);
+
 private: //data
 
   CFuint _lastPrecomputedCellID;
 
+  /// flag telling if the geometric data of the cells are cached
+  bool _cacheCellGeometry;
+
+  /// cached coordinates, shape function gradients and jacobian
+  /// determinants at the quadrature points, for each cell
+  std::vector< std::vector<CFreal> > _cellGeoCache;
+
 }; // end class FEM_VolumeIntegrator
 
 //////////////////////////////////////////////////////////////////////////////
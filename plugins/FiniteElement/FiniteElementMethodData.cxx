@@ -44,6 +44,7 @@ void FiniteElementMethodData::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< std::string >("InertiaVar","Inertia variable set.");
    options.addConfigOption< std::string >("ResidualStrategy","Strategy to compute the system residual.");
    options.addConfigOption< std::string >("IntegratorQuadrature","Type of Quadrature to be used in the Integration.");
+   options.addConfigOption< bool >("CacheCellGeometry","Cache the geometric data at the quadrature points of each cell (only for static meshes).");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -86,6 +87,9 @@ FiniteElementMethodData::FiniteElementMethodData(Common::SafePtr<Framework::Meth
 
    _residualStrategyStr = "StdElementComputer";
    setParameter("ResidualStrategy",&_residualStrategyStr);
+
+   _cacheCellGeometry = false;
+   setParameter("CacheCellGeometry",&_cacheCellGeometry);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -304,6 +308,7 @@ void FiniteElementMethodData::configureIntegrator ( Config::ConfigArgs& args )
     CFPolyOrder::Convert::to_enum( _integratorOrderStr );
 
   _femVolumeIntegrator.setIntegrationForAllGeo(quadType,order);
+  _femVolumeIntegrator.setCacheCellGeometry(_cacheCellGeometry);
 
 }
 
@@ -382,6 +382,9 @@ private: // data
   /// string to configure _residualStrategy
   std::string _residualStrategyStr;
 
+  /// flag telling to cache the geometric data of the cells (static meshes)
+  bool _cacheCellGeometry;
+
   /// The FEM volume Integrator
   FEM_VolumeIntegrator _femVolumeIntegrator;
 
@@ -0,0 +1,251 @@
+#include "Common/PE.hh"
+#include "Common/StringOps.hh"
+#include "Framework/BaseTerm.hh"
+#include "Framework/DataProcessing.hh"
+#include "Framework/MeshData.hh"
+#include "Framework/PhysicalModel.hh"
+#include "Framework/MethodCommandProvider.hh"
+#include "Framework/VarSetTransformer.hh"
+#include "FiniteVolume/CellCenterFVM.hh"
+#include "FiniteVolume/FiniteVolume.hh"
+#include "FiniteVolume/BenchmarkKernelsFVMCC.hh"
+#include "UnitTests/Benchmarks/Benchmark.hh"
+
+//////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Benchmarks;
+
+//////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider<BenchmarkKernelsFVMCC, DataProcessingData, FiniteVolumeModule>
+benchmarkKernelsFVMCCProvider("BenchmarkKernelsFVMCC");
+
+//////////////////////////////////////////////////////////////////////
+
+/// Kernels of the current face, shared with the benchmark functions
+struct FaceKernels {
+  SafePtr<FluxSplitter<CellCenterFVMData> > fluxSplitter;
+  SafePtr<ConvectiveVarSet> updateVar;
+  SafePtr<VarSetTransformer> updateToSolution;
+  SafePtr<VarSetTransformer> solutionToLinear;
+  State* state;
+  RealVector flux;
+  RealVector pdata;
+};
+
+static FaceKernels* kernels = CFNULL;
+
+//////////////////////////////////////////////////////////////////////
+
+static void benchFluxSplitter(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    kernels->fluxSplitter->computeFlux(kernels->flux);
+    doNotOptimize(kernels->flux);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static void benchComputePhysicalData(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    kernels->updateVar->computePhysicalData(*kernels->state, kernels->pdata);
+    doNotOptimize(kernels->pdata);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static void benchUpdateToSolution(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    State* result = kernels->updateToSolution->transform(kernels->state);
+    doNotOptimize(*result);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static void benchSolutionToLinear(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    State* result = kernels->solutionToLinear->transform(kernels->state);
+    doNotOptimize(*result);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void BenchmarkKernelsFVMCC::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< vector<string> >
+    ("BenchmarkArgs", "Options of the benchmark runner (e.g. --benchmark_out=<file>).");
+}
+
+//////////////////////////////////////////////////////////////////////
+
+BenchmarkKernelsFVMCC::BenchmarkKernelsFVMCC(const std::string& name) :
+  DataProcessingCom(name),
+  socket_states("states"),
+  socket_gstates("gstates"),
+  socket_nodes("nodes"),
+  socket_normals("normals"),
+  socket_faceAreas("faceAreas"),
+  m_done(false),
+  m_benchmarkArgs()
+{
+  addConfigOptionsTo(this);
+  setParameter("BenchmarkArgs",&m_benchmarkArgs);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+BenchmarkKernelsFVMCC::~BenchmarkKernelsFVMCC()
+{
+}
+
+//////////////////////////////////////////////////////////////////////
+
+std::vector<Common::SafePtr<BaseDataSocketSink> >
+BenchmarkKernelsFVMCC::needsSockets()
+{
+  std::vector<Common::SafePtr<BaseDataSocketSink> > result;
+
+  result.push_back(&socket_states);
+  result.push_back(&socket_gstates);
+  result.push_back(&socket_nodes);
+  result.push_back(&socket_normals);
+  result.push_back(&socket_faceAreas);
+
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void BenchmarkKernelsFVMCC::execute()
+{
+  CFAUTOTRACE;
+
+  if (m_done) return;
+  m_done = true;
+
+  // the timings of one processor are enough for the kernels of a face
+  if (PE::GetPE().GetRank(getMethodData().getNamespace()) != 0) return;
+
+  SafePtr<SpaceMethod> spaceMethod = getMethodData().getCollaborator<SpaceMethod>();
+  SafePtr<CellCenterFVM> fvmcc = spaceMethod.d_castTo<CellCenterFVM>();
+  SafePtr<CellCenterFVMData> data = fvmcc->getData();
+
+  GeometricEntity* face = buildFace(data);
+  if (face == CFNULL) {
+    CFLog(WARN, "BenchmarkKernelsFVMCC: no inner face to run the benchmarks\n");
+    return;
+  }
+
+  runBenchmarks(data);
+
+  data->getFaceCellTrsGeoBuilder()->releaseGE();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+GeometricEntity* BenchmarkKernelsFVMCC::buildFace(SafePtr<CellCenterFVMData> data)
+{
+  SafePtr<TopologicalRegionSet> faces = MeshDataStack::getActive()->getTrs("InnerFaces");
+
+  SafePtr<GeometricEntityPool<FaceCellTrsGeoBuilder> > geoBuilder = data->getFaceCellTrsGeoBuilder();
+  geoBuilder->getGeoBuilder()->setDataSockets(socket_states, socket_gstates, socket_nodes);
+  FaceCellTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+  geoData.faces = faces;
+  geoData.isBFace = false;
+  geoData.allCells = data->getBuildAllCells();
+
+  const CFuint nbFaces = faces->getLocalNbGeoEnts();
+  for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+    geoData.idx = iFace;
+    GeometricEntity* face = geoBuilder->buildGE();
+    if (face->getState(0)->isParUpdatable() && !face->getState(1)->isGhost()) {
+      // unit normal pointing outward the first cell, as in FVMCC_ComputeRHS
+      DataHandle<CFreal> normals = socket_normals.getDataHandle();
+      RealVector& unitNormal = data->getUnitNormal();
+      const CFuint nbDim = unitNormal.size();
+      const CFuint startID = face->getID()*nbDim;
+      const CFreal invArea = 1./socket_faceAreas.getDataHandle()[face->getID()];
+      for (CFuint i = 0; i < nbDim; ++i) {
+	unitNormal[i] = normals[startID + i]*invArea;
+      }
+      data->getCurrentFace() = face;
+      data->setIsPerturb(false);
+
+      // extrapolate the solution with the gradients of the last residual
+      // computation and compute the physical data in the face
+      SafePtr<FVMCC_PolyRec> polyRec = data->getPolyReconstructor();
+      polyRec->extrapolate(face);
+      SafePtr<ConvectiveVarSet> reconstrVar = (data->reconstructSolVars()) ?
+	data->getSolutionVar() : data->getUpdateVar();
+      vector<State*>& states = polyRec->getExtrapolatedValues();
+      vector<RealVector>& pdata = polyRec->getExtrapolatedPhysicaData();
+      reconstrVar->computePhysicalData(*states[0], pdata[0]);
+      reconstrVar->computePhysicalData(*states[1], pdata[1]);
+      return face;
+    }
+    geoBuilder->releaseGE();
+  }
+
+  return CFNULL;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void BenchmarkKernelsFVMCC::runBenchmarks(SafePtr<CellCenterFVMData> data)
+{
+  FaceKernels faceKernels;
+  faceKernels.fluxSplitter = data->getFluxSplitter();
+  faceKernels.updateVar = data->getUpdateVar();
+  faceKernels.updateToSolution = data->getUpdateToSolutionVecTrans();
+  faceKernels.solutionToLinear = data->getSolutionToLinearVecTrans();
+  faceKernels.state = data->getCurrentFace()->getState(0);
+  faceKernels.flux.resize(PhysicalModelStack::getActive()->getNbEq());
+  PhysicalModelStack::getActive()->getImplementor()->getConvectiveTerm()->
+    resizePhysicalData(faceKernels.pdata);
+  kernels = &faceKernels;
+
+  // the runner takes its options from a command line
+  vector<char*> argv(1, const_cast<char*>("BenchmarkKernelsFVMCC"));
+  for (CFuint i = 0; i < m_benchmarkArgs.size(); ++i) {
+    argv.push_back(const_cast<char*>(m_benchmarkArgs[i].c_str()));
+  }
+
+  Runner runner(argv.size(), &argv[0]);
+  runner.addContext("physical_model", PhysicalModelStack::getActive()->getImplementor()->getName());
+  runner.addContext("faces", StringOps::to_str(MeshDataStack::getActive()->getTrs("InnerFaces")->getLocalNbGeoEnts()));
+  runner.add(faceKernels.fluxSplitter->getName() + "::computeFlux", benchFluxSplitter);
+  runner.add("UpdateVar::computePhysicalData", benchComputePhysicalData);
+  runner.add("UpdateToSolution::transform", benchUpdateToSolution);
+  runner.add("SolutionToLinear::transform", benchSolutionToLinear);
+  runner.run();
+
+  kernels = CFNULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////
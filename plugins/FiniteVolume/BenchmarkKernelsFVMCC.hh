@@ -0,0 +1,109 @@
+#ifndef COOLFluiD_Numerics_FiniteVolume_BenchmarkKernelsFVMCC_hh
+#define COOLFluiD_Numerics_FiniteVolume_BenchmarkKernelsFVMCC_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Framework/DataProcessingData.hh"
+#include "Framework/DataSocketSink.hh"
+#include "Framework/GeometricEntity.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+      class CellCenterFVMData;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class times the kernels used by CellCenterFVM on each face: the
+ * configured flux splitter, ConvectiveVarSet::computePhysicalData and the
+ * variable transformers. The kernels are run on one inner face of the
+ * current solution, set up as in FVMCC_ComputeRHS, and the timings are
+ * reported by the micro-benchmark runner in the JSON format of Google
+ * Benchmark. The benchmarks are run the first time this command is executed.
+ */
+class BenchmarkKernelsFVMCC : public Framework::DataProcessingCom {
+public:
+
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the Option's
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+
+  /**
+   * Constructor
+   */
+  BenchmarkKernelsFVMCC(const std::string& name);
+
+  /**
+   * Default destructor
+   */
+  ~BenchmarkKernelsFVMCC();
+
+  /**
+   * Execute on a set of dofs
+   */
+  void execute();
+
+  /**
+   * Returns the DataSocket's that this command needs as sinks
+   * @return a vector of SafePtr with the DataSockets
+   */
+  virtual std::vector<Common::SafePtr<Framework::BaseDataSocketSink> > needsSockets();
+
+private: // functions
+
+  /**
+   * Build the first inner face with an updatable state and prepare the
+   * method data as FVMCC_ComputeRHS does before computing its flux
+   * @return the face or CFNULL if this processor has no such face
+   */
+  Framework::GeometricEntity* buildFace(Common::SafePtr<CellCenterFVMData> data);
+
+  /**
+   * Run the benchmarks on the current face
+   */
+  void runBenchmarks(Common::SafePtr<CellCenterFVMData> data);
+
+private: //data
+
+  /// storage of states
+  Framework::DataSocketSink < Framework::State* , Framework::GLOBAL > socket_states;
+
+  /// storage of ghost states
+  Framework::DataSocketSink<Framework::State*> socket_gstates;
+
+  /// storage of nodes
+  Framework::DataSocketSink < Framework::Node* , Framework::GLOBAL > socket_nodes;
+
+  /// storage of normals
+  Framework::DataSocketSink<CFreal> socket_normals;
+
+  /// storage of face areas
+  Framework::DataSocketSink<CFreal> socket_faceAreas;
+
+  /// flag telling if the benchmarks have been run
+  bool m_done;
+
+  /// options passed to the benchmark runner (e.g. --benchmark_out=<file>)
+  std::vector<std::string> m_benchmarkArgs;
+
+}; // end of class BenchmarkKernelsFVMCC
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FiniteVolume_BenchmarkKernelsFVMCC_hh
@@ -4,6 +4,10 @@
 #include "FiniteVolume/FiniteVolume.hh"
 #include "FiniteVolume/DerivativeComputer.hh"
 #include "FiniteVolume/ComputeDiffusiveFlux.hh"
+#include "FiniteVolume/FVMCC_ComputeRHS.hh"
+#include "FiniteVolume/FVMCC_FluxSplitter.hh"
+#include "Framework/PhysicalPropertyLibrary.hh"
+#include "Framework/Profiler.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -49,6 +53,7 @@ void CellCenterFVM::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< bool >("OnlyInitComs","Use only init commands to initialize.");
    options.addConfigOption< std::string >("SpaceRHSForGivenCell","Command for the computation of the space discretization contibution to RHS for one cell.");
    options.addConfigOption< std::string >("TimeRHSForGivenCell" ,"Command for the computation of the space discretization contibution to RHS for one cell.");
+   options.addConfigOption< CFuint >("NbThreads","Number of threads processing the face loop of the RHS computation (needs CF_ENABLE_OMP).");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -68,6 +73,8 @@ CellCenterFVM::CellCenterFVM(const std::string& name)
     _afterMeshUpdate(),
     _spaceRHSForGivenCell(),
     _timeRHSForGivenCell(),
+    _threadData(),
+    _threadComputeSpaceRHS(),
     _isBcApplied(false)
 {
   addConfigOptionsTo(this);
@@ -141,6 +148,9 @@ CellCenterFVM::CellCenterFVM(const std::string& name)
 
   setParameter( "TimeRHSForGivenCell", &_timeRHSForGivenCellStr);
   _timeRHSForGivenCellStr = "Null";
+  
+  _nbThreads = 1;
+  setParameter("NbThreads",&_nbThreads);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -328,6 +338,8 @@ void CellCenterFVM::configure ( Config::ConfigArgs& args )
   configureCommand<CellCenterFVMData,CellCenterFVMComProvider>(args, _computeSpaceRHS,
 							       _computeSpaceRHSStr,
 							       _data);
+  
+  configureThreads(args);
 
   configureCommand<CellCenterFVMData,CellCenterFVMComProvider>(args, _computeTimeRHS,
 							       _computeTimeRHSStr,
@@ -465,6 +477,7 @@ void CellCenterFVM::computeSpaceResidualImpl(CFreal factor)
   
   // BC should actually be applied after the computeResidual
   // and after the update of the states !!!
+  CFPROFILE(_computeSpaceRHS->getName());
   _computeSpaceRHS->execute();
 }
 
@@ -479,6 +492,7 @@ void CellCenterFVM::computeTimeResidualImpl(CFreal factor)
   _data->setResFactor(factor);
 
   if (!_computeTimeRHS->isNull()) {
+    CFPROFILE(_computeTimeRHS->getName());
     _computeTimeRHS->execute();
   }
   checkMatrixFrozen();
@@ -496,6 +510,7 @@ void CellCenterFVM::applyBCImpl()
   for(CFuint i = 0; i < _bcs.size(); ++i) {
     cf_assert(_bcs[i].isNotNull());
     CFLog(VERBOSE, "Applying BC " << _bcs[i]->getName() << " => START\n");
+    CFPROFILE(_bcs[i]->getName());
     _bcs[i]->execute();
     CFLog(VERBOSE, "Applying BC " << _bcs[i]->getName() << " => END\n");
   }
@@ -565,6 +580,14 @@ void CellCenterFVM::setMethodImpl()
   // store the mapping index TRS -> bc commands into the data
   _data->setBCList(_bcs);
   
+  // the per-thread data share collaborators and BCs with the main one
+  for (CFuint i = 0; i < _threadData.size(); ++i) {
+    _threadData[i]->setLinearSystemSolver(_data->getLinearSystemSolver());
+    _threadData[i]->setConvergenceMethod(_data->getConvergenceMethod());
+    _threadData[i]->setup();
+    _threadData[i]->setBCList(_bcs);
+  }
+  
   for(CFuint i=0; i < _setups.size();i++){
     cf_assert(_setups[i].isNotNull());
     CFLog(VERBOSE, "CellCenterFVM::setMethodImpl() => start setting up " << _setups[i]->getName() << " \n");
@@ -584,7 +607,11 @@ void CellCenterFVM::unsetMethodImpl()
   CFAUTOTRACE;
 
   unsetupCommandsAndStrategies();
-
+  
+  for (CFuint i = 0; i < _threadData.size(); ++i) {
+    _threadData[i]->unsetup();
+  }
+  
   for(CFuint i=0; i < _unSetups.size();++i){
     cf_assert(_unSetups[i].isNotNull());
     _unSetups[i]->execute();
@@ -632,18 +659,33 @@ void CellCenterFVM::extrapolateStatesToNodesImpl()
 std::vector<Common::SafePtr<NumericalStrategy> > CellCenterFVM::getStrategyList() const
 {
   vector<Common::SafePtr<NumericalStrategy> > result;
-
+  
   // add strategies here
-  result.push_back(_data->getPolyReconstructor().d_castTo<NumericalStrategy>());
-  result.push_back(_data->getLimiter().d_castTo<NumericalStrategy>());
-  result.push_back(_data->getNodalStatesExtrapolator().d_castTo<NumericalStrategy>());
-  result.push_back(_data->getFluxSplitter().d_castTo<NumericalStrategy>());
-  result.push_back(_data->getGeoDataComputer().d_castTo<NumericalStrategy>());
-  result.push_back(_data->getDerivativeComputer().d_castTo<NumericalStrategy>());
-  result.push_back(_data->getDiffusiveFluxComputer().d_castTo<NumericalStrategy>());
+  addStrategies(*_data, result);
+  
+  // the per-thread copies of the strategies need sockets and setup as well
+  for (CFuint i = 0; i < _threadData.size(); ++i) {
+    addStrategies(*_threadData[i], result);
+  }
+  
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CellCenterFVM::addStrategies(CellCenterFVMData& data,
+				  vector<Common::SafePtr<NumericalStrategy> >& result)
+{
+  result.push_back(data.getPolyReconstructor().d_castTo<NumericalStrategy>());
+  result.push_back(data.getLimiter().d_castTo<NumericalStrategy>());
+  result.push_back(data.getNodalStatesExtrapolator().d_castTo<NumericalStrategy>());
+  result.push_back(data.getFluxSplitter().d_castTo<NumericalStrategy>());
+  result.push_back(data.getGeoDataComputer().d_castTo<NumericalStrategy>());
+  result.push_back(data.getDerivativeComputer().d_castTo<NumericalStrategy>());
+  result.push_back(data.getDiffusiveFluxComputer().d_castTo<NumericalStrategy>());
   
   SafePtr<vector<SelfRegistPtr<ComputeSourceTerm<CellCenterFVMData> > > > sourceTerms =
-    _data->getSourceTermComputer();
+    data.getSourceTermComputer();
   
   for(CFuint i=0; i<sourceTerms->size();++i){
     SafePtr<ComputeSourceTerm<CellCenterFVMData> > sourceTerm = ((*sourceTerms)[i]).getPtr();
@@ -651,14 +693,99 @@ std::vector<Common::SafePtr<NumericalStrategy> > CellCenterFVM::getStrategyList(
   }
   
   SafePtr<vector<SelfRegistPtr<EquationFilter<CellCenterFVMData> > > > equationFilters =
-    _data->getEquationFilters();
+    data.getEquationFilters();
   
   for(CFuint i=0; i<equationFilters->size();++i){
     SafePtr<EquationFilter<CellCenterFVMData> > eqFilter = ((*equationFilters)[i]).getPtr();
     result.push_back(eqFilter.d_castTo<NumericalStrategy>());
   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CellCenterFVM::configureThreads ( Config::ConfigArgs& args )
+{
+  CFAUTOTRACE;
   
-  return result;
+  if (_nbThreads < 2) return;
+  
+#ifndef CF_HAVE_OMP
+  CFLog(WARN, "CellCenterFVM::configureThreads() => NbThreads = " << _nbThreads
+	<< " is ignored: OpenMP support is not enabled (CF_ENABLE_OMP)\n");
+#else
+  SafePtr<FVMCC_ComputeRHS> rhsCom = dynamic_cast<FVMCC_ComputeRHS*>(_computeSpaceRHS.getPtr());
+  if (rhsCom.isNull() || !rhsCom->isThreadSafe()) {
+    CFLog(WARN, "CellCenterFVM::configureThreads() => ComputeRHS [" << _computeSpaceRHSStr
+	  << "] cannot run on multiple threads: NbThreads is ignored\n");
+    return;
+  }
+  
+  // source terms are evaluated once per cell using shared cell flags and
+  // some of them provide their own sockets: keep them on the serial path
+  if (_data->hasSourceTerm()) {
+    CFLog(WARN, "CellCenterFVM::configureThreads() => source terms are not supported "
+	  << "by the threaded face loop: NbThreads is ignored\n");
+    return;
+  }
+  
+  // the physical model (and its physical data, used by linearizers and
+  // diffusive var sets) and the physical property library are shared
+  // by all threads: only splitters which don't touch them can be threaded
+  SafePtr<FVMCC_FluxSplitter> fluxSplitter = _data->getFluxSplitter().d_castTo<FVMCC_FluxSplitter>();
+  if (!fluxSplitter->isThreadSafe()) {
+    CFLog(WARN, "CellCenterFVM::configureThreads() => flux splitter ["
+	  << fluxSplitter->getName()
+	  << "] is not thread safe: NbThreads is ignored\n");
+    return;
+  }
+
+  if (!_data->getDiffusiveFluxComputer()->isNull()) {
+    CFLog(WARN, "CellCenterFVM::configureThreads() => diffusive fluxes are not supported "
+	  << "by the threaded face loop: NbThreads is ignored\n");
+    return;
+  }
+
+  if (PhysicalModelStack::getActive()->getImplementor()->
+      getPhysicalPropertyLibrary<PhysicalPropertyLibrary>()->isNotNull()) {
+    CFLog(WARN, "CellCenterFVM::configureThreads() => physical property libraries are not "
+	  << "thread safe: NbThreads is ignored\n");
+    return;
+  }
+
+  // each thread gets its own data and therefore its own strategies
+  // (flux splitter, polynomial reconstructor, geometric entity builders, ...)
+  for (CFuint i = 1; i < _nbThreads; ++i) {
+    SharedPtr<CellCenterFVMData> threadData(new CellCenterFVMData(this));
+    threadData->setFactoryRegistry(getFactoryRegistry());
+    configureNested ( threadData.getPtr(), args );
+    _threadData.push_back(threadData);
+  }
+  
+  // strategies providing sockets cannot be duplicated
+  vector<Common::SafePtr<NumericalStrategy> > threadStrategies;
+  addStrategies(*_threadData[0], threadStrategies);
+  for (CFuint i = 0; i < threadStrategies.size(); ++i) {
+    if (threadStrategies[i]->providesSockets().size() > 0) {
+      CFLog(WARN, "CellCenterFVM::configureThreads() => strategy [" << threadStrategies[i]->getName()
+	    << "] provides sockets and cannot be duplicated: NbThreads is ignored\n");
+      _threadData.clear();
+      return;
+    }
+  }
+  
+  vector<SafePtr<FVMCC_ComputeRHS> > threadComs(_threadData.size());
+  _threadComputeSpaceRHS.resize(_threadData.size());
+  for (CFuint i = 0; i < _threadData.size(); ++i) {
+    configureCommand<CellCenterFVMData,CellCenterFVMComProvider>(args, _threadComputeSpaceRHS[i],
+								 _computeSpaceRHSStr,
+								 _threadData[i]);
+    threadComs[i] = dynamic_cast<FVMCC_ComputeRHS*>(_threadComputeSpaceRHS[i].getPtr());
+    cf_assert(threadComs[i].isNotNull());
+  }
+  rhsCom->setThreadCommands(threadComs);
+  
+  CFLog(INFO, "CellCenterFVM: face loop of " << _computeSpaceRHSStr << " on " << _nbThreads << " threads\n");
+#endif
 }
 
 //////////////////////////////////////////////////////////////////////////////
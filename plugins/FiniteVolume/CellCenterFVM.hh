@@ -152,6 +152,17 @@ protected: //  helper functions
   
   /// Checks if the system matrix shouldbe frozen
   void checkMatrixFrozen() const;
+  
+  /// Creates the per-thread copies of the data and of the ComputeRHS command
+  /// needed to run the face loop on more than one thread
+  /// @param args configuration arguments
+  void configureThreads ( Config::ConfigArgs& args );
+  
+  /// Adds the strategies of the given data to the list
+  /// @param data the method data holding the strategies
+  /// @param result list to fill in
+  static void addStrategies(CellCenterFVMData& data,
+			    std::vector<Common::SafePtr<Framework::NumericalStrategy> >& result);
 
 private: // member data
 
@@ -196,6 +207,12 @@ private: // member data
   /// The data to share between CellCenterFVMCom commands
   Common::SharedPtr<CellCenterFVMData> _data;
   
+  /// The per-thread copies of the data, each one holding its own strategies
+  std::vector<Common::SharedPtr<CellCenterFVMData> > _threadData;
+  
+  /// The per-thread copies of the command computing the space rhs
+  std::vector<Common::SelfRegistPtr<CellCenterFVMCom> > _threadComputeSpaceRHS;
+  
   /// Flag telling if BC's have been applied already
   bool _isBcApplied;
   
@@ -252,7 +269,10 @@ private: // member data
 
   /// The string for configuration of the m_timeRHSForGivenCell command
   std::string _timeRHSForGivenCellStr;
-
+  
+  /// Number of threads processing the face loop of the space rhs
+  CFuint _nbThreads;
+  
 }; // class CellCenterFVM
 
 //////////////////////////////////////////////////////////////////////////////
@@ -6,6 +6,10 @@
 #include "FiniteVolume/FVMCC_BC.hh"
 #include "FiniteVolume/DerivativeComputer.hh"
 
+#ifdef CF_HAVE_OMP
+#include <omp.h>
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 
 using namespace std;
@@ -74,7 +78,11 @@ FVMCC_ComputeRHS::FVMCC_ComputeRHS(const std::string& name) :
   _fluxData(CFNULL),
   _tempUnitNormal(),
   _rExtraVars(),
-  _inverter(CFNULL)  
+  _inverter(CFNULL),
+  _threadComs(),
+  _colorFaces(),
+  _colorStart(),
+  _zeroGrad()
 {
   addConfigOptionsTo(this);
 
@@ -107,6 +115,9 @@ void FVMCC_ComputeRHS::unsetup()
     deletePtr(_rExtraVars[i]);
   }
   
+  _colorFaces.clear();
+  _colorStart.clear();
+  
   CellCenterFVMCom::unsetup();
 }
 
@@ -144,6 +155,14 @@ void FVMCC_ComputeRHS::execute()
   
   initializeComputationRHS();
   
+  // the source terms can evaluate their unperturbed values on all the cells
+  // at once, before being called cell by cell from the face loop
+  if (getMethodData().hasSourceTerm()) {
+    for (CFuint i = 0; i < _stComputers->size(); ++i) {
+      (*_stComputers)[i]->prepareComputeSource();
+    }
+  }
+  
   // set the list of faces
   vector<SafePtr<TopologicalRegionSet> > trs = MeshDataStack::getActive()->getTrsList();
   const CFuint nbTRSs = trs.size();
@@ -199,107 +218,19 @@ void FVMCC_ComputeRHS::execute()
       geoData.faces = currTrs;
       
       const CFuint nbTrsFaces = currTrs->getLocalNbGeoEnts();
+      if (_threadComs.size() > 0 && !geoData.isBFace) {
+	computeFaceRHSThreaded(currTrs, iTRS);
+	_faceIdx += nbTrsFaces;
+	continue;
+      }
+      
       for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace, ++_faceIdx) {
         CFLogDebugMed( "iFace = " << iFace << "\n");
 	
     	// reset the equation subsystem descriptor
 	PhysicalModelStack::getActive()->resetEquationSubSysDescriptor();
 	
-	// build the GeometricEntity
-        geoData.idx = iFace;
-        _currFace = geoBuilder->buildGE();
-	
-	if (_currFace->getState(0)->isParUpdatable() || 
-	    (!_currFace->getState(1)->isGhost() && _currFace->getState(1)->isParUpdatable())) {
-	  
-	  // set the data for the FaceIntegrator
-	  setFaceIntegratorData();
-	  
-	  // cout << "states = " << _currFace->getState(0)->getLocalID()  << ", " <<  _currFace->getState(1)->getLocalID() << endl;
-	  
-	  // extrapolate (and LIMIT, if the reconstruction is linear or more)
-	  // the solution in the quadrature points
-	  _polyRec->extrapolate(_currFace);
-	
-	  // compute the physical data for each left and right reconstructed
-	  // state and in the left and right cell centers
-	  CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => before computePhysicalData()\n");
-	  computePhysicalData();
-	  CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => after computePhysicalData()\n");
-	  
-	  // a jacobian free method requires to re-compute the update coefficient every time the 
-	  // residual is calculated to get F*v from the finite difference formula
-	  // in particular the time dependent part of the residual depend on a updateCoeff
-	  // that has to be up-to-date
-	  getMethodData().setIsPerturb(false);
-	  
-	  // cout << "L = " << *_currFace->getState(0) << endl;
-	  // cout << "R = " << *_currFace->getState(1) << endl;
-	  
-	  const bool isBFace = _currFace->getState(1)->isGhost();
-	  
-	  // this initialization is fundamental, especially for cases with coupling
-	  // where some equation subsystems don't have convective terms
-	  _flux = 0.; 
-	  CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => before conv computeFlux()\n");
-	  if (!isBFace) {
-	    _fluxSplitter->computeFlux(_flux);
-
-
-	  }
-	  else {
-	    _currBC->computeFlux(_flux);
-	  }
-	  CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => after conv computeFlux()\n");
-	  // cout.precision(12);cout << currTrs->getName() << " C flux = " << _flux << endl;
-	  
-	  computeInterConvDiff();
-	  
-	  _isDiffusionActive = (*_eqFilters)[0]->filterOnGeo(_currFace);
-	  
-	  if (_hasDiffusiveTerm && _isDiffusionActive) {
-	    // reset to false the flag telling to freeze the diffusive coefficients
-	    _diffVar->setFreezeCoeff(false);
-	    
-	    // put virtual function here or parameter
-	    if (_extrapolateInNodes) {
-	      _nodalExtrapolator->extrapolateInNodes(*_currFace->getNodes());
-	    }
-	    
-	    // this initialization is fundamental, especially for cases with coupling
-	    // where some equation subsystems don't have diffusive terms
-	    _dFlux = 0.;
-	    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => before diff computeFlux()\n");
-	    _diffusiveFlux->computeFlux(_dFlux);
-	    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => after diff computeFlux()\n");
-	    _flux -= _dFlux;
-	  }
-
-	  /*if (_flux.size() == 9 && currTrs->getName() == "InnerFaces") {
-	    cout.precision(12);cout << "SL[" << _currFace->getState(0)->getLocalID() << "] = [" << *_currFace->getState(0) << "]\n";
-	    cout.precision(12);cout << "SR[" << _currFace->getState(1)->getLocalID() << "] = [" << *_currFace->getState(1) << "]\n";
-	    cout.precision(12);cout << "["<< iFace << "] in " << currTrs->getName() << " C+D flux = " << _flux << endl; 
-	    EXIT_AT(100);
-	    }*/
-	  
-	  CFLogDebugMed("flux = " <<  _flux  << "\n");
-	  
-	  // compute the source term
-	  if (hasSourceTerm) {
-	    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => before computeSourceTerm()\n");
-	    computeSourceTerm();
-	    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => after computeSourceTerm()\n");
-	  }
-	  
-	  // compute the contribution to the RHS
-	  updateRHS();
-	  // source term jacobians are only computed while processing internal faces 
-	  CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => before computeRHSJacobian()\n");
-	  computeRHSJacobian();
-	  CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::execute() => after computeRHSJacobian()\n");
-	}
-	
-	geoBuilder->releaseGE(); 
+	computeFaceRHS(iFace, hasSourceTerm);
       }
     }
   }
@@ -326,6 +257,226 @@ void FVMCC_ComputeRHS::execute()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void FVMCC_ComputeRHS::computeFaceRHS(CFuint iFace, bool hasSourceTerm)
+{
+  Common::SafePtr<GeometricEntityPool<FaceCellTrsGeoBuilder> > geoBuilder = getMethodData().getFaceCellTrsGeoBuilder();
+  FaceCellTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+  
+  // build the GeometricEntity
+  geoData.idx = iFace;
+  _currFace = geoBuilder->buildGE();
+  
+  if (_currFace->getState(0)->isParUpdatable() || 
+      (!_currFace->getState(1)->isGhost() && _currFace->getState(1)->isParUpdatable())) {
+    
+    // set the data for the FaceIntegrator
+    setFaceIntegratorData();
+    
+    // extrapolate (and LIMIT, if the reconstruction is linear or more)
+    // the solution in the quadrature points
+    _polyRec->extrapolate(_currFace);
+    
+    // compute the physical data for each left and right reconstructed
+    // state and in the left and right cell centers
+    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => before computePhysicalData()\n");
+    computePhysicalData();
+    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => after computePhysicalData()\n");
+    
+    // a jacobian free method requires to re-compute the update coefficient every time the 
+    // residual is calculated to get F*v from the finite difference formula
+    // in particular the time dependent part of the residual depend on a updateCoeff
+    // that has to be up-to-date
+    getMethodData().setIsPerturb(false);
+    
+    const bool isBFace = _currFace->getState(1)->isGhost();
+    
+    // this initialization is fundamental, especially for cases with coupling
+    // where some equation subsystems don't have convective terms
+    _flux = 0.; 
+    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => before conv computeFlux()\n");
+    if (!isBFace) {
+      _fluxSplitter->computeFlux(_flux);
+    }
+    else {
+      _currBC->computeFlux(_flux);
+    }
+    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => after conv computeFlux()\n");
+    
+    computeInterConvDiff();
+    
+    _isDiffusionActive = (*_eqFilters)[0]->filterOnGeo(_currFace);
+    
+    if (_hasDiffusiveTerm && _isDiffusionActive) {
+      // reset to false the flag telling to freeze the diffusive coefficients
+      _diffVar->setFreezeCoeff(false);
+      
+      // put virtual function here or parameter
+      if (_extrapolateInNodes) {
+	_nodalExtrapolator->extrapolateInNodes(*_currFace->getNodes());
+      }
+      
+      // this initialization is fundamental, especially for cases with coupling
+      // where some equation subsystems don't have diffusive terms
+      _dFlux = 0.;
+      CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => before diff computeFlux()\n");
+      _diffusiveFlux->computeFlux(_dFlux);
+      CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => after diff computeFlux()\n");
+      _flux -= _dFlux;
+    }
+    
+    CFLogDebugMed("flux = " <<  _flux  << "\n");
+    
+    // compute the source term
+    if (hasSourceTerm) {
+      CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => before computeSourceTerm()\n");
+      computeSourceTerm();
+      CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => after computeSourceTerm()\n");
+    }
+    
+    // compute the contribution to the RHS
+    updateRHS();
+    // source term jacobians are only computed while processing internal faces 
+    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => before computeRHSJacobian()\n");
+    computeRHSJacobian();
+    CFLog(DEBUG_MIN, "FVMCC_ComputeRHS::computeFaceRHS() => after computeRHSJacobian()\n");
+  }
+  
+  geoBuilder->releaseGE(); 
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::computeFaceRHSThreaded(SafePtr<TopologicalRegionSet> trs, CFuint iTRS)
+{
+  if (iTRS >= _colorStart.size() || _colorStart[iTRS].size() == 0) {
+    computeFaceColoring(trs, iTRS);
+  }
+  
+  // the equation subsystem descriptor is shared by all threads: 
+  // it is reset once for the whole TRS
+  PhysicalModelStack::getActive()->resetEquationSubSysDescriptor();
+  
+  prepareThreadFaceLoop(trs, getMethodData());
+  for (CFuint i = 0; i < _threadComs.size(); ++i) {
+    _threadComs[i]->prepareThreadFaceLoop(trs, getMethodData());
+  }
+  
+  const vector<CFuint>& faces = _colorFaces[iTRS];
+  const vector<CFuint>& colorStart = _colorStart[iTRS];
+  const CFuint nbColors = colorStart.size() - 1;
+  
+#ifdef CF_HAVE_OMP
+  const CFuint nbThreads = _threadComs.size() + 1;
+#pragma omp parallel num_threads(nbThreads)
+  {
+    const CFuint threadID = omp_get_thread_num();
+    FVMCC_ComputeRHS *const com = (threadID == 0) ? this : &*_threadComs[threadID-1];
+    
+    // faces with the same color don't share any cell and can be processed concurrently
+    for (CFuint iColor = 0; iColor < nbColors; ++iColor) {
+      const CFint start = colorStart[iColor];
+      const CFint end   = colorStart[iColor+1];
+#pragma omp for schedule(static)
+      for (CFint i = start; i < end; ++i) {
+	com->computeFaceRHS(faces[i], false);
+      }
+    }
+  }
+#else
+  for (CFuint i = 0; i < colorStart[nbColors]; ++i) {
+    computeFaceRHS(faces[i], false);
+  }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::prepareThreadFaceLoop(SafePtr<TopologicalRegionSet> trs, 
+					     const CellCenterFVMData& master)
+{
+  CellCenterFVMData& data = getMethodData();
+  data.setResFactor(master.getResFactor());
+  data.setBuildAllCells(master.getBuildAllCells());
+  data.setIsPreProcessedSolution(master.isPreProcessedSolution());
+  data.setIsInitializationPhase(master.isInitializationPhase());
+  data.setIsPerturb(false);
+  
+  Common::SafePtr<GeometricEntityPool<FaceCellTrsGeoBuilder> > geoBuilder = data.getFaceCellTrsGeoBuilder();
+  geoBuilder->getGeoBuilder()->setDataSockets(socket_states, socket_gstates, socket_nodes);
+  FaceCellTrsGeoBuilder::GeoData& geoData = geoBuilder->getDataGE();
+  geoData.allCells = data.getBuildAllCells();
+  geoData.isBFace = false;
+  geoData.faces = trs;
+  
+  _zeroGrad.assign(PhysicalModelStack::getActive()->getNbEq(), false);
+  _polyRec->setZeroGradient(&_zeroGrad);
+  
+  // gradients and limiters are shared through the data sockets, only 
+  // the per-iteration settings of the reconstructor have to be updated
+  if (&data != &master) {
+    _polyRec->prepareReconstruction();
+    for (CFuint i = 0; i < _eqFilters->size(); ++i) {
+      (*_eqFilters)[i]->reset();
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRHS::computeFaceColoring(SafePtr<TopologicalRegionSet> trs, CFuint iTRS)
+{
+  CFAUTOTRACE;
+  
+  if (_colorStart.size() <= iTRS) {
+    _colorStart.resize(iTRS+1);
+    _colorFaces.resize(iTRS+1);
+  }
+  
+  // greedy coloring: each face gets the lowest color not yet used 
+  // by any other face of its two cells
+  const CFuint nbStates = socket_states.getDataHandle().size();
+  const CFuint nbTrsFaces = trs->getLocalNbGeoEnts();
+  vector<vector<CFuint> > cellColors(nbStates);
+  vector<CFuint> faceColor(nbTrsFaces);
+  CFuint nbColors = 0;
+  for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+    const vector<CFuint>& colorsL = cellColors[trs->getStateID(iFace, 0)];
+    const vector<CFuint>& colorsR = cellColors[trs->getStateID(iFace, 1)];
+    CFuint color = 0;
+    while (find(colorsL.begin(), colorsL.end(), color) != colorsL.end() ||
+	   find(colorsR.begin(), colorsR.end(), color) != colorsR.end()) {
+      ++color;
+    }
+    faceColor[iFace] = color;
+    cellColors[trs->getStateID(iFace, 0)].push_back(color);
+    cellColors[trs->getStateID(iFace, 1)].push_back(color);
+    nbColors = max(nbColors, color+1);
+  }
+  
+  // sort the faces by color, keeping the original ordering inside each color
+  vector<CFuint>& colorStart = _colorStart[iTRS];
+  colorStart.assign(nbColors+1, 0);
+  for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+    colorStart[faceColor[iFace]+1]++;
+  }
+  for (CFuint iColor = 0; iColor < nbColors; ++iColor) {
+    colorStart[iColor+1] += colorStart[iColor];
+  }
+  
+  vector<CFuint>& faces = _colorFaces[iTRS];
+  faces.resize(nbTrsFaces);
+  vector<CFuint> count(colorStart.begin(), colorStart.end()-1);
+  for (CFuint iFace = 0; iFace < nbTrsFaces; ++iFace) {
+    faces[count[faceColor[iFace]]++] = iFace;
+  }
+  
+  CFLog(INFO, "FVMCC_ComputeRHS::computeFaceColoring() => TRS " << trs->getName() << ": " 
+	<< nbTrsFaces << " faces in " << nbColors << " colors for " 
+	<< _threadComs.size() + 1 << " threads\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void FVMCC_ComputeRHS::setup()
 {
   CFAUTOTRACE;
@@ -75,9 +75,42 @@ public:
    * @return a vector of SafePtr with the DataSockets
    */
   virtual std::vector<Common::SafePtr<Framework::BaseDataSocketSink> > needsSockets();
-    
+  
+  /**
+   * Tell if the face loop of this command can be split among threads,
+   * each one working on its own copy of the command
+   */
+  virtual bool isThreadSafe() const {return true;}
+  
+  /**
+   * Set the copies of this command (one per additional thread) which
+   * process part of the faces inside the face loop
+   */
+  void setThreadCommands(const std::vector<Common::SafePtr<FVMCC_ComputeRHS> >& threadComs)
+  {
+    _threadComs = threadComs;
+  }
+  
 protected:
   
+  /// Compute the contribution of the given face of the current TRS to the RHS
+  /// @param iFace         local index of the face inside the current TRS
+  /// @param hasSourceTerm flag telling if a source term has to be computed
+  void computeFaceRHS(CFuint iFace, bool hasSourceTerm);
+  
+  /// Process the faces of the given inner TRS on multiple threads
+  void computeFaceRHSThreaded(Common::SafePtr<Framework::TopologicalRegionSet> trs, CFuint iTRS);
+  
+  /// Prepare a thread copy of this command for processing the given inner TRS
+  /// @param trs    TRS to be processed
+  /// @param master data of the command driving the face loop
+  void prepareThreadFaceLoop(Common::SafePtr<Framework::TopologicalRegionSet> trs, 
+			     const CellCenterFVMData& master);
+  
+  /// Partition the faces of the given TRS into colors such that two faces
+  /// sharing a cell never have the same color
+  void computeFaceColoring(Common::SafePtr<Framework::TopologicalRegionSet> trs, CFuint iTRS);
+  
   /// Restore the backed up left states
   virtual void restoreState(CFuint iCell) {}
   
@@ -357,6 +390,18 @@ protected:
   /// flag telling if to use analytical transformation matrix
   bool _useAnalyticalMatrix;
   
+  /// copies of this command processing faces on the additional threads
+  std::vector<Common::SafePtr<FVMCC_ComputeRHS> > _threadComs;
+  
+  /// faces of each TRS sorted by color
+  std::vector<std::vector<CFuint> > _colorFaces;
+  
+  /// start of each color inside _colorFaces (one more entry than the colors)
+  std::vector<std::vector<CFuint> > _colorStart;
+  
+  /// flags for zero gradient extrapolation on inner faces
+  std::vector<bool> _zeroGrad;
+  
 }; // class FVMCC_ComputeRHS
 
 //////////////////////////////////////////////////////////////////////////////
@@ -280,9 +280,6 @@ void FVMCC_ComputeRhsBlockJacob::initializeComputationRHS()
     socket_diagMatrix.getDataHandle() = 0.;
   }
   
-  // try to see if this fixes the LS with Roe
-  _polyRec->updateWeights();
-  
   // gradients and limiters are computed on all the variables at once
   _polyRec->computeGradients();
   
@@ -37,6 +37,11 @@ public:
    * Destructor.
    */
   virtual ~FVMCC_ComputeRhsBlockJacob();
+  
+  /**
+   * The face loop cannot be split among threads: the jacobian contributions are assembled in shared blocks
+   */
+  virtual bool isThreadSafe() const {return false;}
 
   /**
    * Defines the Config Option's of this class
@@ -418,9 +418,6 @@ void FVMCC_ComputeRhsJacob::initializeComputationRHS()
     _lss->getMatrix()->resetToZeroEntries();
   }
   
-  // try to see if this fixes the LS with Roe
-  _polyRec->updateWeights();
-  
   // gradients and limiters are computed on all the variables at once
   _polyRec->computeGradients();
   
@@ -37,6 +37,11 @@ public:
    * Destructor.
    */
   virtual ~FVMCC_ComputeRhsJacob();
+  
+  /**
+   * The face loop cannot be split among threads: the jacobian contributions are assembled in a shared matrix
+   */
+  virtual bool isThreadSafe() const {return false;}
 
   /**
    * Defines the Config Option's of this class
@@ -0,0 +1,147 @@
+#include "FiniteVolume/FiniteVolume.hh"
+#include "FVMCC_ComputeRhsJacobAD.hh"
+#include "FiniteVolume/FVMCC_FluxSplitter.hh"
+#include "FiniteVolume/FVMCC_BC.hh"
+#include "Framework/BlockAccumulator.hh"
+#include "Framework/LSSMatrix.hh"
+#include "Framework/MethodCommandProvider.hh"
+#include "Common/BadValueException.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider<FVMCC_ComputeRhsJacobAD,
+		      CellCenterFVMData,
+		      FiniteVolumeModule>
+fvmcc_computeRhsJacobAD("NumJacobAD");
+
+//////////////////////////////////////////////////////////////////////////////
+
+FVMCC_ComputeRhsJacobAD::FVMCC_ComputeRhsJacobAD
+(const std::string& name) :
+  FVMCC_ComputeRhsJacobAnalytic(name),
+  _ghostDiff(),
+  _dGhostdInner(),
+  _bJacob()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+FVMCC_ComputeRhsJacobAD::~FVMCC_ComputeRhsJacobAD()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobAD::setup()
+{
+  FVMCC_ComputeRhsJacobAnalytic::setup();
+  
+  SafePtr<FVMCC_FluxSplitter> fluxSplitter = _fluxSplitter.d_castTo<FVMCC_FluxSplitter>();
+  if (!fluxSplitter->hasADJacobian()) {
+    throw BadValueException
+      (FromHere(), "FVMCC_ComputeRhsJacobAD::setup() => flux splitter " + 
+       _fluxSplitter->getName() + " does not compute its jacobians by automatic differentiation");
+  }
+  
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  _ghostDiff.resize(nbEqs);
+  _dGhostdInner.resize(nbEqs, nbEqs);
+  _bJacob.resize(nbEqs, nbEqs);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void FVMCC_ComputeRhsJacobAD::computeBoundaryJacobianTerm()
+{
+  if (_hasDiffusiveTerm && _isDiffusionActive) {
+    FVMCC_ComputeRhsJacob::computeBoundaryJacobianTerm();
+    return;
+  }
+  
+  getMethodData().setIsPerturb(true);
+  
+  const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+  State& currState = *_currFace->getState(0);
+  State& ghostState = *_currFace->getState(1);
+  cf_assert(ghostState.isGhost());
+  
+  if (currState.isParUpdatable()) {
+    const bool isAxi = getMethodData().isAxisymmetric();
+    _upFactor[LEFT] = (!isAxi) ? getResFactor() : getResFactor()*(_rMid*_invr[0]);
+    _upStFactor[LEFT] = (!isAxi) ? -getResFactor() :-getResFactor()*_invr[0];
+    
+    // copy the original value of the ghost state
+    _origState = ghostState;
+    
+    _bAcc->setRowColIndex(0, currState.getLocalID());
+    
+    for (CFuint iVar = 0; iVar < nbEqs; ++iVar) {
+      // set the perturbed variable
+      getMethodData().setIPerturbVar(iVar);
+      
+      // perturb the given component of the state vector
+      _numericalJacob->perturb(iVar, currState[iVar]);
+      
+      // compute the ghost state in the perturbed inner state
+      _currBC->setGhostState(_currFace);
+      _numericalJacob->computeDerivative
+	(_origState, static_cast<const RealVector&>(ghostState), _ghostDiff);
+      _dGhostdInner.setColumn(_ghostDiff, iVar);
+      
+      if (computeSourceTermJacob(0, 0, _stNumJacobIDs)) {
+	_sourceDiffSum = 0.0;
+	addSourceTermNumJacob(_currFace->getNeighborGeo(0), 0);
+	_sourceDiffSum *= _upStFactor[LEFT];
+	_bAcc->addValues(0, 0, iVar, &_sourceDiffSum[0]);
+      }
+      
+      // restore the unperturbed value
+      _numericalJacob->restore(currState[iVar]);
+      
+      // restore the original ghost state
+      ghostState = _origState;
+    }
+    
+    // the flux jacobians with respect to the inner and ghost states
+    // have been computed together with the unperturbed boundary flux
+    _bJacob = (*_fluxSplitter->getRightFluxJacob())*_dGhostdInner;
+    _bJacob += *_fluxSplitter->getLeftFluxJacob();
+    _bJacob *= _upFactor[LEFT];
+    _bAcc->addValuesM(0, 0, _bJacob);
+    
+    // compute analytical jacobian for source term 
+    if (computeSourceTermJacob(LEFT,_stAnJacobIDs)) {
+      addAnalyticSourceTermJacob(LEFT, _bAcc.get());
+    }
+    
+    // add the values in the jacobian matrix
+    _lss->getMatrix()->addValues(*_bAcc);
+    
+    // reset to zero the entries in the block accumulator
+    _bAcc->reset();
+    _sourceJacobOnCell[LEFT] = false;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // namespace FiniteVolume
+
+} // namespace Numerics
+
+} // namespace COOLFluiD
@@ -0,0 +1,78 @@
+#ifndef COOLFluiD_Numerics_FiniteVolume_FVMCC_ComputeRhsJacobAD_hh
+#define COOLFluiD_Numerics_FiniteVolume_FVMCC_ComputeRhsJacobAD_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "FiniteVolume/FVMCC_ComputeRhsJacobAnalytic.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+    
+  namespace Numerics {
+
+    namespace FiniteVolume {
+  
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class represent a command that computes the RHS and the jacobian
+ * using standard cell center FVM schemes, where the convective flux
+ * jacobians are computed exactly by the flux splitter through automatic
+ * differentiation (one evaluation per face instead of one per perturbed
+ * variable). On the boundary faces, the flux is not evaluated again either:
+ * only the ghost state is differentiated numerically and combined with the
+ * jacobians with respect to the inner and ghost states. Boundary faces with
+ * an active diffusive term are still differentiated numerically.
+ *
+ */
+class FVMCC_ComputeRhsJacobAD : public FVMCC_ComputeRhsJacobAnalytic {
+public:
+  
+  /**
+   * Constructor.
+   */
+  explicit FVMCC_ComputeRhsJacobAD(const std::string& name);
+
+  /**
+   * Destructor.
+   */
+  ~FVMCC_ComputeRhsJacobAD();
+  
+  /**
+   * Set up private data and data of the aggregated classes
+   * in this command before processing phase
+   */
+  virtual void setup();
+  
+protected:
+  
+  /**
+   * Compute the contribution of the current boundary face to the jacobian
+   */
+  virtual void computeBoundaryJacobianTerm();
+  
+private:
+  
+  /// derivative of the ghost state with respect to one inner state variable
+  RealVector _ghostDiff;
+  
+  /// derivatives of the ghost state with respect to the inner state
+  RealMatrix _dGhostdInner;
+  
+  /// jacobian of the boundary flux with respect to the inner state
+  RealMatrix _bJacob;
+  
+}; // class FVMCC_ComputeRhsJacobAD
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FiniteVolume_FVMCC_ComputeRhsJacobAD_hh
@@ -533,9 +533,6 @@ void FVMCC_ComputeRhsJacobCoupling::initializeComputationRHS()
     }
   }
   
-  // try to see if this fixes the LS with Roe
-  _polyRec->updateWeights();
-  
   // gradients and limiters are computed on all the variables at once
   _polyRec->computeGradients();
   
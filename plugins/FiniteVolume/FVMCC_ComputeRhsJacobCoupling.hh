@@ -36,6 +36,11 @@ public:
    * Destructor.
    */
   virtual ~FVMCC_ComputeRhsJacobCoupling();
+  
+  /**
+   * The face loop cannot be split among threads: the jacobian contributions are assembled in shared matrices
+   */
+  virtual bool isThreadSafe() const {return false;}
 
   /**
    * Set up private data and data of the aggregated classes
@@ -118,8 +118,10 @@ void FVMCC_FluxSplitter::computeFlux(RealVector& result)
     integrateFluxOnly(result);
   } 
   else {
+    // jacobians by automatic differentiation come with the flux, also on
+    // the boundary faces, where they are combined with the ghost state derivatives
     const bool isBFace =  currFace->getState(1)->isGhost();
-      (!isBFace) ? integrateFluxAndJacob(result) : integrateFluxOnly(result);
+    (!isBFace || hasADJacobian()) ? integrateFluxAndJacob(result) : integrateFluxOnly(result);
   }
 }
       
@@ -65,6 +65,20 @@ public:
    */
   virtual void computeFlux(RealVector& result);
   
+  /**
+   * Tell if the flux jacobians are computed exactly by automatic
+   * differentiation of the flux
+   */
+  virtual bool hasADJacobian() const {return false;}
+  
+  /**
+   * Tell if the flux can be computed concurrently by several copies of
+   * this splitter. This is false by default, since most splitters and
+   * var sets use the physical data stored in the physical model (e.g.
+   * through the jacobian linearizer), which are shared by all threads
+   */
+  virtual bool isThreadSafe() const {return false;}
+  
 protected:
   
   /**
@@ -0,0 +1,117 @@
+#ifndef COOLFluiD_Numerics_FiniteVolume_FluxSplitterAD_hh
+#define COOLFluiD_Numerics_FiniteVolume_FluxSplitterAD_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "MathTools/DualNumber.hh"
+#include "FiniteVolume/FVMCC_FluxSplitter.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class computes a flux written for a generic scalar type (FLUX is
+ * LaxFriedFluxT, RoeFluxT<N> or StegerWarmingFluxT<BASE>) with a variable
+ * set VS corresponding to the update variables and written for a generic
+ * scalar type as well. If the analytical jacobian is requested, the flux is
+ * evaluated once with dual numbers, giving the flux and the exact jacobians
+ * with respect to the left and right states (in update variables) at the
+ * same time.
+ * Subclasses set up the variable set m_model.
+ *
+ */
+template <typename VS, typename FLUX>
+class FluxSplitterAD : public FVMCC_FluxSplitter {
+public:
+  
+  /// number of equations
+  enum {NBEQS = VS::NBEQS};
+  
+  /// dual number carrying the derivatives with respect to both states
+  typedef MathTools::DualNumber<2*NBEQS> DUAL;
+  
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the Option's
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+  
+  /**
+   * Constructor
+   */
+  FluxSplitterAD(const std::string& name);
+  
+  /**
+   * Default destructor
+   */
+  virtual ~FluxSplitterAD();
+  
+  /**
+   * Set up private data
+   */
+  virtual void setup();
+  
+  /**
+   * Tell if the flux jacobians are computed exactly by automatic
+   * differentiation of the flux
+   */
+  virtual bool hasADJacobian() const {return true;}
+  
+protected:
+  
+  /**
+   * Compute the flux : implementation
+   */
+  virtual void compute(RealVector& result);
+  
+  /**
+   * Compute the left flux jacobian (already done in compute())
+   */
+  virtual void computeLeftJacobian() {}
+  
+  /**
+   * Compute the right flux jacobian (already done in compute())
+   */
+  virtual void computeRightJacobian() {}
+  
+  /**
+   * Compute the artificial diffusion reduction coefficient
+   */
+  CFreal getReductionCoeff()
+  {
+    m_diffRedCoeff = std::min(m_diffRedCoeff, getDissipationControlCoeff());
+    return m_diffRedCoeff;
+  }
+  
+protected:
+  
+  /// variable set corresponding to the update variables
+  VS m_model;
+  
+  /// diffusion reduction coefficient
+  CFreal m_diffRedCoeff;
+  
+}; // end of class FluxSplitterAD
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "FiniteVolume/FluxSplitterAD.ci"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FiniteVolume_FluxSplitterAD_hh
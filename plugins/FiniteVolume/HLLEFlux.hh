@@ -40,6 +40,11 @@ public:
    */
   virtual ~HLLEFlux();
   
+  /**
+   * The Roe averaged wave speeds use the physical data of the physical model
+   */
+  virtual bool isThreadSafe() const {return false;}
+  
   /**
    * Set up private data
    */
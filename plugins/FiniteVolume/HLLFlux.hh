@@ -38,6 +38,12 @@ public:
    */
   virtual ~HLLFlux();
   
+  /**
+   * Tell if the flux can be computed concurrently by several copies of
+   * this splitter (it only works on the extrapolated physical data)
+   */
+  virtual bool isThreadSafe() const {return true;}
+  
   /**
    * Set up private data
    */
@@ -0,0 +1,60 @@
+#ifndef COOLFluiD_Numerics_FiniteVolume_LaxFriedFluxT_hh
+#define COOLFluiD_Numerics_FiniteVolume_LaxFriedFluxT_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "MathTools/DualNumber.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class computes the Lax-Friedrichs flux with a variable set written
+ * for a generic scalar type (e.g. Physics::NavierStokes::Euler2DConsT):
+ * evaluated with MathTools::DualNumber states, it gives the flux and its
+ * exact jacobians with respect to both states at once.
+ *
+ * The variable set VS must provide computePhysicalData(), getFlux(),
+ * computeConsVariables(), getMaxEigenValue() and getMaxAbsEigenValue()
+ * templated on the scalar type.
+ *
+ */
+class LaxFriedFluxT {
+public:
+  
+  /**
+   * Compute the flux for the given left and right states (update variables)
+   * @param model     variable set corresponding to the update variables
+   * @param diffCoeff artificial diffusion reduction coefficient
+   * @param maxEvL    maximum eigenvalue in the left state
+   * @param maxEvR    maximum eigenvalue in the right state (opposite normal)
+   */
+  template <typename VS, typename T>
+  static void computeFlux(const VS& model, const T* stateL, const T* stateR,
+			  const CFreal* normal, CFreal diffCoeff, T* flux,
+			  CFreal& maxEvL, CFreal& maxEvR);
+  
+}; // end of class LaxFriedFluxT
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "FiniteVolume/LaxFriedFluxT.ci"
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FiniteVolume_LaxFriedFluxT_hh
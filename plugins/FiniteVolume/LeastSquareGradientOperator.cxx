@@ -0,0 +1,307 @@
+#include <map>
+
+#include "LeastSquareGradientOperator.hh"
+#include "MathTools/MathChecks.hh"
+
+#ifdef CF_HAVE_OMP
+#include <omp.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::MathTools;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+LeastSquareGradientOperator::LeastSquareGradientOperator() :
+  m_dim(0),
+  m_rowStart(),
+  m_neighbor(),
+  m_coeff(),
+  m_ghosts(),
+  m_values()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+LeastSquareGradientOperator::~LeastSquareGradientOperator()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint LeastSquareGradientOperator::build(const CFuint dim,
+					  DataHandle<State*, GLOBAL> states,
+					  DataHandle<vector<State*> > stencil,
+					  DataHandle<CFreal> weights,
+					  bool zeroSingular)
+{
+  cf_assert(dim == DIM_2D || dim == DIM_3D);
+
+  m_dim = dim;
+  const CFuint nbStates = states.size();
+  // upper triangle of the symmetric least square matrix of each cell
+  const CFuint nbLEntries = (dim == DIM_2D) ? 3 : 6;
+
+  m_ghosts.clear();
+  map<const State*, CFuint> ghostIdx;
+  vector<CFreal> l(nbStates*nbLEntries, 0.);
+  vector<CFuint> rowSize(nbStates, 0);
+
+  // weighted edges: first state, last point (ghosts after the states) and
+  // w^2 (x_last - x_first)
+  vector<CFuint> edgeFirst;
+  vector<CFuint> edgeLast;
+  vector<CFreal> edgeCoeff;
+  CFreal d[DIM_3D];
+
+  CFuint iEdge = 0;
+  for (CFuint iState = 0; iState < nbStates; ++iState) {
+    const State* const first = states[iState];
+    const CFuint firstID = first->getLocalID();
+    cf_assert(firstID == iState);
+    const CFuint stencilSize = stencil[iState].size();
+    for (CFuint in = 0; in < stencilSize; ++in) {
+      const State* const last = stencil[iState][in];
+      const CFuint lastID = (!last->isGhost()) ? last->getLocalID() :
+	numeric_limits<CFuint>::max();
+      cf_assert(firstID != lastID);
+
+      if (lastID > firstID) {
+	const RealVector& nodeFirst = first->getCoordinates();
+	const RealVector& nodeLast = last->getCoordinates();
+	const CFreal w = weights[iEdge];
+	for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	  d[iDim] = w*(nodeLast[iDim] - nodeFirst[iDim]);
+	}
+
+	CFuint lastIdx = lastID;
+	if (last->isGhost()) {
+	  map<const State*, CFuint>::const_iterator it = ghostIdx.find(last);
+	  if (it == ghostIdx.end()) {
+	    lastIdx = nbStates + m_ghosts.size();
+	    ghostIdx[last] = lastIdx;
+	    m_ghosts.push_back(last);
+	  }
+	  else {
+	    lastIdx = it->second;
+	  }
+	}
+
+	const CFuint nbRows = (!last->isGhost()) ? 2 : 1;
+	const CFuint rows[2] = {firstID, lastID};
+	for (CFuint r = 0; r < nbRows; ++r) {
+	  CFreal* lr = &l[rows[r]*nbLEntries];
+	  CFuint k = 0;
+	  for (CFuint i = 0; i < dim; ++i) {
+	    for (CFuint j = i; j < dim; ++j, ++k) {
+	      lr[k] += d[i]*d[j];
+	    }
+	  }
+	  ++rowSize[rows[r]];
+	}
+
+	edgeFirst.push_back(firstID);
+	edgeLast.push_back(lastIdx);
+	for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	  edgeCoeff.push_back(w*d[iDim]);
+	}
+	++iEdge;
+      }
+    }
+  }
+
+  m_rowStart.resize(nbStates + 1);
+  m_rowStart[0] = 0;
+  for (CFuint iState = 0; iState < nbStates; ++iState) {
+    m_rowStart[iState+1] = m_rowStart[iState] + rowSize[iState];
+  }
+
+  // each edge contributes to the row of the first state and, unless the
+  // last one is a ghost, with the opposite sign to the row of the last state
+  const CFuint nbEntries = m_rowStart[nbStates];
+  m_neighbor.resize(nbEntries);
+  m_coeff.resize(nbEntries*dim);
+  vector<CFuint> next(m_rowStart.begin(), m_rowStart.end() - 1);
+  for (CFuint e = 0; e < edgeFirst.size(); ++e) {
+    const CFuint firstID = edgeFirst[e];
+    const CFuint lastIdx = edgeLast[e];
+    const CFreal* c = &edgeCoeff[e*dim];
+
+    const CFuint kf = next[firstID]++;
+    m_neighbor[kf] = lastIdx;
+    for (CFuint iDim = 0; iDim < dim; ++iDim) {
+      m_coeff[kf*dim + iDim] = c[iDim];
+    }
+
+    if (lastIdx < nbStates) {
+      const CFuint kl = next[lastIdx]++;
+      m_neighbor[kl] = firstID;
+      for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	m_coeff[kl*dim + iDim] = -c[iDim];
+      }
+    }
+  }
+
+  // fold the inverse of the least square matrix into the coefficients
+  CFuint nbSingular = 0;
+  CFreal linv[DIM_3D][DIM_3D];
+  for (CFuint iState = 0; iState < nbStates; ++iState) {
+    const CFreal* lr = &l[iState*nbLEntries];
+    CFreal det = 0.;
+    if (dim == DIM_2D) {
+      const CFreal l11 = lr[0], l12 = lr[1], l22 = lr[2];
+      det = l11*l22 - l12*l12;
+      linv[0][0] =  l22; linv[0][1] = -l12;
+      linv[1][0] = -l12; linv[1][1] =  l11;
+    }
+    else {
+      const CFreal l11 = lr[0], l12 = lr[1], l13 = lr[2];
+      const CFreal l22 = lr[3], l23 = lr[4], l33 = lr[5];
+      det = l11*l22*l33 - l11*l23*l23 - l12*l12*l33
+	+ l12*l13*l23 + l13*l12*l23 - l13*l13*l22;
+      linv[0][0] = l22*l33 - l23*l23;
+      linv[1][1] = l11*l33 - l13*l13;
+      linv[2][2] = l11*l22 - l12*l12;
+      linv[0][1] = linv[1][0] = -(l12*l33 - l13*l23);
+      linv[0][2] = linv[2][0] = l12*l23 - l13*l22;
+      linv[1][2] = linv[2][1] = -(l11*l23 - l13*l12);
+    }
+
+    const bool isSingular = MathChecks::isZero(det);
+    if (isSingular) ++nbSingular;
+    const CFreal invDet = (isSingular && zeroSingular) ? 0. : 1./det;
+
+    for (CFuint k = m_rowStart[iState]; k < m_rowStart[iState+1]; ++k) {
+      CFreal* c = &m_coeff[k*dim];
+      for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	d[iDim] = c[iDim];
+      }
+      for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	CFreal sum = 0.;
+	for (CFuint jDim = 0; jDim < dim; ++jDim) {
+	  sum += linv[iDim][jDim]*d[jDim];
+	}
+	c[iDim] = sum*invDet;
+      }
+    }
+  }
+
+  return nbSingular;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareGradientOperator::compute(DataHandle<State*, GLOBAL> states,
+					  const CFuint nbEqs, CFreal* uX,
+					  CFreal* uY, CFreal* uZ,
+					  const CFuint nbThreads)
+{
+  cf_assert(isBuilt());
+  cf_assert(states.size() + 1 == m_rowStart.size());
+
+  if (states.size() == 0) return;
+
+  gatherValues(states, nbEqs, nbThreads);
+
+  if (m_dim == DIM_2D) {
+    applyOperator<DIM_2D>(nbEqs, uX, uY, uZ, nbThreads);
+  }
+  else {
+    applyOperator<DIM_3D>(nbEqs, uX, uY, uZ, nbThreads);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareGradientOperator::gatherValues(DataHandle<State*, GLOBAL> states,
+					       const CFuint nbEqs,
+					       const CFuint nbThreads)
+{
+  const CFint nbStates = states.size();
+  const CFuint nbGhosts = m_ghosts.size();
+  m_values.resize((nbStates + nbGhosts)*nbEqs);
+
+#ifdef CF_HAVE_OMP
+#pragma omp parallel for num_threads(nbThreads) schedule(static)
+#endif
+  for (CFint iState = 0; iState < nbStates; ++iState) {
+    const State& state = *states[iState];
+    CFreal* values = &m_values[iState*nbEqs];
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+      values[iEq] = state[iEq];
+    }
+  }
+
+  for (CFuint iGhost = 0; iGhost < nbGhosts; ++iGhost) {
+    const State& ghost = *m_ghosts[iGhost];
+    CFreal* values = &m_values[(nbStates + iGhost)*nbEqs];
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+      values[iEq] = ghost[iEq];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <CFuint DIM>
+void LeastSquareGradientOperator::applyOperator(const CFuint nbEqs, CFreal* uX,
+						CFreal* uY, CFreal* uZ,
+						const CFuint nbThreads) const
+{
+  const CFint nbStates = m_rowStart.size() - 1;
+  const CFreal* const u = &m_values[0];
+
+#ifdef CF_HAVE_OMP
+#pragma omp parallel for num_threads(nbThreads) schedule(static)
+#endif
+  for (CFint iState = 0; iState < nbStates; ++iState) {
+    const CFuint start = iState*nbEqs;
+    const CFreal* const ui = u + start;
+    CFreal* const gx = uX + start;
+    CFreal* const gy = uY + start;
+    CFreal* const gz = (DIM == DIM_3D) ? uZ + start : CFNULL;
+
+    for (CFuint iVar = 0; iVar < nbEqs; ++iVar) {
+      gx[iVar] = 0.;
+      gy[iVar] = 0.;
+      if (DIM == DIM_3D) gz[iVar] = 0.;
+    }
+
+    const CFuint end = m_rowStart[iState+1];
+    for (CFuint k = m_rowStart[iState]; k < end; ++k) {
+      const CFreal* const un = u + m_neighbor[k]*nbEqs;
+      const CFreal* const c = &m_coeff[k*DIM];
+      const CFreal cx = c[XX];
+      const CFreal cy = c[YY];
+      const CFreal cz = (DIM == DIM_3D) ? c[ZZ] : 0.;
+      for (CFuint iVar = 0; iVar < nbEqs; ++iVar) {
+	const CFreal du = un[iVar] - ui[iVar];
+	gx[iVar] += cx*du;
+	gy[iVar] += cy*du;
+	if (DIM == DIM_3D) gz[iVar] += cz*du;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,127 @@
+#ifndef COOLFluiD_Numerics_FiniteVolume_LeastSquareGradientOperator_hh
+#define COOLFluiD_Numerics_FiniteVolume_LeastSquareGradientOperator_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Framework/DataSocketSink.hh"
+#include "Framework/State.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class implements the linear least square gradient operator of the
+ * cell centered reconstructors in a form which is cheap to apply.
+ *
+ * The weighted least square gradient of a cell i is
+ *   grad(u)_i = L_i^-1 * sum_n w_in^2 (x_n - x_i) (u_n - u_i)
+ * where L_i does not depend on the solution: the inverse matrix is folded
+ * once into one geometric coefficient per (cell, neighbor) pair, stored in
+ * flat CSR arrays, so that applying the operator only needs, for each edge,
+ * one difference of states and DIM multiply-adds per variable. All the
+ * variables of an edge are processed together in a contiguous inner loop
+ * that the compiler can vectorize, and the cells can be split among OpenMP
+ * threads, since each cell only writes its own gradients.
+ *
+ * The operator must be rebuilt whenever the stencil or the weights change:
+ * clear() discards it, so that it can be rebuilt lazily before its next use.
+ */
+class LeastSquareGradientOperator {
+public:
+
+  /// Constructor
+  LeastSquareGradientOperator();
+
+  /// Destructor
+  ~LeastSquareGradientOperator();
+
+  /**
+   * Build the operator, visiting the edges in the same order in which the
+   * weights have been computed (each edge is stored once, by the state with
+   * the smallest local ID, ghost neighbors coming last)
+   * @param dim           space dimension (2 or 3)
+   * @param zeroSingular  if true, the gradient of a cell with a singular least
+   *                      square matrix is set to zero
+   * @return the number of cells with a singular least square matrix
+   */
+  CFuint build(const CFuint dim,
+	       Framework::DataHandle<Framework::State*, Framework::GLOBAL> states,
+	       Framework::DataHandle<std::vector<Framework::State*> > stencil,
+	       Framework::DataHandle<CFreal> weights,
+	       bool zeroSingular);
+
+  /**
+   * Compute the gradients of all the variables in all the cells
+   * @param uX, uY, uZ  gradients stored as [stateID*nbEqs + iVar],
+   *                    uZ is ignored in 2D
+   * @param nbThreads   number of OpenMP threads (ignored without CF_HAVE_OMP)
+   */
+  void compute(Framework::DataHandle<Framework::State*, Framework::GLOBAL> states,
+	       const CFuint nbEqs, CFreal* uX, CFreal* uY, CFreal* uZ,
+	       const CFuint nbThreads);
+
+  /// @return true if the operator has been built
+  bool isBuilt() const {return !m_rowStart.empty();}
+
+  /// discard the operator after a change of the stencil or of the weights
+  void clear()
+  {
+    m_rowStart.clear();
+    m_neighbor.clear();
+    m_coeff.clear();
+    m_ghosts.clear();
+  }
+
+private:
+
+  /// gather the values of the states and of the ghost states in m_values
+  void gatherValues(Framework::DataHandle<Framework::State*, Framework::GLOBAL> states,
+		    const CFuint nbEqs, const CFuint nbThreads);
+
+  /// apply the operator for the given dimension
+  template <CFuint DIM>
+  void applyOperator(const CFuint nbEqs, CFreal* uX, CFreal* uY, CFreal* uZ,
+		     const CFuint nbThreads) const;
+
+private:
+
+  /// space dimension
+  CFuint m_dim;
+
+  /// start of the row of each cell in m_neighbor, with one extra entry
+  std::vector<CFuint> m_rowStart;
+
+  /// neighbor of each entry, as index in m_values (ghosts after the states)
+  std::vector<CFuint> m_neighbor;
+
+  /// DIM geometric coefficients of each entry
+  std::vector<CFreal> m_coeff;
+
+  /// ghost states appearing in the stencils
+  std::vector<const Framework::State*> m_ghosts;
+
+  /// values of the states followed by the ghost states, contiguous per state
+  std::vector<CFreal> m_values;
+
+}; // end of class LeastSquareGradientOperator
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FiniteVolume_LeastSquareGradientOperator_hh
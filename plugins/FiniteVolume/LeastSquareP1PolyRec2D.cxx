@@ -30,6 +30,14 @@ leastSquareP1PolyRec2DProvider("LinearLS2D");
 
 //////////////////////////////////////////////////////////////////////////////
 
+void LeastSquareP1PolyRec2D::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< CFuint >
+    ("NbThreads","Number of threads computing the gradients (needs CF_ENABLE_OMP).");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 LeastSquareP1PolyRec2D::LeastSquareP1PolyRec2D(const std::string& name) :
   FVMCC_PolyRec(name),
   socket_stencil("stencil"),
@@ -40,8 +48,14 @@ LeastSquareP1PolyRec2D::LeastSquareP1PolyRec2D(const std::string& name) :
   _l12(),
   _l22(),
   _lf1(),
-  _lf2()
+  _lf2(),
+  m_gradientOperator(),
+  m_nbThreads(1)
 {
+  addConfigOptionsTo(this);
+  
+  m_nbThreads = 1;
+  setParameter("NbThreads",&m_nbThreads);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -84,70 +98,19 @@ void LeastSquareP1PolyRec2D::computeGradients()
   prepareReconstruction();
  
   DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
-  DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
-  DataHandle<CFreal> weights = socket_weights.getDataHandle();
   DataHandle<CFreal> uX = socket_uX.getDataHandle();
   DataHandle<CFreal> uY = socket_uY.getDataHandle();
-
-  const CFuint nbStates = states.size();
-  const CFuint nbEquations = PhysicalModelStack::getActive()->getNbEq();
-
-  for(CFuint iVar = 0; iVar < nbEquations; ++iVar) {
-    _lf1 = 0.0;
-    _lf2 = 0.0;
-    CFuint iEdge = 0;
-    
-    for(CFuint iState = 0; iState < nbStates; ++iState) {
-      assert(iState == states[iState]->getLocalID());
-      const State* const first = states[iState];
-      const CFuint stencilSize = stencil[iState].size();
-      // loop over the neighbor cells belonging to the chosen stencil
-      for(CFuint in = 0; in < stencilSize; ++in) {
-	const State* const last = stencil[iState][in];
-	const CFuint lastID = (!last->isGhost()) ? last->getLocalID() : 
-	  numeric_limits<CFuint>::max();
-	const CFuint firstID = first->getLocalID();
-	cf_assert(firstID != lastID);
-	
-	if (lastID > firstID) {
-	  // consider the next edge
-	  const RealVector& nodeFirst = first->getCoordinates();
-	  const RealVector& nodeLast = last->getCoordinates();
-	  const CFreal weig = weights[iEdge];
-	  const CFreal dx = weig*(nodeLast[0] - nodeFirst[0]);
-	  const CFreal dy = weig*(nodeLast[1] - nodeFirst[1]);
-	  const CFreal du = weig*((*last)[iVar] - (*first)[iVar]);
-	  const CFreal dxdu = dx*du;
-	  const CFreal dydu = dy*du;
-	  
-	  _lf1[firstID] += dxdu;
-	  _lf2[firstID] += dydu;
-	  
-	  if (!last->isGhost()) {
-	    _lf1[lastID] += dxdu;
-	    _lf2[lastID] += dydu;
-	  }
-	  
-	  ++iEdge;
-	}
-      }
-    }
-    
-    for(CFuint iState = 0; iState < nbStates; ++iState) {
-      const CFreal invDet = 1./(_l11[iState]*_l22[iState] - _l12[iState]*_l12[iState]);
-      uX(iState,iVar,nbEquations) = (_l22[iState]*_lf1[iState] - _l12[iState]*_lf2[iState])*invDet;
-      uY(iState,iVar,nbEquations) = (_l11[iState]*_lf2[iState] - _l12[iState]*_lf1[iState])*invDet;
-      
-      CFLogDebugMax( "invDet = " << invDet
-		     << ", l11 = " << _l11[iState]
-		     << ", l12 = " << _l12[iState]
-		     << ", l22 = " << _l22[iState]
-		     <<", lf1 = " << _lf1[iState]
-		     <<", lf2 = " << _lf2[iState]
-		     << ", uX =" << uX(iState,iVar,nbEquations)
-		     << ", uY =" << uY(iState,iVar,nbEquations)
-		     << "\n");
-    }
+  
+  // the operator is built at the first call after setup() or updateWeights(),
+  // so that the subclasses computing their own gradients never build it
+  if (!m_gradientOperator.isBuilt()) {
+    buildGradientOperator();
+  }
+  
+  // all the variables of each edge are processed at once by the precomputed operator
+  if (states.size() > 0) {
+    const CFuint nbEquations = PhysicalModelStack::getActive()->getNbEq();
+    m_gradientOperator.compute(states, nbEquations, &uX[0], &uY[0], CFNULL, m_nbThreads);
   }
   
   CFLog(VERBOSE, "LeastSquareP1PolyRec2D::computeGradients() => END\n");
@@ -325,7 +288,8 @@ void LeastSquareP1PolyRec2D::updateWeights()
      }
    }
  }
-
+ 
+ m_gradientOperator.clear();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -397,6 +361,23 @@ void LeastSquareP1PolyRec2D::setup()
      }
    }
  }
+ 
+ m_gradientOperator.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareP1PolyRec2D::buildGradientOperator()
+{
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
+  DataHandle<CFreal> weights = socket_weights.getDataHandle();
+  
+  const CFuint nbSingular = m_gradientOperator.build(DIM_2D, states, stencil, weights, false);
+  if (nbSingular > 0) {
+    CFLog(WARN, "LeastSquareP1PolyRec2D::buildGradientOperator() => " << nbSingular
+	  << " cells with singular least square matrix\n");
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
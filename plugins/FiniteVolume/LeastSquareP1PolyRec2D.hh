@@ -4,6 +4,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "FiniteVolume/FVMCC_PolyRec.hh"
+#include "FiniteVolume/LeastSquareGradientOperator.hh"
 
 #ifdef CF_HAVE_CUDA
 #include "FiniteVolume/FluxData.hh"
@@ -131,6 +132,12 @@ public:
   }   
 #endif
   
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the Option's
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+
   /**
    * Constructor
    */
@@ -170,6 +177,11 @@ public:
 
 protected:
 
+  /**
+   * Build the gradient operator from the current stencil and weights
+   */
+  void buildGradientOperator();
+
   /**
    * Extrapolate the solution in the face quadrature points
    */
@@ -205,6 +217,12 @@ protected:
 
   RealVector  _lf2;
 
+  /// gradient operator precomputed from the stencil and the weights
+  LeastSquareGradientOperator m_gradientOperator;
+
+  /// number of threads computing the gradients
+  CFuint m_nbThreads;
+
 }; // end of class LeastSquareP1PolyRec2D
 
 //////////////////////////////////////////////////////////////////////////////
@@ -27,6 +27,14 @@ MethodStrategyProvider<LeastSquareP1PolyRec3D, CellCenterFVMData, PolyReconstruc
 
 //////////////////////////////////////////////////////////////////////////////
 
+void LeastSquareP1PolyRec3D::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< CFuint >
+    ("NbThreads","Number of threads computing the gradients (needs CF_ENABLE_OMP).");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 LeastSquareP1PolyRec3D::LeastSquareP1PolyRec3D(const std::string& name) :
   FVMCC_PolyRec(name),
   socket_stencil("stencil"),
@@ -42,8 +50,14 @@ LeastSquareP1PolyRec3D::LeastSquareP1PolyRec3D(const std::string& name) :
   _l33(),
   _lf1(),
   _lf2(),
-  _lf3()
+  _lf3(),
+  m_gradientOperator(),
+  m_nbThreads(1)
 {
+  addConfigOptionsTo(this);
+  
+  m_nbThreads = 1;
+  setParameter("NbThreads",&m_nbThreads);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -83,132 +97,22 @@ void LeastSquareP1PolyRec3D::computeGradients()
   prepareReconstruction();
 
   DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
-  DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
-  DataHandle<CFreal> weights = socket_weights.getDataHandle();
   DataHandle<CFreal> uX = socket_uX.getDataHandle();
   DataHandle<CFreal> uY = socket_uY.getDataHandle();
   DataHandle<CFreal> uZ = socket_uZ.getDataHandle();
-
-  const CFuint nbStates = states.size();
-  const CFuint nbEquations = PhysicalModelStack::getActive()->getNbEq();
-
-  for(CFuint iVar = 0; iVar < nbEquations; ++iVar) {
-    _lf1 = 0.0;
-    _lf2 = 0.0;
-    _lf3 = 0.0;
-    CFuint iEdge = 0;
-
-    for(CFuint iState = 0; iState < nbStates; ++iState) {
-      const State* const first = states[iState];
-      const CFuint stencilSize = stencil[iState].size();
-      // loop over the neighbor cells belonging to the chosen stencil
-      for(CFuint in = 0; in < stencilSize; ++in) {
-        const State* const last = stencil[iState][in];
-	const CFuint lastID = (!last->isGhost()) ? last->getLocalID() : 
-	    numeric_limits<CFuint>::max();
-        const CFuint firstID = first->getLocalID();
-        cf_assert(firstID != lastID);
-
-	if (lastID > firstID) {
-	  const RealVector& nodeFirst = first->getCoordinates();
-	  const RealVector& nodeLast = last->getCoordinates();
-
-	  const CFreal dx = weights[iEdge]*(nodeLast[0]
-					    - nodeFirst[0]);
-	  const CFreal dy = weights[iEdge]*(nodeLast[1]
-					    - nodeFirst[1]);
-	  const CFreal dz = weights[iEdge]*(nodeLast[2]
-					    - nodeFirst[2]);
-
-	  const CFreal du = weights[iEdge]*((*last)[iVar] - (*first)[iVar]);
-
-	  CFLogDebugMin( "du = " << du << "\n");
-
-	    _lf1[firstID] += dx*du;
-	    _lf2[firstID] += dy*du;
-	    _lf3[firstID] += dz*du;
-	    
-	    if (!last->isGhost()) {
-		_lf1[lastID]  += dx*du; 
-		_lf2[lastID]  += dy*du;
-		_lf3[lastID]  += dz*du;
-	    }
-	  ++iEdge;
-	}
-      }
-    }
-
-    for(CFuint iState = 0; iState < nbStates; ++iState) {
-
-      const CFreal det = _l11[iState]*_l22[iState]*_l33[iState]
-	- _l11[iState]*_l23[iState]*_l23[iState]
-	- _l12[iState]*_l12[iState]*_l33[iState]
-	+ _l12[iState]*_l13[iState]*_l23[iState]
-	+ _l13[iState]*_l12[iState]*_l23[iState]
-	- _l13[iState]*_l13[iState]*_l22[iState];
-
-      if (!(std::abs(det) > MathTools::MathConsts::CFrealEps())) {
-	CFout << "Det is zero."<<"\n";
-      }
-
-      const CFreal linv11 = _l22[iState]*_l33[iState] - _l23[iState]*_l23[iState];
-      const CFreal linv22 = _l11[iState]*_l33[iState] - _l13[iState]*_l13[iState];
-      const CFreal linv33 = _l11[iState]*_l22[iState] - _l12[iState]*_l12[iState];
-      const CFreal linv12 = -(_l12[iState]*_l33[iState] - _l13[iState]*_l23[iState]);
-      const CFreal linv13 = _l12[iState]*_l23[iState] - _l13[iState]*_l22[iState];
-      const CFreal linv23 = -(_l11[iState]*_l23[iState] - _l13[iState]*_l12[iState]);
-
-      // A cure to the singularites in calculating the determinant
-      if (!MathChecks::isZero(det)) {
-	uX(iState,iVar,nbEquations) = (linv11*_lf1[iState] +
-				       linv12*_lf2[iState] +
-				       linv13*_lf3[iState])/det;
-	uY(iState,iVar,nbEquations) = (linv12*_lf1[iState] +
-				       linv22*_lf2[iState] +
-				       linv23*_lf3[iState])/det;
-	uZ(iState,iVar,nbEquations) = (linv13*_lf1[iState] +
-				       linv23*_lf2[iState] +
-				       linv33*_lf3[iState])/det;
-	
-	// if (std::abs(_uX(iState,iVar,nbEquations)) > 0.) CFout << "ux = " << _uX(iState,iVar,nbEquations) << "\n";
-	// if (std::abs(_uY(iState,iVar,nbEquations)) > 0.) CFout << "uy = " << _uY(iState,iVar,nbEquations) << "\n";
-	// if (std::abs(_uZ(iState,iVar,nbEquations)) > 0.) CFout << "uz = " << _uZ(iState,iVar,nbEquations) << "\n";
-      }
-      else {
-	uX(iState,iVar,nbEquations) = 0.0;
-	uY(iState,iVar,nbEquations) = 0.0;
-	uZ(iState,iVar,nbEquations) = 0.0;
-      }
-
-      CFLogDebugMed( "det = " << det
-		     << ", l11 = " << _l11[iState]
-		     << ", l12 = " << _l12[iState]
-		     << ", l13 = " << _l13[iState]
-		     << ", l22 = " << _l22[iState]
-		     << ", l23 = " << _l23[iState]
-		     << ", l33 = " << _l33[iState]
-		     <<", lf1 = " << _lf1[iState]
-		     <<", lf2 = " << _lf2[iState]
-		     <<", lf3 = " << _lf3[iState]
-		     << ", uX =" << uX(iState,iVar,nbEquations)
-		     << ", uY =" << uY(iState,iVar,nbEquations)
-		     << ", uZ =" << uZ(iState,iVar,nbEquations)
-		     << "\n");
-    }
-  }
   
+  // the operator is built at the first call after setup() or updateWeights(),
+  // so that the subclasses computing their own gradients never build it
+  if (!m_gradientOperator.isBuilt()) {
+    buildGradientOperator();
+  }
   
-  ///// TEST
-  // CFuint idxr = 0;
-  // for (CFuint cellID = 0; cellID < 5000; ++cellID) {
-  //   for (CFuint i = 0; i < 9; ++i, ++idxr) {
-  //     cout << "cellID["<< cellID << "], "<< i << " => UX (";
-  //     cout.precision(12); cout << uX[idxr] << ", " << uY[idxr] << ", " << uZ[idxr] << ")\n";
-  //   }
-  // }
-  // abort();
-  ////
+  if (states.size() == 0) return;
   
+  // all the variables of each edge are processed at once by the precomputed
+  // operator, the gradients of cells with a singular matrix are set to zero
+  const CFuint nbEquations = PhysicalModelStack::getActive()->getNbEq();
+  m_gradientOperator.compute(states, nbEquations, &uX[0], &uY[0], &uZ[0], m_nbThreads);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -401,6 +305,8 @@ void LeastSquareP1PolyRec3D::updateWeights()
       }
     }
   }
+  
+  m_gradientOperator.clear();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -490,6 +396,23 @@ void LeastSquareP1PolyRec3D::setup()
       }
     }
   }
+  
+  m_gradientOperator.clear();
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+void LeastSquareP1PolyRec3D::buildGradientOperator()
+{
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<vector<State*> > stencil = socket_stencil.getDataHandle();
+  DataHandle<CFreal> weights = socket_weights.getDataHandle();
+  
+  const CFuint nbSingular = m_gradientOperator.build(DIM_3D, states, stencil, weights, true);
+  if (nbSingular > 0) {
+    CFLog(WARN, "LeastSquareP1PolyRec3D::buildGradientOperator() => " << nbSingular
+	  << " cells with singular least square matrix get zero gradients\n");
+  }
 }
       
 //////////////////////////////////////////////////////////////////////////////
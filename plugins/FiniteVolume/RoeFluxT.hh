@@ -67,6 +67,23 @@ public:
    */
   virtual void computeRightJacobian();
   
+  /**
+   * Compute the Roe flux for the given left and right states (update
+   * variables) with a variable set written for a generic scalar type
+   * (e.g. Physics::NavierStokes::Euler2DConsT): evaluated with
+   * MathTools::DualNumber states, it gives the flux and its exact jacobians.
+   * The variable set VS must provide computePhysicalData(), getFlux(),
+   * computeConsVariables(), linearize(), computeEigenValuesVectors() and
+   * getMaxEigenValue() templated on the scalar type, with VS::NBEQS == N.
+   * @param diffCoeff artificial diffusion reduction coefficient
+   * @param maxEvL    maximum eigenvalue in the left state
+   * @param maxEvR    maximum eigenvalue in the right state (opposite normal)
+   */
+  template <typename VS, typename T>
+  static void computeFlux(const VS& model, const T* stateL, const T* stateR,
+			  const CFreal* normal, CFreal diffCoeff, T* flux,
+			  CFreal& maxEvL, CFreal& maxEvR);
+  
 protected: // helper functions
   
   /**
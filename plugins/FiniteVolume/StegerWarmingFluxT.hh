@@ -51,8 +51,35 @@ public:
    */
   virtual void compute(RealVector& result);
   
+  /**
+   * Compute the Steger-Warming flux A+(UL)*UL + A-(UR)*UR on all the
+   * equations for the given left and right states (update variables) with
+   * a variable set written for a generic scalar type (e.g.
+   * Physics::NavierStokes::Euler2DConsT): evaluated with
+   * MathTools::DualNumber states, it gives the flux and its exact jacobians.
+   * The variable set VS must provide computePhysicalData(),
+   * computeConsVariables(), computeEigenValuesVectors() and
+   * getMaxEigenValue() templated on the scalar type.
+   * @param diffCoeff unused (no artificial diffusion to reduce)
+   * @param maxEvL    maximum eigenvalue in the left state
+   * @param maxEvR    maximum eigenvalue in the right state (opposite normal)
+   */
+  template <typename VS, typename T>
+  static void computeFlux(const VS& model, const T* stateL, const T* stateR,
+			  const CFreal* normal, CFreal diffCoeff, T* flux,
+			  CFreal& maxEvL, CFreal& maxEvR);
+  
 protected:
   
+  /**
+   * Add A+(U)*U (sign = 1) or A-(U)*U (sign = -1) to the given flux
+   * @param evNormal normal to use for the maximum eigenvalue
+   * @param maxEv    maximum eigenvalue in the given state
+   */
+  template <typename VS, typename T>
+  static void addSplitFlux(const VS& model, const T* state, const CFreal* normal,
+			   CFreal sign, const CFreal* evNormal, T* flux, CFreal& maxEv);
+  
   /// acquaintance of the concrete variable set
   Common::SafePtr<Framework::ConvectiveVarSet> _solutionVarSet;
   
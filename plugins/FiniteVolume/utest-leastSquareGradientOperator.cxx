@@ -0,0 +1,293 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test least square gradient operator"
+
+#include <boost/test/unit_test.hpp>
+
+#include "MathTools/MathFunctions.hh"
+#include "Framework/Node.hh"
+#include "FiniteVolume/LeastSquareGradientOperator.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Numerics::FiniteVolume;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Allocate the storage of a data handle, whatever its container
+template <typename T>
+void newStorage(std::vector<T>*& ptr, const CFuint size, const T& init)
+{
+  ptr = new std::vector<T>(size, init);
+}
+
+#ifdef CF_ENABLE_GROWARRAY
+template <typename T>
+void newStorage(Common::GrowArray<T>*& ptr, const CFuint size, const T& init)
+{
+  ptr = new Common::GrowArray<T>(init, size);
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct LeastSquareGradientOperator_Fixture
+{
+  typedef DataHandle<State*, GLOBAL>::StorageType StatesStorage;
+  typedef DataHandle<vector<State*> >::StorageType StencilStorage;
+  typedef DataHandle<CFreal>::StorageType WeightsStorage;
+
+  /// common setup for each test case
+  LeastSquareGradientOperator_Fixture() :
+    nbEqs(3), seed(12345), statesStorage(CFNULL), stencilStorage(CFNULL), weightsStorage(CFNULL)
+  {
+  }
+
+  /// common tear-down for each test case
+  ~LeastSquareGradientOperator_Fixture()
+  {
+    for (CFuint i = 0; i < allStates.size(); ++i) {
+      deletePtr(allStates[i]);
+    }
+    for (CFuint i = 0; i < nodes.size(); ++i) {
+      deletePtr(nodes[i]);
+    }
+    deletePtr(statesStorage);
+    deletePtr(stencilStorage);
+    deletePtr(weightsStorage);
+  }
+
+  /// pseudo random number in [-1,1], the same on every platform
+  CFreal random()
+  {
+    seed = (seed*1103515245u + 12345u) % 2147483648u;
+    return 2.*seed/2147483648. - 1.;
+  }
+
+  /// Create a state, its node and random values
+  State* newState(const RealVector& coord, bool isGhost)
+  {
+    RealVector values(nbEqs);
+    for (CFuint i = 0; i < nbEqs; ++i) {
+      values[i] = random();
+    }
+    State* state = new State(values, isGhost);
+    nodes.push_back(new Node(coord, false));
+    state->setSpaceCoordinates(nodes.back());
+    allStates.push_back(state);
+    return state;
+  }
+
+  /// Build a perturbed cartesian cloud of nbPerDir^dim cells, whose
+  /// stencils are their face and vertex neighbors, with a ghost state
+  /// beyond each face on the boundary
+  void buildCloud(const CFuint dim, const CFuint nbPerDir)
+  {
+    const CFuint nbStates = (dim == DIM_2D) ? nbPerDir*nbPerDir : nbPerDir*nbPerDir*nbPerDir;
+    newStorage(statesStorage, nbStates, static_cast<State*>(CFNULL));
+    newStorage(stencilStorage, nbStates, vector<State*>());
+    DataHandle<State*, GLOBAL> states(statesStorage);
+    DataHandle<vector<State*> > stencil(stencilStorage);
+
+    vector<CFuint> ijk(nbStates*DIM_3D, 0);
+    RealVector coord(dim);
+    for (CFuint iState = 0; iState < nbStates; ++iState) {
+      CFuint rest = iState;
+      for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	ijk[iState*DIM_3D + iDim] = rest % nbPerDir;
+	rest /= nbPerDir;
+	coord[iDim] = ijk[iState*DIM_3D + iDim] + 0.2*random();
+      }
+      states[iState] = newState(coord, false);
+      states[iState]->setLocalID(iState);
+    }
+
+    for (CFuint iState = 0; iState < nbStates; ++iState) {
+      const CFuint* pi = &ijk[iState*DIM_3D];
+      for (CFuint jState = 0; jState < nbStates; ++jState) {
+	const CFuint* pj = &ijk[jState*DIM_3D];
+	bool isNeighbor = (iState != jState);
+	for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	  isNeighbor = isNeighbor && (pi[iDim] + 1 >= pj[iDim] && pj[iDim] + 1 >= pi[iDim]);
+	}
+	if (isNeighbor) stencil[iState].push_back(states[jState]);
+      }
+
+      for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	if (pi[iDim] == 0 || pi[iDim] == nbPerDir - 1) {
+	  for (CFuint jDim = 0; jDim < dim; ++jDim) {
+	    coord[jDim] = states[iState]->getCoordinates()[jDim];
+	  }
+	  coord[iDim] += (pi[iDim] == 0) ? -0.8 : 0.8;
+	  stencil[iState].push_back(newState(coord, true));
+	}
+      }
+    }
+
+    // weights in the order of the edges visited by the reconstructors
+    vector<CFreal> w;
+    for (CFuint iState = 0; iState < nbStates; ++iState) {
+      for (CFuint in = 0; in < stencil[iState].size(); ++in) {
+	const State* const last = stencil[iState][in];
+	if (last->isGhost() || last->getLocalID() > iState) {
+	  w.push_back(1./MathTools::MathFunctions::getDistance
+		      (states[iState]->getCoordinates(), last->getCoordinates()));
+	}
+      }
+    }
+    newStorage(weightsStorage, w.size(), 0.);
+    DataHandle<CFreal> weights(weightsStorage);
+    for (CFuint i = 0; i < w.size(); ++i) {
+      weights[i] = w[i];
+    }
+  }
+
+  /// Solve the weighted least square problem of each cell directly and
+  /// compare with the gradients given by the operator
+  void checkGradients(const CFuint dim, const vector<CFreal>* grad)
+  {
+    DataHandle<State*, GLOBAL> states(statesStorage);
+    DataHandle<vector<State*> > stencil(stencilStorage);
+
+    for (CFuint iState = 0; iState < states.size(); ++iState) {
+      const State& first = *states[iState];
+      CFreal a[DIM_3D][DIM_3D+3];
+      for (CFuint i = 0; i < dim; ++i) {
+	for (CFuint j = 0; j < dim + nbEqs; ++j) {
+	  a[i][j] = 0.;
+	}
+      }
+
+      // normal equations [L | b] of the cell, one right hand side per variable
+      for (CFuint in = 0; in < stencil[iState].size(); ++in) {
+	const State& last = *stencil[iState][in];
+	const CFreal w = 1./MathTools::MathFunctions::getDistance
+	  (first.getCoordinates(), last.getCoordinates());
+	CFreal d[DIM_3D];
+	for (CFuint i = 0; i < dim; ++i) {
+	  d[i] = last.getCoordinates()[i] - first.getCoordinates()[i];
+	}
+	for (CFuint i = 0; i < dim; ++i) {
+	  for (CFuint j = 0; j < dim; ++j) {
+	    a[i][j] += w*w*d[i]*d[j];
+	  }
+	  for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+	    a[i][dim + iEq] += w*w*d[i]*(last[iEq] - first[iEq]);
+	  }
+	}
+      }
+
+      // Gauss-Jordan elimination, the matrix is symmetric positive definite
+      for (CFuint k = 0; k < dim; ++k) {
+	for (CFuint i = 0; i < dim; ++i) {
+	  if (i != k) {
+	    const CFreal f = a[i][k]/a[k][k];
+	    for (CFuint j = k; j < dim + nbEqs; ++j) {
+	      a[i][j] -= f*a[k][j];
+	    }
+	  }
+	}
+      }
+
+      for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+	  const CFreal expected = a[iDim][dim + iEq]/a[iDim][iDim];
+	  const CFreal computed = grad[iDim][iState*nbEqs + iEq];
+	  BOOST_CHECK_SMALL(computed - expected, 1e-12*max(std::abs(expected), 1.));
+	}
+      }
+    }
+  }
+
+  /// Build the operator on a cloud and check its gradients
+  void checkOperator(const CFuint dim, const CFuint nbPerDir)
+  {
+    buildCloud(dim, nbPerDir);
+    DataHandle<State*, GLOBAL> states(statesStorage);
+    DataHandle<vector<State*> > stencil(stencilStorage);
+    DataHandle<CFreal> weights(weightsStorage);
+
+    LeastSquareGradientOperator op;
+    BOOST_CHECK(!op.isBuilt());
+    BOOST_CHECK_EQUAL(op.build(dim, states, stencil, weights, true), 0u);
+    BOOST_CHECK(op.isBuilt());
+
+    const CFuint size = states.size()*nbEqs;
+    vector<CFreal> grad[DIM_3D];
+    for (CFuint iDim = 0; iDim < DIM_3D; ++iDim) {
+      grad[iDim].resize(size, -1.);
+    }
+    op.compute(states, nbEqs, &grad[XX][0], &grad[YY][0], &grad[ZZ][0], 1);
+    checkGradients(dim, grad);
+
+    // the cells split among threads must give the same gradients
+    vector<CFreal> gradThreads[DIM_3D];
+    for (CFuint iDim = 0; iDim < DIM_3D; ++iDim) {
+      gradThreads[iDim].resize(size, -1.);
+    }
+    op.compute(states, nbEqs, &gradThreads[XX][0], &gradThreads[YY][0], &gradThreads[ZZ][0], 2);
+    for (CFuint iDim = 0; iDim < dim; ++iDim) {
+      for (CFuint i = 0; i < size; ++i) {
+	BOOST_CHECK_EQUAL(gradThreads[iDim][i], grad[iDim][i]);
+      }
+    }
+
+    op.clear();
+    BOOST_CHECK(!op.isBuilt());
+  }
+
+  /// number of variables
+  CFuint nbEqs;
+
+  /// state of the pseudo random generator
+  CFuint seed;
+
+  /// storage of the states of the cloud
+  StatesStorage* statesStorage;
+
+  /// storage of the stencils
+  StencilStorage* stencilStorage;
+
+  /// storage of the weights
+  WeightsStorage* weightsStorage;
+
+  /// all the states, ghosts included
+  vector<State*> allStates;
+
+  /// all the nodes
+  vector<Node*> nodes;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( LeastSquareGradientOperator_TestSuite, LeastSquareGradientOperator_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_directSolve2D )
+{
+  checkOperator(DIM_2D, 5);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_directSolve3D )
+{
+  checkOperator(DIM_3D, 3);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
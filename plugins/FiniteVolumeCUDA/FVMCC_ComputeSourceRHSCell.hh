@@ -43,6 +43,11 @@ public:
    */
   virtual ~FVMCC_ComputeSourceRHSCell();
   
+  /**
+   * The face loop cannot be split among threads: this command uses a cell-based kernel
+   */
+  virtual bool isThreadSafe() const {return false;}
+  
   /**
    * Defines the Config Option's of this class
    * @param options a OptionList where to add the Option's
@@ -39,6 +39,11 @@ public:
    * Destructor.
    */
   virtual ~FVMCC_ComputeRHS_LES();
+  
+  /**
+   * The face loop cannot be split among threads: the LES data are computed on shared storage
+   */
+  virtual bool isThreadSafe() const {return false;}
 
   /**
    * Defines the Config Option's of this class
@@ -3,7 +3,10 @@
 
 //////////////////////////////////////////////////////////////////////////////
 
+#include <memory>
+
 #include "FiniteVolume/ComputeSourceTermFVMCC.hh"
+#include "Framework/PhysicalChemicalLibrary.hh"
 #include "Common/SafePtr.hh"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -18,7 +21,6 @@ namespace COOLFluiD {
   
   namespace Framework {
     class GeometricEntity;
-    class PhysicalChemicalLibrary;
   }
   
   namespace Numerics {
@@ -72,6 +74,12 @@ public:
    */
   virtual void setup();
   
+  /**
+   * Compute the mass production terms of all the cells with a single call
+   * to the physical-chemical library per block of cells
+   */
+  virtual void prepareComputeSource();
+  
   /**
    * Compute the source term
    */
@@ -87,6 +95,13 @@ protected:
   virtual void setVibTemperature(const RealVector& pdata, 
 				 const Framework::State& state,
 				 RealVector& tvib);
+  /**
+   * @return true if the mass production terms of the given state have been
+   *         computed by prepareComputeSource() and the state is unchanged
+   *         (not perturbed) since then
+   */
+  bool hasBlockOmega(const Framework::State& state) const;
+  
   /**
    * Compute the source term for the axisymmetric Navier-Stokes
    */
@@ -149,6 +164,21 @@ protected: // data
   /// relaxation factor for radiation coupling
   CFreal _radRelaxationFactor;	
   
+  /// number of cells evaluated together by the physical-chemical library
+  CFuint _blockSize;
+  
+  /// workspace of the physical-chemical library for the blocks of cells
+  std::auto_ptr<Framework::PhysicalChemicalLibrary::BlockWorkspace> _blockWorkspace;
+  
+  /// input and output arrays of a block of cells (structure of arrays)
+  std::vector<CFreal> _blockData;
+  
+  /// states for which the mass production terms have been computed
+  std::vector<CFreal> _blockStates;
+  
+  /// mass production terms of all the cells
+  std::vector<CFreal> _blockOmega;
+  
 }; // end of class ChemNEQST
 
 //////////////////////////////////////////////////////////////////////////////
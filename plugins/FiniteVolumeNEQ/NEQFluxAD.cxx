@@ -0,0 +1,74 @@
+#include "Framework/MethodStrategyProvider.hh"
+#include "FiniteVolume/LaxFriedFluxT.hh"
+#include "FiniteVolume/RoeFluxT.hh"
+#include "FiniteVolume/StegerWarmingFluxT.hh"
+#include "FiniteVolumeNEQ/FiniteVolumeNEQ.hh"
+#include "FiniteVolumeNEQ/NEQFluxAD.hh"
+#include "NEQ/Euler2DNEQRhoivtT.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Physics::NEQ;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+// 5 species (e.g. air5)
+
+MethodStrategyProvider<NEQFluxAD<Euler2DNEQRhoivtT<5, NEQLibraryThermo>, LaxFriedFluxT>,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNEQModule>
+laxFriedNEQ5FluxAD2DProvider("LaxFriedNEQ5AD2D");
+
+MethodStrategyProvider<NEQFluxAD<Euler2DNEQRhoivtT<5, NEQLibraryThermo>, RoeFluxT<8> >,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNEQModule>
+roeNEQ5FluxAD2DProvider("RoeNEQ5AD2D");
+
+MethodStrategyProvider<NEQFluxAD<Euler2DNEQRhoivtT<5, NEQLibraryThermo>, 
+				 StegerWarmingFluxT<FVMCC_FluxSplitter> >,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNEQModule>
+stegerWarmingNEQ5FluxAD2DProvider("StegerWarmingNEQ5AD2D");
+
+// 11 species (e.g. air11, ionized species are treated as neutral ones)
+
+MethodStrategyProvider<NEQFluxAD<Euler2DNEQRhoivtT<11, NEQLibraryThermo>, LaxFriedFluxT>,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNEQModule>
+laxFriedNEQ11FluxAD2DProvider("LaxFriedNEQ11AD2D");
+
+MethodStrategyProvider<NEQFluxAD<Euler2DNEQRhoivtT<11, NEQLibraryThermo>, RoeFluxT<14> >,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNEQModule>
+roeNEQ11FluxAD2DProvider("RoeNEQ11AD2D");
+
+MethodStrategyProvider<NEQFluxAD<Euler2DNEQRhoivtT<11, NEQLibraryThermo>, 
+				 StegerWarmingFluxT<FVMCC_FluxSplitter> >,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNEQModule>
+stegerWarmingNEQ11FluxAD2DProvider("StegerWarmingNEQ11AD2D");
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,98 @@
+#ifndef COOLFluiD_Numerics_FiniteVolume_NEQFluxAD_hh
+#define COOLFluiD_Numerics_FiniteVolume_NEQFluxAD_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "FiniteVolume/FluxSplitterAD.hh"
+#include "Framework/PhysicalChemicalLibrary.hh"
+#include "NEQ/NEQLibraryThermo.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class computes a flux corresponding to the Euler equations in chemical
+ * non equilibrium in [rho_i u v T] variables (VS is
+ * Physics::NEQ::Euler2DNEQRhoivtT<NS, Physics::NEQ::NEQLibraryThermo>) with
+ * exact jacobians by automatic differentiation.
+ * Only dimensional computations are supported.
+ *
+ */
+template <typename VS, typename FLUX>
+class NEQFluxAD : public FluxSplitterAD<VS, FLUX> {
+public:
+  
+  /**
+   * Constructor
+   */
+  NEQFluxAD(const std::string& name) : 
+    FluxSplitterAD<VS, FLUX>(name), 
+    m_thermo() 
+  {
+  }
+  
+  /**
+   * Default destructor
+   */
+  virtual ~NEQFluxAD() 
+  {
+  }
+  
+  /**
+   * Set up private data
+   */
+  virtual void setup()
+  {
+    using namespace COOLFluiD::Framework;
+    
+    FluxSplitterAD<VS, FLUX>::setup();
+    
+    if (this->getMethodData().getUpdateVarStr() != "Rhoivt") {
+      throw Common::BadValueException
+	(FromHere(), "NEQFluxAD::setup() => update variables must be Rhoivt");
+    }
+    
+    if (PhysicalModelStack::getActive()->getImplementor()->isAdimensional()) {
+      throw Common::BadValueException
+	(FromHere(), "NEQFluxAD::setup() => only dimensional computations are supported");
+    }
+    
+    Common::SafePtr<PhysicalChemicalLibrary> library = 
+      PhysicalModelStack::getActive()->getImplementor()->template
+      getPhysicalPropertyLibrary<PhysicalChemicalLibrary>();
+    cf_assert(library.isNotNull());
+    
+    if (library->getNbSpecies() != VS::NBEQS - 3) {
+      throw Common::BadValueException
+	(FromHere(), "NEQFluxAD::setup() => wrong number of species");
+    }
+    
+    m_thermo.setup(library);
+    this->m_model.setModelData(&m_thermo);
+  }
+  
+private:
+  
+  /// species thermodynamic properties used by the variable set
+  Physics::NEQ::NEQLibraryThermo m_thermo;
+  
+}; // end of class NEQFluxAD
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FiniteVolume_NEQFluxAD_hh
@@ -48,6 +48,12 @@ public:
    */
   virtual void setup();
   
+  /**
+   * The mass production terms are computed cell by cell, together with the
+   * energy exchange terms which need the state set in the library
+   */
+  virtual void prepareComputeSource() {}
+  
   /**
    * Compute the source term
    */
@@ -0,0 +1,336 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test chemical NEQ flux jacobians by automatic differentiation"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Stopwatch.hh"
+#include "FiniteVolume/LaxFriedFluxT.hh"
+#include "FiniteVolume/RoeFluxT.hh"
+#include "FiniteVolume/StegerWarmingFluxT.hh"
+#include "NEQ/Euler2DNEQRhoivtT.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Numerics::FiniteVolume;
+using namespace COOLFluiD::Physics::NEQ;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Species energies e_i = cv0_i T + c_i T^2 + hf_i of a 5 species air mixture
+/// (N2, O2, NO, N, O), with a temperature dependent heat capacity
+class AnalyticThermo {
+public:
+
+  AnalyticThermo()
+  {
+    const CFreal Ru = 8.314472;
+    const CFreal mm[5] = {0.028, 0.032, 0.030, 0.014, 0.016};
+    const CFreal hf[5] = {0., 0., 3.0e6, 3.36e7, 1.54e7};
+    for (CFuint i = 0; i < 5; ++i) {
+      m_R[i] = Ru/mm[i];
+      m_cv0[i] = ((i < 3) ? 2.5 : 1.5)*m_R[i];
+      m_c[i] = ((i < 3) ? 1e-4 : 1e-5)*m_R[i];
+      m_hf[i] = hf[i];
+    }
+  }
+
+  CFreal getRspecies(CFuint i) const {return m_R[i];}
+
+  void computeEnergies(const CFreal* rhoi, CFreal temp,
+		       CFreal* e, CFreal* cv, CFreal* dcv) const
+  {
+    for (CFuint i = 0; i < 5; ++i) {
+      e[i] = (m_cv0[i] + m_c[i]*temp)*temp + m_hf[i];
+      cv[i] = m_cv0[i] + 2.*m_c[i]*temp;
+      dcv[i] = 2.*m_c[i];
+    }
+  }
+
+private:
+
+  CFreal m_R[5];
+  CFreal m_cv0[5];
+  CFreal m_c[5];
+  CFreal m_hf[5];
+};
+
+typedef Euler2DNEQRhoivtT<5, AnalyticThermo> NEQVarSet;
+
+typedef StegerWarmingFluxT<FVMCC_FluxSplitter> StegerWarmingFlux;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct NEQFluxAD_Fixture
+{
+  /// common setup for each test case
+  NEQFluxAD_Fixture() : diffCoeff(0.8), model(&thermo)
+  {
+    const CFreal stateL[8] = {2e-2, 4e-3, 1e-3, 5e-4, 2e-3, 500., 100., 3000.};
+    const CFreal stateR[8] = {1.5e-2, 2e-3, 2e-3, 1e-3, 3e-3, 350., -80., 4000.};
+    for (CFuint i = 0; i < 8; ++i) {
+      this->stateL[i] = stateL[i];
+      this->stateR[i] = stateR[i];
+    }
+    normal[0] = 0.6;
+    normal[1] = -0.8;
+  }
+
+  /// common tear-down for each test case
+  ~NEQFluxAD_Fixture() {}
+
+  /// Compare the jacobians given by the dual numbers with central finite
+  /// differences of the flux
+  /// @return the maximum relative difference
+  template <typename FLUX>
+  CFreal checkJacobians(const CFreal* stateL, const CFreal* stateR) const
+  {
+    const CFuint N = NEQVarSet::NBEQS;
+    typedef MathTools::DualNumber<2*NEQVarSet::NBEQS> DUAL;
+
+    DUAL dualL[NEQVarSet::NBEQS];
+    DUAL dualR[NEQVarSet::NBEQS];
+    DUAL dualFlux[NEQVarSet::NBEQS];
+    for (CFuint i = 0; i < N; ++i) {
+      dualL[i] = DUAL(stateL[i], i);
+      dualR[i] = DUAL(stateR[i], N + i);
+    }
+    CFreal maxEvL = 0.;
+    CFreal maxEvR = 0.;
+    FLUX::computeFlux(model, dualL, dualR, normal, diffCoeff, dualFlux, maxEvL, maxEvR);
+
+    CFreal flux[NEQVarSet::NBEQS];
+    CFreal evL = 0.;
+    CFreal evR = 0.;
+    FLUX::computeFlux(model, stateL, stateR, normal, diffCoeff, flux, evL, evR);
+    for (CFuint i = 0; i < N; ++i) {
+      BOOST_CHECK_EQUAL(dualFlux[i].value(), flux[i]);
+    }
+    BOOST_CHECK_EQUAL(maxEvL, evL);
+    BOOST_CHECK_EQUAL(maxEvR, evR);
+
+    // the derivatives are scaled by the size of the state components
+    CFreal maxErr = 0.;
+    CFreal state[2*NEQVarSet::NBEQS];
+    for (CFuint j = 0; j < 2*N; ++j) {
+      for (CFuint i = 0; i < N; ++i) {
+	state[i] = stateL[i];
+	state[N + i] = stateR[i];
+      }
+      const CFreal eps = 1e-5*std::abs(state[j]);
+      CFreal fluxP[NEQVarSet::NBEQS];
+      CFreal fluxM[NEQVarSet::NBEQS];
+      state[j] += eps;
+      FLUX::computeFlux(model, &state[0], &state[N], normal, diffCoeff, fluxP, evL, evR);
+      state[j] -= 2.*eps;
+      FLUX::computeFlux(model, &state[0], &state[N], normal, diffCoeff, fluxM, evL, evR);
+
+      for (CFuint i = 0; i < N; ++i) {
+	const CFreal fd = (fluxP[i] - fluxM[i])/(2.*eps);
+	const CFreal err = std::abs(dualFlux[i].der(j) - fd)/
+	  std::max(std::abs(fd), std::abs(flux[i]/state[j]));
+	BOOST_CHECK_SMALL(err, 1e-6);
+	maxErr = std::max(maxErr, err);
+      }
+    }
+    return maxErr;
+  }
+
+  /// Measure the time to compute the flux and both jacobians with dual
+  /// numbers and with forward finite differences
+  template <typename FLUX>
+  void timeJacobians(const std::string& name) const
+  {
+    const CFuint N = NEQVarSet::NBEQS;
+    const CFuint nbRuns = 5000;
+    typedef MathTools::DualNumber<2*NEQVarSet::NBEQS> DUAL;
+    CFreal maxEvL = 0.;
+    CFreal maxEvR = 0.;
+    CFreal sum = 0.;
+
+    Stopwatch<WallTime> timer;
+    timer.start();
+    for (CFuint r = 0; r < nbRuns; ++r) {
+      DUAL dualL[NEQVarSet::NBEQS];
+      DUAL dualR[NEQVarSet::NBEQS];
+      DUAL dualFlux[NEQVarSet::NBEQS];
+      for (CFuint i = 0; i < N; ++i) {
+	dualL[i] = DUAL(stateL[i], i);
+	dualR[i] = DUAL(stateR[i], N + i);
+      }
+      FLUX::computeFlux(model, dualL, dualR, normal, diffCoeff, dualFlux, maxEvL, maxEvR);
+      sum += dualFlux[r%N].der(r%(2*N));
+    }
+    timer.stop();
+    const CFreal timeAD = timer.read();
+
+    timer.start();
+    for (CFuint r = 0; r < nbRuns; ++r) {
+      CFreal state[2*NEQVarSet::NBEQS];
+      CFreal flux[NEQVarSet::NBEQS];
+      CFreal fluxP[NEQVarSet::NBEQS];
+      for (CFuint i = 0; i < N; ++i) {
+	state[i] = stateL[i];
+	state[N + i] = stateR[i];
+      }
+      FLUX::computeFlux(model, &state[0], &state[N], normal, diffCoeff, flux, maxEvL, maxEvR);
+      for (CFuint j = 0; j < 2*N; ++j) {
+	const CFreal eps = 1e-7*std::abs(state[j]);
+	state[j] += eps;
+	FLUX::computeFlux(model, &state[0], &state[N], normal, diffCoeff, fluxP, maxEvL, maxEvR);
+	state[j] -= eps;
+	sum += (fluxP[r%N] - flux[r%N])/eps;
+      }
+    }
+    timer.stop();
+    const CFreal timeFD = timer.read();
+
+    BOOST_CHECK(sum == sum);
+    BOOST_TEST_MESSAGE(name << ": flux + jacobians in " << 1e6*timeAD/nbRuns
+		       << " us with AD, " << 1e6*timeFD/nbRuns << " us with FD, ratio AD/FD = "
+		       << timeAD/timeFD);
+  }
+
+  /// species thermodynamics
+  AnalyticThermo thermo;
+
+  /// artificial diffusion reduction coefficient
+  CFreal diffCoeff;
+
+  /// variable set
+  NEQVarSet model;
+
+  /// left state
+  CFreal stateL[NEQVarSet::NBEQS];
+
+  /// right state
+  CFreal stateR[NEQVarSet::NBEQS];
+
+  /// unit normal
+  CFreal normal[2];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( NEQFluxAD_TestSuite, NEQFluxAD_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_consistency )
+{
+  CFreal data[NEQVarSet::DATASIZE];
+  CFreal physFlux[NEQVarSet::NBEQS];
+  CFreal fluxLF[NEQVarSet::NBEQS];
+  CFreal fluxRoe[NEQVarSet::NBEQS];
+  CFreal fluxSW[NEQVarSet::NBEQS];
+  CFreal maxEvL = 0.;
+  CFreal maxEvR = 0.;
+  model.computePhysicalData(stateL, data);
+  model.getFlux(data, normal, physFlux);
+  LaxFriedFluxT::computeFlux(model, stateL, stateL, normal, diffCoeff, fluxLF, maxEvL, maxEvR);
+  RoeFluxT<8>::computeFlux(model, stateL, stateL, normal, diffCoeff, fluxRoe, maxEvL, maxEvR);
+  StegerWarmingFlux::computeFlux(model, stateL, stateL, normal, diffCoeff, fluxSW, maxEvL, maxEvR);
+
+  for (CFuint i = 0; i < NEQVarSet::NBEQS; ++i) {
+    const CFreal tol = 1e-12*std::abs(physFlux[i]);
+    BOOST_CHECK_SMALL(fluxLF[i] - physFlux[i], tol);
+    BOOST_CHECK_SMALL(fluxRoe[i] - physFlux[i], tol);
+    // A*U = F only holds up to round-off on the energy of formation
+    BOOST_CHECK_SMALL(fluxSW[i] - physFlux[i], 1e-9*std::abs(physFlux[i]));
+  }
+
+  // the linearized state of two equal states is the state itself
+  CFreal avData[NEQVarSet::DATASIZE];
+  model.linearize(data, data, avData);
+  for (CFuint i = 0; i < NEQVarSet::DATASIZE; ++i) {
+    if (i < NEQVarSet::EULERTERM::VZ || i == NEQVarSet::EULERTERM::GAMMA ||
+	i >= NEQVarSet::Y) {
+      BOOST_CHECK_CLOSE(avData[i], data[i], 1e-10);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_eigenSystem )
+{
+  // R*Lambda*L*dU/dQ = dF/dQ, with Q the update variables
+  const CFuint N = NEQVarSet::NBEQS;
+  typedef MathTools::DualNumber<NEQVarSet::NBEQS> DUAL;
+
+  CFreal data[NEQVarSet::DATASIZE];
+  CFreal rightEv[N*N];
+  CFreal leftEv[N*N];
+  CFreal eValues[N];
+  model.computePhysicalData(stateL, data);
+  model.computeEigenValuesVectors(data, normal, rightEv, leftEv, eValues);
+
+  DUAL dualState[N];
+  DUAL dualData[NEQVarSet::DATASIZE];
+  DUAL dualFlux[N];
+  DUAL dualCons[N];
+  for (CFuint i = 0; i < N; ++i) {
+    dualState[i] = DUAL(stateL[i], i);
+  }
+  model.computePhysicalData(dualState, dualData);
+  model.getFlux(dualData, normal, dualFlux);
+  model.computeConsVariables(dualData, dualCons);
+
+  for (CFuint i = 0; i < N; ++i) {
+    for (CFuint j = 0; j < N; ++j) {
+      CFreal lr = 0.;
+      for (CFuint k = 0; k < N; ++k) {
+	lr += leftEv[i*N + k]*rightEv[k*N + j];
+      }
+      BOOST_CHECK_SMALL(lr - ((i == j) ? 1. : 0.), 1e-10);
+
+      CFreal adUdQ = 0.;
+      for (CFuint k = 0; k < N; ++k) {
+	CFreal a = 0.;
+	for (CFuint l = 0; l < N; ++l) {
+	  a += rightEv[i*N + l]*eValues[l]*leftEv[l*N + k];
+	}
+	adUdQ += a*dualCons[k].der(j);
+      }
+      const CFreal dFdQ = dualFlux[i].der(j);
+      BOOST_CHECK_SMALL(adUdQ - dFdQ, 1e-9*std::max(std::abs(dFdQ),
+						     std::abs(dualFlux[i].value()/stateL[j])));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_jacobians )
+{
+  const CFreal errLF = checkJacobians<LaxFriedFluxT>(stateL, stateR);
+  const CFreal errLFSwap = checkJacobians<LaxFriedFluxT>(stateR, stateL);
+  const CFreal errRoe = checkJacobians<RoeFluxT<8> >(stateL, stateR);
+  const CFreal errSW = checkJacobians<StegerWarmingFlux>(stateL, stateR);
+  BOOST_TEST_MESSAGE("NEQ5 max relative difference AD/FD: LaxFried " << errLF << " "
+		     << errLFSwap << ", Roe " << errRoe << ", StegerWarming " << errSW);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_timing )
+{
+  timeJacobians<LaxFriedFluxT>("LaxFriedNEQ5");
+  timeJacobians<RoeFluxT<8> >("RoeNEQ5");
+  timeJacobians<StegerWarmingFlux>("StegerWarmingNEQ5");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,12 @@ public:
    */
   virtual ~AUSMPlusFlux();
   
+  /**
+   * Tell if the flux can be computed concurrently by several copies of
+   * this splitter (it only works on the extrapolated physical data)
+   */
+  virtual bool isThreadSafe() const {return true;}
+  
   /**
    * Defines the Config Option's of this class
    * @param options a OptionList where to add the Option's
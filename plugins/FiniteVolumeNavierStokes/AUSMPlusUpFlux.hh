@@ -34,6 +34,12 @@ public:
    * Default destructor
    */
   virtual ~AUSMPlusUpFlux();
+  
+  /**
+   * Tell if the flux can be computed concurrently by several copies of
+   * this splitter (it only works on the extrapolated physical data)
+   */
+  virtual bool isThreadSafe() const {return true;}
 
   /**
    * Defines the Config Option's of this class
@@ -0,0 +1,70 @@
+#include "Framework/MethodStrategyProvider.hh"
+#include "FiniteVolume/FiniteVolume.hh"
+#include "FiniteVolume/LaxFriedFluxT.hh"
+#include "FiniteVolume/RoeFluxT.hh"
+#include "FiniteVolume/StegerWarmingFluxT.hh"
+#include "FiniteVolumeNavierStokes/FiniteVolumeNavierStokes.hh"
+#include "FiniteVolumeNavierStokes/EulerFluxAD.hh"
+#include "NavierStokes/Euler2DConsT.hh"
+#include "NavierStokes/Euler3DConsT.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Physics::NavierStokes;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodStrategyProvider<EulerFluxAD<Euler2DConsT, LaxFriedFluxT>,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNavierStokesModule>
+laxFriedFluxAD2DProvider("LaxFriedAD2D");
+
+MethodStrategyProvider<EulerFluxAD<Euler3DConsT, LaxFriedFluxT>,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNavierStokesModule>
+laxFriedFluxAD3DProvider("LaxFriedAD3D");
+
+MethodStrategyProvider<EulerFluxAD<Euler2DConsT, RoeFluxT<4> >,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNavierStokesModule>
+roeFluxAD2DProvider("RoeAD2D");
+
+MethodStrategyProvider<EulerFluxAD<Euler3DConsT, RoeFluxT<5> >,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNavierStokesModule>
+roeFluxAD3DProvider("RoeAD3D");
+
+MethodStrategyProvider<EulerFluxAD<Euler2DConsT, StegerWarmingFluxT<FVMCC_FluxSplitter> >,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNavierStokesModule>
+stegerWarmingFluxAD2DProvider("StegerWarmingAD2D");
+
+MethodStrategyProvider<EulerFluxAD<Euler3DConsT, StegerWarmingFluxT<FVMCC_FluxSplitter> >,
+		       CellCenterFVMData,
+		       FluxSplitter<CellCenterFVMData>,
+		       FiniteVolumeNavierStokesModule>
+stegerWarmingFluxAD3DProvider("StegerWarmingAD3D");
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
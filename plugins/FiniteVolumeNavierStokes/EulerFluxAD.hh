@@ -0,0 +1,81 @@
+#ifndef COOLFluiD_Numerics_FiniteVolume_EulerFluxAD_hh
+#define COOLFluiD_Numerics_FiniteVolume_EulerFluxAD_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "FiniteVolume/FluxSplitterAD.hh"
+#include "NavierStokes/EulerTerm.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace FiniteVolume {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class computes a flux corresponding to the Euler physical model in
+ * conservative variables (VS is Physics::NavierStokes::Euler2DConsT or
+ * Euler3DConsT) with exact jacobians by automatic differentiation.
+ *
+ */
+template <typename VS, typename FLUX>
+class EulerFluxAD : public FluxSplitterAD<VS, FLUX> {
+public:
+  
+  /**
+   * Constructor
+   */
+  EulerFluxAD(const std::string& name) : 
+    FluxSplitterAD<VS, FLUX>(name), 
+    m_dco() 
+  {
+  }
+  
+  /**
+   * Default destructor
+   */
+  virtual ~EulerFluxAD() 
+  {
+  }
+  
+  /**
+   * Set up private data
+   */
+  virtual void setup()
+  {
+    using namespace COOLFluiD::Framework;
+    
+    FluxSplitterAD<VS, FLUX>::setup();
+    
+    if (this->getMethodData().getUpdateVarStr() != "Cons") {
+      throw Common::BadValueException
+	(FromHere(), "EulerFluxAD::setup() => update variables must be Cons");
+    }
+    
+    PhysicalModelStack::getActive()->getImplementor()->getConvectiveTerm().
+      template d_castTo<Physics::NavierStokes::EulerTerm>()->copyConfigOptions(&m_dco);
+    this->m_model.setModelData(&m_dco);
+  }
+  
+private:
+  
+  /// gas constants used by the variable set
+  Physics::NavierStokes::EulerTerm::DeviceConfigOptions<NOTYPE> m_dco;
+  
+}; // end of class EulerFluxAD
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace FiniteVolume
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_FiniteVolume_EulerFluxAD_hh
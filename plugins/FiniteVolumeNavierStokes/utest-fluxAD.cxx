@@ -0,0 +1,345 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test Euler flux jacobians by automatic differentiation"
+
+#include <boost/test/unit_test.hpp>
+
+#include "Common/Stopwatch.hh"
+#include "FiniteVolume/LaxFriedFluxT.hh"
+#include "FiniteVolume/RoeFluxT.hh"
+#include "FiniteVolume/StegerWarmingFluxT.hh"
+#include "NavierStokes/Euler2DConsT.hh"
+#include "NavierStokes/Euler3DConsT.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Numerics::FiniteVolume;
+using namespace COOLFluiD::Physics::NavierStokes;
+
+using namespace boost::unit_test;
+
+typedef StegerWarmingFluxT<FVMCC_FluxSplitter> StegerWarmingFlux;
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct FluxAD_Fixture
+{
+  /// common setup for each test case
+  FluxAD_Fixture() : diffCoeff(0.8)
+  {
+    dco.gamma = 1.4;
+    dco.R = 287.046;
+    model2D.setModelData(&dco);
+    model3D.setModelData(&dco);
+  }
+
+  /// common tear-down for each test case
+  ~FluxAD_Fixture() {}
+
+  /// Fill a conservative state
+  template <int DIM>
+  void setState(CFreal rho, CFreal u, CFreal p, CFreal* state) const
+  {
+    state[0] = rho;
+    CFreal V2 = 0.;
+    for (CFuint iDim = 0; iDim < DIM; ++iDim) {
+      const CFreal ui = u*(1. + 0.3*iDim);
+      state[1+iDim] = rho*ui;
+      V2 += ui*ui;
+    }
+    state[DIM+1] = p/(dco.gamma - 1.) + 0.5*rho*V2;
+  }
+
+  /// Check that the numerical flux of two equal states is the physical flux
+  template <typename FLUX, typename VS>
+  void checkConsistency(const VS& model, const CFreal* state, const CFreal* normal) const
+  {
+    CFreal data[VS::DATASIZE];
+    CFreal physFlux[VS::NBEQS];
+    CFreal flux[VS::NBEQS];
+    CFreal maxEvL = 0.;
+    CFreal maxEvR = 0.;
+    model.computePhysicalData(state, data);
+    model.getFlux(data, normal, physFlux);
+    FLUX::computeFlux(model, state, state, normal, diffCoeff, flux, maxEvL, maxEvR);
+
+    for (CFuint i = 0; i < VS::NBEQS; ++i) {
+      BOOST_CHECK_SMALL(flux[i] - physFlux[i], 1e-12*std::max(std::abs(physFlux[i]), 1.));
+    }
+  }
+
+  /// Check that L*R = I and that R*Lambda*L is the jacobian of the physical
+  /// flux (computed with dual numbers)
+  template <typename VS>
+  void checkEigenSystem(const VS& model, const CFreal* state, const CFreal* normal) const
+  {
+    const CFuint N = VS::NBEQS;
+    typedef MathTools::DualNumber<VS::NBEQS> DUAL;
+
+    CFreal data[VS::DATASIZE];
+    CFreal rightEv[VS::NBEQS*VS::NBEQS];
+    CFreal leftEv[VS::NBEQS*VS::NBEQS];
+    CFreal eValues[VS::NBEQS];
+    model.computePhysicalData(state, data);
+    model.computeEigenValuesVectors(data, normal, rightEv, leftEv, eValues);
+
+    DUAL dualState[VS::NBEQS];
+    DUAL dualData[VS::DATASIZE];
+    DUAL dualFlux[VS::NBEQS];
+    for (CFuint i = 0; i < N; ++i) {
+      dualState[i] = DUAL(state[i], i);
+    }
+    model.computePhysicalData(dualState, dualData);
+    model.getFlux(dualData, normal, dualFlux);
+
+    for (CFuint i = 0; i < N; ++i) {
+      for (CFuint j = 0; j < N; ++j) {
+	CFreal lr = 0.;
+	CFreal a = 0.;
+	for (CFuint k = 0; k < N; ++k) {
+	  lr += leftEv[i*N + k]*rightEv[k*N + j];
+	  a  += rightEv[i*N + k]*eValues[k]*leftEv[k*N + j];
+	}
+	BOOST_CHECK_SMALL(lr - ((i == j) ? 1. : 0.), 1e-12);
+	BOOST_CHECK_SMALL(a - dualFlux[i].der(j), 1e-10*std::max(std::abs(a), 1.));
+      }
+    }
+  }
+
+  /// Compare the jacobians given by the dual numbers with central finite
+  /// differences of the flux
+  /// @return the maximum relative difference
+  template <typename FLUX, typename VS>
+  CFreal checkJacobians(const VS& model, const CFreal* stateL, const CFreal* stateR,
+			const CFreal* normal) const
+  {
+    const CFuint N = VS::NBEQS;
+    typedef MathTools::DualNumber<2*VS::NBEQS> DUAL;
+
+    DUAL dualL[VS::NBEQS];
+    DUAL dualR[VS::NBEQS];
+    DUAL dualFlux[VS::NBEQS];
+    for (CFuint i = 0; i < N; ++i) {
+      dualL[i] = DUAL(stateL[i], i);
+      dualR[i] = DUAL(stateR[i], N + i);
+    }
+    CFreal maxEvL = 0.;
+    CFreal maxEvR = 0.;
+    FLUX::computeFlux(model, dualL, dualR, normal, diffCoeff, dualFlux, maxEvL, maxEvR);
+
+    // the values must be the ones of the plain evaluation
+    CFreal flux[VS::NBEQS];
+    CFreal evL = 0.;
+    CFreal evR = 0.;
+    FLUX::computeFlux(model, stateL, stateR, normal, diffCoeff, flux, evL, evR);
+    for (CFuint i = 0; i < N; ++i) {
+      BOOST_CHECK_EQUAL(dualFlux[i].value(), flux[i]);
+    }
+    BOOST_CHECK_EQUAL(maxEvL, evL);
+    BOOST_CHECK_EQUAL(maxEvR, evR);
+
+    // derivative with respect to each component of both states
+    CFreal maxErr = 0.;
+    CFreal state[2*VS::NBEQS];
+    for (CFuint j = 0; j < 2*N; ++j) {
+      for (CFuint i = 0; i < N; ++i) {
+	state[i] = stateL[i];
+	state[N + i] = stateR[i];
+      }
+      const CFreal eps = 1e-5*std::max(std::abs(state[j]), 1.);
+      CFreal fluxP[VS::NBEQS];
+      CFreal fluxM[VS::NBEQS];
+      state[j] += eps;
+      FLUX::computeFlux(model, &state[0], &state[N], normal, diffCoeff, fluxP, evL, evR);
+      state[j] -= 2.*eps;
+      FLUX::computeFlux(model, &state[0], &state[N], normal, diffCoeff, fluxM, evL, evR);
+
+      for (CFuint i = 0; i < N; ++i) {
+	const CFreal fd = (fluxP[i] - fluxM[i])/(2.*eps);
+	const CFreal err = std::abs(dualFlux[i].der(j) - fd)/std::max(std::abs(fd), 1.);
+	BOOST_CHECK_SMALL(err, 1e-6);
+	maxErr = std::max(maxErr, err);
+      }
+    }
+    return maxErr;
+  }
+
+  /// Measure the time to compute the flux and both jacobians with dual
+  /// numbers and with forward finite differences (as NumJacob does)
+  template <typename FLUX, typename VS>
+  void timeJacobians(const std::string& name, const VS& model, const CFreal* stateL,
+		     const CFreal* stateR, const CFreal* normal) const
+  {
+    const CFuint N = VS::NBEQS;
+    const CFuint nbRuns = 20000;
+    typedef MathTools::DualNumber<2*VS::NBEQS> DUAL;
+    CFreal maxEvL = 0.;
+    CFreal maxEvR = 0.;
+    CFreal sum = 0.;
+
+    Stopwatch<WallTime> timer;
+    timer.start();
+    for (CFuint r = 0; r < nbRuns; ++r) {
+      DUAL dualL[VS::NBEQS];
+      DUAL dualR[VS::NBEQS];
+      DUAL dualFlux[VS::NBEQS];
+      for (CFuint i = 0; i < N; ++i) {
+	dualL[i] = DUAL(stateL[i], i);
+	dualR[i] = DUAL(stateR[i], N + i);
+      }
+      FLUX::computeFlux(model, dualL, dualR, normal, diffCoeff, dualFlux, maxEvL, maxEvR);
+      sum += dualFlux[r%N].der(r%(2*N));
+    }
+    timer.stop();
+    const CFreal timeAD = timer.read();
+
+    timer.start();
+    for (CFuint r = 0; r < nbRuns; ++r) {
+      CFreal state[2*VS::NBEQS];
+      CFreal flux[VS::NBEQS];
+      CFreal fluxP[VS::NBEQS];
+      for (CFuint i = 0; i < N; ++i) {
+	state[i] = stateL[i];
+	state[N + i] = stateR[i];
+      }
+      FLUX::computeFlux(model, &state[0], &state[N], normal, diffCoeff, flux, maxEvL, maxEvR);
+      for (CFuint j = 0; j < 2*N; ++j) {
+	const CFreal eps = 1e-7*std::max(std::abs(state[j]), 1.);
+	state[j] += eps;
+	FLUX::computeFlux(model, &state[0], &state[N], normal, diffCoeff, fluxP, maxEvL, maxEvR);
+	state[j] -= eps;
+	sum += (fluxP[r%N] - flux[r%N])/eps;
+      }
+    }
+    timer.stop();
+    const CFreal timeFD = timer.read();
+
+    BOOST_CHECK(sum == sum);
+    BOOST_TEST_MESSAGE(name << ": flux + jacobians in " << 1e6*timeAD/nbRuns
+		       << " us with AD, " << 1e6*timeFD/nbRuns << " us with FD, ratio AD/FD = "
+		       << timeAD/timeFD);
+  }
+
+  /// gas constants
+  EulerTerm::DeviceConfigOptions<NOTYPE> dco;
+
+  /// 2D variable set
+  Euler2DConsT model2D;
+
+  /// 3D variable set
+  Euler3DConsT model3D;
+
+  /// artificial diffusion reduction coefficient
+  CFreal diffCoeff;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( FluxAD_TestSuite, FluxAD_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_consistency )
+{
+  CFreal state2D[4];
+  setState<2>(1.2, 0.4, 0.9, state2D);
+  const CFreal normal2D[2] = {0.6, 0.8};
+  checkConsistency<LaxFriedFluxT>(model2D, state2D, normal2D);
+  checkConsistency<RoeFluxT<4> >(model2D, state2D, normal2D);
+  checkConsistency<StegerWarmingFlux>(model2D, state2D, normal2D);
+
+  CFreal state3D[5];
+  setState<3>(1.1, 0.3, 0.8, state3D);
+  const CFreal normal3D[3] = {0.48, 0.6, 0.64};
+  checkConsistency<LaxFriedFluxT>(model3D, state3D, normal3D);
+  checkConsistency<RoeFluxT<5> >(model3D, state3D, normal3D);
+  checkConsistency<StegerWarmingFlux>(model3D, state3D, normal3D);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_eigenSystem )
+{
+  CFreal state2D[4];
+  setState<2>(1.2, 0.4, 0.9, state2D);
+  const CFreal normal2D[2] = {0.6, -0.8};
+  checkEigenSystem(model2D, state2D, normal2D);
+
+  CFreal state3D[5];
+  setState<3>(1.1, 0.3, 0.8, state3D);
+  const CFreal normal3D[3] = {0.48, 0.6, 0.64};
+  checkEigenSystem(model3D, state3D, normal3D);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_jacobians2D )
+{
+  CFreal stateL[4];
+  CFreal stateR[4];
+  setState<2>(1.0, 0.5, 1.0, stateL);
+  setState<2>(0.7, -0.2, 0.6, stateR);
+  const CFreal normal[2] = {0.6, -0.8};
+
+  const CFreal errLF = checkJacobians<LaxFriedFluxT>(model2D, stateL, stateR, normal);
+  // the swapped states give the largest spectral radius on the other side
+  const CFreal errLFSwap = checkJacobians<LaxFriedFluxT>(model2D, stateR, stateL, normal);
+  const CFreal errRoe = checkJacobians<RoeFluxT<4> >(model2D, stateL, stateR, normal);
+  const CFreal errSW = checkJacobians<StegerWarmingFlux>(model2D, stateL, stateR, normal);
+  BOOST_TEST_MESSAGE("2D max relative difference AD/FD: LaxFried " << errLF << " "
+		     << errLFSwap << ", Roe " << errRoe << ", StegerWarming " << errSW);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_jacobians3D )
+{
+  CFreal stateL[5];
+  CFreal stateR[5];
+  setState<3>(1.1, 0.3, 0.8, stateL);
+  setState<3>(0.9, 0.6, 1.3, stateR);
+  const CFreal normal[3] = {0.48, 0.6, 0.64};
+
+  const CFreal errLF = checkJacobians<LaxFriedFluxT>(model3D, stateL, stateR, normal);
+  const CFreal errLFSwap = checkJacobians<LaxFriedFluxT>(model3D, stateR, stateL, normal);
+  const CFreal errRoe = checkJacobians<RoeFluxT<5> >(model3D, stateL, stateR, normal);
+  const CFreal errSW = checkJacobians<StegerWarmingFlux>(model3D, stateL, stateR, normal);
+  BOOST_TEST_MESSAGE("3D max relative difference AD/FD: LaxFried " << errLF << " "
+		     << errLFSwap << ", Roe " << errRoe << ", StegerWarming " << errSW);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_timing )
+{
+  CFreal stateL2D[4];
+  CFreal stateR2D[4];
+  setState<2>(1.0, 0.5, 1.0, stateL2D);
+  setState<2>(0.7, -0.2, 0.6, stateR2D);
+  const CFreal normal2D[2] = {0.6, -0.8};
+  timeJacobians<LaxFriedFluxT>("LaxFried2D", model2D, stateL2D, stateR2D, normal2D);
+  timeJacobians<RoeFluxT<4> >("Roe2D", model2D, stateL2D, stateR2D, normal2D);
+  timeJacobians<StegerWarmingFlux>("StegerWarming2D", model2D, stateL2D, stateR2D, normal2D);
+
+  CFreal stateL3D[5];
+  CFreal stateR3D[5];
+  setState<3>(1.1, 0.3, 0.8, stateL3D);
+  setState<3>(0.9, 0.6, 1.3, stateR3D);
+  const CFreal normal3D[3] = {0.48, 0.6, 0.64};
+  timeJacobians<LaxFriedFluxT>("LaxFried3D", model3D, stateL3D, stateR3D, normal3D);
+  timeJacobians<RoeFluxT<5> >("Roe3D", model3D, stateL3D, stateR3D, normal3D);
+  timeJacobians<StegerWarmingFlux>("StegerWarming3D", model3D, stateL3D, stateR3D, normal3D);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
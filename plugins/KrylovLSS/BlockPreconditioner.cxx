@@ -0,0 +1,329 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cmath>
+
+#include "Common/BadValueException.hh"
+#include "Common/StringOps.hh"
+#include "KrylovLSS/BlockPreconditioner.hh"
+#include "KrylovLSS/KrylovLSSMatrix.hh"
+
+using namespace std;
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// c = a*b for blocks of size nb
+template <typename TA, typename TB>
+static inline void blockMult(const CFuint nb, const TA* a, const TB* b, CFreal* c)
+{
+  for (CFuint i = 0; i < nb; ++i) {
+    for (CFuint j = 0; j < nb; ++j) {
+      CFreal sum = 0.;
+      for (CFuint k = 0; k < nb; ++k) {
+	sum += a[i*nb + k]*b[k*nb + j];
+      }
+      c[i*nb + j] = sum;
+    }
+  }
+}
+
+/// c -= a*b for blocks of size nb
+template <typename TB>
+static inline void blockMultSub(const CFuint nb, const CFreal* a, const TB* b, CFreal* c)
+{
+  for (CFuint i = 0; i < nb; ++i) {
+    for (CFuint k = 0; k < nb; ++k) {
+      const CFreal aik = a[i*nb + k];
+      for (CFuint j = 0; j < nb; ++j) {
+	c[i*nb + j] -= aik*b[k*nb + j];
+      }
+    }
+  }
+}
+
+/// y -= a*x for a block of size nb
+template <typename T>
+static inline void blockMatVecSub(const CFuint nb, const T* a, const CFreal* x, CFreal* y)
+{
+  for (CFuint i = 0; i < nb; ++i) {
+    CFreal sum = 0.;
+    for (CFuint j = 0; j < nb; ++j) {
+      sum += a[i*nb + j]*x[j];
+    }
+    y[i] -= sum;
+  }
+}
+
+/// y = a*x for a block of size nb
+template <typename T>
+static inline void blockMatVec(const CFuint nb, const T* a, const CFreal* x, CFreal* y)
+{
+  for (CFuint i = 0; i < nb; ++i) {
+    CFreal sum = 0.;
+    for (CFuint j = 0; j < nb; ++j) {
+      sum += a[i*nb + j]*x[j];
+    }
+    y[i] = sum;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BlockPreconditioner* BlockPreconditioner::create(const std::string& type,
+						 const bool singlePrecision)
+{
+  if (type == "None") return new IdentityPreconditioner();
+  if (type == "BlockJacobi") {
+    if (singlePrecision) return new BlockJacobiPreconditioner<float>();
+    return new BlockJacobiPreconditioner<CFreal>();
+  }
+  if (type == "ILU0") {
+    if (singlePrecision) return new BlockILU0Preconditioner<float>();
+    return new BlockILU0Preconditioner<CFreal>();
+  }
+
+  throw Common::BadValueException
+    (FromHere(), "BlockPreconditioner::create() => unknown preconditioner " + type +
+     " (available: None, BlockJacobi, ILU0)");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockPreconditioner::invertBlock(const CFuint nb, const CFreal* a, CFreal* inv,
+				      std::vector<CFreal>& work)
+{
+  const CFuint nb2 = nb*nb;
+  work.resize(nb2);
+  std::copy(a, a + nb2, work.begin());
+  CFreal *const m = &work[0];
+
+  for (CFuint i = 0; i < nb2; ++i) inv[i] = 0.;
+  for (CFuint i = 0; i < nb; ++i) inv[i*nb + i] = 1.;
+
+  for (CFuint k = 0; k < nb; ++k) {
+    // partial pivoting
+    CFuint p = k;
+    for (CFuint i = k+1; i < nb; ++i) {
+      if (std::abs(m[i*nb + k]) > std::abs(m[p*nb + k])) p = i;
+    }
+    if (m[p*nb + k] == 0.) {
+      throw Common::BadValueException
+	(FromHere(), "BlockPreconditioner::invertBlock() => singular block (column " +
+	 Common::StringOps::to_str(k) + ")");
+    }
+    if (p != k) {
+      for (CFuint j = 0; j < nb; ++j) {
+	std::swap(m[p*nb + j], m[k*nb + j]);
+	std::swap(inv[p*nb + j], inv[k*nb + j]);
+      }
+    }
+
+    const CFreal ovPivot = 1./m[k*nb + k];
+    for (CFuint j = 0; j < nb; ++j) {
+      m[k*nb + j] *= ovPivot;
+      inv[k*nb + j] *= ovPivot;
+    }
+
+    for (CFuint i = 0; i < nb; ++i) {
+      const CFreal f = m[i*nb + k];
+      if (i == k || f == 0.) continue;
+      for (CFuint j = 0; j < nb; ++j) {
+	m[i*nb + j] -= f*m[k*nb + j];
+	inv[i*nb + j] -= f*inv[k*nb + j];
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void IdentityPreconditioner::compute(const KrylovLSSMatrix& mat)
+{
+  m_size = mat.getNbRows()*mat.getBlockSize();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void IdentityPreconditioner::apply(const CFreal* r, CFreal* z) const
+{
+  std::copy(r, r + m_size, z);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void BlockJacobiPreconditioner<T>::compute(const KrylovLSSMatrix& mat)
+{
+  m_blockSize = mat.getBlockSize();
+  m_nbRows = mat.getNbRows();
+
+  const CFuint nb2 = m_blockSize*m_blockSize;
+  m_invDiag.resize(m_nbRows*nb2);
+
+  // the inversion is done in double precision, only the result is rounded
+  vector<CFreal> block(nb2);
+  vector<CFreal> inv(nb2);
+  const vector<CFuint>& diagSlot = mat.getDiagSlots();
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    mat.copyBlock(diagSlot[iRow], &block[0]);
+    invertBlock(m_blockSize, &block[0], &inv[0], m_work);
+    std::copy(inv.begin(), inv.end(), m_invDiag.begin() + iRow*nb2);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void BlockJacobiPreconditioner<T>::apply(const CFreal* r, CFreal* z) const
+{
+  const CFuint nb = m_blockSize;
+  const CFuint nb2 = nb*nb;
+  const CFint nbRows = static_cast<CFint>(m_nbRows);
+
+#ifdef CF_HAVE_OMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (CFint iRow = 0; iRow < nbRows; ++iRow) {
+    blockMatVec(nb, &m_invDiag[iRow*nb2], &r[iRow*nb], &z[iRow*nb]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void BlockILU0Preconditioner<T>::createPattern(const KrylovLSSMatrix& mat)
+{
+  m_blockSize = mat.getBlockSize();
+  m_nbRows = mat.getNbRows();
+
+  const vector<CFuint>& rowPtr = mat.getRowPtr();
+  const vector<CFuint>& colIdx = mat.getColIdx();
+
+  // only the columns of the owned states are kept
+  m_rowPtr.resize(m_nbRows+1);
+  m_diagSlot.resize(m_nbRows);
+  m_colIdx.clear();
+  m_matSlot.clear();
+  m_rowPtr[0] = 0;
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    for (CFuint k = rowPtr[iRow]; k < rowPtr[iRow+1]; ++k) {
+      if (colIdx[k] < m_nbRows) {
+	if (colIdx[k] == iRow) m_diagSlot[iRow] = m_colIdx.size();
+	m_colIdx.push_back(colIdx[k]);
+	m_matSlot.push_back(k);
+      }
+    }
+    m_rowPtr[iRow+1] = m_colIdx.size();
+  }
+
+  const CFuint nb2 = m_blockSize*m_blockSize;
+  m_lu.resize(m_colIdx.size()*nb2);
+  m_invDiag.resize(m_nbRows*nb2);
+  m_work.resize(nb2);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void BlockILU0Preconditioner<T>::compute(const KrylovLSSMatrix& mat)
+{
+  // the pattern of the matrix does not change between two solves
+  if (m_nbRows != mat.getNbRows() || m_blockSize != mat.getBlockSize() ||
+      m_matSlot.empty()) {
+    createPattern(mat);
+  }
+
+  const CFuint nb = m_blockSize;
+  const CFuint nb2 = nb*nb;
+
+  // position of the columns in the current row (-1 if not in the row)
+  vector<CFint> pos(m_nbRows, -1);
+  vector<CFreal> row;
+  vector<CFreal> lij(nb2);
+  vector<CFreal> inv(nb2);
+  vector<CFreal> work;
+
+  // IKJ variant of the factorization, restricted to the pattern of the matrix:
+  // each row is computed in double precision from the rows above it and
+  // stored in the type T once complete
+  for (CFuint i = 0; i < m_nbRows; ++i) {
+    const CFuint start = m_rowPtr[i];
+    row.resize((m_rowPtr[i+1] - start)*nb2);
+    for (CFuint k = start; k < m_rowPtr[i+1]; ++k) {
+      mat.copyBlock(m_matSlot[k], &row[(k - start)*nb2]);
+      pos[m_colIdx[k]] = k - start;
+    }
+
+    for (CFuint k = start; k < m_diagSlot[i]; ++k) {
+      const CFuint j = m_colIdx[k];
+      CFreal *const rowBlock = &row[(k - start)*nb2];
+      // L_ij = A_ij*inv(U_jj)
+      blockMult(nb, rowBlock, &m_invDiag[j*nb2], &lij[0]);
+      std::copy(lij.begin(), lij.end(), rowBlock);
+
+      for (CFuint m = m_diagSlot[j]+1; m < m_rowPtr[j+1]; ++m) {
+	const CFint p = pos[m_colIdx[m]];
+	if (p >= 0) {
+	  blockMultSub(nb, &lij[0], &m_lu[m*nb2], &row[p*nb2]);
+	}
+      }
+    }
+
+    invertBlock(nb, &row[(m_diagSlot[i] - start)*nb2], &inv[0], work);
+    std::copy(inv.begin(), inv.end(), m_invDiag.begin() + i*nb2);
+    std::copy(row.begin(), row.end(), m_lu.begin() + start*nb2);
+
+    for (CFuint k = start; k < m_rowPtr[i+1]; ++k) {
+      pos[m_colIdx[k]] = -1;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void BlockILU0Preconditioner<T>::apply(const CFreal* r, CFreal* z) const
+{
+  const CFuint nb = m_blockSize;
+  const CFuint nb2 = nb*nb;
+
+  // forward substitution with the unit lower triangle
+  for (CFuint i = 0; i < m_nbRows; ++i) {
+    CFreal *const zi = &z[i*nb];
+    std::copy(&r[i*nb], &r[i*nb] + nb, zi);
+    for (CFuint k = m_rowPtr[i]; k < m_diagSlot[i]; ++k) {
+      blockMatVecSub(nb, &m_lu[k*nb2], &z[m_colIdx[k]*nb], zi);
+    }
+  }
+
+  // backward substitution with the upper triangle
+  CFreal *const t = &m_work[0];
+  for (CFuint i = m_nbRows; i > 0; --i) {
+    const CFuint iRow = i-1;
+    CFreal *const zi = &z[iRow*nb];
+    std::copy(zi, zi + nb, t);
+    for (CFuint k = m_diagSlot[iRow]+1; k < m_rowPtr[iRow+1]; ++k) {
+      blockMatVecSub(nb, &m_lu[k*nb2], &z[m_colIdx[k]*nb], t);
+    }
+    blockMatVec(nb, &m_invDiag[iRow*nb2], t, zi);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template class BlockJacobiPreconditioner<CFreal>;
+template class BlockJacobiPreconditioner<float>;
+template class BlockILU0Preconditioner<CFreal>;
+template class BlockILU0Preconditioner<float>;
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
@@ -0,0 +1,174 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_BlockPreconditioner_hh
+#define COOLFluiD_KrylovLSS_BlockPreconditioner_hh
+
+#include <string>
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+    class KrylovLSSMatrix;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a preconditioner for the KrylovLSS solver, acting
+/// on the rows owned by this process only (the couplings with the ghost
+/// states are neglected, giving a block Jacobi preconditioner across the
+/// processes).
+/// The factors can be stored in single precision (float) while the vectors
+/// and all the accumulations stay in double precision.
+class BlockPreconditioner {
+public:
+
+  /// Create the preconditioner of the given type
+  /// @param type             "None", "BlockJacobi" or "ILU0"
+  /// @param singlePrecision  store the factors in single precision
+  /// @throw Common::BadValueException if the type is unknown
+  static BlockPreconditioner* create(const std::string& type,
+				     const bool singlePrecision = false);
+
+  /// Destructor
+  virtual ~BlockPreconditioner() {}
+
+  /// Compute the preconditioner from the given matrix
+  virtual void compute(const KrylovLSSMatrix& mat) = 0;
+
+  /// Apply the preconditioner: z = M^-1 r
+  /// @param r  array of size mat.getNbRows()*mat.getBlockSize()
+  /// @param z  array of the same size, different from r
+  virtual void apply(const CFreal* r, CFreal* z) const = 0;
+
+protected:
+
+  /// Invert a block of size nb (Gauss-Jordan elimination with partial pivoting)
+  /// @throw Common::BadValueException if the block is singular
+  static void invertBlock(const CFuint nb, const CFreal* a, CFreal* inv,
+			  std::vector<CFreal>& work);
+
+}; // end of class BlockPreconditioner
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents the identity preconditioner
+class IdentityPreconditioner : public BlockPreconditioner {
+public:
+
+  /// Constructor
+  IdentityPreconditioner() : m_size(0) {}
+
+  /// Compute the preconditioner (nothing to do)
+  void compute(const KrylovLSSMatrix& mat);
+
+  /// Apply the preconditioner: z = r
+  void apply(const CFreal* r, CFreal* z) const;
+
+private:
+
+  /// size of the arrays
+  CFuint m_size;
+
+}; // end of class IdentityPreconditioner
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a block Jacobi preconditioner, storing the
+/// inverse of the diagonal blocks in the type T (CFreal or float)
+template <typename T>
+class BlockJacobiPreconditioner : public BlockPreconditioner {
+public:
+
+  /// Constructor
+  BlockJacobiPreconditioner() : m_blockSize(0), m_nbRows(0) {}
+
+  /// Compute the inverse of the diagonal blocks
+  void compute(const KrylovLSSMatrix& mat);
+
+  /// Apply the preconditioner
+  void apply(const CFreal* r, CFreal* z) const;
+
+private:
+
+  /// size of the blocks
+  CFuint m_blockSize;
+
+  /// number of block rows
+  CFuint m_nbRows;
+
+  /// inverse of the diagonal blocks
+  std::vector<T> m_invDiag;
+
+  /// workspace for the block inversion
+  std::vector<CFreal> m_work;
+
+}; // end of class BlockJacobiPreconditioner
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a block incomplete LU factorization with the same
+/// pattern as the matrix (ILU(0)). The strictly lower blocks store L (with
+/// unit diagonal), the upper blocks store U and the inverse of the diagonal
+/// blocks of U is kept apart. The factors are stored in the type T (CFreal
+/// or float), each row being factorized in double precision.
+template <typename T>
+class BlockILU0Preconditioner : public BlockPreconditioner {
+public:
+
+  /// Constructor
+  BlockILU0Preconditioner() : m_blockSize(0), m_nbRows(0) {}
+
+  /// Factorize the matrix
+  void compute(const KrylovLSSMatrix& mat);
+
+  /// Apply the preconditioner (forward and backward substitution)
+  void apply(const CFreal* r, CFreal* z) const;
+
+private:
+
+  /// Extract the pattern of the owned columns from the matrix
+  void createPattern(const KrylovLSSMatrix& mat);
+
+private:
+
+  /// size of the blocks
+  CFuint m_blockSize;
+
+  /// number of block rows
+  CFuint m_nbRows;
+
+  /// first slot of each row
+  std::vector<CFuint> m_rowPtr;
+
+  /// column of each slot
+  std::vector<CFuint> m_colIdx;
+
+  /// slot of the diagonal block of each row
+  std::vector<CFuint> m_diagSlot;
+
+  /// slot of each block in the matrix
+  std::vector<CFuint> m_matSlot;
+
+  /// factorized blocks
+  std::vector<T> m_lu;
+
+  /// inverse of the diagonal blocks of U
+  std::vector<T> m_invDiag;
+
+  /// workspace for the block operations
+  mutable std::vector<CFreal> m_work;
+
+}; // end of class BlockILU0Preconditioner
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_BlockPreconditioner_hh
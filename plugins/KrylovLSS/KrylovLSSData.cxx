@@ -0,0 +1,279 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/PE.hh"
+#include "Common/BadValueException.hh"
+#include "Framework/MethodCommandProvider.hh"
+
+#ifdef CF_HAVE_MPI
+#include "Common/MPI/MPIError.hh"
+#include "Common/MPI/MPIStructDef.hh"
+#endif
+
+#include "KrylovLSS/KrylovLSSData.hh"
+#include "KrylovLSS/KrylovLSSModule.hh"
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider< NullMethodCommand< KrylovLSSData >, KrylovLSSData,
+  KrylovLSSModule > nullKrylovLSSComProvider("Null");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSData::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< std::string >("KSPType","Krylov solver type (GMRES or BiCGStab).");
+  options.addConfigOption< std::string >("PCType","Preconditioner type (ILU0, BlockJacobi or None).");
+  options.addConfigOption< CFreal >("RelativeTolerance","Relative tolerance for control of iterative solver convergence.");
+  options.addConfigOption< CFreal >("AbsoluteTolerance","Absolute tolerance for control of iterative solver convergence.");
+  options.addConfigOption< CFuint >("NbKrylovSpaces","Number of Krylov spaces (GMRES restart).");
+  options.addConfigOption< CFuint >("NbThreads","Number of threads in the matrix-vector product (if OpenMP is enabled).");
+  options.addConfigOption< bool >("SinglePrecisionMatrix","Store the jacobian matrix in single precision (the Krylov vectors stay in double precision).");
+  options.addConfigOption< bool >("SinglePrecisionPC","Store the preconditioner factors in single precision (the Krylov vectors stay in double precision).");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovLSSData::KrylovLSSData(SafePtr< std::valarray< bool > > maskArray,
+			     CFuint& nbSysEquations,
+			     SafePtr< Framework::Method > owner) :
+  LSSData(maskArray,nbSysEquations,owner),
+  m_mat(),
+  m_sol(),
+  m_rhs(),
+  m_pc(),
+  m_nbStates(0),
+  m_nbLocalStates(0),
+  m_sendRanks(),
+  m_sendIDs(),
+  m_recvRanks(),
+  m_recvIDs(),
+  m_sendBuf(),
+  m_recvBuf()
+{
+  addConfigOptionsTo(this);
+
+  m_kspTypeStr = "GMRES";
+  setParameter("KSPType",&m_kspTypeStr);
+
+  m_pcTypeStr = "ILU0";
+  setParameter("PCType",&m_pcTypeStr);
+
+  m_rTol = 1e-5;
+  setParameter("RelativeTolerance",&m_rTol);
+
+  m_aTol = 1e-30;
+  setParameter("AbsoluteTolerance",&m_aTol);
+
+  m_nbKsp = 30;
+  setParameter("NbKrylovSpaces",&m_nbKsp);
+
+  m_nbThreads = 1;
+  setParameter("NbThreads",&m_nbThreads);
+
+  m_singlePrecisionMatrix = false;
+  setParameter("SinglePrecisionMatrix",&m_singlePrecisionMatrix);
+
+  m_singlePrecisionPC = false;
+  setParameter("SinglePrecisionPC",&m_singlePrecisionPC);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovLSSData::~KrylovLSSData()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSData::configure(Config::ConfigArgs& args)
+{
+  LSSData::configure(args);
+
+  if (m_kspTypeStr != "GMRES" && m_kspTypeStr != "BiCGStab") {
+    throw BadValueException
+      (FromHere(), "KrylovLSSData::configure() => unknown KSPType " + m_kspTypeStr +
+       " (available: GMRES, BiCGStab)");
+  }
+
+  if (m_nbKsp == 0) {
+    throw BadValueException(FromHere(), "KrylovLSSData::configure() => NbKrylovSpaces must be > 0");
+  }
+
+  m_pc.reset(BlockPreconditioner::create(m_pcTypeStr, m_singlePrecisionPC));
+  m_mat.setNbThreads(std::max<CFuint>(m_nbThreads, 1));
+  m_mat.setSinglePrecision(m_singlePrecisionMatrix);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSData::printToFile(const std::string& prefix, const std::string& suffix)
+{
+  CFAUTOTRACE;
+  std::string matStr = prefix + "mat" + suffix;
+  std::string rhsStr = prefix + "rhs" + suffix;
+  std::string solStr = prefix + "sol" + suffix;
+
+  m_mat.printToFile(matStr.c_str());
+  m_rhs.printToFile(rhsStr.c_str());
+  m_sol.printToFile(solStr.c_str());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSData::setGhostLists(const vector< vector<CFuint> >& sendList,
+				  const vector< vector<CFuint> >& recvList)
+{
+  cf_assert(sendList.size() == recvList.size());
+
+  const LSSIdxMapping& mapping = getLocalToGlobalMapping();
+  const CFuint nbEqs = getNbSysEquations();
+
+  m_sendRanks.clear();
+  m_sendIDs.clear();
+  m_recvRanks.clear();
+  m_recvIDs.clear();
+
+  // the states are sent and received in the order of the lists, which is
+  // the same on both sides
+  for (CFuint rank = 0; rank < sendList.size(); ++rank) {
+    if (!sendList[rank].empty()) {
+      m_sendRanks.push_back(rank);
+      m_sendIDs.push_back(vector<CFuint>(sendList[rank].size()));
+      for (CFuint i = 0; i < sendList[rank].size(); ++i) {
+	m_sendIDs.back()[i] = mapping.getColID(sendList[rank][i]);
+      }
+    }
+
+    if (!recvList[rank].empty()) {
+      m_recvRanks.push_back(rank);
+      m_recvIDs.push_back(vector<CFuint>(recvList[rank].size()));
+      for (CFuint i = 0; i < recvList[rank].size(); ++i) {
+	m_recvIDs.back()[i] = mapping.getColID(recvList[rank][i]);
+      }
+    }
+  }
+
+  m_sendBuf.resize(m_sendIDs.size());
+  for (CFuint i = 0; i < m_sendIDs.size(); ++i) {
+    m_sendBuf[i].resize(m_sendIDs[i].size()*nbEqs);
+  }
+
+  m_recvBuf.resize(m_recvIDs.size());
+  for (CFuint i = 0; i < m_recvIDs.size(); ++i) {
+    m_recvBuf[i].resize(m_recvIDs[i].size()*nbEqs);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSData::synchronize(CFreal* x)
+{
+#ifdef CF_HAVE_MPI
+  if (m_sendRanks.empty() && m_recvRanks.empty()) return;
+
+  const CFuint nbEqs = getNbSysEquations();
+  const std::string nsp = getNamespace();
+  MPI_Comm comm = PE::GetPE().GetCommunicator(nsp);
+  const int tag = 0;
+
+  vector<MPI_Request> requests(m_sendRanks.size() + m_recvRanks.size());
+  CFuint iReq = 0;
+
+  for (CFuint i = 0; i < m_recvRanks.size(); ++i, ++iReq) {
+    MPIError::getInstance().check
+      ("MPI_Irecv", "KrylovLSSData::synchronize()",
+       MPI_Irecv(&m_recvBuf[i][0], m_recvBuf[i].size(), MPIStructDef::getMPIType(&m_recvBuf[i][0]),
+		 m_recvRanks[i], tag, comm, &requests[iReq]));
+  }
+
+  for (CFuint i = 0; i < m_sendRanks.size(); ++i, ++iReq) {
+    const vector<CFuint>& ids = m_sendIDs[i];
+    CFreal* buf = &m_sendBuf[i][0];
+    for (CFuint s = 0; s < ids.size(); ++s) {
+      const CFreal *const xs = &x[ids[s]*nbEqs];
+      for (CFuint e = 0; e < nbEqs; ++e, ++buf) {
+	*buf = xs[e];
+      }
+    }
+
+    MPIError::getInstance().check
+      ("MPI_Isend", "KrylovLSSData::synchronize()",
+       MPI_Isend(&m_sendBuf[i][0], m_sendBuf[i].size(), MPIStructDef::getMPIType(&m_sendBuf[i][0]),
+		 m_sendRanks[i], tag, comm, &requests[iReq]));
+  }
+
+  MPIError::getInstance().check
+    ("MPI_Waitall", "KrylovLSSData::synchronize()",
+     MPI_Waitall(requests.size(), &requests[0], MPI_STATUSES_IGNORE));
+
+  for (CFuint i = 0; i < m_recvRanks.size(); ++i) {
+    const vector<CFuint>& ids = m_recvIDs[i];
+    const CFreal* buf = &m_recvBuf[i][0];
+    for (CFuint s = 0; s < ids.size(); ++s) {
+      CFreal *const xs = &x[ids[s]*nbEqs];
+      for (CFuint e = 0; e < nbEqs; ++e, ++buf) {
+	xs[e] = *buf;
+      }
+    }
+  }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal KrylovLSSData::dot(const CFreal* a, const CFreal* b) const
+{
+  const CFint size = static_cast<CFint>(m_nbLocalStates*getNbSysEquations());
+  CFreal localSum = 0.;
+#ifdef CF_HAVE_OMP
+#pragma omp parallel for num_threads(m_nbThreads) reduction(+:localSum) schedule(static)
+#endif
+  for (CFint i = 0; i < size; ++i) {
+    localSum += a[i]*b[i];
+  }
+
+#ifdef CF_HAVE_MPI
+  if (PE::GetPE().IsParallel()) {
+    const std::string nsp = getNamespace();
+    CFreal sum = 0.;
+    MPIError::getInstance().check
+      ("MPI_Allreduce", "KrylovLSSData::dot()",
+       MPI_Allreduce(&localSum, &sum, 1, MPIStructDef::getMPIType(&localSum), MPI_SUM,
+		     PE::GetPE().GetCommunicator(nsp)));
+    return sum;
+  }
+#endif
+
+  return localSum;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSData::clear()
+{
+  m_mat.destroy();
+  m_sol.destroy();
+  m_rhs.destroy();
+  m_sendRanks.clear();
+  m_sendIDs.clear();
+  m_recvRanks.clear();
+  m_recvIDs.clear();
+  m_sendBuf.clear();
+  m_recvBuf.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
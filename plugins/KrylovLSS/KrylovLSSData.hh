@@ -0,0 +1,205 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_KrylovLSSData_hh
+#define COOLFluiD_KrylovLSS_KrylovLSSData_hh
+
+#include <memory>
+
+#include "Framework/LSSData.hh"
+#include "KrylovLSS/KrylovLSSMatrix.hh"
+#include "KrylovLSS/KrylovLSSVector.hh"
+#include "KrylovLSS/BlockPreconditioner.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This is a data object accessed by KrylovLSSComs
+class KrylovLSSData : public Framework::LSSData
+{
+
+ public:  // methods
+
+  /**
+   * Defines the Config Option's of this class
+   * @param options a OptionList where to add the options
+   */
+  static void defineConfigOptions(Config::OptionList& options);
+
+  /// Default constructor without arguments
+  KrylovLSSData(Common::SafePtr< std::valarray< bool > > maskArray,
+		CFuint& nbSysEquations,
+		Common::SafePtr<Framework::Method> owner);
+
+  /// Destructor
+  ~KrylovLSSData();
+
+  /// Configure the data from the supplied arguments
+  virtual void configure ( Config::ConfigArgs& args );
+
+  /// Get the class name
+  static std::string getClassName() {
+    return "KrylovLSS";
+  }
+
+  /// Get the KrylovLSSMatrix
+  KrylovLSSMatrix& getMatrix() {
+    return m_mat;
+  }
+
+  /// Get the KrylovLSSVector for the solution
+  KrylovLSSVector& getSolVector() {
+    return m_sol;
+  }
+
+  /// Get the KrylovLSSVector for the RHS
+  KrylovLSSVector& getRhsVector() {
+    return m_rhs;
+  }
+
+  /// Get the preconditioner
+  BlockPreconditioner& getPreconditioner() {
+    cf_assert(m_pc.get() != CFNULL);
+    return *m_pc;
+  }
+
+  /// Prints the Linear System to a file
+  void printToFile(const std::string& prefix, const std::string& suffix);
+
+  /// Get the name of the Krylov method ("GMRES" or "BiCGStab")
+  const std::string& getKSPType() const {
+    return m_kspTypeStr;
+  }
+
+  /// Get the relative tolerance on the residual
+  CFreal getRelativeTolerance() const {
+    return m_rTol;
+  }
+
+  /// Get the absolute tolerance on the residual
+  CFreal getAbsoluteTolerance() const {
+    return m_aTol;
+  }
+
+  /// Get the number of Krylov vectors before restarting GMRES
+  CFuint getNbKrylovSpaces() const {
+    return m_nbKsp;
+  }
+
+  /// Set the number of local states (updatable + ghost) and of updatable states
+  void setNbStates(CFuint nbStates, CFuint nbLocalStates) {
+    m_nbStates = nbStates;
+    m_nbLocalStates = nbLocalStates;
+  }
+
+  /// Get the number of local states (updatable + ghost)
+  CFuint getNbStates() const {
+    return m_nbStates;
+  }
+
+  /// Get the number of updatable states
+  CFuint getNbLocalStates() const {
+    return m_nbLocalStates;
+  }
+
+  /// Set the lists of the states to send to and to receive from each process
+  /// @param sendList  local IDs of the states to send to each process
+  /// @param recvList  local IDs of the ghost states received from each process
+  /// @pre the local to global LSS mapping has been created
+  void setGhostLists(const std::vector< std::vector<CFuint> >& sendList,
+		     const std::vector< std::vector<CFuint> >& recvList);
+
+  /// Update the entries of the ghost states in the given array
+  /// @param x  array of getNbStates() blocks in LSS numbering
+  void synchronize(CFreal* x);
+
+  /// @return the scalar product of two arrays over the updatable states of
+  ///         all the processes
+  CFreal dot(const CFreal* a, const CFreal* b) const;
+
+  /// Release the storage of the system
+  void clear();
+
+ private:  // data
+
+  /// System matrix
+  KrylovLSSMatrix m_mat;
+
+  /// System solution vector
+  KrylovLSSVector m_sol;
+
+  /// System right hand side (RHS) vector
+  KrylovLSSVector m_rhs;
+
+  /// preconditioner
+  std::auto_ptr<BlockPreconditioner> m_pc;
+
+  /// number of local states (updatable + ghost)
+  CFuint m_nbStates;
+
+  /// number of updatable states
+  CFuint m_nbLocalStates;
+
+  /// ranks of the processes to which states are sent
+  std::vector<int> m_sendRanks;
+
+  /// LSS IDs of the states sent to each process
+  std::vector< std::vector<CFuint> > m_sendIDs;
+
+  /// ranks of the processes from which ghost states are received
+  std::vector<int> m_recvRanks;
+
+  /// LSS IDs of the ghost states received from each process
+  std::vector< std::vector<CFuint> > m_recvIDs;
+
+  /// buffers for the states sent to each process
+  std::vector< std::vector<CFreal> > m_sendBuf;
+
+  /// buffers for the ghost states received from each process
+  std::vector< std::vector<CFreal> > m_recvBuf;
+
+  /// Krylov method (configurable)
+  std::string m_kspTypeStr;
+
+  /// preconditioner type (configurable)
+  std::string m_pcTypeStr;
+
+  /// relative tolerance (configurable)
+  CFreal m_rTol;
+
+  /// absolute tolerance (configurable)
+  CFreal m_aTol;
+
+  /// number of Krylov vectors before restarting GMRES (configurable)
+  CFuint m_nbKsp;
+
+  /// number of threads of the matrix-vector product (configurable)
+  CFuint m_nbThreads;
+
+  /// store the matrix in single precision (configurable)
+  bool m_singlePrecisionMatrix;
+
+  /// store the preconditioner factors in single precision (configurable)
+  bool m_singlePrecisionPC;
+
+}; // end of class KrylovLSSData
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Definition of a command for KrylovLSS
+typedef Framework::MethodCommand< KrylovLSSData > KrylovLSSCom;
+
+/// Definition of a command provider for KrylovLSS
+typedef Framework::MethodCommand< KrylovLSSData >::PROVIDER KrylovLSSComProvider;
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_KrylovLSSData_hh
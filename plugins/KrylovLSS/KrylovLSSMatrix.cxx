@@ -0,0 +1,460 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <fstream>
+
+#include "Common/BadValueException.hh"
+#include "Common/CFLog.hh"
+#include "Common/NotImplementedException.hh"
+#include "Common/StringOps.hh"
+#include "Framework/BlockAccumulator.hh"
+#include "KrylovLSS/KrylovLSSMatrix.hh"
+#include "KrylovLSS/KrylovLSSVector.hh"
+
+#ifdef CF_HAVE_OMP
+#include <omp.h>
+#endif
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// y = A*x for a BSR matrix with blocks of size nb stored in the type T
+template <typename T>
+static void bsrMultiply(const CFint nbRows, const CFuint nb, const CFuint nbThreads,
+			const vector<CFuint>& rowPtr, const vector<CFuint>& colIdx,
+			const T* values, const CFreal* x, CFreal* y)
+{
+  const CFuint nb2 = nb*nb;
+
+  // each thread computes a contiguous range of rows: no synchronization is needed
+#ifdef CF_HAVE_OMP
+#pragma omp parallel for num_threads(nbThreads) schedule(static)
+#endif
+  for (CFint iRow = 0; iRow < nbRows; ++iRow) {
+    CFreal *const yRow = &y[iRow*nb];
+    for (CFuint ib = 0; ib < nb; ++ib) {
+      yRow[ib] = 0.;
+    }
+
+    for (CFuint k = rowPtr[iRow]; k < rowPtr[iRow+1]; ++k) {
+      const T *const block = &values[k*nb2];
+      const CFreal *const xCol = &x[colIdx[k]*nb];
+      for (CFuint ib = 0; ib < nb; ++ib) {
+	CFreal sum = 0.;
+	for (CFuint jb = 0; jb < nb; ++jb) {
+	  sum += block[ib*nb + jb]*xCol[jb];
+	}
+	yRow[ib] += sum;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovLSSMatrix::KrylovLSSMatrix() :
+  LSSMatrix(),
+  m_blockSize(0),
+  m_blockSize2(0),
+  m_nbRows(0),
+  m_nbCols(0),
+  m_rowPtr(),
+  m_colIdx(),
+  m_diagSlot(),
+  m_singlePrecision(false),
+  m_values(),
+  m_valuesSP(),
+  m_nbThreads(1),
+  m_nbIgnored(0),
+  m_firstIgnoredRow(0),
+  m_firstIgnoredCol(0)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovLSSMatrix::~KrylovLSSMatrix()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::createPattern(const CFuint blockSize, const CFuint nbCols,
+				    const vector< vector<CFuint> >& pattern)
+{
+  m_blockSize  = blockSize;
+  m_blockSize2 = blockSize*blockSize;
+  m_nbRows     = pattern.size();
+  m_nbCols     = nbCols;
+
+  m_rowPtr.resize(m_nbRows+1);
+  m_rowPtr[0] = 0;
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    m_rowPtr[iRow+1] = m_rowPtr[iRow] + pattern[iRow].size();
+  }
+
+  m_colIdx.resize(m_rowPtr[m_nbRows]);
+  m_diagSlot.resize(m_nbRows);
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    const CFuint start = m_rowPtr[iRow];
+    std::copy(pattern[iRow].begin(), pattern[iRow].end(), m_colIdx.begin() + start);
+    std::sort(m_colIdx.begin() + start, m_colIdx.begin() + m_rowPtr[iRow+1]);
+
+    const CFint diag = getBlockSlot(iRow, iRow);
+    cf_assert(diag >= 0);
+    m_diagSlot[iRow] = static_cast<CFuint>(diag);
+  }
+
+  const CFuint nbEntries = m_colIdx.size()*m_blockSize2;
+  if (m_singlePrecision) {
+    vector<CFreal>().swap(m_values);
+    m_valuesSP.assign(nbEntries, 0.f);
+  }
+  else {
+    vector<float>().swap(m_valuesSP);
+    m_values.assign(nbEntries, 0.);
+  }
+  m_nbIgnored = 0;
+
+  const CFuint entrySize = m_singlePrecision ? sizeof(float) : sizeof(CFreal);
+  CFLog(VERBOSE, "KrylovLSSMatrix::createPattern() => " << m_nbRows << " x "
+	<< m_nbCols << " blocks of size " << m_blockSize << ", "
+	<< m_colIdx.size() << " non zero blocks, "
+	<< nbEntries*entrySize/(1024.*1024.) << " MB in "
+	<< (m_singlePrecision ? "single" : "double") << " precision\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::destroy()
+{
+  m_nbRows = m_nbCols = 0;
+  vector<CFuint>().swap(m_rowPtr);
+  vector<CFuint>().swap(m_colIdx);
+  vector<CFuint>().swap(m_diagSlot);
+  vector<CFreal>().swap(m_values);
+  vector<float>().swap(m_valuesSP);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::createSeqAIJ(const CFint m, const CFint n, const CFint nz,
+				   const CFint* nnz, const char* name)
+{
+  throw Common::NotImplementedException
+    (FromHere(), "KrylovLSSMatrix::createSeqAIJ() => use createPattern()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::createSeqBAIJ(const CFuint blockSize, const CFint m,
+				    const CFint n, const CFint nz,
+				    const CFint* nnz, const char* name)
+{
+  throw Common::NotImplementedException
+    (FromHere(), "KrylovLSSMatrix::createSeqBAIJ() => use createPattern()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+#ifdef CF_HAVE_MPI
+void KrylovLSSMatrix::createParAIJ(MPI_Comm comm, const CFint m, const CFint n,
+				   const CFint M, const CFint N,
+				   const CFint dnz, const CFint* dnnz,
+				   const CFint onz, const CFint* onnz,
+				   const char* name)
+{
+  throw Common::NotImplementedException
+    (FromHere(), "KrylovLSSMatrix::createParAIJ() => use createPattern()");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::createParBAIJ(MPI_Comm comm, const CFuint blockSize,
+				    const CFint m, const CFint n,
+				    const CFint M, const CFint N,
+				    const CFint dnz, const CFint* dnnz,
+				    const CFint onz, const CFint* onnz,
+				    const char* name)
+{
+  throw Common::NotImplementedException
+    (FromHere(), "KrylovLSSMatrix::createParBAIJ() => use createPattern()");
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::endAssembly(LSSMatrixAssemblyType assemblyType)
+{
+  if (assemblyType == FINAL_ASSEMBLY && m_nbIgnored > 0) {
+    CFLog(WARN, "KrylovLSSMatrix::endAssembly() => " << m_nbIgnored
+	  << " entries outside the pattern have been ignored, the first one in block ("
+	  << m_firstIgnoredRow << "," << m_firstIgnoredCol << ")\n");
+    m_nbIgnored = 0;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::printToScreen() const
+{
+  CFout << "KrylovLSSMatrix (" << m_nbRows << " x " << m_nbCols << " blocks of size "
+	<< m_blockSize << ")\n";
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    for (CFuint k = m_rowPtr[iRow]; k < m_rowPtr[iRow+1]; ++k) {
+      const CFuint start = k*m_blockSize2;
+      CFout << "(" << iRow << "," << m_colIdx[k] << ")\n";
+      for (CFuint ib = 0; ib < m_blockSize; ++ib) {
+	for (CFuint jb = 0; jb < m_blockSize; ++jb) {
+	  CFout << getEntry(start + ib*m_blockSize + jb) << " ";
+	}
+	CFout << "\n";
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::printToFile(const char* fileName) const
+{
+  // one scalar entry per line, in the same (row,column,value) format used
+  // by the other LSS matrices
+  ofstream fout(fileName);
+  fout.precision(14);
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    for (CFuint k = m_rowPtr[iRow]; k < m_rowPtr[iRow+1]; ++k) {
+      const CFuint start = k*m_blockSize2;
+      for (CFuint ib = 0; ib < m_blockSize; ++ib) {
+	for (CFuint jb = 0; jb < m_blockSize; ++jb) {
+	  fout << iRow*m_blockSize + ib << " " << m_colIdx[k]*m_blockSize + jb << " "
+	       << scientific << getEntry(start + ib*m_blockSize + jb) << "\n";
+	}
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFint KrylovLSSMatrix::getEntryIdx(const CFint im, const CFint in,
+				   const bool isWrite)
+{
+  if (im < 0 || in < 0) return -1;
+
+  const CFuint iRow = im/m_blockSize;
+  const CFuint iCol = in/m_blockSize;
+  cf_assert(iRow < m_nbRows);
+  cf_assert(iCol < m_nbCols);
+
+  const CFint slot = getBlockSlot(iRow, iCol);
+  if (slot < 0) {
+    if (isWrite) dropBlock(iRow, iCol);
+    return -1;
+  }
+  return slot*m_blockSize2 + (im%m_blockSize)*m_blockSize + in%m_blockSize;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::dropBlock(const CFuint iRow, const CFuint iCol)
+{
+#ifndef NDEBUG
+  throw Common::BadValueException
+    (FromHere(), "KrylovLSSMatrix::dropBlock() => block (" +
+     Common::StringOps::to_str(iRow) + "," + Common::StringOps::to_str(iCol) +
+     ") is outside the pattern");
+#endif
+
+  if (m_nbIgnored == 0) {
+    m_firstIgnoredRow = iRow;
+    m_firstIgnoredCol = iCol;
+  }
+  ++m_nbIgnored;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::setValue(const CFint im, const CFint in, const CFreal value)
+{
+  const CFint idx = getEntryIdx(im, in, true);
+  if (idx >= 0) setEntry(idx, value);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::setValues(const CFuint m, const CFint* im, const CFuint n,
+				const CFint* in, const CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      setValue(im[i], in[j], values[i*n + j]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::addValue(const CFint im, const CFint in, const CFreal value)
+{
+  const CFint idx = getEntryIdx(im, in, true);
+  if (idx >= 0) addEntry(idx, value);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::addValues(const CFuint m, const CFint* im, const CFuint n,
+				const CFint* in, const CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      addValue(im[i], in[j], values[i*n + j]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::getValue(const CFint im, const CFint in, CFreal& value)
+{
+  const CFint idx = getEntryIdx(im, in, false);
+  value = (idx >= 0) ? getEntry(idx) : 0.;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::getValues(const CFuint m, const CFint* im, const CFuint n,
+				const CFint* in, CFreal* values)
+{
+  for (CFuint i = 0; i < m; ++i) {
+    for (CFuint j = 0; j < n; ++j) {
+      getValue(im[i], in[j], values[i*n + j]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::setRow(const CFuint row, CFreal diagval, CFreal offdiagval)
+{
+  const CFuint iRow = row/m_blockSize;
+  const CFuint ib = row%m_blockSize;
+  cf_assert(iRow < m_nbRows);
+
+  for (CFuint k = m_rowPtr[iRow]; k < m_rowPtr[iRow+1]; ++k) {
+    const CFuint start = k*m_blockSize2 + ib*m_blockSize;
+    for (CFuint jb = 0; jb < m_blockSize; ++jb) {
+      setEntry(start + jb, (m_colIdx[k]*m_blockSize + jb == row) ? diagval : offdiagval);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::setDiagonal(LSSVector& diag)
+{
+  const CFreal *const d = dynamic_cast<KrylovLSSVector&>(diag).getArray();
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    const CFuint start = m_diagSlot[iRow]*m_blockSize2;
+    for (CFuint ib = 0; ib < m_blockSize; ++ib) {
+      setEntry(start + ib*m_blockSize + ib, d[iRow*m_blockSize + ib]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::addToDiagonal(LSSVector& diag)
+{
+  const CFreal *const d = dynamic_cast<KrylovLSSVector&>(diag).getArray();
+  for (CFuint iRow = 0; iRow < m_nbRows; ++iRow) {
+    const CFuint start = m_diagSlot[iRow]*m_blockSize2;
+    for (CFuint ib = 0; ib < m_blockSize; ++ib) {
+      addEntry(start + ib*m_blockSize + ib, d[iRow*m_blockSize + ib]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::resetToZeroEntries()
+{
+  std::fill(m_values.begin(), m_values.end(), 0.);
+  std::fill(m_valuesSP.begin(), m_valuesSP.end(), 0.f);
+  m_nbIgnored = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void KrylovLSSMatrix::assemble(const BlockAccumulator& acc, vector<T>& values,
+			       const bool add)
+{
+  cf_assert(acc.getNB() == m_blockSize);
+  const vector<CFint>& im = acc.getIM();
+  const vector<CFint>& in = acc.getIN();
+
+  for (CFuint i = 0; i < acc.getM(); ++i) {
+    if (im[i] < 0) continue;
+    for (CFuint j = 0; j < acc.getN(); ++j) {
+      if (in[j] < 0) continue;
+      const CFint slot = getBlockSlot(im[i], in[j]);
+      if (slot < 0) {
+	dropBlock(im[i], in[j]);
+	continue;
+      }
+
+      T *const block = &values[slot*m_blockSize2];
+      for (CFuint ib = 0; ib < m_blockSize; ++ib) {
+	for (CFuint jb = 0; jb < m_blockSize; ++jb) {
+	  const T value = static_cast<T>(acc.getValue(i,j,ib,jb));
+	  if (add) {block[ib*m_blockSize + jb] += value;}
+	  else {block[ib*m_blockSize + jb] = value;}
+	}
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::setValues(const BlockAccumulator& acc)
+{
+  if (m_singlePrecision) {assemble(acc, m_valuesSP, false);}
+  else {assemble(acc, m_values, false);}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::addValues(const BlockAccumulator& acc)
+{
+  if (m_singlePrecision) {assemble(acc, m_valuesSP, true);}
+  else {assemble(acc, m_values, true);}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSMatrix::multiply(const CFreal* x, CFreal* y) const
+{
+  const CFint nbRows = static_cast<CFint>(m_nbRows);
+  if (m_singlePrecision) {
+    bsrMultiply(nbRows, m_blockSize, m_nbThreads, m_rowPtr, m_colIdx, &m_valuesSP[0], x, y);
+  }
+  else {
+    bsrMultiply(nbRows, m_blockSize, m_nbThreads, m_rowPtr, m_colIdx, &m_values[0], x, y);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
@@ -0,0 +1,293 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_KrylovLSSMatrix_hh
+#define COOLFluiD_KrylovLSS_KrylovLSSMatrix_hh
+
+#include <algorithm>
+#include <vector>
+
+#include "Framework/LSSMatrix.hh"
+
+namespace COOLFluiD {
+
+  namespace Framework {
+    class BlockAccumulator;
+  }
+
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a block compressed sparse row (BSR) matrix.
+/// The rows are the ones of the states updatable by this process, the
+/// columns are the ones of all the local states (updatable first, ghosts
+/// after them). The pattern is fixed at creation and each block is stored
+/// contiguously row by row, so that the contributions of a BlockAccumulator
+/// are added to preallocated slots without any reallocation.
+/// Setting or adding entries outside the pattern is an assembly error: it
+/// throws in debug builds, while in release builds the entries are dropped,
+/// as in a PETSc matrix with frozen non zero structure, and a warning with the
+/// first dropped block is given at the final assembly.
+/// The blocks can be stored in single precision to halve the memory traffic
+/// of the matrix-vector product: the operations on the vectors are always
+/// accumulated in double precision.
+class KrylovLSSMatrix : public Framework::LSSMatrix {
+
+public:
+
+  /// Default constructor without arguments
+  KrylovLSSMatrix();
+
+  /// Destructor
+  ~KrylovLSSMatrix();
+
+  /// Store the blocks in single precision
+  /// @pre called before createPattern()
+  void setSinglePrecision(const bool singlePrecision) {m_singlePrecision = singlePrecision;}
+
+  /// @return true if the blocks are stored in single precision
+  bool isSinglePrecision() const {return m_singlePrecision;}
+
+  /// Allocate the storage for the given pattern
+  /// @param blockSize  size of the square blocks
+  /// @param nbCols     number of block columns (updatable and ghost states)
+  /// @param pattern    block columns of each row owned by this process
+  ///                   (diagonal included)
+  void createPattern(const CFuint blockSize, const CFuint nbCols,
+		     const std::vector< std::vector<CFuint> >& pattern);
+
+  /// Deallocate internal memory
+  void destroy();
+
+  /// Create a sequential sparse matrix (not available, use createPattern())
+  void createSeqAIJ(const CFint m, const CFint n, const CFint nz,
+		    const CFint* nnz, const char* name = CFNULL);
+
+  /// Create a sequential block sparse matrix (not available, use createPattern())
+  void createSeqBAIJ(const CFuint blockSize, const CFint m, const CFint n,
+		     const CFint nz, const CFint* nnz, const char* name = CFNULL);
+
+#ifdef CF_HAVE_MPI
+  /// Create a parallel sparse matrix (not available, use createPattern())
+  void createParAIJ(MPI_Comm comm, const CFint m, const CFint n,
+		    const CFint M, const CFint N,
+		    const CFint dnz, const CFint* dnnz,
+		    const CFint onz, const CFint* onnz,
+		    const char* name = CFNULL);
+
+  /// Create a parallel block sparse matrix (not available, use createPattern())
+  void createParBAIJ(MPI_Comm comm, const CFuint blockSize,
+		     const CFint m, const CFint n, const CFint M, const CFint N,
+		     const CFint dnz, const CFint* dnnz,
+		     const CFint onz, const CFint* onnz,
+		     const char* name = CFNULL);
+#endif
+
+  /// Start to assemble the matrix
+  void beginAssembly(LSSMatrixAssemblyType assemblyType) {}
+
+  /// Finish to assemble the matrix
+  void endAssembly(LSSMatrixAssemblyType assemblyType);
+
+  /// Print this matrix
+  void printToScreen() const;
+
+  /// Print this matrix to a file
+  void printToFile(const char* fileName) const;
+
+  /// Set one value
+  void setValue(const CFint im, const CFint in, const CFreal value);
+
+  /// Set a list of values
+  void setValues(const CFuint m, const CFint* im, const CFuint n,
+		 const CFint* in, const CFreal* values);
+
+  /// Add one value
+  void addValue(const CFint im, const CFint in, const CFreal value);
+
+  /// Add a list of values
+  void addValues(const CFuint m, const CFint* im, const CFuint n,
+		 const CFint* in, const CFreal* values);
+
+  /// Get one value
+  void getValue(const CFint im, const CFint in, CFreal& value);
+
+  /// Get a list of values
+  void getValues(const CFuint m, const CFint* im, const CFuint n,
+		 const CFint* in, CFreal* values);
+
+  /// Set a row, diagonal and off-diagonals
+  void setRow(const CFuint row, CFreal diagval, CFreal offdiagval);
+
+  /// Set the diagonal
+  void setDiagonal(Framework::LSSVector& diag);
+
+  /// Add to the diagonal
+  void addToDiagonal(Framework::LSSVector& diag);
+
+  /// Reset to 0 all the non-zero elements of the matrix
+  void resetToZeroEntries();
+
+  /// Set the values of a block accumulator
+  void setValues(const Framework::BlockAccumulator& acc);
+
+  /// Add the values of a block accumulator
+  void addValues(const Framework::BlockAccumulator& acc);
+
+  /// Freeze the matrix structure (the pattern is always frozen)
+  void freezeNonZeroStructure() {}
+
+  /// Set the number of threads used in the matrix-vector product
+  void setNbThreads(const CFuint nbThreads) {m_nbThreads = nbThreads;}
+
+  /// Compute y = A*x on the rows owned by this process
+  /// @param x  array of size getNbCols()*getBlockSize() with the entries of
+  ///           the ghost states up to date
+  /// @param y  array of size getNbRows()*getBlockSize()
+  void multiply(const CFreal* x, CFreal* y) const;
+
+  /// @return the slot of the block (iRow,iCol), -1 if it is not in the pattern
+  CFint getBlockSlot(const CFuint iRow, const CFuint iCol) const
+  {
+    cf_assert(iRow < m_nbRows);
+    // the rows are short and sorted: a linear scan is the fastest lookup
+    for (CFuint k = m_rowPtr[iRow]; k < m_rowPtr[iRow+1]; ++k) {
+      if (m_colIdx[k] == iCol) return static_cast<CFint>(k);
+      if (m_colIdx[k] > iCol) break;
+    }
+    return -1;
+  }
+
+  /// Copy in double precision the block in the given slot
+  /// @param block  array of getBlockSize()*getBlockSize() entries (row-major)
+  void copyBlock(const CFuint slot, CFreal* block) const
+  {
+    const CFuint start = slot*m_blockSize2;
+    if (m_singlePrecision) {
+      std::copy(&m_valuesSP[start], &m_valuesSP[start] + m_blockSize2, block);
+    }
+    else {
+      std::copy(&m_values[start], &m_values[start] + m_blockSize2, block);
+    }
+  }
+
+  /// @return the size of the blocks
+  CFuint getBlockSize() const {return m_blockSize;}
+
+  /// @return the number of block rows
+  CFuint getNbRows() const {return m_nbRows;}
+
+  /// @return the number of block columns
+  CFuint getNbCols() const {return m_nbCols;}
+
+  /// @return the number of stored blocks
+  CFuint getNbBlocks() const {return m_colIdx.size();}
+
+  /// @return the first slot of each row (size getNbRows()+1)
+  const std::vector<CFuint>& getRowPtr() const {return m_rowPtr;}
+
+  /// @return the column of each slot
+  const std::vector<CFuint>& getColIdx() const {return m_colIdx;}
+
+  /// @return the slot of the diagonal block of each row
+  const std::vector<CFuint>& getDiagSlots() const {return m_diagSlot;}
+
+private:
+
+  /// @return the position in the storage of the given scalar indices,
+  ///         -1 if it is not in the pattern
+  /// @param isWrite  flag telling if the entry is going to be set or added,
+  ///                 in which case an entry outside the pattern is dropped
+  CFint getEntryIdx(const CFint im, const CFint in, const bool isWrite);
+
+  /// Drop the contribution to a block outside the pattern
+  /// @throw Common::BadValueException in debug builds
+  void dropBlock(const CFuint iRow, const CFuint iCol);
+
+  /// @return the value stored in the given position
+  CFreal getEntry(const CFuint idx) const
+  {
+    return m_singlePrecision ? static_cast<CFreal>(m_valuesSP[idx]) : m_values[idx];
+  }
+
+  /// Set the value stored in the given position
+  void setEntry(const CFuint idx, const CFreal value)
+  {
+    if (m_singlePrecision) {m_valuesSP[idx] = static_cast<float>(value);}
+    else {m_values[idx] = value;}
+  }
+
+  /// Add to the value stored in the given position
+  void addEntry(const CFuint idx, const CFreal value)
+  {
+    if (m_singlePrecision) {m_valuesSP[idx] += static_cast<float>(value);}
+    else {m_values[idx] += value;}
+  }
+
+  /// Set or add the values of a block accumulator in the given storage
+  template <typename T>
+  void assemble(const Framework::BlockAccumulator& acc, std::vector<T>& values,
+		const bool add);
+
+  /// Copy constructor
+  KrylovLSSMatrix(const KrylovLSSMatrix& other);
+
+  /// Overloading of the assignment operator
+  const KrylovLSSMatrix& operator= (const KrylovLSSMatrix& other);
+
+private:
+
+  /// size of the blocks
+  CFuint m_blockSize;
+
+  /// number of entries of a block
+  CFuint m_blockSize2;
+
+  /// number of block rows
+  CFuint m_nbRows;
+
+  /// number of block columns
+  CFuint m_nbCols;
+
+  /// first slot of each row
+  std::vector<CFuint> m_rowPtr;
+
+  /// column of each slot (sorted in each row)
+  std::vector<CFuint> m_colIdx;
+
+  /// slot of the diagonal block of each row
+  std::vector<CFuint> m_diagSlot;
+
+  /// flag telling if the blocks are stored in single precision
+  bool m_singlePrecision;
+
+  /// entries of the blocks (double precision storage)
+  std::vector<CFreal> m_values;
+
+  /// entries of the blocks (single precision storage)
+  std::vector<float> m_valuesSP;
+
+  /// number of threads in the matrix-vector product
+  CFuint m_nbThreads;
+
+  /// number of entries ignored since the last assembly because outside the pattern
+  CFuint m_nbIgnored;
+
+  /// block row of the first entry ignored since the last assembly
+  CFuint m_firstIgnoredRow;
+
+  /// block column of the first entry ignored since the last assembly
+  CFuint m_firstIgnoredCol;
+
+}; // end of class KrylovLSSMatrix
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_KrylovLSSMatrix_hh
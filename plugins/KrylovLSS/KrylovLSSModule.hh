@@ -0,0 +1,42 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_KrylovLSSModule_hh
+#define COOLFluiD_KrylovLSS_KrylovLSSModule_hh
+
+#include "Environment/ModuleRegister.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+/// This class defines the Module KrylovLSS
+class KrylovLSSModule : public Environment::ModuleRegister< KrylovLSSModule > {
+public:
+
+  /**
+   * Static function that returns the module name.
+   * Must be implemented for the ModuleRegister template
+   * @return name of the module
+   */
+  static std::string getModuleName() {
+    return "KrylovLSS";
+  }
+
+  /**
+   * Static function that returns the description of the module.
+   * Must be implemented for the ModuleRegister template
+   * @return descripton of the module
+   */
+  static std::string getModuleDescription() {
+    return "This module implements a block sparse Krylov linear system solver without external dependencies.";
+  }
+
+}; // end KrylovLSSModule
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_KrylovLSSModule_hh
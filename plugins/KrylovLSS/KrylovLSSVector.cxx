@@ -0,0 +1,51 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <fstream>
+#include <iomanip>
+
+#include "Common/CFLog.hh"
+#include "KrylovLSS/KrylovLSSVector.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSVector::create(MPI_Comm comm, const CFint m, const CFint M,
+			     const char* name)
+{
+  cf_assert(m >= 0 && M >= 0);
+  m_v.assign(m, 0.);
+  m_globalSize = M;
+  m_name = (name != CFNULL) ? name : "";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSVector::printToScreen() const
+{
+  CFout << "KrylovLSSVector " << m_name << " (" << m_v.size() << ")\n";
+  for (CFuint i = 0; i < m_v.size(); ++i) {
+    CFout << i << " " << m_v[i] << "\n";
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovLSSVector::printToFile(const char* fileName) const
+{
+  std::ofstream fout(fileName);
+  fout.precision(14);
+  for (CFuint i = 0; i < m_v.size(); ++i) {
+    fout << i << " " << std::scientific << m_v[i] << "\n";
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
@@ -0,0 +1,145 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_KrylovLSSVector_hh
+#define COOLFluiD_KrylovLSS_KrylovLSSVector_hh
+
+#include <vector>
+
+#include "Framework/LSSVector.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a KrylovLSSVector, stored contiguously with the
+/// entries of the updatable states first and the ones of the ghost states
+/// after them
+class KrylovLSSVector : public Framework::LSSVector {
+
+public:
+
+  /// Default constructor without arguments
+  KrylovLSSVector() : Framework::LSSVector(), m_v(), m_globalSize(0), m_name() {}
+
+  /// Destructor
+  ~KrylovLSSVector() {}
+
+  /// Create a vector
+  /// @param m local size (updatable and ghost entries)
+  /// @param M global size
+  void create(MPI_Comm comm, const CFint m, const CFint M, const char* name);
+
+  /// Deallocate internal memory
+  void destroy()
+  {
+    std::vector<CFreal>().swap(m_v);
+    m_globalSize = 0;
+  }
+
+  /// Initialize a vector
+  void initialize(MPI_Comm comm, const CFreal value) {setValue(value);}
+
+  /// Start to assemble the vector
+  void beginAssembly() {}
+
+  /// Finish to assemble the vector
+  void endAssembly() {}
+
+  /// Print this vector
+  void printToScreen() const;
+
+  /// Print this vector to a file
+  void printToFile(const char* fileName) const;
+
+  /// Set a value at the specified position in the vector
+  void setValue(const CFint idx, const CFreal value)
+  {
+    if (idx >= 0) m_v[idx] = value;
+  }
+
+  /// Set all the entries equal to the given value
+  void setValue(const CFreal value)
+  {
+    for (CFuint i = 0; i < m_v.size(); ++i) m_v[i] = value;
+  }
+
+  /// Set a list of values
+  void setValues(const CFuint nbValues, const CFint* idx, const CFreal* values)
+  {
+    for (CFuint i = 0; i < nbValues; ++i) setValue(idx[i], values[i]);
+  }
+
+  /// Add a value in the vector at the given location
+  void addValue(const CFint idx, const CFreal value)
+  {
+    if (idx >= 0) m_v[idx] += value;
+  }
+
+  /// Add a list of values at the given locations
+  void addValues(const CFuint nbValues, const CFint* idx, const CFreal* values)
+  {
+    for (CFuint i = 0; i < nbValues; ++i) addValue(idx[i], values[i]);
+  }
+
+  /// Get one value
+  void getValue(const CFint idx, CFreal value) {value = m_v[idx];}
+
+  /// Get a list of values
+  void getValues(const CFuint m, const CFint* im, CFreal* values)
+  {
+    for (CFuint i = 0; i < m; ++i) values[i] = m_v[im[i]];
+  }
+
+  /// Copy the raw data of this vector to a given array
+  void copy(CFreal *const other, const CFuint size) const
+  {
+    for (CFuint i = 0; i < size; ++i) other[i] = m_v[i];
+  }
+
+  /// Copy the raw data of this vector to the given positions of an array
+  void copy(CFreal *const other, CFint *const localIDs, const CFuint size) const
+  {
+    for (CFuint i = 0; i < size; ++i) other[localIDs[i]] = m_v[i];
+  }
+
+  /// Gets the local size of the vector
+  CFuint getLocalSize() const {return m_v.size();}
+
+  /// Gets the global size of the vector
+  CFuint getGlobalSize() const {return m_globalSize;}
+
+  /// Get internal array
+  CFreal* getArray() {return (m_v.empty()) ? CFNULL : &m_v[0];}
+
+private:
+
+  /// Copy constructor
+  KrylovLSSVector(const KrylovLSSVector& other);
+
+  /// Overloading of the assignment operator
+  const KrylovLSSVector& operator= (const KrylovLSSVector& other);
+
+private:
+
+  /// vector entries
+  std::vector<CFreal> m_v;
+
+  /// global size of the vector
+  CFuint m_globalSize;
+
+  /// vector name
+  std::string m_name;
+
+}; // end of class KrylovLSSVector
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_KrylovLSSVector_hh
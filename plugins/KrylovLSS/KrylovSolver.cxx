@@ -0,0 +1,249 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cmath>
+
+#include "KrylovLSS/BlockPreconditioner.hh"
+#include "KrylovLSS/KrylovSolver.hh"
+
+using namespace std;
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+KrylovSolver::KrylovSolver() :
+  m_size(0),
+  m_nbKrylovSpaces(30),
+  m_maxIter(0),
+  m_relTol(0.),
+  m_absTol(0.),
+  m_r(),
+  m_w(),
+  m_v(),
+  m_h(),
+  m_givens()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void KrylovSolver::setup(const CFuint size, const CFuint nbKrylovSpaces,
+			 const CFuint maxIter, const CFreal relTol,
+			 const CFreal absTol)
+{
+  cf_assert(nbKrylovSpaces > 0);
+  m_size = size;
+  m_nbKrylovSpaces = nbKrylovSpaces;
+  m_maxIter = maxIter;
+  m_relTol = relTol;
+  m_absTol = absTol;
+  m_r.resize(m_size);
+  m_w.resize(m_size);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint KrylovSolver::solveGMRES(Operations& op, const BlockPreconditioner& pc,
+				const CFreal* b, CFreal* x, CFreal& resNorm)
+{
+  const CFuint n = m_size;
+  const CFuint m = m_nbKrylovSpaces;
+
+  m_v.resize((m+1)*n);
+  m_h.resize((m+1)*m);
+  m_givens.resize(4*m+1);
+  CFreal *const cs = &m_givens[0];
+  CFreal *const sn = cs + m;
+  CFreal *const g  = sn + m;
+  CFreal *const y  = g + m + 1;
+
+  std::fill(x, x + n, 0.);
+  std::copy(b, b + n, m_r.begin());
+  CFreal beta = std::sqrt(op.dot(&m_r[0], &m_r[0]));
+  resNorm = beta;
+  if (beta == 0.) return 0;
+
+  const CFreal tol = max(m_relTol*beta, m_absTol);
+  CFuint iter = 0;
+
+  while (true) {
+    for (CFuint i = 0; i < n; ++i) {
+      m_v[i] = m_r[i]/beta;
+    }
+    std::fill(g, g + m + 1, 0.);
+    g[0] = beta;
+
+    CFuint k = 0;
+    while (k < m && iter < m_maxIter) {
+      const CFreal *const vk = &m_v[k*n];
+      CFreal *const w = &m_v[(k+1)*n];
+      pc.apply(vk, &m_w[0]);
+      op.multiply(&m_w[0], w);
+
+      // modified Gram-Schmidt orthogonalization
+      for (CFuint i = 0; i <= k; ++i) {
+	const CFreal *const vi = &m_v[i*n];
+	const CFreal hik = op.dot(w, vi);
+	m_h[i*m + k] = hik;
+	for (CFuint j = 0; j < n; ++j) {
+	  w[j] -= hik*vi[j];
+	}
+      }
+
+      const CFreal hNext = std::sqrt(op.dot(w, w));
+      if (hNext > 0.) {
+	for (CFuint j = 0; j < n; ++j) {
+	  w[j] /= hNext;
+	}
+      }
+
+      // apply the previous rotations to the new column and compute the new one
+      for (CFuint i = 0; i < k; ++i) {
+	const CFreal hi  = m_h[i*m + k];
+	const CFreal hi1 = m_h[(i+1)*m + k];
+	m_h[i*m + k]     =  cs[i]*hi + sn[i]*hi1;
+	m_h[(i+1)*m + k] = -sn[i]*hi + cs[i]*hi1;
+      }
+
+      const CFreal hkk = m_h[k*m + k];
+      const CFreal denom = std::sqrt(hkk*hkk + hNext*hNext);
+      cs[k] = (denom > 0.) ? hkk/denom : 1.;
+      sn[k] = (denom > 0.) ? hNext/denom : 0.;
+      m_h[k*m + k] = denom;
+
+      g[k+1] = -sn[k]*g[k];
+      g[k]   =  cs[k]*g[k];
+      resNorm = std::abs(g[k+1]);
+
+      ++k;
+      ++iter;
+      // stop also if the Krylov space is invariant (lucky breakdown)
+      if (resNorm <= tol || hNext == 0.) break;
+    }
+
+    // solve the upper triangular system and update x += M^-1 V y
+    for (CFuint i = k; i > 0; --i) {
+      const CFuint ii = i-1;
+      CFreal sum = g[ii];
+      for (CFuint j = ii+1; j < k; ++j) {
+	sum -= m_h[ii*m + j]*y[j];
+      }
+      y[ii] = (m_h[ii*m + ii] != 0.) ? sum/m_h[ii*m + ii] : 0.;
+    }
+
+    std::fill(m_r.begin(), m_r.end(), 0.);
+    for (CFuint i = 0; i < k; ++i) {
+      const CFreal *const vi = &m_v[i*n];
+      for (CFuint j = 0; j < n; ++j) {
+	m_r[j] += y[i]*vi[j];
+      }
+    }
+    pc.apply(&m_r[0], &m_w[0]);
+    for (CFuint j = 0; j < n; ++j) {
+      x[j] += m_w[j];
+    }
+
+    if (resNorm <= tol || iter >= m_maxIter) break;
+
+    // restart from the true residual
+    op.multiply(x, &m_r[0]);
+    for (CFuint j = 0; j < n; ++j) {
+      m_r[j] = b[j] - m_r[j];
+    }
+    beta = std::sqrt(op.dot(&m_r[0], &m_r[0]));
+    resNorm = beta;
+    if (beta <= tol) break;
+  }
+
+  return iter;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint KrylovSolver::solveBiCGStab(Operations& op, const BlockPreconditioner& pc,
+				   const CFreal* b, CFreal* x, CFreal& resNorm)
+{
+  const CFuint n = m_size;
+
+  // r0 (shadow residual), p, v, phat, s, shat, t
+  m_v.resize(7*n);
+  CFreal *const r0   = &m_v[0];
+  CFreal *const p    = r0 + n;
+  CFreal *const v    = p + n;
+  CFreal *const phat = v + n;
+  CFreal *const s    = phat + n;
+  CFreal *const shat = s + n;
+  CFreal *const t    = shat + n;
+  CFreal *const r    = &m_r[0];
+
+  std::fill(x, x + n, 0.);
+  std::copy(b, b + n, r);
+  std::copy(b, b + n, r0);
+  std::fill(p, p + n, 0.);
+  std::fill(v, v + n, 0.);
+
+  resNorm = std::sqrt(op.dot(r, r));
+  if (resNorm == 0.) return 0;
+  const CFreal tol = max(m_relTol*resNorm, m_absTol);
+
+  CFreal rho = 1.;
+  CFreal alpha = 1.;
+  CFreal omega = 1.;
+  CFuint iter = 0;
+
+  while (iter < m_maxIter) {
+    const CFreal rhoNew = op.dot(r0, r);
+    if (rhoNew == 0. || omega == 0.) break; // breakdown
+
+    const CFreal beta = (rhoNew/rho)*(alpha/omega);
+    for (CFuint j = 0; j < n; ++j) {
+      p[j] = r[j] + beta*(p[j] - omega*v[j]);
+    }
+
+    pc.apply(p, phat);
+    op.multiply(phat, v);
+    const CFreal r0v = op.dot(r0, v);
+    if (r0v == 0.) break; // breakdown
+    alpha = rhoNew/r0v;
+
+    for (CFuint j = 0; j < n; ++j) {
+      s[j] = r[j] - alpha*v[j];
+    }
+
+    ++iter;
+    resNorm = std::sqrt(op.dot(s, s));
+    if (resNorm <= tol) {
+      for (CFuint j = 0; j < n; ++j) {
+	x[j] += alpha*phat[j];
+      }
+      break;
+    }
+
+    pc.apply(s, shat);
+    op.multiply(shat, t);
+    const CFreal tt = op.dot(t, t);
+    omega = (tt > 0.) ? op.dot(t, s)/tt : 0.;
+
+    for (CFuint j = 0; j < n; ++j) {
+      x[j] += alpha*phat[j] + omega*shat[j];
+      r[j] = s[j] - omega*t[j];
+    }
+
+    rho = rhoNew;
+    resNorm = std::sqrt(op.dot(r, r));
+    if (resNorm <= tol) break;
+  }
+
+  return iter;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
@@ -0,0 +1,112 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_KrylovSolver_hh
+#define COOLFluiD_KrylovLSS_KrylovSolver_hh
+
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+    class BlockPreconditioner;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class implements the right preconditioned Krylov iterations (restarted
+/// GMRES and BiCGStab) on the rows owned by this process. The operations that
+/// depend on the parallel layout (matrix-vector product with the update of the
+/// ghost states, scalar product over all the processes) are supplied by the
+/// caller, so that the iterations can be used without the method framework.
+class KrylovSolver {
+public:
+
+  /// Interface to the operator and to the scalar product
+  class Operations {
+  public:
+
+    /// Destructor
+    virtual ~Operations() {}
+
+    /// Compute y = A*v
+    /// @param v  array of size getSize()
+    /// @param y  array of size getSize(), different from v
+    virtual void multiply(const CFreal* v, CFreal* y) = 0;
+
+    /// @return the scalar product of two arrays over all the processes
+    virtual CFreal dot(const CFreal* a, const CFreal* b) = 0;
+
+  }; // end of class Operations
+
+  /// Constructor
+  KrylovSolver();
+
+  /// Set the parameters of the iterations
+  /// @param size            number of entries owned by this process
+  /// @param nbKrylovSpaces  number of Krylov vectors before restarting GMRES
+  /// @param maxIter         maximum number of iterations
+  /// @param relTol          tolerance relative to the norm of the right hand side
+  /// @param absTol          absolute tolerance on the residual norm
+  void setup(const CFuint size, const CFuint nbKrylovSpaces, const CFuint maxIter,
+	     const CFreal relTol, const CFreal absTol);
+
+  /// @return the number of entries owned by this process
+  CFuint getSize() const {return m_size;}
+
+  /// Solve with restarted GMRES, starting from x = 0
+  /// @param resNorm  final norm of the residual
+  /// @return the number of iterations
+  CFuint solveGMRES(Operations& op, const BlockPreconditioner& pc,
+		    const CFreal* b, CFreal* x, CFreal& resNorm);
+
+  /// Solve with BiCGStab, starting from x = 0
+  /// @param resNorm  final norm of the residual
+  /// @return the number of iterations
+  CFuint solveBiCGStab(Operations& op, const BlockPreconditioner& pc,
+		       const CFreal* b, CFreal* x, CFreal& resNorm);
+
+private:
+
+  /// number of entries owned by this process
+  CFuint m_size;
+
+  /// number of Krylov vectors before restarting GMRES
+  CFuint m_nbKrylovSpaces;
+
+  /// maximum number of iterations
+  CFuint m_maxIter;
+
+  /// relative tolerance
+  CFreal m_relTol;
+
+  /// absolute tolerance
+  CFreal m_absTol;
+
+  /// residual
+  std::vector<CFreal> m_r;
+
+  /// work array
+  std::vector<CFreal> m_w;
+
+  /// Krylov basis (GMRES) or BiCGStab vectors
+  std::vector<CFreal> m_v;
+
+  /// Hessenberg matrix (GMRES)
+  std::vector<CFreal> m_h;
+
+  /// Givens rotations and right hand side of the least squares problem (GMRES)
+  std::vector<CFreal> m_givens;
+
+}; // end of class KrylovSolver
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_KrylovSolver_hh
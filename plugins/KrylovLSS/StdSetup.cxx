@@ -0,0 +1,205 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include "Common/PE.hh"
+#include "Common/ConnectivityTable.hh"
+#include "Common/NotImplementedException.hh"
+#include "Framework/MeshData.hh"
+#include "Framework/GlobalJacobianSparsity.hh"
+#include "Framework/MethodCommandProvider.hh"
+#include "Framework/SpaceMethod.hh"
+#include "Framework/State.hh"
+#include "KrylovLSS/StdSetup.hh"
+#include "KrylovLSS/KrylovLSSModule.hh"
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider< StdSetup,KrylovLSSData,KrylovLSSModule >
+  stdSetupProvider("StdSetup");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSetup::execute()
+{
+  CFAUTOTRACE;
+
+  KrylovLSSData& d = getMethodData();
+  if (d.useNodeBased()) {
+    throw NotImplementedException
+      (FromHere(), "KrylovLSS::StdSetup::execute() => node-based assembly is not supported");
+  }
+
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  const CFuint nbStates = states.size();
+  const CFuint nbEqs = d.getNbSysEquations();
+
+  // local to LSS mapping: the updatable states come first, the ghost states
+  // after them, so that the rows of the matrix are contiguous
+  valarray< CFuint > L2S(nbStates);
+  valarray< bool > ghosts(nbStates);
+  CFuint nbUpdatable = 0;
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    if (states[iL]->isParUpdatable()) ++nbUpdatable;
+  }
+
+  CFuint iu = 0;
+  CFuint ig = nbUpdatable;
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    if (states[iL]->isParUpdatable()) {
+      L2S[iL] = iu++;
+      ghosts[iL] = false;
+    }
+    else {
+      L2S[iL] = ig++;
+      ghosts[iL] = true;
+    }
+  }
+
+  d.setNbStates(nbStates, nbUpdatable);
+  d.getLocalToGlobalMapping().createMapping(L2S, ghosts);
+
+  // setup matrix
+  vector< vector< CFuint > > pattern(nbUpdatable);
+  if (!getSparsityPattern(L2S, pattern)) {
+    getCellStatesPattern(L2S, pattern);
+  }
+
+  for (CFuint iRow = 0; iRow < nbUpdatable; ++iRow) {
+    vector< CFuint >& row = pattern[iRow];
+    row.push_back(iRow);
+    sort(row.begin(), row.end());
+    row.erase(unique(row.begin(), row.end()), row.end());
+  }
+  d.getMatrix().createPattern(nbEqs, nbStates, pattern);
+
+  // setup vectors, with room for the ghost states
+  const std::string nsp = d.getNamespace();
+  MPI_Comm comm = PE::GetPE().GetCommunicator(nsp);
+  const CFuint nbGlobal = states.getGlobalSize();
+
+  KrylovLSSVector& sol = d.getSolVector();
+  sol.create(comm, nbStates*nbEqs, nbGlobal*nbEqs, "sol");
+  sol.initialize(comm, 0.);
+
+  KrylovLSSVector& rhs = d.getRhsVector();
+  rhs.create(comm, nbStates*nbEqs, nbGlobal*nbEqs, "rhs");
+  rhs.initialize(comm, 0.);
+
+  if (PE::GetPE().IsParallel()) {
+    d.setGhostLists(states.getGhostSendList(), states.getGhostReceiveList());
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool StdSetup::getSparsityPattern(const valarray< CFuint >& L2S,
+				  vector< vector< CFuint > >& pattern)
+{
+  CFAUTOTRACE;
+
+  SelfRegistPtr<GlobalJacobianSparsity> sparsity =
+    getMethodData().getCollaborator<SpaceMethod>()->createJacobianSparsity();
+
+  ConnectivityTable<CFuint> neighbors;
+  try {
+    sparsity->computeMatrixPattern(socket_states, neighbors);
+  }
+  catch (NotImplementedException&) {
+    CFLog(VERBOSE, "KrylovLSS::StdSetup => the sparsity of the space method "
+	  << "does not give the matrix pattern, using the cell connectivity\n");
+    return false;
+  }
+
+  const CFuint nbUpdatable = pattern.size();
+  for (CFuint iL = 0; iL < neighbors.nbRows(); ++iL) {
+    const CFuint iRow = L2S[iL];
+    if (iRow >= nbUpdatable) continue;
+    const CFuint nbNeighbors = neighbors.nbCols(iL);
+    pattern[iRow].reserve(nbNeighbors + 1);
+    for (CFuint j = 0; j < nbNeighbors; ++j) {
+      pattern[iRow].push_back(L2S[neighbors(iL,j)]);
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSetup::getCellStatesPattern(const valarray< CFuint >& L2S,
+				    vector< vector< CFuint > >& pattern)
+{
+  CFAUTOTRACE;
+
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<std::valarray< State* > > bStatesNeighbors =
+    socket_bStatesNeighbors.getDataHandle();
+
+  const CFuint nbStates = states.size();
+  const CFuint nbUpdatable = pattern.size();
+
+  // loop over all the boundary TRSs to detect all the boundary states
+  valarray< bool > isBState(false, nbStates);
+  vector< SafePtr<TopologicalRegionSet> > alltrs = MeshDataStack::getActive()->getTrsList();
+  for (CFuint iTrs = 0; iTrs < alltrs.size(); ++iTrs) {
+    SafePtr<TopologicalRegionSet> currTrs = alltrs[iTrs];
+    if (currTrs->getName() == "InnerCells" || currTrs->getName() == "InnerFaces") continue;
+    SafePtr< vector< CFuint > > bStates = currTrs->getStatesInTrs();
+    for (CFuint i = 0; i < bStates->size(); ++i) {
+      isBState[(*bStates)[i]] = true;
+    }
+  }
+
+  // neighbors in local numbering, including the state itself
+  vector< vector< CFuint > > nz(nbStates);
+  SafePtr< ConnectivityTable< CFuint > > cellStates =
+    MeshDataStack::getActive()->getConnectivity("cellStates_InnerCells");
+  const CFuint nbCells = cellStates->nbRows();
+  for (CFuint iCell = 0; iCell < nbCells; ++iCell) {
+    const CFuint nbCellStates = cellStates->nbCols(iCell);
+    for (CFuint iState = 0; iState < nbCellStates; ++iState) {
+      const CFuint iL = (*cellStates)(iCell,iState);
+      for (CFuint iNeigh = 0; iNeigh < nbCellStates; ++iNeigh) {
+	nz[iL].push_back((*cellStates)(iCell,iNeigh));
+      }
+    }
+  }
+
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    nz[iL].push_back(iL);
+    sort(nz[iL].begin(), nz[iL].end());
+    nz[iL].erase(unique(nz[iL].begin(), nz[iL].end()), nz[iL].end());
+
+    // the boundary conditions access the neighbors of the boundary states
+    if (isBState[iL]) {
+      bStatesNeighbors[iL].resize(nz[iL].size());
+      for (CFuint n = 0; n < nz[iL].size(); ++n) {
+	bStatesNeighbors[iL][n] = states[nz[iL][n]];
+      }
+    }
+
+    const CFuint iRow = L2S[iL];
+    if (iRow < nbUpdatable) {
+      pattern[iRow].resize(nz[iL].size());
+      for (CFuint n = 0; n < nz[iL].size(); ++n) {
+	pattern[iRow][n] = L2S[nz[iL][n]];
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  }  // namespace KrylovLSS
+}  // namespace COOLFluiD
@@ -0,0 +1,72 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_StdSetup_hh
+#define COOLFluiD_KrylovLSS_StdSetup_hh
+
+#include "KrylovLSS/KrylovLSSData.hh"
+#include "Framework/DataSocketSink.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+/// This is a standard command to setup the KrylovLSS method: it numbers the
+/// updatable states first and the ghost states after them, allocates the
+/// block pattern of the matrix and the lists of the ghost states to exchange
+class StdSetup : public KrylovLSSCom {
+public:
+
+  /// Constructor
+  explicit StdSetup(const std::string& name) :
+    KrylovLSSCom(name),
+    socket_bStatesNeighbors("bStatesNeighbors"),
+    socket_states("states") {}
+
+  /// Destructor
+  ~StdSetup() {}
+
+  /// Execute processing actions
+  void execute();
+
+  /**
+   * Returns the DataSockets that this command needs as sinks
+   * @return vector of SafePtr with the DataSockets
+   */
+  std::vector< Common::SafePtr< Framework::BaseDataSocketSink > >
+    needsSockets() {
+    std::vector< Common::SafePtr< Framework::BaseDataSocketSink > > result;
+    result.push_back(&socket_states);
+    result.push_back(&socket_bStatesNeighbors);
+    return result;
+  }
+
+protected:
+
+  /// socket for bStatesNeighbors
+  /// It's a list of neighbor states for the boundary states (to avoid matrix
+  /// reallocations when applying boundary conditions)
+  Framework::DataSocketSink< std::valarray<Framework::State*> > socket_bStatesNeighbors;
+
+  /// socket for states
+  Framework::DataSocketSink< Framework::State*,Framework::GLOBAL >  socket_states;
+
+private: // methods
+
+  /// Get the block pattern from the sparsity of the space method
+  /// @return false if the space method does not provide the pattern
+  bool getSparsityPattern(const std::valarray< CFuint >& L2S,
+			  std::vector< std::vector< CFuint > >& pattern);
+
+  /// Get the block pattern from the state-state connectivity of the cells
+  void getCellStatesPattern(const std::valarray< CFuint >& L2S,
+			    std::vector< std::vector< CFuint > >& pattern);
+
+}; // class StdSetup
+
+  }  // namespace KrylovLSS
+}  // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_StdSetup_hh
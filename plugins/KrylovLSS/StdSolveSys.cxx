@@ -0,0 +1,143 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include "Common/Stopwatch.hh"
+#include "Framework/MethodCommandProvider.hh"
+#include "Framework/State.hh"
+#include "KrylovLSS/StdSolveSys.hh"
+#include "KrylovLSS/KrylovLSSModule.hh"
+
+using namespace std;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Framework;
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider< StdSolveSys,KrylovLSSData,KrylovLSSModule >
+  stdSolveSysProvider("StdSolveSys");
+
+//////////////////////////////////////////////////////////////////////////////
+
+StdSolveSys::StdSolveSys(const std::string& name) :
+  KrylovLSSCom(name),
+  socket_states("states"),
+  socket_rhs("rhs"),
+  m_nbSolves(0),
+  m_size(0),
+  m_z(),
+  m_solver()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+StdSolveSys::~StdSolveSys()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSolveSys::execute()
+{
+  CFAUTOTRACE;
+
+  KrylovLSSData& d = getMethodData();
+  const CFuint nbSysEqs = d.getNbSysEquations();
+  m_size = d.getNbLocalStates()*nbSysEqs;
+  m_z.resize(d.getNbStates()*nbSysEqs);
+  m_solver.setup(m_size, d.getNbKrylovSpaces(), d.getMaxIterations(),
+		 d.getRelativeTolerance(), d.getAbsoluteTolerance());
+
+  // create equation index mapping (solver to absolute)
+  vector< CFuint > equationID;
+  equationID.reserve(nbSysEqs);
+  const valarray< bool >& maskArray = *d.getMaskArray();
+  const CFuint totalNbEqs = maskArray.size();
+  for (CFuint i = 0; i < totalNbEqs; ++i) {
+    if (maskArray[i]) equationID.push_back(i);
+  }
+  cf_assert(equationID.size() == nbSysEqs);
+
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle<CFreal> rhs = socket_rhs.getDataHandle();
+  const LSSIdxMapping& mapping = d.getLocalToGlobalMapping();
+  const CFuint nbStates = states.size();
+
+  // copy the rhs of the updatable states into the right hand side vector
+  CFreal *const b = d.getRhsVector().getArray();
+  CFreal *const x = d.getSolVector().getArray();
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    if (states[iL]->isParUpdatable()) {
+      const CFuint start = mapping.getColID(iL)*nbSysEqs;
+      for (CFuint e = 0; e < nbSysEqs; ++e) {
+	b[start + e] = rhs(iL, equationID[e], totalNbEqs);
+      }
+    }
+  }
+
+  // the preconditioner is kept if the convergence method reuses the jacobian
+  Stopwatch<WallTime> timer;
+  timer.start();
+  const CFuint pcRate = max<CFuint>(d.getPreconditionerRate(), 1);
+  if (m_nbSolves == 0 || (!d.reusePreconditioner() && m_nbSolves%pcRate == 0)) {
+    d.getPreconditioner().compute(d.getMatrix());
+  }
+  ++m_nbSolves;
+  const CFreal pcTime = timer.read();
+
+  CFreal resNorm = 0.;
+  const CFuint nbIter = (d.getKSPType() == "GMRES") ?
+    m_solver.solveGMRES(*this, d.getPreconditioner(), b, x, resNorm) :
+    m_solver.solveBiCGStab(*this, d.getPreconditioner(), b, x, resNorm);
+  d.setNbIterations(nbIter);
+  const CFreal solveTime = timer.read() - pcTime;
+
+  // the times allow to compare the single precision storage to the double one
+  if (d.isOutput()) {
+    CFLog(INFO, "KrylovLSS: " << d.getKSPType() << " iterations = " << nbIter
+	  << ", residual norm = " << resNorm << ", PC time = " << pcTime
+	  << "s, solve time = " << solveTime << "s\n");
+  }
+  else {
+    CFLog(VERBOSE, "KrylovLSS: " << d.getKSPType() << " iterations = " << nbIter
+	  << ", residual norm = " << resNorm << ", PC time = " << pcTime
+	  << "s, solve time = " << solveTime << "s\n");
+  }
+
+  // copy the solution of the updatable states back to the rhs
+  for (CFuint iL = 0; iL < nbStates; ++iL) {
+    if (states[iL]->isParUpdatable()) {
+      const CFuint start = mapping.getColID(iL)*nbSysEqs;
+      for (CFuint e = 0; e < nbSysEqs; ++e) {
+	rhs(iL, equationID[e], totalNbEqs) = x[start + e];
+      }
+    }
+  }
+
+  if (d.isSaveSystemToFile()) {
+    d.printToFile("krylov_", ".dat");
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdSolveSys::multiply(const CFreal* v, CFreal* y)
+{
+  KrylovLSSData& d = getMethodData();
+  std::copy(v, v + m_size, m_z.begin());
+  d.synchronize(&m_z[0]);
+  d.getMatrix().multiply(&m_z[0], y);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
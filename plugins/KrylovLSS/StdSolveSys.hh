@@ -0,0 +1,77 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_StdSolveSys_hh
+#define COOLFluiD_KrylovLSS_StdSolveSys_hh
+
+#include "KrylovLSS/KrylovLSSData.hh"
+#include "KrylovLSS/KrylovSolver.hh"
+#include "Framework/DataSocketSink.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+/// This is a standard command to solve the linear system with a right
+/// preconditioned Krylov method (restarted GMRES or BiCGStab)
+class StdSolveSys : public KrylovLSSCom,
+		    private KrylovSolver::Operations {
+public:
+
+  /// Constructor
+  explicit StdSolveSys(const std::string& name);
+
+  /// Destructor
+  virtual ~StdSolveSys();
+
+  /// Execute processing actions
+  void execute();
+
+  /**
+   * Returns the DataSocket's that this command needs as sinks
+   * @return a vector of SafePtr with the DataSockets
+   */
+  virtual std::vector< Common::SafePtr< Framework::BaseDataSocketSink > >
+    needsSockets() {
+    std::vector< Common::SafePtr< Framework::BaseDataSocketSink > > result;
+    result.push_back(&socket_states);
+    result.push_back(&socket_rhs);
+    return result;
+  }
+
+private: // methods
+
+  /// Compute y = A*v, updating the entries of the ghost states of v
+  void multiply(const CFreal* v, CFreal* y);
+
+  /// @return the scalar product of two arrays over all the processes
+  CFreal dot(const CFreal* a, const CFreal* b) {return getMethodData().dot(a,b);}
+
+private: // data
+
+  /// socket for states
+  Framework::DataSocketSink< Framework::State*,Framework::GLOBAL > socket_states;
+
+  /// Handle to RHS
+  Framework::DataSocketSink<CFreal > socket_rhs;
+
+  /// number of solves since the setup
+  CFuint m_nbSolves;
+
+  /// number of entries of the updatable states
+  CFuint m_size;
+
+  /// operand of the matrix-vector product, with the ghost states
+  std::vector<CFreal> m_z;
+
+  /// Krylov iterations
+  KrylovSolver m_solver;
+
+}; // class StdSolveSys
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_StdSolveSys_hh
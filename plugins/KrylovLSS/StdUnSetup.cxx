@@ -0,0 +1,32 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "KrylovLSS/StdUnSetup.hh"
+#include "KrylovLSS/KrylovLSSModule.hh"
+#include "Framework/MethodCommandProvider.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+//////////////////////////////////////////////////////////////////////////////
+
+Framework::MethodCommandProvider< StdUnSetup,KrylovLSSData,KrylovLSSModule >
+  stdUnSetupProvider("StdUnSetup");
+
+//////////////////////////////////////////////////////////////////////////////
+
+void StdUnSetup::execute()
+{
+  CFAUTOTRACE;
+
+  // destroy the system matrix, vectors and ghost lists
+  getMethodData().clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
@@ -0,0 +1,33 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_KrylovLSS_StdUnSetup_hh
+#define COOLFluiD_KrylovLSS_StdUnSetup_hh
+
+#include "KrylovLSS/KrylovLSSData.hh"
+
+namespace COOLFluiD {
+  namespace KrylovLSS {
+
+/// This is a standard command to deallocate data specific to KrylovLSS method
+class StdUnSetup : public KrylovLSSCom {
+public:
+
+  /// Constructor
+  explicit StdUnSetup(const std::string& name) : KrylovLSSCom(name) {}
+
+  /// Destructor
+  ~StdUnSetup() {}
+
+  /// Execute processing actions
+  void execute();
+
+}; // class StdUnSetup
+
+  } // namespace KrylovLSS
+} // namespace COOLFluiD
+
+#endif // COOLFluiD_KrylovLSS_StdUnSetup_hh
@@ -0,0 +1,233 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test Krylov solvers"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+
+#include "Common/BadValueException.hh"
+#include "KrylovLSS/BlockPreconditioner.hh"
+#include "KrylovLSS/KrylovLSSMatrix.hh"
+#include "KrylovLSS/KrylovSolver.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::KrylovLSS;
+
+using namespace boost::unit_test;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Sequential operations on a KrylovLSSMatrix (no ghost states)
+class SerialOperations : public KrylovSolver::Operations {
+public:
+
+  SerialOperations(const KrylovLSSMatrix& mat) : m_mat(mat) {}
+
+  void multiply(const CFreal* v, CFreal* y) {m_mat.multiply(v, y);}
+
+  CFreal dot(const CFreal* a, const CFreal* b)
+  {
+    const CFuint n = m_mat.getNbRows()*m_mat.getBlockSize();
+    CFreal sum = 0.;
+    for (CFuint i = 0; i < n; ++i) {
+      sum += a[i]*b[i];
+    }
+    return sum;
+  }
+
+private:
+
+  const KrylovLSSMatrix& m_mat;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct KrylovSolver_Fixture
+{
+  /// common setup for each test case: a non symmetric BSR matrix whose
+  /// pattern is wider than tridiagonal, so that ILU0 is not exact
+  KrylovSolver_Fixture() : nb(3), nbRows(10), size(nb*nbRows)
+  {
+    srand(12345);
+    pattern.resize(nbRows);
+    for (CFuint iRow = 0; iRow < nbRows; ++iRow) {
+      pattern[iRow].push_back(iRow);
+      if (iRow > 0) pattern[iRow].push_back(iRow-1);
+      if (iRow+1 < nbRows) pattern[iRow].push_back(iRow+1);
+      if (iRow+3 < nbRows) pattern[iRow].push_back(iRow+3);
+      if (iRow >= 4) pattern[iRow].push_back(iRow-4);
+    }
+    mat.createPattern(nb, nbRows, pattern);
+
+    dense.assign(size*size, 0.);
+    for (CFuint iRow = 0; iRow < nbRows; ++iRow) {
+      for (CFuint k = 0; k < pattern[iRow].size(); ++k) {
+	const CFuint iCol = pattern[iRow][k];
+	for (CFuint ib = 0; ib < nb; ++ib) {
+	  for (CFuint jb = 0; jb < nb; ++jb) {
+	    const CFuint i = iRow*nb + ib;
+	    const CFuint j = iCol*nb + jb;
+	    const CFreal value = (i == j) ? 10. + random() : random() - 0.5;
+	    mat.setValue(i, j, value);
+	    dense[i*size + j] = value;
+	  }
+	}
+      }
+    }
+    mat.finalAssembly();
+
+    b.resize(size);
+    for (CFuint i = 0; i < size; ++i) {
+      b[i] = random() - 0.5;
+    }
+    xExact = denseSolve(dense, b);
+  }
+
+  /// @return a random number in [0,1]
+  static CFreal random() {return static_cast<CFreal>(rand())/RAND_MAX;}
+
+  /// Gaussian elimination with partial pivoting
+  vector<CFreal> denseSolve(vector<CFreal> a, vector<CFreal> rhs) const
+  {
+    for (CFuint k = 0; k < size; ++k) {
+      CFuint p = k;
+      for (CFuint i = k+1; i < size; ++i) {
+	if (std::abs(a[i*size + k]) > std::abs(a[p*size + k])) p = i;
+      }
+      for (CFuint j = 0; j < size; ++j) {
+	std::swap(a[k*size + j], a[p*size + j]);
+      }
+      std::swap(rhs[k], rhs[p]);
+
+      for (CFuint i = k+1; i < size; ++i) {
+	const CFreal f = a[i*size + k]/a[k*size + k];
+	for (CFuint j = k; j < size; ++j) {
+	  a[i*size + j] -= f*a[k*size + j];
+	}
+	rhs[i] -= f*rhs[k];
+      }
+    }
+
+    vector<CFreal> x(size);
+    for (CFuint i = size; i > 0; --i) {
+      const CFuint ii = i-1;
+      CFreal sum = rhs[ii];
+      for (CFuint j = ii+1; j < size; ++j) {
+	sum -= a[ii*size + j]*x[j];
+      }
+      x[ii] = sum/a[ii*size + ii];
+    }
+    return x;
+  }
+
+  /// @return the maximum difference between the solution and the dense one
+  CFreal error(const vector<CFreal>& x) const
+  {
+    CFreal maxErr = 0.;
+    for (CFuint i = 0; i < size; ++i) {
+      maxErr = max(maxErr, std::abs(x[i] - xExact[i]));
+    }
+    return maxErr;
+  }
+
+  /// size of the blocks
+  CFuint nb;
+
+  /// number of block rows
+  CFuint nbRows;
+
+  /// number of scalar rows
+  CFuint size;
+
+  /// block columns of each block row
+  vector< vector<CFuint> > pattern;
+
+  /// BSR matrix
+  KrylovLSSMatrix mat;
+
+  /// same matrix stored densely, row by row
+  vector<CFreal> dense;
+
+  /// right hand side
+  vector<CFreal> b;
+
+  /// solution of the dense solve
+  vector<CFreal> xExact;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( KrylovSolver_TestSuite, KrylovSolver_Fixture )
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_gmresILU0 )
+{
+  std::auto_ptr<BlockPreconditioner> pc(BlockPreconditioner::create("ILU0"));
+  pc->compute(mat);
+
+  SerialOperations op(mat);
+  KrylovSolver solver;
+  // a Krylov space smaller than the system to go through a restart
+  solver.setup(size, 5, 200, 1e-13, 1e-30);
+
+  vector<CFreal> x(size);
+  CFreal resNorm = 0.;
+  const CFuint nbIter = solver.solveGMRES(op, *pc, &b[0], &x[0], resNorm);
+
+  BOOST_CHECK(nbIter > 1);
+  BOOST_CHECK(nbIter < 200);
+  BOOST_CHECK_SMALL(error(x), 1e-10);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_bicgstabILU0 )
+{
+  std::auto_ptr<BlockPreconditioner> pc(BlockPreconditioner::create("ILU0"));
+  pc->compute(mat);
+
+  SerialOperations op(mat);
+  KrylovSolver solver;
+  solver.setup(size, 30, 200, 1e-13, 1e-30);
+
+  vector<CFreal> x(size);
+  CFreal resNorm = 0.;
+  const CFuint nbIter = solver.solveBiCGStab(op, *pc, &b[0], &x[0], resNorm);
+
+  BOOST_CHECK(nbIter > 1);
+  BOOST_CHECK(nbIter < 200);
+  BOOST_CHECK_SMALL(error(x), 1e-10);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_entryOutsidePattern )
+{
+  // block (0,5) is not in the pattern
+#ifndef NDEBUG
+  BOOST_CHECK_THROW(mat.addValue(0, 5*nb, 1.), Common::BadValueException);
+#else
+  mat.addValue(0, 5*nb, 1.);
+  CFreal value = 1.;
+  mat.getValue(0, 5*nb, value);
+  BOOST_CHECK_EQUAL(value, 0.);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//////////////////////////////////////////////////////////////////////////////
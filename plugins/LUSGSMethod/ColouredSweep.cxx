@@ -0,0 +1,252 @@
+#include <algorithm>
+
+#include "Common/ConnectivityTable.hh"
+#include "Framework/MeshData.hh"
+#include "Framework/SpaceMethod.hh"
+#include "Framework/State.hh"
+#include "LUSGSMethod/LUSGSMethod.hh"
+#include "LUSGSMethod/ColouredSweep.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Numerics {
+
+    namespace LUSGSMethod {
+
+//////////////////////////////////////////////////////////////////////////////
+
+MethodCommandProvider<ColouredSweep, LUSGSIteratorData, LUSGSMethodModule>
+    colouredSweepProvider("ColouredSweep");
+
+//////////////////////////////////////////////////////////////////////////////
+
+ColouredSweep::ColouredSweep(std::string name) :
+  LUSGSIteratorCom(name),
+  socket_statesSetIdx("statesSetIdx"),
+  socket_states("states"),
+  socket_statesSetStateIDs("statesSetStateIDs"),
+  socket_isStatesSetParUpdatable("isStatesSetParUpdatable"),
+  m_computeSolUpdate(CFNULL),
+  m_updateSol(CFNULL)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ColouredSweep::setup()
+{
+  CFAUTOTRACE;
+
+  // call setup of parent class
+  LUSGSIteratorCom::setup();
+
+  cf_assert(m_computeSolUpdate.isNotNull());
+  cf_assert(m_updateSol.isNotNull());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ColouredSweep::setStatesSetUpdateComs(SafePtr<LUSGSIteratorCom> computeSolUpdate,
+                                           SafePtr<LUSGSIteratorCom> updateSol)
+{
+  m_computeSolUpdate = computeSolUpdate;
+  m_updateSol = updateSol;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ColouredSweep::execute()
+{
+  CFAUTOTRACE;
+
+  LUSGSIteratorData& data = getMethodData();
+
+  // the colouring is computed once, the states sets do not change
+  vector< vector< CFuint > >& colours = data.getStatesSetsColours();
+  if (colours.empty())
+  {
+    colourStatesSets();
+  }
+
+  DataHandle< CFint > statesSetIdx = socket_statesSetIdx.getDataHandle();
+  DataHandle< vector< CFuint > > statesSetStateIDs = socket_statesSetStateIDs.getDataHandle();
+
+  SafePtr<SpaceMethod> spaceMethod = data.getCollaborator<SpaceMethod>();
+  const bool forward = data.isForwardSweep();
+  const CFuint nbColours = colours.size();
+
+  for (CFuint iColour = 0; iColour < nbColours; ++iColour)
+  {
+    const vector< CFuint >& sets = colours[forward ? iColour : nbColours - 1 - iColour];
+    const CFuint nbSets = sets.size();
+
+    // the states sets of a colour do not depend on each other: each one is
+    // processed as in the states set by states set sweep
+    for (CFuint iSet = 0; iSet < nbSets; ++iSet)
+    {
+      statesSetIdx[0] = sets[iSet];
+
+      // Compute space residual for the current states set
+      spaceMethod->computeSpaceRhsForStatesSet(1.0);
+
+      // Compute the solution update for the current states set
+      m_computeSolUpdate->execute();
+
+      // Update the solution for the current states set
+      m_updateSol->execute();
+
+      // add contribution of current states set to the residual norms in the local processor
+      if (!forward)
+      {
+        data.getLUSGSNormComputer()->addStatesSetContribution();
+      }
+    }
+  }
+
+  // leave the states set index as UpdateStatesSetIndex does at the end of a sweep
+  statesSetIdx[0] = forward ? static_cast<CFint>(statesSetStateIDs.size()) : -1;
+  data.setStopSweep(true);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ColouredSweep::colourStatesSets()
+{
+  CFAUTOTRACE;
+
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle< vector< CFuint > > statesSetStateIDs = socket_statesSetStateIDs.getDataHandle();
+  DataHandle< bool > isStatesSetParUpdatable = socket_isStatesSetParUpdatable.getDataHandle();
+  const CFuint nbrStatesSets = statesSetStateIDs.size();
+
+  // states set of each state
+  vector< CFint > stateSet(states.size(), -1);
+  for (CFuint iSet = 0; iSet < nbrStatesSets; ++iSet)
+  {
+    for (CFuint iState = 0; iState < statesSetStateIDs[iSet].size(); ++iState)
+    {
+      stateSet[statesSetStateIDs[iSet][iState]] = iSet;
+    }
+  }
+
+  // nodes of the cells of each states set and states sets around each node
+  SafePtr< ConnectivityTable< CFuint > > cellStates =
+    MeshDataStack::getActive()->getConnectivity("cellStates_InnerCells");
+  SafePtr< ConnectivityTable< CFuint > > cellNodes =
+    MeshDataStack::getActive()->getConnectivity("cellNodes_InnerCells");
+  const CFuint nbrCells = cellNodes->nbRows();
+
+  vector< vector< CFuint > > setNodes(nbrStatesSets);
+  vector< vector< CFuint > > nodeSets;
+  for (CFuint iCell = 0; iCell < nbrCells; ++iCell)
+  {
+    const CFint iSet = stateSet[(*cellStates)(iCell,0)];
+    if (iSet < 0) continue;
+
+    for (CFuint iNode = 0; iNode < cellNodes->nbCols(iCell); ++iNode)
+    {
+      const CFuint nodeID = (*cellNodes)(iCell,iNode);
+      if (nodeID >= nodeSets.size()) nodeSets.resize(nodeID + 1);
+      setNodes[iSet].push_back(nodeID);
+      nodeSets[nodeID].push_back(iSet);
+    }
+  }
+
+  // states sets sharing a node
+  vector< vector< CFuint > > neighbours(nbrStatesSets);
+  for (CFuint iSet = 0; iSet < nbrStatesSets; ++iSet)
+  {
+    vector< CFuint >& setNeighbours = neighbours[iSet];
+    for (CFuint iNode = 0; iNode < setNodes[iSet].size(); ++iNode)
+    {
+      const vector< CFuint >& sets = nodeSets[setNodes[iSet][iNode]];
+      setNeighbours.insert(setNeighbours.end(), sets.begin(), sets.end());
+    }
+    sort(setNeighbours.begin(), setNeighbours.end());
+    setNeighbours.erase(unique(setNeighbours.begin(), setNeighbours.end()), setNeighbours.end());
+  }
+
+  // greedy colouring: a states set gets the first colour not used by the
+  // states sets within ColouringLayers layers of neighbours
+  const CFuint nbLayers = std::max<CFuint>(getMethodData().getColouringLayers(), 1);
+  vector< CFint > colour(nbrStatesSets, -1);
+  vector< CFuint > visited(nbrStatesSets, 0);
+  vector< CFuint > colourUsed;
+  vector< CFuint > front;
+  vector< CFuint > nextFront;
+  CFuint nbColours = 0;
+  for (CFuint iSet = 0; iSet < nbrStatesSets; ++iSet)
+  {
+    if (!isStatesSetParUpdatable[iSet]) continue;
+
+    const CFuint stamp = iSet + 1;
+    visited[iSet] = stamp;
+    front.assign(1, iSet);
+    for (CFuint iLayer = 0; iLayer < nbLayers && !front.empty(); ++iLayer)
+    {
+      nextFront.clear();
+      for (CFuint f = 0; f < front.size(); ++f)
+      {
+        const vector< CFuint >& setNeighbours = neighbours[front[f]];
+        for (CFuint n = 0; n < setNeighbours.size(); ++n)
+        {
+          const CFuint jSet = setNeighbours[n];
+          if (visited[jSet] == stamp) continue;
+          visited[jSet] = stamp;
+          nextFront.push_back(jSet);
+          if (colour[jSet] >= 0) colourUsed[colour[jSet]] = stamp;
+        }
+      }
+      front.swap(nextFront);
+    }
+
+    CFuint c = 0;
+    while (c < nbColours && colourUsed[c] == stamp) ++c;
+    if (c == nbColours)
+    {
+      ++nbColours;
+      colourUsed.push_back(0);
+    }
+    colour[iSet] = c;
+  }
+
+  vector< vector< CFuint > >& colours = getMethodData().getStatesSetsColours();
+  colours.assign(nbColours, vector< CFuint >());
+  for (CFuint iSet = 0; iSet < nbrStatesSets; ++iSet)
+  {
+    if (colour[iSet] >= 0) colours[colour[iSet]].push_back(iSet);
+  }
+
+  CFLog(INFO, "ColouredSweep: " << nbrStatesSets << " states sets in "
+        << nbColours << " colours\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+vector<SafePtr<BaseDataSocketSink> > ColouredSweep::needsSockets()
+{
+  vector<SafePtr<BaseDataSocketSink> > result;
+
+  result.push_back(&socket_statesSetIdx);
+  result.push_back(&socket_states);
+  result.push_back(&socket_statesSetStateIDs);
+  result.push_back(&socket_isStatesSetParUpdatable);
+
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace LUSGSMethod
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
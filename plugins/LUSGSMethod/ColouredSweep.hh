@@ -0,0 +1,111 @@
+#ifndef COOLFluiD_Numerics_LUSGSMethod_ColouredSweep_hh
+#define COOLFluiD_Numerics_LUSGSMethod_ColouredSweep_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "LUSGSMethod/LUSGSIteratorData.hh"
+#include "Framework/DataSocketSink.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework { class State; }
+
+  namespace Numerics {
+
+    namespace LUSGSMethod {
+
+//////////////////////////////////////////////////////////////////////////////
+
+  /**
+   * This class performs a forward or backward sweep over the states sets
+   * colour by colour. Two states sets of the same colour are not coupled
+   * within ColouringLayers layers of cells sharing a node, so that the
+   * result of the sweep does not depend on the order of the states sets
+   * within a colour. Each states set is processed as in the states set by
+   * states set sweep, with the configured ComputeSolUpdate and UpdateSol
+   * commands. The states sets of a colour are not processed concurrently,
+   * since the space method commands computing their residual are not
+   * reentrant.
+   */
+class ColouredSweep : public LUSGSIteratorCom {
+public:
+
+  /**
+   * Constructor.
+   */
+  explicit ColouredSweep(std::string name);
+
+  /**
+   * Destructor.
+   */
+  ~ColouredSweep() {}
+
+  /**
+   * Execute Processing actions
+   */
+  void execute();
+
+  /**
+   * Returns the DataSocket's that this command needs as sinks.
+   * @return a vector of SafePtr with the DataSockets
+   */
+  virtual std::vector<Common::SafePtr<Framework::BaseDataSocketSink> > needsSockets();
+
+  /**
+   * Setup private data and data of the aggregated classes
+   * in this command before processing phase
+   */
+  virtual void setup();
+
+  /**
+   * Set the commands computing and applying the update of a states set
+   * @param computeSolUpdate command solving for the update of a states set
+   * @param updateSol        command adding the update to the states
+   */
+  void setStatesSetUpdateComs(Common::SafePtr<LUSGSIteratorCom> computeSolUpdate,
+                              Common::SafePtr<LUSGSIteratorCom> updateSol);
+
+private: // functions
+
+  /**
+   * Colour the parallel updatable states sets with a greedy algorithm
+   */
+  void colourStatesSets();
+
+private: // data
+
+  /// socket for current states set index
+  Framework::DataSocketSink< CFint > socket_statesSetIdx;
+
+  /// socket for the states
+  Framework::DataSocketSink< Framework::State*, Framework::GLOBAL > socket_states;
+
+  /// socket for the IDs of the states in each states set
+  Framework::DataSocketSink< std::vector< CFuint > > socket_statesSetStateIDs;
+
+  /// handle to list of booleans telling whether a states set is parallel updatable
+  Framework::DataSocketSink< bool > socket_isStatesSetParUpdatable;
+
+  /// command solving for the update of a states set
+  Common::SafePtr<LUSGSIteratorCom> m_computeSolUpdate;
+
+  /// command adding the update of a states set to its states
+  Common::SafePtr<LUSGSIteratorCom> m_updateSol;
+
+}; // class ColouredSweep
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace LUSGSMethod
+
+  } // namespace Numerics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Numerics_LUSGSMethod_ColouredSweep_hh
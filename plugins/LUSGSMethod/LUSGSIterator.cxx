@@ -10,6 +10,7 @@
 
 #include "LUSGSMethod/LUSGSMethod.hh"
 #include "LUSGSMethod/LUSGSIterator.hh"
+#include "LUSGSMethod/ColouredSweep.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -48,6 +49,7 @@ void LUSGSIterator::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< std::string >("LUFactorization","Command to perform the LU factorization.");
   options.addConfigOption< std::string >("ComputeSolUpdate","Command to solve the two triangular systems after the LU factorization.");
   options.addConfigOption< std::string >("ComputeJacobians","Command for the computation of the diagonal block Jacobians.");
+  options.addConfigOption< std::string >("ColouredSweepCom","Command to sweep the states sets colour by colour (if UseColouring).");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -91,6 +93,9 @@ LUSGSIterator::LUSGSIterator(const std::string& name)
 
   m_diagBlockJacobComputerStr = "DiagBlockJacobMatrByPert";
   setParameter("ComputeJacobians",&m_diagBlockJacobComputerStr);
+
+  m_colouredSweepStr = "ColouredSweep";
+  setParameter("ColouredSweepCom",&m_colouredSweepStr);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -148,6 +153,15 @@ void LUSGSIterator::configure ( Config::ConfigArgs& args )
 
   configureCommand<LUSGSIteratorData,LUSGSIteratorComProvider>( args, m_diagBlockJacobComputer,m_diagBlockJacobComputerStr,m_data);
 
+  configureCommand<LUSGSIteratorData,LUSGSIteratorComProvider>( args, m_colouredSweep,m_colouredSweepStr,m_data);
+
+  // the coloured sweep applies the configured solution update commands
+  ColouredSweep* colouredSweep = dynamic_cast<ColouredSweep*>(m_colouredSweep.getPtr());
+  if (colouredSweep != CFNULL)
+  {
+    colouredSweep->setStatesSetUpdateComs(m_computeStatesSetUpdate.getPtr(), m_updateSol.getPtr());
+  }
+
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -263,8 +277,16 @@ void LUSGSIterator::takeStepImpl()
     CFLog(VERBOSE,"LUSGSIterator::takeStep(): starting forward sweep\n");
     m_data->setForwardSweep(true);
     m_data->setStopSweep(false);
-    // Update states set index (it is equal to -1 at this point)
-    m_updateStatesSetIndex->execute();
+    if (m_data->useColouring())
+    {
+      // sweep the states sets colour by colour
+      m_colouredSweep->execute();
+    }
+    else
+    {
+      // Update states set index (it is equal to -1 at this point)
+      m_updateStatesSetIndex->execute();
+    }
     for (;!m_data->stopSweep();)
     {
       // Compute space residual for the current states set
@@ -293,8 +315,16 @@ void LUSGSIterator::takeStepImpl()
     CFLog(VERBOSE,"LUSGSIterator::takeStep(): starting backward sweep\n");
     m_data->setForwardSweep(false);
     m_data->setStopSweep(false);
-    // Update states set index (it is equal to the number of states sets at this point)
-    m_updateStatesSetIndex->execute();
+    if (m_data->useColouring())
+    {
+      // sweep the states sets colour by colour, adding the norm contributions
+      m_colouredSweep->execute();
+    }
+    else
+    {
+      // Update states set index (it is equal to the number of states sets at this point)
+      m_updateStatesSetIndex->execute();
+    }
     for (;!m_data->stopSweep();)
     {
       // Compute space residual for the current states set
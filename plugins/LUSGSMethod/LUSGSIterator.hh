@@ -132,6 +132,9 @@ protected: // member data
   ///The command that computes the diagonal block Jacobians by perturbation of the states
   Common::SelfRegistPtr<LUSGSIteratorCom> m_diagBlockJacobComputer;
 
+  /// Command used to sweep the states sets colour by colour
+  Common::SelfRegistPtr<LUSGSIteratorCom> m_colouredSweep;
+
   ///The string for configuration of m_setup command
   std::string m_setupStr;
 
@@ -165,6 +168,9 @@ protected: // member data
   ///The string for configuration of m_diagBlockJacobComputer command
   std::string m_diagBlockJacobComputerStr;
 
+  ///The string for configuration of m_colouredSweep command
+  std::string m_colouredSweepStr;
+
   ///The data to share between LUSGSMethodMethod commands
   Common::SharedPtr<LUSGSIteratorData> m_data;
 
@@ -29,6 +29,8 @@ void LUSGSIteratorData::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< bool >("PrintHistory","Print convergence history for each (nonlinear) LU-SGS Iterator step");
    options.addConfigOption< vector<CFuint> >("JacobFreezFreq","Number of time-steps to perform in the (nonlinear) LU-SGS iterator before to recompute the block Jacobian matrices.");
    options.addConfigOption< vector<CFuint> >("MaxSweepsPerStep","Maximum number of sweeps to perform in one LU-SGS step.");
+   options.addConfigOption< bool >("UseColouring","Sweep the states sets colour by colour, the states sets of a colour being independent.");
+   options.addConfigOption< CFuint >("ColouringLayers","Number of layers of neighbouring cells coupled to a states set in the colouring (2 if the residual uses the gradients of the neighbours).");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -45,7 +47,8 @@ LUSGSIteratorData::LUSGSIteratorData(Common::SafePtr<Framework::Method> owner)
     m_beforePertResComputation(),
     m_nbrStatesSets(),
     m_resAux(),
-    m_withPivot()
+    m_withPivot(),
+    m_statesSetsColours()
 {
   addConfigOptionsTo(this);
 
@@ -60,6 +63,12 @@ LUSGSIteratorData::LUSGSIteratorData(Common::SafePtr<Framework::Method> owner)
 
   m_printHistory = false;
   setParameter("PrintHistory",&m_printHistory);
+
+  m_useColouring = false;
+  setParameter("UseColouring",&m_useColouring);
+
+  m_colouringLayers = 2;
+  setParameter("ColouringLayers",&m_colouringLayers);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -257,6 +257,30 @@ public: // functions
     m_withPivot = withPivot;
   }
 
+  /**
+   * @return true if the states sets are swept colour by colour
+   */
+  bool useColouring() const
+  {
+    return m_useColouring;
+  }
+
+  /**
+   * @return the number of layers of neighbouring cells coupled to a states set
+   */
+  CFuint getColouringLayers() const
+  {
+    return m_colouringLayers;
+  }
+
+  /**
+   * @return the parallel updatable states sets of each colour
+   */
+  std::vector< std::vector< CFuint > >& getStatesSetsColours()
+  {
+    return m_statesSetsColours;
+  }
+
 private: // data
 
   /// Functor that computes the requested norm specific for LUSGSMethod
@@ -304,6 +328,15 @@ private: // data
   /// boolean telling whether pivotation is used
   bool m_withPivot;
 
+  /// flag telling to sweep the states sets colour by colour
+  bool m_useColouring;
+
+  /// number of layers of neighbouring cells coupled to a states set
+  CFuint m_colouringLayers;
+
+  /// parallel updatable states sets of each colour
+  std::vector< std::vector< CFuint > > m_statesSetsColours;
+
 }; // end of class LUSGSIteratorData
 
 //////////////////////////////////////////////////////////////////////////////
@@ -159,19 +159,30 @@ void ComputeWallDistance::printToFile()
 
   using namespace boost::filesystem;
 
-  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
-  DataHandle< CFreal> wallDistance = socket_wallDistance.getDataHandle();
-
   path file = Environment::DirPaths::getInstance().getResultsDir() / path(_nameOutputFile);
 //   path file = Environment::DirPaths::getInstance().getWorkingDir() / path(_nameOutputFile);
   file = Framework::PathAppender::getInstance().appendParallel( file );
   change_extension(file,".dat");
+  
+  printToFile(file);
+}
+
+//////////////////////////////////////////////////////////////////////////////
 
+void ComputeWallDistance::printToFile(const boost::filesystem::path& file)
+{
+  CFAUTOTRACE;
+  
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle< CFreal> wallDistance = socket_wallDistance.getDataHandle();
+  
   SelfRegistPtr<Environment::FileHandlerOutput> fhandle = Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
   ofstream& fout = fhandle->open(file);
 
   const CFuint dim = Framework::PhysicalModelStack::getActive()->getDim();
-
+  
+  // enough digits for the file to be read back as a cache
+  fout.precision(12);
   fout << "!WALLDISTANCE" << endl;
   fout << "!NBSTATES " << wallDistance.size() << endl;
 
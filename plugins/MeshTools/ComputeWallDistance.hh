@@ -83,6 +83,11 @@ protected: //function
    * Outputs the quality of the cells to a file
    */
   void printToFile();
+  
+  /**
+   * Outputs the wall distance of the states to the given file
+   */
+  void printToFile(const boost::filesystem::path& file);
 
 protected: //data
 
@@ -22,8 +22,12 @@
 
 #include <vector>
 #include <cmath>
+#include "Environment/DirPaths.hh"
+#include "Framework/PathAppender.hh"
 #include "MeshTools/MeshToolsFVM.hh"
 #include "MeshTools/ComputeWallDistanceVector2CCMPI.hh"
+#include "MeshTools/ReadWallDistance.hh"
+#include "MeshTools/WallFaceTree.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -50,6 +54,10 @@ void ComputeWallDistanceVector2CCMPI::defineConfigOptions(Config::OptionList& op
    options.addConfigOption< bool >
      ("CentroidBased", "Flag to select algorithm based on wall face centroid (limited usability!).");
    options.addConfigOption< CFreal >("AcceptableDistance","Distance");
+   options.addConfigOption< bool >
+     ("UseTree", "Flag to compute the exact distance to the wall faces gathered from all processors in a bounding volume hierarchy.");
+   options.addConfigOption< std::string >
+     ("CacheFile", "Name of the file (one per processor) where to read the wall distance if it exists or to write it otherwise; it is recomputed and rewritten if its states do not match the local states.");
 
 
 }
@@ -70,6 +78,12 @@ ComputeWallDistanceVector2CCMPI::ComputeWallDistanceVector2CCMPI(const std::stri
   setParameter("CentroidBased",&m_centroidBased);
   m_acceptableDistance = 0.;
   setParameter("AcceptableDistance",&m_acceptableDistance);
+  
+  m_useTree = false;
+  setParameter("UseTree",&m_useTree);
+  
+  m_cacheFile = "";
+  setParameter("CacheFile",&m_cacheFile);
 
 }
     
@@ -126,9 +140,196 @@ void ComputeWallDistanceVector2CCMPI::execute()
 {
   CFAUTOTRACE;
   
+  using namespace boost::filesystem;
+  
   // this has only to be run at setup for now
   CFLog(VERBOSE, "ComputeWallDistanceVector2CCMPI::execute() START\n");
   
+  path cacheFile;
+  if (m_cacheFile != "") {
+    cacheFile = Environment::DirPaths::getInstance().getWorkingDir() / path(m_cacheFile);
+    cacheFile = PathAppender::getInstance().appendParallel(cacheFile);
+    
+    // the cache is used only if all the processors have it
+    int cacheExists = exists(cacheFile) ? 1 : 0;
+#ifdef CF_HAVE_MPI
+    int allCacheExist = 0;
+    MPI_Allreduce(&cacheExists, &allCacheExist, 1, MPI_INT, MPI_MIN, m_comm);
+    cacheExists = allCacheExist;
+#endif
+    
+    if (cacheExists == 1) {
+      CFLog(INFO, "ComputeWallDistanceVector2CCMPI::execute() => Reading distance to the wall from "
+	    << cacheFile.string() << "\n");
+      DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+      DataHandle<CFreal> wallDistance = socket_wallDistance.getDataHandle();
+      
+      // the cache is valid only if it was written for the same local states
+      // (same mesh, partition and local numbering) on all the processors
+      int cacheValid = ReadWallDistance::readFromFile(cacheFile, wallDistance, &states) ? 1 : 0;
+#ifdef CF_HAVE_MPI
+      int allCacheValid = 0;
+      MPI_Allreduce(&cacheValid, &allCacheValid, 1, MPI_INT, MPI_MIN, m_comm);
+      cacheValid = allCacheValid;
+#endif
+      
+      if (cacheValid == 1) {
+	updateNodeDistance();
+	return;
+      }
+      
+      CFLog(WARN, "ComputeWallDistanceVector2CCMPI::execute() => " << m_cacheFile 
+	    << " does not match the current mesh partition: recomputing distance to the wall\n");
+      wallDistance = MathTools::MathConsts::CFrealMax();
+    }
+  }
+  
+  if (m_useTree) {
+    executeTree();
+  }
+  else {
+    executeBroadcast();
+  }
+  
+  if (m_cacheFile != "") {
+    printToFile(cacheFile);
+  }
+  
+  CFLog(VERBOSE, "ComputeWallDistanceVector2CCMPI::execute() END\n");
+}
+    
+//////////////////////////////////////////////////////////////////////////////
+
+void ComputeWallDistanceVector2CCMPI::executeTree()
+{
+  CFAUTOTRACE;
+  
+  CFLog(INFO, "ComputeWallDistanceVector2CCMPI::executeTree() => Computing distance to the wall ...\n");
+  
+  Stopwatch<WallTime> stp;
+  stp.start();
+  
+  DataHandle < Framework::Node*, Framework::GLOBAL > nodes = socket_nodes.getDataHandle();
+  DataHandle < Framework::State*, Framework::GLOBAL > states = socket_states.getDataHandle();
+  DataHandle< CFreal> wallDistance = socket_wallDistance.getDataHandle();
+  const CFuint dim = PhysicalModelStack::getActive()->getDim();
+  cf_always_assert(_boundaryTRS.size() > 0);
+  cf_always_assert(dim == DIM_2D || dim == DIM_3D);
+  
+  // store the node coordinates of the local wall faces, face after face
+  vector<CFreal> faceCoords;
+  vector<CFuint> nbNodesInFace;
+  for(CFuint iTRS = 0; iTRS < _boundaryTRS.size(); ++iTRS) {
+    SafePtr<TopologicalRegionSet> faces = MeshDataStack::getActive()->getTrs(_boundaryTRS[iTRS]);
+    const CFuint nbLocalTrsFaces = faces->getLocalNbGeoEnts();
+    for (CFuint iFace = 0; iFace < nbLocalTrsFaces; ++iFace) {
+      const CFuint nbNodesInGeo = faces->getNbNodesInGeo(iFace);
+      cf_assert((nbNodesInGeo == 2 && dim == DIM_2D) || 
+		((nbNodesInGeo == 3 || nbNodesInGeo == 4) && dim == DIM_3D)); 
+      nbNodesInFace.push_back(nbNodesInGeo);
+      for (CFuint iNode = 0; iNode < nbNodesInGeo; ++iNode) {
+	const CFuint nodeID = faces->getNodeID(iFace, iNode);
+	for (CFuint iDim = 0; iDim < dim; ++iDim) {
+	  faceCoords.push_back((*nodes[nodeID])[iDim]);
+	}
+      }
+    }
+  }
+  
+#ifdef CF_HAVE_MPI
+  // all the processors get the wall faces of all the others at once
+  if (m_nbProc > 1) {
+    int localSizes[2];
+    localSizes[0] = nbNodesInFace.size();
+    localSizes[1] = faceCoords.size();
+    vector<int> sizes(2*m_nbProc);
+    MPI_Allgather(&localSizes[0], 2, MPI_INT, &sizes[0], 2, MPI_INT, m_comm);
+    
+    vector<int> faceCounts(m_nbProc);
+    vector<int> faceDispls(m_nbProc, 0);
+    vector<int> coordCounts(m_nbProc);
+    vector<int> coordDispls(m_nbProc, 0);
+    for (CFuint p = 0; p < m_nbProc; ++p) {
+      faceCounts[p] = sizes[2*p];
+      coordCounts[p] = sizes[2*p+1];
+      if (p > 0) {
+	faceDispls[p] = faceDispls[p-1] + faceCounts[p-1];
+	coordDispls[p] = coordDispls[p-1] + coordCounts[p-1];
+      }
+    }
+    
+    vector<CFuint> allNbNodesInFace(faceDispls[m_nbProc-1] + faceCounts[m_nbProc-1]);
+    vector<CFreal> allFaceCoords(coordDispls[m_nbProc-1] + coordCounts[m_nbProc-1]);
+    CFuint dummyUInt = 0;
+    CFreal dummyReal = 0.;
+    MPI_Allgatherv((nbNodesInFace.size() > 0) ? &nbNodesInFace[0] : &dummyUInt, localSizes[0], 
+		   MPIStructDef::getMPIType(&dummyUInt), 
+		   (allNbNodesInFace.size() > 0) ? &allNbNodesInFace[0] : &dummyUInt, 
+		   &faceCounts[0], &faceDispls[0], MPIStructDef::getMPIType(&dummyUInt), m_comm);
+    MPI_Allgatherv((faceCoords.size() > 0) ? &faceCoords[0] : &dummyReal, localSizes[1], 
+		   MPIStructDef::getMPIType(&dummyReal), 
+		   (allFaceCoords.size() > 0) ? &allFaceCoords[0] : &dummyReal, 
+		   &coordCounts[0], &coordDispls[0], MPIStructDef::getMPIType(&dummyReal), m_comm);
+    
+    nbNodesInFace.swap(allNbNodesInFace);
+    faceCoords.swap(allFaceCoords);
+  }
+#endif
+  
+  WallFaceTree tree;
+  tree.build(dim, faceCoords, nbNodesInFace);
+  vector<CFreal>().swap(faceCoords);
+  
+  CFLog(VERBOSE, "ComputeWallDistanceVector2CCMPI::executeTree() => " << nbNodesInFace.size() 
+	<< " wall faces, tree built in " << stp.read() << "s\n");
+  
+  // the tree is only read: the states can be processed concurrently
+  const CFint nbStates = states.size();
+#ifdef CF_HAVE_OMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+  for (CFint iState = 0; iState < nbStates; ++iState) {
+    RealVector& stateCoord = states[iState]->getCoordinates();
+    wallDistance[iState] = tree.computeDistance(stateCoord.ptr());
+  }
+  
+  updateNodeDistance();
+  
+  CFLog(INFO, "ComputeWallDistanceVector2CCMPI::executeTree() => took " << stp.read() << "s\n");
+  
+  if (m_nbProc == 1) {
+    printToFile();
+  }
+}
+    
+//////////////////////////////////////////////////////////////////////////////
+
+void ComputeWallDistanceVector2CCMPI::updateNodeDistance()
+{
+  DataHandle< CFreal> wallDistance = socket_wallDistance.getDataHandle();
+  DataHandle <bool> nodeisAD = socket_nodeisAD.getDataHandle();
+  DataHandle <CFreal> nodeDistance = socket_nodeDistance.getDataHandle();
+  SafePtr<TopologicalRegionSet> cells = MeshDataStack::getActive()->getTrs("InnerCells");
+  
+  // each node takes the smallest distance among the cells sharing it
+  const CFuint nbStates = wallDistance.size();
+  for (CFuint iState = 0; iState < nbStates; ++iState) {
+    const CFuint nbNodesInCell = cells->getNbNodesInGeo(iState);
+    for (CFuint in = 0; in < nbNodesInCell; ++in) {
+      const CFuint cellNodeID = cells->getNodeID(iState, in);
+      cf_assert(cellNodeID < nodeisAD.size());
+      nodeDistance[cellNodeID] = std::min(nodeDistance[cellNodeID], wallDistance[iState]);
+      nodeisAD[cellNodeID] = (nodeDistance[cellNodeID] < m_acceptableDistance);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void ComputeWallDistanceVector2CCMPI::executeBroadcast()
+{
+  CFAUTOTRACE;
+  
   const CFuint dim = PhysicalModelStack::getActive()->getDim();
   
   // AL: gory fix to use centroid-based algorithm 
@@ -288,8 +489,6 @@ void ComputeWallDistanceVector2CCMPI::execute()
   if (m_nbProc == 1) {
     printToFile();
   }  
-  
-  CFLog(VERBOSE, "ComputeWallDistanceVector2CCMPI::execute() END\n");
 }
     
 //////////////////////////////////////////////////////////////////////////////
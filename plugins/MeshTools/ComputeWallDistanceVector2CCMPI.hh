@@ -84,6 +84,23 @@ public:
   };
   
   
+  /**
+   * Compute the wall distance by broadcasting the wall faces of 
+   * each processor in turn
+   */
+  void executeBroadcast();
+  
+  /**
+   * Compute the exact wall distance by gathering all the wall faces 
+   * in a bounding volume hierarchy
+   */
+  void executeTree();
+  
+  /**
+   * Set the distance and the flag of the nodes from the state wall distance
+   */
+  void updateNodeDistance();
+  
   void execute3D();
   
   /**
@@ -143,6 +160,12 @@ private:
   /// Define the acceptable distance  
  
   CFreal m_acceptableDistance;
+  
+  /// flag to compute the exact distance with a bounding volume hierarchy
+  bool m_useTree;
+  
+  /// name of the file where the wall distance is cached
+  std::string m_cacheFile;
   }; // end of class ComputeWallDistanceVector2CCMPI
 
 //////////////////////////////////////////////////////////////////////////////
@@ -115,12 +115,23 @@ void ReadWallDistance::execute()
   // Read the file and fill in the wallDistance datahandle
   DataHandle< CFreal> wallDistance = socket_wallDistance.getDataHandle();
 
-  const CFuint nbStates = wallDistance.size();
-
   path file = Environment::DirPaths::getInstance().getWorkingDir() / path(_nameInputFile);
   file = Framework::PathAppender::getInstance().appendParallel( file );
   change_extension(file,".dat");
 
+  readFromFile(file, wallDistance);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool ReadWallDistance::readFromFile(const boost::filesystem::path& file,
+				    DataHandle<CFreal>& wallDistance,
+				    const DataHandle<State*, GLOBAL>* states)
+{
+  CFAUTOTRACE;
+  
+  const CFuint nbStates = wallDistance.size();
+  
   SelfRegistPtr<Environment::FileHandlerInput> fhandle = Environment::SingleBehaviorFactory<Environment::FileHandlerInput>::getInstance().create();
   ifstream& fin = fhandle->open(file);
 
@@ -154,6 +165,10 @@ void ReadWallDistance::execute()
   // Check agreement of the number of states
   CFuint nbStatesRead = Common::StringOps::from_str<CFint>(words[1]);
   if(nbStatesRead != nbStates){
+    if (states != CFNULL) {
+      fhandle->close();
+      return false;
+    }
     throw BadFormatException (FromHere(),"Number of states in file " + file.string() + " differs from number of number of states in mesh");
   }
 
@@ -163,9 +178,6 @@ void ReadWallDistance::execute()
   getline(fin,line);
   words = Common::StringOps::getWords(line);
 
-  CFreal temp;
-  CFuint ID;
-
   if( nbDim == 2 ){
     if(words.size() != 5) {
       throw BadFormatException (FromHere(),"Wrong number of parameters in 3rd line of file: " + file.string() + "   Surely in 2D?") ;
@@ -176,16 +188,8 @@ void ReadWallDistance::execute()
     if(words[2] != "x1")         throw BadFormatException (FromHere(),"Expecting 'x1' in 3rd line of " + file.string());
     if(words[3] != "StateID")    throw BadFormatException (FromHere(),"Expecting 'StateID' identifier in 3rd line of " + file.string());
     if(words[4] != "Distance")   throw BadFormatException (FromHere(),"Expecting 'Distance' identifier in 3rd line of " + file.string());
-
-    //Read the wall distances
-    for (CFuint i = 0; i < nbStates; ++i) {
-      // due to new format of distance file some arguments are redundant
-      fin >> temp >> temp >> ID; // coordinate x0 -- coordinate x1 -- ID of state
-      fin >> wallDistance[ID];
-    }
   }
 
-
   if( nbDim == 3 ){
     if(words.size() != 6) {
       throw BadFormatException (FromHere(),"Wrong number of parameters in 3rd line of file: " + file.string() + "   Surely in 3D?") ;
@@ -197,15 +201,37 @@ void ReadWallDistance::execute()
     if(words[3] != "x2")         throw BadFormatException (FromHere(),"Expecting 'x2' in 3rd line of " + file.string());
     if(words[4] != "StateID")    throw BadFormatException (FromHere(),"Expecting 'StateID' identifier in 3rd line of " + file.string());
     if(words[5] != "Distance")   throw BadFormatException (FromHere(),"Expecting 'Distance' identifier in 3rd line of " + file.string());
+  }
 
-    //Read the wall distances
-    for (CFuint i = 0; i < nbStates; ++i) {
-      fin >> temp >> temp >> temp >> ID; // coordinate x0 -- coordinate x1 -- coordinate x2 -- ID of state
-      fin >> wallDistance[ID];
+  //Read the wall distances: each line has the coordinates of the state, its ID 
+  // and its distance
+  CFreal coord[3];
+  CFuint ID;
+  for (CFuint i = 0; i < nbStates; ++i) {
+    for (CFuint iDim = 0; iDim < nbDim; ++iDim) {
+      fin >> coord[iDim];
+    }
+    fin >> ID;
+    if (!fin || ID >= nbStates) {
+      throw BadFormatException (FromHere(),"Wrong state entry in file " + file.string());
+    }
+    fin >> wallDistance[ID];
+    
+    // the states must be the ones of the file (same mesh, same partition and 
+    // same local numbering), up to the digits written in the file
+    if (states != CFNULL) {
+      const RealVector& stateCoord = (*states)[ID]->getCoordinates();
+      for (CFuint iDim = 0; iDim < nbDim; ++iDim) {
+	if (std::abs(coord[iDim] - stateCoord[iDim]) > 1e-9*std::max(std::abs(stateCoord[iDim]), 1.)) {
+	  fhandle->close();
+	  return false;
+	}
+      }
     }
   }
   
   fhandle->close();
+  return true;
 }
 
 //////////////////////////////////////////////////////////////////////////////
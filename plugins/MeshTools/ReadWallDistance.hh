@@ -83,6 +83,19 @@ public:
    * Configures this object with supplied arguments.
    */
   virtual void configure ( Config::ConfigArgs& args );
+  
+  /**
+   * Read the wall distance of the local states from a file written by
+   * ComputeWallDistance
+   * @param file         path of the file
+   * @param wallDistance storage to fill in, already resized to the number of states
+   * @param states       if given, the states whose coordinates must match the
+   *                     ones in the file
+   * @return false if the states are given and do not match the file
+   */
+  static bool readFromFile(const boost::filesystem::path& file,
+			   Framework::DataHandle<CFreal>& wallDistance,
+			   const Framework::DataHandle<Framework::State*, Framework::GLOBAL>* states = CFNULL);
 
 private: //data
 
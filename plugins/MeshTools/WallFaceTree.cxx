@@ -0,0 +1,321 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cmath>
+
+#include "MathTools/MathConsts.hh"
+
+#include "MeshTools/WallFaceTree.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MeshTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// maximum number of primitives in a leaf
+static const CFuint maxNbPrimsInLeaf = 4;
+
+/// helper functions for 3D vectors
+static inline CFreal dot3(const CFreal* a, const CFreal* b)
+{
+  return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+static inline void sub3(const CFreal* a, const CFreal* b, CFreal* c)
+{
+  c[0] = a[0] - b[0]; c[1] = a[1] - b[1]; c[2] = a[2] - b[2];
+}
+
+/// comparison of the primitive centroids along one direction
+struct CentroidLess {
+  CFuint axis;
+  template <typename PRIM>
+  bool operator()(const PRIM& a, const PRIM& b) const
+  {
+    CFreal ca = 0.;
+    CFreal cb = 0.;
+    for (CFuint n = 0; n < a.nbNodes; ++n) {ca += a.p[n][axis];}
+    for (CFuint n = 0; n < b.nbNodes; ++n) {cb += b.p[n][axis];}
+    return ca/a.nbNodes < cb/b.nbNodes;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+WallFaceTree::WallFaceTree() :
+  m_dim(0),
+  m_prims(),
+  m_nodes()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+WallFaceTree::~WallFaceTree()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void WallFaceTree::build(const CFuint dim,
+			 const std::vector<CFreal>& coords,
+			 const std::vector<CFuint>& nbNodesInFace)
+{
+  cf_assert(dim == DIM_2D || dim == DIM_3D);
+  m_dim = dim;
+  m_prims.clear();
+  m_nodes.clear();
+
+  const CFuint nbFaces = nbNodesInFace.size();
+  m_prims.reserve(nbFaces*(dim == DIM_3D ? 2 : 1));
+
+  Primitive prim;
+  CFuint start = 0;
+  for (CFuint iFace = 0; iFace < nbFaces; ++iFace) {
+    const CFuint nbNodes = nbNodesInFace[iFace];
+    cf_assert(start + nbNodes*dim <= coords.size());
+    const CFreal* faceCoords = &coords[start];
+
+    // quadrilaterals are split along the diagonal 0-2
+    const CFuint nbSubFaces = (nbNodes == 4) ? 2 : 1;
+    for (CFuint iSub = 0; iSub < nbSubFaces; ++iSub) {
+      prim.nbNodes = (nbNodes == 2) ? 2 : 3;
+      for (CFuint n = 0; n < prim.nbNodes; ++n) {
+	const CFuint nodeID = (iSub == 0) ? n : ((n == 0) ? 0 : n+1);
+	for (CFuint iDim = 0; iDim < 3; ++iDim) {
+	  prim.p[n][iDim] = (iDim < dim) ? faceCoords[nodeID*dim + iDim] : 0.;
+	}
+      }
+      m_prims.push_back(prim);
+    }
+    start += nbNodes*dim;
+  }
+  cf_assert(start == coords.size());
+
+  if (m_prims.size() > 0) {
+    m_nodes.reserve(2*(m_prims.size()/maxNbPrimsInLeaf + 1));
+    m_nodes.push_back(TreeNode());
+    buildNode(0, 0, m_prims.size());
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void WallFaceTree::buildNode(CFuint nodeID, CFuint begin, CFuint end)
+{
+  cf_assert(end > begin);
+
+  // bounding box of the primitives and of their centroids
+  CFreal bmin[3], bmax[3], cmin[3], cmax[3];
+  for (CFuint iDim = 0; iDim < 3; ++iDim) {
+    bmin[iDim] = cmin[iDim] = MathTools::MathConsts::CFrealMax();
+    bmax[iDim] = cmax[iDim] = -MathTools::MathConsts::CFrealMax();
+  }
+
+  for (CFuint i = begin; i < end; ++i) {
+    const Primitive& prim = m_prims[i];
+    for (CFuint iDim = 0; iDim < 3; ++iDim) {
+      CFreal c = 0.;
+      for (CFuint n = 0; n < prim.nbNodes; ++n) {
+	bmin[iDim] = std::min(bmin[iDim], prim.p[n][iDim]);
+	bmax[iDim] = std::max(bmax[iDim], prim.p[n][iDim]);
+	c += prim.p[n][iDim];
+      }
+      c /= prim.nbNodes;
+      cmin[iDim] = std::min(cmin[iDim], c);
+      cmax[iDim] = std::max(cmax[iDim], c);
+    }
+  }
+
+  for (CFuint iDim = 0; iDim < 3; ++iDim) {
+    m_nodes[nodeID].bmin[iDim] = bmin[iDim];
+    m_nodes[nodeID].bmax[iDim] = bmax[iDim];
+  }
+
+  if (end - begin <= maxNbPrimsInLeaf) {
+    m_nodes[nodeID].first = begin;
+    m_nodes[nodeID].nbPrims = end - begin;
+    return;
+  }
+
+  // split at the median of the centroids along the longest direction
+  CentroidLess comp;
+  comp.axis = 0;
+  for (CFuint iDim = 1; iDim < 3; ++iDim) {
+    if (cmax[iDim] - cmin[iDim] > cmax[comp.axis] - cmin[comp.axis]) {
+      comp.axis = iDim;
+    }
+  }
+
+  const CFuint mid = (begin + end)/2;
+  std::nth_element(m_prims.begin() + begin, m_prims.begin() + mid,
+		   m_prims.begin() + end, comp);
+
+  // the children are stored next to each other
+  const CFuint children = m_nodes.size();
+  m_nodes[nodeID].first = children;
+  m_nodes[nodeID].nbPrims = 0;
+  m_nodes.push_back(TreeNode());
+  m_nodes.push_back(TreeNode());
+
+  buildNode(children, begin, mid);
+  buildNode(children+1, mid, end);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal WallFaceTree::computeDistance(const CFreal* point) const
+{
+  if (m_nodes.size() == 0) return MathTools::MathConsts::CFrealMax();
+
+  CFreal p[3] = {0., 0., 0.};
+  for (CFuint iDim = 0; iDim < m_dim; ++iDim) {
+    p[iDim] = point[iDim];
+  }
+
+  CFreal minDist2 = MathTools::MathConsts::CFrealMax();
+
+  // depth-first traversal, visiting the closest child first
+  CFuint stack[128];
+  CFuint top = 0;
+  stack[top++] = 0;
+  while (top > 0) {
+    const TreeNode& node = m_nodes[stack[--top]];
+    if (boxDistance2(p, node) >= minDist2) continue;
+
+    if (node.nbPrims > 0) {
+      for (CFuint i = node.first; i < node.first + node.nbPrims; ++i) {
+	minDist2 = std::min(minDist2, distance2(p, m_prims[i]));
+      }
+    }
+    else {
+      const CFreal d0 = boxDistance2(p, m_nodes[node.first]);
+      const CFreal d1 = boxDistance2(p, m_nodes[node.first+1]);
+      cf_assert(top + 2 <= 128);
+      if (d0 < d1) {
+	if (d1 < minDist2) stack[top++] = node.first+1;
+	if (d0 < minDist2) stack[top++] = node.first;
+      }
+      else {
+	if (d0 < minDist2) stack[top++] = node.first;
+	if (d1 < minDist2) stack[top++] = node.first+1;
+      }
+    }
+  }
+
+  return std::sqrt(minDist2);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal WallFaceTree::boxDistance2(const CFreal* p, const TreeNode& node)
+{
+  CFreal d2 = 0.;
+  for (CFuint iDim = 0; iDim < 3; ++iDim) {
+    if (p[iDim] < node.bmin[iDim]) {
+      const CFreal d = node.bmin[iDim] - p[iDim];
+      d2 += d*d;
+    }
+    else if (p[iDim] > node.bmax[iDim]) {
+      const CFreal d = p[iDim] - node.bmax[iDim];
+      d2 += d*d;
+    }
+  }
+  return d2;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal WallFaceTree::distance2(const CFreal* p, const Primitive& prim)
+{
+  const CFreal* a = prim.p[0];
+  const CFreal* b = prim.p[1];
+  CFreal ab[3], ap[3], d[3];
+  sub3(b, a, ab);
+  sub3(p, a, ap);
+
+  if (prim.nbNodes == 2) {
+    // closest point on the segment
+    const CFreal ab2 = dot3(ab, ab);
+    CFreal t = (ab2 > 0.) ? dot3(ap, ab)/ab2 : 0.;
+    t = std::max(0., std::min(1., t));
+    for (CFuint iDim = 0; iDim < 3; ++iDim) {
+      d[iDim] = ap[iDim] - t*ab[iDim];
+    }
+    return dot3(d, d);
+  }
+
+  // closest point on the triangle, identified through the Voronoi
+  // region of the triangle where p is located
+  const CFreal* c = prim.p[2];
+  CFreal ac[3], bp[3], cp[3];
+  sub3(c, a, ac);
+
+  const CFreal d1 = dot3(ab, ap);
+  const CFreal d2 = dot3(ac, ap);
+  if (d1 <= 0. && d2 <= 0.) return dot3(ap, ap);
+
+  sub3(p, b, bp);
+  const CFreal d3 = dot3(ab, bp);
+  const CFreal d4 = dot3(ac, bp);
+  if (d3 >= 0. && d4 <= d3) return dot3(bp, bp);
+
+  const CFreal vc = d1*d4 - d3*d2;
+  if (vc <= 0. && d1 >= 0. && d3 <= 0.) {
+    const CFreal v = d1/(d1 - d3);
+    for (CFuint iDim = 0; iDim < 3; ++iDim) {d[iDim] = ap[iDim] - v*ab[iDim];}
+    return dot3(d, d);
+  }
+
+  sub3(p, c, cp);
+  const CFreal d5 = dot3(ab, cp);
+  const CFreal d6 = dot3(ac, cp);
+  if (d6 >= 0. && d5 <= d6) return dot3(cp, cp);
+
+  const CFreal vb = d5*d2 - d1*d6;
+  if (vb <= 0. && d2 >= 0. && d6 <= 0.) {
+    const CFreal w = d2/(d2 - d6);
+    for (CFuint iDim = 0; iDim < 3; ++iDim) {d[iDim] = ap[iDim] - w*ac[iDim];}
+    return dot3(d, d);
+  }
+
+  const CFreal va = d3*d6 - d5*d4;
+  if (va <= 0. && (d4 - d3) >= 0. && (d5 - d6) >= 0.) {
+    const CFreal w = (d4 - d3)/((d4 - d3) + (d5 - d6));
+    for (CFuint iDim = 0; iDim < 3; ++iDim) {d[iDim] = bp[iDim] - w*(c[iDim] - b[iDim]);}
+    return dot3(d, d);
+  }
+
+  // p projects inside the triangle
+  const CFreal sum = va + vb + vc;
+  if (sum <= 0.) {
+    // degenerated triangle: take the closest vertex
+    return std::min(dot3(ap, ap), std::min(dot3(bp, bp), dot3(cp, cp)));
+  }
+  const CFreal denom = 1./sum;
+  const CFreal v = vb*denom;
+  const CFreal w = vc*denom;
+  for (CFuint iDim = 0; iDim < 3; ++iDim) {
+    d[iDim] = ap[iDim] - v*ab[iDim] - w*ac[iDim];
+  }
+  return dot3(d, d);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MeshTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
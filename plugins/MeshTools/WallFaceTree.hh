@@ -0,0 +1,123 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_MeshTools_WallFaceTree_hh
+#define COOLFluiD_MeshTools_WallFaceTree_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MeshTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ *
+ * This class stores a set of wall faces (segments in 2D, triangles
+ * and quadrilaterals in 3D) in a bounding volume hierarchy and computes
+ * the exact distance from a point to the closest face.
+ * Quadrilaterals are split into two triangles.
+ * Once built, the tree can be queried concurrently by several threads.
+ *
+ */
+class WallFaceTree {
+public:
+
+  /**
+   * Constructor.
+   */
+  WallFaceTree();
+
+  /**
+   * Default destructor
+   */
+  ~WallFaceTree();
+
+  /**
+   * Build the tree
+   * @param dim          dimension of the space (2 or 3)
+   * @param coords       coordinates of the face nodes, face after face
+   * @param nbNodesInFace number of nodes of each face
+   */
+  void build(const CFuint dim,
+	     const std::vector<CFreal>& coords,
+	     const std::vector<CFuint>& nbNodesInFace);
+
+  /**
+   * Compute the distance from a point to the closest face
+   * @param point  coordinates of the point (dim entries)
+   * @return the distance or CFrealMax() if the tree is empty
+   */
+  CFreal computeDistance(const CFreal* point) const;
+
+  /**
+   * @return the number of primitives (segments or triangles) in the tree
+   */
+  CFuint getNbPrimitives() const {return m_prims.size();}
+
+private: // helper types
+
+  /// segment or triangle (in 3D coordinates, z = 0 in 2D)
+  struct Primitive {
+    CFreal p[3][3];
+    CFuint nbNodes;
+  };
+
+  /// node of the tree: leaves have nbPrims > 0 and point to m_prims,
+  /// inner nodes have their children in first and first+1
+  struct TreeNode {
+    CFreal bmin[3];
+    CFreal bmax[3];
+    CFuint first;
+    CFuint nbPrims;
+  };
+
+private: // functions
+
+  /**
+   * Recursively build the given node for the primitives in [begin, end)
+   */
+  void buildNode(CFuint nodeID, CFuint begin, CFuint end);
+
+  /**
+   * @return the square of the distance from p to the given primitive
+   */
+  static CFreal distance2(const CFreal* p, const Primitive& prim);
+
+  /**
+   * @return the square of the distance from p to the bounding box of the node
+   */
+  static CFreal boxDistance2(const CFreal* p, const TreeNode& node);
+
+private: // data
+
+  /// dimension of the space
+  CFuint m_dim;
+
+  /// primitives, sorted so that each leaf stores a contiguous range
+  std::vector<Primitive> m_prims;
+
+  /// nodes of the tree, the root being the first one
+  std::vector<TreeNode> m_nodes;
+
+}; // end of class WallFaceTree
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MeshTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_MeshTools_WallFaceTree_hh
@@ -2074,6 +2074,52 @@ void MutationLibrary::getMassProductionTerm(CFdouble& temperature,
 
 //////////////////////////////////////////////////////////////////////////////
 
+void MutationLibrary::getMassProductionTermBlock
+(CFuint nbStates,
+ CFuint nbTv,
+ const CFreal* temp,
+ const CFreal* tVec,
+ const CFreal* rho,
+ const CFreal* ys,
+ CFreal* pressure,
+ CFreal* omega,
+ Framework::PhysicalChemicalLibrary::BlockWorkspace& ws)
+{
+  // the Fortran work arrays are shared: blocks cannot be evaluated concurrently
+  if (ws.tVec.size() != nbTv) {
+    ws.tVec.resize(nbTv);
+  }
+  
+  for (CFuint s = 0; s < nbStates; ++s) {
+    CFdouble T = temp[s];
+    CFdouble r = rho[s];
+    for (CFuint i = 0; i < nbTv; ++i) {
+      ws.tVec[i] = tVec[i*nbStates + s];
+    }
+    for (int is = 0; is < _NS; ++is) {
+      ws.ys[is] = ys[is*nbStates + s];
+    }
+    
+    // only the mass fractions are needed by the pressure and the reaction rates
+    if (presenceElectron()) {
+      setElectronFraction(ws.ys);
+    }
+    for (int is = 0; is < _NS; ++is) {
+      Y[is] = max(0.0, ws.ys[is]);
+    }
+    
+    CFdouble p = MutationLibrary::pressure(r, T, &ws.tVec[0]);
+    MutationLibrary::getMassProductionTerm(T, ws.tVec, p, r, ws.ys, false, ws.omega, ws.jacobian);
+    
+    pressure[s] = p;
+    for (int is = 0; is < _NS; ++is) {
+      omega[is*nbStates + s] = ws.omega[is];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void MutationLibrary::getSource(CFdouble& temp,
 			        RealVector& tempVib,
 			        CFdouble& pressure,
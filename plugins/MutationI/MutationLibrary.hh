@@ -456,6 +456,21 @@ public:
 			     RealVector& omega,
                              RealMatrix& jacobian);
 
+  /**
+   * Computes the pressure and the mass production terms for a block of states,
+   * filling directly the Fortran arrays (the molar fractions are not updated)
+   * @see PhysicalChemicalLibrary::getMassProductionTermBlock()
+   */
+  void getMassProductionTermBlock(CFuint nbStates,
+				  CFuint nbTv,
+				  const CFreal* temp,
+				  const CFreal* tVec,
+				  const CFreal* rho,
+				  const CFreal* ys,
+				  CFreal* pressure,
+				  CFreal* omega,
+				  Framework::PhysicalChemicalLibrary::BlockWorkspace& ws);
+
   /**
    * Returns the source term for the vibrational relaxation with VT transfer
    * @param temp the mixture temperature
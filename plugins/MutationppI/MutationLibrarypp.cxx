@@ -4,7 +4,10 @@
 #include "Common/Stopwatch.hh"
 #include "Environment/ObjectProvider.hh"
 #include "Common/StringOps.hh"
+#include "Common/PE.hh"
 #include <fstream>
+#include <sstream>
+#include <iomanip>
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -50,6 +53,8 @@ void MutationLibrarypp::defineConfigOptions(Config::OptionList& options)
   options.addConfigOption< CFdouble >("Pmax","Maximum pressure in the table.");
   options.addConfigOption< CFdouble >("Pmin","Minimum pressure in the table.");
   options.addConfigOption< CFdouble >("deltaP","Delta pressure.");
+  options.addConfigOption< std::string >
+    ("LookUpTableFile","File where the look up table is saved and reloaded from in later runs (none if empty).");
 }
       
 //////////////////////////////////////////////////////////////////////////////
@@ -72,8 +77,12 @@ MutationLibrarypp::MutationLibrarypp(const std::string& name) :
   m_hr(),
   m_hf(),  
   m_Tstate(),
-  _nameToIdxVar(), //@modif_LkT
-  _lookUpTables()
+  _lookUpTables(), //@modif_LkT
+  _lkpIdxD(-1),
+  _lkpIdxH(-1),
+  _lkpIdxE(-1),
+  _lkpIdxA(-1),
+  _lkpValues()
 {
   addConfigOptionsTo(this);
   
@@ -119,6 +128,9 @@ MutationLibrarypp::MutationLibrarypp(const std::string& name) :
 
   _deltaP = 1000.0;
   setParameter("deltaP",&_deltaP);
+  
+  _lookUpTableFile = "";
+  setParameter("LookUpTableFile",&_lookUpTableFile);
 
 }
 
@@ -360,7 +372,7 @@ CFdouble MutationLibrarypp::soundSpeed(CFdouble& temp, CFdouble& pressure)
   	return m_gasMixture->equilibriumSoundSpeed();
 	}
 	else {
-		return _lookUpTables.get(temp, pressure, _nameToIdxVar.find("a"));
+		return getLookUpValue(temp, pressure, _lkpIdxA);
 		}
 }
 
@@ -410,9 +422,15 @@ void MutationLibrarypp::setDensityEnthalpyEnergy(CFdouble& temp,
   	CFLog(DEBUG_MAX, "Mutation::setDensityEnthalpyEnergy() => " << dhe << ", " <<  m_y << "\n");
 	}
 	else{
-    dhe[0] = _lookUpTables.get(temp, pressure, _nameToIdxVar.find("d"));
-    dhe[1] = _lookUpTables.get(temp, pressure, _nameToIdxVar.find("h"));
-    dhe[2] = _lookUpTables.get(temp, pressure, _nameToIdxVar.find("e"));
+    if (_lkpIdxD < 0 || _lkpIdxH < 0 || _lkpIdxE < 0) {
+      throw Common::NoSuchValueException
+	(FromHere(), "Variables \"d\", \"h\" and \"e\" must be in the look up table");
+    }
+    // all the variables are interpolated at once
+    _lookUpTables.get(temp, pressure, &_lkpValues[0]);
+    dhe[0] = _lkpValues[_lkpIdxD];
+    dhe[1] = _lkpValues[_lkpIdxH];
+    dhe[2] = _lkpValues[_lkpIdxE];
   }
 }
       
@@ -441,7 +459,7 @@ void MutationLibrarypp::setDensityEnthalpyEnergy(CFdouble& temp,
 CFdouble MutationLibrarypp::density(CFdouble& temp,CFdouble& pressure,CFreal* tVec)
 {
   if (m_smType == LTE) {
-    if (_useLookUpTable) {return _lookUpTables.get(temp, pressure, _nameToIdxVar.find("d"));}
+    if (_useLookUpTable) {return getLookUpValue(temp, pressure, _lkpIdxD);}
     else {
      m_gasMixture->setState(&pressure, &temp, 1);
     } 
@@ -488,7 +506,7 @@ CFdouble MutationLibrarypp::energy(CFdouble& temp,CFdouble& pressure)
   	return m_gasMixture->mixtureEnergyMass()- m_H0;
 	}
   else {
-		return _lookUpTables.get(temp, pressure, _nameToIdxVar.find("e"));
+		return getLookUpValue(temp, pressure, _lkpIdxE);
 	}
 }
       
@@ -501,7 +519,7 @@ CFdouble MutationLibrarypp::enthalpy(CFdouble& temp,CFdouble& pressure)
   	return m_gasMixture->mixtureHMass() - m_H0;
 	}
   else{
-		 return _lookUpTables.get(temp, pressure, _nameToIdxVar.find("h"));
+		 return getLookUpValue(temp, pressure, _lkpIdxH);
 	}
 
 }
@@ -647,6 +665,68 @@ void MutationLibrarypp::getMassProductionTerm(CFdouble& temperature,
       
 //////////////////////////////////////////////////////////////////////////////
 
+std::auto_ptr<Framework::PhysicalChemicalLibrary::BlockWorkspace> 
+MutationLibrarypp::createBlockWorkspace()
+{
+  BlockWorkspacepp* ws = new BlockWorkspacepp();
+  std::auto_ptr<Framework::PhysicalChemicalLibrary::BlockWorkspace> result(ws);
+  
+  Mutation::MixtureOptions mo(_mixtureName);
+  mo.setStateModel(_stateModelName);
+  ws->mixture.reset(new Mutation::Mixture(mo));
+  
+  ws->rhoi.resize(_NS);
+  ws->temps.resize(m_Tstate.size());
+  ws->omega.resize(_NS);
+  return result;
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
+void MutationLibrarypp::getMassProductionTermBlock
+(CFuint nbStates,
+ CFuint nbTv,
+ const CFreal* temp,
+ const CFreal* tVec,
+ const CFreal* rho,
+ const CFreal* ys,
+ CFreal* pressure,
+ CFreal* omega,
+ Framework::PhysicalChemicalLibrary::BlockWorkspace& ws)
+{
+  // only the mixture of the workspace is modified, nothing in this object
+  BlockWorkspacepp& wspp = static_cast<BlockWorkspacepp&>(ws);
+  Mutation::Mixture& mixture = *wspp.mixture;
+  const CFuint nbSpecies = _NS;
+  const CFuint nbTemps = ws.temps.size();
+  cf_assert(nbTemps <= nbTv + 1);
+  
+  for (CFuint s = 0; s < nbStates; ++s) {
+    const CFreal r = rho[s];
+    for (CFuint i = 0; i < nbSpecies; ++i) {
+      ws.rhoi[i] = std::max(_minRhoi, ys[i*nbStates + s]*r);
+    }
+    ws.temps[0] = std::max(temp[s], _minT);
+    for (CFuint i = 1; i < nbTemps; ++i) {
+      ws.temps[i] = std::max(tVec[(i-1)*nbStates + s], _minT);
+    }
+    mixture.setState(&ws.rhoi[0], &ws.temps[0], 1);
+    
+    pressure[s] = mixture.P();
+    if (!_freezeChemistry) {
+      mixture.netProductionRates(&ws.omega[0]);
+    }
+    else {
+      ws.omega = 0.;
+    }
+    for (CFuint i = 0; i < nbSpecies; ++i) {
+      omega[i*nbStates + s] = ws.omega[i];
+    }
+  }
+}
+      
+//////////////////////////////////////////////////////////////////////////////
+
 void MutationLibrarypp::getSource(CFdouble& temperature,
 				 RealVector& tVec,
 				 CFdouble& pressure,
@@ -818,218 +898,90 @@ void MutationLibrarypp::setTables(vector<ComputeQuantity>& varComputeVec)
   Common::Stopwatch<Common::WallTime> stp;
   stp.start(); 
   const CFuint nbLookUpVars = _lkpVarNames.size();
-	
-
-
-  //_____________________________________________________________________________
-  // create mapping variable names with corresponding idxs
-	//https://github.com/andrealani/COOLFluiD/blob/master/src/Common/CFMap.hh
-	CFLog(NOTICE, ">> In setTables(): Creating and printing the mapping CFmap... \n");
-  _nameToIdxVar.reserve(nbLookUpVars);
+  
+  // indices of the variables in the table, to avoid any search at run time
   for (CFuint iVar = 0; iVar < nbLookUpVars; ++iVar) {
-    _nameToIdxVar.insert(_lkpVarNames[iVar], iVar);
-	  
-  }	
-	_nameToIdxVar.print();
-  _nameToIdxVar.sortKeys();
-	//a => 0
-	//e => 1
-	//h => 2
-	//d => 3
-	CFLog(NOTICE, ">> In setTables(): After sorting the mapping CFmap... \n");
-	_nameToIdxVar.print();
-	//a => 0
-	//d => 3
-	//e => 1
-	//h => 2
-
-
-  //_____________________________________________________________________________
-  // compute the arrays containing all the keys for T and P
-	// Based on the value set in CFcase file
-
-	//_________________________________
-	// Linear scale for the temperature
-	//---------------------------------
-	const CFuint nbT = static_cast<CFuint> ((_Tmax - _Tmin)/_deltaT) +1 ;
-		vector<CFdouble> vT(nbT+2);
-
-	CFLog(NOTICE, ">> 	           __________________________________\n");
-	CFLog(NOTICE, ">> In setTables(): Linear scale for the temperature\n");
-	CFLog(NOTICE, ">> In setTables(): Tmin           = "<<_Tmin<<"\n");
-	CFLog(NOTICE, ">> In setTables(): Tmax           = "<<_Tmax<<"\n");
-	CFLog(NOTICE, ">> In setTables(): deltaT         = "<<_deltaT<<"\n");
-	CFLog(NOTICE, ">> In setTables(): nbT = "<<nbT<<"\n");
-  for(CFuint i = 0; i <= nbT ; ++i) {
-    vT[i] = _Tmin + i*_deltaT;
+    if (_lkpVarNames[iVar] == "d") _lkpIdxD = iVar;
+    if (_lkpVarNames[iVar] == "h") _lkpIdxH = iVar;
+    if (_lkpVarNames[iVar] == "e") _lkpIdxE = iVar;
+    if (_lkpVarNames[iVar] == "a") _lkpIdxA = iVar;
   }
-		CFLog(NOTICE, ">> In setTables(): vT[0] = "<<vT[0]<<",  vT[1] = "<<vT[1]<<"... "<<"vT["<<nbT-1<<"] = "<<vT[nbT-1]<<"\n");
-
-	//_________________________________
-	// Linear scale for the pressure
-	//---------------------------------
-
-	const CFuint nbP_lin = static_cast<CFuint> ((_pmax - _pmin)/_deltaP)+1; 
-	vector<CFdouble> vP_lin(nbP_lin+1);
-	for(CFuint i = 0; i <= nbP_lin  ; ++i) {
-    vP_lin[i] = _pmin + i*_deltaP;
+  _lkpValues.resize(nbLookUpVars);
+  
+  // uniform temperature axis with the same points as the previous tables
+  const CFuint nbT = static_cast<CFuint>((_Tmax - _Tmin)/_deltaT) + 1;
+  const CFdouble Tlast = _Tmin + (nbT-1)*_deltaT;
+  
+  // the pressure axis is uniform in P or in log(P): in the latter case,
+  // the number of points per decade is the one obtained with deltaP 
+  // over the whole range, equidistributed among the decades
+  CFuint nbP = static_cast<CFuint>((_pmax - _pmin)/_deltaP) + 1;
+  CFdouble Plast = _pmin + (nbP-1)*_deltaP;
+  if (_pLogScale) {
+    cf_always_assert(_pmin > 0.);
+    const CFdouble nbDecades = log10(_pmax/_pmin);
+    const CFdouble nbPointsPerDecade = (nbP - 1)/std::max(1., std::ceil(nbDecades));
+    nbP = static_cast<CFuint>(std::ceil(nbDecades*nbPointsPerDecade)) + 1;
+    Plast = _pmax;
   }
-
-	//__________________________________
-	//Logarithmic scale for the pressure
-	//----------------------------------
-  //Assumption : Pressure >= 1
-	// step 0: Writing P in a Scientific expression form -> a.10^b 
-	int b_min = log10(_pmin);
-	CFdouble a_min = _pmin*pow(10,-b_min);
-	int b_max = log10(_pmax);
-	CFdouble a_max = _pmax*pow(10,-b_max);
-	int pixels = (_pmax-_pmin)/_deltaP;
-	CFdouble NbPowerOfTen = 0;
-
-	/* 
-	 * STEP 1: Number of 10th-power between _pmin and _pmax
-	 */
-	if(a_max == 1)  NbPowerOfTen = b_max - b_min + 1;
-	else            NbPowerOfTen = b_max - b_min + 2;
-	/* 
-	 * STEP 2: Number of logarithmic units (bloc of size 10 => StartBloc[i+1]/StartBloc[i] = 10)
-	 */
- 	vector<CFdouble> StartBloc;                 
-	for(CFuint i=0; i<NbPowerOfTen - 1;++i){
-		StartBloc.push_back(pow(10,b_min+i));
-	}	
-	CFuint nbBlocs = NbPowerOfTen -1;
-	/* 
-	 * STEP 3: EquiDistribution of the pixels in each blocs 
-	 */ 
-	CFuint NbPixPerBloc = CFuint (pixels/nbBlocs); 
-	/* 
-	 * STEP 4: Set the boundaries of each blocs in the vector	
-	 */
-		CFuint nbP_log = nbBlocs*NbPixPerBloc + 1;
-		vector<CFdouble>  vPbis(nbP_log);
-		CFuint PixelPmax;
-		for(CFuint i=0 ; i<nbBlocs ; ++i){
-			vPbis[i*NbPixPerBloc] = StartBloc[i];
-		}
-		if (a_max ==1){
-				 PixelPmax = nbBlocs*NbPixPerBloc;
-				 vPbis[PixelPmax] = _pmax;
-		}
-		else vPbis[nbBlocs*NbPixPerBloc] = pow(10,b_max+1);
-	/* 
-	 * STEP 5: set pmin, pmax and the values 2, 3, 4, ...,9 between each bloc of ratio 10 in the vector
-	 *					_pmin - 100 - 200 - ... - 1000 - 1100 - ... - 10 000 - 10 100 - ... - 100 000 - 100 100 - ... - _pmax
-	 */
-	vector<CFdouble> Res(9);
-	CFuint PixelPmin = int(log10(a_min)*NbPixPerBloc);
-	PixelPmax = int(log10(a_max)*NbPixPerBloc + (nbBlocs-1)*NbPixPerBloc);
-	vPbis[PixelPmin] = _pmin;
-	if(a_max>1) vPbis[PixelPmax] = _pmax;
-	for(CFuint i=0 ; i<nbBlocs ; ++i){
-			for(CFuint j=1 ; j<10 ; ++j){
-					vPbis[int(NbPixPerBloc*log10(j)) + i*NbPixPerBloc] = j*StartBloc[i];
-			}   
-	}	
-	/* 
-	 * STEP 6: set the other values between the ones set previously (step 5)
-	 */ 
-	for(CFdouble pix=0 ; pix<NbPixPerBloc ; ++pix){	 	
-	  for(CFuint k=0 ; k<nbBlocs ; ++k){
-	    if(vPbis[pix+k*NbPixPerBloc] ==0){
-	      vPbis[pix+k*NbPixPerBloc] = pow(10,double(pix/NbPixPerBloc))	*StartBloc[k];	
-	    }
-	  }		
-	}
-	/* 
-	 * STEP 7: Resize the vector vPbis by removing the values in excess () in the boundaries
-	 *        (10^bmin ...) - pmin - ........- pmax - (... 10^bmax+1)
-	 */
-	CFuint k = 0;
-	nbP_log = PixelPmax-PixelPmin+1;
-	vector<CFdouble> vP_log(nbP_log+1);
-	 for(CFuint pix=PixelPmin ; pix<=PixelPmax ; ++pix){
-	   vP_log[k]=vPbis[pix];
-	   k=k+1;
-	 }
-	///... END STEPS
-
-	// _________________________________________________________________
-	// CHOICE (linear or logarithmic) OF THE PRESSURE SCALE BY THE USER:
-	CFuint nbP = (1-_pLogScale)*nbP_lin + _pLogScale*nbP_log;
-	vector<CFdouble>  vP( nbP +1 );
-	if(_pLogScale){
-		CFLog(NOTICE, ">> 	           __________________________________\n");
-		CFLog(NOTICE, ">> In setTables(): Logarithmic scale for the pressure\n");
-		CFLog(NOTICE, ">> In setTables(): pmin   = "<<a_min<<"x 10^"<<b_min<<"\n");
-		CFLog(NOTICE, ">> In setTables(): pmax   = "<<a_max<<"x 10^"<<b_max<<"\n");
-		CFLog(NOTICE, ">> In setTables(): deltaP = "<<_deltaP<<"\n");
-		CFLog(NOTICE, ">> In setTables(): nbP_log before truncation = "<< pixels<<"\n");
-		CFLog(NOTICE, ">> In setTables(): NbPowerOfTen = "<<NbPowerOfTen<<"\n");
-		CFLog(NOTICE, ">> In setTables(): nbBlocs = "<<nbBlocs<<"\n");
-		CFLog(NOTICE, ">> In setTables(): NbPixPerBloc = "<<NbPixPerBloc<<"\n");
-	  CFLog(NOTICE, ">> In setTables(): nbP_log after removing the excess values = "<< nbP_log<<"\n");
-		vP = vP_log;
-		CFLog(NOTICE, ">> In setTables(): vP[0] = "<<vP[0]<<",  vP[1] = "<<vP[1]<<",  vP[2] = "<<vP[2]<<"... "<<"vP["<<nbP-1<<"] = "<<vP[nbP-1]<<"\n");
-
-	}
-	else{
-		CFLog(NOTICE, ">> In setTables(): nbP_lin = "<<nbP_lin<<"\n");
-		CFLog(NOTICE, ">> 	           __________________________________\n");
-		CFLog(NOTICE, ">> In setTables(): Linear scale for the pressure\n");
-		CFLog(NOTICE, ">> In setTables(): Pmin           = "<<_pmin<<"\n");
-		CFLog(NOTICE, ">> In setTables(): Pmax           = "<<_pmax<<"\n");
-		CFLog(NOTICE, ">> In setTables(): deltaP         = "<<_deltaP<<"\n");
-		CFLog(NOTICE, ">> In setTables(): nb subinterval = "<<nbP_lin<<"\n");
-		vP = vP_lin;
-		CFLog(NOTICE, ">> In setTables(): vP[0] = "<<vP[0]<<",  vP[1] = "<<vP[1]<<",  vP[2] = "<<vP[2]<<"... "<<"vP["<<nbP-1<<"] = "<<vP[nbP-1]<<"\n");
-	}
-
-	//_____________________________________________________________________________
-  // INITIALIZE THE TABLE AND INSERT THE VALUES
-	//https://github.com/andrealani/COOLFluiD/blob/master/src/Common/LookupTable2D.ci
-  _lookUpTables.initialize(vT, vP, nbLookUpVars);
-		CFLog(NOTICE, ">> 	           ____________________________________________\n");
-	CFLog(NOTICE, ">> In setTables(): inserting the values in the _lookUpTables (Takes time...) \n");
-	CFdouble result;
-	for(CFuint i = 0; i < nbT; ++i) {
-    for(CFuint j = 0; j < nbP; ++j) {
-
-      // set the composition at first (Here _useLookUpTable is still at false)
-      setComposition(vT[i],vP[j], CFNULL); 
-      for (CFuint iVar  = 0; iVar < nbLookUpVars; ++iVar) {
-				
-       result = (this->*varComputeVec[iVar])(vT[i],vP[j]); 
-			 // Meaning of this command at each iter:
-			 // result := varComputeVec[0](vT[i],vP[j]) := SoundSpeed(vT[i],vP[j])
-			 // result := varComputeVec[1](vT[i],vP[j]) := Energy(vT[i],vP[j])
-			 // result := varComputeVec[2](vT[i],vP[j]) := Enthalpy(vT[i],vP[j])
-			 // result := varComputeVec[3](vT[i],vP[j]) := Density(vT[i],vP[j])
-
-
-       _lookUpTables.insert(vT[i],vP[j], _nameToIdxVar.find(_lkpVarNames[iVar]),result);
+  cf_always_assert(nbT > 1 && nbP > 1);
+  
+  CFLog(INFO, "MutationLibrarypp::setTables() => T in [" << _Tmin << ", " << Tlast 
+	<< "] with " << nbT << " points, P in [" << _pmin << ", " << Plast << "] with " 
+	<< nbP << (_pLogScale ? " log-spaced" : " linearly spaced") << " points\n");
+  
+  const string tag = getLookUpTableTag();
+  if (_lookUpTableFile != "" && _lookUpTables.load(_lookUpTableFile, tag) &&
+      _lookUpTables.getNbX() == nbT && _lookUpTables.getNbY() == nbP && 
+      _lookUpTables.getNbVars() == nbLookUpVars) {
+    stp.stop();
+    CFLog(INFO, "MutationLibrarypp::setTables() => table read from " 
+	  << _lookUpTableFile << " in " << stp.read() << "s\n");
+    return;
+  }
+  
+  _lookUpTables.initialize
+    (_Tmin, Tlast, nbT, Common::UniformLookupTable2D::LINEAR,
+     _pmin, Plast, nbP, (_pLogScale) ? Common::UniformLookupTable2D::LOG : 
+     Common::UniformLookupTable2D::LINEAR, nbLookUpVars);
+  
+  for (CFuint i = 0; i < nbT; ++i) {
+    CFdouble temp = _lookUpTables.getX(i);
+    for (CFuint j = 0; j < nbP; ++j) {
+      CFdouble pressure = _lookUpTables.getY(j);
+      // set the composition at first (here _useLookUpTable is still false)
+      setComposition(temp, pressure, CFNULL); 
+      for (CFuint iVar = 0; iVar < nbLookUpVars; ++iVar) {
+	_lookUpTables.set(i, j, iVar, (this->*varComputeVec[iVar])(temp, pressure));
       }
     }
   }
-	//_____________________________________________________________________________
-  // WRITE IN A FILE THE VALUES INSERTED IN THE LKT
-	/*
-  ofstream fichier("bliblablou.dat", ios::out | ios::trunc);  
-	if(fichier){
-		CFLog(NOTICE, "\n>> In setTables(): printing values computed in a .dat file:\n\n");
-
-		//for(CFuint i = 0; i < nbT; ++i) {
-			for(CFuint j = 0; j < nbP; ++j) {
-				fichier << vP[j]<< "  "<<_lookUpTables.get(vP[j],vT[0], _nameToIdxVar.find("h"))<<endl;
-			}
-		//}
-
-		fichier.close();
-	}
-	else cerr << "CAN NOT OPEN THE  !" << endl;
-	*/
+  
+  stp.stop();
+  CFLog(INFO, "MutationLibrarypp::setTables() => table computed in " << stp.read() << "s\n");
+  
+  // all the processors compute the same table, only one saves it
+  if (_lookUpTableFile != "" && PE::GetPE().GetRank("Default") == 0) {
+    _lookUpTables.save(_lookUpTableFile, tag);
+    CFLog(INFO, "MutationLibrarypp::setTables() => table saved in " << _lookUpTableFile << "\n");
+  }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string MutationLibrarypp::getLookUpTableTag() const
+{
+  // everything the table values depend on
+  std::ostringstream tag;
+  tag << std::setprecision(17) << "Mutationpp " << _mixtureName << " " << _stateModelName
+      << " " << m_H0 << " T " << _Tmin << " " << _Tmax << " " << _deltaT 
+      << " P " << _pmin << " " << _pmax << " " << _deltaP << " " << _pLogScale << " vars";
+  for (CFuint iVar = 0; iVar < _lkpVarNames.size(); ++iVar) {
+    tag << " " << _lkpVarNames[iVar];
+  }
+  return tag.str();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void MutationLibrarypp::getSourceTermVT(CFdouble& temperature,
@@ -6,10 +6,11 @@
 #include "Framework/PhysicalChemicalLibrary.hh"
 #include "Common/Fortran.hh"
 #include "Common/NotImplementedException.hh"
+#include "Common/NoSuchValueException.hh"
 #include "MathTools/RealVector.hh"
 #include "MathTools/RealMatrix.hh"
 #include <mutation++.h>
-#include "Common/LookupTable2D.hh" //@modif_LkT
+#include "Common/UniformLookupTable2D.hh" //@modif_LkT
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -36,11 +37,6 @@ public:
    * @param options a OptionList where to add the Option's
    */
   static void defineConfigOptions(Config::OptionList& options);
-  /**
-   * Creation of an alias for the class that defines a table
-   * @modif_LkT
-   */
-  typedef Common::LookupTable2D<CFdouble, CFdouble, CFdouble> LkpTable; 
   /**
    * Constructor without arguments
    */
@@ -444,6 +440,31 @@ public:
 			     RealVector& omega,
                              RealMatrix& jacobian);
   
+  /**
+   * Create a workspace with its own mixture, so that blocks of states
+   * can be evaluated concurrently
+   */
+  std::auto_ptr<Framework::PhysicalChemicalLibrary::BlockWorkspace> createBlockWorkspace();
+  
+  /**
+   * Blocks of states only modify the mixture of the given workspace
+   */
+  bool isBlockThreadSafe() const {return true;}
+  
+  /**
+   * Computes the pressure and the mass production terms for a block of states
+   * @see PhysicalChemicalLibrary::getMassProductionTermBlock()
+   */
+  void getMassProductionTermBlock(CFuint nbStates,
+				  CFuint nbTv,
+				  const CFreal* temp,
+				  const CFreal* tVec,
+				  const CFreal* rho,
+				  const CFreal* ys,
+				  CFreal* pressure,
+				  CFreal* omega,
+				  Framework::PhysicalChemicalLibrary::BlockWorkspace& ws);
+  
   /**
    * Returns the source term for the vibrational relaxation with VT transfer
    * @param temp the mixture temperature
@@ -574,6 +595,16 @@ private: // helper function
   /* ========================
      START section @modif_LkT 
   */
+protected: // helper class
+  
+  /// workspace owning a mixture for the evaluation of blocks of states
+  class BlockWorkspacepp : public Framework::PhysicalChemicalLibrary::BlockWorkspace {
+  public:
+    
+    /// mixture storing the state being evaluated
+    std::auto_ptr<Mutation::Mixture> mixture;
+  };
+  
 protected: // helper function
   typedef CFdouble (MutationLibrarypp::*ComputeQuantity)
     (CFdouble&, CFdouble&);
@@ -595,6 +626,22 @@ protected: // helper function
    */
   void setTables(std::vector<ComputeQuantity>& varComputeVec);
   
+  /**
+   * @return the string identifying the content of the look up table file
+   */
+  std::string getLookUpTableTag() const;
+  
+  /**
+   * @return the value of the given variable interpolated from the look up table
+   */
+  CFdouble getLookUpValue(CFdouble temp, CFdouble pressure, CFint idx) const
+  {
+    if (idx < 0) {
+      throw Common::NoSuchValueException (FromHere(), "Variable not found in the look up table");
+    }
+    return _lookUpTables.get(temp, pressure, static_cast<CFuint>(idx));
+  }
+  
 protected: //variables
 
   /// flag telling if to use the look up tables
@@ -603,11 +650,26 @@ protected: //variables
   /// flag telling to ignore the electronic energy
   bool _noElectEnergy;
 
-  /// mapping name variable - idx
-  Common::CFMap<std::string, size_t> _nameToIdxVar;
+  /// table storing all the look up variables, uniform in T and in P (or log(P))
+  Common::UniformLookupTable2D _lookUpTables;
+
+  /// index of the density in the look up table (-1 if not stored)
+  CFint _lkpIdxD;
+
+  /// index of the enthalpy in the look up table (-1 if not stored)
+  CFint _lkpIdxH;
+
+  /// index of the energy in the look up table (-1 if not stored)
+  CFint _lkpIdxE;
+
+  /// index of the sound speed in the look up table (-1 if not stored)
+  CFint _lkpIdxA;
+
+  /// values of all the look up variables in one point
+  std::vector<CFdouble> _lkpValues;
 
-  /// table of lookup tables
-  LkpTable _lookUpTables;
+  /// file where the look up table is saved and loaded from
+  std::string _lookUpTableFile;
 
   /// gas mixture pointer
   std::auto_ptr<Mutation::Mixture> m_gasMixture;
@@ -0,0 +1,383 @@
+#ifndef COOLFluiD_Physics_NEQ_Euler2DNEQRhoivtT_hh
+#define COOLFluiD_Physics_NEQ_Euler2DNEQRhoivtT_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "MathTools/DualNumber.hh"
+#include "NavierStokes/EulerTerm.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Physics {
+
+    namespace NEQ {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class represents a variable set for the 2D Euler equations of a
+ * thermally perfect mixture in chemical non equilibrium, in update variables
+ * [rho_i u v T], written for a generic scalar type T (CFreal or
+ * MathTools::DualNumber).
+ * The species energies are given by the THERMO policy, which must provide
+ *  - CFreal getRspecies(CFuint i) const : the gas constant of species i;
+ *  - void computeEnergies(const CFreal* rhoi, CFreal temp, CFreal* e,
+ *                         CFreal* cv, CFreal* dcv) : the internal energies
+ *    per unit mass of the species, their derivatives with respect to the
+ *    temperature and the derivatives of the latter.
+ * The eigensystem is the one of the jacobian in conservative variables
+ * [rho_i rhou rhov rhoE]. The linearized state is a sqrt(rho) weighted
+ * average which does not satisfy the Roe property exactly.
+ *
+ */
+template <int NS, typename THERMO>
+class Euler2DNEQRhoivtT {
+
+public: // classes
+
+  typedef NavierStokes::EulerTerm EULERTERM;
+
+  /// the species mass fractions are stored after the Euler physical data
+  enum {DIM=2, NBEQS=NS+3, DATASIZE=14+NS, Y=14};
+
+  /**
+   * Constructor
+   */
+  Euler2DNEQRhoivtT(THERMO* thermo) : m_thermo(thermo) {}
+
+  /**
+   * Constructor
+   */
+  Euler2DNEQRhoivtT() : m_thermo(CFNULL) {}
+
+  /**
+   * Set the model data
+   */
+  void setModelData(THERMO* thermo) {m_thermo = thermo;}
+
+  /**
+   * Default destructor
+   */
+  virtual ~Euler2DNEQRhoivtT() {}
+
+  /// Compute the physical data starting from the corresponding state variables
+  template <typename T>
+  void computePhysicalData(const T* state, T* data) const
+  {
+    using std::sqrt;
+    using MathTools::sqrt;
+
+    T rho = state[0];
+    for (CFuint i = 1; i < NS; ++i) {
+      rho += state[i];
+    }
+
+    const T ovRho = 1./rho;
+    for (CFuint i = 0; i < NS; ++i) {
+      data[Y+i] = state[i]*ovRho;
+    }
+
+    const T& u = state[NS];
+    const T& v = state[NS+1];
+    const T& temp = state[NS+2];
+    const T V2 = u*u + v*v;
+
+    T e[NS];
+    T cv[NS];
+    computeEnergies(rho, &data[Y], temp, e, cv);
+
+    T R = 0.;
+    T em = 0.;
+    T cvm = 0.;
+    for (CFuint i = 0; i < NS; ++i) {
+      R  += data[Y+i]*m_thermo->getRspecies(i);
+      em += data[Y+i]*e[i];
+      cvm += data[Y+i]*cv[i];
+    }
+
+    const T RT = R*temp;
+    const T gamma = 1. + R/cvm;
+
+    data[EULERTERM::RHO] = rho;
+    data[EULERTERM::P] = rho*RT;
+    data[EULERTERM::E] = em + 0.5*V2;
+    data[EULERTERM::H] = data[EULERTERM::E] + RT;
+    data[EULERTERM::A] = sqrt(gamma*RT);
+    data[EULERTERM::T] = temp;
+    data[EULERTERM::V] = sqrt(V2);
+    data[EULERTERM::VX] = u;
+    data[EULERTERM::VY] = v;
+    data[EULERTERM::GAMMA] = gamma;
+  }
+
+  /// Computes the convective flux projected on a normal
+  template <typename T>
+  void getFlux(const T* data, const CFreal* normal, T* flux) const
+  {
+    const CFreal nx = normal[XX];
+    const CFreal ny = normal[YY];
+    const T& u = data[EULERTERM::VX];
+    const T& v = data[EULERTERM::VY];
+    const T rhoVn = data[EULERTERM::RHO]*(u*nx + v*ny);
+    const T& p = data[EULERTERM::P];
+
+    for (CFuint i = 0; i < NS; ++i) {
+      flux[i] = rhoVn*data[Y+i];
+    }
+    flux[NS]   = p*nx + u*rhoVn;
+    flux[NS+1] = p*ny + v*rhoVn;
+    flux[NS+2] = rhoVn*data[EULERTERM::H];
+  }
+
+  /// Computes the conservative variables from the physical data
+  template <typename T>
+  void computeConsVariables(const T* data, T* cons) const
+  {
+    const T& rho = data[EULERTERM::RHO];
+    for (CFuint i = 0; i < NS; ++i) {
+      cons[i] = rho*data[Y+i];
+    }
+    cons[NS]   = rho*data[EULERTERM::VX];
+    cons[NS+1] = rho*data[EULERTERM::VY];
+    cons[NS+2] = rho*data[EULERTERM::E];
+  }
+
+  /// Set the vector of the eigenValues
+  template <typename T>
+  void computeEigenValues(const T* data, const CFreal* normal, T* eValues) const
+  {
+    const T un = data[EULERTERM::VX]*normal[XX] + data[EULERTERM::VY]*normal[YY];
+    const T& a = data[EULERTERM::A];
+    for (CFuint i = 0; i <= NS; ++i) {
+      eValues[i] = un;
+    }
+    eValues[NS+1] = un + a;
+    eValues[NS+2] = un - a;
+  }
+
+  /// Compute the maximum eigenvalue
+  template <typename T>
+  T getMaxEigenValue(const T* data, const CFreal* normal) const
+  {
+    const T un = data[EULERTERM::VX]*normal[XX] + data[EULERTERM::VY]*normal[YY];
+    return un + data[EULERTERM::A];
+  }
+
+  /// Compute the maximum absolute value eigenvalue
+  template <typename T>
+  T getMaxAbsEigenValue(const T* data, const CFreal* normal) const
+  {
+    const T un = data[EULERTERM::VX]*normal[XX] + data[EULERTERM::VY]*normal[YY];
+    return ((un < 0.) ? T(-un) : un) + data[EULERTERM::A];
+  }
+
+  /// Compute the sqrt(rho) weighted average of the physical data of two states
+  template <typename T>
+  void linearize(const T* dataL, const T* dataR, T* avData) const
+  {
+    using std::sqrt;
+    using MathTools::sqrt;
+
+    const T sqrtRhoL = sqrt(dataL[EULERTERM::RHO]);
+    const T sqrtRhoR = sqrt(dataR[EULERTERM::RHO]);
+    const T ovSum = 1./(sqrtRhoL + sqrtRhoR);
+    const T wL = sqrtRhoL*ovSum;
+    const T wR = sqrtRhoR*ovSum;
+    const T u = wL*dataL[EULERTERM::VX] + wR*dataR[EULERTERM::VX];
+    const T v = wL*dataL[EULERTERM::VY] + wR*dataR[EULERTERM::VY];
+    const T H = wL*dataL[EULERTERM::H] + wR*dataR[EULERTERM::H];
+    const T temp = wL*dataL[EULERTERM::T] + wR*dataR[EULERTERM::T];
+    const T rho = sqrtRhoL*sqrtRhoR;
+    const T V2 = u*u + v*v;
+    for (CFuint i = 0; i < NS; ++i) {
+      avData[Y+i] = wL*dataL[Y+i] + wR*dataR[Y+i];
+    }
+
+    avData[EULERTERM::RHO] = rho;
+    avData[EULERTERM::T] = temp;
+
+    T chi[NS];
+    T beta;
+    computePressureDerivatives(avData, chi, beta);
+
+    T a2 = beta*(H - 0.5*V2);
+    T R = 0.;
+    for (CFuint i = 0; i < NS; ++i) {
+      a2 += avData[Y+i]*chi[i];
+      R += avData[Y+i]*m_thermo->getRspecies(i);
+    }
+
+    avData[EULERTERM::P] = rho*R*temp;
+    avData[EULERTERM::H] = H;
+    avData[EULERTERM::E] = H - R*temp;
+    avData[EULERTERM::A] = sqrt(a2);
+    avData[EULERTERM::V] = sqrt(V2);
+    avData[EULERTERM::VX] = u;
+    avData[EULERTERM::VY] = v;
+    avData[EULERTERM::GAMMA] = 1. + beta;
+  }
+
+  /// Compute the eigenvalues and the right and left eigenvectors (stored
+  /// row by row) of the jacobian in conservative variables projected on
+  /// the normal, for the given (linearized) physical data
+  template <typename T>
+  void computeEigenValuesVectors(const T* data, const CFreal* normal,
+				 T* rightEv, T* leftEv, T* eValues) const
+  {
+    const CFuint N = NBEQS;
+    const CFreal nx = normal[XX];
+    const CFreal ny = normal[YY];
+    const T& rho = data[EULERTERM::RHO];
+    const T& u = data[EULERTERM::VX];
+    const T& v = data[EULERTERM::VY];
+    const T& H = data[EULERTERM::H];
+    const T& a = data[EULERTERM::A];
+    const T un = u*nx + v*ny;
+    const T halfV2 = 0.5*(u*u + v*v);
+    const T ovRho = 1./rho;
+    const T ovA = 1./a;
+    const T ovA2 = ovA*ovA;
+    const T ra = 0.5*rho*ovA;
+
+    T chi[NS];
+    T beta;
+    computePressureDerivatives(data, chi, beta);
+    const T ovBeta = 1./beta;
+    const T betaU = beta*u;
+    const T betaV = beta*v;
+
+    for (CFuint i = 0; i < N*N; ++i) {
+      rightEv[i] = 0.;
+      leftEv[i] = 0.;
+    }
+
+    // species waves
+    for (CFuint k = 0; k < NS; ++k) {
+      rightEv[k*N + k] = 1.;
+      rightEv[NS*N + k]     = u;
+      rightEv[(NS+1)*N + k] = v;
+      rightEv[(NS+2)*N + k] = halfV2 - chi[k]*ovBeta;
+
+      const T& yk = data[Y+k];
+      const T yOvA2 = yk*ovA2;
+      for (CFuint i = 0; i < NS; ++i) {
+	leftEv[k*N + i] = -yOvA2*(chi[i] + beta*halfV2);
+      }
+      leftEv[k*N + k] += 1.;
+      leftEv[k*N + NS]   = yOvA2*betaU;
+      leftEv[k*N + NS+1] = yOvA2*betaV;
+      leftEv[k*N + NS+2] = -yOvA2*beta;
+    }
+
+    // shear wave
+    rightEv[NS*N + NS]     = rho*ny;
+    rightEv[(NS+1)*N + NS] = -rho*nx;
+    rightEv[(NS+2)*N + NS] = rho*(u*ny - v*nx);
+
+    const T shearL = ovRho*(v*nx - u*ny);
+    for (CFuint i = 0; i < NS; ++i) {
+      leftEv[NS*N + i] = shearL;
+    }
+    leftEv[NS*N + NS]   = ovRho*ny;
+    leftEv[NS*N + NS+1] = -ovRho*nx;
+
+    // acoustic waves
+    for (CFuint i = 0; i < NS; ++i) {
+      rightEv[i*N + NS+1] = ra*data[Y+i];
+      rightEv[i*N + NS+2] = ra*data[Y+i];
+
+      const T pRhoiOvA = (chi[i] + beta*halfV2)*ovA;
+      leftEv[(NS+1)*N + i] = ovRho*(pRhoiOvA - un);
+      leftEv[(NS+2)*N + i] = ovRho*(pRhoiOvA + un);
+    }
+    rightEv[NS*N + NS+1]     = ra*(u + a*nx);
+    rightEv[NS*N + NS+2]     = ra*(u - a*nx);
+    rightEv[(NS+1)*N + NS+1] = ra*(v + a*ny);
+    rightEv[(NS+1)*N + NS+2] = ra*(v - a*ny);
+    rightEv[(NS+2)*N + NS+1] = ra*(H + a*un);
+    rightEv[(NS+2)*N + NS+2] = ra*(H - a*un);
+
+    const T betaUOvA = betaU*ovA;
+    const T betaVOvA = betaV*ovA;
+    const T betaOvRhoA = beta*ovRho*ovA;
+    leftEv[(NS+1)*N + NS]   = ovRho*(nx - betaUOvA);
+    leftEv[(NS+1)*N + NS+1] = ovRho*(ny - betaVOvA);
+    leftEv[(NS+1)*N + NS+2] = betaOvRhoA;
+    leftEv[(NS+2)*N + NS]   = -ovRho*(nx + betaUOvA);
+    leftEv[(NS+2)*N + NS+1] = -ovRho*(ny + betaVOvA);
+    leftEv[(NS+2)*N + NS+2] = betaOvRhoA;
+
+    computeEigenValues(data, normal, eValues);
+  }
+
+private:
+
+  /// Compute the species energies and heat capacities at the given
+  /// temperature, with their derivatives if T is a dual number
+  template <typename T>
+  void computeEnergies(const T& rho, const T* ys, const T& temp,
+		       T* e, T* cv) const
+  {
+    using MathTools::getValue;
+    using MathTools::chain;
+
+    CFreal rhoi[NS];
+    CFreal ev[NS];
+    CFreal cvv[NS];
+    CFreal dcv[NS];
+    const CFreal rhoV = getValue(rho);
+    for (CFuint i = 0; i < NS; ++i) {
+      rhoi[i] = rhoV*getValue(ys[i]);
+    }
+
+    m_thermo->computeEnergies(rhoi, getValue(temp), ev, cvv, dcv);
+    for (CFuint i = 0; i < NS; ++i) {
+      e[i]  = chain(temp, ev[i], cvv[i]);
+      cv[i] = chain(temp, cvv[i], dcv[i]);
+    }
+  }
+
+  /// Compute the derivatives of the pressure with respect to the partial
+  /// densities at constant velocity and temperature (chi_i = R_i T - beta e_i)
+  /// and with respect to rhoE (beta = R/cv)
+  template <typename T>
+  void computePressureDerivatives(const T* data, T* chi, T& beta) const
+  {
+    const T& temp = data[EULERTERM::T];
+    T e[NS];
+    T cv[NS];
+    computeEnergies(data[EULERTERM::RHO], &data[Y], temp, e, cv);
+
+    T R = 0.;
+    T cvm = 0.;
+    for (CFuint i = 0; i < NS; ++i) {
+      R   += data[Y+i]*m_thermo->getRspecies(i);
+      cvm += data[Y+i]*cv[i];
+    }
+
+    beta = R/cvm;
+    for (CFuint i = 0; i < NS; ++i) {
+      chi[i] = m_thermo->getRspecies(i)*temp - beta*e[i];
+    }
+  }
+
+private:
+
+  /// thermodynamic properties of the species
+  THERMO* m_thermo;
+
+}; // end of class Euler2DNEQRhoivtT
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace NEQ
+
+  } // namespace Physics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Physics_NEQ_Euler2DNEQRhoivtT_hh
@@ -0,0 +1,110 @@
+#include "NEQ/NEQLibraryThermo.hh"
+#include "Framework/PhysicalChemicalLibrary.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Framework;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Physics {
+
+    namespace NEQ {
+
+//////////////////////////////////////////////////////////////////////////////
+
+NEQLibraryThermo::NEQLibraryThermo() :
+  m_library(CFNULL),
+  m_Rspecies(),
+  m_rhoi(),
+  m_tVec(),
+  m_hs(),
+  m_eMinus(),
+  m_e(),
+  m_ePlus()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+NEQLibraryThermo::~NEQLibraryThermo()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void NEQLibraryThermo::setup(Common::SafePtr<PhysicalChemicalLibrary> library)
+{
+  m_library = library;
+  
+  const CFuint nbSpecies = m_library->getNbSpecies();
+  RealVector mm(nbSpecies);
+  m_library->getMolarMasses(mm);
+  
+  m_Rspecies.resize(nbSpecies);
+  for (CFuint i = 0; i < nbSpecies; ++i) {
+    m_Rspecies[i] = m_library->getRgas()/mm[i];
+  }
+  
+  m_rhoi.resize(nbSpecies);
+  m_hs.resize(nbSpecies);
+  m_eMinus.resize(nbSpecies);
+  m_e.resize(nbSpecies);
+  m_ePlus.resize(nbSpecies);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void NEQLibraryThermo::computeEnergies(const CFreal* rhoi, CFreal temp,
+				       CFreal* e, CFreal* cv, CFreal* dcv)
+{
+  const CFuint nbSpecies = m_Rspecies.size();
+  for (CFuint i = 0; i < nbSpecies; ++i) {
+    m_rhoi[i] = rhoi[i];
+  }
+  
+  const CFreal dT = 1e-4*temp;
+  computeEnergies(rhoi, temp - dT, m_eMinus);
+  computeEnergies(rhoi, temp + dT, m_ePlus);
+  computeEnergies(rhoi, temp, m_e);
+  
+  const CFreal ovDT = 1./dT;
+  for (CFuint i = 0; i < nbSpecies; ++i) {
+    e[i] = m_e[i];
+    cv[i] = 0.5*(m_ePlus[i] - m_eMinus[i])*ovDT;
+    dcv[i] = (m_ePlus[i] - 2.*m_e[i] + m_eMinus[i])*ovDT*ovDT;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void NEQLibraryThermo::computeEnergies(const CFreal* rhoi, CFreal temp,
+				       RealVector& e)
+{
+  // some libraries take the temperature from the thermodynamic state
+  CFreal T = temp;
+  m_library->setState(&m_rhoi[0], &T);
+  
+  CFreal p = 0.;
+  for (CFuint i = 0; i < m_Rspecies.size(); ++i) {
+    p += rhoi[i]*m_Rspecies[i]*temp;
+  }
+  
+  m_library->getSpeciesTotEnthalpies(T, m_tVec, p, m_hs);
+  for (CFuint i = 0; i < m_Rspecies.size(); ++i) {
+    e[i] = m_hs[i] - m_Rspecies[i]*temp;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace NEQ
+
+  } // namespace Physics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,95 @@
+#ifndef COOLFluiD_Physics_NEQ_NEQLibraryThermo_hh
+#define COOLFluiD_Physics_NEQ_NEQLibraryThermo_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Common/SafePtr.hh"
+#include "MathTools/RealVector.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+    class PhysicalChemicalLibrary;
+  }
+
+  namespace Physics {
+
+    namespace NEQ {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class provides the species thermodynamic properties needed by
+ * Euler2DNEQRhoivtT from the physical chemical library, in dimensional units.
+ * The internal energies are e_i = h_i - R_i T, the heat capacities and
+ * their derivatives are computed by central differences in temperature.
+ *
+ */
+class NEQLibraryThermo {
+public:
+
+  /**
+   * Constructor
+   */
+  NEQLibraryThermo();
+
+  /**
+   * Default destructor
+   */
+  ~NEQLibraryThermo();
+
+  /**
+   * Set up the species gas constants and the work arrays
+   */
+  void setup(Common::SafePtr<Framework::PhysicalChemicalLibrary> library);
+
+  /// @return the gas constant of the given species
+  CFreal getRspecies(CFuint i) const {return m_Rspecies[i];}
+
+  /// Compute the internal energies per unit mass of the species, their
+  /// derivatives with respect to the temperature and the derivatives of the latter
+  void computeEnergies(const CFreal* rhoi, CFreal temp,
+		       CFreal* e, CFreal* cv, CFreal* dcv);
+
+private:
+
+  /// Compute the species internal energies at the given temperature
+  void computeEnergies(const CFreal* rhoi, CFreal temp, RealVector& e);
+
+private:
+
+  /// physical chemical library
+  Common::SafePtr<Framework::PhysicalChemicalLibrary> m_library;
+
+  /// gas constants of the species
+  RealVector m_Rspecies;
+
+  /// partial densities passed to the library
+  RealVector m_rhoi;
+
+  /// vibrational temperatures (none)
+  RealVector m_tVec;
+
+  /// species enthalpies
+  RealVector m_hs;
+
+  /// species energies at T - dT, T, T + dT
+  RealVector m_eMinus;
+  RealVector m_e;
+  RealVector m_ePlus;
+
+}; // end of class NEQLibraryThermo
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace NEQ
+
+  } // namespace Physics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Physics_NEQ_NEQLibraryThermo_hh
@@ -16,7 +16,8 @@ namespace COOLFluiD {
 //////////////////////////////////////////////////////////////////////////////
 
 /**
- * This class represents a Euler physical model 2D for conservative variables
+ * This class represents a Euler physical model 2D for conservative variables,
+ * written for a generic scalar type
  *
  * @author Ray Vandenhoeck
  */
@@ -42,23 +43,27 @@ public: // function
   HOST_DEVICE ~Euler2DConsT() {}
   
   /// Compute the physical data starting ffrom the corresponding state variables
-  HOST_DEVICE void computePhysicalData(CFreal* state, CFreal* data) 
+  template <typename T>
+  HOST_DEVICE void computePhysicalData(const T* state, T* data) const
   { 
+    using std::sqrt;
+    using MathTools::sqrt;
+    
     // we assume that if conservative variables are used, the flow is compressible
     // p = static pressure
-    const CFreal rho  = state[0];
-    const CFreal ovRho = 1./rho;
-    const CFreal u = state[1]*ovRho;
-    const CFreal v = state[2]*ovRho;
-    const CFreal V2 = u*u + v*v;
+    const T& rho  = state[0];
+    const T ovRho = 1./rho;
+    const T u = state[1]*ovRho;
+    const T v = state[2]*ovRho;
+    const T V2 = u*u + v*v;
     const CFreal gamma = m_dco->gamma;
     const CFreal gammaMinus1 = gamma - 1.;
-    const CFreal rhoE = state[3];
+    const T& rhoE = state[3];
   
     data[EulerTerm::RHO] = rho;
     data[EulerTerm::P] = gammaMinus1*(rhoE - 0.5*rho*V2);
   
-    const CFreal pOvRho = data[EulerTerm::P]*ovRho;
+    const T pOvRho = data[EulerTerm::P]*ovRho;
     data[EulerTerm::E] = rhoE*ovRho;
     data[EulerTerm::H] = data[EulerTerm::E] + pOvRho;
     data[EulerTerm::A] = sqrt(gamma*pOvRho);
@@ -69,6 +74,71 @@ public: // function
     data[EulerTerm::GAMMA] = gamma;
   }
   
+  /// Compute the eigenvalues and the right and left eigenvectors (stored
+  /// row by row) of the jacobian in conservative variables projected on
+  /// the normal, for the given (linearized) physical data
+  template <typename T>
+  HOST_DEVICE void computeEigenValuesVectors(const T* data, const CFreal* normal,
+					     T* rightEv, T* leftEv, T* eValues) const
+  {
+    const CFreal nx = normal[XX];
+    const CFreal ny = normal[YY];
+    const T& avRho = data[EulerTerm::RHO];
+    const T& avU   = data[EulerTerm::VX];
+    const T& avV   = data[EulerTerm::VY];
+    const T& avH   = data[EulerTerm::H];
+    const T& avA   = data[EulerTerm::A];
+    const T ovAvA = 1./avA;
+    const T ovAvA2 = ovAvA*ovAvA;
+    const CFreal gammaMinus1 = m_dco->gamma - 1.;
+    const T um = avU*nx + avV*ny;
+    const T ra = 0.5*avRho*ovAvA;
+    const T coeffM2 = 0.5*gammaMinus1*(avU*avU + avV*avV)*ovAvA2;
+    const T ovAvRho = 1./avRho;
+    const T uDivA = gammaMinus1*avU*ovAvA;
+    const T vDivA = gammaMinus1*avV*ovAvA;
+    const T ovAvRhoA = ovAvRho*ovAvA;
+    
+    rightEv[0]  = 1.;
+    rightEv[1]  = 0.;
+    rightEv[2]  = ra;
+    rightEv[3]  = ra;
+    rightEv[4]  = avU;
+    rightEv[5]  = avRho*ny;
+    rightEv[6]  = ra*(avU + avA*nx);
+    rightEv[7]  = ra*(avU - avA*nx);
+    rightEv[8]  = avV;
+    rightEv[9]  = -avRho*nx;
+    rightEv[10] = ra*(avV + avA*ny);
+    rightEv[11] = ra*(avV - avA*ny);
+    rightEv[12] = 0.5*(avU*avU + avV*avV);
+    rightEv[13] = avRho*(avU*ny - avV*nx);
+    rightEv[14] = ra*(avH + avA*um);
+    rightEv[15] = ra*(avH - avA*um);
+    
+    leftEv[0]  = 1. - coeffM2;
+    leftEv[1]  = uDivA*ovAvA;
+    leftEv[2]  = vDivA*ovAvA;
+    leftEv[3]  = -gammaMinus1*ovAvA2;
+    leftEv[4]  = ovAvRho*(avV*nx - avU*ny);
+    leftEv[5]  = ovAvRho*ny;
+    leftEv[6]  = -ovAvRho*nx;
+    leftEv[7]  = 0.0;
+    leftEv[8]  = avA*ovAvRho*(coeffM2 - um*ovAvA);
+    leftEv[9]  = ovAvRho*(nx - uDivA);
+    leftEv[10] = ovAvRho*(ny - vDivA);
+    leftEv[11] = gammaMinus1*ovAvRhoA;
+    leftEv[12] = avA*ovAvRho*(coeffM2 + um*ovAvA);
+    leftEv[13] = -ovAvRho*(nx + uDivA);
+    leftEv[14] = -ovAvRho*(ny + vDivA);
+    leftEv[15] = gammaMinus1*ovAvRhoA;
+    
+    eValues[0] = um;
+    eValues[1] = um;
+    eValues[2] = um + avA;
+    eValues[3] = um - avA;
+  }
+  
 }; // end of class Euler2DConsT
 
 //////////////////////////////////////////////////////////////////////////////
@@ -3,6 +3,7 @@
 
 //////////////////////////////////////////////////////////////////////////////
 
+#include "MathTools/DualNumber.hh"
 #include "NavierStokes/EulerTerm.hh"
 
 using namespace std;
@@ -19,101 +20,142 @@ namespace COOLFluiD {
 
 /**
  * This class represents a variable set for the 2D Euler physical model ported to GPU.
+ * All the functions are written for a generic scalar type T (CFreal or
+ * MathTools::DualNumber), the normal being always made of CFreal.
  *
  * @author Ray Vandenhoeck
  */
 class Euler2DVarSetT {
-  
+
 public: // classes
 
   enum {DIM=2, NBEQS=4, DATASIZE = 14};
   typedef EulerTerm PTERM;
-  
+
   /**
    * Constructor
    * @see EulerPhysicalModel
    */
   HOST_DEVICE Euler2DVarSetT(EulerTerm::DeviceConfigOptions<NOTYPE>* dco) :
-    m_dco(dco) {} 
-  
+    m_dco(dco) {}
+
   /**
    * Constructor
    * @see EulerPhysicalModel
    */
   HOST_DEVICE Euler2DVarSetT() {}
-  
+
   /**
    * Set the model data
    */
   HOST_DEVICE void setModelData(EulerTerm::DeviceConfigOptions<NOTYPE>* dco) {m_dco = dco;}
-  
+
   /**
    * Default destructor
    */
   HOST_DEVICE virtual ~Euler2DVarSetT() {}
-  
+
   /// Computes the convective flux projected on a normal
-  HOST_DEVICE void getFlux(CFreal* data, CFreal* normal, CFreal* flux) 
+  template <typename T>
+  HOST_DEVICE void getFlux(const T* data, const CFreal* normal, T* flux) const
   {
     const CFreal nx = normal[XX];
     const CFreal ny = normal[YY];
-    const CFreal rho = data[EulerTerm::RHO];
-    const CFreal u = data[EulerTerm::VX];
-    const CFreal v = data[EulerTerm::VY];
-    const CFreal un = u*nx  + v*ny;
-    const CFreal rhoVn = data[EulerTerm::RHO]*un;
-    const CFreal p = data[EulerTerm::P];
+    const T& u = data[EulerTerm::VX];
+    const T& v = data[EulerTerm::VY];
+    const T un = u*nx  + v*ny;
+    const T rhoVn = data[EulerTerm::RHO]*un;
+    const T& p = data[EulerTerm::P];
 
     flux[0] = rhoVn;
     flux[1] = p*nx + u*rhoVn;
     flux[2] = p*ny + v*rhoVn;
     flux[3] = rhoVn*data[EulerTerm::H];
   }
-  
-  
+
+  /// Computes the conservative variables from the physical data
+  template <typename T>
+  HOST_DEVICE void computeConsVariables(const T* data, T* cons) const
+  {
+    const T& rho = data[EulerTerm::RHO];
+    cons[0] = rho;
+    cons[1] = rho*data[EulerTerm::VX];
+    cons[2] = rho*data[EulerTerm::VY];
+    cons[3] = rho*data[EulerTerm::E];
+  }
+
   /// Set the vector of the eigenValues
-  HOST_DEVICE  void computeEigenValues (CFreal* data, CFreal* normal, CFreal* eValues)
+  template <typename T>
+  HOST_DEVICE void computeEigenValues(const T* data, const CFreal* normal, T* eValues) const
   {
     const CFreal nx = normal[XX];
     const CFreal ny = normal[YY];
-    const CFreal u = data[EulerTerm::VX];
-    const CFreal v = data[EulerTerm::VY];
-    const CFreal un = u*nx  + v*ny;
-    const CFreal a = data[EulerTerm::A];
+    const T un = data[EulerTerm::VX]*nx + data[EulerTerm::VY]*ny;
+    const T& a = data[EulerTerm::A];
 
     eValues[0] = un;
     eValues[1] = un;
     eValues[2] = un + a;
     eValues[3] = un - a;
   }
-  
+
   /// Compute the maximum eigenvalue
-  HOST_DEVICE  CFreal getMaxEigenValue(CFreal* data, CFreal* normal)
+  template <typename T>
+  HOST_DEVICE T getMaxEigenValue(const T* data, const CFreal* normal) const
   {
     const CFreal nx = normal[XX];
     const CFreal ny = normal[YY];
-    const CFreal u = data[EulerTerm::VX];
-    const CFreal v = data[EulerTerm::VY];
-    const CFreal un = u*nx  + v*ny;
+    const T un = data[EulerTerm::VX]*nx + data[EulerTerm::VY]*ny;
     return un + data[EulerTerm::A];
   }
-  
+
   /// Compute the maximum absolute value eigenvalue
-  HOST_DEVICE  CFreal getMaxAbsEigenValue(CFreal* data, CFreal* normal)
+  template <typename T>
+  HOST_DEVICE T getMaxAbsEigenValue(const T* data, const CFreal* normal) const
   {
     const CFreal nx = normal[XX];
     const CFreal ny = normal[YY];
-    const CFreal u = data[EulerTerm::VX];
-    const CFreal v = data[EulerTerm::VY];
-    const CFreal un = u*nx  + v*ny;
-    return fabs(un) + data[EulerTerm::A];
+    const T un = data[EulerTerm::VX]*nx + data[EulerTerm::VY]*ny;
+    return ((un < 0.) ? T(-un) : un) + data[EulerTerm::A];
+  }
+
+  /// Compute the Roe averaged physical data of two states
+  template <typename T>
+  HOST_DEVICE void linearize(const T* dataL, const T* dataR, T* avData) const
+  {
+    using std::sqrt;
+    using MathTools::sqrt;
+
+    const T sqrtRhoL = sqrt(dataL[EulerTerm::RHO]);
+    const T sqrtRhoR = sqrt(dataR[EulerTerm::RHO]);
+    const T ovSum = 1./(sqrtRhoL + sqrtRhoR);
+    const T wL = sqrtRhoL*ovSum;
+    const T wR = sqrtRhoR*ovSum;
+    const T u = wL*dataL[EulerTerm::VX] + wR*dataR[EulerTerm::VX];
+    const T v = wL*dataL[EulerTerm::VY] + wR*dataR[EulerTerm::VY];
+    const T H = wL*dataL[EulerTerm::H] + wR*dataR[EulerTerm::H];
+    const T V2 = u*u + v*v;
+    const CFreal gamma = m_dco->gamma;
+    const T rho = sqrtRhoL*sqrtRhoR;
+    const T a2 = (gamma - 1.)*(H - 0.5*V2);
+
+    avData[EulerTerm::RHO] = rho;
+    avData[EulerTerm::P] = rho*a2/gamma;
+    avData[EulerTerm::H] = H;
+    avData[EulerTerm::E] = H - a2/gamma;
+    avData[EulerTerm::A] = sqrt(a2);
+    avData[EulerTerm::T] = a2/(gamma*m_dco->R);
+    avData[EulerTerm::V] = sqrt(V2);
+    avData[EulerTerm::VX] = u;
+    avData[EulerTerm::VY] = v;
+    avData[EulerTerm::GAMMA] = gamma;
   }
-  
+
 protected:
-  
+
   /// configurable options
   EulerTerm::DeviceConfigOptions<NOTYPE>* m_dco;
-  
+
 }; // end of class Euler2DVarSetT
 
 //////////////////////////////////////////////////////////////////////////////
@@ -127,4 +169,3 @@ protected:
 //////////////////////////////////////////////////////////////////////////////
 
 #endif // COOLFluiD_Physics_NavierStokes_Euler2DVarSetT_hh
-
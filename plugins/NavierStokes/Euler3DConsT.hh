@@ -0,0 +1,183 @@
+#ifndef COOLFluiD_Physics_NavierStokes_Euler3DConsT_hh
+#define COOLFluiD_Physics_NavierStokes_Euler3DConsT_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Euler3DVarSetT.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Physics {
+
+    namespace NavierStokes {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This class represents a Euler physical model 3D for conservative variables,
+ * written for a generic scalar type
+ *
+ */
+class Euler3DConsT : public Euler3DVarSetT {
+public: // function
+  
+  /**
+   * Constructor
+   * @see EulerPhysicalModel
+   */
+  HOST_DEVICE Euler3DConsT(EulerTerm::DeviceConfigOptions<NOTYPE>* dco) : 
+    Euler3DVarSetT(dco) {}
+ 
+  /**
+   * Constructor
+   * @see EulerPhysicalModel
+   */
+  HOST_DEVICE Euler3DConsT() : Euler3DVarSetT() {}
+  
+  /**
+   * Default destructor
+   */
+  HOST_DEVICE ~Euler3DConsT() {}
+  
+  /// Compute the physical data starting ffrom the corresponding state variables
+  template <typename T>
+  HOST_DEVICE void computePhysicalData(const T* state, T* data) const
+  { 
+    using std::sqrt;
+    using MathTools::sqrt;
+    
+    // we assume that if conservative variables are used, the flow is compressible
+    // p = static pressure
+    const T& rho  = state[0];
+    const T ovRho = 1./rho;
+    const T u = state[1]*ovRho;
+    const T v = state[2]*ovRho;
+    const T w = state[3]*ovRho;
+    const T V2 = u*u + v*v + w*w;
+    const CFreal gamma = m_dco->gamma;
+    const CFreal gammaMinus1 = gamma - 1.;
+    const T& rhoE = state[4];
+  
+    data[EulerTerm::RHO] = rho;
+    data[EulerTerm::P] = gammaMinus1*(rhoE - 0.5*rho*V2);
+  
+    const T pOvRho = data[EulerTerm::P]*ovRho;
+    data[EulerTerm::E] = rhoE*ovRho;
+    data[EulerTerm::H] = data[EulerTerm::E] + pOvRho;
+    data[EulerTerm::A] = sqrt(gamma*pOvRho);
+    data[EulerTerm::T] = pOvRho/m_dco->R;
+    data[EulerTerm::V] = sqrt(V2);
+    data[EulerTerm::VX] = u;
+    data[EulerTerm::VY] = v;
+    data[EulerTerm::VZ] = w;
+    data[EulerTerm::GAMMA] = gamma;
+  }
+  
+  /// Compute the eigenvalues and the right and left eigenvectors (stored
+  /// row by row) of the jacobian in conservative variables projected on
+  /// the normal, for the given (linearized) physical data
+  template <typename T>
+  HOST_DEVICE void computeEigenValuesVectors(const T* data, const CFreal* normal,
+					     T* rightEv, T* leftEv, T* eValues) const
+  {
+    const CFreal gammaMinus1 = m_dco->gamma - 1.;
+    const CFreal nx = normal[XX];
+    const CFreal ny = normal[YY];
+    const CFreal nz = normal[ZZ];
+    const T& avRho = data[EulerTerm::RHO];
+    const T& avU   = data[EulerTerm::VX];
+    const T& avV   = data[EulerTerm::VY];
+    const T& avW   = data[EulerTerm::VZ];
+    const T& avH   = data[EulerTerm::H];
+    const T& avA   = data[EulerTerm::A];
+    const T avK = 0.5*(avU*avU + avV*avV + avW*avW);
+    const T um = avU*nx + avV*ny + avW*nz;
+    const T ra = 0.5*avRho/avA;
+    const T avA2 = avA*avA;
+    const T invAvRho = 1./avRho;
+    const T k1 = gammaMinus1*avK/avA2;
+    const T k2 = 1.0 - k1;
+    const T k3 = -gammaMinus1/avA2;
+    const T uDivA = gammaMinus1*avU/avA;
+    const T vDivA = gammaMinus1*avV/avA;
+    const T wDivA = gammaMinus1*avW/avA;
+    const T uDivA2 = uDivA/avA;
+    const T vDivA2 = vDivA/avA;
+    const T wDivA2 = wDivA/avA;
+    const T rhoA = avRho*avA;
+    
+    rightEv[0]  = nx;
+    rightEv[1]  = ny;
+    rightEv[2]  = nz;
+    rightEv[3]  = ra;
+    rightEv[4]  = ra;
+    rightEv[5]  = avU*nx;
+    rightEv[6]  = avU*ny - avRho*nz;
+    rightEv[7]  = avU*nz + avRho*ny;
+    rightEv[8]  = ra*(avU + avA*nx);
+    rightEv[9]  = ra*(avU - avA*nx);
+    rightEv[10] = avV*nx + avRho*nz;
+    rightEv[11] = avV*ny;
+    rightEv[12] = avV*nz - avRho*nx;
+    rightEv[13] = ra*(avV + avA*ny);
+    rightEv[14] = ra*(avV - avA*ny);
+    rightEv[15] = avW*nx - avRho*ny;
+    rightEv[16] = avW*ny + avRho*nx;
+    rightEv[17] = avW*nz;
+    rightEv[18] = ra*(avW + avA*nz);
+    rightEv[19] = ra*(avW - avA*nz);
+    rightEv[20] = avK*nx + avRho*(avV*nz - avW*ny);
+    rightEv[21] = avK*ny + avRho*(avW*nx - avU*nz);
+    rightEv[22] = avK*nz + avRho*(avU*ny - avV*nx);
+    rightEv[23] = ra*(avH + avA*um);
+    rightEv[24] = ra*(avH - avA*um);
+    
+    leftEv[0]  = nx*k2 - invAvRho*(avV*nz - avW*ny);
+    leftEv[1]  = uDivA2*nx;
+    leftEv[2]  = vDivA2*nx + nz*invAvRho;
+    leftEv[3]  = wDivA2*nx - ny*invAvRho;
+    leftEv[4]  = k3*nx;
+    leftEv[5]  = ny*k2 - invAvRho*(avW*nx - avU*nz);
+    leftEv[6]  = uDivA2*ny - nz*invAvRho;
+    leftEv[7]  = vDivA2*ny;
+    leftEv[8]  = wDivA2*ny + nx*invAvRho;
+    leftEv[9]  = k3*ny;
+    leftEv[10] = nz*k2 - invAvRho*(avU*ny - avV*nx);
+    leftEv[11] = uDivA2*nz + ny*invAvRho;
+    leftEv[12] = vDivA2*nz - nx*invAvRho;
+    leftEv[13] = wDivA2*nz;
+    leftEv[14] = k3*nz;
+    leftEv[15] = avA*invAvRho*(k1 - um/avA);
+    leftEv[16] = invAvRho*(nx - uDivA);
+    leftEv[17] = invAvRho*(ny - vDivA);
+    leftEv[18] = invAvRho*(nz - wDivA);
+    leftEv[19] = gammaMinus1/rhoA;
+    leftEv[20] = avA*invAvRho*(k1 + um/avA);
+    leftEv[21] = invAvRho*(-nx - uDivA);
+    leftEv[22] = invAvRho*(-ny - vDivA);
+    leftEv[23] = invAvRho*(-nz - wDivA);
+    leftEv[24] = gammaMinus1/rhoA;
+    
+    eValues[0] = um;
+    eValues[1] = um;
+    eValues[2] = um;
+    eValues[3] = um + avA;
+    eValues[4] = um - avA;
+  }
+  
+}; // end of class Euler3DConsT
+
+//////////////////////////////////////////////////////////////////////////////
+
+    } // namespace NavierStokes
+
+  } // namespace Physics
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Physics_NavierStokes_Euler3DConsT_hh
+
@@ -29,7 +29,6 @@ namespace COOLFluiD {
 class EulerTerm : public Framework::BaseTerm {
 public:
     
-  #ifdef CF_HAVE_CUDA
   /// nested class defining local options
   template <typename P = NOTYPE>
   class DeviceConfigOptions {
@@ -54,20 +53,21 @@ public:
     CFreal R;
   };
   
+  #ifdef CF_HAVE_CUDA
   /// copy the local configuration options to the Framework::DEVICE
   void copyConfigOptionsToDevice(DeviceConfigOptions<NOTYPE>* dco) 
   {
     CudaEnv::copyHost2Dev(&dco->gamma, &_gamma, 1);
     CudaEnv::copyHost2Dev(&dco->R, &_RDim, 1);
   }  
+  #endif
   
-  /// copy the local configuration options to the Framework::DEVICE
+  /// copy the local configuration options to the given object
   void copyConfigOptions(DeviceConfigOptions<NOTYPE>* dco) 
   {
     dco->gamma = _gamma;
     dco->R = _RDim;
   }     
-  #endif
 
   /**
    * Defines the Config Option's of this class
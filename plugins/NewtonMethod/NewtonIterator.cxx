@@ -12,6 +12,7 @@
 #include "Framework/SubSystemStatus.hh"
 #include "Framework/SpaceMethod.hh"
 #include "Framework/CFL.hh"
+#include "Framework/Profiler.hh"
 #include "Framework/StopConditionController.hh"
 #include "NewtonMethod/NewtonMethod.hh"
 #include "NewtonMethod/NewtonIterator.hh"
@@ -55,7 +56,12 @@ void NewtonIterator::defineConfigOptions(Config::OptionList& options)
 //////////////////////////////////////////////////////////////////////////////
 
 NewtonIterator::NewtonIterator(const std::string& name)
-  : ConvergenceMethod(name)
+  : ConvergenceMethod(name),
+    m_jacobAge(0),
+    m_jacobCFL(0.),
+    m_jacobLinearIter(0),
+    m_lastLinearIter(0),
+    m_residualStalled(false)
 {
   addConfigOptionsTo(this);
 
@@ -141,6 +147,10 @@ void NewtonIterator::setMethodImpl()
   m_data->setLinearSystemSolver(getLinearSystemSolver());
   setupCommandsAndStrategies();
   m_setup->execute();
+  
+  // no jacobian is available yet
+  m_jacobAge = 0;
+  m_residualStalled = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -227,13 +237,25 @@ void NewtonIterator::takeStepImpl()
     subSysStatus->setFirstStep( k == 1 );
     subSysStatus->setMaxDT(MathTools::MathConsts::CFrealMax());
     
-    m_init->execute();
+    {
+      CFPROFILE(m_init->getName());
+      m_init->execute();
+    }
     CFLog(VERBOSE, "NewtonIterator::takeStep(): preparing Computation\n");
     getMethodData()->getCollaborator<SpaceMethod>()->prepareComputation();
    
-    CFLog(VERBOSE, "NewtonIterator::takeStep(): m_data->freezeJacobian() " << m_data->freezeJacobian() << "\n");
-    // this will make the solvers compute the jacobian only during the first iteration at each time step
-    (m_data->freezeJacobian() && k > 1) ? m_data->setDoComputeJacobFlag(false) : m_data->setDoComputeJacobFlag(true);
+    bool cflUpdated = false;
+    if (m_data->isReuseJacobian()) {
+      // the CFL is updated first, since its change can ask for a new jacobian
+      getConvergenceMethodData()->getCFL()->update(cvgst.get());
+      cflUpdated = true;
+      m_data->setDoComputeJacobFlag(jacobianNeedsUpdate());
+    }
+    else {
+      CFLog(VERBOSE, "NewtonIterator::takeStep(): m_data->freezeJacobian() " << m_data->freezeJacobian() << "\n");
+      // this will make the solvers compute the jacobian only during the first iteration at each time step
+      (m_data->freezeJacobian() && k > 1) ? m_data->setDoComputeJacobFlag(false) : m_data->setDoComputeJacobFlag(true);
+    }
     
     // this is needed for cases like jacobian free
     getMethodData()->getCollaborator<SpaceMethod>()->setComputeJacobianFlag( m_data->getDoComputeJacobFlag() );
@@ -244,13 +266,16 @@ void NewtonIterator::takeStepImpl()
     
     CFLog(VERBOSE, "NewtonIterator::takeStep(): before second update CFL\n");
     
-    if (m_data->getDoComputeJacobFlag()) {
+    if (m_data->getDoComputeJacobFlag() && !cflUpdated) {
       getConvergenceMethodData()->getCFL()->update(cvgst.get());
     }
     
     // do an intermediate step, useful for some special types of temporal discretization
     CFLog(VERBOSE, "NewtonIterator::takeStep(): calling Intermediate step\n");
-    m_intermediate->execute();
+    {
+      CFPROFILE(m_intermediate->getName());
+      m_intermediate->execute();
+    }
     
     CFLog(VERBOSE, "NewtonIterator::takeStep(): computing the Time Residual\n");
     getMethodData()->getCollaborator<SpaceMethod>()->computeTimeResidual(1.0);
@@ -262,6 +287,13 @@ void NewtonIterator::takeStepImpl()
     CFLog(VERBOSE, "NewtonIterator::takeStep(): solving the linear system\n");
     timer.restart();
 
+    // the preconditioner is kept as long as the jacobian is reused
+    if (m_data->isReuseJacobian()) {
+      for (CFuint i = 0; i < getLinearSystemSolver().size(); ++i) {
+	getLinearSystemSolver()[i]->setReusePreconditioner(!m_data->getDoComputeJacobFlag());
+      }
+    }
+    
     // solve the linear system
     getLinearSystemSolver().apply(mem_fun(&LinearSystemSolver::solveSys), 
 				  m_data->getNbLSSToSolveAtOnce());
@@ -280,10 +312,19 @@ void NewtonIterator::takeStepImpl()
     }
 
     CFLog(VERBOSE, "NewtonIterator::takeStep(): updating the solution\n");
-    m_updateSol->execute();
+    {
+      CFPROFILE(m_updateSol->getName());
+      m_updateSol->execute();
+    }
+    
+    const CFreal prevResidual = subSysStatus->getResidual();
     
     // synchronize the states and compute the residual norms
     ConvergenceMethod::syncGlobalDataComputeResidual(true);
+    
+    if (m_data->isReuseJacobian()) {
+      updateJacobianReuseInfo(prevResidual);
+    }
 
     getMethodData()->getCollaborator<SpaceMethod>()->postProcessSolution();
     getConvergenceMethodData()->getConvergenceStatus().res = subSysStatus->getResidual();
@@ -305,6 +346,62 @@ void NewtonIterator::takeStepImpl()
   CFLog(VERBOSE, "NewtonIterator::takeStepImpl() END\n");
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+bool NewtonIterator::jacobianNeedsUpdate()
+{
+  const CFreal cfl = getConvergenceMethodData()->getCFL()->getCFLValue();
+  
+  string reason = "";
+  if (m_jacobAge == 0) {
+    reason = "no jacobian available";
+  }
+  else if (m_jacobAge >= m_data->getReuseMaxSteps()) {
+    reason = "maximum number of steps reached";
+  }
+  else if (m_lastLinearIter > m_data->getReuseMaxLinearIterRatio()*std::max(m_jacobLinearIter, (CFuint)1)) {
+    reason = "linear iterations grew from " + StringOps::to_str(m_jacobLinearIter) +
+      " to " + StringOps::to_str(m_lastLinearIter);
+  }
+  else if (m_residualStalled) {
+    reason = "residual stalled";
+  }
+  else if (cfl > m_data->getReuseMaxCFLRatio()*m_jacobCFL ||
+	   m_jacobCFL > m_data->getReuseMaxCFLRatio()*cfl) {
+    reason = "CFL changed from " + StringOps::to_str(m_jacobCFL) + " to " + StringOps::to_str(cfl);
+  }
+  
+  if (reason.empty()) {
+    CFLog(VERBOSE, "NewtonIterator::jacobianNeedsUpdate() => reusing jacobian of age " << m_jacobAge << "\n");
+    return false;
+  }
+  
+  CFLog(VERBOSE, "NewtonIterator::jacobianNeedsUpdate() => recomputing jacobian: " << reason << "\n");
+  m_jacobAge = 0;
+  m_jacobCFL = cfl;
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void NewtonIterator::updateJacobianReuseInfo(CFreal prevResidual)
+{
+  // the largest number of iterations among the solved systems is monitored
+  m_lastLinearIter = 0;
+  for (CFuint i = 0; i < getLinearSystemSolver().size(); ++i) {
+    m_lastLinearIter = std::max(m_lastLinearIter, getLinearSystemSolver()[i]->getNbIterations());
+  }
+  
+  if (m_jacobAge == 0) {
+    m_jacobLinearIter = m_lastLinearIter;
+  }
+  ++m_jacobAge;
+  
+  // the residual is given in orders of magnitude
+  const CFreal residual = SubSystemStatusStack::getActive()->getResidual();
+  m_residualStalled = (prevResidual - residual < m_data->getReuseMinResidualDrop());
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
     } // namespace NewtonMethod
@@ -77,6 +77,16 @@ protected: // abstract interface implementations
   /// Perform the prepare phase before any iteration
   virtual void prepare ();
 
+  /// Decide if the jacobian (and the preconditioner) has to be recomputed
+  /// in the current step, when reusing the jacobian across steps
+  /// @return true if the jacobian has to be recomputed
+  bool jacobianNeedsUpdate();
+
+  /// Store the information needed to decide if the jacobian can be reused,
+  /// after the linear system has been solved and the residual updated
+  /// @param prevResidual residual (log10) before the current step
+  void updateJacobianReuseInfo(CFreal prevResidual);
+
 protected: // member data
 
 ///The data to share between NewtonMethodMethod commands
@@ -125,6 +135,21 @@ protected: // member data
   ///The string for configuration of m_aleUpdate command
   std::string m_aleUpdateStr;
 
+  /// number of steps performed with the current jacobian (0 if none is available)
+  CFuint m_jacobAge;
+
+  /// CFL used to compute the current jacobian
+  CFreal m_jacobCFL;
+
+  /// number of linear iterations obtained with the current jacobian when fresh
+  CFuint m_jacobLinearIter;
+
+  /// number of linear iterations of the last step
+  CFuint m_lastLinearIter;
+
+  /// flag telling that the residual stalled in the last step
+  bool m_residualStalled;
+
 }; // class NewtonIterator
 
 //////////////////////////////////////////////////////////////////////////////
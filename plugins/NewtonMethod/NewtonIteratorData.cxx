@@ -4,6 +4,8 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include "Common/BadValueException.hh"
+
 #include "NewtonMethod/NewtonIteratorData.hh"
 #include "NewtonMethod/NewtonMethod.hh"
 
@@ -35,6 +37,11 @@ void NewtonIteratorData::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< bool >          ("SaveSystemToFile","Save files of matrix rhs solution vectors at each Newton step");
    options.addConfigOption< bool >          ("PrintHistory","Print convergence history for each Newton Iterator step");
    options.addConfigOption< vector<CFuint> >("MaxSteps","Maximum steps to perform in the newton loop.");
+   options.addConfigOption< bool >          ("ReuseJacobian","Reuse the jacobian and the preconditioner across Newton and time steps.");
+   options.addConfigOption< CFuint >        ("ReuseMaxSteps","Maximum number of steps during which the jacobian is reused.");
+   options.addConfigOption< CFreal >        ("ReuseMaxLinearIterRatio","Recompute the jacobian when the linear iterations grow past this factor times the ones obtained with a fresh jacobian.");
+   options.addConfigOption< CFreal >        ("ReuseMinResidualDrop","Recompute the jacobian when the residual decreases by less than this number of orders of magnitude in one step.");
+   options.addConfigOption< CFreal >        ("ReuseMaxCFLRatio","Recompute the jacobian when the CFL changes by more than this factor.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -57,6 +64,21 @@ NewtonIteratorData::NewtonIteratorData(Common::SafePtr<Framework::Method> owner)
 
   m_saveSystemToFile = false;
   setParameter("SaveSystemToFile",&m_saveSystemToFile);
+
+  m_reuseJacobian = false;
+  setParameter("ReuseJacobian",&m_reuseJacobian);
+
+  m_reuseMaxSteps = 20;
+  setParameter("ReuseMaxSteps",&m_reuseMaxSteps);
+
+  m_reuseMaxLinearIterRatio = 2.;
+  setParameter("ReuseMaxLinearIterRatio",&m_reuseMaxLinearIterRatio);
+
+  m_reuseMinResidualDrop = 0.;
+  setParameter("ReuseMinResidualDrop",&m_reuseMinResidualDrop);
+
+  m_reuseMaxCFLRatio = 2.;
+  setParameter("ReuseMaxCFLRatio",&m_reuseMaxCFLRatio);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -78,6 +100,15 @@ void NewtonIteratorData::configure ( Config::ConfigArgs& args )
     m_maxSteps[0] = 1;
   }
   cf_assert(m_maxSteps.size() > 0);
+
+  if (m_reuseJacobian) {
+    if (m_reuseMaxSteps == 0) {
+      throw BadValueException (FromHere(),"NewtonIteratorData::configure() => ReuseMaxSteps must be > 0");
+    }
+    if (m_reuseMaxLinearIterRatio < 1. || m_reuseMaxCFLRatio < 1.) {
+      throw BadValueException (FromHere(),"NewtonIteratorData::configure() => ReuseMaxLinearIterRatio and ReuseMaxCFLRatio must be >= 1");
+    }
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -80,6 +80,39 @@ public: // functions
     return m_saveSystemToFile;
   }
 
+  /// Checks if the jacobian and the preconditioner should be reused
+  /// across Newton and time steps
+  bool isReuseJacobian() const
+  {
+    return m_reuseJacobian;
+  }
+
+  /// Gets the maximum number of steps during which a jacobian is reused
+  CFuint getReuseMaxSteps() const
+  {
+    return m_reuseMaxSteps;
+  }
+
+  /// Gets the maximum ratio between the current number of linear iterations
+  /// and the one obtained with a fresh jacobian
+  CFreal getReuseMaxLinearIterRatio() const
+  {
+    return m_reuseMaxLinearIterRatio;
+  }
+
+  /// Gets the minimum decrease of the residual (in orders of magnitude) per step
+  CFreal getReuseMinResidualDrop() const
+  {
+    return m_reuseMinResidualDrop;
+  }
+
+  /// Gets the maximum ratio between the current CFL and the one used to
+  /// compute the jacobian
+  CFreal getReuseMaxCFLRatio() const
+  {
+    return m_reuseMaxCFLRatio;
+  }
+
   /// Gets the flag that indicates we are at the last iteration
   bool isAchieved() const
   {
@@ -127,6 +160,21 @@ private: // data
   /// flag to indicate saving files of system matrix, rhs and solution vectors at each iteration
   bool m_saveSystemToFile;
 
+  /// flag to reuse the jacobian and the preconditioner across steps
+  bool m_reuseJacobian;
+
+  /// maximum number of steps during which a jacobian is reused
+  CFuint m_reuseMaxSteps;
+
+  /// maximum growth of the number of linear iterations before recomputing the jacobian
+  CFreal m_reuseMaxLinearIterRatio;
+
+  /// minimum residual drop per step before recomputing the jacobian
+  CFreal m_reuseMinResidualDrop;
+
+  /// maximum CFL change before recomputing the jacobian
+  CFreal m_reuseMaxCFLRatio;
+
 }; // end of class NewtonIteratorData
 
 //////////////////////////////////////////////////////////////////////////////
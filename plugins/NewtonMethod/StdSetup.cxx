@@ -78,8 +78,11 @@ void StdSetup::execute()
   if(pastStates.size() != nbStates)
   {
     pastStates.resize(nbStates);
+    // past states contiguous in memory and in the same order as the states
+    EntityArena<State>& arena = MeshDataStack::getActive()->getStateArena("pastStates");
+    arena.reserve(nbStates, nbEqs);
     for (CFuint i = 0; i < nbStates; ++i) {
-      pastStates[i] = new State();
+      pastStates[i] = arena.create(i);
     }
   }
 
@@ -78,8 +78,11 @@ void TwoLayerSetup::execute()
   DataHandle<State*> interStates = socket_interStates.getDataHandle();
   
   interStates.resize(nbStates);
+  // intermediate states contiguous in memory and in the same order as the states
+  EntityArena<State>& arena = MeshDataStack::getActive()->getStateArena("interStates");
+  arena.reserve(nbStates, nbEqs);
   for (CFuint i = 0; i < nbStates; ++i) {
-    interStates[i] = new State();
+    interStates[i] = arena.create(i);
   }
   
   DataHandle<CFreal> interRhs = socket_interRhs.getDataHandle();
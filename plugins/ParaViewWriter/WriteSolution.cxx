@@ -7,6 +7,8 @@
 #include <fstream>
 
 #include <iomanip>
+#include <cstring>
+#include <stdint.h>
 
 #include "Common/CFMap.hh"
 #include "Environment/SingleBehaviorFactory.hh"
@@ -24,6 +26,7 @@
 #include "ParaViewWriter/WriteSolution.hh"
 
 #include "Common/OSystem.hh"
+#include "Common/PE.hh"
 //////////////////////////////////////////////////////////////////////////////
 
 using namespace std;
@@ -48,19 +51,30 @@ writeSolutionProvider("WriteSolution");
 
 void WriteSolution::defineConfigOptions(Config::OptionList& options)
 {
-   options.addConfigOption< std::string>("FileFormat","Format to write ParaView file.");
+   options.addConfigOption< std::string>("FileFormat","Format to write ParaView file (ASCII or BINARY, i.e. raw appended data).");
+   options.addConfigOption< bool >("WriteMasterFile","In parallel, write a .pvtu file referencing the pieces written by each process.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
 WriteSolution::WriteSolution(const std::string& name) : ParaWriterCom(name),
   socket_nodes("nodes"),
-  socket_nstatesProxy("nstatesProxy")
+  socket_nstatesProxy("nstatesProxy"),
+  m_binary(false),
+  m_appendedData(),
+  m_pointArrays(),
+  m_cellArrays(),
+  m_currArrays(CFNULL),
+  m_pointScalars(),
+  m_cellScalars()
 {
   addConfigOptionsTo(this);
 
   m_fileFormatStr = "ASCII";
   setParameter("FileFormat",&m_fileFormatStr);
+  
+  m_writeMasterFile = true;
+  setParameter("WriteMasterFile",&m_writeMasterFile);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -71,12 +85,14 @@ void WriteSolution::execute()
   
   if(m_fileFormatStr == "ASCII")
   {
+    m_binary = false;
     writeToFile(getMethodData().getFilename());
   }
   else
   {
     cf_assert(m_fileFormatStr == "BINARY");
-
+    
+    m_binary = true;
     writeToBinaryFile();
   }
 
@@ -93,9 +109,59 @@ const std::string WriteSolution::getWriterName() const
 
 void WriteSolution::writeToBinaryFile()
 {
- CFAUTOTRACE;
+  CFAUTOTRACE;
+  
+  Common::SelfRegistPtr<Environment::FileHandlerOutput>* fhandle = 
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().createPtr();
+  ofstream& file = (*fhandle)->open(getMethodData().getFilename(), ios_base::out | ios_base::binary);
+  
+  writeToFileStream(file);
+  
+  (*fhandle)->close();
+  delete fhandle;
+}
+
+//////////////////////////////////////////////////////////////////////////////
 
-  throw Common::NotImplementedException (FromHere(),"Writing to binary files is not yet implemented in ParaViewWriter...");
+template <typename OUT_TYPE, typename IN_TYPE>
+void WriteSolution::writeDataArray(std::ofstream& fout, const std::string& declaration, 
+				   const vector<IN_TYPE>& values, CFuint nbComponents, 
+				   CFuint nbSetComponents)
+{
+  if (m_currArrays != CFNULL) {
+    m_currArrays->push_back(declaration);
+  }
+  
+  if (!m_binary) {
+    fout << "        <DataArray " << declaration << " format=\"ascii\">\n";
+    fout << "          ";
+    for (CFuint i = 0; i < values.size(); ++i) {
+      if (i%nbComponents < nbSetComponents) {
+	writeAsciiValue(fout, values[i]);
+      }
+      else {
+	// unused components (e.g. z in 2D) are padded with zeros
+	fout << scientific << setprecision(1) << 0.0 << " ";
+      }
+    }
+    fout << "\n";
+    fout << "        </DataArray>\n";
+  }
+  else {
+    // the data are stored after the XML part, each block being 
+    // preceded by its size in bytes
+    fout << "        <DataArray " << declaration << " format=\"appended\" offset=\"" 
+	 << m_appendedData.size() << "\"/>\n";
+    
+    const uint64_t nbBytes = values.size()*sizeof(OUT_TYPE);
+    const size_t start = m_appendedData.size();
+    m_appendedData.resize(start + sizeof(uint64_t) + nbBytes);
+    memcpy(&m_appendedData[start], &nbBytes, sizeof(uint64_t));
+    OUT_TYPE* data = reinterpret_cast<OUT_TYPE*>(&m_appendedData[start + sizeof(uint64_t)]);
+    for (CFuint i = 0; i < values.size(); ++i) {
+      data[i] = static_cast<OUT_TYPE>(values[i]);
+    }
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -106,6 +172,11 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
   
   CFLog(VERBOSE, "WriteSolution::writeToFileStream() => START\n");
   
+  m_pointArrays.clear();
+  m_cellArrays.clear();
+  m_appendedData.clear();
+  m_currArrays = CFNULL;
+  
   if (!getMethodData().onlySurface())
   {
 
@@ -183,9 +254,70 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
   // get variable names
   const vector<std::string>& varNames = updateVarSet->getVarNames();
   cf_assert(varNames.size() == nbEqs);
+  
+  // extra variable names
+  const bool printExtraValues = getMethodData().printExtraValues();
+  const CFuint nbrExtraVars = (printExtraValues) ? updateVarSet->getExtraVarNames().size() : 0;
+  
+  // the nodal states are dimensionalized only once 
+  // and stored node by node for all the variables
+  vector<CFreal> dimStates(nbrNodes*nbEqs);
+  vector<CFreal> dimExtraValues(nbrNodes*nbrExtraVars);
+  {
+    // some helper states
+    RealVector dimState(nbEqs);
+    RealVector extraValues; // size will be set in the VarSet
+    State tempState;
+    
+    for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
+    {
+      // get state in this node
+      const RealVector& nodalState = *nodalStates.getState(iNode);
+
+      // copy to temporary state variable
+      for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
+      {
+        tempState[iEq] = nodalState[iEq];
+      }
 
+      // set temporary state ID
+      const CFuint stateID = nodalStates.getStateLocalID(iNode);
+      tempState.setLocalID(stateID);
+
+      // set the node in the temporary state
+      tempState.setSpaceCoordinates(nodes[iNode]);
+
+      // dimensionalize the state
+      if (printExtraValues) 
+      {
+	updateVarSet->setDimensionalValuesPlusExtraValues(tempState, dimState, extraValues);
+	for (CFuint iVar = 0 ;  iVar < nbrExtraVars; ++iVar) 
+	{
+	  dimExtraValues[iNode*nbrExtraVars + iVar] = extraValues[iVar];
+	}
+      }
+      else 
+      {
+	updateVarSet->setDimensionalValues(tempState, dimState);
+      }
+      
+      for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
+      {
+        dimStates[iNode*nbEqs + iEq] = dimState[iEq];
+      }
+    }
+  }
+  
   // open VTKFile element
-  fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=";
+  if (!m_binary) 
+  {
+    fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=";
+  }
+  else
+  {
+    // 64 bit sizes for the appended data blocks need version 1.0
+    fout << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" header_type=\"UInt64\" byte_order=";
+  }
   if (isLittleEndian())
   {
     fout << "\"LittleEndian\">\n";
@@ -204,95 +336,36 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
   // open PointData element
 //   fout << "      <PointData>\n";
   fout << "   <PointData Scalars=\"" << varNames[0] << "\">\n";
-
-  // some helper states
-  RealVector dimState(nbEqs);
-  RealVector extraValues; // size will be set in the VarSet
-  State tempState;
-
+  m_pointScalars = varNames[0];
+  m_currArrays = &m_pointArrays;
+  
+  vector<CFreal> values;
+  
   // write the (velocity or momentum) vectors
   if ((nbVecComponents > 0) && (!getMethodData().writeVectorAsComponents()))
   {
     cf_assert(nbVecComponents >= 2);
-    // open DataArray element
-    fout << "        <DataArray Name=\"" << varNames[vectorComponentIdxs[1]] << "\" NumberOfComponents=\"3\" type=\"Float32\" format=\"ascii\">\n";
-    fout << "          ";
-
-    // loop over nodes
+    
+    values.assign(nbrNodes*3, 0.0);
     for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
     {
-      // get state in this node
-      const RealVector& nodalState = *nodalStates.getState(iNode);
-
-      // copy to temporary state variable
-      for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-      {
-        tempState[iEq] = nodalState[iEq];
-      }
-
-      // set temporary state ID
-      const CFuint stateID = nodalStates.getStateLocalID(iNode);
-      tempState.setLocalID(stateID);
-
-      // set the node in the temporary state
-      tempState.setSpaceCoordinates(nodes[iNode]);
-
-      // dimensionalize the state
-      updateVarSet->setDimensionalValues(tempState, dimState);
-
-      // write the current variable to the file
       for (CFuint iVecComp = 0; iVecComp < nbVecComponents; ++iVecComp)
       {
-        fout << scientific << setprecision(12) << dimState[vectorComponentIdxs[iVecComp]] << " ";
-      }
-      for (CFuint iVecComp = nbVecComponents; iVecComp < 3; ++iVecComp)
-      {
-        fout << scientific << setprecision(1) << 0.0 << " ";
+        values[iNode*3 + iVecComp] = dimStates[iNode*nbEqs + vectorComponentIdxs[iVecComp]];
       }
-
     }
-    fout << "\n";
-
-    // close DataArray element
-    fout << "        </DataArray>\n";
+    writeDataArray<float>(fout, "Name=\"" + varNames[vectorComponentIdxs[1]] + 
+			  "\" NumberOfComponents=\"3\" type=\"Float32\"", values, 3, nbVecComponents);
   } else if (nbVecComponents > 0) {
 
     for (CFuint iVecComp = 0; iVecComp < nbVecComponents; ++iVecComp)
     {
-
-      fout << "        <DataArray Name=\"" << varNames[vectorComponentIdxs[iVecComp]] << "\" type=\"Float32\" format=\"ascii\">\n";
-      fout << "          ";
-
-      // loop over nodes
+      values.resize(nbrNodes);
       for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
       {
-        // get state in this node
-        const RealVector& nodalState = *nodalStates.getState(iNode);
-
-        // copy to temporary state variable
-        for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-        {
-          tempState[iEq] = nodalState[iEq];
-        }
-
-        // set temporary state ID
-        const CFuint stateID = nodalStates.getStateLocalID(iNode);
-        tempState.setLocalID(stateID);
-
-        // set the node in the temporary state
-        tempState.setSpaceCoordinates(nodes[iNode]);
-
-        // dimensionalize the state
-        updateVarSet->setDimensionalValues(tempState, dimState);
-
-        // write the current variable to the file
-        fout << scientific << setprecision(12) << dimState[vectorComponentIdxs[iVecComp]] << " ";
-
+        values[iNode] = dimStates[iNode*nbEqs + vectorComponentIdxs[iVecComp]];
       }
-      fout << "\n";
-
-      // close DataArray element
-      fout << "        </DataArray>\n";
+      writeDataArray<float>(fout, "Name=\"" + varNames[vectorComponentIdxs[iVecComp]] + "\" type=\"Float32\"", values);
     }
   }
 
@@ -301,88 +374,29 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
   {
     // index of this scalar'
     const CFuint iVar = scalarVarIdxs[iScalar];
-
-    // open DataArray element
-    fout << "        <DataArray Name=\"" << varNames[iVar] << "\" type=\"Float32\" format=\"ascii\">\n";
-    fout << "          ";
-
-    // loop over nodes
+    
+    values.resize(nbrNodes);
     for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
     {
-      // get state in this node
-      const RealVector& nodalState = *nodalStates.getState(iNode);
-
-      // copy to temporary state variable
-      for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-      {
-        tempState[iEq] = nodalState[iEq];
-      }
-
-      // set temporary state ID
-      const CFuint stateID = nodalStates.getStateLocalID(iNode);
-      tempState.setLocalID(stateID);
-
-      // set the node in the temporary state
-      tempState.setSpaceCoordinates(nodes[iNode]);
-
-      // dimensionalize the state
-      updateVarSet->setDimensionalValues(tempState, dimState);
-
-      // write the current variable to the file
-      fout << scientific << setprecision(12) << dimState[iVar] << " ";
+      values[iNode] = dimStates[iNode*nbEqs + iVar];
     }
-    fout << "\n";
-
-    // close DataArray element
-    fout << "        </DataArray>\n";
+    writeDataArray<float>(fout, "Name=\"" + varNames[iVar] + "\" type=\"Float32\"", values);
   }
 
   // if extra variables are to be outputted
-  if (getMethodData().printExtraValues())
+  if (printExtraValues)
   {
-    // variable for extra values
-    RealVector extraValues; // size will be set in the VarSet
-
-    // extra variable names
     const vector<std::string>& extraVarNames = updateVarSet->getExtraVarNames();
-    const CFuint nbrExtraVars = extraVarNames.size();
-
+    
     // loop over the extra variables
     for (CFuint iVar = 0 ;  iVar < nbrExtraVars; ++iVar)
     {
-      // open DataArray element
-      fout << "        <DataArray Name=\"" << extraVarNames[iVar] << "\" type=\"Float32\" format=\"ascii\">\n";
-      fout << "          ";
-
-      // loop over nodes
+      values.resize(nbrNodes);
       for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
       {
-        // get state in this node
-        const RealVector& nodalState = *nodalStates.getState(iNode);
-
-        // copy to temporary state variable
-        for (CFuint iEq = 0; iEq < nbEqs; ++iEq)
-        {
-          tempState[iEq] = nodalState[iEq];
-        }
-
-        // set temporary state ID
-        const CFuint stateID = nodalStates.getStateLocalID(iNode);
-        tempState.setLocalID(stateID);
-
-        // set the node in the temporary state
-        tempState.setSpaceCoordinates(nodes[iNode]);
-
-        // dimensionalize the state
-        updateVarSet->setDimensionalValuesPlusExtraValues(tempState, dimState, extraValues);
-
-        // write the current variable to the file
-        fout << scientific << setprecision(12) << extraValues[iVar] << " ";
+        values[iNode] = dimExtraValues[iNode*nbrExtraVars + iVar];
       }
-      fout << "\n";
-
-      // close DataArray element
-      fout << "        </DataArray>\n";
+      writeDataArray<float>(fout, "Name=\"" + extraVarNames[iVar] + "\" type=\"Float32\"", values);
     }
   }
 
@@ -396,22 +410,16 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
 
     for (CFuint iVar = 0; iVar < dh_varnames.size(); ++iVar)
     {
-      // open DataArray element
-      fout << "        <DataArray Name=\"" << dh_varnames[iVar] << "\" type=\"Float32\" format=\"ascii\">\n";
-      fout << "          ";
-
       DataHandleOutput::DataHandleInfo var_info = datahandle_output->getStateData(iVar);
       CFuint var_var = var_info.first;
       CFuint var_nbvars = var_info.second;
       DataHandle<CFreal> var = var_info.third;
-
+      
+      values.resize(nbrNodes);
       for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
-        fout << scientific << setprecision(12) << var(nodalStates.getStateLocalID(iNode), var_var, var_nbvars) << " ";
-
-      fout << "\n";
-
-      // close DataArray element
-      fout << "        </DataArray>\n";
+        values[iNode] = var(nodalStates.getStateLocalID(iNode), var_var, var_nbvars);
+      
+      writeDataArray<float>(fout, "Name=\"" + dh_varnames[iVar] + "\" type=\"Float32\"", values);
     }
   }
 
@@ -425,72 +433,58 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
     std::vector< std::string > dh_varnames = datahandle_output->getCCVarNames();
     // loop over the state based variables
     
+    m_cellScalars = "";
     if (dh_varnames.size() > 0) {
       // cell-based data
       // open CellData element
       fout << "   <CellData Scalars=\"" << dh_varnames[0] << "\">\n";
+      m_cellScalars = dh_varnames[0];
+      m_currArrays = &m_cellArrays;
       
       for (CFuint iVar = 0; iVar < dh_varnames.size(); ++iVar)
 	{
-	  // open DataArray element
-	  fout << "        <DataArray Name=\"" << dh_varnames[iVar] << "\" type=\"Float32\" format=\"ascii\">\n";
-	  fout << "          ";
-	  
 	  DataHandleOutput::DataHandleInfo var_info = datahandle_output->getCCData(iVar);
 	  CFuint var_var = var_info.first;
 	  CFuint var_nbvars = var_info.second;
 	  DataHandle<CFreal> var = var_info.third;
 	  
+	  values.resize(nbrCells);
 	  for (CFuint iState = 0; iState < nbrCells; ++iState) {
-	    fout << scientific << setprecision(12) <<
-	      var(iState, var_var, var_nbvars) << " ";
+	    values[iState] = var(iState, var_var, var_nbvars);
 	  }
 	  
-	  fout << "\n";
-	  
-	  // close DataArray element
-	  fout << "        </DataArray>\n";
+	  writeDataArray<float>(fout, "Name=\"" + dh_varnames[iVar] + "\" type=\"Float32\"", values);
 	}
       
       // close CellData element
       fout << "      </CellData>\n";
     }
   }
+  m_currArrays = CFNULL;
   
   // open Points element
   fout << "      <Points>\n";
 
-  // open DataArray element
-  fout << "        <DataArray NumberOfComponents=\"" << 3 << "\" type=\"Float32\" format=\"ascii\">\n";
-  fout << "          ";
-
   // loop over nodes to write coordinates
+  values.assign(nbrNodes*3, 0.0);
   for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
   {
     for (CFuint iCoor = 0; iCoor < dim; ++iCoor)
     {
-      fout << scientific << setprecision(12) << (*nodes[iNode])[iCoor]*refL << " ";
-    }
-    for (CFuint iCoor = dim; iCoor < 3; ++iCoor)
-    {
-      fout << scientific << setprecision(1) << 0.0 << " ";
+      values[iNode*3 + iCoor] = (*nodes[iNode])[iCoor]*refL;
     }
   }
-  fout << "\n";
-
-  // close DataArray element
-  fout << "        </DataArray>\n";
-
+  writeDataArray<float>(fout, "NumberOfComponents=\"3\" type=\"Float32\"", values, 3, dim);
+  
   // close Points element
   fout << "      </Points>\n";
 
   // open Cells element
   fout << "      <Cells>\n";
-
-  // open DataArray element (for cell-node connectivity)
-  fout << "        <DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n";
-  fout << "          ";
-
+  
+  vector<CFuint> cellValues;
+  cellValues.reserve(cellNodes->size());
+  
   // loop over element types to write cell-node connectivity
   for (CFuint iCell = 0; iCell < nbrCells; ++iCell)
   {
@@ -498,34 +492,21 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
     // node ordering for one cell is the same for VTK as in COOLFluiD
     for (CFuint iNode = 0; iNode < nbrNodes; ++iNode)
     {
-      fout << (*cellNodes)(iCell,iNode) << " ";
+      cellValues.push_back((*cellNodes)(iCell,iNode));
     }
   }
-  fout << "\n";
-
-  // close DataArray element (for cell-node connectivity)
-  fout << "        </DataArray>\n";
-
-  // open DataArray element (for offsets in cell-node connectivity)
-  fout << "        <DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n";
-  fout << "          ";
-
+  writeDataArray<int32_t>(fout, "type=\"Int32\" Name=\"connectivity\"", cellValues);
+  
   // loop over element types to write offsets in cell-node connectivity (offset of the end of the connectivity for each cell)
+  cellValues.resize(nbrCells);
   CFuint cellEndOffSet = 0;
   for (CFuint iCell = 0; iCell < nbrCells; ++iCell)
   {
     cellEndOffSet += cellNodes->nbCols(iCell);
-    fout << cellEndOffSet << " ";
+    cellValues[iCell] = cellEndOffSet;
   }
-  fout << "\n";
-
-  // close DataArray element (for offsets in cell-node connectivity)
-  fout << "        </DataArray>\n";
-
-  // open DataArray element (for cell types)
-  fout << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">\n";
-  fout << "          ";
-
+  writeDataArray<int32_t>(fout, "type=\"Int32\" Name=\"offsets\"", cellValues);
+  
   // loop over element types to write cell types
   /// @warning (element indexes (elemIdx) should increase monotonically here in order for this to be correct!!!)
   const CFuint nbrElemTypes = elemType->size();
@@ -541,14 +522,11 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
     // loop over cells
     for (CFuint elemIdx = startIdx; elemIdx < endIdx; ++elemIdx)
     {
-      fout << vtkCellType << " ";
+      cellValues[elemIdx] = vtkCellType;
     }
   }
-  fout << "\n";
-
-  // close DataArray element (for cell types)
-  fout << "        </DataArray>\n";
-
+  writeDataArray<uint8_t>(fout, "type=\"UInt8\" Name=\"types\"", cellValues);
+  
   // close Cells element
   fout << "      </Cells>\n";
 
@@ -557,13 +535,28 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
 
   // close UnstructuredGrid element
   fout << "  </UnstructuredGrid>\n";
-
+  
+  if (m_binary) 
+  {
+    // the appended data start right after the underscore
+    fout << "  <AppendedData encoding=\"raw\">\n   _";
+    fout.write(&m_appendedData[0], m_appendedData.size());
+    fout << "\n  </AppendedData>\n";
+    vector<char>().swap(m_appendedData);
+  }
+  
   // close VTKFile element
   fout << "</VTKFile>\n";
 
   // close the file
   fout.close();
-
+  
+  // in parallel each process writes its own piece, indexed by a master file
+  if (PE::GetPE().IsParallel() && m_writeMasterFile) 
+  {
+    writeMasterFile();
+  }
+  
   } // if only surface
 
   // write boundary surface data
@@ -574,6 +567,79 @@ void WriteSolution::writeToFileStream(std::ofstream& fout)
 
 //////////////////////////////////////////////////////////////////////////////
 
+void WriteSolution::writeMasterFile()
+{
+  CFAUTOTRACE;
+  
+#ifdef CF_HAVE_MPI
+  const std::string nsp = getMethodData().getNamespace();
+  MPI_Comm comm = PE::GetPE().GetCommunicator(nsp);
+  const int rank = PE::GetPE().GetRank(nsp);
+  const int nbProcs = PE::GetPE().GetProcessorCount(nsp);
+  
+  // the pieces are in the same directory as the master file
+  const string pieceName = getMethodData().getFilename().filename().string();
+  int nameSize = pieceName.size();
+  vector<int> nameSizes(nbProcs, 0);
+  MPI_Gather(&nameSize, 1, MPI_INT, &nameSizes[0], 1, MPI_INT, 0, comm);
+  
+  vector<int> displs(nbProcs, 0);
+  for (int i = 1; i < nbProcs; ++i) {
+    displs[i] = displs[i-1] + nameSizes[i-1];
+  }
+  vector<char> names(displs[nbProcs-1] + nameSizes[nbProcs-1] + 1);
+  MPI_Gatherv(const_cast<char*>(pieceName.c_str()), nameSize, MPI_CHAR, 
+	      &names[0], &nameSizes[0], &displs[0], MPI_CHAR, 0, comm);
+  
+  if (rank == 0) {
+    // the master file name is the one of the piece without the rank suffix
+    std::ostringstream suffix; 
+    suffix << "-P" << PE::GetPE().GetRank("Default");
+    string masterName = getMethodData().getFilename().string();
+    const size_t pos = masterName.rfind(suffix.str());
+    if (pos != string::npos) {
+      masterName.erase(pos, suffix.str().size());
+    }
+    masterName = boost::filesystem::change_extension(path(masterName), ".pvtu").string();
+    
+    CFLog(INFO, "Writing ParaView master file to: " << masterName << "\n");
+    
+    Common::SelfRegistPtr<Environment::FileHandlerOutput>* fhandle = 
+      Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().createPtr();
+    ofstream& fout = (*fhandle)->open(path(masterName));
+    
+    fout << "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\" byte_order=\"" 
+	 << (isLittleEndian() ? "LittleEndian" : "BigEndian") << "\">\n";
+    fout << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+    fout << "    <PPointData Scalars=\"" << m_pointScalars << "\">\n";
+    for (CFuint i = 0; i < m_pointArrays.size(); ++i) {
+      fout << "      <PDataArray " << m_pointArrays[i] << "/>\n";
+    }
+    fout << "    </PPointData>\n";
+    if (m_cellArrays.size() > 0) {
+      fout << "    <PCellData Scalars=\"" << m_cellScalars << "\">\n";
+      for (CFuint i = 0; i < m_cellArrays.size(); ++i) {
+	fout << "      <PDataArray " << m_cellArrays[i] << "/>\n";
+      }
+      fout << "    </PCellData>\n";
+    }
+    fout << "    <PPoints>\n";
+    fout << "      <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n";
+    fout << "    </PPoints>\n";
+    for (int i = 0; i < nbProcs; ++i) {
+      fout << "    <Piece Source=\"" << string(&names[displs[i]], nameSizes[i]) << "\"/>\n";
+    }
+    fout << "  </PUnstructuredGrid>\n";
+    fout << "</VTKFile>\n";
+    
+    (*fhandle)->close();
+    delete fhandle;
+  }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void WriteSolution::writeBoundarySurface()
 {
   CFAUTOTRACE;
@@ -97,6 +97,37 @@ protected:
    * Write the boundary surface data
    */
   void writeBoundarySurface();
+  
+  /**
+   * Write the .pvtu file referencing the pieces written by all the processes
+   */
+  void writeMasterFile();
+  
+  /**
+   * Write a DataArray element, with inline ASCII values or referencing
+   * the appended binary data
+   * @param declaration     attributes of the DataArray other than format
+   * @param values          values to write
+   * @param nbComponents    number of components of each tuple
+   * @param nbSetComponents number of components of each tuple actually set,
+   *                        the other ones being zero padding
+   */
+  template <typename OUT_TYPE, typename IN_TYPE>
+  void writeDataArray(std::ofstream& fout, const std::string& declaration, 
+		      const std::vector<IN_TYPE>& values, CFuint nbComponents = 1, 
+		      CFuint nbSetComponents = 1);
+  
+  /// Write a floating point value in ASCII format
+  void writeAsciiValue(std::ofstream& fout, CFreal value)
+  {
+    fout << std::scientific << std::setprecision(12) << value << " ";
+  }
+  
+  /// Write an integer value in ASCII format
+  void writeAsciiValue(std::ofstream& fout, CFuint value)
+  {
+    fout << value << " ";
+  }
 
   /**
    * Get the name of the writer
@@ -127,6 +158,30 @@ private:
 
   /// File format to write in (ASCII or Binary)
   std::string m_fileFormatStr;
+  
+  /// flag telling if to write a .pvtu master file in parallel
+  bool m_writeMasterFile;
+  
+  /// flag telling if the current file is written in binary format
+  bool m_binary;
+  
+  /// binary data appended after the XML part of the file
+  std::vector<char> m_appendedData;
+  
+  /// declarations of the point data arrays (for the master file)
+  std::vector<std::string> m_pointArrays;
+  
+  /// declarations of the cell data arrays (for the master file)
+  std::vector<std::string> m_cellArrays;
+  
+  /// list where the declarations of the written arrays are stored
+  std::vector<std::string>* m_currArrays;
+  
+  /// name of the active point scalar
+  std::string m_pointScalars;
+  
+  /// name of the active cell scalar
+  std::string m_cellScalars;
 
 }; // class WriteSolution
 
@@ -33,7 +33,8 @@ class BlockJacobiPcJFContext {
 public: // functions
 
   /// Constructor
-  BlockJacobiPcJFContext() : diagMatrices(CFNULL), upLocalIDsAll(CFNULL) {}
+  BlockJacobiPcJFContext() :
+    diagMatrices(CFNULL), upLocalIDsAll(CFNULL), singlePrecision(false), diagMatricesSP() {}
   
   /// handle of diagonal inverted matrices
   Common::SafePtr<Framework::DataSocketSink<CFreal> > diagMatrices;
@@ -43,6 +44,12 @@ public: // functions
   
   /// pointer to JFContext - we will use bkpStates from this object during the LU-SGS preconditioning
   JFContext* pJFC;
+
+  /// flag telling if the inverted diagonal matrices are applied in single precision
+  bool singlePrecision;
+  
+  /// inverted diagonal matrices stored in single precision (if singlePrecision)
+  std::vector<float> diagMatricesSP;
   
 }; // end of class BlockJacobiPcJFContext
 
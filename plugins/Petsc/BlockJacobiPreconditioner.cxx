@@ -44,8 +44,20 @@ BlockJacobiPreconditioner::BlockJacobiPreconditioner(const std::string& name) :
   socket_diagMatrices("diagMatrices"),
   socket_upLocalIDsAll("upLocalIDsAll"),
   _pcc(),
-  _inverter(CFNULL)
+  _inverter(CFNULL),
+  _singlePrecision()
 {
+  addConfigOptionsTo(this);
+
+  _singlePrecision = false;
+  setParameter("SinglePrecision", &_singlePrecision);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void BlockJacobiPreconditioner::defineConfigOptions(Config::OptionList& options)
+{
+  options.addConfigOption< bool >("SinglePrecision","Apply the inverted diagonal blocks in single precision (the Krylov vectors stay in double precision)");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -62,6 +74,7 @@ void BlockJacobiPreconditioner::setPreconditioner()
   _pcc.pJFC = getMethodData().getJFContext();
   _pcc.diagMatrices = &socket_diagMatrices;
   _pcc.upLocalIDsAll = &socket_upLocalIDsAll;
+  _pcc.singlePrecision = _singlePrecision;
 
   _inverter.reset(MatrixInverter::create(getMethodData().getNbSysEquations(), false));
 
@@ -94,6 +107,13 @@ void BlockJacobiPreconditioner::computeBeforeSolving()
       matIter[m] = invMat[m];
     }
   }
+  // the inverted matrices are rounded once here and applied in single precision
+  if (_pcc.singlePrecision) {
+    _pcc.diagMatricesSP.resize(diagMatrices.size());
+    for (CFuint i = 0; i < diagMatrices.size(); ++i) {
+      _pcc.diagMatricesSP[i] = static_cast<float>(diagMatrices[i]);
+    }
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -139,18 +159,35 @@ PetscErrorCode BlockJacobiPcApply(PC pc, Vec X, Vec Y)
   DataHandle<State*, GLOBAL> states = pcContext->pJFC->states->getDataHandle();
   const CFint nbUpdatableStates = diagMatInv.size()/nbEqs2;
 
-  RealVector tmpX(nbEqs, &x[0]);
-  RealVector tmpY(nbEqs, &y[0]);
-  RealMatrix invMatIter(nbEqs, nbEqs, &diagMatInv[0]);
-
-  for(CFint i = 0; i < nbUpdatableStates; ++i)
-  {
-    const CFuint startIdx = i*nbEqs;
-    tmpX.wrap(nbEqs,&x[startIdx]);
-    tmpY.wrap(nbEqs,&y[startIdx]);
-    invMatIter.wrap(nbEqs, nbEqs, &diagMatInv[i*nbEqs2]);
+  if (pcContext->singlePrecision) {
+    // single precision matrices, double precision accumulation
+    const vector<float>& diagMatInvSP = pcContext->diagMatricesSP;
+    for(CFint i = 0; i < nbUpdatableStates; ++i) {
+      const CFuint startIdx = i*nbEqs;
+      const float *const invMat = &diagMatInvSP[i*nbEqs2];
+      for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+        CFreal sum = 0.;
+        for (CFuint jEq = 0; jEq < nbEqs; ++jEq) {
+          sum += invMat[iEq*nbEqs + jEq]*x[startIdx + jEq];
+        }
+        y[startIdx + iEq] = sum;
+      }
+    }
+  }
+  else {
+    RealVector tmpX(nbEqs, &x[0]);
+    RealVector tmpY(nbEqs, &y[0]);
+    RealMatrix invMatIter(nbEqs, nbEqs, &diagMatInv[0]);
     
-    tmpY = invMatIter*tmpX;
+    for(CFint i = 0; i < nbUpdatableStates; ++i)
+    {
+      const CFuint startIdx = i*nbEqs;
+      tmpX.wrap(nbEqs,&x[startIdx]);
+      tmpY.wrap(nbEqs,&y[startIdx]);
+      invMatIter.wrap(nbEqs, nbEqs, &diagMatInv[i*nbEqs2]);
+      
+      tmpY = invMatIter*tmpX;
+    }
   }
 
   // restoring of arrays X - vector to be preconditioned and Y - preconditioned vector
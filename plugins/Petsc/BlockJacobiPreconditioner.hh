@@ -87,6 +87,9 @@ private:
   /// temporary data for holding the matrix inverter
   std::auto_ptr<MathTools::MatrixInverter> _inverter;
   
+  /// flag telling to apply the inverted blocks in single precision
+  bool _singlePrecision;
+  
 }; // end of class BlockJacobiPreconditioner
     
 //////////////////////////////////////////////////////////////////////////////
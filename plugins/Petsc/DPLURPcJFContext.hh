@@ -33,7 +33,8 @@ class DPLURPcJFContext {
 public: // functions
   
   /// Constructor
-  DPLURPcJFContext() : diagMatrices(CFNULL), upLocalIDsAll(CFNULL) {}
+  DPLURPcJFContext() :
+    diagMatrices(CFNULL), upLocalIDsAll(CFNULL), singlePrecision(false), diagMatricesSP() {}
   
   /// handle of diagonal inverted matrices
   Common::SafePtr<Framework::DataSocketSink <CFreal> > diagMatrices;
@@ -52,6 +53,12 @@ public: // functions
 	
   /// state neighbors connectivity
   Common::ConnectivityTable<CFuint> stateNeighbors;
+
+  /// flag telling if the inverted diagonal matrices are applied in single precision
+  bool singlePrecision;
+  
+  /// inverted diagonal matrices stored in single precision (if singlePrecision)
+  std::vector<float> diagMatricesSP;
     
 }; // end of class DPLURPcJFContext
 
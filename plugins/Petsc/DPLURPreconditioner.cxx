@@ -43,6 +43,7 @@ void DPLURPreconditioner::defineConfigOptions(Config::OptionList& options)
 {
   options.addConfigOption< CFreal >("omega","Relaxation constant (0 < omega < 1 - underrelaxation; 1 < omega < 2 - overrelaxation)");
   options.addConfigOption< CFuint >("nbSweeps", "Number of sweeps in the DP-LUR method");
+  options.addConfigOption< bool >("SinglePrecision","Apply the inverted diagonal blocks in single precision (the Krylov vectors stay in double precision)");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -54,7 +55,8 @@ DPLURPreconditioner::DPLURPreconditioner(const std::string& name) :
   _pcc(),
   _inverter(CFNULL),
   _omega(),
-  _nbSweeps()
+  _nbSweeps(),
+  _singlePrecision()
 {
   addConfigOptionsTo(this);
 
@@ -63,6 +65,9 @@ DPLURPreconditioner::DPLURPreconditioner(const std::string& name) :
 
   _nbSweeps = 6;
   setParameter("nbSweeps", &_nbSweeps);
+
+  _singlePrecision = false;
+  setParameter("SinglePrecision", &_singlePrecision);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -81,6 +86,7 @@ void DPLURPreconditioner::setPreconditioner()
 	_pcc.upLocalIDsAll = &socket_upLocalIDsAll;
 	_pcc.omega = _omega;
 	_pcc.nbSweeps = _nbSweeps;
+	_pcc.singlePrecision = _singlePrecision;
 	
 	SelfRegistPtr<GlobalJacobianSparsity> sparsity =
 	getMethodData().getCollaborator<SpaceMethod>()->createJacobianSparsity();
@@ -122,6 +128,13 @@ void DPLURPreconditioner::computeBeforeSolving()
       matIter[m] = invMat[m];
     }
   }
+  // the inverted matrices are rounded once here and applied in single precision
+  if (_pcc.singlePrecision) {
+    _pcc.diagMatricesSP.resize(diagMatrices.size());
+    for (CFuint i = 0; i < diagMatrices.size(); ++i) {
+      _pcc.diagMatricesSP[i] = static_cast<float>(diagMatrices[i]);
+    }
+  }
 }
     
 //////////////////////////////////////////////////////////////////////////////
@@ -254,9 +267,22 @@ PetscErrorCode DPLURPcApply(PC pc, Vec X, Vec Y)
 					sumDeltaR[iEq] += x[startX + iEq];
 				}
 				
-				invMatIter.wrap(nbEqs, nbEqs, &diagMatInv[i*nbEqs2]);
-				tmpY.wrap(nbEqs, &y[startX]);
-				tmpY = (1.0 - relax)*tmpY + relax*(invMatIter*sumDeltaR);
+				if (pcContext->singlePrecision) {
+					// single precision matrix, double precision accumulation
+					const float *const invMat = &pcContext->diagMatricesSP[i*nbEqs2];
+					for(CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+						CFreal sum = 0.;
+						for(CFuint jEq = 0; jEq < nbEqs; ++jEq) {
+							sum += invMat[iEq*nbEqs + jEq]*sumDeltaR[jEq];
+						}
+						y[startX + iEq] = (1.0 - relax)*y[startX + iEq] + relax*sum;
+					}
+				}
+				else {
+					invMatIter.wrap(nbEqs, nbEqs, &diagMatInv[i*nbEqs2]);
+					tmpY.wrap(nbEqs, &y[startX]);
+					tmpY = (1.0 - relax)*tmpY + relax*(invMatIter*sumDeltaR);
+				}
 			}
 		}
 	// some testing stuff
@@ -93,6 +93,9 @@ private:
   /// Number of sweeps in the DP-LUR method
   CFuint _nbSweeps;
   
+  /// flag telling to apply the inverted blocks in single precision
+  bool _singlePrecision;
+  
 }; // end of class DPLURPreconditioner
     
 //////////////////////////////////////////////////////////////////////////////
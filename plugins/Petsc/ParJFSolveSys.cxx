@@ -117,6 +117,12 @@ void ParJFSolveSys::execute()
       //cout << "\n\n\n Setting up J-F different preconditioner matrix ParBAIJ with Petsc preconditioner \n\n\n";
       precondMat.finalAssembly();
       
+#if PETSC_VERSION_MINOR==7 || PETSC_VERSION_MINOR==9 || PETSC_VERSION_MINOR==11 || PETSC_VERSION_MINOR==12
+      // the jacobian-free operator stays exact, only the preconditioner is kept
+      const PetscBool reusePC = (getMethodData().reusePreconditioner()) ? PETSC_TRUE : PETSC_FALSE;
+      CF_CHKERRCONTINUE(KSPSetReusePreconditioner(ksp,reusePC));
+#endif
+      
 #if PETSC_VERSION_MINOR==6 || PETSC_VERSION_MINOR==7 || PETSC_VERSION_MINOR==9 || PETSC_VERSION_MINOR==11 || PETSC_VERSION_MINOR==12
       CF_CHKERRCONTINUE(KSPSetOperators(ksp, mat.getMat(), precondMat.getMat()));
 #else
@@ -171,6 +177,7 @@ void ParJFSolveSys::execute()
   CF_CHKERRCONTINUE(KSPSolve(ksp, rhsVec.getVec(), solVec.getVec()));
   CFint iter = 0;
   CF_CHKERRCONTINUE(KSPGetIterationNumber(ksp, &iter));
+  getMethodData().setNbIterations(iter);
 
   CFLog(INFO, "KSP convergence reached at iteration: " << iter << "\n");
 
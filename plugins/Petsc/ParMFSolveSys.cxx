@@ -97,6 +97,12 @@ void ParMFSolveSys::execute()
   CFuint ierr = KSPSetOperators(ksp, jfMat.getMat(), precMat.getMat(), DIFFERENT_NONZERO_PATTERN);
 #endif
   
+#if PETSC_VERSION_MINOR==7 || PETSC_VERSION_MINOR==9 || PETSC_VERSION_MINOR==11 || PETSC_VERSION_MINOR==12
+  // the matrix-free operator stays exact, only the preconditioner is kept
+  const PetscBool reusePC = (getMethodData().reusePreconditioner()) ? PETSC_TRUE : PETSC_FALSE;
+  CHKERRCONTINUE(KSPSetReusePreconditioner(ksp,reusePC));
+#endif
+  
   ierr = KSPSetUp(ksp);
   CHKERRCONTINUE(ierr);
   precMat.getMat();
@@ -107,6 +113,7 @@ void ParMFSolveSys::execute()
   CFint iter = 0;
   ierr = KSPGetIterationNumber(ksp, &iter);
   CHKERRCONTINUE(ierr);
+  getMethodData().setNbIterations(iter);
 
   CFLog(INFO, "KSP convergence reached at iteration: " << iter << "\n");
 
@@ -115,8 +115,10 @@ stopTimer.start();
  
   // reuse te preconditioner
 #if PETSC_VERSION_MINOR==7 || PETSC_VERSION_MINOR==9 || PETSC_VERSION_MINOR==11 || PETSC_VERSION_MINOR==12
-  PetscBool reusePC = ((nbIter-1)%getMethodData().getPreconditionerRate() == 0) ?
-     PETSC_FALSE : PETSC_TRUE;
+  // the convergence method can also ask to keep the preconditioner
+  // as long as the system matrix is frozen
+  PetscBool reusePC = (((nbIter-1)%getMethodData().getPreconditionerRate() == 0) &&
+		       !getMethodData().reusePreconditioner()) ? PETSC_FALSE : PETSC_TRUE;
   CFLog(VERBOSE, "StdParSolveSys::execute() => reusePC [" << reusePC <<"]\n");
   CHKERRCONTINUE(KSPSetReusePreconditioner(ksp,reusePC));
   PC& pc = getMethodData().getPreconditioner();
@@ -163,6 +165,7 @@ stopTimer.start();
   CFint iter = 0;
   ierr = KSPGetIterationNumber(ksp, &iter);
   CHKERRCONTINUE(ierr);
+  getMethodData().setNbIterations(iter);
   
   // Ask to stop the simulation if convergence is achieved at iteration 0 (i.e. LSS was not solved)
   if (iter == 0) {
@@ -36,6 +36,12 @@ struct PhotonData {
   CFreal KS;
   CFreal energyFraction;
   CFreal wavelength;
+  
+  /**
+   * @brief state of the random number stream of this photon (emitter ID on 
+   * two words, index of the photon within its emitter, counter)
+   */
+  unsigned int randomStream[4]={0,0,0,0};
 };
       
 //////////////////////////////////////////////////////////////////////////////
@@ -23,6 +23,7 @@
 #include <time.h>
 #include <cmath>
 #include <algorithm>
+#include <cstring>
 #include <boost/progress.hpp>
 #include <boost/random.hpp>
 
@@ -289,6 +290,24 @@ private:
   CFuint  m_iphoton_face_fix, m_igState_face_fix;
 
   CFreal m_relaxationFactor;
+  
+  /// seed of the counter-based random number streams (if < 0, time-based seeding)
+  CFint m_randomSeed;
+  
+  /// counter-based random number stream of the current photon
+  RandomStream m_randomStream;
+  
+  /// number of emission loops already done (to change the streams at each loop)
+  CFuint m_nbEmissionLoops;
+  
+  /// attach the stream of the given photon, if reproducible streams are used
+  void attachRandomStream(PhotonData& photonData)
+  {
+    if (m_randomSeed >= 0) {m_randomStream.attach(&photonData.randomStream[0]);}
+  }
+  
+  /// initialize the random number stream of a photon
+  void initRandomStream(PhotonData& photonData, unsigned long long emitterID, bool isWall, CFuint photonIdx);
 
 
   bool getFacePhotonData(Photon &ray);
@@ -310,6 +329,7 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::defineConfigOptions
   options.addConfigOption< CFuint >("sendBufferSize","Size of the buffer for communication");
   options.addConfigOption< CFuint >("nbRaysCycle","Number of rays to emit before communication step");
   options.addConfigOption< CFreal >("relaxationFactor","Relaxation Factor");
+  options.addConfigOption< CFint >("RandomSeed","Seed of the counter-based random numbers, making the results independent from the partitioning (time-based seed if < 0)");
   options.addConfigOption< bool >("plotTrajectories","Photon trajectories will be exported to a tecplot geometry plot");
   options.addConfigOption< CFuint >("MaxNbTrajectories","Maximum number of trajectories to be plotted");
 //  options.addConfigOption< trajectoryExportType >("exportType", "Determines selection criterion for trajectory ids (\"Random\" or \"ConstantSpacing\"");
@@ -377,6 +397,11 @@ RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::RadiativeTransferMonteCarlo
 
   m_relaxationFactor = 1.;
   setParameter("relaxationFactor", &m_relaxationFactor);
+  
+  m_randomSeed = -1;
+  setParameter("RandomSeed", &m_randomSeed);
+  
+  m_nbEmissionLoops = 0;
 
 
 }
@@ -568,10 +593,11 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::setup()
   //MPI_Datatype Userdatatype, particleDatatype;
   MPIStruct Userdatatype;//, particleDatatype;
 
+  // consecutive members of the same type are sent as a single block
   PhotonData photonData;
-  int counts[6] = {1,1,1,1,1,1};
-  MPIStructDef::buildMPIStruct<CFint,CFint,CFint,CFreal,CFreal,CFreal>
-          (&photonData.globalTrajectoryId, &photonData.indexWithinTrajectory,&photonData.fatherProcessId,&photonData.KS, &photonData.energyFraction, &photonData.wavelength, counts , Userdatatype);
+  int counts[3] = {3,3,4};
+  MPIStructDef::buildMPIStruct<CFint,CFreal,unsigned int>
+          (&photonData.globalTrajectoryId, &photonData.KS, &photonData.randomStream[0], counts , Userdatatype);
 
   m_lagrangianSolver.setupParticleDatatype( Userdatatype.type );
  // particleDatatype.type = m_lagrangianSolver.getParticleDataType();
@@ -736,6 +762,11 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData(Photon &r
       // Calculate the wavelength
       //cout<<"wavelength= "<<ray.userData.wavelength<<endl;
       
+      static Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
+	= socket_states.getDataHandle();
+      
+      initRandomStream(ray.userData, states[ m_istate_cell_fix ]->getGlobalID(), false, m_iphoton_cell_fix);
+      
       //Get directions
       m_radiation->getCellDistPtr( m_istate_cell_fix )->
 	getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, m_direction );
@@ -751,9 +782,6 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getCellPhotonData(Photon &r
       // ray.actualKS = 0;
       //  cout<<"getCellcenter"<<endl;
       //Get cell center
-      static Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
-	= socket_states.getDataHandle();
-      
       Node& baricenter = (*states[ m_istate_cell_fix ]).getCoordinates();
       
       for(CFuint i=0;i<m_dim;++i){
@@ -804,18 +832,29 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData(Photon &r
   {
     for( ; m_iphoton_face_fix < m_nbPhotonsGhostState[ m_igState_face_fix  ]; )
     {
-      //Get directions
-      m_radiation->getWallDistPtr( m_igState_face_fix )->
-	getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, m_direction );
-      
-
-
+      SharedPtr<RadiationPhysics> wallDist = m_radiation->getWallDistPtr( m_igState_face_fix );
       const CFuint faceGeoID = m_radiation->getCurrentWallGeoID();
       const CFuint cellID = m_lagrangianSolver.getWallStateId( faceGeoID );
       
       static Framework::DataHandle<Framework::State*, Framework::GLOBAL> states
 	= socket_states.getDataHandle();
       
+      // a wall face is identified by its cell and by its center
+      if (m_randomSeed >= 0) {
+	DataHandle<CFreal> faceCenters = socket_faceCenters.getDataHandle();
+	unsigned long long emitterID = states[cellID]->getGlobalID();
+	for(CFuint i=0;i<m_dim;++i){
+	  CFreal x = faceCenters[m_dim * faceGeoID + i];
+	  unsigned long long bits = 0;
+	  std::memcpy(&bits, &x, sizeof(CFreal));
+	  emitterID = emitterID*1000003ULL ^ (bits ^ (bits >> 29));
+	}
+	initRandomStream(ray.userData, emitterID, true, m_iphoton_face_fix);
+      }
+      
+      //Get directions
+      wallDist->getRadiatorPtr()->getRandomEmission(ray.userData.wavelength, m_direction );
+      
       Node& cellCenter = (*states[cellID]).getCoordinates();
       
       //cout<<"direction = [";
@@ -898,6 +937,22 @@ bool RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::getFacePhotonData(Photon &r
 
 /////////////////////////////////////////////////////////////////////////////
 
+template<class PARTICLE_TRACKING>
+void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::initRandomStream
+(PhotonData& photonData, unsigned long long emitterID, bool isWall, CFuint photonIdx)
+{
+  if (m_randomSeed < 0) return;
+  
+  // the last bit separates the wall emitters from the cell ones
+  photonData.randomStream[0] = (unsigned int)emitterID;
+  photonData.randomStream[1] = ((unsigned int)(emitterID >> 32) & 0x7FFFFFFFU) | (isWall ? 0x80000000U : 0U);
+  photonData.randomStream[2] = (unsigned int)photonIdx;
+  photonData.randomStream[3] = 0;
+  m_randomStream.attach(&photonData.randomStream[0]);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
 template<class PARTICLE_TRACKING>
 void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
 {
@@ -910,7 +965,16 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
     
   CFLog(DEBUG_MAX, "RadiativeTransferMonteCarlo::computeCellRays()\n");
   
-  m_rand.seed(time(NULL)*(m_myProcessRank+1));
+  if (m_randomSeed < 0) {
+    m_rand.seed(time(NULL)*(m_myProcessRank+1));
+  }
+  else {
+    // all the generators draw from the stream of the current photon, keyed
+    // by the seed and the emission loop, whatever the partitioning
+    m_randomStream.setKey((unsigned int)m_randomSeed, (unsigned int)m_nbEmissionLoops);
+    RandomNumberGenerator::setStream(&m_randomStream);
+  }
+  ++m_nbEmissionLoops;
 
 
   // CFuint totalnbPhotons =  (m_nbRaysElem )* m_radiation->getNbStates();
@@ -1007,6 +1071,7 @@ void RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::computePhotons()
     CFLog(VERBOSE,"Number of photons left: "<< toGenerateCellPhotons <<"\n");
   }
   delete progressBar;
+  RandomNumberGenerator::setStream(CFNULL);
   
   CFLog(INFO,"RadiativeTransferMonteCarlo::computePhotons() => Raytracing took "<<s.readTimeHMS().str()<<'\n');
 
@@ -1093,6 +1158,7 @@ CFuint RadiativeTransferMonteCarlo<PARTICLE_TRACKING>::rayTracing(Photon& beam)
   
   CommonData trackingCommonData;
   PhotonData &beamData = m_lagrangianSolver.getUserDataPtr();
+  attachRandomStream(beamData);
   exitCellID=m_lagrangianSolver.getExitCellID();
   
   //bool foundEntity = false;
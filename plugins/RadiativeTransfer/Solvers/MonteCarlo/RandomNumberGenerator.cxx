@@ -6,7 +6,34 @@ namespace COOLFluiD {
 namespace RadiativeTransfer {
   using namespace std;
 
+  RandomStream* RandomNumberGenerator::m_stream = CFNULL;
+
+  CFreal RandomStream::uniform(){
+    cf_assert(m_state != CFNULL);
+    unsigned int ctr[4] = {m_state[3]++, m_state[0], m_state[1], m_state[2]};
+    unsigned int key[2] = {m_key[0], m_key[1]};
+    for (CFuint r = 0; r < 10; ++r) {
+      const unsigned long long p0 = 0xD2511F53ULL*ctr[0];
+      const unsigned long long p1 = 0xCD9E8D57ULL*ctr[2];
+      const unsigned int c1 = ctr[1];
+      const unsigned int c3 = ctr[3];
+      ctr[0] = (unsigned int)(p1 >> 32) ^ c1 ^ key[0];
+      ctr[1] = (unsigned int)p1;
+      ctr[2] = (unsigned int)(p0 >> 32) ^ c3 ^ key[1];
+      ctr[3] = (unsigned int)p0;
+      key[0] += 0x9E3779B9U;
+      key[1] += 0xBB67AE85U;
+    }
+    // 53 random bits, shifted by half a step to exclude 0 and 1
+    const CFreal hi = (CFreal)(ctr[0] >> 5);
+    const CFreal lo = (CFreal)(ctr[1] >> 6);
+    return (hi*67108864. + lo + 0.5)/9007199254740992.;
+  }
+
   CFreal RandomNumberGenerator::uniformRand(const CFreal i0, const CFreal i1){
+    if (m_stream != CFNULL) {
+      return i0 + (i1 - i0)*m_stream->uniform();
+    }
     boost::uniform_real<CFreal> uniformDist(i0,i1);
     boost::variate_generator<typeGenerator&, boost::uniform_real<CFreal> >
              uniform(m_generator, uniformDist);
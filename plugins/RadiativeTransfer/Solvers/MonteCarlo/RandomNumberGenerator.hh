@@ -2,6 +2,7 @@
 #define RANDOMNUMBERGENERATOR_HH
 
 #include "MathTools/MathFunctions.hh"
+#include "MathTools/MathConsts.hh"
 #include <boost/random.hpp>
 #include "Common/COOLFluiD.hh"
 #include <vector>
@@ -17,6 +18,34 @@ namespace RadiativeTransfer {
 
 typedef boost::mt19937 typeGenerator; //Marsenne Twister generator
 
+/*  Counter-based random number stream (Philox4x32-10): the n-th number
+*   of a stream only depends on the key and on the 4 words of the stream
+*   state, i.e. 3 words identifying the stream and the counter n. The
+*   stream state can be stored in a particle and sent to other processes
+*   so that the numbers do not depend on the partitioning.
+*/
+class RandomStream{
+
+public:
+
+  RandomStream() : m_state(CFNULL) {m_key[0] = m_key[1] = 0;}
+
+  /// set the key common to all the streams
+  void setKey(unsigned int k0, unsigned int k1) {m_key[0] = k0; m_key[1] = k1;}
+
+  /// attach the state of a stream (3 identification words and the counter)
+  void attach(unsigned int* state) {m_state = state;}
+
+  /// @return a number uniformly distributed in (0,1) and increment the counter
+  CFreal uniform();
+
+private:
+
+  unsigned int m_key[2];
+
+  unsigned int* m_state;
+};
+
 class RandomNumberGenerator{
 
 public:
@@ -25,30 +54,47 @@ public:
   void sphereDirections(CFuint dim, Tout &directions);
 
   template<typename Tin, typename Tout>
-  void hemiDirections(CFuint dim , Tin faceNormals, Tout &directions);
+  void hemiDirections(CFuint dim , const Tin& faceNormals, Tout &directions);
 
   CFreal uniformRand(const CFreal i0=0., const CFreal i1=1.);
 
   void seed(CFuint seedNumber);
 
+  /// make all the generators draw from the given stream instead of their
+  /// own generator (CFNULL to go back to the latter)
+  /// @warning the stream is shared by all the generators: not thread-safe
+  static void setStream(RandomStream* stream) {m_stream = stream;}
+
 private:
 
   typeGenerator m_generator;
+
+  static RandomStream* m_stream;
 };
 
 template<class Tout>
 void RandomNumberGenerator::sphereDirections(CFuint dim, Tout &directions){
-  boost::uniform_on_sphere<CFreal, std::vector<CFreal> > uniformOnSphere(dim);
-  boost::variate_generator<typeGenerator&, boost::uniform_on_sphere<CFreal , std::vector<CFreal> > >
-       randSphere(m_generator, uniformOnSphere);
-  std::vector<CFreal> temp=randSphere();
-  for (CFuint i=0; i<dim;++i){
-    directions[i]=temp[i];
+  // uniform sampling of the unit sphere (circle in 2D), without temporary storage
+  if (dim == 3) {
+    const CFreal z = uniformRand(-1., 1.);
+    const CFreal phi = uniformRand(0., 2.*MathTools::MathConsts::CFrealPi());
+    const CFreal r = std::sqrt(std::max(0., 1. - z*z));
+    directions[0] = r*std::cos(phi);
+    directions[1] = r*std::sin(phi);
+    directions[2] = z;
+  }
+  else if (dim == 2) {
+    const CFreal phi = uniformRand(0., 2.*MathTools::MathConsts::CFrealPi());
+    directions[0] = std::cos(phi);
+    directions[1] = std::sin(phi);
+  }
+  else {
+    directions[0] = (uniformRand() < 0.5) ? -1. : 1.;
   }
 }
 
 template<typename Tin, typename Tout>
-void RandomNumberGenerator::hemiDirections(CFuint dim , Tin faceNormals, Tout &directions){
+void RandomNumberGenerator::hemiDirections(CFuint dim , const Tin& faceNormals, Tout &directions){
   //generate spherical directions;
   sphereDirections(dim, directions);
   //if the direction is in the wrong half of the sphere
@@ -766,7 +766,6 @@ void ParWriteSolution::writeNodeList(ofstream* fout, const CFuint iType,
     
   const CFuint wordFormatSize = 22;
   
-  vector<MPI_Offset> wOffset(_nbWriters, tt.headerOffset[iType][1]); 
   // set the offsets for the nodes of this element type
   tt.nodesOffset[iType].first  = tt.headerOffset[iType][1];
   tt.nodesOffset[iType].second = tt.nodesOffset[iType].first + totalToSend*wordFormatSize;
@@ -774,140 +773,98 @@ void ParWriteSolution::writeNodeList(ofstream* fout, const CFuint iType,
   CFLog(VERBOSE, "ParWriteSolution::writeNodeList() => offsets = [" 
 	<<  tt.nodesOffset[iType].first << ", " << tt.nodesOffset[iType].second << "]\n");
   
-  // update the maximum possible element-list size to send
-  const CFuint maxElemSendSize = elementList.getMaxElemSize();
-  
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
+  // values of the nodes updated by this process: each process sends only 
+  // its own nodes to the corresponding writers
   const vector<CFuint>& nodesInType = tt.nodesInType[iType];
+  vector<CFuint> sendIDs;
+  sendIDs.reserve(nbLocalElements);
+  vector<CFreal> sendElements(nbLocalElements*nodesStride, 0.);
   for (CFuint iElem = 0; iElem < nbLocalElements; ++iElem) {
-    const CFuint globalTypeID = tt.mapNodeID2NodeIDByEType[iType]->find(nodesInType[iElem]);
-    elementList.insertElemLocalID(iElem, globalTypeID, 0);
-  }
-  elementList.endElemInsertion(_myRank);
-  
-  // buffer data to send
-  vector<CFreal> sendElements(maxElemSendSize, 0);
-  vector<CFreal> elementToPrint(maxElemSendSize, 0);
-  
-  CFint wRank = -1; 
-  CFuint wSendSize = 0;
-  CFuint rangeID = 0;
-  CFuint countElem = 0;
-  for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-    bool isRangeFound = false;
-    WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
+    const CFuint nodeID = _mapGlobal2LocalNodeID.find(nodesInType[iElem]);
     
-    if (isRangeFound) {
-      CFuint eSize = 0;
-      for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	const CFuint localElemID = it->second;
-	const CFuint globalElemID = tt.mapNodeID2NodeIDByEType[iType]->find(nodesInType[localElemID]);
-	const CFuint sendElemID = globalElemID - countElem;
-	const CFuint nodeID = _mapGlobal2LocalNodeID.find(nodesInType[localElemID]);
+    // this fix has to be added EVERYWHERE when writing states in parallel
+    if (nodes[nodeID]->isParUpdatable()) {
+      CFuint isend = sendIDs.size()*nodesStride;
+      sendIDs.push_back(tt.mapNodeID2NodeIDByEType[iType]->find(nodesInType[iElem]));
+      
+      for (CFuint in = 0; in < dim; ++in, ++isend) {
+	cf_assert(nodeID < nodes.size());
+	sendElements[isend] = (*nodes[nodeID])[in]*refL;
+      }
+      
+      if (!getMethodData().onlyCoordinates()) {
+	const RealVector& currState = *nodalStates.getState(nodeID);
+	const CFuint stateID = nodalStates.getStateLocalID(nodeID);
+	tempState.setLocalID(stateID);
+	// the node is set  in the temporary state
+	tempState.setSpaceCoordinates(nodes[nodeID]);
+	for (CFuint ieq = 0; ieq < nbEqs; ++ieq) {
+	  tempState[ieq] = currState[ieq];
+	}
 	
-	// this fix has to be added EVERYWHERE when writing states in parallel
-	if (nodes[nodeID]->isParUpdatable()) {
-	  CFuint isend = sendElemID*nodesStride;
-	  for (CFuint in = 0; in < dim; ++in, ++isend) {
-	    cf_assert(isend < sendElements.size());
-	    cf_assert(nodeID < nodes.size());
-	    sendElements[isend] = (*nodes[nodeID])[in]*refL;
-	  }
+	if (getMethodData().shouldPrintExtraValues()) {
+	  // dimensionalize the solution
+	  outputVarSet->setDimensionalValuesPlusExtraValues
+	    (tempState, dimState, extraValues);
 	  
-	  if (!getMethodData().onlyCoordinates()) {
-	    const RealVector& currState = *nodalStates.getState(nodeID);
-	    const CFuint stateID = nodalStates.getStateLocalID(nodeID);
-	    tempState.setLocalID(stateID);
-	    // the node is set  in the temporary state
-	    tempState.setSpaceCoordinates(nodes[nodeID]);
-	    for (CFuint ieq = 0; ieq < nbEqs; ++ieq) {
-	      tempState[ieq] = currState[ieq];
+	  if (getMethodData().withEquations()) {
+	    for (CFuint in = 0; in < dimState.size(); ++in, ++isend) {
+	      sendElements[isend] = dimState[in];
 	    }
-	    
-	    if (getMethodData().shouldPrintExtraValues()) {
-	      // dimensionalize the solution
-	      outputVarSet->setDimensionalValuesPlusExtraValues
-		(tempState, dimState, extraValues);
-	      
-	      if (getMethodData().withEquations()) {
-		for (CFuint in = 0; in < dimState.size(); ++in, ++isend) {
-		  cf_assert(isend < sendElements.size());
-		  sendElements[isend] = dimState[in];
-		}
-	      }
-	      
-	      for (CFuint in = 0; in < extraValues.size(); ++in, ++isend) {
-		cf_assert(isend < sendElements.size());
-		sendElements[isend] = extraValues[in];
-	      }
-	    }
-	    else {
-	      if (getMethodData().withEquations()) {
-		outputVarSet->setDimensionalValues(tempState, dimState);
-		for (CFuint in = 0; in < dimState.size(); ++in, ++isend) {
-		  cf_assert(isend < sendElements.size());
-		  sendElements[isend] = dimState[in];
-		}
-	      }
-	    }	    
-	    
-	    datahandle_output->fillStateData(&sendElements[0], stateID, isend);
+	  }
+	  
+	  for (CFuint in = 0; in < extraValues.size(); ++in, ++isend) {
+	    sendElements[isend] = extraValues[in];
 	  }
 	}
+	else {
+	  if (getMethodData().withEquations()) {
+	    outputVarSet->setDimensionalValues(tempState, dimState);
+	    for (CFuint in = 0; in < dimState.size(); ++in, ++isend) {
+	      sendElements[isend] = dimState[in];
+	    }
+	  }
+	}	    
+	
+	datahandle_output->fillStateData(&sendElements[0], stateID, isend);
       }
-      
-      cf_assert(eSize*nodesStride <= elementList.getSendDataSize(rangeID));
-    }
-    
-    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		  (" sendElements  = ", &sendElements, nodesStride) << "\n");
-    
-    const CFuint sendSize = elementList.getSendDataSize(rangeID);
-    cf_assert(sendSize <= sendElements.size());
-    cf_assert(sendSize <= elementToPrint.size());
-    
-    // if the rank corresponds to a writing process, record the size to send for this writer
-    if (_isWriterRank && wg.globalRanks[is] == _myRank) {
-      wSendSize = sendSize; // this should be the total sendsize in the range
-      wRank = is;
-    }
-    
-    MPI_Op myMpiOp;
-    MPI_Op_create((MPI_User_function *)cmpAndTakeMaxAbs3, 1, &myMpiOp);
-    MPI_Reduce(&sendElements[0], &elementToPrint[0], sendSize,
-	       MPIStructDef::getMPIType(&sendElements[0]), myMpiOp, wg.globalRanks[is], _comm);
-    
-    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		  (" elementToPrint  = ", &elementToPrint, nodesStride) << "\n");
-    
-    if (is == 0) {
-      CFLog(VERBOSE, "[0] => wOffset = " << wOffset[0] << ", sendSize = " << sendSize << "\n");
-    }
-    
-    // the offsets for all writers with send ID > current must be incremented  
-    for (CFuint iw = is+1; iw < wOffset.size(); ++iw) {
-      cf_assert(sendSize > 0);
-      wOffset[iw] += sendSize*wordFormatSize;
-      CFLog(VERBOSE, "[" << is << ", " << iw << "] => wOffset = " << wOffset[iw] << ", sendSize = " << sendSize << "\n");
-    }
-    
-    // reset the all sendElement list to 0
-    for (CFuint i = 0; i < maxElemSendSize; ++i) {
-      sendElements[i] = 0;
     }
-    
-    // update the count element for the current element type
-    countElem += elementList.getSendDataSize(rangeID)/nodesStride;
   }
+  sendElements.resize(sendIDs.size()*nodesStride);
+  
+  CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		(" sendElements  = ", &sendElements, nodesStride) << "\n");
+  
+  // start of the range of global IDs collected by each writer
+  vector<CFuint> rangeStart(nSend+1, 0);
+  for (CFuint is = 0; is < nSend; ++is) {
+    rangeStart[is+1] = rangeStart[is] + elementList.getSendDataSize(is)/nodesStride;
+  }
+  
+  const vector<int> writers(wg.globalRanks.begin(), wg.globalRanks.begin() + nSend);
+  const CFint wRank = getWriterRange(writers);
+  const CFuint wSendSize = (wRank >= 0) ? 
+    (rangeStart[wRank+1] - rangeStart[wRank])*nodesStride : 0;
+  
+  // only the writers hold the buffer of one range of nodal data
+  vector<CFreal> elementToPrint(_isWriterRank ? elementList.getMaxElemSize() : 0, 0.);
+  cf_assert(wSendSize <= elementToPrint.size());
+  
+  MPIIOFunctions::sendToWriters(sendIDs, sendElements, nodesStride, rangeStart, 
+				writers, (_isWriterRank) ? &elementToPrint[0] : CFNULL, _comm);
+  
+  CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		(" elementToPrint  = ", &elementToPrint, nodesStride) << "\n");
   
   if (_isWriterRank) { 
-    CFLog(DEBUG_MIN, "ParWriteSolution::writeNodeList() => P[" << _myRank << "] => offset = " << wOffset[wRank] << "\n");
     // each writer can now concurrently write all the collected data (related to one element type)
     cf_assert(wRank >= 0);
+    const MPI_Offset wOffset = tt.nodesOffset[iType].first + 
+      rangeStart[wRank]*nodesStride*wordFormatSize;
+    CFLog(DEBUG_MIN, "ParWriteSolution::writeNodeList() => P[" << _myRank << "] => offset = " << wOffset << "\n");
     
     // point to the corresponding writing location
-    fout->seekp(wOffset[wRank]);
+    fout->seekp(wOffset);
     
     CFLog(VERBOSE, "wSendSize = " << wSendSize << ", nodesStride = " << nodesStride << "\n");
     for (CFuint i = 0; i < wSendSize; ++i) {
@@ -941,11 +898,6 @@ void ParWriteSolution::writeNodeList(ofstream* fout, const CFuint iType,
     fout->seekp(maxpos);
   }
   
-  //reset the all sendElement list to 0
-  for (CFuint i = 0; i < maxElemSendSize; ++i) {
-    elementToPrint[i] = 0;
-  }
-  
   CFLog(VERBOSE, "ParWriteSolution::writeNodeList() => end\n");
 }
       
@@ -986,13 +938,10 @@ void ParWriteSolution::writeElementList
   elementList.fill(nbElementsInType, nbNodesInType, totalToSend);
   cf_assert(totalToSend == totalSize);
   
-  // update the maximum possible element-list size to send
-  const CFuint maxElemSendSize = elementList.getMaxElemSize();
   const CFuint wordFormatSize = _intWordFormatSize+1;
   
-  // wOffset is initialized with current offset
+  // the element list starts at the end of the nodes list
   MPI_Offset offset = tt.nodesOffset[iType].second;
-  vector<MPI_Offset> wOffset(_nbWriters, offset); 
   
   const CFuint dim = PhysicalModelStack::getActive()->getDim();
   // real number of nodes written for this element (can be more than nbNodesInType:
@@ -1019,116 +968,69 @@ void ParWriteSolution::writeElementList
   }
   cf_assert(globalElementIDs->size() >= nbLocalElements);
   
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
+  // global IDs and connectivity of the local elements: each process sends 
+  // only its own elements to the corresponding writers
+  vector<CFuint> sendIDs(nbLocalElements);
+  vector<CFuint> sendElements(nbLocalElements*nbNodesInType);
   CFuint elemID = startElementID;
-  const CFuint nbLocalElementsInType = nbLocalElements;
-  for (CFuint iElem = 0; iElem < nbLocalElementsInType; ++iElem, ++elemID) {
-    elementList.insertElemLocalID(elemID, (*globalElementIDs)[elemID], 0);
+  for (CFuint iElem = 0; iElem < nbLocalElements; ++iElem, ++elemID) {
+    sendIDs[iElem] = (*globalElementIDs)[elemID];
+    const CFuint nbNodes = (isCell) ? elements->getNbNodesInGeo(elemID) : 
+      (*elements)[iType]->getNbNodesInGeo(elemID);
+    cf_assert(nbNodes <= nbNodesInType);
+    
+    CFuint isend = iElem*nbNodesInType;
+    for (CFuint in = 0; in < nbNodesInType; ++in, ++isend) {
+      // fix for degenerated elements (e.g. quads with 2 coincident nodes)
+      const CFuint inID = (in < nbNodes) ? in : in-1;
+      const CFuint localNodeID = (isCell) ? elements->getNodeID(elemID, inID) : 
+	(*elements)[iType]->getNodeID(elemID, inID);
+      const CFuint globalNodeID = nodes[localNodeID]->getGlobalID();
+      sendElements[isend] = tt.mapNodeID2NodeIDByEType[iType]->find(globalNodeID);
+    }
   }
-  elementList.endElemInsertion(_myRank);
   
-  CFLog(VERBOSE, "P[" << _myRank << "] has maxElemSendSize = " << maxElemSendSize << "\n");
+  CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
+		(" sendElements  = ", &sendElements, nbNodesInType) << "\n");
   
-  // buffer data to send
-  vector<CFuint> sendElements(maxElemSendSize, 0);
-  vector<CFuint> elementToPrint(maxElemSendSize, 0);
-    
   const string writerName = getMethodData().getNamespace() + "_Writers";
   Group& wg = PE::GetPE().getGroup(writerName);
   
-  CFint wRank = -1; 
-  CFuint rangeID = 0;
-  CFuint wSendSize = 0;
-  CFuint countElem = 0;
-  for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-    bool isRangeFound = false;
-    WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
-    
-    if (isRangeFound) {
-      CFuint eSize = 0;
-      for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	const CFuint localElemID = it->second;
-	const CFuint globalElemID = (*globalElementIDs)[localElemID];
-	const CFuint sendElemID = globalElemID - countElem;
-	const CFuint nbNodes = (isCell) ? elements->getNbNodesInGeo(localElemID) : 
-	  (*elements)[iType]->getNbNodesInGeo(localElemID);
-	cf_assert(nbNodes <= nbNodesInType);
-	
-	CFuint isend = sendElemID*nbNodesInType;
-	for (CFuint in = 0; in < nbNodesInType; ++in, ++isend) {
-	  // fix for degenerated elements (e.g. quads with 2 coincident nodes)
-	  const CFuint inID = (in < nbNodes) ? in : in-1;
-	  const CFuint localNodeID = (isCell) ? elements->getNodeID(localElemID, inID) : 
-	    (*elements)[iType]->getNodeID(localElemID, inID);
-	  
-	  if (isend >= sendElements.size()) {
-	    CFLogInfo(_myRank << " nbNodesInType = " << nbNodesInType
-		      << " node isend = " << isend << " , size = " << sendElements.size() << "\n");
-	    cf_assert(isend < sendElements.size());
-	  }
-	  
-	  const CFuint globalNodeID = nodes[localNodeID]->getGlobalID();
-	  sendElements[isend] = tt.mapNodeID2NodeIDByEType[iType]->find(globalNodeID);
-	}
-      }
-      
-      cf_assert(eSize*nbNodesInType <= elementList.getSendDataSize(rangeID));
-    }
-    
-    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
-		  (" sendElements  = ", &sendElements, nbNodesInType) << "\n");
-    
-    // size of the data that, in total, those processes will send to the aggregator (writer) with ID=is
-    const CFuint sendSize = elementList.getSendDataSize(rangeID);
-    cf_assert(sendSize <= sendElements.size());
-    cf_assert(sendSize <= elementToPrint.size());
-    
-    // if the rank corresponds to a writing process, record the size to send for this writer
-    if (_isWriterRank && wg.globalRanks[is] == _myRank) {
-      wSendSize = sendSize; // this should be the total sendsize in the range
-      wRank = is;
-    }
-    
-    // for each send, accumulate data to the corresponding writing process
-    // this might allocate too much memory on master processes with OPENMPI
-    MPI_Reduce(&sendElements[0], &elementToPrint[0], (int)sendSize,
-	       MPIStructDef::getMPIType(&sendElements[0]), MPI_MAX, wg.globalRanks[is], _comm);
-    
-    // the offsets for all writers with send ID > current must be incremented  
-    for (CFuint iw = is+1; iw < wOffset.size(); ++iw) {
-      cf_assert(sendSize > 0);
-      // offset must be computed taling into account the real number of element nodes to write
-      wOffset[iw] += (sendSize/nbNodesInType)*nbNodesInTypeToWrite*wordFormatSize;
-      CFLog(DEBUG_MIN, "[" << is << ", " << iw << "] => wOffset = " << wOffset[iw] << ", sendSize = " 
-	    << (sendSize/nbNodesInType)*nbNodesInTypeToWrite << "\n");
-    }
-    
-    //reset the all sendElement list to 0
-    for (CFuint i = 0; i < maxElemSendSize; ++i) {
-      sendElements[i] = 0;
-    }
-    
-    // update the count element for the current element type
-    countElem += elementList.getSendDataSize(rangeID)/nbNodesInType;
-    
-    CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
-		  (" elementToPrint  = ", &elementToPrint, nbNodesInType) << "\n");
-    
-  } // end sending loop
+  // start of the range of global IDs collected by each writer
+  vector<CFuint> rangeStart(nSend+1, 0);
+  for (CFuint is = 0; is < nSend; ++is) {
+    rangeStart[is+1] = rangeStart[is] + elementList.getSendDataSize(is)/nbNodesInType;
+  }
+  
+  const vector<int> writers(wg.globalRanks.begin(), wg.globalRanks.begin() + nSend);
+  const CFint wRank = getWriterRange(writers);
+  const CFuint wSendSize = (wRank >= 0) ? 
+    (rangeStart[wRank+1] - rangeStart[wRank])*nbNodesInType : 0;
+  
+  // only the writers hold the buffer of one range of element data
+  vector<CFuint> elementToPrint(_isWriterRank ? elementList.getMaxElemSize() : 0, 0);
+  cf_assert(wSendSize <= elementToPrint.size());
+  
+  MPIIOFunctions::sendToWriters(sendIDs, sendElements, nbNodesInType, rangeStart, 
+				writers, (_isWriterRank) ? &elementToPrint[0] : CFNULL, _comm);
+  
+  CFLogDebugMax(_myRank << CFPrintContainer<vector<CFuint> >
+		(" elementToPrint  = ", &elementToPrint, nbNodesInType) << "\n");
   
   // need to distinguish between writing on boundary and not
   // need to be able to handle hybrid case ... (with degenerated quads having node[3] = node[2]) 
   
   if (_isWriterRank) { 
-    CFLog(VERBOSE, "ParCFmeshBinaryFileWriter::writeElementList() => P[" << _myRank 
-	  << "] => offset = " << wOffset[wRank] << "\n");
-    
     // each writer can now concurrently write all the collected data (related to one element type)
     cf_assert(wRank >= 0);
+    // offset must be computed taking into account the real number of element nodes to write
+    const MPI_Offset wOffset = offset + 
+      rangeStart[wRank]*nbNodesInTypeToWrite*wordFormatSize;
+    CFLog(VERBOSE, "ParWriteSolution::writeElementList() => P[" << _myRank 
+	  << "] => offset = " << wOffset << "\n");
     
     // point to the corresponding writing location
-    fout->seekp(wOffset[wRank]);
+    fout->seekp(wOffset);
     
     const CFuint nbElementsToWrite = wSendSize/nbNodesInType;
     for (CFuint i = 0; i < nbElementsToWrite; ++i) {
@@ -1149,11 +1051,6 @@ void ParWriteSolution::writeElementList
     fout->seekp(maxpos);
   }
   
-  // reset all the elements to print to 0
-  for (CFuint i = 0; i < maxElemSendSize; ++i) {
-    elementToPrint[i] = 0;
-  }
-  
   CFLog(VERBOSE, "ParWriteSolution::writeElementList() => end\n");
 }
       
@@ -25,18 +25,6 @@ namespace COOLFluiD {
 
 //////////////////////////////////////////////////////////////////////////////
 
- extern "C" {
-   static void cmpAndTakeMaxAbs3(CFreal* invec, CFreal* inoutvec, int* len,
-				 MPI_Datatype* datatype)
-   {
-     cf_assert(len != CFNULL);
-     int size = *len;
-     for (int i = 0; i < size; ++i) {
-       inoutvec[i] = (fabs(invec[i]) > 0.) ? invec[i] : inoutvec[i];
-     }
-   }
- }
-      
 /// This class represents a parallel writer for TECPLOT files
 /// @author Andrea Lani
 class TecplotWriter_API ParWriteSolution : 
@@ -240,7 +240,6 @@ void ParWriteSolutionBlock::writeNodeList(ofstream* fout, const CFuint iType,
   
   const CFuint wordFormatSize = 22;
   
-  vector<MPI_Offset> wOffset(_nbWriters, tt.headerOffset[iType][1]); 
   // set the offsets for the nodes of this element type
   tt.nodesOffset[iType].first  = tt.headerOffset[iType][1];
   const CFuint totalToSend = totNbVarsND*totalToSendND + totNbVarsCC*totalToSendCC;
@@ -253,33 +252,25 @@ void ParWriteSolutionBlock::writeNodeList(ofstream* fout, const CFuint iType,
   const CFuint maxElemSendSize = std::max(elementListND.getMaxElemSize(),
 					  elementListCC.getMaxElemSize());
   
-  // insert in the write list the local IDs of the elements
-  // the range ID is automatically determined inside the WriteListMap
   const vector<CFuint>& nodesInType = tt.nodesInType[iType];
-  for (CFuint iElem = 0; iElem < nbLocalElementsND; ++iElem) {
-    const CFuint globalTypeID = tt.mapNodeID2NodeIDByEType[iType]->find(nodesInType[iElem]);
-    elementListND.insertElemLocalID(iElem, globalTypeID, 0);
-  }
-  elementListND.endElemInsertion(_myRank);
-  
   SafePtr< vector<CFuint> > globalElementIDs = MeshDataStack::getActive()->getGlobalElementIDs();
   
+  CFuint startElemID = 0;
   if (!m_onlyNodal && !isBoundary) {
     SafePtr<vector<ElementTypeData> > elementType =
       MeshDataStack::getActive()->getElementTypeData(elements->getName());
-    ElementTypeData& eType = (*elementType)[iType];
-    // insert in the write list the local IDs of the elements
-    // the range ID is automatically determined inside the WriteListMap
-    CFuint elemID = eType.getStartIdx();
-    for (CFuint iElem = 0; iElem < nbLocalElementsCC; ++iElem, ++elemID) {
-      elementListCC.insertElemLocalID(elemID, (*globalElementIDs)[elemID], 0);
-    }
-    elementListCC.endElemInsertion(_myRank);
+    startElemID = (*elementType)[iType].getStartIdx();
   }
   
-  // buffer data to send
-  vector<CFreal> sendElements(maxElemSendSize, 0);
-  vector<CFreal> elementToPrint(maxElemSendSize, 0);
+  // ranks of the writers and range of global IDs collected by this process
+  const vector<int> writers(wg.globalRanks.begin(), wg.globalRanks.begin() + nSend);
+  const CFint wRank = getWriterRange(writers);
+  
+  // only the writers hold the buffer of one range of data
+  vector<CFreal> elementToPrint(_isWriterRank ? maxElemSendSize : 0, 0.);
+  
+  // offset of the first variable
+  MPI_Offset varOffset = tt.nodesOffset[iType].first;
   
   const CFuint totNbVars = totNbVarsND + totNbVarsCC;
   if (getMethodData().onlyCoordinates()) {
@@ -306,11 +297,6 @@ void ParWriteSolutionBlock::writeNodeList(ofstream* fout, const CFuint iType,
   }
   
   for (CFuint iVar = 0; iVar < totNbVars; ++iVar) {
-    CFint wRank = -1; 
-    CFuint wSendSize = 0;
-    CFuint rangeID = 0;
-    CFuint countElem = 0;
-    
     cf_assert(iVar < isVarNodal.size());
     const bool isNodal = isVarNodal[iVar]; 
     CFLog(VERBOSE, "ParWriteSolutionBlock::writeNodeList() => isNodal[" << iVar << "] = " << isNodal << " \n"); 
@@ -319,176 +305,139 @@ void ParWriteSolutionBlock::writeNodeList(ofstream* fout, const CFuint iType,
     if (!m_onlyNodal || (m_onlyNodal && isNodal)) {
       WriteListMap& elementList = (isNodal) ? elementListND : elementListCC;
       
-      for (CFuint is = 0; is < nSend; ++is, ++rangeID) {
-	bool isRangeFound = false;
-	WriteListMap::List elist = elementList.find(rangeID, isRangeFound);
+      // values of this variable in the local entries updated by this process:
+      // each process sends only its own entries to the corresponding writers
+      const CFuint nbLocalEntries = (isNodal) ? nbLocalElementsND : nbLocalElementsCC;
+      vector<CFuint> sendIDs;
+      sendIDs.reserve(nbLocalEntries);
+      vector<CFreal> sendElements(nbLocalEntries*nodesStride, 0.);
+      for (CFuint iElem = 0; iElem < nbLocalEntries; ++iElem) {
+	CFuint globalElemID = 0;
+	CFuint dofID = 0;
+	bool isUpdatable = false;
+	if (isNodal) {
+	  globalElemID = tt.mapNodeID2NodeIDByEType[iType]->find(nodesInType[iElem]);
+	  dofID = _mapGlobal2LocalNodeID.find(nodesInType[iElem]);
+	  if (nodes[dofID]->isParUpdatable()) isUpdatable = true;
+	}
+	else {
+	  const CFuint localElemID = startElemID + iElem;
+	  globalElemID = (*globalElementIDs)[localElemID];
+	  dofID = localElemID; // AL: double check this!!!
+	  if (states[dofID]->isParUpdatable()) isUpdatable = true;
+	}
 	
-	if (isRangeFound) {
-	  CFuint eSize = 0;
-	  for (WriteListMap::ListIterator it = elist.first; it != elist.second; ++it, ++eSize) {
-	    const CFuint localElemID = it->second;
-	    CFuint globalElemID = 0;
-	    CFuint dofID = 0;
-	    bool isUpdatable = false;
-	    if (isNodal) {
-	      globalElemID = tt.mapNodeID2NodeIDByEType[iType]->find(nodesInType[localElemID]);
-	      dofID = _mapGlobal2LocalNodeID.find(nodesInType[localElemID]);
-	      if (nodes[dofID]->isParUpdatable()) isUpdatable = true;
-	    }
-	    else {
-	      globalElemID = (*globalElementIDs)[localElemID];
-	      dofID = localElemID; // AL: double check this!!!
-	      if (states[dofID]->isParUpdatable()) isUpdatable = true;
-	    }
-	    
-	    const CFuint sendElemID = globalElemID - countElem;
+	// this fix has to be added EVERYWHERE when writing states in parallel
+	if (isUpdatable) {
+	  CFuint isend = sendIDs.size()*nodesStride;
+	  sendIDs.push_back(globalElemID);
+	  
+	  if (iVar < dim) {
+	    cf_assert(dofID < nodes.size());
+	    sendElements[isend++] = (*nodes[dofID])[iVar]*refL;
+	  }
+	  
+	  if (isNodal && iVar >= dim) { 
+	    const CFuint stateID = nodalStates.getStateLocalID(dofID);
+	    tempState.setLocalID(stateID);
+	    // the node is set  in the temporary state
+	    tempState.setSpaceCoordinates(nodes[dofID]);
 	    
-	    // this fix has to be added EVERYWHERE when writing states in parallel
-	    if (isUpdatable) {
-	      CFuint isend = sendElemID*nodesStride;
-	      
-	      if (iVar < dim) {
-		cf_assert(isend < sendElements.size());
-		cf_assert(dofID < nodes.size());
-		sendElements[isend++] = (*nodes[dofID])[iVar]*refL;
-		// break;
+	    if (iVar < endNbExtraVars) {
+	      const RealVector& currState = *nodalStates.getState(dofID);
+	      for (CFuint ieq = 0; ieq < nbEqs; ++ieq) {
+		tempState[ieq] = currState[ieq];
 	      }
 	      
-	      if (isNodal && iVar >= dim) { 
-		const CFuint stateID = nodalStates.getStateLocalID(dofID);
-		tempState.setLocalID(stateID);
-		// the node is set  in the temporary state
-		tempState.setSpaceCoordinates(nodes[dofID]);
-		
-		if (iVar < endNbExtraVars) {
-		  const RealVector& currState = *nodalStates.getState(dofID);
-		  for (CFuint ieq = 0; ieq < nbEqs; ++ieq) {
-		    tempState[ieq] = currState[ieq];
-		  }
-		  
-		  if (getMethodData().withEquations()) {
-		    if (iVar >= dim && iVar < endNbEqs) {
-		      cf_assert(isend < sendElements.size());
-		      outputVarSet->setDimensionalValues(tempState, dimState);
-		      sendElements[isend++] = dimState[iVar-dim];
-		    }
-		  }
-		  
-		  if (printExtra && (iVar >= endNbEqs && iVar < endNbExtraVars)) {
-		    // this is EXTREMELY inefficient !!!! 
-		    // setDimensionalValuesPlusExtraValues() will be called nbExtraVars times per state !!!
-		    // dimensionalize the solution
-		    outputVarSet->setDimensionalValuesPlusExtraValues(tempState, dimState, extraValues);
-		    cf_assert(isend < sendElements.size());
-		    sendElements[isend++] = extraValues[iVar-endNbEqs];
-		  }
-		}
-		
-		if (!isBoundary) {
-		  if (nbDHNDVars > 0 && iVar >= endNbExtraVars && iVar < endNbDHNDVars) {
-		    datahandle_output->fillStateData(&sendElements[0], stateID, isend, iVar-endNbExtraVars);
-		  }
+	      if (getMethodData().withEquations()) {
+		if (iVar >= dim && iVar < endNbEqs) {
+		  outputVarSet->setDimensionalValues(tempState, dimState);
+		  sendElements[isend++] = dimState[iVar-dim];
 		}
 	      }
-	      else if ((!isNodal) && iVar >= dim) {
-		// cell centered case
-		if (getMethodData().withEquations()) {
-		  if (iVar >= dim && iVar < endNbEqs) {
-		    const State& currState = *states[dofID];
-		    outputVarSet->setDimensionalValues(currState, dimState);
-		    cf_assert(isend < sendElements.size());
-		    sendElements[isend++] = dimState[iVar-dim];
-		  }
-		}
-		
-		if (printExtra && (iVar >= endNbEqs && iVar < endNbExtraVars)) {
-		  // this is EXTREMELY inefficient !!!! 
-		  // setDimensionalValuesPlusExtraValues() will be called nbExtraVars times per state !!!
-		  // dimensionalize the solution
-		  const State& currState = *states[dofID];
-		  outputVarSet->setDimensionalValuesPlusExtraValues(currState, dimState, extraValues);
-		  cf_assert(isend < sendElements.size());
-		  cf_assert(iVar-endNbEqs < extraValues.size());
-		  sendElements[isend++] = extraValues[iVar-endNbEqs]; 
-		}
-		
-		if (nbDHCCVars > 0 && iVar >= endNbDHNDVars) {
-		  datahandle_output->fillStateDataCC(&sendElements[0], dofID, isend, iVar - endNbDHNDVars);
-		}
+	      
+	      if (printExtra && (iVar >= endNbEqs && iVar < endNbExtraVars)) {
+		// this is EXTREMELY inefficient !!!! 
+		// setDimensionalValuesPlusExtraValues() will be called nbExtraVars times per state !!!
+		// dimensionalize the solution
+		outputVarSet->setDimensionalValuesPlusExtraValues(tempState, dimState, extraValues);
+		sendElements[isend++] = extraValues[iVar-endNbEqs];
+	      }
+	    }
+	    
+	    if (!isBoundary) {
+	      if (nbDHNDVars > 0 && iVar >= endNbExtraVars && iVar < endNbDHNDVars) {
+		datahandle_output->fillStateData(&sendElements[0], stateID, isend, iVar-endNbExtraVars);
 	      }
 	    }
 	  }
-	  
-	  cf_assert(eSize*nodesStride <= elementList.getSendDataSize(rangeID));
+	  else if ((!isNodal) && iVar >= dim) {
+	    // cell centered case
+	    if (getMethodData().withEquations()) {
+	      if (iVar >= dim && iVar < endNbEqs) {
+		const State& currState = *states[dofID];
+		outputVarSet->setDimensionalValues(currState, dimState);
+		sendElements[isend++] = dimState[iVar-dim];
+	      }
+	    }
+	    
+	    if (printExtra && (iVar >= endNbEqs && iVar < endNbExtraVars)) {
+	      // this is EXTREMELY inefficient !!!! 
+	      // setDimensionalValuesPlusExtraValues() will be called nbExtraVars times per state !!!
+	      // dimensionalize the solution
+	      const State& currState = *states[dofID];
+	      outputVarSet->setDimensionalValuesPlusExtraValues(currState, dimState, extraValues);
+	      cf_assert(iVar-endNbEqs < extraValues.size());
+	      sendElements[isend++] = extraValues[iVar-endNbEqs]; 
+	    }
+	    
+	    if (nbDHCCVars > 0 && iVar >= endNbDHNDVars) {
+	      datahandle_output->fillStateDataCC(&sendElements[0], dofID, isend, iVar - endNbDHNDVars);
+	    }
+	  }
 	}
-	
-	CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		      (" sendElements  = ", &sendElements, nodesStride) << "\n");
-	
-	const CFuint sendSize = elementList.getSendDataSize(rangeID);
-	cf_assert(sendSize <= sendElements.size());
-	cf_assert(sendSize <= elementToPrint.size());
+      }
+      sendElements.resize(sendIDs.size()*nodesStride);
       
-	// if the rank corresponds to a writing process, record the size to send for this writer
-	if (_isWriterRank && wg.globalRanks[is] == _myRank) {
-	  wSendSize = sendSize; // this should be the total sendsize in the range
-	  wRank = is;
-	}
-	
-	MPI_Op myMpiOp;
-	MPI_Op_create((MPI_User_function *)cmpAndTakeMaxAbs3, 1, &myMpiOp);
-	MPI_Reduce(&sendElements[0], &elementToPrint[0], sendSize,
-		   MPIStructDef::getMPIType(&sendElements[0]), myMpiOp, wg.globalRanks[is], _comm);
-	
-	CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
-		      (" elementToPrint  = ", &elementToPrint, nodesStride) << "\n");
-	
-	if (is == 0) {
-	  CFLog(VERBOSE, "[0] => wOffset = " << wOffset[0] << ", sendSize = " << sendSize << "\n");
-	}
-	
-	// the offsets for all writers with send ID > current must be incremented  
-	for (CFuint iw = is+1; iw < wOffset.size(); ++iw) {
-	  cf_assert(sendSize > 0);
-	  wOffset[iw] += sendSize*wordFormatSize;
-	  CFLog(VERBOSE, "[" << is << ", " << iw << "] => wOffset = " << wOffset[iw] << ", sendSize = " << sendSize << "\n");
-	}
-	
-	// reset the all sendElement list to 0
-	for (CFuint i = 0; i < maxElemSendSize; ++i) {
-	  sendElements[i] = 0;
-	}
-	
-	// update the count element for the current element type
-	countElem += elementList.getSendDataSize(rangeID)/nodesStride;
+      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		    (" sendElements  = ", &sendElements, nodesStride) << "\n");
+      
+      // start of the range of global IDs collected by each writer
+      vector<CFuint> rangeStart(nSend+1, 0);
+      for (CFuint is = 0; is < nSend; ++is) {
+	rangeStart[is+1] = rangeStart[is] + elementList.getSendDataSize(is)/nodesStride;
       }
       
+      const CFuint wSendSize = (wRank >= 0) ? 
+	(rangeStart[wRank+1] - rangeStart[wRank])*nodesStride : 0;
+      cf_assert(wSendSize <= elementToPrint.size());
+      
+      MPIIOFunctions::sendToWriters(sendIDs, sendElements, nodesStride, rangeStart, 
+				    writers, (_isWriterRank) ? &elementToPrint[0] : CFNULL, _comm);
+      
+      CFLogDebugMax(_myRank << CFPrintContainer<vector<CFreal> >
+		    (" elementToPrint  = ", &elementToPrint, nodesStride) << "\n");
+      
       if (_isWriterRank) { 
-	CFLog(DEBUG_MIN, "ParWriteSolutionBlock::writeNodeList() => P[" << _myRank << "] => offset = " << wOffset[wRank] << "\n");
 	// each writer can now concurrently write all the collected data (related to one element type)
 	cf_assert(wRank >= 0);
+	const MPI_Offset wOffset = varOffset + rangeStart[wRank]*nodesStride*wordFormatSize;
+	CFLog(DEBUG_MIN, "ParWriteSolutionBlock::writeNodeList() => P[" << _myRank << "] => offset = " << wOffset << "\n");
 	
 	// point to the corresponding writing location
-	fout->seekp(wOffset[wRank]);
-	CFLog(VERBOSE, "For iVar=" << iVar << " seeking position wOffset[wRank] = " << wOffset[wRank] << "\n");
+	fout->seekp(wOffset);
+	CFLog(VERBOSE, "For iVar=" << iVar << " seeking position wOffset = " << wOffset << "\n");
 	CFLog(VERBOSE, "wSendSize = " << wSendSize << ", nodesStride = " << nodesStride << "\n");
-	// const CFuint sizeLine = 8;
 	for (CFuint i = 0; i < wSendSize; ++i) {
 	  // this fix is needed for ensuring consistency in the format and avoid 
 	  // to have entries with 3 digits in the exponent (e.g. +A.BC..e-XXX)
 	  if (std::abs(elementToPrint[i]) < 1e-50) elementToPrint[i] = 0.;
 	  
-	  //	const CFreal coeff = (countN < dim) ? refL : 1.;
 	  // this format corresponds to a line of 22*nodesStride bytes  
 	  fout->precision(14);
 	  fout->setf(ios::scientific,ios::floatfield); 
 	  fout->setf(ios::showpos);
-	  // if ((i+1)%sizeLine > 0) {
-	  // *fout << elementToPrint[i] << " ";
-	  //	}
-	  //else {
 	  *fout << elementToPrint[i] << "\n"; 
-	  // }
 	}
 	
 	MPI_Offset lastpos = fout->tellp();
@@ -504,14 +453,12 @@ void ParWriteSolutionBlock::writeNodeList(ofstream* fout, const CFuint iType,
 	}
 	else {
 	  // update the starting offset
-	  wOffset.assign(_nbWriters, maxpos); 
+	  varOffset = maxpos; 
 	}
 	fout->seekp(maxpos);
-      }
-      
-      //reset the all sendElement list to 0
-      for (CFuint i = 0; i < maxElemSendSize; ++i) {
-	elementToPrint[i] = 0;
+	
+	//reset the all elementToPrint list to 0
+	elementToPrint.assign(elementToPrint.size(), 0.);
       }
     }
   }
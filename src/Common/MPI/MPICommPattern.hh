@@ -268,6 +268,17 @@ private:
   /// recv local IDs
   std::vector<T> m_recvBuf;
   
+  /// communicator duplicated for the ghost exchange, so that the exchanges 
+  /// of different patterns can be in flight at the same time
+  MPI_Comm m_syncComm;
+  
+  /// persistent point-to-point requests of the ghost exchange 
+  /// (receives from the neighbors first, then sends)
+  std::vector<MPI_Request> m_syncRequests;
+  
+  /// flag telling if the persistent requests have been built
+  bool m_syncReady;
+  
   /// The Index for ghost points
   TGhostMap _GhostMap;
 
@@ -317,6 +328,13 @@ private:
 
   void Sync_BuildTypeHelper (const std::vector<std::vector<IndexType> > & V,
                                    std::vector<MPI_Datatype> & MPIType ) const;
+  
+  /// Build the persistent requests for exchanging the ghosts with the 
+  /// neighbor ranks only (uses the send/recv counts of the ghost map)
+  void buildSyncRequests ();
+  
+  /// Free the persistent requests of the ghost exchange
+  void freeSyncRequests ();
 
   /// Find functions (for internal use)
   /// These take advantage of a index map if one is present
@@ -408,12 +426,24 @@ public: // funcions
   /// Synchronize the ghost entries (collective) with corresponding updatable values
   void synchronize();
   
+  /// Pack the updatable values and start their nonblocking exchange 
+  /// with the neighbor ranks. The data can be read, but ghost entries 
+  /// must not be written until endSynchronize() has returned
+  void beginSynchronize();
+  
+  /// Wait for the exchange started by beginSynchronize() and 
+  /// copy the received values into the ghost entries
+  void endSynchronize();
+  
   /// Build internal data structures
   /// (to be called after adding ghost points but before doing a sync)
   /// Collective.
   /// @pre InitMPI needs to be called before this.
   void BuildGhostMap(const std::string& algo) 
   {
+    // the persistent requests refer to the old communication pattern
+    freeSyncRequests();
+    
     cf_assert(algo == "Old" || algo == "Bcast" || algo == "AllToAll");
     if (algo == "Old") {
       BuildGhostMapOld(); 
@@ -1909,6 +1939,11 @@ void MPICommPattern<DATA>::DoneMPI ()
     }
   }
   
+  freeSyncRequests();
+  if (m_syncComm != MPI_COMM_NULL) {
+    MPI_Comm_free(&m_syncComm);
+  }
+  
   CFLogDebugMin( "MPICommPattern<DATA>::DoneMPI\n");
 }
 
@@ -1978,7 +2013,8 @@ MPICommPattern<DATA>::MPICommPattern (const std::string nspaceName,
 				      DATA* data, const T & Init, CFuint Size, CFuint ESize)
   : _ElementSize(ESize), _LocalSize(0), _GhostSize(0),
     _NextFree(_NO_MORE_FREE), m_data(data), _MetaData(DataType(), 0),
-    _IsIndexed(false), _InitMPIOK(false), _CGlobalValid(false)
+    _IsIndexed(false), _InitMPIOK(false), _CGlobalValid(false),
+    m_syncComm(MPI_COMM_NULL), m_syncRequests(), m_syncReady(false)
 {
   if (ESize > 0) {
     InitMPI (nspaceName);
@@ -2012,24 +2048,27 @@ void MPICommPattern<DATA>::synchronize()
 { 
   CFLog(VERBOSE, "MPICommPattern<DATA>::synchronize() => start\n");
   
+  beginSynchronize();
+  endSynchronize();
+  
+  CFLog(VERBOSE, "MPICommPattern<DATA>::synchronize() => end\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename DATA>
+void MPICommPattern<DATA>::beginSynchronize()
+{ 
   if (_CommSize > 1) {
-    using namespace std;
+    if (!m_syncReady) {
+      buildSyncRequests();
+    }
     
-    T dummy = 0.;
     const CFuint elemsize = _ElementSize/sizeof(T);
     
-    // allocate the send and recv buffers
-    m_sendBuf.resize(m_sendLocalIDs.size()*elemsize);
-    cf_assert(m_sendBuf.size() > 0);
-    
-    m_recvBuf.resize(m_recvLocalIDs.size()*elemsize);
-    cf_assert(m_recvBuf.size() > 0);
-    
     // send local IDs stores the local IDs of the locally updatable DOFs to send 
     const CFuint totalSize = size()*elemsize;
     
-    CFLog(VERBOSE, "MPICommPattern<DATA>::synchronize() => 1\n");
-    
     CFuint scounter = 0;
     for (CFuint i = 0; i < m_sendLocalIDs.size(); ++i) {
       const CFuint startLocalID = m_sendLocalIDs[i]*elemsize;
@@ -2040,17 +2079,30 @@ void MPICommPattern<DATA>::synchronize()
       }
     }
     
-    CFLog(VERBOSE, "MPICommPattern<DATA>::synchronize() => 2\n");
+    if (m_syncRequests.size() > 0) {
+      MPIError::getInstance().check
+	("MPI_Startall", "MPICommPattern<DATA>::beginSynchronize()",
+	 MPI_Startall(m_syncRequests.size(), &m_syncRequests[0]));
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename DATA>
+void MPICommPattern<DATA>::endSynchronize()
+{ 
+  if (_CommSize > 1) {
+    cf_assert(m_syncReady);
     
-    MPIError::getInstance().check
-      ("MPI_Alltoallv", "MPICommPattern<DATA>::synchronize()",
-       MPI_Alltoallv(&m_sendBuf[0], &m_sendCount[0], &m_sendDispl[0], 
-		     MPIStructDef::getMPIType(&dummy), 
-		     &m_recvBuf[0], &m_recvCount[0], &m_recvDispl[0], 
-		     MPIStructDef::getMPIType(&dummy),
-		     _Communicator));
+    if (m_syncRequests.size() > 0) {
+      MPIError::getInstance().check
+	("MPI_Waitall", "MPICommPattern<DATA>::endSynchronize()",
+	 MPI_Waitall(m_syncRequests.size(), &m_syncRequests[0], MPI_STATUSES_IGNORE));
+    }
     
-    CFLog(VERBOSE, "MPICommPattern<DATA>::synchronize() => 3\n");
+    const CFuint elemsize = _ElementSize/sizeof(T);
+    const CFuint totalSize = size()*elemsize;
     
     CFuint rcounter = 0;
     for (CFuint i = 0; i < m_recvLocalIDs.size(); ++i) {
@@ -2062,8 +2114,73 @@ void MPICommPattern<DATA>::synchronize()
       }
     }
   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename DATA>
+void MPICommPattern<DATA>::buildSyncRequests()
+{ 
+  CFLog(VERBOSE, "MPICommPattern<DATA>::buildSyncRequests() => start\n");
+  
+  freeSyncRequests();
+  
+  // the buffers must not be reallocated while the requests are alive
+  const CFuint elemsize = _ElementSize/sizeof(T);
+  m_sendBuf.resize(m_sendLocalIDs.size()*elemsize);
+  m_recvBuf.resize(m_recvLocalIDs.size()*elemsize);
+  
+  if (m_syncComm == MPI_COMM_NULL) {
+    MPIError::getInstance().check
+      ("MPI_Comm_dup", "MPICommPattern<DATA>::buildSyncRequests()",
+       MPI_Comm_dup(_Communicator, &m_syncComm));
+  }
   
-  CFLog(VERBOSE, "MPICommPattern<DATA>::synchronize() => end\n");
+  T dummy = T();
+  MPI_Datatype type = MPIStructDef::getMPIType(&dummy);
+  
+  // only the ranks sharing ghosts with this one are involved 
+  for (int i = 0; i < _CommSize; ++i) {
+    if (m_recvCount[i] > 0) {
+      MPI_Request request;
+      MPIError::getInstance().check
+	("MPI_Recv_init", "MPICommPattern<DATA>::buildSyncRequests()",
+	 MPI_Recv_init(&m_recvBuf[m_recvDispl[i]], m_recvCount[i], type, i, 
+		       _MPI_TAG_SYNC, m_syncComm, &request));
+      m_syncRequests.push_back(request);
+    }
+  }
+  const CFuint nbRecvs = m_syncRequests.size();
+  
+  for (int i = 0; i < _CommSize; ++i) {
+    if (m_sendCount[i] > 0) {
+      MPI_Request request;
+      MPIError::getInstance().check
+	("MPI_Send_init", "MPICommPattern<DATA>::buildSyncRequests()",
+	 MPI_Send_init(&m_sendBuf[m_sendDispl[i]], m_sendCount[i], type, i, 
+		       _MPI_TAG_SYNC, m_syncComm, &request));
+      m_syncRequests.push_back(request);
+    }
+  }
+  
+  m_syncReady = true;
+  
+  CFLog(VERBOSE, "MPICommPattern<DATA>::buildSyncRequests() => " << nbRecvs << " recv and " 
+	<< m_syncRequests.size() - nbRecvs << " send neighbors\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename DATA>
+void MPICommPattern<DATA>::freeSyncRequests()
+{ 
+  for (CFuint i = 0; i < m_syncRequests.size(); ++i) {
+    if (m_syncRequests[i] != MPI_REQUEST_NULL) {
+      MPI_Request_free(&m_syncRequests[i]);
+    }
+  }
+  m_syncRequests.clear();
+  m_syncReady = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -10,7 +10,9 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <mpi.h>
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "Common/Group.hh"
 #include "Common/CFLog.hh"
@@ -221,6 +223,203 @@ public:
       
     } while (totBufLeft > 0);
   }
+  
+  /// Send the entries owned by each process to the writers of the ranges of 
+  /// IDs they belong to. Only the owned entries are exchanged and each writer 
+  /// only receives the entries of its own range, so that the communication
+  /// volume and the memory scale with the size of the data rather than with
+  /// the number of processes times the size of the range.
+  /// @param ids         IDs of the entries owned by this process
+  /// @param values      stride values per entry, in the same order as ids
+  /// @param stride      number of values per entry
+  /// @param rangeStart  first ID of the range of each writer, followed by the 
+  ///                    end of the last range
+  /// @param writers     ranks in comm of the writers of each range (all different)
+  /// @param buf         buffer of the range of this process if it is a writer,
+  ///                    where the received entries are copied at 
+  ///                    (ID - rangeStart)*stride, ignored otherwise
+  template <typename T>
+  static void sendToWriters(const std::vector<CFuint>& ids, 
+			    const std::vector<T>& values,
+			    const CFuint stride,
+			    const std::vector<CFuint>& rangeStart,
+			    const std::vector<int>& writers,
+			    T* buf, MPI_Comm comm)
+  {
+    cf_assert(rangeStart.size() == writers.size() + 1);
+    cf_assert(values.size() == ids.size()*stride);
+    
+    int nbProcs = 0;
+    int myRank = 0;
+    MPI_Comm_size(comm, &nbProcs);
+    MPI_Comm_rank(comm, &myRank);
+    
+    const CFuint nbEntries = ids.size();
+    std::vector<CFuint> recvIDs;
+    std::vector<T> recvValues;
+    
+    if (writers.size() == 1) {
+      // a single writer simply gathers all the entries
+      const int root = writers[0];
+      int sendCount = nbEntries;
+      std::vector<int> recvCount((myRank == root) ? nbProcs : 0, 0);
+      MPIError::getInstance().check
+	("MPI_Gather", "MPIIOFunctions::sendToWriters()", 
+	 MPI_Gather(&sendCount, 1, MPI_INT, dataPtr(recvCount), 1, MPI_INT, root, comm));
+      
+      std::vector<int> recvDispl(recvCount.size(), 0);
+      for (CFuint p = 1; p < recvCount.size(); ++p) {
+	recvDispl[p] = recvDispl[p-1] + recvCount[p-1];
+      }
+      const CFuint nbRecv = (myRank == root) ? recvDispl.back() + recvCount.back() : 0;
+      
+      recvIDs.resize(nbRecv);
+      MPIError::getInstance().check
+	("MPI_Gatherv", "MPIIOFunctions::sendToWriters()", 
+	 MPI_Gatherv(dataPtr(const_cast<std::vector<CFuint>&>(ids)), sendCount, 
+		     MPIStructDef::getMPIType(dataPtr(recvIDs)), dataPtr(recvIDs), 
+		     dataPtr(recvCount), dataPtr(recvDispl), 
+		     MPIStructDef::getMPIType(dataPtr(recvIDs)), root, comm));
+      
+      sendCount *= stride;
+      for (CFuint p = 0; p < recvCount.size(); ++p) {
+	recvCount[p] *= stride; recvDispl[p] *= stride;
+      }
+      
+      recvValues.resize(nbRecv*stride);
+      MPIError::getInstance().check
+	("MPI_Gatherv", "MPIIOFunctions::sendToWriters()", 
+	 MPI_Gatherv(dataPtr(const_cast<std::vector<T>&>(values)), sendCount, 
+		     MPIStructDef::getMPIType(dataPtr(recvValues)), dataPtr(recvValues), 
+		     dataPtr(recvCount), dataPtr(recvDispl), 
+		     MPIStructDef::getMPIType(dataPtr(recvValues)), root, comm));
+    }
+    else {
+      // range of each owned entry and number of entries to send to each process
+      std::vector<CFuint> entryRange(nbEntries);
+      std::vector<int> sendCount(nbProcs, 0);
+      for (CFuint e = 0; e < nbEntries; ++e) {
+	const CFuint r = std::upper_bound(rangeStart.begin(), rangeStart.end(), ids[e]) 
+	  - rangeStart.begin() - 1;
+	cf_assert(r < writers.size());
+	entryRange[e] = r;
+	sendCount[writers[r]]++;
+      }
+      
+      std::vector<int> recvCount(nbProcs, 0);
+      MPIError::getInstance().check
+	("MPI_Alltoall", "MPIIOFunctions::sendToWriters()", 
+	 MPI_Alltoall(&sendCount[0], 1, MPI_INT, &recvCount[0], 1, MPI_INT, comm));
+      
+      std::vector<int> sendDispl(nbProcs, 0);
+      std::vector<int> recvDispl(nbProcs, 0);
+      for (int p = 1; p < nbProcs; ++p) {
+	sendDispl[p] = sendDispl[p-1] + sendCount[p-1];
+	recvDispl[p] = recvDispl[p-1] + recvCount[p-1];
+      }
+      const CFuint nbRecv = recvDispl[nbProcs-1] + recvCount[nbProcs-1];
+      
+      // pack the entries by destination
+      std::vector<CFuint> sendIDs(nbEntries);
+      std::vector<T> sendValues(nbEntries*stride);
+      std::vector<int> next(sendDispl);
+      for (CFuint e = 0; e < nbEntries; ++e) {
+	const CFuint pos = next[writers[entryRange[e]]]++;
+	sendIDs[pos] = ids[e];
+	std::copy(&values[e*stride], &values[e*stride] + stride, &sendValues[pos*stride]);
+      }
+      
+      recvIDs.resize(nbRecv);
+      MPIError::getInstance().check
+	("MPI_Alltoallv", "MPIIOFunctions::sendToWriters()", 
+	 MPI_Alltoallv(dataPtr(sendIDs), &sendCount[0], &sendDispl[0], 
+		       MPIStructDef::getMPIType(dataPtr(sendIDs)),
+		       dataPtr(recvIDs), &recvCount[0], &recvDispl[0], 
+		       MPIStructDef::getMPIType(dataPtr(recvIDs)), comm));
+      
+      for (int p = 0; p < nbProcs; ++p) {
+	sendCount[p] *= stride; sendDispl[p] *= stride;
+	recvCount[p] *= stride; recvDispl[p] *= stride;
+      }
+      
+      recvValues.resize(nbRecv*stride);
+      MPIError::getInstance().check
+	("MPI_Alltoallv", "MPIIOFunctions::sendToWriters()", 
+	 MPI_Alltoallv(dataPtr(sendValues), &sendCount[0], &sendDispl[0], 
+		       MPIStructDef::getMPIType(dataPtr(sendValues)),
+		       dataPtr(recvValues), &recvCount[0], &recvDispl[0], 
+		       MPIStructDef::getMPIType(dataPtr(recvValues)), comm));
+    }
+    
+    // copy the received entries at their position in the range
+    const CFuint nbRecv = recvIDs.size();
+    if (nbRecv > 0) {
+      const CFuint myRange = std::find(writers.begin(), writers.end(), myRank) - writers.begin();
+      cf_assert(myRange < writers.size());
+      for (CFuint e = 0; e < nbRecv; ++e) {
+	cf_assert(recvIDs[e] >= rangeStart[myRange]);
+	cf_assert(recvIDs[e] < rangeStart[myRange+1]);
+	const CFuint pos = (recvIDs[e] - rangeStart[myRange])*stride;
+	std::copy(&recvValues[e*stride], &recvValues[e*stride] + stride, &buf[pos]);
+      }
+    }
+  }
+  
+  /// Append the data of all the processors at the end of the given file,
+  /// in rank order. The offset of each processor is given by a prefix sum
+  /// of the data sizes and all the slices are written at once with
+  /// collective MPI-IO, instead of having the processors reopening the file
+  /// one after the other.
+  /// @param fileName  name of the file, created if it does not exist
+  /// @param buf       data of this processor
+  /// @param bufSize   number of bytes in buf (can be 0)
+  /// @param comm      communicator of all the processors writing the file
+  static void appendOrdered(const std::string& fileName, const char* buf,
+			    const CFuint bufSize, MPI_Comm comm)
+  {
+    MPI_File fh;
+    MPIError::getInstance().check
+      ("MPI_File_open", "MPIIOFunctions::appendOrdered()",
+       MPI_File_open(comm, const_cast<char*>(fileName.c_str()),
+		     MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh));
+
+    // all the processors see the same size of the file
+    MPI_Offset fileSize = 0;
+    MPI_File_get_size(fh, &fileSize);
+
+    int myRank = 0;
+    MPI_Comm_rank(comm, &myRank);
+    MPI_Offset mySize = bufSize;
+    MPI_Offset myOffset = 0;
+    MPI_Exscan(&mySize, &myOffset, 1, MPIStructDef::getMPIOffsetType(), MPI_SUM, comm);
+    if (myRank == 0) {myOffset = 0;}
+
+    // the data are written in blocks whose size fits into an int
+    const CFuint maxBlockSize = 1 << 30;
+    CFuint myNbBlocks = (bufSize + maxBlockSize - 1)/maxBlockSize;
+    CFuint nbBlocks = 0;
+    MPI_Allreduce(&myNbBlocks, &nbBlocks, 1, MPIStructDef::getMPIType(&myNbBlocks), MPI_MAX, comm);
+
+    for (CFuint ib = 0; ib < nbBlocks; ++ib) {
+      const CFuint start = std::min(ib*maxBlockSize, bufSize);
+      const int size = (int)(std::min(start + maxBlockSize, bufSize) - start);
+      MPI_Status status;
+      MPIError::getInstance().check
+	("MPI_File_write_at_all", "MPIIOFunctions::appendOrdered()",
+	 MPI_File_write_at_all(fh, fileSize + myOffset + start,
+			       const_cast<char*>((size > 0) ? &buf[start] : buf),
+			       size, MPI_CHAR, &status));
+    }
+
+    MPI_File_close(&fh);
+  }
+  
+private:
+  
+  /// @return the address of the first element of v or CFNULL if v is empty
+  template <typename T>
+  static T* dataPtr(std::vector<T>& v) {return (!v.empty()) ? &v[0] : CFNULL;}
+  
 };
 
 //////////////////////////////////////////////////////////////////////////////
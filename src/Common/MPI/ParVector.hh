@@ -121,6 +121,12 @@ public: // functions
   /// execute the synchronization
   void synchronize() {m_pattern->synchronize();} 
   
+  /// Start the nonblocking synchronization with the neighbor processes
+  void beginSynchronize() {m_pattern->beginSynchronize();}
+  
+  /// Complete the synchronization started by beginSynchronize()
+  void endSynchronize() {m_pattern->endSynchronize();}
+  
   /// Build Sync table
   void BuildGhostMap(const std::string& algo) {m_pattern->BuildGhostMap(algo);}
   
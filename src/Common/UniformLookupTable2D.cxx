@@ -0,0 +1,229 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cstring>
+#include <iterator>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "Common/FilesystemException.hh"
+#include "Common/UniformLookupTable2D.hh"
+
+#if defined(CF_HAVE_ALLOC_MMAP) && defined(CF_HAVE_UNISTD_H)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#define CF_LOOKUP_TABLE_MMAP
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// identifier of the file format
+static const char lookupTableMagic[8] = {'C','F','L','K','T','2','D','\0'};
+
+/// version of the file format, to be increased at each change of the layout
+static const unsigned int lookupTableVersion = 1;
+
+//////////////////////////////////////////////////////////////////////////////
+
+UniformLookupTable2D::UniformLookupTable2D() :
+  m_header(),
+  m_dx(0.),
+  m_dy(0.),
+  m_storage(),
+  m_data(CFNULL),
+  m_isMapped(false),
+  m_mapStart(CFNULL),
+  m_mapSize(0)
+{
+  std::memset(&m_header, 0, sizeof(Header));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+UniformLookupTable2D::~UniformLookupTable2D()
+{
+  clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void UniformLookupTable2D::initialize(CFreal x0, CFreal x1, CFuint nbX, AxisScale scaleX,
+				      CFreal y0, CFreal y1, CFuint nbY, AxisScale scaleY,
+				      CFuint nbVars)
+{
+  cf_always_assert(nbX > 1 && nbY > 1 && nbVars > 0);
+  cf_always_assert(x1 > x0 && y1 > y0);
+  cf_always_assert(scaleX == LINEAR || x0 > 0.);
+  cf_always_assert(scaleY == LINEAR || y0 > 0.);
+
+  clear();
+
+  std::memcpy(m_header.magic, lookupTableMagic, 8);
+  m_header.version = lookupTableVersion;
+  m_header.nbVars = nbVars;
+  m_header.nbX = nbX;
+  m_header.nbY = nbY;
+  m_header.scaleX = scaleX;
+  m_header.scaleY = scaleY;
+  m_header.x0 = x0;
+  m_header.x1 = x1;
+  m_header.y0 = y0;
+  m_header.y1 = y1;
+  setSpacing();
+
+  m_storage.assign(nbX*nbY*nbVars, 0.);
+  m_data = &m_storage[0];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void UniformLookupTable2D::setSpacing()
+{
+  m_dx = (m_header.scaleX == LOG) ?
+    (std::log(m_header.x1) - std::log(m_header.x0))/(m_header.nbX - 1) :
+    (m_header.x1 - m_header.x0)/(m_header.nbX - 1);
+  m_dy = (m_header.scaleY == LOG) ?
+    (std::log(m_header.y1) - std::log(m_header.y0))/(m_header.nbY - 1) :
+    (m_header.y1 - m_header.y0)/(m_header.nbY - 1);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void UniformLookupTable2D::clear()
+{
+#ifdef CF_LOOKUP_TABLE_MMAP
+  if (m_isMapped) {
+    munmap(m_mapStart, m_mapSize);
+  }
+#endif
+  m_isMapped = false;
+  m_mapStart = CFNULL;
+  m_mapSize = 0;
+  std::vector<CFreal>().swap(m_storage);
+  m_data = CFNULL;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void UniformLookupTable2D::save(const boost::filesystem::path& file,
+				const std::string& tag) const
+{
+  cf_assert(m_data != CFNULL);
+
+  // the table is written aside and then renamed, so that the file is never
+  // seen incomplete by other processes loading it
+  const boost::filesystem::path tmpFile(file.string() + ".tmp");
+  boost::filesystem::ofstream fout(tmpFile, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fout) {
+    throw FilesystemException (FromHere(), "Could not open file: " + tmpFile.string());
+  }
+
+  Header header = m_header;
+  header.tagSize = tag.size();
+  fout.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  fout.write(tag.c_str(), tag.size());
+
+  // the values are aligned on 8 bytes
+  const size_t padding = (8 - tag.size()%8)%8;
+  const char zeros[8] = {0,0,0,0,0,0,0,0};
+  fout.write(zeros, padding);
+
+  const size_t nbValues = m_header.nbX*m_header.nbY*m_header.nbVars;
+  fout.write(reinterpret_cast<const char*>(m_data), nbValues*sizeof(CFreal));
+
+  if (!fout) {
+    throw FilesystemException (FromHere(), "Could not write file: " + tmpFile.string());
+  }
+  fout.close();
+  boost::filesystem::rename(tmpFile, file);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool UniformLookupTable2D::load(const boost::filesystem::path& file,
+				const std::string& tag)
+{
+  if (!boost::filesystem::exists(file)) return false;
+
+  clear();
+
+#ifdef CF_LOOKUP_TABLE_MMAP
+  const int fd = open(file.string().c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+    close(fd);
+    return false;
+  }
+
+  void* start = mmap(CFNULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (start == MAP_FAILED) return false;
+
+  m_isMapped = true;
+  m_mapStart = start;
+  m_mapSize = st.st_size;
+  const char* content = static_cast<const char*>(start);
+  const size_t fileSize = st.st_size;
+#else
+  boost::filesystem::ifstream fin(file, std::ios::in | std::ios::binary);
+  if (!fin) return false;
+  std::vector<char> buffer((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+  if (buffer.size() < sizeof(Header)) return false;
+  const char* content = &buffer[0];
+  const size_t fileSize = buffer.size();
+#endif
+
+  Header header;
+  std::memcpy(&header, content, sizeof(Header));
+  const size_t padding = (8 - header.tagSize%8)%8;
+  const size_t dataStart = sizeof(Header) + header.tagSize + padding;
+  const size_t nbValues = (size_t)header.nbX*header.nbY*header.nbVars;
+
+  const bool isValid =
+    std::memcmp(header.magic, lookupTableMagic, 8) == 0 &&
+    header.version == lookupTableVersion &&
+    header.nbX > 1 && header.nbY > 1 && header.nbVars > 0 &&
+    header.tagSize == tag.size() &&
+    fileSize == dataStart + nbValues*sizeof(CFreal) &&
+    std::memcmp(content + sizeof(Header), tag.c_str(), tag.size()) == 0;
+
+  if (!isValid) {
+    clear();
+    return false;
+  }
+
+  m_header = header;
+  setSpacing();
+
+#ifdef CF_LOOKUP_TABLE_MMAP
+  m_data = reinterpret_cast<const CFreal*>(content + dataStart);
+#else
+  m_storage.resize(nbValues);
+  std::memcpy(&m_storage[0], content + dataStart, nbValues*sizeof(CFreal));
+  m_data = &m_storage[0];
+#endif
+
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,207 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Common_UniformLookupTable2D_hh
+#define COOLFluiD_Common_UniformLookupTable2D_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+
+#include "Common/COOLFluiD.hh"
+#include "Common/CommonAPI.hh"
+#include "Common/NonCopyable.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Common {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a table of several variables sampled on a
+/// structured grid whose axes are uniform in linear or logarithmic scale.
+/// The cell containing a point is computed directly (no search) and all
+/// the variables are interpolated at once with bilinear shape functions.
+/// Points outside the table are clamped to its boundaries.
+/// The table can be saved to a binary file which is mapped in memory
+/// (read-only) when loaded.
+class Common_API UniformLookupTable2D : public NonCopyable<UniformLookupTable2D> {
+public:
+
+  /// scale of an axis
+  enum AxisScale {LINEAR=0, LOG=1};
+
+  /// Constructor
+  UniformLookupTable2D();
+
+  /// Destructor
+  ~UniformLookupTable2D();
+
+  /// Initialize the table by allocating the memory for the values
+  /// @param x0, x1   bounds of the first axis
+  /// @param nbX      number of points along the first axis (>= 2)
+  /// @param scaleX   scale of the first axis
+  /// @param y0, y1   bounds of the second axis
+  /// @param nbY      number of points along the second axis (>= 2)
+  /// @param scaleY   scale of the second axis
+  /// @param nbVars   number of variables stored in each point
+  void initialize(CFreal x0, CFreal x1, CFuint nbX, AxisScale scaleX,
+		  CFreal y0, CFreal y1, CFuint nbY, AxisScale scaleY,
+		  CFuint nbVars);
+
+  /// @return the coordinate of the i-th point along the first axis
+  CFreal getX(CFuint i) const {return getCoord(i, m_header.x0, m_dx, m_header.scaleX);}
+
+  /// @return the coordinate of the j-th point along the second axis
+  CFreal getY(CFuint j) const {return getCoord(j, m_header.y0, m_dy, m_header.scaleY);}
+
+  /// @return the number of points along the first axis
+  CFuint getNbX() const {return m_header.nbX;}
+
+  /// @return the number of points along the second axis
+  CFuint getNbY() const {return m_header.nbY;}
+
+  /// @return the number of variables
+  CFuint getNbVars() const {return m_header.nbVars;}
+
+  /// Set the value of a variable in the point (i,j)
+  /// @pre the table has not been loaded from a file
+  void set(CFuint i, CFuint j, CFuint iVar, CFreal value)
+  {
+    cf_assert(!m_isMapped);
+    m_storage[(i + j*m_header.nbX)*m_header.nbVars + iVar] = value;
+  }
+
+  /// Interpolate all the variables in the given point
+  /// @param values  array of size getNbVars() where to store the result
+  void get(CFreal x, CFreal y, CFreal* values) const
+  {
+    CFuint i, j;
+    CFreal tx, ty;
+    locate(x, m_header.x0, m_dx, m_header.nbX, m_header.scaleX, i, tx);
+    locate(y, m_header.y0, m_dy, m_header.nbY, m_header.scaleY, j, ty);
+
+    const CFuint nbVars = m_header.nbVars;
+    const CFreal* v00 = &m_data[(i + j*m_header.nbX)*nbVars];
+    const CFreal* v10 = v00 + nbVars;
+    const CFreal* v01 = v00 + m_header.nbX*nbVars;
+    const CFreal* v11 = v01 + nbVars;
+    const CFreal w00 = (1. - tx)*(1. - ty);
+    const CFreal w10 = tx*(1. - ty);
+    const CFreal w01 = (1. - tx)*ty;
+    const CFreal w11 = tx*ty;
+    for (CFuint iVar = 0; iVar < nbVars; ++iVar) {
+      values[iVar] = w00*v00[iVar] + w10*v10[iVar] + w01*v01[iVar] + w11*v11[iVar];
+    }
+  }
+
+  /// Interpolate one variable in the given point
+  CFreal get(CFreal x, CFreal y, CFuint iVar) const
+  {
+    CFuint i, j;
+    CFreal tx, ty;
+    locate(x, m_header.x0, m_dx, m_header.nbX, m_header.scaleX, i, tx);
+    locate(y, m_header.y0, m_dy, m_header.nbY, m_header.scaleY, j, ty);
+
+    const CFuint nbVars = m_header.nbVars;
+    const CFreal* v00 = &m_data[(i + j*m_header.nbX)*nbVars + iVar];
+    const CFreal* v01 = v00 + m_header.nbX*nbVars;
+    return (1. - ty)*((1. - tx)*v00[0] + tx*v00[nbVars]) +
+      ty*((1. - tx)*v01[0] + tx*v01[nbVars]);
+  }
+
+  /// Save the table to a binary file
+  /// @param tag  string identifying the content of the table (checked by load())
+  void save(const boost::filesystem::path& file, const std::string& tag) const;
+
+  /// Load the table from a binary file written by save()
+  /// @param tag  string identifying the expected content of the table
+  /// @return false if the file does not exist, has another version or another tag
+  bool load(const boost::filesystem::path& file, const std::string& tag);
+
+  /// Release the memory or the mapped file
+  void clear();
+
+private:
+
+  /// @return the coordinate of a point along an axis
+  static CFreal getCoord(CFuint i, CFreal a0, CFreal delta, CFuint scale)
+  {
+    return (scale == LOG) ? std::exp(std::log(a0) + i*delta) : a0 + i*delta;
+  }
+
+  /// Compute the index of the cell containing the point along an axis
+  /// and the local coordinate of the point in [0,1]
+  static void locate(CFreal a, CFreal a0, CFreal delta, CFuint n, CFuint scale,
+		     CFuint& idx, CFreal& t)
+  {
+    const CFreal s = (scale == LOG) ?
+      (std::log(a) - std::log(a0))/delta : (a - a0)/delta;
+    if (!(s > 0.)) {idx = 0; t = 0.; return;}
+    if (s >= n - 1) {idx = n - 2; t = 1.; return;}
+    idx = static_cast<CFuint>(s);
+    t = s - idx;
+  }
+
+  /// set the spacing of the axes from the header
+  void setSpacing();
+
+private:
+
+  /// description of the table, stored at the beginning of the file
+  struct Header {
+    char magic[8];
+    unsigned int version;
+    unsigned int nbVars;
+    unsigned int nbX;
+    unsigned int nbY;
+    unsigned int scaleX;
+    unsigned int scaleY;
+    unsigned int tagSize;
+    unsigned int padding;
+    double x0, x1, y0, y1;
+  };
+
+  /// header of the table
+  Header m_header;
+
+  /// spacing along the first axis (in logarithm if LOG scale)
+  CFreal m_dx;
+
+  /// spacing along the second axis (in logarithm if LOG scale)
+  CFreal m_dy;
+
+  /// values, if the table is not mapped from a file
+  std::vector<CFreal> m_storage;
+
+  /// values, point after point, variable after variable
+  const CFreal* m_data;
+
+  /// flag telling if the values are mapped from a file
+  bool m_isMapped;
+
+  /// start of the mapped file
+  void* m_mapStart;
+
+  /// size of the mapped file
+  size_t m_mapSize;
+
+}; // end of class UniformLookupTable2D
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Common
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Common_UniformLookupTable2D_hh
@@ -0,0 +1,267 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <boost/bind.hpp>
+
+#include "Common/FilesystemException.hh"
+#include "Common/Stopwatch.hh"
+#include "Environment/ObjectProvider.hh"
+#include "Framework/AsyncFileWriter.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+// provider for this behavior
+Environment::ObjectProvider<AsyncFileWrite,
+			    Environment::FileHandlerOutput,
+			    FrameworkLib>
+Provider_AsyncFileWrite("AsyncFileWrite");
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncFileWriter& AsyncFileWriter::getInstance()
+{
+  static AsyncFileWriter aAsyncFileWriter;
+  return aAsyncFileWriter;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncFileWriter::AsyncFileWriter() :
+  m_jobs(),
+  m_writeTime(),
+  m_failures(),
+  m_owner(""),
+  m_mutex(),
+  m_cond(),
+  m_thread(),
+  m_busy(false),
+  m_stop(false)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+  if (m_thread.get() != CFNULL) {
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    // the queued files are written before the thread terminates
+    m_thread->join();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AsyncFileWriter::push(const boost::filesystem::path& filepath, std::string& content,
+			   std::ios_base::openmode mode)
+{
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_jobs.push_back(Job());
+    m_jobs.back().filepath = filepath;
+    m_jobs.back().content.swap(content);
+    m_jobs.back().mode = mode;
+    m_jobs.back().owner = m_owner;
+
+    if (m_thread.get() == CFNULL) {
+      m_thread.reset(new boost::thread(boost::bind(&AsyncFileWriter::run, this)));
+    }
+  }
+  m_cond.notify_all();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal AsyncFileWriter::wait()
+{
+  Stopwatch<WallTime> stopTimer;
+  stopTimer.start();
+
+  boost::mutex::scoped_lock lock(m_mutex);
+  while (!m_jobs.empty() || m_busy) {
+    m_cond.wait(lock);
+  }
+  lock.unlock();
+  
+  reportFailures();
+
+  stopTimer.stop();
+  return stopTimer.read();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AsyncFileWriter::reportFailures()
+{
+  vector<string> failures;
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    failures.swap(m_failures);
+  }
+  
+  for (CFuint i = 0; i < failures.size(); ++i) {
+    CFLog(ERROR, "AsyncFileWriter => could not write file " << failures[i] << "\n");
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFreal AsyncFileWriter::popWriteTime(const std::string& owner)
+{
+  CFreal time = 0.;
+  {
+    boost::mutex::scoped_lock lock(m_mutex);
+    time = m_writeTime[owner];
+    m_writeTime[owner] = 0.;
+  }
+  reportFailures();
+  return time;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AsyncFileWriter::run()
+{
+  Job job;
+  while (true) {
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+      while (m_jobs.empty() && !m_stop) {
+	m_cond.wait(lock);
+      }
+      if (m_jobs.empty()) return;
+
+      job.filepath = m_jobs.front().filepath;
+      job.content.swap(m_jobs.front().content);
+      job.mode = m_jobs.front().mode;
+      job.owner = m_jobs.front().owner;
+      m_jobs.pop_front();
+      m_busy = true;
+    }
+
+    Stopwatch<WallTime> stopTimer;
+    stopTimer.start();
+
+    // exceptions cannot be propagated and the logger cannot be used from
+    // this thread: failures are recorded and reported by the solver thread
+    ofstream fout(job.filepath.string().c_str(), job.mode);
+    if (fout) {
+      fout.write(job.content.data(), job.content.size());
+    }
+    const bool failed = !fout;
+    fout.close();
+    string().swap(job.content);
+
+    stopTimer.stop();
+
+    {
+      boost::mutex::scoped_lock lock(m_mutex);
+      m_writeTime[job.owner] += stopTimer.read();
+      if (failed) {m_failures.push_back(job.filepath.string());}
+      m_busy = false;
+    }
+    m_cond.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncFileWrite::AsyncFileWrite() :
+  Environment::FileHandlerOutput(),
+  m_fout(),
+  m_buffer(),
+  m_filepath(),
+  m_mode(std::ios_base::out),
+  m_direct(false)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+AsyncFileWrite::~AsyncFileWrite()
+{
+  if (m_isopen) close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::ofstream& AsyncFileWrite::open(const boost::filesystem::path& filepath,
+				    std::ios_base::openmode mode)
+{
+  cf_assert(!m_isopen);
+
+  m_filepath = filepath;
+  m_mode = mode;
+
+  // a file opened also for reading can be modified in place by other
+  // processes: it cannot be written from memory
+  m_direct = (mode & std::ios_base::in);
+  if (m_direct) {
+    CFLog(VERBOSE, "Opening file " << filepath.string() << "\n");
+    m_fout.open(filepath.string().c_str(), mode);
+    if (!m_fout) {
+      throw Common::FilesystemException (FromHere(), "Could not open file: " + filepath.string());
+    }
+  }
+  else {
+    CFLog(VERBOSE, "Opening file " << filepath.string() << " in memory\n");
+    m_fout.clear();
+    m_fout.std::basic_ios<char>::rdbuf(&m_buffer);
+  }
+
+  m_isopen = true;
+  return m_fout;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void AsyncFileWrite::close()
+{
+  if (m_direct) {
+    m_fout.close();
+  }
+  else {
+    m_fout.flush();
+    // the content is moved, not copied, to the background writer
+    std::string content;
+    m_buffer.swapContent(content);
+    // give back to the stream its own file buffer
+    m_fout.std::basic_ios<char>::rdbuf(m_fout.rdbuf());
+    AsyncFileWriter::getInstance().push(m_filepath, content, m_mode);
+  }
+  m_isopen = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::ofstream& AsyncFileWrite::get()
+{
+  cf_assert(m_isopen);
+  return m_fout;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
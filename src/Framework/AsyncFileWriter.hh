@@ -0,0 +1,233 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Framework_AsyncFileWriter_hh
+#define COOLFluiD_Framework_AsyncFileWriter_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <streambuf>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include "Common/NonCopyable.hh"
+#include "Environment/FileHandlerOutput.hh"
+#include "Framework/Framework.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a singleton object owning a background thread
+/// which writes to disk the files formatted in memory by AsyncFileWrite.
+/// Files are written in the same order as they are queued.
+class Framework_API AsyncFileWriter : public Common::NonCopyable<AsyncFileWriter> {
+public:
+
+  /// @return the instance of this singleton
+  static AsyncFileWriter& getInstance();
+
+  /// Queue a file to be written by the background thread
+  /// @param filepath path of the file
+  /// @param content  content of the file (swapped out, empty on return)
+  /// @param mode     mode to use for opening the file
+  void push(const boost::filesystem::path& filepath, std::string& content,
+	    std::ios_base::openmode mode);
+
+  /// Wait until all the queued files have been written
+  /// @return the time spent waiting
+  CFreal wait();
+
+  /// Set the name to which the next queued files are attributed
+  void setOwner(const std::string& owner) {m_owner = owner;}
+
+  /// Get the time spent in background writing the files of the given owner
+  /// since the last call to this function
+  CFreal popWriteTime(const std::string& owner);
+
+  /// Report the files which could not be written by the background thread
+  /// (the logger is not thread safe, so this is done by the calling thread)
+  void reportFailures();
+
+private:
+
+  /// Constructor
+  AsyncFileWriter();
+
+  /// Destructor
+  ~AsyncFileWriter();
+
+  /// Loop of the background thread
+  void run();
+
+private:
+
+  /// file to be written
+  struct Job {
+    boost::filesystem::path filepath;
+    std::string content;
+    std::ios_base::openmode mode;
+    std::string owner;
+  };
+
+  /// queued files
+  std::deque<Job> m_jobs;
+
+  /// time spent writing, per owner
+  std::map<std::string, CFreal> m_writeTime;
+
+  /// files which could not be written
+  std::vector<std::string> m_failures;
+
+  /// current owner of the queued files
+  std::string m_owner;
+
+  /// mutex protecting the queue and the timings
+  boost::mutex m_mutex;
+
+  /// condition signalling that a file has been queued or written
+  boost::condition_variable m_cond;
+
+  /// background thread (started at the first push)
+  std::auto_ptr<boost::thread> m_thread;
+
+  /// flag telling if a file is being written
+  bool m_busy;
+
+  /// flag telling the background thread to terminate
+  bool m_stop;
+
+}; // class AsyncFileWriter
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// A stream buffer accumulating the output into a string, which is then
+/// swapped out without copying it
+class Framework_API StringOutBuf : public std::streambuf {
+public:
+
+  /// Constructor
+  StringOutBuf() : std::streambuf(), m_str() {setp(m_chunk, m_chunk + CHUNK_SIZE);}
+
+  /// Swap the accumulated content with the given string and reset
+  void swapContent(std::string& content)
+  {
+    flushChunk();
+    m_str.swap(content);
+    std::string().swap(m_str);
+  }
+
+protected:
+
+  /// Append the chunk and the given character to the content
+  virtual int_type overflow(int_type c)
+  {
+    flushChunk();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  /// Append the given characters to the content
+  virtual std::streamsize xsputn(const char* s, std::streamsize n)
+  {
+    if (n > epptr() - pptr()) {
+      flushChunk();
+      m_str.append(s, n);
+      return n;
+    }
+    return std::streambuf::xsputn(s, n);
+  }
+
+  /// Append the chunk to the content
+  virtual int sync() {flushChunk(); return 0;}
+
+private:
+
+  /// Append the chunk to the content and reset it
+  void flushChunk()
+  {
+    m_str.append(pbase(), pptr() - pbase());
+    setp(m_chunk, m_chunk + CHUNK_SIZE);
+  }
+
+private:
+
+  /// size of the chunk
+  enum {CHUNK_SIZE = 65536};
+
+  /// chunk of characters being written
+  char m_chunk[CHUNK_SIZE];
+
+  /// accumulated content
+  std::string m_str;
+
+}; // class StringOutBuf
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// A FileHandlerOutput which formats the file in memory and hands it
+/// over to the AsyncFileWriter when closed. Files opened for reading
+/// (e.g. by the parallel writers, which seek in a shared file) are
+/// written directly.
+class Framework_API AsyncFileWrite : public Environment::FileHandlerOutput {
+public:
+
+  /// Constructor
+  AsyncFileWrite();
+
+  /// Destructor
+  virtual ~AsyncFileWrite();
+
+  /// Opens the file stream and returns the handle
+  virtual std::ofstream& open(const boost::filesystem::path& filepath,
+			      std::ios_base::openmode mode);
+
+  /// Closes the file stream and queues the content
+  virtual void close();
+
+  /// Accesses the file stream.
+  virtual std::ofstream& get();
+
+private:
+
+  /// file stream, redirected to m_buffer unless m_direct
+  std::ofstream m_fout;
+
+  /// in-memory content of the file
+  StringOutBuf m_buffer;
+
+  /// path of the file
+  boost::filesystem::path m_filepath;
+
+  /// mode for opening the file
+  std::ios_base::openmode m_mode;
+
+  /// flag telling if the file is written directly
+  bool m_direct;
+
+}; // class AsyncFileWrite
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Framework_AsyncFileWriter_hh
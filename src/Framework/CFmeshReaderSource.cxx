@@ -22,6 +22,36 @@ namespace COOLFluiD {
 
 //////////////////////////////////////////////////////////////////////////////
 
+/// @return the arena for the states of the given DataHandle, with room
+///         for all of them
+static EntityArena<State>& getStateArena(const std::string& name,
+					 const CFuint nbStates,
+					 const CFuint stride)
+{
+  EntityArena<State>& arena = MeshDataStack::getActive()->getStateArena(name);
+  if (arena.getCapacity() != nbStates || arena.getStride() != stride) {
+    arena.reserve(nbStates, stride);
+  }
+  return arena;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// @return the arena for the nodes of the given DataHandle, with room
+///         for all of them
+static EntityArena<Node>& getNodeArena(const std::string& name,
+				       const CFuint nbNodes,
+				       const CFuint stride)
+{
+  EntityArena<Node>& arena = MeshDataStack::getActive()->getNodeArena(name);
+  if (arena.getCapacity() != nbNodes || arena.getStride() != stride) {
+    arena.reserve(nbNodes, stride);
+  }
+  return arena;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 CFmeshReaderSource::CFmeshReaderSource() :
   socket_nodes("Null"),
   socket_states("Null"),
@@ -255,7 +285,8 @@ void CFmeshReaderSource::setPastNode(const CFuint nodeID, const RealVector& valu
     std::string socketName = "pastNodes";
     DataHandle<Node*> pastNodes = dynamicSockets->getSocketSink<Node*>(socketName)->getDataHandle();
 
-    pastNodes[nodeID] = new Node();
+    const CFuint dim = PhysicalModelStack::getActive()->getDim();
+    pastNodes[nodeID] = getNodeArena(socketName, pastNodes.size(), dim).create(nodeID);
     pastNodes[nodeID]->setIsOnMesh(false);
     *(pastNodes[nodeID]) = value;
   }
@@ -269,7 +300,8 @@ void CFmeshReaderSource::setPastState(const CFuint stateID, const RealVector& va
     std::string socketName = "pastStates";
     DataHandle<State*> pastStates = dynamicSockets->getSocketSink<State*>(socketName)->getDataHandle();
 
-    pastStates[stateID] = new State();
+    const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+    pastStates[stateID] = getStateArena(socketName, pastStates.size(), nbEqs).create(stateID);
     *(pastStates[stateID]) = value;
   }
 }
@@ -282,7 +314,8 @@ void CFmeshReaderSource::setInterNode(const CFuint nodeID, const RealVector& val
     std::string socketName = "interNodes";
     DataHandle<Node*> interNodes = dynamicSockets->getSocketSink<Node*>(socketName)->getDataHandle();
 
-    interNodes[nodeID] = new Node();
+    const CFuint dim = PhysicalModelStack::getActive()->getDim();
+    interNodes[nodeID] = getNodeArena(socketName, interNodes.size(), dim).create(nodeID);
     interNodes[nodeID]->setIsOnMesh(false);
     *(interNodes[nodeID]) = value;
   }
@@ -296,7 +329,8 @@ void CFmeshReaderSource::setInterState(const CFuint stateID, const RealVector& v
     std::string socketName = "interStates";
     DataHandle<State*> interStates = dynamicSockets->getSocketSink<State*>(socketName)->getDataHandle();
 
-    interStates[stateID] = new State();
+    const CFuint nbEqs = PhysicalModelStack::getActive()->getNbEq();
+    interStates[stateID] = getStateArena(socketName, interStates.size(), nbEqs).create(stateID);
     *(interStates[stateID]) = value;
   }
 }
@@ -400,11 +434,11 @@ void CFmeshReaderSource::setNode(const CFuint nodeID, CFreal * Mem, const RealVe
 
 Node* CFmeshReaderSource::createNode(const CFuint nodeID, CFreal * Mem, const RealVector& D, bool IsUpdatable)
 {
-  const bool ownedByMesh = true;
   cf_assert(nodeID < socket_nodes.getDataHandle().size());
 
-/// TODO: change this
-  Node* nodePtr = new Node (Mem, ownedByMesh);
+  // the node objects are contiguous, their data stay in the mesh storage
+  const CFuint nbNodes = socket_nodes.getDataHandle().size();
+  Node* nodePtr = getNodeArena("nodes", nbNodes, 0).create(nodeID, Mem);
 
   nodePtr->setParUpdatable(IsUpdatable);
 
@@ -468,8 +502,9 @@ State* CFmeshReaderSource::createState(const CFuint stateID, CFreal * Mem, const
 
   const bool Ghost = false;
 
-  /// TODO: change this
-  State* statePtr = new State (Mem);
+  // the state objects are contiguous, their data stay in the mesh storage
+  const CFuint nbStates = socket_states.getDataHandle().size();
+  State* statePtr = getStateArena("states", nbStates, 0).create(stateID, Mem);
 
   statePtr->setGhost(Ghost);
 
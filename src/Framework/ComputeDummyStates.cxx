@@ -79,6 +79,11 @@ void ComputeDummyStates::operator() (const std::vector<std::string>& trssWithGho
   
   const bool isGhost = true;
   CFuint nbGhostStates = 0;
+  
+  // ghost states contiguous in memory and in the same order as the boundary faces
+  EntityArena<State>& arena = MeshDataStack::getActive()->getStateArena("gstates");
+  arena.reserve(gstates.size(), newState.size());
+  
   // loop over all the BOUNDARY  topological region sets
   vector< Common::SafePtr<TopologicalRegionSet> >::iterator itrs;
   for (itrs = alltrs.begin(); itrs != alltrs.end(); ++itrs) {
@@ -93,7 +98,8 @@ void ComputeDummyStates::operator() (const std::vector<std::string>& trssWithGho
       // loop over all the boundary faces
       for (CFuint iGeo = 0; iGeo < nbGeos; ++iGeo, ++nbGhostStates) {
         // create a ghost state
-        State* ghostState = new State(newState, isGhost);
+        State* ghostState = arena.create(nbGhostStates);
+        ghostState->setGhost(isGhost);
 	const State* const state = states[trs->getStateID(iGeo, 0)];
         const CFuint faceID = trs->getLocalGeoID(iGeo);
         const CFuint startID = faceID*dim;
@@ -95,6 +95,11 @@ public:
     _isPerturb = isPerturb;
   }
   
+  /// Prepare the computation of the source term before the loop on the cells,
+  /// e.g. to evaluate expensive terms on all the cells at once
+  /// (nothing is done by default)
+  virtual void prepareComputeSource() {}
+  
   /// Compute the source term
   virtual void computeSource(Framework::GeometricEntity *const element,
 			     RealVector& source,
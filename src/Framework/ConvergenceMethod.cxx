@@ -149,7 +149,7 @@ void ConvergenceMethod::takeStep()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("takeStep");
 
   if (m_stopwatch.isNotRunning()) { m_stopwatch.start(); }
 
@@ -308,7 +308,7 @@ void ConvergenceMethod::syncGlobalDataComputeResidual(const bool computeResidual
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("syncGlobalDataComputeResidual");
 
   const bool isParallel = Common::PE::GetPE().IsParallel();
   Common::Stopwatch<Common::WallTime> syncTimer;
@@ -321,13 +321,19 @@ void ConvergenceMethod::syncGlobalDataComputeResidual(const bool computeResidual
     MeshDataStack::getInstance().getEntryByNamespace(nsp)->getNodeDataSocketSink().getDataHandle();
   
   if (CFEnv::getInstance().getVars()->SyncAlgo != "Old") {
+    // the ghost exchange with the neighbor processes overlaps 
+    // with the computation of the residual, which only reads the data
     if (isParallel) {
-      statedata.synchronize();
-      nodedata.synchronize();
+      statedata.beginSynchronize();
+      nodedata.beginSynchronize();
     }
     if (computeResidual) {
       getConvergenceMethodData()->updateResidual();
     }
+    if (isParallel) {
+      statedata.endSynchronize();
+      nodedata.endSynchronize();
+    }
   }
   else {
     // after each update the states have to be syncronized
@@ -358,7 +364,7 @@ void ConvergenceMethod::syncAllAndComputeResidual(const bool computeResidual)
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("syncAllAndComputeResidual");
 
   const bool isParallel = Common::PE::GetPE().IsParallel();
   Common::Stopwatch<Common::WallTime> syncTimer;
@@ -402,7 +408,7 @@ void ConvergenceMethod::writeOnScreen()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("writeOnScreen");
 
   Common::SafePtr<SubSystemStatus> subSysStatus = SubSystemStatusStack::getActive();
 
@@ -103,7 +103,7 @@ void CouplerMethod::preProcessWrite()
   cf_assert(isConfigured());
   cf_assert(isSetup());
   
-  pushNamespace();
+  pushNamespace("preProcessWrite");
   
   preProcessWriteImpl();
   
@@ -122,7 +122,7 @@ void CouplerMethod::preProcessRead()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("preProcessRead");
 
   preProcessReadImpl();
 
@@ -141,7 +141,7 @@ void CouplerMethod::meshMatchingWrite()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("meshMatchingWrite");
 
   meshMatchingWriteImpl();
 
@@ -160,7 +160,7 @@ void CouplerMethod::meshMatchingRead()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("meshMatchingRead");
 
   meshMatchingReadImpl();
 
@@ -177,7 +177,7 @@ void CouplerMethod::dataTransferRead()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("dataTransferRead");
 
   dataTransferReadImpl();
 
@@ -193,7 +193,7 @@ void CouplerMethod::dataTransferWrite()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("dataTransferWrite");
 
   dataTransferWriteImpl();
 
@@ -209,7 +209,7 @@ void CouplerMethod::finalize()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("finalize");
   
   finalizeImpl();
   
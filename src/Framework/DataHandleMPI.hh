@@ -18,6 +18,7 @@
 #include "Framework/GlobalCommTypes.hh"
 #include "Framework/GlobalTypeTrait.hh"
 #include "Framework/DataHandle.hh"
+#include "Framework/Profiler.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -166,6 +167,7 @@ public:
   /// begin the synchronization
   void beginSync()
   {
+    CFPROFILE("BeginSync");
     cf_assert(_globalPtr != NULL);
     _globalPtr->BeginSync ();
   }
@@ -173,6 +175,7 @@ public:
   /// end the synchronization
   void endSync()
   {
+    CFPROFILE("EndSync");
     cf_assert(_globalPtr != NULL);
     _globalPtr->EndSync ();
   }
@@ -180,9 +183,26 @@ public:
   /// execute the synchronization
   void synchronize()
   {
+    CFPROFILE("Synchronize");
     cf_assert(_globalPtr != NULL);
     _globalPtr->synchronize();
   }
+  
+  /// start the nonblocking synchronization with the neighbor processes
+  void beginSynchronize()
+  {
+    CFPROFILE("BeginSynchronize");
+    cf_assert(_globalPtr != NULL);
+    _globalPtr->beginSynchronize();
+  }
+  
+  /// complete the synchronization started by beginSynchronize()
+  void endSynchronize()
+  {
+    CFPROFILE("EndSynchronize");
+    cf_assert(_globalPtr != NULL);
+    _globalPtr->endSynchronize();
+  }
 
   /// allocate memory dynamically before insertion 
   void reserve (const CFuint Size, 
@@ -99,7 +99,7 @@ void DataProcessingMethod::processData()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("processData");
   
   if (SubSystemStatusStack::getActive()->getNbIter() < m_stopIter 
       && SubSystemStatusStack::getActive()->getNbIter() >= m_startIter ) {
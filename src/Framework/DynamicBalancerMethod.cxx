@@ -93,7 +93,7 @@ void DynamicBalancerMethod::doDynamicBalance()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("doDynamicBalance");
 
   doDynamicBalanceImpl();
 
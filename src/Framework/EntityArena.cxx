@@ -0,0 +1,192 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include "Common/CFLog.hh"
+#include "Framework/EntityArena.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+struct EntityArenaBase::Block {
+
+  /// storage for the entity objects
+  char* entities;
+
+  /// size in bytes of one entity object
+  size_t entitySize;
+
+  /// number of entities the block can hold
+  CFuint capacity;
+
+  /// size of the data of each entity
+  CFuint stride;
+
+  /// data of the entities
+  vector<CFreal> data;
+
+  /// flags telling which entities are alive
+  vector<bool> isAlive;
+
+  /// number of entities alive
+  CFuint nbAlive;
+
+  /// flag telling if the arena has given up this block
+  bool isOrphan;
+
+  /// @return true if the given pointer is an entity of this block
+  bool contains(const void* ptr) const
+  {
+    const char* p = static_cast<const char*>(ptr);
+    return (p >= entities && p < entities + capacity*entitySize);
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// registry of all the blocks of all the arenas, never destroyed since
+/// entities can be deleted during the destruction of static objects
+static vector<EntityArenaBase::Block*>& getBlockRegistry()
+{
+  static vector<EntityArenaBase::Block*>* registry = new vector<EntityArenaBase::Block*>();
+  return *registry;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void freeBlock(EntityArenaBase::Block* block)
+{
+  vector<EntityArenaBase::Block*>& registry = getBlockRegistry();
+  registry.erase(std::remove(registry.begin(), registry.end(), block), registry.end());
+  ::operator delete(block->entities);
+  delete block;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+EntityArenaBase::EntityArenaBase(size_t entitySize) :
+  m_entitySize(entitySize),
+  m_block(CFNULL)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+EntityArenaBase::~EntityArenaBase()
+{
+  clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool EntityArenaBase::release(void* ptr)
+{
+  vector<Block*>& registry = getBlockRegistry();
+  for (CFuint i = 0; i < registry.size(); ++i) {
+    Block* block = registry[i];
+    if (block->contains(ptr)) {
+      const CFuint idx = (static_cast<char*>(ptr) - block->entities)/block->entitySize;
+      cf_assert(block->isAlive[idx]);
+      block->isAlive[idx] = false;
+      --block->nbAlive;
+      if (block->isOrphan && block->nbAlive == 0) {
+	freeBlock(block);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint EntityArenaBase::getCapacity() const
+{
+  return (m_block != CFNULL) ? m_block->capacity : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint EntityArenaBase::getStride() const
+{
+  return (m_block != CFNULL) ? m_block->stride : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void EntityArenaBase::clear()
+{
+  if (m_block != CFNULL) {
+    if (m_block->nbAlive == 0) {
+      freeBlock(m_block);
+    }
+    else {
+      // the block is freed with its last entity
+      m_block->isOrphan = true;
+    }
+    m_block = CFNULL;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void EntityArenaBase::allocate(CFuint nbEntities, CFuint stride)
+{
+  clear();
+  if (nbEntities == 0) return;
+
+  Block* block = new Block();
+  block->entities = static_cast<char*>(::operator new(nbEntities*m_entitySize));
+  block->entitySize = m_entitySize;
+  block->capacity = nbEntities;
+  block->stride = stride;
+  block->data.resize(nbEntities*stride, 0.);
+  block->isAlive.resize(nbEntities, false);
+  block->nbAlive = 0;
+  block->isOrphan = false;
+
+  getBlockRegistry().push_back(block);
+  m_block = block;
+
+  CFLog(VERBOSE, "EntityArena::allocate() => " << nbEntities << " entities with stride "
+	<< stride << " (" << (nbEntities*(m_entitySize + stride*sizeof(CFreal)))/(1024*1024)
+	<< " MB)\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void* EntityArenaBase::acquire(CFuint idx, CFreal*& data)
+{
+  data = CFNULL;
+  if (m_block == CFNULL || idx >= m_block->capacity || m_block->isAlive[idx]) {
+    return CFNULL;
+  }
+
+  m_block->isAlive[idx] = true;
+  ++m_block->nbAlive;
+  if (m_block->stride > 0) {
+    data = &m_block->data[idx*m_block->stride];
+  }
+  return m_block->entities + idx*m_entitySize;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
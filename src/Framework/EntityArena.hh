@@ -0,0 +1,173 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Framework_EntityArena_hh
+#define COOLFluiD_Framework_EntityArena_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+
+#include "Framework/State.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class is the non template part of EntityArena.
+/// It keeps the contiguous block of entity objects (and optionally of their
+/// data) and the global registry of all the blocks, which allows State and
+/// Node to recognize an object living in an arena when it is deleted.
+/// A block whose entities are still alive when the arena is cleared or
+/// destroyed is released together with its last entity, so that the entities
+/// can be deleted one by one as if they had been allocated with new.
+class Framework_API EntityArenaBase {
+public:
+
+  /// contiguous storage for the entities and their data
+  struct Block;
+
+  /// Release the given entity, if it lives in an arena
+  /// @pre the destructor of the entity has already been called
+  /// @return false if the entity has not been allocated in an arena
+  static bool release(void* ptr);
+
+  /// Get the number of entities the arena can hold
+  CFuint getCapacity() const;
+
+  /// Get the size of the data of each entity stored in the arena
+  CFuint getStride() const;
+
+  /// Give up the current block, which is freed as soon as its
+  /// entities have all been deleted
+  void clear();
+
+protected:
+
+  /// Constructor
+  /// @param entitySize size in bytes of one entity object
+  explicit EntityArenaBase(size_t entitySize);
+
+  /// Destructor
+  ~EntityArenaBase();
+
+  /// Allocate a new block for the given number of entities
+  /// @param stride  size of the data of each entity (0 if the data are
+  ///                not kept in the arena)
+  void allocate(CFuint nbEntities, CFuint stride);
+
+  /// Acquire the memory for the entity with the given index
+  /// @param data  set to the data of the entity in the arena, if any
+  /// @return CFNULL if the entity cannot be placed in the arena
+  void* acquire(CFuint idx, CFreal*& data);
+
+private:
+
+  /// Disallow copy
+  EntityArenaBase(const EntityArenaBase&);
+
+  /// Disallow assignment
+  EntityArenaBase& operator= (const EntityArenaBase&);
+
+private:
+
+  /// size in bytes of one entity object
+  size_t m_entitySize;
+
+  /// current block
+  Block* m_block;
+
+}; // end of class EntityArenaBase
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This struct knows how to build an entity in a given memory location,
+/// or on the heap if no location is given.
+template <typename ENTITY>
+struct EntityArenaTraits;
+
+/// States built on external data take it as their storage
+template <>
+struct EntityArenaTraits<State> {
+  static State* construct(void* mem, CFreal* data)
+  {
+    if (mem == CFNULL) {
+      return (data == CFNULL) ? new State() : new State(data);
+    }
+    return (data == CFNULL) ? new (mem) State() : new (mem) State(data);
+  }
+};
+
+/// Nodes built on external data are the mesh nodes
+template <>
+struct EntityArenaTraits<Node> {
+  static Node* construct(void* mem, CFreal* data)
+  {
+    const bool isOnMesh = (data != CFNULL);
+    if (mem == CFNULL) {
+      return (data == CFNULL) ? new Node(isOnMesh) : new Node(data, isOnMesh);
+    }
+    return (data == CFNULL) ?
+      new (mem) Node(isOnMesh) : new (mem) Node(data, isOnMesh);
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class provides contiguous storage for a set of State's or Node's,
+/// indexed as the corresponding DataHandle, instead of one heap allocation
+/// per entity. The data of the entities can be either external (e.g. the
+/// ParVector memory of the mesh states) or kept in the arena with a fixed
+/// stride, in the same order as the entities.
+/// The entities are deleted with delete as usual: the arena only saves the
+/// allocations and keeps neighbouring entities next to each other in memory.
+/// If an entity cannot be placed in the arena (index beyond the capacity
+/// or slot already in use) it is allocated on the heap.
+template <typename ENTITY>
+class EntityArena : public EntityArenaBase {
+public:
+
+  /// Constructor
+  EntityArena() : EntityArenaBase(sizeof(ENTITY)) {}
+
+  /// Destructor
+  ~EntityArena() {}
+
+  /// Reserve room for the given number of entities
+  /// @param stride  size of the data of each entity to keep in the arena,
+  ///                0 if the entities are built on external data
+  void reserve(CFuint nbEntities, CFuint stride = 0)
+  {
+    allocate(nbEntities, stride);
+  }
+
+  /// Create the entity with the given index
+  /// @param data  external data of the entity, if CFNULL the data in the
+  ///              arena are used (or allocated by the entity itself if the
+  ///              arena has no data)
+  ENTITY* create(CFuint idx, CFreal* data = CFNULL)
+  {
+    CFreal* arenaData = CFNULL;
+    void* mem = acquire(idx, arenaData);
+    return EntityArenaTraits<ENTITY>::construct
+      (mem, (data != CFNULL) ? data : arenaData);
+  }
+
+}; // end of class EntityArena
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Framework_EntityArena_hh
@@ -76,7 +76,7 @@ void ErrorEstimatorMethod::estimate()
   cf_assert(isSetup());
   //cf_assert(isSpaceMethodSet());
 
-  pushNamespace();
+  pushNamespace("estimate");
 
   estimateImpl();
 
@@ -73,13 +73,16 @@ public:
       _shapeFunc[ip].resize(SHAPE::getNbNodes());
       _shapeFunc[ip] = 0.0;
     }
+
+    // the quadrature points are fixed in the reference element, so that
+    // the shape functions are tabulated once for all the elements
+    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
   }
 
   /// Compute the interpolated values in the quadrature points
   void computeSolutionAtQuadraturePoints(const std::vector<State*>& states,
                                                std::vector<State*>& values)
   {
-    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
     SHAPE::interpolate(states, _shapeFunc, values);
   }
 
@@ -87,7 +90,6 @@ public:
   void computeCoordinatesAtQuadraturePoints(const std::vector<Node*>& nodes,
                                                   std::vector<Node*>& coord)
   {
-    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
     SHAPE::interpolate(nodes, _shapeFunc, coord);
   }
 
@@ -98,7 +100,6 @@ public:
           const std::vector<State*>& states,
                 std::vector<State*>& values)
   {
-    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
     SHAPE::interpolate(nodes, _shapeFunc, coord);
     SHAPE::interpolate(states, _shapeFunc, values);
   }
@@ -141,7 +142,6 @@ public:
   /// Computes the ShapeFunctions values
   const std::vector<RealVector>& computeShapeFunctionsAtQuadraturePoints()
   {
-    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
     return _shapeFunc;
   }
 
@@ -158,7 +158,7 @@ protected: // data
   /// mapped coordinates of the quadrature points
   std::vector<RealVector> _mappedCoord;
 
-  /// nodal shape function values at quadrature points
+  /// nodal shape function values at quadrature points, tabulated in setup()
   std::vector<RealVector> _shapeFunc;
 
 }; // end class GaussLegendreContourIntegratorImpl
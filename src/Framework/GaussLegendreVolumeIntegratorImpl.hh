@@ -9,6 +9,7 @@
 
 //////////////////////////////////////////////////////////////////////////////
 
+#include "MathTools/MatrixInverterT.hh"
 #include "Framework/CFPolyForm.hh"
 #include "Framework/CFPolyOrder.hh"
 #include "Framework/CFGeoShape.hh"
@@ -35,7 +36,8 @@ class GaussLegendreVolumeIntegratorImpl : public VolumeIntegratorImpl {
 public:
 
   /// Constructor
-  GaussLegendreVolumeIntegratorImpl() :  VolumeIntegratorImpl(), _mappedCoord() {}
+  GaussLegendreVolumeIntegratorImpl() :
+    VolumeIntegratorImpl(), _mappedCoord(), _shapeFunc(), _mappedGrad(), _hasMappedGrad(false) {}
 
   /// Default destructor
   virtual ~GaussLegendreVolumeIntegratorImpl() {}
@@ -64,13 +66,24 @@ public:
       _shapeFunc[ip].resize(SHAPE::getNbNodes());
       _shapeFunc[ip] = 0.0;
     }
+
+    // the quadrature points are fixed in the reference element, so that
+    // the shape functions are tabulated once for all the elements
+    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
+
+    // and so are their gradients in the reference element, if provided
+    _mappedGrad.resize(nbQPts);
+    for (CFuint ip = 0; ip < nbQPts; ++ip) {
+      _mappedGrad[ip].resize(SHAPE::getNbNodes(), SHAPE::getDimensionality());
+      _mappedGrad[ip] = 0.0;
+    }
+    _hasMappedGrad = SHAPE::computeMappedGradients(_mappedCoord,_mappedGrad);
   }
 
   /// Compute the interpolated values in the quadrature points
   void computeSolutionAtQuadraturePoints(const std::vector<State*>& states,
       std::vector<State*>& values)
   {
-    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
     SHAPE::interpolate(states, _shapeFunc, values);
   }
 
@@ -78,7 +91,6 @@ public:
   void computeCoordinatesAtQuadraturePoints(const std::vector<Node*>& nodes,
     			    std::vector<Node*>& coord)
   {
-    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
     SHAPE::interpolate(nodes, _shapeFunc, coord);
   }
 
@@ -89,7 +101,6 @@ public:
   const std::vector<State*>& states,
   std::vector<State*>& values)
   {
-    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
     SHAPE::interpolate(nodes, _shapeFunc, coord);
     SHAPE::interpolate(states, _shapeFunc, values);
   }
@@ -109,7 +120,6 @@ public:
   /// Compute the ShapeFunctions values
   const std::vector<RealVector>& computeShapeFunctionsAtQuadraturePoints()
   {
-    SHAPE::computeShapeFunctions(_mappedCoord,_shapeFunc);
     return _shapeFunc;
   }
 
@@ -123,7 +133,24 @@ public:
   {
   const CFuint dim = PhysicalModelStack::getActive()->getDim();
   const CFuint dimensionality = SHAPE::getDimensionality();
-  if(dim == dimensionality) {
+  if(dim == dimensionality && useMappedGradients(mappedCoord)) {
+    // J(i,j) = dx_j/dxi_i from the tabulated gradients
+    const CFuint nbNodes = nodes.size();
+    for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
+      const RealMatrix& mappedGrad = _mappedGrad[ip];
+      RealMatrix& pointJacob = jacob[ip];
+      pointJacob = 0.0;
+      for (CFuint n = 0; n < nbNodes; ++n) {
+        const Node& node = *nodes[n];
+        for (CFuint i = 0; i < dim; ++i) {
+          for (CFuint j = 0; j < dim; ++j) {
+            pointJacob(i,j) += mappedGrad(n,i)*node[j];
+          }
+        }
+      }
+    }
+  }
+  else if(dim == dimensionality) {
     SHAPE::computeJacobian(nodes, mappedCoord, jacob);
   }
   else {
@@ -142,7 +169,40 @@ public:
           const std::vector<RealVector>& mappedCoord,
                 std::vector<RealMatrix>& grad)
   {
-    SHAPE::computeGradientStates(jacob, mappedCoord, grad);
+    const CFuint dim = PhysicalModelStack::getActive()->getDim();
+    if (dim != SHAPE::getDimensionality() || dim < DIM_2D || !useMappedGradients(mappedCoord)) {
+      SHAPE::computeGradientStates(jacob, mappedCoord, grad);
+      return;
+    }
+
+    // the Jacobian is inverted at each point, since it varies
+    // on curved elements, into storage on the stack
+    CFreal invJData[9];
+    RealMatrix invJ(dim,dim,invJData);
+    MathTools::MatrixInverterT<2> inverter2D;
+    MathTools::MatrixInverterT<3> inverter3D;
+    const CFuint nbNodes = SHAPE::getNbNodes();
+    for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
+      if (dim == DIM_2D) {
+        inverter2D.invert(jacob[ip], invJ);
+      }
+      else {
+        inverter3D.invert(jacob[ip], invJ);
+      }
+
+      // dN/dx_j = sum_k dN/dxi_k * dxi_k/dx_j, with invJ(j,k) = dxi_k/dx_j
+      const RealMatrix& mappedGrad = _mappedGrad[ip];
+      RealMatrix& lgrad = grad[ip];
+      for (CFuint n = 0; n < nbNodes; ++n) {
+        for (CFuint j = 0; j < dim; ++j) {
+          CFreal sum = 0.0;
+          for (CFuint k = 0; k < dim; ++k) {
+            sum += mappedGrad(n,k)*invJ(j,k);
+          }
+          lgrad(n,j) = sum;
+        }
+      }
+    }
   }
 
   /// Compute the jacobian of transformation at the quadrature points
@@ -186,14 +246,35 @@ protected: // methods
   /// Set the weights
   virtual void setWeights() = 0;
 
+  /// @return true if the gradients tabulated in the reference element
+  /// can be used at the given quadrature points
+  bool useMappedGradients(const std::vector<RealVector>& mappedCoord) const
+  {
+    if (!_hasMappedGrad || mappedCoord.size() != _mappedCoord.size()) return false;
+    // the points of another integrator may be given
+    for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
+      for (CFuint i = 0; i < mappedCoord[ip].size(); ++i) {
+        if (mappedCoord[ip][i] != _mappedCoord[ip][i]) return false;
+      }
+    }
+    return true;
+  }
+
 protected: // data
 
   /// mapped coordinates of the quadrature points
   std::vector<RealVector> _mappedCoord;
 
-  /// nodal shape function values at quadrature points
+  /// nodal shape function values at quadrature points, tabulated in setup()
   std::vector<RealVector> _shapeFunc;
 
+  /// gradients of the nodal shape functions in the reference element
+  /// at quadrature points, tabulated in setup() if SHAPE provides them
+  std::vector<RealMatrix> _mappedGrad;
+
+  /// flag telling if _mappedGrad has been tabulated
+  bool _hasMappedGrad;
+
 }; // end class GaussLegendreVolumeIntegratorImpl
 
 //////////////////////////////////////////////////////////////////////////////
@@ -95,6 +95,32 @@ public: // functions
     return m_preconditionerRate;  
   }
 
+  /// Tell if the preconditioner of the previous solve has to be reused,
+  /// as requested by the convergence method
+  bool reusePreconditioner() const
+  {
+    return m_reusePreconditioner;
+  }
+
+  /// Set the flag telling if the preconditioner of the previous solve has
+  /// to be reused
+  void setReusePreconditioner(bool reuse)
+  {
+    m_reusePreconditioner = reuse;
+  }
+
+  /// Gets the number of iterations taken by the last solve
+  CFuint getNbIterations() const
+  {
+    return m_nbIterations;
+  }
+
+  /// Sets the number of iterations taken by the last solve
+  void setNbIterations(CFuint nbIterations)
+  {
+    m_nbIterations = nbIterations;
+  }
+
   /// Returns if the convergence history of the solver should be outputed
   bool isOutput() const
   {
@@ -149,6 +175,12 @@ public: // functions
 
   /// rate at which preconditioner must be recomputed 
   CFuint m_preconditionerRate;
+
+  /// flag telling to reuse the preconditioner of the previous solve
+  bool m_reusePreconditioner;
+
+  /// number of iterations taken by the last solve
+  CFuint m_nbIterations;
  
   /// write output
   bool m_isOutput;
@@ -133,7 +133,7 @@ void LinearSystemSolver::solveSys()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("solveSys");
 
   solveSysImpl();
 
@@ -154,6 +154,22 @@ Framework::LSSIdxMapping& LinearSystemSolver::getLocalToLocallyUpdatableMapping(
   return m_lssData->getLocalToLocallyUpdatableMapping();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+void LinearSystemSolver::setReusePreconditioner(bool reuse)
+{
+  if (m_lssData.isNotNull()) {
+    m_lssData->setReusePreconditioner(reuse);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+CFuint LinearSystemSolver::getNbIterations() const
+{
+  return (m_lssData.isNotNull()) ? m_lssData->getNbIterations() : 0;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
   } // namespace Framework
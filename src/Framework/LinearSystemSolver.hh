@@ -91,6 +91,14 @@ public: // methods
   /// Gets the size of the system of equations to solve
   CFuint getNbSysEqs() const {   return m_nbSysEquations;  }
 
+  /// Tell the solver to reuse (or not) the preconditioner computed during
+  /// the previous solve, as long as the matrix is kept frozen
+  void setReusePreconditioner(bool reuse);
+
+  /// Get the number of iterations taken by the last solve (0 if the
+  /// solver does not provide it)
+  CFuint getNbIterations() const;
+
   /// Get the Preconditioner system matrix
   virtual Common::SafePtr<LSSMatrix> getPreconditionerMatrix() const
   {
@@ -78,7 +78,7 @@ void MeshAdapterMethod::adaptMesh()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("adaptMesh");
 
   adaptMeshImpl();
 
@@ -94,7 +94,7 @@ void MeshAdapterMethod::remesh()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("remesh");
 
   remeshImpl();
 
@@ -82,7 +82,7 @@ void MeshCreator::generateMeshData()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("generateMeshData");
 
   CFLog(NOTICE,"-------------------------------------------------------------\n");
   CFLog(NOTICE,"MeshCreator [" << getName() << "] Generate or Read Mesh\n");
@@ -105,7 +105,7 @@ void MeshCreator::processMeshData()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("processMeshData");
 
   /// @todo this could be a post generation hook not directly accessible from
   ///       the interface, maybe controled by commands
@@ -123,7 +123,7 @@ void MeshCreator::buildMeshData()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("buildMeshData");
 
   CFLog(NOTICE,"-------------------------------------------------------------\n");
   CFLog(NOTICE,"MeshCreator [" << getName() << "] Building Mesh Data\n");
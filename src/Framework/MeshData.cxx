@@ -45,6 +45,8 @@ MeshData::MeshData(const std::string& name) :
   m_connectivityStorage(),
   m_trsStorage(),
   m_mapGeoToTrsStorage(),
+  m_stateArenaStorage(),
+  m_nodeArenaStorage(),
   m_elementType(new vector<ElementTypeData>()),
   m_groupElementTypeMap(),
   m_nbOverLayers(1),
@@ -85,6 +87,10 @@ MeshData::~MeshData()
   CFAUTOTRACE;
 
   deallocate();
+
+  // the arenas still holding entities are freed with their last entity
+  m_stateArenaStorage.deleteAllEntries();
+  m_nodeArenaStorage.deleteAllEntries();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -331,6 +337,11 @@ void MeshData::deallocateNodesStates()
     deletePtr(nodes[i]);
   }
 
+  // the mesh states and nodes have all been deleted, so the arenas
+  // holding them can be freed
+  getStateArena("states").clear();
+  getNodeArena("nodes").clear();
+
   // deallocateSockets();
 
   /// @todo the use of IndexList has to be re-discussed !!!!!!!
@@ -445,6 +456,26 @@ void MeshData::addTrs(TopologicalRegionSet * trs)
 
 //////////////////////////////////////////////////////////////////////////////
 
+EntityArena<State>& MeshData::getStateArena(const std::string& name)
+{
+  if (!m_stateArenaStorage.checkEntry(name)) {
+    m_stateArenaStorage.addEntry(name, new EntityArena<State>());
+  }
+  return *m_stateArenaStorage.getEntry(name);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+EntityArena<Node>& MeshData::getNodeArena(const std::string& name)
+{
+  if (!m_nodeArenaStorage.checkEntry(name)) {
+    m_nodeArenaStorage.addEntry(name, new EntityArena<Node>());
+  }
+  return *m_nodeArenaStorage.getEntry(name);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void MeshData::storeMapGeoToTrs(const std::string& name,
                                 MapGeoToTrsAndIdx *const mapG)
 {
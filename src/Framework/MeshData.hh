@@ -19,6 +19,7 @@
 #include "Framework/DataSocketSink.hh"
 #include "Framework/TopologicalRegionSet.hh"
 #include "Framework/ElementTypeData.hh"
+#include "Framework/EntityArena.hh"
 #include "Framework/Storage.hh"
 #include "Framework/NamespaceGroup.hh"
 #include "Framework/NamespaceStack.hh"
@@ -150,6 +151,16 @@ public: // methods
   /// @param name the name to identify the connectivity
   void removeConnectivity(const std::string& name);
 
+  /// @return the arena providing contiguous storage for the State's
+  ///         of the DataHandle with the given name
+  /// @param name the name of the DataHandle (e.g. "states", "pastStates")
+  EntityArena<State>& getStateArena(const std::string& name);
+
+  /// @return the arena providing contiguous storage for the Node's
+  ///         of the DataHandle with the given name
+  /// @param name the name of the DataHandle (e.g. "nodes", "pastNodes")
+  EntityArena<Node>& getNodeArena(const std::string& name);
+
   /// @return the MapGeoToTrsAndIdx corresponding to the given name
   /// @param name the name to identify the connectivity
   Common::SafePtr<MapGeoToTrsAndIdx> getMapGeoToTrs(const std::string& name);
@@ -323,6 +334,12 @@ private: // member data
   /// TRS data
   Common::GeneralStorage<MapGeoToTrsAndIdx> m_mapGeoToTrsStorage;
 
+  /// storage of the arenas for the State's
+  Common::GeneralStorage< EntityArena<State> > m_stateArenaStorage;
+
+  /// storage of the arenas for the Node's
+  Common::GeneralStorage< EntityArena<Node> > m_nodeArenaStorage;
+
   /// the vector of data of ElementTypes
   std::vector<ElementTypeData>* m_elementType;
 
@@ -46,6 +46,10 @@ public:
 
     /// virtual destructor
   virtual ~MeshPartitioner ();
+  
+  /// Append to the given array the settings which affect the partitioning
+  /// (used to detect if a stored partitioning can be reused)
+  virtual void getSettings(std::vector<CFint>& settings) const {}
 
     /// For factory
   static std::string getClassName () { return "MeshPartitioner"; }
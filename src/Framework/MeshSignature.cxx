@@ -0,0 +1,87 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "Common/MPI/MPIError.hh"
+#include "Framework/MeshSignature.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// 64-bit FNV-1a hash of a value, combined with the given hash
+static inline uint64_t hashCombine(uint64_t hash, uint64_t value)
+{
+  for (CFuint i = 0; i < 8; ++i) {
+    hash ^= (value >> (8*i)) & 0xff;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+uint64_t computeMeshSignature(const ConnectivityTable<CFuint>& elemNode,
+			      const ConnectivityTable<CFuint>& elemState,
+			      DataHandle<Node*, GLOBAL> nodes,
+			      DataHandle<State*, GLOBAL> states,
+			      const CFuint totNbNodes,
+			      const CFuint totNbStates,
+			      const CFuint totNbElems,
+			      MPI_Comm comm)
+{
+  cf_assert(elemNode.nbRows() == elemState.nbRows());
+
+  // the sum is independent from the order in which the elements are visited;
+  // the elements of the overlap region are present on several processors,
+  // so each element is only counted by the owner of its first state
+  uint64_t localSum = 0;
+  const CFuint nbElems = elemNode.nbRows();
+  for (CFuint iElem = 0; iElem < nbElems; ++iElem) {
+    if (!states[elemState(iElem, 0)]->isParUpdatable()) continue;
+    
+    uint64_t elemHash = 14695981039346656037ULL;
+    const CFuint nbNodesInElem = elemNode.nbCols(iElem);
+    elemHash = hashCombine(elemHash, nbNodesInElem);
+    for (CFuint in = 0; in < nbNodesInElem; ++in) {
+      elemHash = hashCombine(elemHash, nodes[elemNode(iElem, in)]->getGlobalID());
+    }
+    const CFuint nbStatesInElem = elemState.nbCols(iElem);
+    elemHash = hashCombine(elemHash, nbStatesInElem);
+    for (CFuint is = 0; is < nbStatesInElem; ++is) {
+      elemHash = hashCombine(elemHash, states[elemState(iElem, is)]->getGlobalID());
+    }
+    localSum += elemHash;
+  }
+
+  uint64_t sum = 0;
+  MPIError::getInstance().check
+    ("MPI_Allreduce", "computeMeshSignature()",
+     MPI_Allreduce(&localSum, &sum, 1, MPI_UINT64_T, MPI_SUM, comm));
+
+  uint64_t hash = 14695981039346656037ULL;
+  hash = hashCombine(hash, sum);
+  hash = hashCombine(hash, totNbNodes);
+  hash = hashCombine(hash, totNbStates);
+  hash = hashCombine(hash, totNbElems);
+  return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,62 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Framework_MeshSignature_hh
+#define COOLFluiD_Framework_MeshSignature_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <mpi.h>
+#include <stdint.h>
+
+#include "Common/ConnectivityTable.hh"
+#include "Framework/Storage.hh"
+#include "Framework/Node.hh"
+#include "Framework/State.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Compute the signature of the topology of a distributed mesh, used to
+/// check that a solution file is read together with the mesh it was
+/// written from.
+/// Each element contributes a hash of the global IDs of its nodes and
+/// states and the contributions are summed over all the processors, each
+/// element being counted only by the processor owning its first state, so
+/// that the signature depends neither on the partitioning nor on the
+/// local numbering of the mesh, but only on its global connectivity.
+/// @param elemNode     element-node connectivity (local IDs)
+/// @param elemState    element-state connectivity (local IDs)
+/// @param nodes        local and ghost nodes
+/// @param states       local and ghost states
+/// @param totNbNodes   total number of nodes in the mesh
+/// @param totNbStates  total number of states in the mesh
+/// @param totNbElems   total number of elements in the mesh
+/// @param comm         communicator of the processors sharing the mesh
+Framework_API uint64_t computeMeshSignature
+(const Common::ConnectivityTable<CFuint>& elemNode,
+ const Common::ConnectivityTable<CFuint>& elemState,
+ DataHandle<Node*, GLOBAL> nodes,
+ DataHandle<State*, GLOBAL> states,
+ const CFuint totNbNodes,
+ const CFuint totNbStates,
+ const CFuint totNbElems,
+ MPI_Comm comm);
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Framework_MeshSignature_hh
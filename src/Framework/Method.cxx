@@ -13,6 +13,7 @@
 #include "Framework/NamespaceSwitcher.hh"
 #include "Framework/MethodData.hh"
 #include "Framework/SubSystemStatus.hh"
+#include "Framework/Profiler.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -147,7 +148,7 @@ void Method::setMethod()
   cf_assert(isConfigured());
   cf_assert(!isSetup());
 
-  pushNamespace();
+  pushNamespace("setMethod");
   
 
   // setup parent class
@@ -180,7 +181,7 @@ void Method::unsetMethod()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("unsetMethod");
   
   // unsetup derived classes
   this->unsetMethodImpl();
@@ -563,12 +564,18 @@ std::vector<Common::SafePtr<CommandGroup> > Method::getCommandGroups()
 
 //////////////////////////////////////////////////////////////////////////////
 
-void Method::pushNamespace()
+void Method::pushNamespace(const char* action)
 {
   CFAUTOTRACE;
   
   NamespaceSwitcher::getInstance(SubSystemStatusStack::getCurrentName()).
     pushNamespace(getNamespace());
+  
+  // each action of the method is profiled in the scope of the method
+  if (Profiler::isActive()) {
+    Profiler::getInstance().beginScope(getName());
+    Profiler::getInstance().beginScope(action);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -577,6 +584,11 @@ void Method::popNamespace()
 {
   CFAUTOTRACE;
 
+  if (Profiler::isActive()) {
+    Profiler::getInstance().endScope();
+    Profiler::getInstance().endScope();
+  }
+  
   SafePtr<Namespace> ptr = NamespaceSwitcher::getInstance
     (SubSystemStatusStack::getCurrentName()).popNamespace();
   cf_assert(ptr->getName() == getNamespace());
@@ -613,7 +625,7 @@ Method::getStrategyList() const
 
 void Method::executeCommands(const vector<std::string>& comNames)
 {
-  pushNamespace();
+  pushNamespace("executeCommands");
 
   vector< Common::SafePtr<NumericalCommand> > comList = getCommandList();
   for (CFuint i = 0; i < comNames.size(); ++i)
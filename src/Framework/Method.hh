@@ -166,7 +166,9 @@ protected: // helper functions
   resetup ( Common::Signal::arg_t input );
 
   /// Switch to the Namespace of this Method
-  void pushNamespace();
+  /// @param action name of the action of this Method being executed,
+  ///               under which it is profiled
+  void pushNamespace(const char* action);
 
   /// Switch back from the Namespace of this Method
   void popNamespace();
@@ -6,6 +6,7 @@
 
 #include "Framework/Node.hh"
 #include "Framework/PhysicalModel.hh"
+#include "Framework/EntityArena.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -69,6 +70,15 @@ Node::~Node()
 {
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+void Node::operator delete(void* ptr)
+{
+  if (!EntityArenaBase::release(ptr)) {
+    ::operator delete(ptr);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
   } // namespace Framework
@@ -49,6 +49,9 @@ public:
   /// Default destructor
   ~Node();
 
+  /// Deallocation, aware of the Nodes living in an EntityArena
+  static void operator delete(void* ptr);
+
   /// Copy Constructor: Constructs new Node with the inner state equal to inNode.
   /// @param inNode Node to be copied
   Node(const Node& inNode);
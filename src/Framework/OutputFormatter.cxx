@@ -150,7 +150,7 @@ void OutputFormatter::open()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("open");
 
   openImpl();
 
@@ -166,7 +166,7 @@ void OutputFormatter::write()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("write");
 
   writeImpl();
 
@@ -182,7 +182,7 @@ void OutputFormatter::close()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("close");
 
   closeImpl();
 
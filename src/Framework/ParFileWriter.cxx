@@ -207,6 +207,18 @@ void ParFileWriter::setNodeWriters(vector<int>& writerRanks)
   }
 }
     
+//////////////////////////////////////////////////////////////////////////////
+
+CFint ParFileWriter::getWriterRange(const vector<int>& writers) const
+{
+  if (_isWriterRank) {
+    for (CFuint i = 0; i < writers.size(); ++i) {
+      if (writers[i] == static_cast<int>(_myRank)) return static_cast<CFint>(i);
+    }
+  }
+  return -1;
+}
+    
 //////////////////////////////////////////////////////////////////////////////
 
   } // namespace Framework
@@ -50,6 +50,11 @@ public:
   /// Set _nbWritersPerNode writers per node
   void setNodeWriters(std::vector<int>& writerRanks);
   
+  /// Get the range of global IDs collected by this processor
+  /// @param writers  ranks of the writers of each range
+  /// @return the index of this processor in writers or -1 if it is not a writer
+  CFint getWriterRange(const std::vector<int>& writers) const;
+  
  protected: //data
   
   /// Class holding all offsets defining the parallel file structure
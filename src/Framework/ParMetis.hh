@@ -41,6 +41,14 @@ public:
   /// @param args the argument list to configure this object
   virtual void configure ( Config::ConfigArgs& args );
   
+  /// Append to the given array the ParMetis options
+  virtual void getSettings(std::vector<CFint>& settings) const
+  {
+    settings.push_back(IN_NCommonNodes_);
+    settings.push_back(IN_Options_);
+    settings.push_back(IN_RND_);
+  }
+  
 protected:
   
   std::vector<PartitionerData::IndexT> eptr;
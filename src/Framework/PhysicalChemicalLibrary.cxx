@@ -69,6 +69,61 @@ void PhysicalChemicalLibrary::configure ( Config::ConfigArgs& args )
   PhysicalPropertyLibrary::configure(args);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+std::auto_ptr<PhysicalChemicalLibrary::BlockWorkspace> 
+PhysicalChemicalLibrary::createBlockWorkspace()
+{
+  std::auto_ptr<BlockWorkspace> ws(new BlockWorkspace());
+  ws->ys.resize(_NS);
+  ws->rhoi.resize(_NS);
+  ws->omega.resize(_NS);
+  return ws;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void PhysicalChemicalLibrary::getMassProductionTermBlock(CFuint nbStates,
+							 CFuint nbTv,
+							 const CFreal* temp,
+							 const CFreal* tVec,
+							 const CFreal* rho,
+							 const CFreal* ys,
+							 CFreal* pressure,
+							 CFreal* omega,
+							 BlockWorkspace& ws)
+{
+  const CFuint nbSpecies = _NS;
+  cf_assert(ws.ys.size() == nbSpecies);
+  if (ws.tVec.size() != nbTv) {
+    ws.tVec.resize(nbTv);
+    ws.temps.resize(nbTv + 1);
+  }
+  
+  for (CFuint s = 0; s < nbStates; ++s) {
+    CFdouble T = temp[s];
+    CFdouble r = rho[s];
+    ws.temps[0] = T;
+    for (CFuint i = 0; i < nbTv; ++i) {
+      ws.tVec[i] = ws.temps[i+1] = tVec[i*nbStates + s];
+    }
+    for (CFuint i = 0; i < nbSpecies; ++i) {
+      ws.ys[i] = ys[i*nbStates + s];
+      ws.rhoi[i] = ws.ys[i]*r;
+    }
+    
+    setSpeciesFractions(ws.ys);
+    setState(&ws.rhoi[0], &ws.temps[0]);
+    CFdouble p = this->pressure(r, T, &ws.tVec[0]);
+    getMassProductionTerm(T, ws.tVec, p, r, ws.ys, false, ws.omega, ws.jacobian);
+    
+    pressure[s] = p;
+    for (CFuint i = 0; i < nbSpecies; ++i) {
+      omega[i*nbStates + s] = ws.omega[i];
+    }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
   
 } // namespace Framework
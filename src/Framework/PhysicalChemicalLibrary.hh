@@ -9,6 +9,8 @@
 
 //////////////////////////////////////////////////////////////////////////////
 
+#include <memory>
+
 #include "Framework/PhysicalPropertyLibrary.hh"
 #include "Common/NotImplementedException.hh"
 #include "MathTools/RealVector.hh"
@@ -83,7 +85,35 @@ public:
     RealVector dP_Bar;
 
   };
-
+  
+  /// Scratch data for the evaluation of a block of states.
+  /// Each thread evaluating blocks must use its own workspace.
+  class Framework_API BlockWorkspace {
+  public:
+    
+    BlockWorkspace(){}
+    
+    virtual ~BlockWorkspace(){}
+    
+    /// species mass fractions of one state
+    RealVector ys;
+    
+    /// species partial densities of one state
+    RealVector rhoi;
+    
+    /// temperatures of one state (translational first)
+    RealVector temps;
+    
+    /// vibrational temperatures of one state
+    RealVector tVec;
+    
+    /// mass production terms of one state
+    RealVector omega;
+    
+    /// unused Jacobian of the mass production terms
+    RealMatrix jacobian;
+  };
+  
   /// Defines the Config Option's of this class
   /// @param options a OptionList where to add the Option's
   static void defineConfigOptions(Config::OptionList& options);
@@ -522,6 +552,38 @@ public:
 				       RealVector* hsVib = CFNULL,
 				       RealVector* hsEl = CFNULL) = 0;
   
+  /// Create a workspace for the evaluation of blocks of states
+  /// @pre setup() has been called
+  virtual std::auto_ptr<BlockWorkspace> createBlockWorkspace();
+  
+  /// @return true if blocks of states can be evaluated concurrently
+  ///         by several threads, each one with its own workspace
+  virtual bool isBlockThreadSafe() const {return false;}
+  
+  /// Computes the pressure and the mass production terms [kg m^-3 s^-1]
+  /// for a block of states in structure-of-arrays layout: the i-th entry
+  /// of the state s is stored in [i*nbStates + s].
+  /// The default implementation loops over setState(), pressure() and
+  /// getMassProductionTerm(), so it modifies the state of the library.
+  /// @param nbStates the number of states in the block
+  /// @param nbTv     the number of vibrational temperatures per state
+  /// @param temp     the mixture temperatures
+  /// @param tVec     the vibrational temperatures
+  /// @param rho      the mixture densities
+  /// @param ys       the species mass fractions
+  /// @param pressure the mixture pressures (output)
+  /// @param omega    the mass production terms (output)
+  /// @param ws       the workspace created by createBlockWorkspace()
+  virtual void getMassProductionTermBlock(CFuint nbStates,
+					  CFuint nbTv,
+					  const CFreal* temp,
+					  const CFreal* tVec,
+					  const CFreal* rho,
+					  const CFreal* ys,
+					  CFreal* pressure,
+					  CFreal* omega,
+					  BlockWorkspace& ws);
+  
   /// Temperature of free electrons
   CFdouble getTe(CFdouble temp, CFreal* tVec)
   {
@@ -0,0 +1,320 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifdef CF_HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include "Common/PE.hh"
+#include "Common/CFLog.hh"
+#include "Common/StringOps.hh"
+#include "Environment/FileHandlerOutput.hh"
+#include "Environment/SingleBehaviorFactory.hh"
+#include "Framework/Profiler.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD::Common;
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// timings of a scope reduced across the processors
+struct ScopeStats {
+  CFreal min;
+  CFreal max;
+  CFreal sum;
+  CFuint nbCalls;
+  CFuint nbProcs;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+bool Profiler::m_isActive = false;
+
+//////////////////////////////////////////////////////////////////////////////
+
+Profiler& Profiler::getInstance()
+{
+  static Profiler aProfiler;
+  return aProfiler;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Profiler::Profiler() :
+  m_scopes(),
+  m_openScopes(),
+  m_startTimes(),
+  m_events(),
+  m_maxNbEvents(100000),
+  m_clock()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+Profiler::~Profiler()
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::setActive(bool isActive)
+{
+  m_isActive = isActive;
+
+  m_scopes.assign(1, Scope());
+  m_scopes[0].name = "Total";
+  m_scopes[0].parent = 0;
+  m_scopes[0].time = 0.;
+  m_scopes[0].nbCalls = 1;
+  m_openScopes.assign(1, 0);
+  m_startTimes.assign(1, 0.);
+  m_events.clear();
+
+  m_clock.reset();
+  if (m_isActive) {
+    m_clock.start();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::beginScope(const char* name)
+{
+  if (!m_isActive) return;
+
+  const CFuint parent = m_openScopes.back();
+  CFuint scopeID = m_scopes.size();
+  const vector<CFuint>& children = m_scopes[parent].children;
+  for (CFuint i = 0; i < children.size(); ++i) {
+    if (m_scopes[children[i]].name == name) {
+      scopeID = children[i];
+      break;
+    }
+  }
+
+  if (scopeID == m_scopes.size()) {
+    Scope scope;
+    scope.name = name;
+    scope.parent = parent;
+    scope.time = 0.;
+    scope.nbCalls = 0;
+    m_scopes.push_back(scope);
+    m_scopes[parent].children.push_back(scopeID);
+  }
+
+  m_openScopes.push_back(scopeID);
+  m_startTimes.push_back(m_clock.read());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::endScope()
+{
+  // an exception may have skipped the end of some scopes
+  if (!m_isActive || m_openScopes.size() < 2) return;
+
+  const CFuint scopeID = m_openScopes.back();
+  const CFreal start = m_startTimes.back();
+  const CFreal duration = m_clock.read() - start;
+  m_openScopes.pop_back();
+  m_startTimes.pop_back();
+
+  m_scopes[scopeID].time += duration;
+  ++m_scopes[scopeID].nbCalls;
+
+  if (m_events.size() < m_maxNbEvents) {
+    Event event;
+    event.scope = scopeID;
+    event.start = start;
+    event.duration = duration;
+    m_events.push_back(event);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+string Profiler::getPath(CFuint scopeID) const
+{
+  string path = m_scopes[scopeID].name;
+  for (CFuint id = scopeID; id != 0; ) {
+    id = m_scopes[id].parent;
+    if (id != 0) {
+      path = m_scopes[id].name + "/" + path;
+    }
+  }
+  return path;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::writeReport(const boost::filesystem::path& prefix)
+{
+  if (!m_isActive) return;
+
+  m_scopes[0].time = m_clock.read();
+
+  // scopes of this processor listed depth first, one per line
+  ostringstream local;
+  vector<CFuint> toVisit(1, 0);
+  while (!toVisit.empty()) {
+    const CFuint id = toVisit.back();
+    toVisit.pop_back();
+    const Scope& scope = m_scopes[id];
+    local << ((id == 0) ? scope.name : getPath(id)) << "\t"
+	  << setprecision(12) << scope.time << "\t" << scope.nbCalls << "\n";
+    for (CFuint i = scope.children.size(); i > 0; --i) {
+      toVisit.push_back(scope.children[i-1]);
+    }
+  }
+  const string localStr = local.str();
+
+  CFuint rank = 0;
+  CFuint nbProcs = 1;
+  string allStr = localStr;
+  vector<int> sizes(1, localStr.size());
+
+#ifdef CF_HAVE_MPI
+  if (PE::GetPE().IsParallel()) {
+    MPI_Comm comm = PE::GetPE().GetCommunicator("Default");
+    rank = PE::GetPE().GetRank("Default");
+    nbProcs = PE::GetPE().GetProcessorCount("Default");
+
+    int localSize = localStr.size();
+    sizes.resize(nbProcs);
+    MPI_Gather(&localSize, 1, MPI_INT, &sizes[0], 1, MPI_INT, 0, comm);
+
+    vector<int> displs(nbProcs, 0);
+    for (CFuint p = 1; p < nbProcs; ++p) {
+      displs[p] = displs[p-1] + sizes[p-1];
+    }
+    vector<char> recvBuf((rank == 0) ? displs[nbProcs-1] + sizes[nbProcs-1] + 1 : 1);
+    MPI_Gatherv(const_cast<char*>(localStr.c_str()), localSize, MPI_CHAR,
+		&recvBuf[0], &sizes[0], &displs[0], MPI_CHAR, 0, comm);
+    if (rank == 0) {
+      allStr.assign(&recvBuf[0], recvBuf.size() - 1);
+    }
+  }
+#endif
+
+  // each processor writes its own timeline
+  writeTrace(prefix.string() + "-trace-P" + StringOps::to_str(rank) + ".json", rank);
+
+  if (rank != 0) return;
+
+  // reduce the timings of each scope across the processors,
+  // keeping the order in which the scopes are first found
+  vector<string> paths;
+  map<string, ScopeStats> stats;
+
+  istringstream in(allStr);
+  string line;
+  while (getline(in, line)) {
+    const size_t tab1 = line.find('\t');
+    const size_t tab2 = line.find('\t', tab1 + 1);
+    if (tab1 == string::npos || tab2 == string::npos) continue;
+    const string path = line.substr(0, tab1);
+    const CFreal time = StringOps::from_str<CFreal>(line.substr(tab1 + 1, tab2 - tab1 - 1));
+    const CFuint nbCalls = StringOps::from_str<CFuint>(line.substr(tab2 + 1));
+
+    map<string, ScopeStats>::iterator it = stats.find(path);
+    if (it == stats.end()) {
+      ScopeStats s;
+      s.min = s.max = s.sum = time;
+      s.nbCalls = nbCalls;
+      s.nbProcs = 1;
+      stats[path] = s;
+      paths.push_back(path);
+    }
+    else {
+      ScopeStats& s = it->second;
+      s.min = std::min(s.min, time);
+      s.max = std::max(s.max, time);
+      s.sum += time;
+      s.nbCalls = std::max(s.nbCalls, nbCalls);
+      ++s.nbProcs;
+    }
+  }
+
+  Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  const boost::filesystem::path tablePath(prefix.string() + ".txt");
+  ofstream& fout = fhandle->open(tablePath);
+
+  fout << "# wall time per scope over " << nbProcs << " processors [s]\n";
+  fout << "# imbalance = max/avg, procs = number of processors entering the scope\n";
+  fout << left << setw(60) << "# scope" << right
+       << setw(12) << "calls" << setw(14) << "min" << setw(14) << "avg"
+       << setw(14) << "max" << setw(11) << "imbalance" << setw(7) << "procs" << "\n";
+
+  for (CFuint i = 0; i < paths.size(); ++i) {
+    const ScopeStats& s = stats[paths[i]];
+    const CFuint depth = std::count(paths[i].begin(), paths[i].end(), '/') + (i > 0 ? 1 : 0);
+    const size_t slash = paths[i].rfind('/');
+    const string name = string(2*depth, ' ') +
+      ((slash == string::npos) ? paths[i] : paths[i].substr(slash + 1));
+    const CFreal avg = s.sum/s.nbProcs;
+
+    fout << left << setw(60) << name << right << setw(12) << s.nbCalls
+	 << fixed << setprecision(4)
+	 << setw(14) << s.min << setw(14) << avg << setw(14) << s.max
+	 << setprecision(2) << setw(11) << ((avg > 0.) ? s.max/avg : 1.)
+	 << setw(7) << s.nbProcs << "\n";
+  }
+
+  fhandle->close();
+
+  CFLog(INFO, "Profiler: timings written to " << tablePath.string() << "\n");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void Profiler::writeTrace(const boost::filesystem::path& filepath, CFuint rank) const
+{
+  Common::SelfRegistPtr<Environment::FileHandlerOutput> fhandle =
+    Environment::SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance().create();
+  ofstream& fout = fhandle->open(filepath);
+
+  // Chrome trace event format, with complete events in microseconds
+  fout << "{\"traceEvents\":[\n";
+  for (CFuint i = 0; i < m_events.size(); ++i) {
+    const Event& event = m_events[i];
+    fout << "{\"name\":\"" << m_scopes[event.scope].name
+	 << "\",\"cat\":\"" << getPath(m_scopes[event.scope].parent)
+	 << "\",\"ph\":\"X\",\"pid\":" << rank << ",\"tid\":0"
+	 << ",\"ts\":" << fixed << setprecision(1) << event.start*1e6
+	 << ",\"dur\":" << event.duration*1e6 << "}"
+	 << ((i + 1 < m_events.size()) ? ",\n" : "\n");
+  }
+  fout << "],\"displayTimeUnit\":\"ms\"}\n";
+
+  fhandle->close();
+
+  if (m_events.size() == m_maxNbEvents) {
+    CFLog(WARN, "Profiler: the timeline is truncated to the first " << m_maxNbEvents << " events\n");
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,170 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_Framework_Profiler_hh
+#define COOLFluiD_Framework_Profiler_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+
+#include "Common/NonCopyable.hh"
+#include "Common/Stopwatch.hh"
+#include "Framework/Framework.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Framework {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a singleton object collecting the wall time spent
+/// in nested scopes (method actions, commands, parallel synchronizations).
+/// Scopes with the same name and the same parent are accumulated together.
+/// When inactive, opening a scope costs only the test of a flag.
+/// At the end of the run the timings are reduced across all the processors
+/// into a table with the min/avg/max time of each scope, which shows the load
+/// imbalance between the partitions, and each processor writes the timeline
+/// of its scopes in the Chrome trace (JSON) format.
+class Framework_API Profiler : public Common::NonCopyable<Profiler> {
+public:
+
+  /// @return the instance of this singleton
+  static Profiler& getInstance();
+
+  /// @return true if the profiling is active
+  static bool isActive() {return m_isActive;}
+
+  /// Activate or deactivate the profiling, discarding the collected data
+  void setActive(bool isActive);
+
+  /// Set the maximum number of events kept for the timeline
+  void setMaxNbTraceEvents(CFuint maxNbEvents) {m_maxNbEvents = maxNbEvents;}
+
+  /// Open a scope nested in the current one
+  void beginScope(const char* name);
+
+  /// Open a scope nested in the current one
+  void beginScope(const std::string& name) {beginScope(name.c_str());}
+
+  /// Close the current scope
+  void endScope();
+
+  /// Write the summary table reduced across the processors and the timeline
+  /// of this processor. This is a collective operation.
+  /// @param prefix  path of the files, without extension
+  void writeReport(const boost::filesystem::path& prefix);
+
+private:
+
+  /// Constructor
+  Profiler();
+
+  /// Destructor
+  ~Profiler();
+
+  /// Get the full name of a scope, with the names of its parents
+  std::string getPath(CFuint scopeID) const;
+
+  /// Write the timeline of this processor
+  void writeTrace(const boost::filesystem::path& filepath, CFuint rank) const;
+
+private:
+
+  /// node of the tree of scopes
+  struct Scope {
+    std::string name;
+    CFuint parent;
+    std::vector<CFuint> children;
+    CFreal time;
+    CFuint nbCalls;
+  };
+
+  /// closed scope in the timeline
+  struct Event {
+    CFuint scope;
+    CFreal start;
+    CFreal duration;
+  };
+
+  /// flag telling if the profiling is active
+  static bool m_isActive;
+
+  /// tree of the scopes, the first one being the root
+  std::vector<Scope> m_scopes;
+
+  /// IDs of the open scopes
+  std::vector<CFuint> m_openScopes;
+
+  /// starting times of the open scopes
+  std::vector<CFreal> m_startTimes;
+
+  /// timeline of the closed scopes
+  std::vector<Event> m_events;
+
+  /// maximum number of events in the timeline
+  CFuint m_maxNbEvents;
+
+  /// clock started with the profiling
+  Common::Stopwatch<Common::WallTime> m_clock;
+
+}; // class Profiler
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Scoped timer for the Profiler, use it through the CFPROFILE macro
+class ProfileScope {
+public:
+
+  /// Constructor
+  ProfileScope() : m_isActive(false) {}
+
+  /// Open the scope
+  template <typename NAME>
+  void begin(const NAME& name)
+  {
+    Profiler::getInstance().beginScope(name);
+    m_isActive = true;
+  }
+
+  /// Destructor closes the scope
+  ~ProfileScope()
+  {
+    if (m_isActive) Profiler::getInstance().endScope();
+  }
+
+private:
+
+  /// flag telling if the scope has been opened
+  bool m_isActive;
+
+}; // class ProfileScope
+
+//////////////////////////////////////////////////////////////////////////////
+
+#define CF_PROFILE_JOIN2(a,b) a##b
+#define CF_PROFILE_JOIN(a,b) CF_PROFILE_JOIN2(a,b)
+
+/// Profile the rest of the enclosing block under the given name.
+/// The name is evaluated only if the profiling is active.
+#define CFPROFILE(name) \
+  COOLFluiD::Framework::ProfileScope CF_PROFILE_JOIN(cf_profile_scope_,__LINE__); \
+  if (COOLFluiD::Framework::Profiler::isActive()) \
+    CF_PROFILE_JOIN(cf_profile_scope_,__LINE__).begin(name)
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Framework
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_Framework_Profiler_hh
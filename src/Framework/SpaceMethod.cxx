@@ -132,7 +132,7 @@ void SpaceMethod::initializeSolution()
   cf_assert(isConfigured());
   cf_assert(isSetup());
   
-  pushNamespace();
+  pushNamespace("initializeSolution");
   
   getSpaceMethodData()->setIsRestart(m_restart); 
   initializeSolutionImpl(m_restart);
@@ -151,7 +151,7 @@ void SpaceMethod::prepareComputation()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("prepareComputation");
 
   prepareComputationImpl();
 
@@ -167,7 +167,7 @@ void SpaceMethod::computeSpaceResidual(CFreal factor)
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("computeSpaceResidual");
 
   computeSpaceResidualImpl(factor);
 
@@ -183,7 +183,7 @@ void SpaceMethod::computeTimeResidual(CFreal factor)
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("computeTimeResidual");
 
   computeTimeResidualImpl(factor);
 
@@ -199,7 +199,7 @@ void SpaceMethod::applyBC()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("applyBC");
 
   applyBCImpl();
 
@@ -215,7 +215,7 @@ void SpaceMethod::postProcessSolution()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("postProcessSolution");
 
   postProcessSolutionImpl();
 
@@ -231,7 +231,7 @@ void SpaceMethod::preProcessSolution()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("preProcessSolution");
   
   preProcessSolutionImpl();
   
@@ -279,7 +279,7 @@ void SpaceMethod::computeSpaceRhsForStatesSet(CFreal factor)
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("computeSpaceRhsForStatesSet");
 
   computeSpaceRhsForStatesSetImpl(factor);
 
@@ -295,7 +295,7 @@ void SpaceMethod::computeTimeRhsForStatesSet(CFreal factor)
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("computeTimeRhsForStatesSet");
 
   computeTimeRhsForStatesSetImpl(factor);
 
@@ -311,7 +311,7 @@ void SpaceMethod::extrapolateStatesToNodes()
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("extrapolateStatesToNodes");
 
   extrapolateStatesToNodesImpl();
 
@@ -388,7 +388,7 @@ Common::Signal::return_t SpaceMethod::beforeMeshUpdateAction(Common::Signal::arg
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("beforeMeshUpdateAction");
 
   Common::Signal::return_t ret = beforeMeshUpdateActionImpl(eBefore);
 
@@ -406,7 +406,7 @@ Common::Signal::return_t SpaceMethod::afterMeshUpdateAction(Common::Signal::arg_
   cf_assert(isConfigured());
   cf_assert(isSetup());
 
-  pushNamespace();
+  pushNamespace("afterMeshUpdateAction");
 
   Common::Signal::return_t ret = afterMeshUpdateActionImpl(eAfter);
 
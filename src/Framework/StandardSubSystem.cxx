@@ -44,6 +44,8 @@
 #include "Framework/Namespace.hh"
 #include "Framework/Framework.hh"
 #include "Framework/SimulationStatus.hh"
+#include "Framework/AsyncFileWriter.hh"
+#include "Framework/Profiler.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -95,6 +97,10 @@ void StandardSubSystem::defineConfigOptions(Config::OptionList& options)
    options.addConfigOption< CFreal >("InitialTime","Initial Physical Time of the SubSystem.");
    options.addConfigOption< int, Config::DynamicOption<> >("StopSimulation","Flag to force an immediate stop of the simulation.");
    options.addConfigOption< string >("StopConditionSubSystemStatus","Subsystem status corresponding to the stop condition to apply."); 
+   options.addConfigOption< bool >("AsyncOutput","Write the output files from memory on a background thread, overlapping with the solver.");
+   options.addConfigOption< bool >("Profiling","Time the method actions, commands and parallel synchronizations and write a report at the end of the run.");
+   options.addConfigOption< string >("ProfilingFile","Prefix of the profiling report files in the results directory.");
+   options.addConfigOption< CFuint >("ProfilingMaxTraceEvents","Maximum number of events in the profiling timeline of each processor.");
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -162,6 +168,18 @@ StandardSubSystem::StandardSubSystem(const std::string& name)
 
   m_forcedStop = 0;
   setParameter("StopSimulation",&m_forcedStop);
+  
+  m_asyncOutput = false;
+  setParameter("AsyncOutput",&m_asyncOutput);
+  
+  m_profiling = false;
+  setParameter("Profiling",&m_profiling);
+  
+  m_profilingFile = "profile";
+  setParameter("ProfilingFile",&m_profilingFile);
+  
+  m_profilingMaxTraceEvents = 100000;
+  setParameter("ProfilingMaxTraceEvents",&m_profilingMaxTraceEvents);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -181,6 +199,12 @@ void StandardSubSystem::configure ( Config::ConfigArgs& args )
   
   SubSystem::configure(args);
   
+  // the profiling starts here to include the setup of the methods
+  if (m_profiling) {
+    Profiler::getInstance().setMaxNbTraceEvents(m_profilingMaxTraceEvents);
+    Profiler::getInstance().setActive(true);
+  }
+  
   // set the physical model
   configurePhysicalModel(args);
   
@@ -688,6 +712,8 @@ void StandardSubSystem::run()
   
   for ( ; iterate(currSSS); ) {
     
+    CFPROFILE("Iteration");
+    
     // read the interactive parameters
     runSerial<void, InteractiveParamReader, &InteractiveParamReader::readFile>
       (&*getInteractiveParamReader(), ssGroupName, false);
@@ -761,6 +787,11 @@ void StandardSubSystem::run()
   
   CFLog(NOTICE, "SubSystem WallTime: " << stopTimer << "s\n");
   m_duration = subSysStatusVec[0]->readWatchHMS();
+  
+  if (Profiler::isActive()) {
+    Profiler::getInstance().writeReport
+      (Environment::DirPaths::getInstance().getResultsDir() / m_profilingFile);
+  }
  
   // dumpStates();
 }
@@ -806,6 +837,11 @@ void StandardSubSystem::unsetup()
   bool force = true;
   writeSolution(force);
   
+  if (m_asyncOutput) {
+    const CFreal waitTime = AsyncFileWriter::getInstance().wait();
+    CFLog(INFO, "Waited " << waitTime << "s for the background writing of the output files\n");
+  }
+  
   CFLog(VERBOSE, "StandardSubSystem::unsetup() => OutputFormatter\n");
   // unset all the methods
   m_outputFormat.apply
@@ -984,7 +1020,13 @@ void StandardSubSystem::setCollaborators()
 void StandardSubSystem::writeSolution(const bool force_write )
 {
   CFAUTOTRACE;
-
+  
+  CFPROFILE("WriteSolution");
+  
+  // files are formatted in memory and written in background: the solver 
+  // only waits once for the end of the previous writing of all the formats
+  bool asyncWriterIdle = !m_asyncOutput;
+  
   const int rank = Common::PE::GetPE().GetRank("Default");
   for (CFuint i = 0; i < m_outputFormat.size(); ++i)
   {
@@ -995,13 +1037,43 @@ void StandardSubSystem::writeSolution(const bool force_write )
       {
         Stopwatch<WallTime> stopTimer;
         stopTimer.start();
+	
+	SingleBehaviorFactory<Environment::FileHandlerOutput>& fileFactory = 
+	  SingleBehaviorFactory<Environment::FileHandlerOutput>::getInstance();
+	const string defaultFileHandler = fileFactory.getDefaultBehavior();
+	if (m_asyncOutput) {
+	  if (!asyncWriterIdle) {
+	    AsyncFileWriter::getInstance().wait();
+	    asyncWriterIdle = true;
+	  }
+	  AsyncFileWriter::getInstance().setOwner(m_outputFormat[i]->getName());
+	  fileFactory.setDefaultBehavior("AsyncFileWrite");
+	}
+	
         CFLog(VERBOSE, "StandardSubSystem::writeSolution() => output from [" << m_outputFormat[i]->getName() << "] START\n");
-        m_outputFormat[i]->open ();
-        m_outputFormat[i]->write();
-        m_outputFormat[i]->close();
+	try {
+	  m_outputFormat[i]->open ();
+	  m_outputFormat[i]->write();
+	  m_outputFormat[i]->close();
+	}
+	catch (...) {
+	  // the other file handlers must not write in background
+	  fileFactory.setDefaultBehavior(defaultFileHandler);
+	  throw;
+	}
         CFLog(VERBOSE, "StandardSubSystem::writeSolution() => output from [" << m_outputFormat[i]->getName() << "] END\n");
         stopTimer.stop();
-        CFLog(INFO, "Writing took " << stopTimer << "s\n");
+	
+	if (m_asyncOutput) {
+	  fileFactory.setDefaultBehavior(defaultFileHandler);
+	  CFLog(INFO, "Writing [" << m_outputFormat[i]->getName() << "] took " << stopTimer 
+		<< "s exposed, previous writing took " 
+		<< AsyncFileWriter::getInstance().popWriteTime(m_outputFormat[i]->getName()) 
+		<< "s overlapped\n");
+	}
+	else {
+	  CFLog(INFO, "Writing took " << stopTimer << "s\n");
+	}
       }
     }
   }
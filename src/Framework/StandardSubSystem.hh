@@ -209,6 +209,18 @@ protected: // functions
 
   ///flag to force stopping the run()
   int m_forcedStop;
+  
+  /// flag telling to write the output files in background
+  bool m_asyncOutput;
+  
+  /// flag telling to profile the run
+  bool m_profiling;
+  
+  /// prefix of the profiling report files
+  std::string m_profilingFile;
+  
+  /// maximum number of events in the profiling timeline
+  CFuint m_profilingMaxTraceEvents;
 
 }; // class StandardSubSystem
 
@@ -6,6 +6,7 @@
 
 #include "Framework/State.hh"
 #include "Framework/PhysicalModel.hh"
+#include "Framework/EntityArena.hh"
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -88,6 +89,15 @@ State::~State()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void State::operator delete(void* ptr)
+{
+  if (!EntityArenaBase::release(ptr)) {
+    ::operator delete(ptr);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 bool State::isValid() const
 {
   return PhysicalModelStack::getActive()->validate(*this);
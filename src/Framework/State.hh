@@ -47,6 +47,9 @@ public:
   /// Destructor
   ~State();
 
+  /// Deallocation, aware of the States living in an EntityArena
+  static void operator delete(void* ptr);
+
   /// Copy Constructor: Constructs new State with the inner state equal to inState.
   /// @param inNode Node to be copied
   State(const State& inState);
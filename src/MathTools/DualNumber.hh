@@ -0,0 +1,317 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_MathTools_DualNumber_hh
+#define COOLFluiD_MathTools_DualNumber_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "Common/COOLFluiD.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace MathTools {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class represents a dual number for forward-mode automatic
+/// differentiation: a value together with its derivatives with respect to
+/// N independent variables. Evaluating a function written for a generic
+/// scalar type with DualNumber arguments gives the value of the function and
+/// N columns of its jacobian in a single pass.
+/// Comparisons only involve the values, so that the derivative of a
+/// non-smooth function (abs, max, min) is the one of the active branch.
+template <int N>
+class DualNumber {
+public:
+
+  /// Default constructor (value and derivatives set to zero)
+  DualNumber() : m_val(0.)
+  {
+    for (int i = 0; i < N; ++i) m_der[i] = 0.;
+  }
+
+  /// Constructor of a constant
+  DualNumber(CFreal val) : m_val(val)
+  {
+    for (int i = 0; i < N; ++i) m_der[i] = 0.;
+  }
+
+  /// Constructor of the independent variable iVar
+  DualNumber(CFreal val, CFuint iVar) : m_val(val)
+  {
+    cf_assert(iVar < static_cast<CFuint>(N));
+    for (int i = 0; i < N; ++i) m_der[i] = 0.;
+    m_der[iVar] = 1.;
+  }
+
+  /// @return the value
+  CFreal value() const {return m_val;}
+
+  /// @return the derivative with respect to the i-th variable
+  CFreal der(CFuint i) const {return m_der[i];}
+
+  /// @return the derivative with respect to the i-th variable
+  CFreal& der(CFuint i) {return m_der[i];}
+
+  /// Assignment of a constant
+  DualNumber& operator= (CFreal val)
+  {
+    m_val = val;
+    for (int i = 0; i < N; ++i) m_der[i] = 0.;
+    return *this;
+  }
+
+  DualNumber& operator+= (const DualNumber& b)
+  {
+    m_val += b.m_val;
+    for (int i = 0; i < N; ++i) m_der[i] += b.m_der[i];
+    return *this;
+  }
+
+  DualNumber& operator-= (const DualNumber& b)
+  {
+    m_val -= b.m_val;
+    for (int i = 0; i < N; ++i) m_der[i] -= b.m_der[i];
+    return *this;
+  }
+
+  DualNumber& operator*= (const DualNumber& b)
+  {
+    for (int i = 0; i < N; ++i) m_der[i] = m_der[i]*b.m_val + m_val*b.m_der[i];
+    m_val *= b.m_val;
+    return *this;
+  }
+
+  DualNumber& operator/= (const DualNumber& b)
+  {
+    // same value as the division of two reals
+    const CFreal ovB = 1./b.m_val;
+    m_val /= b.m_val;
+    for (int i = 0; i < N; ++i) m_der[i] = (m_der[i] - m_val*b.m_der[i])*ovB;
+    return *this;
+  }
+
+  DualNumber& operator+= (CFreal b) {m_val += b; return *this;}
+
+  DualNumber& operator-= (CFreal b) {m_val -= b; return *this;}
+
+  DualNumber& operator*= (CFreal b)
+  {
+    m_val *= b;
+    for (int i = 0; i < N; ++i) m_der[i] *= b;
+    return *this;
+  }
+
+  DualNumber& operator/= (CFreal b)
+  {
+    const CFreal ovB = 1./b;
+    m_val /= b;
+    for (int i = 0; i < N; ++i) m_der[i] *= ovB;
+    return *this;
+  }
+
+  /// @return a dual number with the given value and the derivatives of
+  ///         this one multiplied by the given factor (chain rule)
+  DualNumber chain(CFreal val, CFreal dfdx) const
+  {
+    DualNumber r(val);
+    for (int i = 0; i < N; ++i) r.m_der[i] = dfdx*m_der[i];
+    return r;
+  }
+
+private:
+
+  /// value
+  CFreal m_val;
+
+  /// derivatives
+  CFreal m_der[N];
+
+}; // end of class DualNumber
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <int N>
+inline DualNumber<N> operator- (const DualNumber<N>& a)
+{
+  return a.chain(-a.value(), -1.);
+}
+
+template <int N>
+inline DualNumber<N> operator+ (const DualNumber<N>& a, const DualNumber<N>& b)
+{
+  DualNumber<N> r(a); return r += b;
+}
+
+template <int N>
+inline DualNumber<N> operator- (const DualNumber<N>& a, const DualNumber<N>& b)
+{
+  DualNumber<N> r(a); return r -= b;
+}
+
+template <int N>
+inline DualNumber<N> operator* (const DualNumber<N>& a, const DualNumber<N>& b)
+{
+  DualNumber<N> r(a); return r *= b;
+}
+
+template <int N>
+inline DualNumber<N> operator/ (const DualNumber<N>& a, const DualNumber<N>& b)
+{
+  DualNumber<N> r(a); return r /= b;
+}
+
+template <int N>
+inline DualNumber<N> operator+ (const DualNumber<N>& a, CFreal b)
+{
+  DualNumber<N> r(a); return r += b;
+}
+
+template <int N>
+inline DualNumber<N> operator+ (CFreal a, const DualNumber<N>& b)
+{
+  DualNumber<N> r(b); return r += a;
+}
+
+template <int N>
+inline DualNumber<N> operator- (const DualNumber<N>& a, CFreal b)
+{
+  DualNumber<N> r(a); return r -= b;
+}
+
+template <int N>
+inline DualNumber<N> operator- (CFreal a, const DualNumber<N>& b)
+{
+  return b.chain(a - b.value(), -1.);
+}
+
+template <int N>
+inline DualNumber<N> operator* (const DualNumber<N>& a, CFreal b)
+{
+  DualNumber<N> r(a); return r *= b;
+}
+
+template <int N>
+inline DualNumber<N> operator* (CFreal a, const DualNumber<N>& b)
+{
+  DualNumber<N> r(b); return r *= a;
+}
+
+template <int N>
+inline DualNumber<N> operator/ (const DualNumber<N>& a, CFreal b)
+{
+  DualNumber<N> r(a); return r /= b;
+}
+
+template <int N>
+inline DualNumber<N> operator/ (CFreal a, const DualNumber<N>& b)
+{
+  const CFreal val = a/b.value();
+  return b.chain(val, -val/b.value());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+#define CF_DUALNUMBER_COMPARISON(OP)					\
+template <int N>							\
+inline bool operator OP (const DualNumber<N>& a, const DualNumber<N>& b) \
+{ return a.value() OP b.value(); }					\
+template <int N>							\
+inline bool operator OP (const DualNumber<N>& a, CFreal b)		\
+{ return a.value() OP b; }						\
+template <int N>							\
+inline bool operator OP (CFreal a, const DualNumber<N>& b)		\
+{ return a OP b.value(); }
+
+CF_DUALNUMBER_COMPARISON(<)
+CF_DUALNUMBER_COMPARISON(>)
+CF_DUALNUMBER_COMPARISON(<=)
+CF_DUALNUMBER_COMPARISON(>=)
+CF_DUALNUMBER_COMPARISON(==)
+CF_DUALNUMBER_COMPARISON(!=)
+
+#undef CF_DUALNUMBER_COMPARISON
+
+//////////////////////////////////////////////////////////////////////////////
+
+template <int N>
+inline DualNumber<N> sqrt(const DualNumber<N>& a)
+{
+  const CFreal val = std::sqrt(a.value());
+  return a.chain(val, 0.5/val);
+}
+
+template <int N>
+inline DualNumber<N> exp(const DualNumber<N>& a)
+{
+  const CFreal val = std::exp(a.value());
+  return a.chain(val, val);
+}
+
+template <int N>
+inline DualNumber<N> log(const DualNumber<N>& a)
+{
+  return a.chain(std::log(a.value()), 1./a.value());
+}
+
+template <int N>
+inline DualNumber<N> pow(const DualNumber<N>& a, CFreal b)
+{
+  const CFreal val = std::pow(a.value(), b);
+  return a.chain(val, b*std::pow(a.value(), b - 1.));
+}
+
+template <int N>
+inline DualNumber<N> abs(const DualNumber<N>& a)
+{
+  return (a.value() < 0.) ? -a : a;
+}
+
+template <int N>
+inline DualNumber<N> max(const DualNumber<N>& a, const DualNumber<N>& b)
+{
+  return (a.value() < b.value()) ? b : a;
+}
+
+template <int N>
+inline DualNumber<N> min(const DualNumber<N>& a, const DualNumber<N>& b)
+{
+  return (b.value() < a.value()) ? b : a;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// @return the value of a real number or of a dual number
+inline CFreal getValue(CFreal a) {return a;}
+
+template <int N>
+inline CFreal getValue(const DualNumber<N>& a) {return a.value();}
+
+/// @return the value f(a) of a function computed outside (e.g. by a
+///         thermodynamic library), with the derivative df/da given by the
+///         caller for the dual number
+inline CFreal chain(CFreal a, CFreal val, CFreal dfda) {return val;}
+
+template <int N>
+inline DualNumber<N> chain(const DualNumber<N>& a, CFreal val, CFreal dfda)
+{
+  return a.chain(val, dfda);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace MathTools
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_MathTools_DualNumber_hh
@@ -9,6 +9,7 @@
 #include <fstream>
 #include <string>
 #include <cstdlib>
+#include <algorithm>
 
 #include "Common/ConnectivityTable.hh"
 #include "Common/SwapEmpty.hh"
@@ -328,6 +329,56 @@ void RCM::transformCellNode2NodeNode ( const ConnectivityTable<CFuint>& cellnode
 
 /////////////////////////////////////////////////////////////////////////////
 
+void RCM::computeOrdering (const ConnectivityTable<CFuint>& nodenode,
+			   std::vector<CFuint>& newToOld)
+{
+  const CFuint nnodes = nodenode.nbRows();
+  newToOld.clear();
+  newToOld.reserve(nnodes);
+  
+  // nodes sorted by increasing degree, to pick the starting node of each component
+  vector<pair<CFuint,CFuint> > degreeNode(nnodes);
+  for (CFuint i = 0; i < nnodes; ++i) {
+    degreeNode[i] = pair<CFuint,CFuint>(nodenode.nbCols(i), i);
+  }
+  std::sort(degreeNode.begin(), degreeNode.end());
+
+  vector<bool> flag(nnodes, false);
+  vector<pair<CFuint,CFuint> > neighbors;
+  CFuint readcount = 0;
+  for (CFuint is = 0; is < nnodes; ++is) {
+    const CFuint start = degreeNode[is].second;
+    if (flag[start]) continue;
+    
+    // breadth first visit of the component, adding the neighbors
+    // of each node by increasing degree (Cuthill-McKee)
+    flag[start] = true;
+    newToOld.push_back(start);
+    for (; readcount < newToOld.size(); ++readcount) {
+      const CFuint n = newToOld[readcount];
+      const CFuint nneig = nodenode.nbCols(n);
+      neighbors.clear();
+      for (CFuint j = 0; j < nneig; ++j) {
+	const CFuint nj = nodenode(n,j);
+	if (!flag[nj]) {
+	  flag[nj] = true;
+	  neighbors.push_back(pair<CFuint,CFuint>(nodenode.nbCols(nj), nj));
+	}
+      }
+      std::sort(neighbors.begin(), neighbors.end());
+      for (CFuint j = 0; j < neighbors.size(); ++j) {
+	newToOld.push_back(neighbors[j].second);
+      }
+    }
+  }
+  cf_assert(newToOld.size() == nnodes);
+  
+  // reverse the Cuthill-McKee ordering
+  std::reverse(newToOld.begin(), newToOld.end());
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
 int RCM::read_input ( const std::string& filename, ConnectivityTable<CFuint>& cellnode )
 {
   CFuint nb_elems;
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "Common/ConnectivityTable.hh"
 #include "MathTools/MathTools.hh"
@@ -29,6 +30,13 @@ class MathTools_API RCM
 			std::valarray<CFuint>& new_id,
 			const bool useMedianDual);
   
+  /// Computes the Reverse Cuthill-McKee ordering of the graph given by its
+  /// node to node connectivity. Each connected component is numbered in turn,
+  /// starting from a node of minimum degree.
+  /// @param newToOld is filled with the old id of each node in the new order
+  static void computeOrdering (const Common::ConnectivityTable<CFuint>& nodenode,
+			       std::vector<CFuint>& newToOld);
+  
   /// reads the a cell to node connectivity from the file
   static int read_input (const std::string& filename, 
 			 Common::ConnectivityTable<CFuint>& cellnode);
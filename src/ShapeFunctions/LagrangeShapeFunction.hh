@@ -13,6 +13,7 @@
 #include "Common/NotImplementedException.hh"
 
 #include "MathTools/RealVector.hh"
+#include "MathTools/RealMatrix.hh"
 
 #include "Framework/Node.hh"
 #include "Framework/FaceJacobiansDeterminant.hh"
@@ -46,6 +47,16 @@ public:
                                  const std::vector<RealVector>& nodalSF,
                                        std::vector<T*>& values);
 
+  /// Compute the gradients of the shape functions with respect to the
+  /// mapped coordinates, (node, mapped coordinate) in each matrix.
+  /// Shape functions providing them hide this function.
+  /// @return false, these gradients are not provided
+  static bool computeMappedGradients(const std::vector<RealVector>& mappedCoord,
+                                     std::vector<RealMatrix>& mappedGrad)
+  {
+    return false;
+  }
+
 protected:
 
   /// Default constructor without arguments
@@ -207,7 +207,8 @@ void LagrangeShapeFunctionHexaP1::computeGradientStates(
          const std::vector<RealVector>& mappedCoord,
                std::vector<RealMatrix>& grad)
 {
-  static RealMatrix invJ(3,3);
+  CFreal invJData[9];
+  RealMatrix invJ(3,3,invJData);
   MathTools::MatrixInverterT<3> inverter;
 
   for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
@@ -41,7 +41,8 @@ void LagrangeShapeFunctionQuadP1::computeGradientStates(
          const std::vector<RealVector>& mappedCoord,
                std::vector<RealMatrix>& grad)
 {
-  static RealMatrix invJ(2,2);
+  CFreal invJData[4];
+  RealMatrix invJ(2,2,invJData);
   MathTools::MatrixInverterT<2> inverter;
 
   for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
@@ -113,17 +113,39 @@ public:
     shapeFunc[3] = mappedCoord[2];
   }
 
+  /// Compute the gradients of the shape functions with respect to the
+  /// mapped coordinates, (node, mapped coordinate) in each matrix
+  /// @return true, these gradients are provided
+  static bool computeMappedGradients(
+         const std::vector<RealVector>& mappedCoord,
+               std::vector<RealMatrix>& mappedGrad)
+  {
+    for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
+      RealMatrix& g = mappedGrad[ip];
+      g = 0.;
+      g(0,KSI) = g(0,ETA) = g(0,ZTA) = -1.;
+      g(1,KSI) = 1.;
+      g(2,ETA) = 1.;
+      g(3,ZTA) = 1.;
+    }
+    return true;
+  }
+
   /// Compute the Gradient of the Shape Function
   static void computeGradientStates(
          const std::vector<RealMatrix>& jacob,
          const std::vector<RealVector>& mappedCoord,
                std::vector<RealMatrix>& grad)
   {
-    static RealMatrix invJ(3,3);
+    if (mappedCoord.size() == 0) return;
+
+    // the inverse Jacobian lives on the stack to keep this reentrant
+    CFreal invJData[9];
+    RealMatrix invJ(3,3,invJData);
     MathTools::MatrixInverterT<3> inverter;
 
-    // Derivatives of shape functions are constant
-    // hence Gradients are independent of the mappedCoord
+    // the Jacobians come from the geometric shape function and differ
+    // from point to point on curved elements: each one is inverted
     for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
 
       inverter.invert(jacob[ip], invJ);
@@ -149,6 +149,56 @@ public:
 
   }
 
+  /// Compute the gradients of the shape functions with respect to the
+  /// mapped coordinates, (node, mapped coordinate) in each matrix
+  /// @return true, these gradients are provided
+  static bool computeMappedGradients(
+         const std::vector<RealVector>& mappedCoord,
+               std::vector<RealMatrix>& mappedGrad)
+  {
+    for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
+      RealMatrix& g = mappedGrad[ip];
+      const CFreal lambda = 1.0 - mappedCoord[ip].sum();
+      const CFreal xi =  mappedCoord[ip][KSI];
+      const CFreal eta = mappedCoord[ip][ETA];
+      const CFreal zta = mappedCoord[ip][ZTA];
+
+      g(0,KSI) = 1. - 4. * lambda;
+      g(1,KSI) = -1. + 4. * xi;
+      g(2,KSI) = 0.;
+      g(3,KSI) = 0.;
+      g(4,KSI) = 4.*(lambda - xi);
+      g(5,KSI) = 4. * eta;
+      g(6,KSI) = -4.* eta;
+      g(7,KSI) = 4. * zta;
+      g(8,KSI) = 0.;
+      g(9,KSI) = -4. * zta;
+
+      g(0,ETA) = 1. - 4. * lambda;
+      g(1,ETA) = 0.;
+      g(2,ETA) = -1. + 4. * eta;
+      g(3,ETA) = 0.;
+      g(4,ETA) = -4. * xi;
+      g(5,ETA) = 4. * xi;
+      g(6,ETA) = 4.*(lambda - eta);
+      g(7,ETA) = 0.;
+      g(8,ETA) = 4. * zta;
+      g(9,ETA) = -4. * zta;
+
+      g(0,ZTA) = 1. - 4. * lambda;
+      g(1,ZTA) = 0.;
+      g(2,ZTA) = 0.;
+      g(3,ZTA) = -1. + 4. * zta;
+      g(4,ZTA) = -4. * xi;
+      g(5,ZTA) = 0.;
+      g(6,ZTA) = -4. * eta;
+      g(7,ZTA) = 4. * xi;
+      g(8,ZTA) = 4. * eta;
+      g(9,ZTA) = 4. * (lambda - zta);
+    }
+    return true;
+  }
+
   /// Compute the Gradient of the Shape Function
   static void computeGradientStates(
          const std::vector<RealMatrix>& jacob,
@@ -107,6 +107,23 @@ public:
       shapeFunc[2] = mappedCoord[1];
   }
 
+  /// Compute the gradients of the shape functions with respect to the
+  /// mapped coordinates, (node, mapped coordinate) in each matrix
+  /// @return true, these gradients are provided
+  static bool computeMappedGradients(
+         const std::vector<RealVector>& mappedCoord,
+               std::vector<RealMatrix>& mappedGrad)
+  {
+    for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
+      RealMatrix& g = mappedGrad[ip];
+      g = 0.;
+      g(0,KSI) = g(0,ETA) = -1.;
+      g(1,KSI) = 1.;
+      g(2,ETA) = 1.;
+    }
+    return true;
+  }
+
   /// Compute the Gradient of the Shape Function
   static void computeGradientStates(
          const std::vector<RealMatrix>& jacob,
@@ -116,6 +116,35 @@ public:
       shapeFunc[5] = 4.*mappedCoord[1]*(1.0 - mappedCoord.sum());
   }
 
+  /// Compute the gradients of the shape functions with respect to the
+  /// mapped coordinates, (node, mapped coordinate) in each matrix
+  /// @return true, these gradients are provided
+  static bool computeMappedGradients(
+         const std::vector<RealVector>& mappedCoord,
+               std::vector<RealMatrix>& mappedGrad)
+  {
+    for (CFuint ip = 0; ip < mappedCoord.size(); ++ip) {
+      RealMatrix& g = mappedGrad[ip];
+      const CFreal xi =  mappedCoord[ip][KSI];
+      const CFreal eta = mappedCoord[ip][ETA];
+
+      g(0,KSI) = -3. + 4.*eta + 4.*xi;
+      g(1,KSI) = 4.*xi - 1.;
+      g(2,KSI) = 0.;
+      g(3,KSI) = 4. - 8.*xi - 4.*eta;
+      g(4,KSI) = 4.*eta;
+      g(5,KSI) = -4.*eta;
+
+      g(0,ETA) = -3. + 4.*eta + 4.*xi;
+      g(1,ETA) = 0.;
+      g(2,ETA) = 4.*eta - 1.;
+      g(3,ETA) = -4.*xi;
+      g(4,ETA) = 4.*xi;
+      g(5,ETA) = 4. - 4.*xi - 8.*eta;
+    }
+    return true;
+  }
+
   /// Compute the Gradient of the Shape Function
   static void computeGradientStates(
          const std::vector<RealMatrix>& jacob,
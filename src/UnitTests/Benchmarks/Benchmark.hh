@@ -0,0 +1,358 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef COOLFluiD_UnitTests_Benchmark_hh
+#define COOLFluiD_UnitTests_Benchmark_hh
+
+//////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Common/Stopwatch.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace COOLFluiD {
+
+  namespace Benchmarks {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Prevent the compiler from optimizing away the computation of a value
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static const void* volatile sink = CFNULL;
+  sink = &value;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// This class runs a list of micro-benchmarks and reports the time per
+/// iteration of each of them, in the JSON format of Google Benchmark so that
+/// the results can be compared across versions with the usual tools.
+/// Each benchmark is a function running its kernel the given number of times
+/// on synthetic data. The number of iterations is doubled until the run lasts
+/// at least the minimum time, then the run is repeated and the min, mean and
+/// median times are reported.
+///
+/// Command line options:
+///   --benchmark_filter=<str>       run only the benchmarks containing <str>
+///   --benchmark_min_time=<s>       minimum duration of a run (default 0.2s)
+///   --benchmark_repetitions=<n>    number of measured runs (default 5)
+///   --benchmark_out=<file>         write the JSON report to <file> instead
+///                                  of the standard output
+///
+/// In parallel, the wall time of each run is reduced with the given function
+/// (typically the maximum across the processes), so that all the processes
+/// take the same decisions, and only the root process writes the report.
+class Runner {
+public:
+
+  /// kernel to time, running the given number of iterations
+  typedef void (*Function)(CFuint nbIter);
+
+  /// reduction of a time across the processes
+  typedef CFreal (*Reduction)(CFreal time);
+
+  /// Constructor parsing the command line
+  Runner(int argc, char** argv) :
+    m_benchmarks(),
+    m_results(),
+    m_executable((argc > 0) ? argv[0] : ""),
+    m_filter(),
+    m_outFile(),
+    m_minTime(0.2),
+    m_nbRepetitions(5),
+    m_isRoot(true),
+    m_reduce(CFNULL),
+    m_context()
+  {
+    for (int i = 1; i < argc; ++i) {
+      const std::string arg = argv[i];
+      if (hasPrefix(arg, "--benchmark_filter=")) {
+        m_filter = getValue(arg);
+      }
+      else if (hasPrefix(arg, "--benchmark_min_time=")) {
+        m_minTime = std::atof(getValue(arg).c_str());
+      }
+      else if (hasPrefix(arg, "--benchmark_repetitions=")) {
+        m_nbRepetitions = std::max(1, std::atoi(getValue(arg).c_str()));
+      }
+      else if (hasPrefix(arg, "--benchmark_out=")) {
+        m_outFile = getValue(arg);
+      }
+    }
+  }
+
+  /// Register a benchmark
+  /// @param itemsPerIter  number of items (entries, flops, bytes...) processed
+  ///                      in one iteration, reported as a rate if not zero
+  void add(const std::string& name, Function fun, CFuint itemsPerIter = 0)
+  {
+    Entry entry;
+    entry.name = name;
+    entry.fun = fun;
+    entry.itemsPerIter = itemsPerIter;
+    m_benchmarks.push_back(entry);
+  }
+
+  /// Run in parallel
+  /// @param isRoot  true if this process writes the report
+  /// @param reduce  reduction of the wall time across the processes
+  void setParallel(bool isRoot, Reduction reduce)
+  {
+    m_isRoot = isRoot;
+    m_reduce = reduce;
+  }
+
+  /// Add an entry to the context of the report
+  void addContext(const std::string& key, const std::string& value)
+  {
+    m_context.push_back(std::make_pair(key, value));
+  }
+
+  /// Run all the benchmarks matching the filter and write the report
+  /// @return the exit code of the benchmark executable
+  int run()
+  {
+    for (CFuint i = 0; i < m_benchmarks.size(); ++i) {
+      if (m_filter.empty() || m_benchmarks[i].name.find(m_filter) != std::string::npos) {
+        runOne(m_benchmarks[i]);
+      }
+    }
+
+    if (!m_isRoot) return 0;
+
+    if (m_outFile.empty()) {
+      writeJSON(std::cout);
+    }
+    else {
+      std::ofstream fout(m_outFile.c_str());
+      if (!fout) {
+        std::cerr << "cannot open " << m_outFile << "\n";
+        return 1;
+      }
+      writeJSON(fout);
+      writeTable(std::cout);
+    }
+    return 0;
+  }
+
+private:
+
+  /// registered benchmark
+  struct Entry {
+    std::string name;
+    Function fun;
+    CFuint itemsPerIter;
+  };
+
+  /// timings of a benchmark
+  struct Result {
+    std::string name;
+    CFuint nbIter;
+    CFuint itemsPerIter;
+    CFreal realTime;
+    CFreal cpuTime;
+    std::string aggregate;
+  };
+
+  static bool hasPrefix(const std::string& arg, const char* prefix)
+  {
+    return arg.compare(0, std::strlen(prefix), prefix) == 0;
+  }
+
+  static std::string getValue(const std::string& arg)
+  {
+    return arg.substr(arg.find('=') + 1);
+  }
+
+  /// Time one run of the given number of iterations
+  void time(const Entry& entry, CFuint nbIter, CFreal& realTime, CFreal& cpuTime)
+  {
+    Common::Stopwatch<Common::WallTime> wallClock;
+    Common::Stopwatch<Common::CPUTime> cpuClock;
+    wallClock.start();
+    cpuClock.start();
+    entry.fun(nbIter);
+    cpuClock.stop();
+    wallClock.stop();
+    realTime = (m_reduce != CFNULL) ? m_reduce(wallClock.read()) : wallClock.read();
+    cpuTime = cpuClock.read();
+  }
+
+  /// Run one benchmark
+  void runOne(const Entry& entry)
+  {
+    CFreal realTime = 0.;
+    CFreal cpuTime = 0.;
+
+    // warm up and find the number of iterations lasting the minimum time
+    CFuint nbIter = 1;
+    for (;;) {
+      time(entry, nbIter, realTime, cpuTime);
+      if (realTime >= m_minTime || nbIter >= 1000000000) break;
+      const CFreal factor = (realTime > 0.) ? 1.4*m_minTime/realTime : 10.;
+      nbIter = static_cast<CFuint>(nbIter*std::min(10., std::max(2., factor)));
+    }
+
+    std::vector<CFreal> realTimes(m_nbRepetitions);
+    std::vector<CFreal> cpuTimes(m_nbRepetitions);
+    for (int r = 0; r < m_nbRepetitions; ++r) {
+      time(entry, nbIter, realTimes[r], cpuTimes[r]);
+      addResult(entry, nbIter, realTimes[r], cpuTimes[r], "");
+    }
+
+    std::vector<CFreal> sorted(realTimes);
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<CFreal> sortedCpu(cpuTimes);
+    std::sort(sortedCpu.begin(), sortedCpu.end());
+    const CFuint mid = m_nbRepetitions/2;
+
+    addResult(entry, nbIter, sorted[0], sortedCpu[0], "min");
+    addResult(entry, nbIter, mean(realTimes), mean(cpuTimes), "mean");
+    addResult(entry, nbIter, sorted[mid], sortedCpu[mid], "median");
+  }
+
+  static CFreal mean(const std::vector<CFreal>& v)
+  {
+    CFreal sum = 0.;
+    for (CFuint i = 0; i < v.size(); ++i) {
+      sum += v[i];
+    }
+    return sum/v.size();
+  }
+
+  void addResult(const Entry& entry, CFuint nbIter, CFreal realTime,
+                 CFreal cpuTime, const std::string& aggregate)
+  {
+    Result result;
+    result.name = aggregate.empty() ? entry.name : entry.name + "_" + aggregate;
+    result.nbIter = nbIter;
+    result.itemsPerIter = entry.itemsPerIter;
+    result.realTime = realTime;
+    result.cpuTime = cpuTime;
+    result.aggregate = aggregate;
+    m_results.push_back(result);
+  }
+
+  /// Write the report in the Google Benchmark JSON format, times in ns
+  void writeJSON(std::ostream& out) const
+  {
+    char date[64];
+    const std::time_t now = std::time(CFNULL);
+    std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"executable\": \"" << m_executable << "\",\n";
+    for (CFuint i = 0; i < m_context.size(); ++i) {
+      out << "    \"" << m_context[i].first << "\": \"" << m_context[i].second << "\",\n";
+    }
+    out << "    \"library_build_type\": \""
+#ifdef NDEBUG
+        << "release"
+#else
+        << "debug"
+#endif
+        << "\"\n  },\n  \"benchmarks\": [\n";
+
+    for (CFuint i = 0; i < m_results.size(); ++i) {
+      const Result& r = m_results[i];
+      const CFreal realNs = 1e9*r.realTime/r.nbIter;
+      const CFreal cpuNs = 1e9*r.cpuTime/r.nbIter;
+      out << "    {\n"
+          << "      \"name\": \"" << r.name << "\",\n"
+          << "      \"run_type\": \"" << (r.aggregate.empty() ? "iteration" : "aggregate") << "\",\n";
+      if (!r.aggregate.empty()) {
+        out << "      \"aggregate_name\": \"" << r.aggregate << "\",\n";
+      }
+      out << "      \"iterations\": " << r.nbIter << ",\n"
+          << std::setprecision(10)
+          << "      \"real_time\": " << realNs << ",\n"
+          << "      \"cpu_time\": " << cpuNs << ",\n";
+      if (r.itemsPerIter > 0 && r.realTime > 0.) {
+        out << "      \"items_per_second\": " << r.itemsPerIter*r.nbIter/r.realTime << ",\n";
+      }
+      out << "      \"time_unit\": \"ns\"\n"
+          << "    }" << ((i + 1 < m_results.size()) ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+  }
+
+  /// Write a summary table with the median times
+  void writeTable(std::ostream& out) const
+  {
+    out << std::left << std::setw(50) << "Benchmark" << std::right
+        << std::setw(16) << "Time [ns]" << std::setw(16) << "CPU [ns]"
+        << std::setw(14) << "Iterations" << "\n";
+    for (CFuint i = 0; i < m_results.size(); ++i) {
+      const Result& r = m_results[i];
+      if (r.aggregate != "median") continue;
+      out << std::left << std::setw(50) << r.name << std::right << std::fixed
+          << std::setprecision(1) << std::setw(16) << 1e9*r.realTime/r.nbIter
+          << std::setw(16) << 1e9*r.cpuTime/r.nbIter
+          << std::setw(14) << r.nbIter << "\n";
+    }
+  }
+
+private:
+
+  /// registered benchmarks
+  std::vector<Entry> m_benchmarks;
+
+  /// timings of the benchmarks that have been run
+  std::vector<Result> m_results;
+
+  /// name of the executable
+  std::string m_executable;
+
+  /// only the benchmarks containing this string are run
+  std::string m_filter;
+
+  /// file where to write the JSON report
+  std::string m_outFile;
+
+  /// minimum duration of a run in seconds
+  CFreal m_minTime;
+
+  /// number of measured runs
+  int m_nbRepetitions;
+
+  /// flag telling if this process writes the report
+  bool m_isRoot;
+
+  /// reduction of the wall time across the processes
+  Reduction m_reduce;
+
+  /// additional entries of the context of the report
+  std::vector<std::pair<std::string, std::string> > m_context;
+
+}; // class Runner
+
+//////////////////////////////////////////////////////////////////////////////
+
+  } // namespace Benchmarks
+
+} // namespace COOLFluiD
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif // COOLFluiD_UnitTests_Benchmark_hh
@@ -0,0 +1,137 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <mpi.h>
+
+#include "Common/CFMultiMap.hh"
+#include "Common/PE.hh"
+#include "Common/SharedPtr.hh"
+#include "Common/StringOps.hh"
+#include "Common/MPI/ParVector.hh"
+#include "UnitTests/Benchmarks/Benchmark.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::Benchmarks;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// number of points owned by each process
+static const CFuint nbLocalPoints = 200000;
+
+/// number of ghost points received from each neighbour process
+static const CFuint nbGhostPointsPerSide = 5000;
+
+/// number of variables per point
+static const CFuint nbEqs = 5;
+
+/// parallel vectors of states distributed on a ring of processes, with
+/// ghost layers coming from the previous and the next process, whose
+/// ghost maps are built with the "AllToAll" and "Old" algorithms
+static ParVector<CFreal>* states = CFNULL;
+static ParVector<CFreal>* statesOld = CFNULL;
+
+//////////////////////////////////////////////////////////////////////////////
+
+static CFreal maxTime(CFreal time)
+{
+  CFreal result = time;
+  MPI_Allreduce(&time, &result, 1, MPI_DOUBLE, MPI_MAX,
+                PE::GetPE().GetCommunicator("Default"));
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static ParVector<CFreal>* buildStates(const string& algo)
+{
+  const CFuint rank = PE::GetPE().GetRank("Default");
+  const CFuint nbProcs = PE::GetPE().GetProcessorCount("Default");
+  const CFuint nbGhosts = (nbProcs > 1) ? 2*nbGhostPointsPerSide : 0;
+
+  ParVector<CFreal>* parStates = new ParVector<CFreal>("Default", 0., 0);
+  parStates->reserve(nbLocalPoints + nbGhosts, nbEqs*sizeof(CFreal), "Default");
+
+  const CFuint start = rank*nbLocalPoints;
+  for (CFuint i = 0; i < nbLocalPoints; ++i) {
+    const CFuint localID = parStates->AddLocalPoint(start + i);
+    CFreal* state = &(*parStates)(localID);
+    for (CFuint iEq = 0; iEq < nbEqs; ++iEq) {
+      state[iEq] = start + i;
+    }
+  }
+
+  if (nbProcs > 1) {
+    SharedPtr<CFMultiMap<CFuint, CFuint> > ghost2Donor(new CFMultiMap<CFuint, CFuint>(nbGhosts));
+    const CFuint prev = (rank + nbProcs - 1)%nbProcs;
+    const CFuint next = (rank + 1)%nbProcs;
+    // last points of the previous process and first points of the next one
+    for (CFuint i = 0; i < nbGhostPointsPerSide; ++i) {
+      const CFuint globalID = (prev + 1)*nbLocalPoints - nbGhostPointsPerSide + i;
+      parStates->AddGhostPoint(globalID);
+      ghost2Donor->insert(globalID, prev);
+    }
+    for (CFuint i = 0; i < nbGhostPointsPerSide; ++i) {
+      const CFuint globalID = next*nbLocalPoints + i;
+      parStates->AddGhostPoint(globalID);
+      ghost2Donor->insert(globalID, next);
+    }
+    ghost2Donor->sortKeys();
+    parStates->setMapGhost2DonorRanks(ghost2Donor);
+  }
+
+  parStates->BuildGhostMap(algo);
+  return parStates;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchSynchronize(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    states->synchronize();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchBeginEndSync(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    statesOld->BeginSync();
+    statesOld->EndSync();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+  PE::InitPE(&argc, &argv);
+
+  states = buildStates("AllToAll");
+  statesOld = buildStates("Old");
+
+  Runner runner(argc, argv);
+  runner.setParallel(PE::GetPE().GetRank("Default") == 0, maxTime);
+  runner.addContext("mpi_procs", StringOps::to_str(PE::GetPE().GetProcessorCount("Default")));
+  runner.addContext("local_points", StringOps::to_str(nbLocalPoints));
+  runner.addContext("ghost_points", StringOps::to_str(2*nbGhostPointsPerSide));
+  runner.add("MPICommPattern::synchronize", benchSynchronize, 2*nbGhostPointsPerSide*nbEqs);
+  runner.add("MPICommPattern::BeginSync/EndSync", benchBeginEndSync, 2*nbGhostPointsPerSide*nbEqs);
+
+  const int result = runner.run();
+
+  delete states;
+  delete statesOld;
+  PE::DonePE();
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,306 @@
+// Copyright (C) 2012 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cmath>
+#include <cstdlib>
+#include <valarray>
+#include <vector>
+
+#include "Common/ConnectivityTable.hh"
+#include "Common/LookupTable2D.hh"
+#include "MathTools/LUInverterT.hh"
+#include "MathTools/MatrixInverter.hh"
+#include "MathTools/MatrixInverterT.hh"
+#include "Framework/Node.hh"
+#include "ShapeFunctions/LagrangeShapeFunctionHexaP1.hh"
+#include "ShapeFunctions/LagrangeShapeFunctionTriagP1.hh"
+#include "UnitTests/Benchmarks/Benchmark.hh"
+
+//////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace COOLFluiD;
+using namespace COOLFluiD::Common;
+using namespace COOLFluiD::MathTools;
+using namespace COOLFluiD::Framework;
+using namespace COOLFluiD::ShapeFunctions;
+using namespace COOLFluiD::Benchmarks;
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// Synthetic data shared by the benchmarks, built once
+struct KernelData {
+  /// diagonally dominant matrices to invert
+  RealMatrix a4;
+  RealMatrix a5;
+  RealMatrix a10;
+  RealMatrix inv4;
+  RealMatrix inv5;
+  RealMatrix inv10;
+  LUInverterT<5> luInverter5;
+  MatrixInverterT<4> inverter4;
+  MatrixInverter* inverter10;
+
+  /// table and random keys for the look ups
+  LookupTable2D<CFreal,CFreal,CFreal> table;
+  vector<CFreal> key1;
+  vector<CFreal> key2;
+
+  /// element-state like connectivity with mixed row sizes
+  ConnectivityTable<CFuint> connectivity;
+
+  /// distorted hexahedron and its quadrature points
+  vector<Node*> hexaNodes;
+  vector<RealVector> hexaPoints;
+  vector<RealVector> hexaShapeFunctions;
+  vector<RealMatrix> hexaJacobians;
+  valarray<CFreal> hexaDetJacobians;
+
+  /// triangle quadrature points
+  vector<RealVector> triagPoints;
+  vector<RealVector> triagShapeFunctions;
+
+  KernelData();
+  ~KernelData();
+};
+
+static KernelData* data = CFNULL;
+
+//////////////////////////////////////////////////////////////////////////////
+
+static CFreal randomValue(CFreal minValue, CFreal maxValue)
+{
+  return minValue + (maxValue - minValue)*(std::rand()/(RAND_MAX + 1.));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void fillMatrix(RealMatrix& a)
+{
+  for (CFuint i = 0; i < a.nbRows(); ++i) {
+    for (CFuint j = 0; j < a.nbCols(); ++j) {
+      a(i,j) = randomValue(-1., 1.);
+    }
+    a(i,i) += a.nbCols();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KernelData::KernelData() :
+  a4(4,4), a5(5,5), a10(10,10), inv4(4,4), inv5(5,5), inv10(10,10),
+  inverter10(MatrixInverter::create(10, false)),
+  hexaDetJacobians(8)
+{
+  std::srand(1);
+
+  fillMatrix(a4);
+  fillMatrix(a5);
+  fillMatrix(a10);
+
+  const CFuint nbKeys = 200;
+  vector<CFreal> keys1(nbKeys);
+  vector<CFreal> keys2(nbKeys);
+  for (CFuint i = 0; i < nbKeys; ++i) {
+    keys1[i] = 200. + 50.*i;
+    keys2[i] = 1e-2*(i + 1);
+  }
+  table.initialize(keys1, keys2, 1);
+  for (CFuint i = 0; i < nbKeys; ++i) {
+    for (CFuint j = 0; j < nbKeys; ++j) {
+      table.insert(keys1[i], keys2[j], 0, keys1[i]*keys2[j]);
+    }
+  }
+  key1.resize(1024);
+  key2.resize(1024);
+  for (CFuint i = 0; i < key1.size(); ++i) {
+    key1[i] = randomValue(keys1.front(), keys1.back());
+    key2[i] = randomValue(keys2.front(), keys2.back());
+  }
+
+  const CFuint nbRows = 100000;
+  valarray<CFuint> pattern(nbRows);
+  for (CFuint i = 0; i < nbRows; ++i) {
+    pattern[i] = (i%3 == 0) ? 8 : 4;
+  }
+  connectivity = ConnectivityTable<CFuint>(pattern);
+  for (CFuint i = 0; i < nbRows; ++i) {
+    for (CFuint j = 0; j < connectivity.nbCols(i); ++j) {
+      connectivity(i,j) = std::rand()%nbRows;
+    }
+  }
+
+  const CFreal xi[8][3] = {{-1.,-1.,-1.}, {1.,-1.,-1.}, {1.,1.,-1.}, {-1.,1.,-1.},
+                           {-1.,-1.,1.},  {1.,-1.,1.},  {1.,1.,1.},  {-1.,1.,1.}};
+  const CFreal gp = 1./std::sqrt(3.);
+  RealVector coord(3);
+  for (CFuint i = 0; i < 8; ++i) {
+    for (CFuint d = 0; d < 3; ++d) {
+      coord[d] = 0.5*(xi[i][d] + 1.) + randomValue(-0.1, 0.1);
+    }
+    hexaNodes.push_back(new Node(coord, false));
+
+    RealVector point(3);
+    for (CFuint d = 0; d < 3; ++d) {
+      point[d] = gp*xi[i][d];
+    }
+    hexaPoints.push_back(point);
+    hexaShapeFunctions.push_back(RealVector(8));
+    hexaJacobians.push_back(RealMatrix(3,3));
+  }
+
+  const CFreal triag[3][2] = {{1./6., 1./6.}, {2./3., 1./6.}, {1./6., 2./3.}};
+  for (CFuint i = 0; i < 3; ++i) {
+    RealVector point(2);
+    point[0] = triag[i][0];
+    point[1] = triag[i][1];
+    triagPoints.push_back(point);
+    triagShapeFunctions.push_back(RealVector(3));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+KernelData::~KernelData()
+{
+  delete inverter10;
+  for (CFuint i = 0; i < hexaNodes.size(); ++i) {
+    delete hexaNodes[i];
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchMatrixInverterT4(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    data->inverter4.invert(data->a4, data->inv4);
+    doNotOptimize(data->inv4);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchLUInverterT5(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    data->luInverter5.invert(data->a5, data->inv5);
+    doNotOptimize(data->inv5);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchMatrixInverter10(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    data->inverter10->invert(data->a10, data->inv10);
+    doNotOptimize(data->inv10);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchLookupTable2DGet(CFuint nbIter)
+{
+  const CFuint nbKeys = data->key1.size();
+  CFreal sum = 0.;
+  for (CFuint i = 0; i < nbIter; ++i) {
+    for (CFuint k = 0; k < nbKeys; ++k) {
+      sum += data->table.get(data->key1[k], data->key2[k], 0);
+    }
+  }
+  doNotOptimize(sum);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchConnectivityTableAccess(CFuint nbIter)
+{
+  const ConnectivityTable<CFuint>& table = data->connectivity;
+  const CFuint nbRows = table.nbRows();
+  CFuint sum = 0;
+  for (CFuint i = 0; i < nbIter; ++i) {
+    for (CFuint iRow = 0; iRow < nbRows; ++iRow) {
+      const CFuint nbCols = table.nbCols(iRow);
+      for (CFuint jCol = 0; jCol < nbCols; ++jCol) {
+        sum += table(iRow, jCol);
+      }
+    }
+  }
+  doNotOptimize(sum);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchHexaP1ShapeFunctions(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    LagrangeShapeFunctionHexaP1::computeShapeFunctions
+      (data->hexaPoints, data->hexaShapeFunctions);
+    doNotOptimize(data->hexaShapeFunctions);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchHexaP1Jacobian(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    LagrangeShapeFunctionHexaP1::computeJacobian
+      (data->hexaNodes, data->hexaPoints, data->hexaJacobians);
+    doNotOptimize(data->hexaJacobians);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchHexaP1JacobianDeterminant(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    LagrangeShapeFunctionHexaP1::computeJacobianDeterminant
+      (data->hexaPoints, data->hexaNodes, data->hexaDetJacobians);
+    doNotOptimize(data->hexaDetJacobians);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void benchTriagP1ShapeFunctions(CFuint nbIter)
+{
+  for (CFuint i = 0; i < nbIter; ++i) {
+    LagrangeShapeFunctionTriagP1::computeShapeFunctions
+      (data->triagPoints, data->triagShapeFunctions);
+    doNotOptimize(data->triagShapeFunctions);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+  data = new KernelData();
+
+  Runner runner(argc, argv);
+  runner.add("MatrixInverterT<4>::invert", benchMatrixInverterT4);
+  runner.add("LUInverterT<5>::invert", benchLUInverterT5);
+  runner.add("MatrixInverter(10)::invert", benchMatrixInverter10);
+  runner.add("LookupTable2D::get", benchLookupTable2DGet, data->key1.size());
+  runner.add("ConnectivityTable::operator()", benchConnectivityTableAccess,
+             data->connectivity.size());
+  runner.add("LagrangeShapeFunctionHexaP1::computeShapeFunctions", benchHexaP1ShapeFunctions);
+  runner.add("LagrangeShapeFunctionHexaP1::computeJacobian", benchHexaP1Jacobian);
+  runner.add("LagrangeShapeFunctionHexaP1::computeJacobianDeterminant",
+             benchHexaP1JacobianDeterminant);
+  runner.add("LagrangeShapeFunctionTriagP1::computeShapeFunctions", benchTriagP1ShapeFunctions);
+
+  const int result = runner.run();
+
+  delete data;
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////